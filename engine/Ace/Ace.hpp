@@ -6,14 +6,63 @@
 #pragma once
 
 #include <Ace/System/AssetRegistry.hpp>
+#include <Ace/System/ConcurrentFreeList.hpp>
+#include <Ace/System/ConcurrentSkipList.hpp>
+#include <Ace/System/ConcurrentVector.hpp>
+#include <Ace/System/CpuTopology.hpp>
+#include <Ace/System/DerivedDataCache.hpp>
 #include <Ace/System/EntryPoint.hpp>
+#include <Ace/System/EpochReclaimer.hpp>
 #include <Ace/System/EventBus.hpp>
 #include <Ace/System/FileWatcher.hpp>
+#include <Ace/System/JobSystem.hpp>
 #include <Ace/System/LoggerConsoleSink.hpp>
 #include <Ace/System/LoggerFileSink.hpp>
 #include <Ace/System/LoggerRenderSink.hpp>
+#include <Ace/System/Settings.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+#include <Ace/Scene/WorldStreamer.hpp>
+
+#include <Ace/Graphics/Mesh.hpp>
+#include <Ace/Graphics/MeshCooker.hpp>
+#include <Ace/Graphics/MeshLoaders.hpp>
+#include <Ace/Graphics/NullRenderBackend.hpp>
+#include <Ace/Graphics/ParticleSystem.hpp>
+#include <Ace/Graphics/RenderQueue.hpp>
+#include <Ace/Graphics/ShaderCache.hpp>
+#include <Ace/Graphics/SoftwareRasterizer.hpp>
+#include <Ace/Graphics/SoftwareRenderBackend.hpp>
+#include <Ace/Graphics/StagingRing.hpp>
+#include <Ace/Graphics/StreamedMesh.hpp>
+#include <Ace/Graphics/Texture.hpp>
+#include <Ace/Graphics/TextureCompressor.hpp>
+#include <Ace/Graphics/TextureLoaders.hpp>
+
+#include <Ace/Input/InputPipeline.hpp>
+
+#include <Ace/Audio/AudioMixer.hpp>
+#include <Ace/Audio/WaveFileSink.hpp>
+
+#include <Ace/Networking/LoopbackTransport.hpp>
+#include <Ace/Networking/NetworkHost.hpp>
+#include <Ace/Networking/SnapshotReplication.hpp>
+#include <Ace/Networking/UdpTransport.hpp>
+
+#include <Ace/Physics/DynamicAABBTree.hpp>
+#include <Ace/Physics/PhysicsWorld.hpp>
+#include <Ace/Physics/SweepAndPrune.hpp>
+
+#include <Ace/Animation/AnimationClip.hpp>
+#include <Ace/Animation/AnimationPose.hpp>
+#include <Ace/Animation/Animator.hpp>
+
+#include <Ace/Scripting/ScriptCompiler.hpp>
+#include <Ace/Scripting/ScriptLoader.hpp>
+#include <Ace/Scripting/ScriptVM.hpp>
 
 #include <Ace/Maths/Vector2.hpp>
 #include <Ace/Maths/Vector3.hpp>
 #include <Ace/Maths/Quaternion4.hpp>
 #include <Ace/Maths/Transform.hpp>
+#include <Ace/Maths/AABB3.hpp>
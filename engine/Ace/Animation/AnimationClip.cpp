@@ -0,0 +1,253 @@
+/**
+ * @file    Ace/Animation/AnimationClip.cpp
+ */
+
+#include <Ace/Animation/AnimationClip.hpp>
+#include <Ace/Networking/Quantization.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    AnimationClip::AnimationClip (
+        const RawAnimationClip&     pRaw,
+        const AnimationClipSpec&    pSpec
+    ) :
+        mFrameRate  { pRaw.mFrameRate },
+        mJointCount { pRaw.mJointCount },
+        mFrameCount { pRaw.mFrameCount },
+        mSpec       { pSpec }
+    {
+        const std::size_t lKeyCount = pRaw.mJointCount * pRaw.mFrameCount;
+        if (
+            pRaw.mFrameCount == 0 ||
+            (pRaw.mFrameRate > 0.0f) == false ||
+            pRaw.mTranslations.size() != lKeyCount ||
+            pRaw.mRotations.size() != lKeyCount ||
+            pRaw.mScales.size() != lKeyCount
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: The raw clip's keys do not match its frames and joints!",
+                "AnimationClip");
+        }
+
+        if (
+            pSpec.mRotationBits < 2 || pSpec.mRotationBits > 10 ||
+            pSpec.mVectorBits < 1 || pSpec.mVectorBits > 16
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Key widths are out of range!",
+                "AnimationClip");
+        }
+
+        mDuration = static_cast<float>(mFrameCount - 1) / mFrameRate;
+
+        // Every track starts from its first key; constant tracks stay there.
+        mConstantPose.Resize(mJointCount);
+        for (std::size_t j = 0; j < mJointCount; ++j)
+        {
+            mConstantPose.SetJoint(j, pRaw.mTranslations[j], pRaw.mRotations[j].Normalized(),
+                pRaw.mScales[j]);
+        }
+
+        // A rotation track is constant if every key turns the same way as
+        // the first, give or take the tolerance.
+        for (std::size_t j = 0; j < mJointCount; ++j)
+        {
+            const Quaternion4f lFirst = pRaw.mRotations[j].Normalized();
+            for (std::size_t f = 1; f < mFrameCount; ++f)
+            {
+                const float lDot = std::abs(Dot(lFirst, pRaw.mRotations[f * mJointCount + j].Normalized()));
+                if (lDot < 1.0f - pSpec.mConstantTolerance)
+                {
+                    mRotationJoints.push_back(static_cast<std::uint32_t>(j));
+                    break;
+                }
+            }
+        }
+
+        mRotationKeys.resize(mRotationJoints.size() * mFrameCount);
+        for (std::size_t f = 0; f < mFrameCount; ++f)
+        {
+            for (std::size_t k = 0; k < mRotationJoints.size(); ++k)
+            {
+                mRotationKeys[f * mRotationJoints.size() + k] = QuantizeRotation(
+                    pRaw.mRotations[f * mJointCount + mRotationJoints[k]], pSpec.mRotationBits);
+            }
+        }
+
+        CompressVectors(pRaw.mTranslations, mTranslationTracks, mTranslationKeys);
+        CompressVectors(pRaw.mScales, mScaleTracks, mScaleKeys);
+    }
+
+    /* Public Methods *********************************************************/
+
+    void AnimationClip::Sample (
+        const float pTime,
+        LocalPose&  pPose
+    ) const
+    {
+        // Find the frames either side of the time, and how far between them
+        // it lies.
+        std::size_t lFrame = 0;
+        std::size_t lNextFrame = 0;
+        float lAlpha = 0.0f;
+        if (mFrameCount > 1)
+        {
+            float lTime = std::fmod(pTime, mDuration);
+            if (lTime < 0.0f)
+            {
+                lTime += mDuration;
+            }
+
+            const float lPosition = lTime * mFrameRate;
+            lFrame = std::min(static_cast<std::size_t>(lPosition), mFrameCount - 2);
+            lNextFrame = lFrame + 1;
+            lAlpha = std::clamp(lPosition - static_cast<float>(lFrame), 0.0f, 1.0f);
+        }
+
+        pPose.Resize(mJointCount);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            std::copy(mConstantPose.mTranslation[c].begin(), mConstantPose.mTranslation[c].end(),
+                pPose.mTranslation[c].begin());
+            std::copy(mConstantPose.mScale[c].begin(), mConstantPose.mScale[c].end(),
+                pPose.mScale[c].begin());
+        }
+
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            std::copy(mConstantPose.mRotation[c].begin(), mConstantPose.mRotation[c].end(),
+                pPose.mRotation[c].begin());
+        }
+
+        const std::size_t lRotationCount = mRotationJoints.size();
+        const std::uint32_t* lKeys = mRotationKeys.data() + lFrame * lRotationCount;
+        const std::uint32_t* lNextKeys = mRotationKeys.data() + lNextFrame * lRotationCount;
+        for (std::size_t k = 0; k < lRotationCount; ++k)
+        {
+            const Quaternion4f lFrom = DequantizeRotation(lKeys[k], mSpec.mRotationBits);
+            const Quaternion4f lTo = DequantizeRotation(lNextKeys[k], mSpec.mRotationBits);
+            const float lSign = (Dot(lFrom, lTo) < 0.0f) ? -1.0f : 1.0f;
+            Quaternion4f lBlend {
+                lFrom.mX + (lTo.mX * lSign - lFrom.mX) * lAlpha,
+                lFrom.mY + (lTo.mY * lSign - lFrom.mY) * lAlpha,
+                lFrom.mZ + (lTo.mZ * lSign - lFrom.mZ) * lAlpha,
+                lFrom.mW + (lTo.mW * lSign - lFrom.mW) * lAlpha
+            };
+            lBlend.Normalize();
+
+            const std::uint32_t lJoint = mRotationJoints[k];
+            pPose.mRotation[0][lJoint] = lBlend.mX;
+            pPose.mRotation[1][lJoint] = lBlend.mY;
+            pPose.mRotation[2][lJoint] = lBlend.mZ;
+            pPose.mRotation[3][lJoint] = lBlend.mW;
+        }
+
+        SampleVectors(mTranslationTracks, mTranslationKeys, lFrame, lNextFrame, lAlpha, pPose.mTranslation);
+        SampleVectors(mScaleTracks, mScaleKeys, lFrame, lNextFrame, lAlpha, pPose.mScale);
+    }
+
+    std::size_t AnimationClip::GetMemorySize () const
+    {
+        const std::size_t lPoseSize = mJointCount * 10 * sizeof(float);
+        return sizeof(AnimationClip) + lPoseSize +
+            mRotationJoints.size() * sizeof(std::uint32_t) +
+            mRotationKeys.size() * sizeof(std::uint32_t) +
+            (mTranslationTracks.size() + mScaleTracks.size()) * sizeof(VectorTrack) +
+            (mTranslationKeys.size() + mScaleKeys.size()) * sizeof(std::uint16_t);
+    }
+
+    std::size_t AnimationClip::GetRawMemorySize (
+        const RawAnimationClip& pRaw
+    )
+    {
+        return
+            pRaw.mTranslations.size() * sizeof(Vector3f) +
+            pRaw.mRotations.size() * sizeof(Quaternion4f) +
+            pRaw.mScales.size() * sizeof(Vector3f);
+    }
+
+    /* Private Methods ********************************************************/
+
+    void AnimationClip::CompressVectors (
+        const std::vector<Vector3f>&    pKeys,
+        std::vector<VectorTrack>&       pTracks,
+        std::vector<std::uint16_t>&     pQuantized
+    )
+    {
+        // A track is animated if any component's keys span more than the
+        // tolerance; its keys are then mapped onto that span.
+        const float lSteps = static_cast<float>((1u << mSpec.mVectorBits) - 1);
+        for (std::size_t j = 0; j < mJointCount; ++j)
+        {
+            Vector3f lMin = pKeys[j];
+            Vector3f lMax = pKeys[j];
+            for (std::size_t f = 1; f < mFrameCount; ++f)
+            {
+                const Vector3f& lKey = pKeys[f * mJointCount + j];
+                lMin = { std::min(lMin.mX, lKey.mX), std::min(lMin.mY, lKey.mY), std::min(lMin.mZ, lKey.mZ) };
+                lMax = { std::max(lMax.mX, lKey.mX), std::max(lMax.mY, lKey.mY), std::max(lMax.mZ, lKey.mZ) };
+            }
+
+            const Vector3f lSpan = lMax - lMin;
+            if (std::max({ lSpan.mX, lSpan.mY, lSpan.mZ }) > mSpec.mConstantTolerance)
+            {
+                pTracks.push_back({ static_cast<std::uint32_t>(j), lMin, lSpan / lSteps });
+            }
+        }
+
+        auto lQuantize =
+            [lSteps] (const float pValue, const float pMin, const float pStep) -> std::uint16_t
+            {
+                return (pStep > 0.0f) ?
+                    static_cast<std::uint16_t>(std::clamp(std::round((pValue - pMin) / pStep), 0.0f, lSteps)) :
+                    0;
+            };
+
+        const std::size_t lTrackCount = pTracks.size();
+        pQuantized.resize(lTrackCount * 3 * mFrameCount);
+        for (std::size_t f = 0; f < mFrameCount; ++f)
+        {
+            std::uint16_t* lOut = pQuantized.data() + f * lTrackCount * 3;
+            for (std::size_t k = 0; k < lTrackCount; ++k)
+            {
+                const VectorTrack& lTrack = pTracks[k];
+                const Vector3f& lKey = pKeys[f * mJointCount + lTrack.mJoint];
+                lOut[k * 3] = lQuantize(lKey.mX, lTrack.mMin.mX, lTrack.mStep.mX);
+                lOut[k * 3 + 1] = lQuantize(lKey.mY, lTrack.mMin.mY, lTrack.mStep.mY);
+                lOut[k * 3 + 2] = lQuantize(lKey.mZ, lTrack.mMin.mZ, lTrack.mStep.mZ);
+            }
+        }
+    }
+
+    void AnimationClip::SampleVectors (
+        const std::vector<VectorTrack>&     pTracks,
+        const std::vector<std::uint16_t>&   pQuantized,
+        const std::size_t                   pFrame,
+        const std::size_t                   pNextFrame,
+        const float                         pAlpha,
+        std::array<std::vector<float>, 3>&  pStreams
+    ) const
+    {
+        // Blend in quantized space, then map the result back onto the
+        // track's range.
+        const std::size_t lTrackCount = pTracks.size();
+        const std::uint16_t* lKeys = pQuantized.data() + pFrame * lTrackCount * 3;
+        const std::uint16_t* lNextKeys = pQuantized.data() + pNextFrame * lTrackCount * 3;
+        for (std::size_t k = 0; k < lTrackCount; ++k)
+        {
+            const VectorTrack& lTrack = pTracks[k];
+            const float lMin[3] = { lTrack.mMin.mX, lTrack.mMin.mY, lTrack.mMin.mZ };
+            const float lStep[3] = { lTrack.mStep.mX, lTrack.mStep.mY, lTrack.mStep.mZ };
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                const float lFrom = lKeys[k * 3 + c];
+                const float lTo = lNextKeys[k * 3 + c];
+                pStreams[c][lTrack.mJoint] = lMin[c] + lStep[c] * (lFrom + (lTo - lFrom) * pAlpha);
+            }
+        }
+    }
+
+}
@@ -0,0 +1,211 @@
+/**
+ * @file    Ace/Animation/AnimationClip.hpp
+ * @brief   Provides a class containing a skeletal animation, with its keys
+ *          quantized to a fraction of their raw size.
+ */
+
+#pragma once
+#include <Ace/Animation/AnimationPose.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing a skeletal animation as sampled by an
+     *          authoring tool: every joint's transform, at every frame.
+     *
+     * Keys are stored frame after frame, each frame holding one key for
+     * every joint: the key of joint `j` at frame `f` is at `f * mJointCount
+     * + j`.
+     */
+    struct RawAnimationClip
+    {
+        float                       mFrameRate = 30.0f;     ///< @brief The number of frames per second.
+        std::size_t                 mJointCount = 0;        ///< @brief The number of joints animated.
+        std::size_t                 mFrameCount = 0;        ///< @brief The number of frames.
+        std::vector<Vector3f>       mTranslations;          ///< @brief Each joint's translation at each frame.
+        std::vector<Quaternion4f>   mRotations;             ///< @brief Each joint's rotation at each frame.
+        std::vector<Vector3f>       mScales;                ///< @brief Each joint's scale at each frame.
+    };
+
+    /**
+     * @brief   A structure containing the settings a clip is compressed
+     *          with.
+     */
+    struct AnimationClipSpec
+    {
+        std::uint32_t   mRotationBits = 10;         ///< @brief The width of each stored rotation component, from 2 to 10.
+        std::uint32_t   mVectorBits = 16;           ///< @brief The width of each stored translation or scale component, from 1 to 16.
+        float           mConstantTolerance = 1e-5f; ///< @brief How far a track's keys may stray from its first and still count as constant.
+    };
+
+    /**
+     * @brief   A class containing a skeletal animation, compressed track by
+     *          track, which can be sampled at any time into a
+     *          @a `LocalPose`.
+     *
+     * Each joint's translation, rotation and scale is a track. A track whose
+     * keys never stray from the first is constant, and stored once. The
+     * keys of the other tracks are quantized:
+     *
+     * - rotations with "smallest three" compression, into 32 bits rather
+     *   than 128;
+     * - translations and scales into 16 bits per component rather than 32,
+     *   each track mapped onto the range its own keys span.
+     *
+     * Keys are laid out frame after frame, so that sampling reads two short
+     * runs of memory: the keys of the frames either side of the time asked
+     * for. Sampling blends between them, with a normalized lerp for
+     * rotations.
+     */
+    class ACE_API AnimationClip final
+    {
+    public:
+
+        /**
+         * @brief   Compresses a raw clip.
+         *
+         * @param   pRaw    The raw clip.
+         * @param   pSpec   The settings to compress it with.
+         *
+         * @throw   `std::invalid_argument` if the raw clip has no frames, its
+         *          frame rate is not positive, its key counts do not match
+         *          its frame and joint counts, or the settings are out of
+         *          range.
+         */
+        explicit AnimationClip (
+            const RawAnimationClip&     pRaw,
+            const AnimationClipSpec&    pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Samples the clip, looping it.
+         *
+         * @param   pTime   The time to sample at, in seconds. Times past the
+         *                  end of the clip wrap around to its start.
+         * @param   pPose   The pose to write the sample to. Resized to the
+         *                  clip's joint count.
+         */
+        void Sample (
+            const float pTime,
+            LocalPose&  pPose
+        ) const;
+
+        /**
+         * @brief   Retrieves the length of the clip.
+         *
+         * @return  The time from the first frame to the last, in seconds.
+         */
+        inline float GetDuration () const
+        {
+            return mDuration;
+        }
+
+        /**
+         * @brief   Retrieves the number of joints the clip animates.
+         *
+         * @return  The number of joints.
+         */
+        inline std::size_t GetJointCount () const
+        {
+            return mJointCount;
+        }
+
+        /**
+         * @brief   Retrieves the number of frames in the clip.
+         *
+         * @return  The number of frames.
+         */
+        inline std::size_t GetFrameCount () const
+        {
+            return mFrameCount;
+        }
+
+        /**
+         * @brief   Retrieves the number of tracks which change over the clip,
+         *          and so are stored key by key.
+         *
+         * @return  The number of animated translation, rotation and scale
+         *          tracks.
+         */
+        inline std::size_t GetAnimatedTrackCount () const
+        {
+            return mTranslationTracks.size() + mRotationJoints.size() + mScaleTracks.size();
+        }
+
+        /**
+         * @brief   Retrieves the memory the clip's keys and tracks take up.
+         *
+         * @return  The size of the clip's data, in bytes.
+         */
+        std::size_t GetMemorySize () const;
+
+        /**
+         * @brief   Retrieves the memory a raw clip's keys take up.
+         *
+         * @param   pRaw    The raw clip.
+         *
+         * @return  The size of the raw clip's keys, in bytes.
+         */
+        static std::size_t GetRawMemorySize (
+            const RawAnimationClip& pRaw
+        );
+
+    private:
+
+        /**
+         * @brief   A structure containing the range one animated translation
+         *          or scale track's keys are quantized over.
+         */
+        struct VectorTrack
+        {
+            std::uint32_t   mJoint = 0;     ///< @brief The joint the track animates.
+            Vector3f        mMin;           ///< @brief The lowest value of each component.
+            Vector3f        mStep;          ///< @brief The distance between adjacent quantized values of each component.
+        };
+
+    private:
+
+        /**
+         * @brief   Finds the animated tracks of a translation or scale
+         *          channel, and quantizes their keys.
+         */
+        void CompressVectors (
+            const std::vector<Vector3f>&    pKeys,
+            std::vector<VectorTrack>&       pTracks,
+            std::vector<std::uint16_t>&     pQuantized
+        );
+
+        /**
+         * @brief   Samples a translation or scale channel's animated tracks
+         *          into the pose's streams.
+         */
+        void SampleVectors (
+            const std::vector<VectorTrack>&     pTracks,
+            const std::vector<std::uint16_t>&   pQuantized,
+            const std::size_t                   pFrame,
+            const std::size_t                   pNextFrame,
+            const float                         pAlpha,
+            std::array<std::vector<float>, 3>&  pStreams
+        ) const;
+
+    private:
+        float                           mFrameRate = 0.0f;          ///< @brief The number of frames per second.
+        float                           mDuration = 0.0f;           ///< @brief The time from the first frame to the last.
+        std::size_t                     mJointCount = 0;            ///< @brief The number of joints animated.
+        std::size_t                     mFrameCount = 0;            ///< @brief The number of frames.
+        AnimationClipSpec               mSpec;                      ///< @brief The settings the clip was compressed with.
+
+        LocalPose                       mConstantPose;              ///< @brief The first frame's pose, which constant tracks keep throughout.
+        std::vector<std::uint32_t>      mRotationJoints;            ///< @brief The joints whose rotations are animated.
+        std::vector<std::uint32_t>      mRotationKeys;              ///< @brief The animated rotations, packed, frame after frame.
+        std::vector<VectorTrack>        mTranslationTracks;         ///< @brief The animated translation tracks.
+        std::vector<std::uint16_t>      mTranslationKeys;           ///< @brief The animated translations' components, frame after frame.
+        std::vector<VectorTrack>        mScaleTracks;               ///< @brief The animated scale tracks.
+        std::vector<std::uint16_t>      mScaleKeys;                 ///< @brief The animated scales' components, frame after frame.
+
+    };
+
+}
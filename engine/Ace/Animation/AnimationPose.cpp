@@ -0,0 +1,366 @@
+/**
+ * @file    Ace/Animation/AnimationPose.cpp
+ */
+
+#include <Ace/Animation/AnimationPose.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Builds the local matrix of one joint: its scale, then its
+     *          rotation, then its translation.
+     */
+    static void ComposeJoint (
+        const LocalPose&    pPose,
+        const std::size_t   pJoint,
+        Matrix4f&           pMatrix
+    )
+    {
+        const Matrix3f lRotation = pPose.GetRotation(pJoint).ToMatrix3();
+        const Vector3f lScale = pPose.GetScale(pJoint);
+        const Vector3f lTranslation = pPose.GetTranslation(pJoint);
+        const float lScales[3] = { lScale.mX, lScale.mY, lScale.mZ };
+        for (std::size_t lColumn = 0; lColumn < 3; ++lColumn)
+        {
+            for (std::size_t lRow = 0; lRow < 3; ++lRow)
+            {
+                pMatrix.mI[lColumn * 4 + lRow] = lRotation.mI[lColumn * 3 + lRow] * lScales[lColumn];
+            }
+
+            pMatrix.mI[lColumn * 4 + 3] = 0.0f;
+        }
+
+        pMatrix.mI[12] = lTranslation.mX;
+        pMatrix.mI[13] = lTranslation.mY;
+        pMatrix.mI[14] = lTranslation.mZ;
+        pMatrix.mI[15] = 1.0f;
+    }
+
+    /**
+     * @brief   Multiplies a model matrix by a local matrix, in place:
+     *          `pLocal = pParent * pLocal`.
+     */
+    static inline void MultiplyInPlace (
+        const Matrix4f& pParent,
+        Matrix4f&       pLocal
+    )
+    {
+        #if defined(__SSE2__)
+            // Each column of the product is the parent's columns weighted by
+            // the matching column of the local matrix.
+            const __m128 lColumn0 = _mm_loadu_ps(pParent.mI.data());
+            const __m128 lColumn1 = _mm_loadu_ps(pParent.mI.data() + 4);
+            const __m128 lColumn2 = _mm_loadu_ps(pParent.mI.data() + 8);
+            const __m128 lColumn3 = _mm_loadu_ps(pParent.mI.data() + 12);
+            for (std::size_t lColumn = 0; lColumn < 4; ++lColumn)
+            {
+                float* lOut = pLocal.mI.data() + lColumn * 4;
+                const __m128 lSum = _mm_add_ps(
+                    _mm_add_ps(_mm_mul_ps(lColumn0, _mm_set1_ps(lOut[0])), _mm_mul_ps(lColumn1, _mm_set1_ps(lOut[1]))),
+                    _mm_add_ps(_mm_mul_ps(lColumn2, _mm_set1_ps(lOut[2])), _mm_mul_ps(lColumn3, _mm_set1_ps(lOut[3]))));
+                _mm_storeu_ps(lOut, lSum);
+            }
+        #else
+            pLocal = pParent * pLocal;
+        #endif
+    }
+
+    /* Public Methods *********************************************************/
+
+    void LocalPose::Resize (
+        const std::size_t   pJointCount
+    )
+    {
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            mTranslation[i].resize(pJointCount, 0.0f);
+            mScale[i].resize(pJointCount, 1.0f);
+        }
+
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            mRotation[i].resize(pJointCount, (i == 3) ? 1.0f : 0.0f);
+        }
+
+        mJointCount = pJointCount;
+    }
+
+    void LocalPose::SetJoint (
+        const std::size_t   pJoint,
+        const Vector3f&     pTranslation,
+        const Quaternion4f& pRotation,
+        const Vector3f&     pScale
+    )
+    {
+        mTranslation[0][pJoint] = pTranslation.mX;
+        mTranslation[1][pJoint] = pTranslation.mY;
+        mTranslation[2][pJoint] = pTranslation.mZ;
+        mRotation[0][pJoint] = pRotation.mX;
+        mRotation[1][pJoint] = pRotation.mY;
+        mRotation[2][pJoint] = pRotation.mZ;
+        mRotation[3][pJoint] = pRotation.mW;
+        mScale[0][pJoint] = pScale.mX;
+        mScale[1][pJoint] = pScale.mY;
+        mScale[2][pJoint] = pScale.mZ;
+    }
+
+    void LocalPose::Blend (
+        std::span<const LocalPose* const>   pPoses,
+        std::span<const float>              pWeights
+    )
+    {
+        if (pPoses.empty() == true || pPoses.size() != pWeights.size())
+        {
+            ACE_THROW(std::invalid_argument, "{}: Expected one weight for each of at least one pose!",
+                "LocalPose");
+        }
+
+        float lTotal = 0.0f;
+        for (std::size_t i = 0; i < pPoses.size(); ++i)
+        {
+            if (pPoses[i]->mJointCount != pPoses[0]->mJointCount)
+            {
+                ACE_THROW(std::invalid_argument, "{}: Poses to be blended must have the same joints!",
+                    "LocalPose");
+            }
+
+            lTotal += pWeights[i];
+        }
+
+        if ((lTotal > 0.0f) == false)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Blend weights must sum to a positive number!",
+                "LocalPose");
+        }
+
+        // Start from the first pose, scaled by its weight, then add each
+        // other pose in turn, so that every joint sums its poses in the same
+        // order.
+        const std::size_t lCount = pPoses[0]->mJointCount;
+        Resize(lCount);
+        const float lFirstWeight = pWeights[0] / lTotal;
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            for (std::size_t j = 0; j < lCount; ++j)
+            {
+                mTranslation[c][j] = pPoses[0]->mTranslation[c][j] * lFirstWeight;
+                mScale[c][j] = pPoses[0]->mScale[c][j] * lFirstWeight;
+            }
+        }
+
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            for (std::size_t j = 0; j < lCount; ++j)
+            {
+                mRotation[c][j] = pPoses[0]->mRotation[c][j] * lFirstWeight;
+            }
+        }
+
+        for (std::size_t lPose = 1; lPose < pPoses.size(); ++lPose)
+        {
+            const LocalPose& lOther = *pPoses[lPose];
+            const float lWeight = pWeights[lPose] / lTotal;
+            std::size_t j = 0;
+
+            #if defined(__SSE2__)
+                const __m128 lWeights = _mm_set1_ps(lWeight);
+                const __m128 lZero = _mm_setzero_ps();
+                const __m128 lSignBit = _mm_set1_ps(-0.0f);
+                for (; j + 4 <= lCount; j += 4)
+                {
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        _mm_storeu_ps(&mTranslation[c][j], _mm_add_ps(_mm_loadu_ps(&mTranslation[c][j]),
+                            _mm_mul_ps(_mm_loadu_ps(&lOther.mTranslation[c][j]), lWeights)));
+                        _mm_storeu_ps(&mScale[c][j], _mm_add_ps(_mm_loadu_ps(&mScale[c][j]),
+                            _mm_mul_ps(_mm_loadu_ps(&lOther.mScale[c][j]), lWeights)));
+                    }
+
+                    // Flip the weight of rotations on the other hemisphere
+                    // from the first pose's.
+                    __m128 lDot = lZero;
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        lDot = _mm_add_ps(lDot, _mm_mul_ps(_mm_loadu_ps(&pPoses[0]->mRotation[c][j]),
+                            _mm_loadu_ps(&lOther.mRotation[c][j])));
+                    }
+
+                    const __m128 lSigned = _mm_xor_ps(lWeights,
+                        _mm_and_ps(_mm_cmplt_ps(lDot, lZero), lSignBit));
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        _mm_storeu_ps(&mRotation[c][j], _mm_add_ps(_mm_loadu_ps(&mRotation[c][j]),
+                            _mm_mul_ps(_mm_loadu_ps(&lOther.mRotation[c][j]), lSigned)));
+                    }
+                }
+            #endif
+
+            for (; j < lCount; ++j)
+            {
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    mTranslation[c][j] += lOther.mTranslation[c][j] * lWeight;
+                    mScale[c][j] += lOther.mScale[c][j] * lWeight;
+                }
+
+                float lDot = 0.0f;
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    lDot += pPoses[0]->mRotation[c][j] * lOther.mRotation[c][j];
+                }
+
+                const float lSigned = (lDot < 0.0f) ? -lWeight : lWeight;
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    mRotation[c][j] += lOther.mRotation[c][j] * lSigned;
+                }
+            }
+        }
+
+        // Normalize the summed rotations.
+        std::size_t j = 0;
+
+        #if defined(__SSE2__)
+            for (; j + 4 <= lCount; j += 4)
+            {
+                __m128 lLengthSquared = _mm_setzero_ps();
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    const __m128 lValue = _mm_loadu_ps(&mRotation[c][j]);
+                    lLengthSquared = _mm_add_ps(lLengthSquared, _mm_mul_ps(lValue, lValue));
+                }
+
+                const __m128 lLength = _mm_sqrt_ps(lLengthSquared);
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    _mm_storeu_ps(&mRotation[c][j], _mm_div_ps(_mm_loadu_ps(&mRotation[c][j]), lLength));
+                }
+            }
+        #endif
+
+        for (; j < lCount; ++j)
+        {
+            float lLengthSquared = 0.0f;
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                lLengthSquared += mRotation[c][j] * mRotation[c][j];
+            }
+
+            const float lLength = std::sqrt(lLengthSquared);
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                mRotation[c][j] /= lLength;
+            }
+        }
+    }
+
+    void LocalPose::ComputeModelMatrices (
+        const Skeleton&         pSkeleton,
+        std::vector<Matrix4f>&  pMatrices
+    ) const
+    {
+        const std::size_t lCount = pSkeleton.GetJointCount();
+        if (mJointCount != lCount)
+        {
+            ACE_THROW(std::invalid_argument, "{}: The pose does not match the skeleton!",
+                "LocalPose");
+        }
+
+        pMatrices.resize(lCount);
+        std::size_t j = 0;
+
+        #if defined(__SSE2__)
+            // Build four joints' local matrices at once: each element of the
+            // matrix is worked out for all four joints, then each column is
+            // transposed out to the four joints' matrices.
+            const __m128 lOne = _mm_set1_ps(1.0f);
+            const __m128 lTwo = _mm_set1_ps(2.0f);
+            for (; j + 4 <= lCount; j += 4)
+            {
+                const __m128 lX = _mm_loadu_ps(&mRotation[0][j]);
+                const __m128 lY = _mm_loadu_ps(&mRotation[1][j]);
+                const __m128 lZ = _mm_loadu_ps(&mRotation[2][j]);
+                const __m128 lW = _mm_loadu_ps(&mRotation[3][j]);
+                const __m128 lXX = _mm_mul_ps(lX, lX);
+                const __m128 lYY = _mm_mul_ps(lY, lY);
+                const __m128 lZZ = _mm_mul_ps(lZ, lZ);
+                const __m128 lXY = _mm_mul_ps(lX, lY);
+                const __m128 lXZ = _mm_mul_ps(lX, lZ);
+                const __m128 lYZ = _mm_mul_ps(lY, lZ);
+                const __m128 lWX = _mm_mul_ps(lW, lX);
+                const __m128 lWY = _mm_mul_ps(lW, lY);
+                const __m128 lWZ = _mm_mul_ps(lW, lZ);
+                const __m128 lScaleX = _mm_loadu_ps(&mScale[0][j]);
+                const __m128 lScaleY = _mm_loadu_ps(&mScale[1][j]);
+                const __m128 lScaleZ = _mm_loadu_ps(&mScale[2][j]);
+
+                __m128 lColumns[4][4] = {
+                    {
+                        _mm_mul_ps(_mm_sub_ps(lOne, _mm_mul_ps(lTwo, _mm_add_ps(lYY, lZZ))), lScaleX),
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_add_ps(lXY, lWZ)), lScaleX),
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_sub_ps(lXZ, lWY)), lScaleX),
+                        _mm_setzero_ps()
+                    },
+                    {
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_sub_ps(lXY, lWZ)), lScaleY),
+                        _mm_mul_ps(_mm_sub_ps(lOne, _mm_mul_ps(lTwo, _mm_add_ps(lXX, lZZ))), lScaleY),
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_add_ps(lYZ, lWX)), lScaleY),
+                        _mm_setzero_ps()
+                    },
+                    {
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_add_ps(lXZ, lWY)), lScaleZ),
+                        _mm_mul_ps(_mm_mul_ps(lTwo, _mm_sub_ps(lYZ, lWX)), lScaleZ),
+                        _mm_mul_ps(_mm_sub_ps(lOne, _mm_mul_ps(lTwo, _mm_add_ps(lXX, lYY))), lScaleZ),
+                        _mm_setzero_ps()
+                    },
+                    {
+                        _mm_loadu_ps(&mTranslation[0][j]),
+                        _mm_loadu_ps(&mTranslation[1][j]),
+                        _mm_loadu_ps(&mTranslation[2][j]),
+                        lOne
+                    }
+                };
+
+                for (std::size_t lColumn = 0; lColumn < 4; ++lColumn)
+                {
+                    __m128* lRows = lColumns[lColumn];
+                    _MM_TRANSPOSE4_PS(lRows[0], lRows[1], lRows[2], lRows[3]);
+                    for (std::size_t k = 0; k < 4; ++k)
+                    {
+                        _mm_storeu_ps(pMatrices[j + k].mI.data() + lColumn * 4, lRows[k]);
+                    }
+                }
+            }
+        #endif
+
+        for (; j < lCount; ++j)
+        {
+            ComposeJoint(*this, j, pMatrices[j]);
+        }
+
+        // Parents come first, so each parent's matrix is already in model
+        // space by the time its children need it.
+        for (j = 0; j < lCount; ++j)
+        {
+            const std::int32_t lParent = pSkeleton.mParents[j];
+            if (lParent >= static_cast<std::int32_t>(j))
+            {
+                ACE_THROW(std::invalid_argument, "{}: Joint {} comes before its parent!",
+                    "LocalPose", j);
+            }
+
+            if (lParent >= 0)
+            {
+                MultiplyInPlace(pMatrices[lParent], pMatrices[j]);
+            }
+        }
+    }
+
+}
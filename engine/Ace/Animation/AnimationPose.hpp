@@ -0,0 +1,159 @@
+/**
+ * @file    Ace/Animation/AnimationPose.hpp
+ * @brief   Provides skeletons, and poses stored as streams of joint
+ *          components, which are blended and converted to model space four
+ *          joints at a time.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+#include <Ace/Maths/Matrix4.hpp>
+#include <Ace/Maths/Quaternion4.hpp>
+
+namespace ace
+{
+
+    struct Skeleton;
+
+    /**
+     * @brief   A structure containing the translation, rotation and scale of
+     *          each joint of a skeleton, relative to its parent.
+     *
+     * Each component is kept in a stream of its own, joint after joint, so
+     * that the kernels working on poses read and write four joints at once.
+     */
+    struct ACE_API LocalPose
+    {
+        std::size_t                         mJointCount = 0;    ///< @brief The number of joints in the pose.
+        std::array<std::vector<float>, 3>   mTranslation;       ///< @brief The X, Y and Z streams of each joint's translation.
+        std::array<std::vector<float>, 4>   mRotation;          ///< @brief The X, Y, Z and W streams of each joint's rotation.
+        std::array<std::vector<float>, 3>   mScale;             ///< @brief The X, Y and Z streams of each joint's scale.
+
+        /**
+         * @brief   Resizes the pose, setting any new joints to the identity.
+         *
+         * @param   pJointCount The new number of joints.
+         */
+        void Resize (
+            const std::size_t   pJointCount
+        );
+
+        /**
+         * @brief   Sets one joint's transform.
+         *
+         * @param   pJoint          The joint's index.
+         * @param   pTranslation    The joint's translation.
+         * @param   pRotation       The joint's rotation.
+         * @param   pScale          The joint's scale.
+         */
+        void SetJoint (
+            const std::size_t   pJoint,
+            const Vector3f&     pTranslation,
+            const Quaternion4f& pRotation,
+            const Vector3f&     pScale = { 1.0f, 1.0f, 1.0f }
+        );
+
+        /**
+         * @brief   Sets this pose to a blend of several poses of the same
+         *          skeleton, by weight.
+         *
+         * Translations and scales are averaged; rotations are averaged then
+         * normalized, each first flipped onto the same hemisphere as the
+         * first pose's, which matches a normalized lerp for two poses.
+         *
+         * @param   pPoses      The poses to blend. Must not include this pose.
+         * @param   pWeights    Each pose's weight. Weights need not sum to
+         *                      one.
+         *
+         * @throw   `std::invalid_argument` if there are no poses, the counts
+         *          of poses and weights differ, the poses' joint counts
+         *          differ, or the weights do not sum to a positive number.
+         */
+        void Blend (
+            std::span<const LocalPose* const>   pPoses,
+            std::span<const float>              pWeights
+        );
+
+        /**
+         * @brief   Converts this pose into each joint's model-space transform.
+         *
+         * The joints' local matrices are built four at a time, then each is
+         * multiplied by its parent's model matrix, in order.
+         *
+         * @param   pSkeleton   The skeleton this pose belongs to.
+         * @param   pMatrices   The list to write each joint's model matrix to.
+         *
+         * @throw   `std::invalid_argument` if this pose's joint count does not
+         *          match the skeleton's, or a joint's parent does not come
+         *          before it.
+         */
+        void ComputeModelMatrices (
+            const Skeleton&         pSkeleton,
+            std::vector<Matrix4f>&  pMatrices
+        ) const;
+
+        /**
+         * @brief   Retrieves one joint's translation.
+         *
+         * @param   pJoint  The joint's index.
+         *
+         * @return  The joint's translation.
+         */
+        inline Vector3f GetTranslation (
+            const std::size_t   pJoint
+        ) const
+        {
+            return { mTranslation[0][pJoint], mTranslation[1][pJoint], mTranslation[2][pJoint] };
+        }
+
+        /**
+         * @brief   Retrieves one joint's rotation.
+         *
+         * @param   pJoint  The joint's index.
+         *
+         * @return  The joint's rotation.
+         */
+        inline Quaternion4f GetRotation (
+            const std::size_t   pJoint
+        ) const
+        {
+            return { mRotation[0][pJoint], mRotation[1][pJoint], mRotation[2][pJoint], mRotation[3][pJoint] };
+        }
+
+        /**
+         * @brief   Retrieves one joint's scale.
+         *
+         * @param   pJoint  The joint's index.
+         *
+         * @return  The joint's scale.
+         */
+        inline Vector3f GetScale (
+            const std::size_t   pJoint
+        ) const
+        {
+            return { mScale[0][pJoint], mScale[1][pJoint], mScale[2][pJoint] };
+        }
+    };
+
+    /**
+     * @brief   A structure containing the hierarchy of a skeleton's joints,
+     *          and the pose it rests in.
+     */
+    struct Skeleton
+    {
+        std::vector<std::int32_t>   mParents;   ///< @brief Each joint's parent, or -1 for a root. Parents come before their children.
+        LocalPose                   mBindPose;  ///< @brief The pose used when a character plays no clips.
+
+        /**
+         * @brief   Retrieves the number of joints in the skeleton.
+         *
+         * @return  The number of joints.
+         */
+        inline std::size_t GetJointCount () const
+        {
+            return mParents.size();
+        }
+    };
+
+}
@@ -0,0 +1,107 @@
+/**
+ * @file    Ace/Animation/Animator.cpp
+ */
+
+#include <Ace/Animation/Animator.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    Animator::Animator (
+        const AnimatorSpec& pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    void Animator::Evaluate (
+        std::span<AnimatedCharacter>    pCharacters
+    ) const
+    {
+        // Check every character up front, so that a bad one is reported on
+        // the calling thread rather than from inside a worker.
+        for (const AnimatedCharacter& lCharacter : pCharacters)
+        {
+            if (lCharacter.mSkeleton == nullptr || lCharacter.mLayerCount > MAX_ANIMATION_LAYERS)
+            {
+                ACE_THROW(std::invalid_argument, "{}: A character has no skeleton, or too many layers!",
+                    "Animator");
+            }
+
+            for (std::size_t i = 0; i < lCharacter.mLayerCount; ++i)
+            {
+                const AnimationClip* lClip = lCharacter.mLayers[i].mClip;
+                if (lClip == nullptr || lClip->GetJointCount() != lCharacter.mSkeleton->GetJointCount())
+                {
+                    ACE_THROW(std::invalid_argument, "{}: A character's clip does not fit its skeleton!",
+                        "Animator");
+                }
+            }
+        }
+
+        auto lEvaluate =
+            [this, pCharacters] (const std::size_t pIndex)
+            {
+                EvaluateCharacter(pCharacters[pIndex]);
+            };
+
+        if (mSpec.mThreadPool != nullptr && pCharacters.size() > mSpec.mGrainSize)
+        {
+            mSpec.mThreadPool->ParallelFor(pCharacters.size(), lEvaluate, mSpec.mGrainSize);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < pCharacters.size(); ++i)
+            {
+                lEvaluate(i);
+            }
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    void Animator::EvaluateCharacter (
+        AnimatedCharacter&  pCharacter
+    ) const
+    {
+        // Scratch poses are kept per thread, so that after the first few
+        // characters no thread allocates.
+        thread_local std::array<LocalPose, MAX_ANIMATION_LAYERS> sLayerPoses;
+        thread_local LocalPose sBlendedPose;
+
+        const Skeleton& lSkeleton = *pCharacter.mSkeleton;
+        if (pCharacter.mLayerCount == 0)
+        {
+            lSkeleton.mBindPose.ComputeModelMatrices(lSkeleton, pCharacter.mModelMatrices);
+            return;
+        }
+
+        std::array<const LocalPose*, MAX_ANIMATION_LAYERS> lPoses {};
+        std::array<float, MAX_ANIMATION_LAYERS> lWeights {};
+        for (std::size_t i = 0; i < pCharacter.mLayerCount; ++i)
+        {
+            const AnimationLayer& lLayer = pCharacter.mLayers[i];
+            lLayer.mClip->Sample(lLayer.mTime, sLayerPoses[i]);
+            lPoses[i] = &sLayerPoses[i];
+            lWeights[i] = lLayer.mWeight;
+        }
+
+        if (pCharacter.mLayerCount == 1)
+        {
+            sLayerPoses[0].ComputeModelMatrices(lSkeleton, pCharacter.mModelMatrices);
+            return;
+        }
+
+        sBlendedPose.Blend(
+            std::span<const LocalPose* const> { lPoses.data(), pCharacter.mLayerCount },
+            std::span<const float> { lWeights.data(), pCharacter.mLayerCount }
+        );
+        sBlendedPose.ComputeModelMatrices(lSkeleton, pCharacter.mModelMatrices);
+    }
+
+}
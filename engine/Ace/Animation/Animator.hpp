@@ -0,0 +1,112 @@
+/**
+ * @file    Ace/Animation/Animator.hpp
+ * @brief   Provides a class used for evaluating many animated characters'
+ *          poses at once.
+ */
+
+#pragma once
+#include <Ace/Animation/AnimationClip.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   The most clips a character can blend together at once.
+     */
+    constexpr std::size_t MAX_ANIMATION_LAYERS = 4;
+
+    /**
+     * @brief   A structure describing one clip a character is playing.
+     */
+    struct AnimationLayer
+    {
+        const AnimationClip*    mClip = nullptr;    ///< @brief The clip being played.
+        float                   mTime = 0.0f;       ///< @brief The time to sample the clip at, in seconds.
+        float                   mWeight = 1.0f;     ///< @brief The layer's weight in the blend.
+    };
+
+    /**
+     * @brief   A structure containing one animated character: the clips it is
+     *          playing, and the model-space transforms they pose it in.
+     */
+    struct AnimatedCharacter
+    {
+        const Skeleton*                                     mSkeleton = nullptr;    ///< @brief The character's skeleton.
+        std::array<AnimationLayer, MAX_ANIMATION_LAYERS>    mLayers;                ///< @brief The clips the character is playing.
+        std::size_t                                         mLayerCount = 0;        ///< @brief The number of layers in use.
+        std::vector<Matrix4f>                               mModelMatrices;         ///< @brief Each joint's model-space transform, written by the animator.
+    };
+
+    /**
+     * @brief   A structure containing the settings an @a `Animator` is
+     *          created with.
+     */
+    struct AnimatorSpec
+    {
+        ThreadPool*     mThreadPool = nullptr;  ///< @brief The thread pool to evaluate on, or `nullptr` to evaluate on the calling thread.
+        std::size_t     mGrainSize = 16;        ///< @brief The number of characters each thread claims at once.
+    };
+
+    /**
+     * @brief   A class used for evaluating many animated characters' poses at
+     *          once.
+     *
+     * Each character's layers are sampled, blended, and converted to model
+     * space independently of every other character's, so characters are
+     * spread across the thread pool, each thread reusing its own scratch
+     * poses. The results do not depend on how the characters are spread.
+     */
+    class ACE_API Animator final
+    {
+    public:
+
+        /**
+         * @brief   Creates an animator.
+         *
+         * @param   pSpec   The animator's settings.
+         */
+        explicit Animator (
+            const AnimatorSpec& pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Evaluates every character's model-space transforms.
+         *
+         * A character playing no clips is posed in its skeleton's bind pose.
+         *
+         * @param   pCharacters The characters to evaluate.
+         *
+         * @throw   `std::invalid_argument` if a character has no skeleton, has
+         *          too many layers, or plays a clip animating a different
+         *          number of joints than its skeleton has. Nothing is
+         *          evaluated in that case.
+         */
+        void Evaluate (
+            std::span<AnimatedCharacter>    pCharacters
+        ) const;
+
+    private:
+        Animator (const Animator&) = delete;
+        Animator (Animator&&) = delete;
+        void operator= (const Animator&) = delete;
+        void operator= (Animator&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Evaluates one character, using the calling thread's
+         *          scratch poses.
+         */
+        void EvaluateCharacter (
+            AnimatedCharacter&  pCharacter
+        ) const;
+
+    private:
+        AnimatorSpec    mSpec;  ///< @brief The animator's settings.
+
+    };
+
+}
@@ -0,0 +1,50 @@
+/**
+ * @file    Ace/Audio/AudioClip.cpp
+ */
+
+#include <Ace/Audio/AudioClip.hpp>
+#include <Ace/Audio/WaveDecoder.hpp>
+
+namespace ace
+{
+
+    /* Public Methods *********************************************************/
+
+    bool WaveClipLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".wav");
+    }
+
+    std::shared_ptr<AudioClip> WaveClipLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        try
+        {
+            WaveDecoder lDecoder { std::move(pVirtualFile) };
+
+            auto lClip = std::make_shared<AudioClip>();
+            lClip->mSampleRate = lDecoder.GetSampleRate();
+            lClip->mChannelCount = lDecoder.GetChannelCount();
+            lClip->mSamples.resize(
+                lDecoder.GetFrameCount() * lDecoder.GetChannelCount());
+
+            std::size_t lFrames = lDecoder.Decode(lClip->mSamples.data(),
+                lDecoder.GetFrameCount());
+            lClip->mSamples.resize(lFrames * lDecoder.GetChannelCount());
+
+            return lClip;
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+}
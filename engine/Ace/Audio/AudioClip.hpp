@@ -0,0 +1,54 @@
+/**
+ * @file    Ace/Audio/AudioClip.hpp
+ * @brief   Provides a structure containing fully-decoded audio, and an asset
+ *          loader which decodes it from `.wav` files.
+ */
+
+#pragma once
+#include <Ace/System/AssetRegistry.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing a short piece of fully-decoded audio,
+     *          such as a sound effect, held in memory.
+     */
+    struct AudioClip
+    {
+        std::uint32_t       mSampleRate = 0;    ///< @brief The audio's sample rate.
+        std::uint32_t       mChannelCount = 0;  ///< @brief The audio's channel count; either one or two.
+        std::vector<float>  mSamples;           ///< @brief The audio's interleaved samples.
+
+        /**
+         * @brief   Retrieves the number of frames in the audio.
+         *
+         * @return  The number of frames.
+         */
+        inline std::size_t GetFrameCount () const
+        {
+            return (mChannelCount != 0) ? mSamples.size() / mChannelCount : 0;
+        }
+    };
+
+    /**
+     * @brief   An asset loader which decodes @a `AudioClip`s from `.wav`
+     *          files.
+     */
+    class ACE_API WaveClipLoader final : public IAssetLoader<AudioClip>
+    {
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<AudioClip> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    };
+
+}
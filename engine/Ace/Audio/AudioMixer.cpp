@@ -0,0 +1,710 @@
+/**
+ * @file    Ace/Audio/AudioMixer.cpp
+ */
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include <numbers>
+#include <Ace/Audio/AudioMixer.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    AudioMixer::AudioMixer (
+        const AudioMixerSpec&   pSpec
+    ) :
+        mSpec           { pSpec },
+        mCommands       { std::make_unique<CommandQueue>() },
+        mFinishedVoices { std::make_unique<FinishedQueue>() }
+    {
+        if (
+            pSpec.mSampleRate == 0 ||
+            pSpec.mBlockFrames == 0 ||
+            pSpec.mVoiceCount == 0
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Settings must not be zero!",
+                "AudioMixer");
+        }
+
+        // Allocate everything the mixer thread will ever need up front, so
+        // that it never has to allocate.
+        mVoices.resize(pSpec.mVoiceCount);
+        mFreeVoices.reserve(pSpec.mVoiceCount);
+        mActiveVoices.reserve(pSpec.mVoiceCount);
+        for (std::size_t i = pSpec.mVoiceCount; i > 0; --i)
+        {
+            mFreeVoices.push_back(i - 1);
+        }
+
+        const std::size_t lMaxSourceFrames = static_cast<std::size_t>(
+            MAX_PITCH * (pSpec.mBlockFrames - 1)) + 2;
+        mGather.resize(lMaxSourceFrames * 2);
+        mResampled.resize(pSpec.mBlockFrames * 2);
+        mOutput.resize(pSpec.mBlockFrames * 2);
+
+        for (std::size_t i = 0; i < pSpec.mStreamCount; ++i)
+        {
+            auto lStream = std::make_unique<Stream>();
+            lStream->mFrames.resize(STREAM_BUFFER_FRAMES * 2);
+            mStreams.push_back(std::move(lStream));
+            mFreeStreams.push_back(pSpec.mStreamCount - i - 1);
+        }
+    }
+
+    AudioMixer::~AudioMixer ()
+    {
+        Stop();
+    }
+
+    /* Public Methods *********************************************************/
+
+    void AudioMixer::Start (
+        IAudioSink& pSink
+    )
+    {
+        // If the mixer is currently running, then early out.
+        if (mRunning.exchange(true) == true)
+        {
+            return;
+        }
+
+        mSink = &pSink;
+
+        const auto lPeriod = std::chrono::duration_cast<
+            std::chrono::steady_clock::duration>(
+                std::chrono::duration<double> {
+                    static_cast<double>(mSpec.mBlockFrames) / mSpec.mSampleRate
+                }
+            );
+
+        // The mixer thread mixes one block per block period, pacing itself
+        // against absolute deadlines so that timing errors do not accumulate.
+        mMixerThread = std::thread {
+            [this, lPeriod] -> void
+            {
+                auto lDeadline = std::chrono::steady_clock::now();
+                while (mRunning.load(std::memory_order_relaxed) == true)
+                {
+                    MixBlock();
+                    mSink->Write(mOutput.data(), mSpec.mBlockFrames);
+
+                    lDeadline += lPeriod;
+                    std::this_thread::sleep_until(lDeadline);
+                }
+            }
+        };
+
+        // The streaming thread tops up the streams' queues a few times per
+        // block period, which is far more often than they can run dry.
+        mStreamThread = std::thread {
+            [this, lPeriod] -> void
+            {
+                while (mRunning.load(std::memory_order_relaxed) == true)
+                {
+                    RefillStreams();
+                    std::this_thread::sleep_for(lPeriod / 2);
+                }
+            }
+        };
+    }
+
+    void AudioMixer::Stop ()
+    {
+        // If the mixer is not running, early out.
+        if (mRunning.exchange(false) == false)
+        {
+            return;
+        }
+
+        if (mMixerThread.joinable() == true)
+        {
+            mMixerThread.join();
+        }
+
+        if (mStreamThread.joinable() == true)
+        {
+            mStreamThread.join();
+        }
+
+        mSink = nullptr;
+    }
+
+    void AudioMixer::Render (
+        IAudioSink&         pSink,
+        const std::size_t&  pBlocks
+    )
+    {
+        for (std::size_t i = 0; i < pBlocks; ++i)
+        {
+            RefillStreams();
+            MixBlock();
+            pSink.Write(mOutput.data(), mSpec.mBlockFrames);
+        }
+    }
+
+    VoiceHandle AudioMixer::Play (
+        const AssetHandle<AudioClip>&   pClip,
+        const VoiceParams&              pParams
+    )
+    {
+        if (
+            pClip.IsValid() == false ||
+            pClip->mSampleRate == 0 ||
+            (pClip->mChannelCount != 1 && pClip->mChannelCount != 2)
+        )
+        {
+            return 0;
+        }
+
+        std::lock_guard lGuard { mGameMutex };
+
+        Command lCommand;
+        lCommand.mClip = pClip.Get();
+        lCommand.mParams = pParams;
+
+        // Keep the clip alive until the mixer thread reports that it is done
+        // with it.
+        VoiceHandle lVoice = QueuePlay(lCommand);
+        if (lVoice != 0)
+        {
+            mClipVoices.emplace(lVoice, pClip);
+        }
+
+        return lVoice;
+    }
+
+    VoiceHandle AudioMixer::PlayStream (
+        const std::string&  pLogicalPath,
+        const VoiceParams&  pParams
+    )
+    {
+        // Open the file and parse its header before taking any locks.
+        std::unique_ptr<WaveDecoder> lDecoder = nullptr;
+        try
+        {
+            auto lFile = VFS::OpenFile(pLogicalPath);
+            if (lFile == nullptr)
+            {
+                return 0;
+            }
+
+            lDecoder = std::make_unique<WaveDecoder>(std::move(lFile));
+        }
+        catch (const std::exception&)
+        {
+            return 0;
+        }
+
+        std::lock_guard lGuard { mGameMutex };
+        if (mFreeStreams.empty() == true)
+        {
+            return 0;
+        }
+
+        // Hand the decoder to a free stream slot, resetting its queue.
+        std::size_t lIndex = mFreeStreams.back();
+        Stream& lStream = *mStreams[lIndex];
+        {
+            std::lock_guard lStreamGuard { lStream.mMutex };
+            lStream.mLooping = pParams.mLooping;
+            lStream.mChannelCount = lDecoder->GetChannelCount();
+            lStream.mSampleRate = lDecoder->GetSampleRate();
+            lStream.mWritten.store(0, std::memory_order_relaxed);
+            lStream.mRead.store(0, std::memory_order_relaxed);
+            lStream.mEnded.store(false, std::memory_order_relaxed);
+            lStream.mDecoder = std::move(lDecoder);
+        }
+
+        Command lCommand;
+        lCommand.mStream = &lStream;
+        lCommand.mParams = pParams;
+
+        VoiceHandle lVoice = QueuePlay(lCommand);
+        if (lVoice == 0)
+        {
+            std::lock_guard lStreamGuard { lStream.mMutex };
+            lStream.mDecoder.reset();
+            return 0;
+        }
+
+        mFreeStreams.pop_back();
+        mStreamVoices.emplace(lVoice, lIndex);
+        return lVoice;
+    }
+
+    void AudioMixer::StopVoice (
+        const VoiceHandle&  pVoice
+    )
+    {
+        Command lCommand;
+        lCommand.mType = CommandType::Stop;
+        lCommand.mVoice = pVoice;
+        mCommands->Enqueue(lCommand);
+    }
+
+    void AudioMixer::SetVoiceGain (
+        const VoiceHandle&  pVoice,
+        const float         pGain,
+        const float         pPan
+    )
+    {
+        Command lCommand;
+        lCommand.mType = CommandType::SetGain;
+        lCommand.mVoice = pVoice;
+        lCommand.mParams.mGain = pGain;
+        lCommand.mParams.mPan = pPan;
+        mCommands->Enqueue(lCommand);
+    }
+
+    void AudioMixer::SetVoicePitch (
+        const VoiceHandle&  pVoice,
+        const float         pPitch
+    )
+    {
+        Command lCommand;
+        lCommand.mType = CommandType::SetPitch;
+        lCommand.mVoice = pVoice;
+        lCommand.mParams.mPitch = pPitch;
+        mCommands->Enqueue(lCommand);
+    }
+
+    void AudioMixer::Update ()
+    {
+        std::lock_guard lGuard { mGameMutex };
+
+        while (auto lVoice = mFinishedVoices->Dequeue())
+        {
+            mClipVoices.erase(lVoice.value());
+
+            // The mixer thread is done with a finished voice's stream, so its
+            // slot can be reclaimed, closing its file.
+            auto lIter = mStreamVoices.find(lVoice.value());
+            if (lIter != mStreamVoices.end())
+            {
+                Stream& lStream = *mStreams[lIter->second];
+                {
+                    std::lock_guard lStreamGuard { lStream.mMutex };
+                    lStream.mDecoder.reset();
+                }
+
+                mFreeStreams.push_back(lIter->second);
+                mStreamVoices.erase(lIter);
+            }
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    VoiceHandle AudioMixer::QueuePlay (
+        Command pCommand
+    )
+    {
+        pCommand.mType = CommandType::Play;
+        pCommand.mVoice = mNextHandle.fetch_add(1, std::memory_order_relaxed);
+        if (mCommands->Enqueue(pCommand) == false)
+        {
+            return 0;
+        }
+
+        return pCommand.mVoice;
+    }
+
+    void AudioMixer::MixBlock ()
+    {
+        const auto lStart = std::chrono::steady_clock::now();
+        const std::size_t N = mSpec.mBlockFrames;
+
+        while (auto lCommand = mCommands->Dequeue())
+        {
+            ApplyCommand(lCommand.value());
+        }
+
+        std::fill(mOutput.begin(), mOutput.end(), 0.0f);
+
+        for (std::size_t lSlot = 0; lSlot < mActiveVoices.size(); )
+        {
+            Voice& lVoice = mVoices[mActiveVoices[lSlot]];
+            if (lVoice.mFinished == false)
+            {
+                // Work out which source frames this block needs: every frame
+                // the block's positions fall on, plus one more to interpolate
+                // towards.
+                const float lEnd = lVoice.mFraction + lVoice.mStep * N;
+                const std::size_t lAdvance = static_cast<std::size_t>(lEnd);
+                const std::size_t lCount = static_cast<std::size_t>(
+                    lVoice.mFraction + lVoice.mStep * (N - 1)) + 2;
+                GatherFrames(lVoice, lCount, lAdvance);
+
+                // Resample the source frames to stereo frames at the mixer's
+                // rate, with linear interpolation.
+                const float* lSource = mGather.data();
+                float* lResampled = mResampled.data();
+                if (lVoice.mChannelCount == 1)
+                {
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        const float lPosition = lVoice.mFraction + lVoice.mStep * i;
+                        const std::size_t j = static_cast<std::size_t>(lPosition);
+                        const float t = lPosition - j;
+                        const float lSample =
+                            lSource[j] + (lSource[j + 1] - lSource[j]) * t;
+                        lResampled[i * 2 + 0] = lSample;
+                        lResampled[i * 2 + 1] = lSample;
+                    }
+                }
+                else
+                {
+                    for (std::size_t i = 0; i < N; ++i)
+                    {
+                        const float lPosition = lVoice.mFraction + lVoice.mStep * i;
+                        const std::size_t j = static_cast<std::size_t>(lPosition);
+                        const float t = lPosition - j;
+                        lResampled[i * 2 + 0] = lSource[j * 2 + 0] +
+                            (lSource[j * 2 + 2] - lSource[j * 2 + 0]) * t;
+                        lResampled[i * 2 + 1] = lSource[j * 2 + 1] +
+                            (lSource[j * 2 + 3] - lSource[j * 2 + 1]) * t;
+                    }
+                }
+                lVoice.mFraction = lEnd - lAdvance;
+
+                // Accumulate the voice into the mix, ramping its gains from
+                // where they were to where they should be over the block.
+                const float lStepLeft =
+                    (lVoice.mTargetLeft - lVoice.mGainLeft) / N;
+                const float lStepRight =
+                    (lVoice.mTargetRight - lVoice.mGainRight) / N;
+                float* lOutput = mOutput.data();
+
+                std::size_t i = 0;
+                #if defined(__SSE2__)
+                {
+                    // Two stereo frames, four samples, at a time.
+                    __m128 lGains = _mm_setr_ps(
+                        lVoice.mGainLeft, lVoice.mGainRight,
+                        lVoice.mGainLeft + lStepLeft,
+                        lVoice.mGainRight + lStepRight
+                    );
+                    const __m128 lGainSteps = _mm_setr_ps(
+                        lStepLeft * 2.0f, lStepRight * 2.0f,
+                        lStepLeft * 2.0f, lStepRight * 2.0f
+                    );
+
+                    for (; i + 2 <= N; i += 2)
+                    {
+                        __m128 lMix = _mm_loadu_ps(lOutput + i * 2);
+                        __m128 lSamples = _mm_loadu_ps(lResampled + i * 2);
+                        lMix = _mm_add_ps(lMix, _mm_mul_ps(lSamples, lGains));
+                        _mm_storeu_ps(lOutput + i * 2, lMix);
+                        lGains = _mm_add_ps(lGains, lGainSteps);
+                    }
+                }
+                #endif
+
+                for (; i < N; ++i)
+                {
+                    lOutput[i * 2 + 0] += lResampled[i * 2 + 0] *
+                        (lVoice.mGainLeft + lStepLeft * i);
+                    lOutput[i * 2 + 1] += lResampled[i * 2 + 1] *
+                        (lVoice.mGainRight + lStepRight * i);
+                }
+
+                lVoice.mGainLeft = lVoice.mTargetLeft;
+                lVoice.mGainRight = lVoice.mTargetRight;
+
+                // A stopping voice has now faded out completely.
+                if (lVoice.mStopping == true)
+                {
+                    lVoice.mFinished = true;
+                }
+            }
+
+            // Report finished voices to game threads. If the report queue is
+            // full, try again next block.
+            if (
+                lVoice.mFinished == true &&
+                mFinishedVoices->Enqueue(lVoice.mHandle) == true
+            )
+            {
+                mFreeVoices.push_back(mActiveVoices[lSlot]);
+                mActiveVoices[lSlot] = mActiveVoices.back();
+                mActiveVoices.pop_back();
+                lVoice = Voice {};
+                continue;
+            }
+
+            ++lSlot;
+        }
+
+        // Apply the master gain, and clamp the mix to the valid range.
+        const float lMasterGain = mMasterGain.load(std::memory_order_relaxed);
+        std::size_t i = 0;
+        #if defined(__SSE2__)
+        {
+            const __m128 lGain = _mm_set1_ps(lMasterGain);
+            const __m128 lMin = _mm_set1_ps(-1.0f);
+            const __m128 lMax = _mm_set1_ps(1.0f);
+            for (; i + 4 <= mOutput.size(); i += 4)
+            {
+                __m128 lMix = _mm_mul_ps(_mm_loadu_ps(mOutput.data() + i), lGain);
+                _mm_storeu_ps(mOutput.data() + i,
+                    _mm_min_ps(_mm_max_ps(lMix, lMin), lMax));
+            }
+        }
+        #endif
+
+        for (; i < mOutput.size(); ++i)
+        {
+            mOutput[i] = std::clamp(mOutput[i] * lMasterGain, -1.0f, 1.0f);
+        }
+
+        mActiveVoiceCount.store(mActiveVoices.size(), std::memory_order_relaxed);
+        mLastMixNanoseconds.store(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - lStart).count(),
+            std::memory_order_relaxed
+        );
+    }
+
+    void AudioMixer::ApplyCommand (
+        const Command&  pCommand
+    )
+    {
+        if (pCommand.mType == CommandType::Play)
+        {
+            // If every voice is in use, the new voice finishes immediately.
+            if (mFreeVoices.empty() == true)
+            {
+                mFinishedVoices->Enqueue(pCommand.mVoice);
+                return;
+            }
+
+            std::size_t lIndex = mFreeVoices.back();
+            mFreeVoices.pop_back();
+            mActiveVoices.push_back(lIndex);
+
+            Voice& lVoice = mVoices[lIndex];
+            lVoice = Voice {};
+            lVoice.mHandle = pCommand.mVoice;
+            lVoice.mClip = pCommand.mClip;
+            lVoice.mStream = pCommand.mStream;
+            lVoice.mLooping = pCommand.mParams.mLooping;
+
+            std::uint32_t lSampleRate = 0;
+            if (lVoice.mClip != nullptr)
+            {
+                lVoice.mChannelCount = lVoice.mClip->mChannelCount;
+                lSampleRate = lVoice.mClip->mSampleRate;
+            }
+            else
+            {
+                lVoice.mChannelCount = lVoice.mStream->mChannelCount;
+                lSampleRate = lVoice.mStream->mSampleRate;
+            }
+
+            lVoice.mRateRatio =
+                static_cast<float>(lSampleRate) / mSpec.mSampleRate;
+            lVoice.mStep = std::clamp(lVoice.mRateRatio * pCommand.mParams.mPitch,
+                0.0f, MAX_PITCH);
+
+            // New voices fade in from silence over their first block.
+            SetTargetGains(lVoice, pCommand.mParams);
+            return;
+        }
+
+        // Every other command controls an existing voice; look it up.
+        Voice* lVoice = nullptr;
+        for (const auto& lIndex : mActiveVoices)
+        {
+            if (mVoices[lIndex].mHandle == pCommand.mVoice)
+            {
+                lVoice = &mVoices[lIndex];
+                break;
+            }
+        }
+
+        if (lVoice == nullptr || lVoice->mStopping == true)
+        {
+            return;
+        }
+
+        switch (pCommand.mType)
+        {
+            case CommandType::Stop:
+                lVoice->mTargetLeft = 0.0f;
+                lVoice->mTargetRight = 0.0f;
+                lVoice->mStopping = true;
+                break;
+            case CommandType::SetGain:
+                SetTargetGains(*lVoice, pCommand.mParams);
+                break;
+            case CommandType::SetPitch:
+                lVoice->mStep = std::clamp(
+                    lVoice->mRateRatio * pCommand.mParams.mPitch,
+                    0.0f, MAX_PITCH);
+                break;
+            default:
+                break;
+        }
+    }
+
+    void AudioMixer::GatherFrames (
+        Voice&              pVoice,
+        const std::size_t&  pCount,
+        const std::size_t&  pAdvance
+    )
+    {
+        const std::size_t lChannels = pVoice.mChannelCount;
+        float* lOut = mGather.data();
+
+        if (pVoice.mClip != nullptr)
+        {
+            const float* lSamples = pVoice.mClip->mSamples.data();
+            const std::size_t lFrames = pVoice.mClip->GetFrameCount();
+
+            // Copy the clip's frames in contiguous runs, wrapping around if
+            // looping, and padding with silence past the end otherwise.
+            std::size_t lPosition = pVoice.mPosition;
+            std::size_t lRemaining = pCount;
+            while (lRemaining > 0)
+            {
+                if (lPosition >= lFrames)
+                {
+                    if (pVoice.mLooping == false || lFrames == 0)
+                    {
+                        std::fill_n(lOut, lRemaining * lChannels, 0.0f);
+                        break;
+                    }
+
+                    lPosition %= lFrames;
+                }
+
+                std::size_t lRun = std::min(lRemaining, lFrames - lPosition);
+                std::copy_n(lSamples + lPosition * lChannels, lRun * lChannels,
+                    lOut);
+                lOut += lRun * lChannels;
+                lRemaining -= lRun;
+                lPosition += lRun;
+            }
+
+            pVoice.mPosition += pAdvance;
+            if (pVoice.mLooping == true && lFrames != 0)
+            {
+                pVoice.mPosition %= lFrames;
+            }
+            else if (pVoice.mPosition >= lFrames)
+            {
+                pVoice.mFinished = true;
+            }
+
+            return;
+        }
+
+        // Check whether the stream has ended before checking how many frames
+        // it has, so that no frames written before it ended are missed.
+        Stream& lStream = *pVoice.mStream;
+        const bool lEnded = lStream.mEnded.load(std::memory_order_acquire);
+        const std::size_t lWritten = lStream.mWritten.load(std::memory_order_acquire);
+        const std::size_t lRead = lStream.mRead.load(std::memory_order_relaxed);
+        const std::size_t lAvailable = lWritten - lRead;
+
+        // Peek at as many of the needed frames as are available, padding with
+        // silence if the stream is running behind, but only consume the
+        // frames this block advances past.
+        constexpr std::size_t MASK = STREAM_BUFFER_FRAMES - 1;
+        const std::size_t lPeeked = std::min(pCount, lAvailable);
+        for (std::size_t i = 0; i < lPeeked; ++i)
+        {
+            const float* lFrame =
+                lStream.mFrames.data() + ((lRead + i) & MASK) * lChannels;
+            for (std::size_t c = 0; c < lChannels; ++c)
+            {
+                lOut[i * lChannels + c] = lFrame[c];
+            }
+        }
+        std::fill_n(lOut + lPeeked * lChannels, (pCount - lPeeked) * lChannels,
+            0.0f);
+
+        const std::size_t lConsumed = std::min(pAdvance, lAvailable);
+        lStream.mRead.store(lRead + lConsumed, std::memory_order_release);
+
+        if (lEnded == true && lConsumed == lAvailable)
+        {
+            pVoice.mFinished = true;
+        }
+    }
+
+    void AudioMixer::RefillStreams ()
+    {
+        constexpr std::size_t MASK = STREAM_BUFFER_FRAMES - 1;
+
+        for (auto& lStreamPtr : mStreams)
+        {
+            Stream& lStream = *lStreamPtr;
+            std::lock_guard lGuard { lStream.mMutex };
+            if (
+                lStream.mDecoder == nullptr ||
+                lStream.mEnded.load(std::memory_order_relaxed) == true
+            )
+            {
+                continue;
+            }
+
+            // Decode straight into the queue, one contiguous run at a time.
+            const std::size_t lChannels = lStream.mChannelCount;
+            std::size_t lWritten = lStream.mWritten.load(std::memory_order_relaxed);
+            while (true)
+            {
+                const std::size_t lRead =
+                    lStream.mRead.load(std::memory_order_acquire);
+                const std::size_t lFree = STREAM_BUFFER_FRAMES - (lWritten - lRead);
+                if (lFree == 0)
+                {
+                    break;
+                }
+
+                const std::size_t lOffset = lWritten & MASK;
+                const std::size_t lRun = std::min(lFree,
+                    STREAM_BUFFER_FRAMES - lOffset);
+                const std::size_t lDecoded = lStream.mDecoder->Decode(
+                    lStream.mFrames.data() + lOffset * lChannels, lRun);
+
+                if (lDecoded == 0)
+                {
+                    if (
+                        lStream.mLooping == true &&
+                        lStream.mDecoder->GetFrameCount() != 0 &&
+                        lStream.mDecoder->Rewind() == true
+                    )
+                    {
+                        continue;
+                    }
+
+                    lStream.mEnded.store(true, std::memory_order_release);
+                    break;
+                }
+
+                lWritten += lDecoded;
+                lStream.mWritten.store(lWritten, std::memory_order_release);
+            }
+        }
+    }
+
+    void AudioMixer::SetTargetGains (
+        Voice&              pVoice,
+        const VoiceParams&  pParams
+    )
+    {
+        // Map the stereo position to an angle between zero and a quarter
+        // turn; its cosine and sine keep the total power constant.
+        const float lAngle = (std::clamp(pParams.mPan, -1.0f, 1.0f) + 1.0f) *
+            (std::numbers::pi_v<float> / 4.0f);
+        pVoice.mTargetLeft = pParams.mGain * std::cos(lAngle);
+        pVoice.mTargetRight = pParams.mGain * std::sin(lAngle);
+    }
+
+}
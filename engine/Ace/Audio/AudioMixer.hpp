@@ -0,0 +1,426 @@
+/**
+ * @file    Ace/Audio/AudioMixer.hpp
+ * @brief   Provides a class which mixes many voices of audio on a real-time
+ *          thread.
+ */
+
+#pragma once
+#include <Ace/Audio/AudioClip.hpp>
+#include <Ace/Audio/IAudioSink.hpp>
+#include <Ace/Audio/WaveDecoder.hpp>
+#include <Ace/System/RingBuffer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A handle to a voice played by an @a `AudioMixer`. Handles are
+     *          never reused; zero is never a valid handle.
+     */
+    using VoiceHandle = std::uint32_t;
+
+    /**
+     * @brief   A structure containing the parameters which a voice is played
+     *          with.
+     */
+    struct VoiceParams
+    {
+        float   mGain       = 1.0f;     ///< @brief The voice's linear gain.
+        float   mPan        = 0.0f;     ///< @brief The voice's stereo position, from `-1` (left) to `1` (right).
+        float   mPitch      = 1.0f;     ///< @brief The voice's playback rate, relative to its sample rate.
+        bool    mLooping    = false;    ///< @brief Loop the voice's audio until it is stopped?
+    };
+
+    /**
+     * @brief   A structure containing the settings an @a `AudioMixer` is
+     *          created with.
+     */
+    struct AudioMixerSpec
+    {
+        std::uint32_t   mSampleRate     = 48000;    ///< @brief The sample rate of the mixed audio.
+        std::size_t     mBlockFrames    = 256;      ///< @brief The number of frames mixed per block.
+        std::size_t     mVoiceCount     = 256;      ///< @brief The maximum number of voices played at once.
+        std::size_t     mStreamCount    = 16;       ///< @brief The maximum number of streamed voices played at once.
+    };
+
+    /**
+     * @brief   A class which mixes many voices of audio into stereo blocks, on
+     *          a real-time thread which never locks or allocates.
+     *
+     * Game threads control voices through methods which pass commands to the
+     * mixer thread through a lock-free @a `RingBuffer`; the mixer thread
+     * reports finished voices back through another. Short clips are played
+     * from memory. Long audio is streamed: a separate streaming thread decodes
+     * it from the VFS, ahead of the mixer thread, into lock-free
+     * single-producer, single-consumer queues.
+     *
+     * Each voice is resampled to the mixer's sample rate with linear
+     * interpolation. Changes in gain, and the starts and ends of voices, are
+     * ramped over one block to avoid clicks. Voices are accumulated into the
+     * mix four samples at a time with SSE2 where available.
+     */
+    class ACE_API AudioMixer final
+    {
+    public:
+
+        /**
+         * @brief   The maximum number of source frames a voice can advance by
+         *          per mixed frame, after accounting for its pitch and sample
+         *          rate.
+         */
+        static constexpr float MAX_PITCH = 4.0f;
+
+        /**
+         * @brief   The number of frames buffered ahead for each streamed voice.
+         */
+        static constexpr std::size_t STREAM_BUFFER_FRAMES = 16384;
+
+        /**
+         * @brief   The maximum number of commands which can be queued for the
+         *          mixer thread.
+         */
+        static constexpr std::size_t COMMAND_CAPACITY = 4096;
+
+    public:
+
+        /**
+         * @brief   Constructs a mixer with the given settings.
+         *
+         * @param   pSpec   The mixer's settings.
+         *
+         * @throw   `std::invalid_argument` if any setting is zero.
+         */
+        explicit AudioMixer (
+            const AudioMixerSpec&   pSpec = {}
+        );
+
+        /**
+         * @brief   The destructor stops the mixer, if it is running.
+         */
+        ~AudioMixer ();
+
+    public:
+
+        /**
+         * @brief   Starts the mixer and streaming threads. The mixer thread
+         *          writes one block to the given sink per block period.
+         *
+         * @param   pSink   The sink to write mixed audio to. It must outlive
+         *                  the mixer, or the next call to @a `Stop`.
+         */
+        void Start (
+            IAudioSink& pSink
+        );
+
+        /**
+         * @brief   Stops the mixer and streaming threads, if they are running.
+         */
+        void Stop ();
+
+        /**
+         * @brief   Mixes the given number of blocks on the calling thread, as
+         *          fast as possible, writing them to the given sink. Streamed
+         *          voices are refilled between blocks.
+         *
+         * This method must not be called while the mixer is running.
+         *
+         * @param   pSink       The sink to write mixed audio to.
+         * @param   pBlocks     The number of blocks to mix.
+         */
+        void Render (
+            IAudioSink&         pSink,
+            const std::size_t&  pBlocks
+        );
+
+        /**
+         * @brief   Starts playing an audio clip from memory.
+         *
+         * @param   pClip       The clip to play. The mixer keeps the clip alive
+         *                      until the voice has finished.
+         * @param   pParams     The parameters to play the clip with.
+         *
+         * @return  The new voice's handle, or zero if the clip is invalid or
+         *          the command queue is full.
+         */
+        VoiceHandle Play (
+            const AssetHandle<AudioClip>&   pClip,
+            const VoiceParams&              pParams = {}
+        );
+
+        /**
+         * @brief   Starts streaming a `.wav` file from the virtual filesystem.
+         *
+         * @param   pLogicalPath    The logical path of the file to stream.
+         * @param   pParams         The parameters to play the file with.
+         *
+         * @return  The new voice's handle, or zero if the file could not be
+         *          opened or decoded, or all stream slots are in use.
+         */
+        VoiceHandle PlayStream (
+            const std::string&  pLogicalPath,
+            const VoiceParams&  pParams = {}
+        );
+
+        /**
+         * @brief   Fades out and stops a voice.
+         *
+         * @param   pVoice  The voice's handle.
+         */
+        void StopVoice (
+            const VoiceHandle&  pVoice
+        );
+
+        /**
+         * @brief   Changes a voice's gain and stereo position. The change is
+         *          ramped over one block.
+         *
+         * @param   pVoice  The voice's handle.
+         * @param   pGain   The voice's new linear gain.
+         * @param   pPan    The voice's new stereo position.
+         */
+        void SetVoiceGain (
+            const VoiceHandle&  pVoice,
+            const float         pGain,
+            const float         pPan = 0.0f
+        );
+
+        /**
+         * @brief   Changes a voice's playback rate.
+         *
+         * @param   pVoice  The voice's handle.
+         * @param   pPitch  The voice's new playback rate.
+         */
+        void SetVoicePitch (
+            const VoiceHandle&  pVoice,
+            const float         pPitch
+        );
+
+        /**
+         * @brief   Sets the gain applied to the whole mix.
+         *
+         * @param   pGain   The master linear gain.
+         */
+        inline void SetMasterGain (
+            const float pGain
+        )
+        {
+            mMasterGain.store(pGain, std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Releases the clips and stream slots of voices which the
+         *          mixer has finished playing.
+         *
+         * This should be called regularly, such as once per frame.
+         */
+        void Update ();
+
+        /**
+         * @brief   Retrieves the number of voices currently being mixed.
+         *
+         * @return  The number of active voices.
+         */
+        inline std::size_t GetActiveVoiceCount () const
+        {
+            return mActiveVoiceCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Retrieves how long the mixer took to mix its most recent
+         *          block.
+         *
+         * @return  The duration of the most recent mix.
+         */
+        inline std::chrono::nanoseconds GetLastMixDuration () const
+        {
+            return std::chrono::nanoseconds {
+                mLastMixNanoseconds.load(std::memory_order_relaxed) };
+        }
+
+        /**
+         * @brief   Retrieves the mixer's settings.
+         *
+         * @return  The mixer's settings.
+         */
+        inline const AudioMixerSpec& GetSpec () const
+        {
+            return mSpec;
+        }
+
+    private:
+        AudioMixer (const AudioMixer&) = delete;
+        AudioMixer (AudioMixer&&) = delete;
+        void operator= (const AudioMixer&) = delete;
+        void operator= (AudioMixer&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one streamed voice's decoder, and
+         *          the queue of frames decoded ahead for the mixer thread.
+         *
+         * The decoder is owned by the streaming thread while the stream is
+         * active, and by game threads otherwise; @a `mMutex` hands it over.
+         * The frame queue has one producer, the streaming thread, and one
+         * consumer, the mixer thread.
+         */
+        struct Stream
+        {
+            std::mutex                      mMutex;                 ///< @brief The mutex used for handing over the decoder.
+            std::unique_ptr<WaveDecoder>    mDecoder = nullptr;     ///< @brief The decoder reading the streamed file.
+            bool                            mLooping = false;       ///< @brief Rewind the decoder when it runs out?
+            std::uint32_t                   mChannelCount = 1;      ///< @brief The streamed audio's channel count.
+            std::uint32_t                   mSampleRate = 0;        ///< @brief The streamed audio's sample rate.
+            std::vector<float>              mFrames;                ///< @brief The circular queue of decoded frames.
+            std::atomic<std::size_t>        mWritten { 0 };         ///< @brief The number of frames ever written to the queue.
+            std::atomic<std::size_t>        mRead { 0 };            ///< @brief The number of frames ever read from the queue.
+            std::atomic<bool>               mEnded { false };       ///< @brief Has the decoder run out of frames?
+        };
+
+        /**
+         * @brief   Enumerates the commands passed to the mixer thread.
+         */
+        enum class CommandType
+        {
+            Play,
+            Stop,
+            SetGain,
+            SetPitch
+        };
+
+        /**
+         * @brief   A structure containing one command passed to the mixer
+         *          thread.
+         */
+        struct Command
+        {
+            CommandType         mType = CommandType::Play;  ///< @brief The type of command.
+            VoiceHandle         mVoice = 0;                 ///< @brief The voice being controlled.
+            const AudioClip*    mClip = nullptr;            ///< @brief The clip to play, if playing a clip.
+            Stream*             mStream = nullptr;          ///< @brief The stream to play, if playing a stream.
+            VoiceParams         mParams;                    ///< @brief The voice's new parameters.
+        };
+
+        /**
+         * @brief   A structure containing one voice's mixing state. It is only
+         *          ever accessed by the mixer thread.
+         */
+        struct Voice
+        {
+            VoiceHandle         mHandle = 0;            ///< @brief The voice's handle, or zero if the slot is free.
+            const AudioClip*    mClip = nullptr;        ///< @brief The clip being played, if any.
+            Stream*             mStream = nullptr;      ///< @brief The stream being played, if any.
+            std::uint32_t       mChannelCount = 1;      ///< @brief The source audio's channel count.
+            float               mRateRatio = 1.0f;      ///< @brief The source sample rate, over the mixer's.
+            float               mStep = 1.0f;           ///< @brief The number of source frames advanced per mixed frame.
+            std::size_t         mPosition = 0;          ///< @brief The whole part of the voice's position in its clip.
+            float               mFraction = 0.0f;       ///< @brief The fractional part of the voice's position.
+            float               mGainLeft = 0.0f;       ///< @brief The left gain at the start of the next block.
+            float               mGainRight = 0.0f;      ///< @brief The right gain at the start of the next block.
+            float               mTargetLeft = 0.0f;     ///< @brief The left gain to ramp to over the next block.
+            float               mTargetRight = 0.0f;    ///< @brief The right gain to ramp to over the next block.
+            bool                mLooping = false;       ///< @brief Loop the clip?
+            bool                mStopping = false;      ///< @brief Finish the voice once it has faded out?
+            bool                mFinished = false;      ///< @brief Has the voice finished, pending a report to game threads?
+        };
+
+        /**
+         * @brief   The queue of commands passed to the mixer thread.
+         */
+        using CommandQueue = RingBuffer<Command, COMMAND_CAPACITY>;
+
+        /**
+         * @brief   The queue of voices reported finished by the mixer thread.
+         */
+        using FinishedQueue = RingBuffer<VoiceHandle, COMMAND_CAPACITY>;
+
+    private:
+
+        /**
+         * @brief   Allocates a new voice handle and queues a play command.
+         *
+         * @param   pCommand    The play command, without its voice handle.
+         *
+         * @return  The new voice's handle, or zero if the queue is full.
+         */
+        VoiceHandle QueuePlay (
+            Command pCommand
+        );
+
+        /**
+         * @brief   Drains the command queue, then mixes one block into
+         *          @a `mOutput`. Called on the mixer thread.
+         */
+        void MixBlock ();
+
+        /**
+         * @brief   Applies a single command. Called on the mixer thread.
+         *
+         * @param   pCommand    The command to apply.
+         */
+        void ApplyCommand (
+            const Command&  pCommand
+        );
+
+        /**
+         * @brief   Gathers the source frames needed for one voice's next
+         *          block into @a `mGather`, then advances the voice's source.
+         *          Called on the mixer thread.
+         *
+         * @param   pVoice  The voice to gather frames for.
+         * @param   pCount  The number of source frames to gather.
+         * @param   pAdvance    The number of source frames to advance by.
+         */
+        void GatherFrames (
+            Voice&              pVoice,
+            const std::size_t&  pCount,
+            const std::size_t&  pAdvance
+        );
+
+        /**
+         * @brief   Tops up every active stream's frame queue. Called on the
+         *          streaming thread.
+         */
+        void RefillStreams ();
+
+        /**
+         * @brief   Computes a voice's left and right gains from its gain and
+         *          stereo position, with a constant-power pan law.
+         *
+         * @param   pVoice      The voice to update.
+         * @param   pParams     The voice's parameters.
+         */
+        static void SetTargetGains (
+            Voice&              pVoice,
+            const VoiceParams&  pParams
+        );
+
+    private:
+        AudioMixerSpec                                             mSpec;                        ///< @brief The mixer's settings.
+        std::atomic<bool>                                          mRunning { false };           ///< @brief Indicates whether or not the mixer thread is running.
+        std::thread                                                mMixerThread;                 ///< @brief The real-time thread which mixes blocks.
+        std::thread                                                mStreamThread;                ///< @brief The thread which decodes streamed voices ahead of the mixer.
+        IAudioSink*                                                mSink = nullptr;              ///< @brief The sink the mixer thread writes to.
+        std::unique_ptr<CommandQueue>                              mCommands;                    ///< @brief Commands passed from game threads to the mixer thread.
+        std::unique_ptr<FinishedQueue>                             mFinishedVoices;              ///< @brief Voices reported finished by the mixer thread.
+        std::atomic<VoiceHandle>                                   mNextHandle { 1 };            ///< @brief The next voice handle to be issued.
+        std::atomic<float>                                         mMasterGain { 1.0f };         ///< @brief The gain applied to the whole mix.
+        std::atomic<std::size_t>                                   mActiveVoiceCount { 0 };      ///< @brief The number of voices currently being mixed.
+        std::atomic<std::int64_t>                                  mLastMixNanoseconds { 0 };    ///< @brief How long the most recent block took to mix.
+
+        std::mutex                                                 mGameMutex;                   ///< @brief The mutex used for locking down the game-side voice bookkeeping.
+        std::unordered_map<VoiceHandle, AssetHandle<AudioClip>>    mClipVoices;                  ///< @brief The clips kept alive for unfinished voices.
+        std::unordered_map<VoiceHandle, std::size_t>               mStreamVoices;                ///< @brief The stream slots held by unfinished voices.
+        std::vector<std::unique_ptr<Stream>>                       mStreams;                     ///< @brief The stream slots.
+        std::vector<std::size_t>                                   mFreeStreams;                 ///< @brief The indices of unused stream slots.
+
+        std::vector<Voice>                                         mVoices;                      ///< @brief The voice slots. Mixer thread only.
+        std::vector<std::size_t>                                   mFreeVoices;                  ///< @brief The indices of unused voice slots. Mixer thread only.
+        std::vector<std::size_t>                                   mActiveVoices;                ///< @brief The indices of used voice slots. Mixer thread only.
+        std::vector<float>                                         mGather;                      ///< @brief Scratch space for a voice's source frames. Mixer thread only.
+        std::vector<float>                                         mResampled;                   ///< @brief Scratch space for a voice's resampled stereo frames. Mixer thread only.
+        std::vector<float>                                         mOutput;                      ///< @brief The mixed stereo block. Mixer thread only.
+
+    };
+
+}
@@ -0,0 +1,42 @@
+/**
+ * @file    Ace/Audio/IAudioSink.hpp
+ * @brief   Provides an abstract interface for a destination of mixed audio.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An abstract interface for a destination of the audio mixed by
+     *          an @a `AudioMixer`, such as a sound device or a file.
+     */
+    class ACE_API IAudioSink
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~IAudioSink () = default;
+
+        /**
+         * @brief   Writes a block of mixed audio to the sink.
+         *
+         * This method is called from the mixer's thread, and must not block
+         * for longer than the block takes to play.
+         *
+         * @param   pSamples        The block's interleaved stereo samples, in
+         *                          the range `[-1, 1]`.
+         * @param   pFrameCount     The number of frames in the block.
+         */
+        virtual void Write (
+            const float*        pSamples,
+            const std::size_t&  pFrameCount
+        ) = 0;
+
+    };
+
+}
@@ -0,0 +1,332 @@
+/**
+ * @file    Ace/Audio/WaveDecoder.cpp
+ */
+
+#include <Ace/Audio/WaveDecoder.hpp>
+
+namespace ace
+{
+
+    /* IMA ADPCM Tables *******************************************************/
+
+    static constexpr std::array<std::int32_t, 89> IMA_STEP_TABLE = {
+        7, 8, 9, 10, 11, 12, 13, 14, 16, 17, 19, 21, 23, 25, 28, 31, 34, 37,
+        41, 45, 50, 55, 60, 66, 73, 80, 88, 97, 107, 118, 130, 143, 157, 173,
+        190, 209, 230, 253, 279, 307, 337, 371, 408, 449, 494, 544, 598, 658,
+        724, 796, 876, 963, 1060, 1166, 1282, 1411, 1552, 1707, 1878, 2066,
+        2272, 2499, 2749, 3024, 3327, 3660, 4026, 4428, 4871, 5358, 5894, 6484,
+        7132, 7845, 8630, 9493, 10442, 11487, 12635, 13899, 15289, 16818,
+        18500, 20350, 22385, 24623, 27086, 29794, 32767
+    };
+
+    static constexpr std::array<std::int32_t, 16> IMA_INDEX_TABLE = {
+        -1, -1, -1, -1, 2, 4, 6, 8,
+        -1, -1, -1, -1, 2, 4, 6, 8
+    };
+
+    /* Helper Functions *******************************************************/
+
+    template <typename T>
+    static T ReadLittleEndian (
+        const std::uint8_t* pBytes
+    )
+    {
+        T lValue {};
+        std::memcpy(&lValue, pBytes, sizeof(T));
+        return lValue;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    WaveDecoder::WaveDecoder (
+        std::unique_ptr<IVirtualFile>   pVirtualFile
+    ) :
+        mFile { std::move(pVirtualFile) }
+    {
+        if (mFile == nullptr)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Virtual file is null!",
+                "WaveDecoder");
+        }
+
+        const std::size_t lFileSize = mFile->GetSize();
+
+        // Read and check the RIFF header.
+        std::array<std::uint8_t, 12> lHeader {};
+        if (
+            lFileSize < lHeader.size() ||
+            mFile->Read(lHeader.data(), lHeader.size()) != lHeader.size() ||
+            std::memcmp(lHeader.data(), "RIFF", 4) != 0 ||
+            std::memcmp(lHeader.data() + 8, "WAVE", 4) != 0
+        )
+        {
+            ACE_THROW(std::runtime_error, "{}: File is not a '.wav' file!",
+                "WaveDecoder");
+        }
+
+        // Walk the file's chunks, looking for its format, fact and data
+        // chunks.
+        std::uint16_t   lFormatTag = 0;
+        std::uint16_t   lBitsPerSample = 0;
+        std::size_t     lFactFrames = 0;
+        bool            lHasFormat = false;
+        bool            lHasData = false;
+        std::size_t     lPosition = lHeader.size();
+        while (lPosition + 8 <= lFileSize && lHasData == false)
+        {
+            std::array<std::uint8_t, 8> lChunkHeader {};
+            mFile->Seek(lPosition);
+            mFile->Read(lChunkHeader.data(), lChunkHeader.size());
+
+            const std::size_t lChunkSize =
+                ReadLittleEndian<std::uint32_t>(lChunkHeader.data() + 4);
+            const std::size_t lChunkStart = lPosition + 8;
+            const std::size_t lAvailable =
+                std::min(lChunkSize, lFileSize - lChunkStart);
+
+            if (std::memcmp(lChunkHeader.data(), "fmt ", 4) == 0 && lAvailable >= 16)
+            {
+                std::array<std::uint8_t, 16> lFormat {};
+                mFile->Read(lFormat.data(), lFormat.size());
+
+                lFormatTag      = ReadLittleEndian<std::uint16_t>(lFormat.data() + 0);
+                mChannelCount   = ReadLittleEndian<std::uint16_t>(lFormat.data() + 2);
+                mSampleRate     = ReadLittleEndian<std::uint32_t>(lFormat.data() + 4);
+                mBlockAlign     = ReadLittleEndian<std::uint16_t>(lFormat.data() + 12);
+                lBitsPerSample  = ReadLittleEndian<std::uint16_t>(lFormat.data() + 14);
+
+                lHasFormat = true;
+            }
+            else if (std::memcmp(lChunkHeader.data(), "fact", 4) == 0 && lAvailable >= 4)
+            {
+                std::array<std::uint8_t, 4> lFact {};
+                mFile->Read(lFact.data(), lFact.size());
+                lFactFrames = ReadLittleEndian<std::uint32_t>(lFact.data());
+            }
+            else if (std::memcmp(lChunkHeader.data(), "data", 4) == 0)
+            {
+                mDataOffset = lChunkStart;
+                mDataSize = lAvailable;
+                lHasData = true;
+            }
+
+            // Chunks are padded to an even number of bytes.
+            lPosition = lChunkStart + lChunkSize + (lChunkSize & 1);
+        }
+
+        if (lHasFormat == false || lHasData == false)
+        {
+            ACE_THROW(std::runtime_error, "{}: File is missing its '{}' chunk!",
+                "WaveDecoder", lHasFormat ? "data" : "fmt ");
+        }
+        else if (mChannelCount != 1 && mChannelCount != 2)
+        {
+            ACE_THROW(std::runtime_error, "{}: {} channels are not supported!",
+                "WaveDecoder", mChannelCount);
+        }
+        else if (mSampleRate == 0 || mBlockAlign == 0)
+        {
+            ACE_THROW(std::runtime_error, "{}: Format chunk is invalid!",
+                "WaveDecoder");
+        }
+
+        // Determine the encoding, and from that, the number of frames.
+        if (lFormatTag == 1 && lBitsPerSample == 16)
+        {
+            mEncoding = WaveEncoding::PCM16;
+            mFramesPerBlock = 1;
+            mFrameCount = mDataSize / mBlockAlign;
+        }
+        else if (lFormatTag == 3 && lBitsPerSample == 32)
+        {
+            mEncoding = WaveEncoding::Float32;
+            mFramesPerBlock = 1;
+            mFrameCount = mDataSize / mBlockAlign;
+        }
+        else if (lFormatTag == 0x11 && lBitsPerSample == 4)
+        {
+            // Each block holds a four-byte header per channel, which also
+            // encodes the block's first frame, followed by two frames per
+            // byte per channel.
+            const std::size_t lHeaderSize = 4 * mChannelCount;
+            if (mBlockAlign <= lHeaderSize || mBlockAlign % lHeaderSize != 0)
+            {
+                ACE_THROW(std::runtime_error,
+                    "{}: IMA ADPCM block size {} is invalid!",
+                    "WaveDecoder", mBlockAlign);
+            }
+
+            mEncoding = WaveEncoding::IMAADPCM;
+            mFramesPerBlock = (mBlockAlign - lHeaderSize) / lHeaderSize * 8 + 1;
+
+            const std::size_t lFullBlocks = mDataSize / mBlockAlign;
+            const std::size_t lRemainder = mDataSize % mBlockAlign;
+            mFrameCount = lFullBlocks * mFramesPerBlock;
+            if (lRemainder > lHeaderSize)
+            {
+                mFrameCount += (lRemainder - lHeaderSize) / lHeaderSize * 8 + 1;
+            }
+
+            if (lFactFrames != 0)
+            {
+                mFrameCount = std::min(mFrameCount, lFactFrames);
+            }
+
+            mBlockSamples.resize(mFramesPerBlock * mChannelCount);
+        }
+        else
+        {
+            ACE_THROW(std::runtime_error,
+                "{}: Format {:#x} with {} bits per sample is not supported!",
+                "WaveDecoder", lFormatTag, lBitsPerSample);
+        }
+
+        Rewind();
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::size_t WaveDecoder::Decode (
+        float*              pOut,
+        const std::size_t&  pFrames
+    )
+    {
+        const std::size_t lFrames = std::min(pFrames, mFrameCount - mFramesDecoded);
+        if (lFrames == 0 || pOut == nullptr)
+        {
+            return 0;
+        }
+
+        if (mEncoding == WaveEncoding::IMAADPCM)
+        {
+            // Copy frames out of the current block, decoding the next block
+            // whenever the current one runs dry.
+            std::size_t lDecoded = 0;
+            while (lDecoded < lFrames)
+            {
+                if (mBlockFrame == mBlockFrames && DecodeBlock() == false)
+                {
+                    break;
+                }
+
+                std::size_t lCount = std::min(lFrames - lDecoded,
+                    mBlockFrames - mBlockFrame);
+                std::copy_n(
+                    mBlockSamples.data() + mBlockFrame * mChannelCount,
+                    lCount * mChannelCount,
+                    pOut + lDecoded * mChannelCount
+                );
+
+                mBlockFrame += lCount;
+                lDecoded += lCount;
+            }
+
+            mFramesDecoded += lDecoded;
+            return lDecoded;
+        }
+
+        // Uncompressed frames are fixed in size, so read them all at once.
+        const std::size_t lBytes = lFrames * mBlockAlign;
+        mReadBuffer.resize(lBytes);
+        if (mFile->Read(mReadBuffer.data(), lBytes) != lBytes)
+        {
+            return 0;
+        }
+
+        const std::size_t lSamples = lFrames * mChannelCount;
+        if (mEncoding == WaveEncoding::PCM16)
+        {
+            for (std::size_t i = 0; i < lSamples; ++i)
+            {
+                pOut[i] = ReadLittleEndian<std::int16_t>(
+                    mReadBuffer.data() + i * 2) * (1.0f / 32768.0f);
+            }
+        }
+        else
+        {
+            std::memcpy(pOut, mReadBuffer.data(), lSamples * sizeof(float));
+        }
+
+        mDataRead += lBytes;
+        mFramesDecoded += lFrames;
+        return lFrames;
+    }
+
+    bool WaveDecoder::Rewind ()
+    {
+        mDataRead = 0;
+        mFramesDecoded = 0;
+        mBlockFrame = 0;
+        mBlockFrames = 0;
+        return mFile->Seek(mDataOffset);
+    }
+
+    /* Private Methods ********************************************************/
+
+    bool WaveDecoder::DecodeBlock ()
+    {
+        const std::size_t lBytes = std::min(mBlockAlign, mDataSize - mDataRead);
+        const std::size_t lHeaderSize = 4 * mChannelCount;
+        if (lBytes <= lHeaderSize)
+        {
+            return false;
+        }
+
+        mReadBuffer.resize(lBytes);
+        if (mFile->Read(mReadBuffer.data(), lBytes) != lBytes)
+        {
+            return false;
+        }
+        mDataRead += lBytes;
+
+        // Each channel's header holds its first sample and its step index.
+        std::array<std::int32_t, 2> lPredictors {};
+        std::array<std::int32_t, 2> lStepIndices {};
+        for (std::size_t c = 0; c < mChannelCount; ++c)
+        {
+            const std::uint8_t* lChannelHeader = mReadBuffer.data() + c * 4;
+            lPredictors[c] = ReadLittleEndian<std::int16_t>(lChannelHeader);
+            lStepIndices[c] = std::clamp<std::int32_t>(lChannelHeader[2], 0, 88);
+            mBlockSamples[c] = lPredictors[c] * (1.0f / 32768.0f);
+        }
+
+        // The remaining data is interleaved in groups of four bytes - eight
+        // samples - per channel. Each byte holds two samples, low nibble
+        // first. A truncated final group is ignored.
+        const std::size_t lFrames = (lBytes - lHeaderSize) / lHeaderSize * 8;
+        const std::uint8_t* lData = mReadBuffer.data() + lHeaderSize;
+        for (std::size_t lFrame = 0; lFrame < lFrames; ++lFrame)
+        {
+            for (std::size_t c = 0; c < mChannelCount; ++c)
+            {
+                const std::size_t lGroup = lFrame / 8;
+                const std::size_t lInGroup = lFrame % 8;
+                const std::uint8_t lByte =
+                    lData[(lGroup * mChannelCount + c) * 4 + lInGroup / 2];
+                const std::int32_t lNibble = (lInGroup & 1) ? (lByte >> 4) : (lByte & 0xF);
+
+                // Reconstruct the difference from the nibble's magnitude bits,
+                // then apply it in the direction of its sign bit.
+                const std::int32_t lStep = IMA_STEP_TABLE[lStepIndices[c]];
+                std::int32_t lDifference = lStep >> 3;
+                if (lNibble & 1) { lDifference += lStep >> 2; }
+                if (lNibble & 2) { lDifference += lStep >> 1; }
+                if (lNibble & 4) { lDifference += lStep; }
+                if (lNibble & 8) { lDifference = -lDifference; }
+
+                lPredictors[c] = std::clamp(lPredictors[c] + lDifference,
+                    -32768, 32767);
+                lStepIndices[c] = std::clamp(
+                    lStepIndices[c] + IMA_INDEX_TABLE[lNibble], 0, 88);
+
+                mBlockSamples[(lFrame + 1) * mChannelCount + c] =
+                    lPredictors[c] * (1.0f / 32768.0f);
+            }
+        }
+
+        mBlockFrame = 0;
+        mBlockFrames = lFrames + 1;
+        return true;
+    }
+
+}
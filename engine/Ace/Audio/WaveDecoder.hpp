@@ -0,0 +1,143 @@
+/**
+ * @file    Ace/Audio/WaveDecoder.hpp
+ * @brief   Provides a class which incrementally decodes `.wav` audio read from
+ *          a virtual file.
+ */
+
+#pragma once
+#include <Ace/System/IVirtualFile.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the sample encodings a @a `WaveDecoder` can decode.
+     */
+    enum class WaveEncoding
+    {
+        PCM16,      ///< @brief Uncompressed, signed 16-bit integer samples.
+        Float32,    ///< @brief Uncompressed, 32-bit floating-point samples.
+        IMAADPCM    ///< @brief IMA ADPCM compressed samples, four bits each.
+    };
+
+    /**
+     * @brief   A class which incrementally decodes mono or stereo `.wav` audio
+     *          read from a virtual file into floating-point samples.
+     *
+     * The decoder reads only as much of the file as it needs to satisfy each
+     * call to @a `Decode`, so long clips can be streamed rather than loaded
+     * whole.
+     */
+    class ACE_API WaveDecoder final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a decoder which reads from the given virtual
+         *          file, parsing its header.
+         *
+         * @param   pVirtualFile    The opened `.wav` file.
+         *
+         * @throw   `std::invalid_argument` if the file is `nullptr`.
+         * @throw   `std::runtime_error` if the file is not a `.wav` file, or
+         *          uses an unsupported encoding or channel count.
+         */
+        explicit WaveDecoder (
+            std::unique_ptr<IVirtualFile>   pVirtualFile
+        );
+
+    public:
+
+        /**
+         * @brief   Decodes up to the given number of frames into interleaved
+         *          floating-point samples.
+         *
+         * @param   pOut        Room for `pFrames * GetChannelCount()` samples.
+         * @param   pFrames     The maximum number of frames to decode.
+         *
+         * @return  The number of frames decoded. Fewer frames than requested
+         *          are decoded only at the end of the audio.
+         */
+        std::size_t Decode (
+            float*              pOut,
+            const std::size_t&  pFrames
+        );
+
+        /**
+         * @brief   Seeks back to the start of the audio.
+         *
+         * @return  `true` if the seek is successful; `false` otherwise.
+         */
+        bool Rewind ();
+
+        /**
+         * @brief   Retrieves the audio's sample rate.
+         *
+         * @return  The number of frames per second.
+         */
+        inline std::uint32_t GetSampleRate () const
+        {
+            return mSampleRate;
+        }
+
+        /**
+         * @brief   Retrieves the audio's channel count.
+         *
+         * @return  The number of samples per frame; either one or two.
+         */
+        inline std::uint32_t GetChannelCount () const
+        {
+            return mChannelCount;
+        }
+
+        /**
+         * @brief   Retrieves the total number of frames in the audio.
+         *
+         * @return  The number of frames.
+         */
+        inline std::size_t GetFrameCount () const
+        {
+            return mFrameCount;
+        }
+
+        /**
+         * @brief   Retrieves the audio's sample encoding.
+         *
+         * @return  The sample encoding.
+         */
+        inline WaveEncoding GetEncoding () const
+        {
+            return mEncoding;
+        }
+
+    private:
+
+        /**
+         * @brief   Reads and decodes the next IMA ADPCM block into
+         *          @a `mBlockSamples`.
+         *
+         * @return  `true` if a block was decoded; `false` at the end of the
+         *          audio.
+         */
+        bool DecodeBlock ();
+
+    private:
+        std::unique_ptr<IVirtualFile>   mFile = nullptr;                    ///< @brief The file being decoded.
+        WaveEncoding                    mEncoding = WaveEncoding::PCM16;    ///< @brief The audio's sample encoding.
+        std::uint32_t                   mSampleRate = 0;                    ///< @brief The audio's sample rate.
+        std::uint32_t                   mChannelCount = 0;                  ///< @brief The audio's channel count.
+        std::size_t                     mBlockAlign = 0;                    ///< @brief The size of one frame, or of one IMA ADPCM block, in bytes.
+        std::size_t                     mFramesPerBlock = 1;                ///< @brief The number of frames encoded in each IMA ADPCM block.
+        std::size_t                     mFrameCount = 0;                    ///< @brief The total number of frames in the audio.
+        std::size_t                     mDataOffset = 0;                    ///< @brief The offset of the audio data in the file.
+        std::size_t                     mDataSize = 0;                      ///< @brief The size of the audio data, in bytes.
+        std::size_t                     mDataRead = 0;                      ///< @brief The number of bytes of audio data read so far.
+        std::size_t                     mFramesDecoded = 0;                 ///< @brief The number of frames decoded so far.
+        astd::byte_buffer               mReadBuffer;                        ///< @brief Scratch space for encoded data read from the file.
+        std::vector<float>              mBlockSamples;                      ///< @brief The samples of the most recently decoded IMA ADPCM block.
+        std::size_t                     mBlockFrame = 0;                    ///< @brief The next frame to be consumed from @a `mBlockSamples`.
+        std::size_t                     mBlockFrames = 0;                   ///< @brief The number of frames held in @a `mBlockSamples`.
+
+    };
+
+}
@@ -0,0 +1,128 @@
+/**
+ * @file    Ace/Audio/WaveFileSink.cpp
+ */
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include <Ace/Audio/WaveFileSink.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    WaveFileSink::WaveFileSink (
+        const fs::path&         pPath,
+        const std::uint32_t&    pSampleRate
+    ) :
+        mFileStream { pPath, std::ios::binary | std::ios::trunc },
+        mSampleRate { pSampleRate }
+    {
+        if (mFileStream.is_open() == false)
+        {
+            throw std::runtime_error {
+                std::format("WaveFileSink: '{}' could not be opened!",
+                    pPath.string())
+            };
+        }
+
+        // Write a placeholder header; it is rewritten with the final sizes
+        // when the file is closed.
+        WriteHeader();
+    }
+
+    WaveFileSink::~WaveFileSink ()
+    {
+        Close();
+    }
+
+    /* Public Methods *********************************************************/
+
+    void WaveFileSink::Write (
+        const float*        pSamples,
+        const std::size_t&  pFrameCount
+    )
+    {
+        if (mFileStream.is_open() == false)
+        {
+            return;
+        }
+
+        const std::size_t lSamples = pFrameCount * 2;
+        mConverted.resize(lSamples);
+
+        // Scale the samples to the 16-bit range, then convert them, with
+        // saturation, eight at a time where SSE2 is available.
+        std::size_t i = 0;
+        #if defined(__SSE2__)
+        {
+            const __m128 lScale = _mm_set1_ps(32767.0f);
+            for (; i + 8 <= lSamples; i += 8)
+            {
+                __m128i lLow = _mm_cvtps_epi32(
+                    _mm_mul_ps(_mm_loadu_ps(pSamples + i), lScale));
+                __m128i lHigh = _mm_cvtps_epi32(
+                    _mm_mul_ps(_mm_loadu_ps(pSamples + i + 4), lScale));
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(mConverted.data() + i),
+                    _mm_packs_epi32(lLow, lHigh));
+            }
+        }
+        #endif
+
+        for (; i < lSamples; ++i)
+        {
+            mConverted[i] = static_cast<std::int16_t>(std::lround(
+                std::clamp(pSamples[i], -1.0f, 1.0f) * 32767.0f));
+        }
+
+        mFileStream.write(reinterpret_cast<const char*>(mConverted.data()),
+            lSamples * sizeof(std::int16_t));
+        mFrameCount += pFrameCount;
+    }
+
+    void WaveFileSink::Close ()
+    {
+        if (mFileStream.is_open() == false)
+        {
+            return;
+        }
+
+        mFileStream.seekp(0);
+        WriteHeader();
+        mFileStream.close();
+    }
+
+    /* Private Methods ********************************************************/
+
+    void WaveFileSink::WriteHeader ()
+    {
+        const std::uint32_t lDataSize =
+            static_cast<std::uint32_t>(mFrameCount * 2 * sizeof(std::int16_t));
+
+        std::array<std::uint8_t, 44> lHeader {};
+        auto lPut = [&lHeader] (const std::size_t& pOffset, const auto pValue)
+        {
+            std::memcpy(lHeader.data() + pOffset, &pValue, sizeof(pValue));
+        };
+
+        std::memcpy(lHeader.data() + 0, "RIFF", 4);
+        lPut(4, std::uint32_t { 36 + lDataSize });
+        std::memcpy(lHeader.data() + 8, "WAVEfmt ", 8);
+        lPut(16, std::uint32_t { 16 });                 // Format chunk size
+        lPut(20, std::uint16_t { 1 });                  // PCM
+        lPut(22, std::uint16_t { 2 });                  // Stereo
+        lPut(24, mSampleRate);
+        lPut(28, std::uint32_t { mSampleRate * 4 });    // Bytes per second
+        lPut(32, std::uint16_t { 4 });                  // Bytes per frame
+        lPut(34, std::uint16_t { 16 });                 // Bits per sample
+        std::memcpy(lHeader.data() + 36, "data", 4);
+        lPut(40, lDataSize);
+
+        mFileStream.write(reinterpret_cast<const char*>(lHeader.data()),
+            lHeader.size());
+    }
+
+}
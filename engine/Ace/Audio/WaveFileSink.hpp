@@ -0,0 +1,79 @@
+/**
+ * @file    Ace/Audio/WaveFileSink.hpp
+ * @brief   Provides an audio sink which records mixed audio to a `.wav` file.
+ */
+
+#pragma once
+#include <Ace/Audio/IAudioSink.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An audio sink which records mixed audio to a 16-bit stereo
+     *          `.wav` file, allowing audio to be rendered with no sound device
+     *          present.
+     */
+    class ACE_API WaveFileSink final : public IAudioSink
+    {
+    public:
+
+        /**
+         * @brief   Constructs a sink which records to the given file.
+         *
+         * @param   pPath           The path of the file to record to. Any
+         *                          existing file is overwritten.
+         * @param   pSampleRate     The sample rate of the recorded audio.
+         *
+         * @throw   `std::runtime_error` if the file could not be opened.
+         */
+        WaveFileSink (
+            const fs::path&         pPath,
+            const std::uint32_t&    pSampleRate
+        );
+
+        /**
+         * @brief   The destructor closes the file, if it is still open.
+         */
+        ~WaveFileSink () override;
+
+    public:
+
+        void Write (
+            const float*        pSamples,
+            const std::size_t&  pFrameCount
+        ) override;
+
+        /**
+         * @brief   Finalizes the file's header and closes the file, rendering
+         *          subsequent writes invalid.
+         */
+        void Close ();
+
+        /**
+         * @brief   Retrieves the number of frames recorded so far.
+         *
+         * @return  The number of frames recorded.
+         */
+        inline std::size_t GetFrameCount () const
+        {
+            return mFrameCount;
+        }
+
+    private:
+
+        /**
+         * @brief   Writes the file's header, sized for the frames recorded so
+         *          far, at the start of the file.
+         */
+        void WriteHeader ();
+
+    private:
+        std::ofstream                   mFileStream;        ///< @brief The file being recorded to.
+        std::uint32_t                   mSampleRate = 0;    ///< @brief The sample rate of the recorded audio.
+        std::size_t                     mFrameCount = 0;    ///< @brief The number of frames recorded so far.
+        std::vector<std::int16_t>       mConverted;         ///< @brief Scratch space for samples converted to 16-bit integers.
+
+    };
+
+}
@@ -0,0 +1,106 @@
+/**
+ * @file    Ace/Graphics/Framebuffer.cpp
+ */
+
+#include <Ace/Graphics/Framebuffer.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    Framebuffer::Framebuffer (
+        const std::size_t&  pWidth,
+        const std::size_t&  pHeight
+    ) :
+        mWidth  { pWidth },
+        mHeight { pHeight },
+        mStride { (pWidth + ROW_ALIGNMENT - 1) & ~(ROW_ALIGNMENT - 1) }
+    {
+        if (pWidth == 0 || pHeight == 0)
+        {
+            ACE_THROW(
+                std::invalid_argument,
+                "{}: Dimensions {}x{} are invalid!",
+                "Framebuffer", pWidth, pHeight
+            );
+        }
+
+        mColor.resize(mStride * mHeight, 0);
+        mDepth.resize(mStride * mHeight, 1.0f);
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::uint32_t Framebuffer::PackColor (
+        const Vector4f& pColor
+    )
+    {
+        static const auto TO_BYTE = [] (const float pChannel) -> std::uint32_t
+        {
+            return static_cast<std::uint32_t>(
+                std::clamp(pChannel, 0.0f, 1.0f) * 255.0f + 0.5f
+            );
+        };
+
+        return
+            (TO_BYTE(pColor.mX) <<  0) |
+            (TO_BYTE(pColor.mY) <<  8) |
+            (TO_BYTE(pColor.mZ) << 16) |
+            (TO_BYTE(pColor.mW) << 24);
+    }
+
+    void Framebuffer::Clear (
+        const Vector4f& pColor,
+        const float     pDepth
+    )
+    {
+        std::fill(mColor.begin(), mColor.end(), PackColor(pColor));
+        std::fill(mDepth.begin(), mDepth.end(), pDepth);
+    }
+
+    bool Framebuffer::SaveTGA (
+        const fs::path& pPath
+    ) const
+    {
+        std::ofstream lStream { pPath, std::ios::binary };
+        if (lStream.is_open() == false)
+        {
+            return false;
+        }
+
+        // Write the 18-byte header of an uncompressed true-colour image, with
+        // an 8-bit alpha channel and a top-left origin.
+        std::array<std::uint8_t, 18> lHeader {};
+        lHeader[2]  = 2;
+        lHeader[12] = static_cast<std::uint8_t>(mWidth & 0xFF);
+        lHeader[13] = static_cast<std::uint8_t>((mWidth >> 8) & 0xFF);
+        lHeader[14] = static_cast<std::uint8_t>(mHeight & 0xFF);
+        lHeader[15] = static_cast<std::uint8_t>((mHeight >> 8) & 0xFF);
+        lHeader[16] = 32;
+        lHeader[17] = 0x28;
+        lStream.write(reinterpret_cast<const char*>(lHeader.data()),
+            lHeader.size());
+
+        // `.tga` pixels are stored in BGRA order, so swap the red and blue
+        // channels of each pixel on the way out.
+        astd::byte_buffer lRow(mWidth * 4);
+        for (std::size_t y = 0; y < mHeight; ++y)
+        {
+            const std::uint32_t* lPixels = GetColorRow(y);
+            for (std::size_t x = 0; x < mWidth; ++x)
+            {
+                lRow[x * 4 + 0] = static_cast<std::uint8_t>(lPixels[x] >> 16);
+                lRow[x * 4 + 1] = static_cast<std::uint8_t>(lPixels[x] >>  8);
+                lRow[x * 4 + 2] = static_cast<std::uint8_t>(lPixels[x] >>  0);
+                lRow[x * 4 + 3] = static_cast<std::uint8_t>(lPixels[x] >> 24);
+            }
+
+            lStream.write(reinterpret_cast<const char*>(lRow.data()),
+                lRow.size());
+        }
+
+        return lStream.good();
+    }
+
+}
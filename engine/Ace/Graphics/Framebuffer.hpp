@@ -0,0 +1,154 @@
+/**
+ * @file    Ace/Graphics/Framebuffer.hpp
+ * @brief   Provides an in-memory framebuffer with colour and depth planes.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+#include <Ace/Maths/Vector4.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An in-memory framebuffer, containing a plane of 8-bit RGBA
+     *          colour pixels and a plane of 32-bit floating-point depths.
+     *
+     * Each plane's rows are padded out to a multiple of four pixels, so that
+     * SIMD code may always process four pixels of a row at once without
+     * reading or writing past the end of that row.
+     */
+    class ACE_API Framebuffer final
+    {
+    public:
+
+        /**
+         * @brief   The number of pixels each row is padded to a multiple of.
+         */
+        static constexpr std::size_t ROW_ALIGNMENT = 4;
+
+    public:
+
+        /**
+         * @brief   Constructs a framebuffer of the given dimensions.
+         *
+         * @param   pWidth  The framebuffer's width, in pixels.
+         * @param   pHeight The framebuffer's height, in pixels.
+         *
+         * @throw   `std::invalid_argument` if either dimension is zero.
+         */
+        Framebuffer (
+            const std::size_t&  pWidth,
+            const std::size_t&  pHeight
+        );
+
+    public:
+
+        /**
+         * @brief   Packs a floating-point RGBA colour into an 8-bit-per-channel
+         *          pixel, with red in the lowest byte.
+         *
+         * @param   pColor  The colour to pack. Components are clamped to the
+         *                  range `[0, 1]`.
+         *
+         * @return  The packed pixel.
+         */
+        static std::uint32_t PackColor (
+            const Vector4f& pColor
+        );
+
+        /**
+         * @brief   Fills the colour plane with the given colour, and the depth
+         *          plane with the given depth.
+         *
+         * @param   pColor  The colour to fill with.
+         * @param   pDepth  The depth to fill with.
+         */
+        void Clear (
+            const Vector4f& pColor,
+            const float     pDepth = 1.0f
+        );
+
+        /**
+         * @brief   Writes the colour plane to an uncompressed, 32-bit `.tga`
+         *          image file.
+         *
+         * @param   pPath   The path to the image file to write.
+         *
+         * @return  `true` if the image was written; `false` otherwise.
+         */
+        bool SaveTGA (
+            const fs::path& pPath
+        ) const;
+
+    public:
+
+        inline std::size_t GetWidth () const    { return mWidth; }
+        inline std::size_t GetHeight () const   { return mHeight; }
+        inline std::size_t GetStride () const   { return mStride; }
+
+        /**
+         * @brief   Retrieves a pointer to the start of the given row of the
+         *          colour plane.
+         *
+         * @param   pY  The row index.
+         *
+         * @return  A pointer to the row's first pixel.
+         */
+        inline std::uint32_t* GetColorRow (const std::size_t& pY)               { return mColor.data() + pY * mStride; }
+        inline const std::uint32_t* GetColorRow (const std::size_t& pY) const   { return mColor.data() + pY * mStride; }
+
+        /**
+         * @brief   Retrieves a pointer to the start of the given row of the
+         *          depth plane.
+         *
+         * @param   pY  The row index.
+         *
+         * @return  A pointer to the row's first depth value.
+         */
+        inline float* GetDepthRow (const std::size_t& pY)                       { return mDepth.data() + pY * mStride; }
+        inline const float* GetDepthRow (const std::size_t& pY) const           { return mDepth.data() + pY * mStride; }
+
+        /**
+         * @brief   Retrieves the packed colour of the pixel at the given
+         *          coordinates.
+         *
+         * @param   pX  The pixel's column.
+         * @param   pY  The pixel's row.
+         *
+         * @return  The packed pixel.
+         */
+        inline std::uint32_t GetPixel (
+            const std::size_t&  pX,
+            const std::size_t&  pY
+        ) const
+        {
+            return mColor[pY * mStride + pX];
+        }
+
+        /**
+         * @brief   Retrieves the depth of the pixel at the given coordinates.
+         *
+         * @param   pX  The pixel's column.
+         * @param   pY  The pixel's row.
+         *
+         * @return  The pixel's depth.
+         */
+        inline float GetDepth (
+            const std::size_t&  pX,
+            const std::size_t&  pY
+        ) const
+        {
+            return mDepth[pY * mStride + pX];
+        }
+
+    private:
+        std::size_t                 mWidth = 0;     ///< @brief The framebuffer's width, in pixels.
+        std::size_t                 mHeight = 0;    ///< @brief The framebuffer's height, in pixels.
+        std::size_t                 mStride = 0;    ///< @brief The padded length of each row, in pixels.
+        std::vector<std::uint32_t>  mColor;         ///< @brief The colour plane, as packed RGBA pixels.
+        std::vector<float>          mDepth;         ///< @brief The depth plane.
+
+    };
+
+}
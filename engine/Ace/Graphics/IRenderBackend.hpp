@@ -0,0 +1,53 @@
+/**
+ * @file    Ace/Graphics/IRenderBackend.hpp
+ * @brief   Provides an abstract interface for a backend which executes sorted
+ *          draw commands.
+ */
+
+#pragma once
+#include <Ace/Graphics/RenderCommandBuffer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An abstract interface for a backend which executes the sorted
+     *          draw commands submitted by a @a `RenderQueue`.
+     *
+     * The handles referenced by draw commands, such as geometry and material
+     * handles, are issued by each concrete backend in its own way.
+     */
+    class ACE_API IRenderBackend
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~IRenderBackend () = default;
+
+        /**
+         * @brief   Called before the first draw command of a submission.
+         */
+        virtual void BeginFrame () = 0;
+
+        /**
+         * @brief   Executes a single draw command. Commands are executed in
+         *          ascending order of their sort keys.
+         *
+         * @param   pSortKey    The command's sort key.
+         * @param   pCommand    The draw command to execute.
+         */
+        virtual void Draw (
+            const std::uint64_t&    pSortKey,
+            const DrawCommand&      pCommand
+        ) = 0;
+
+        /**
+         * @brief   Called after the last draw command of a submission.
+         */
+        virtual void EndFrame () = 0;
+
+    };
+
+}
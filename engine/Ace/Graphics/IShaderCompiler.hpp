@@ -0,0 +1,104 @@
+/**
+ * @file    Ace/Graphics/IShaderCompiler.hpp
+ * @brief   Provides the descriptions of shaders and pipelines, and an
+ *          abstract interface for a backend's compiler of them.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the stages a shader may run at.
+     */
+    enum class ShaderStage : std::uint8_t
+    {
+        Vertex,
+        Fragment,
+        Compute
+    };
+
+    /**
+     * @brief   A structure describing one shader to compile: its source, and
+     *          everything else which changes the compiled result.
+     */
+    struct ShaderSource
+    {
+        std::string                 mPath;                          ///< @brief The logical path the source was read from, if any; recorded in manifests.
+        ShaderStage                 mStage = ShaderStage::Vertex;   ///< @brief The stage the shader runs at.
+        std::string                 mEntryPoint = "main";           ///< @brief The name of the shader's entry point.
+        std::vector<std::string>    mDefines;                       ///< @brief The preprocessor definitions, each `NAME` or `NAME=VALUE`, in any order.
+        std::string                 mSource;                        ///< @brief The shader's source.
+    };
+
+    /**
+     * @brief   A structure describing one pipeline to build: its shaders, and
+     *          the fixed-function state the backend bakes in with them.
+     */
+    struct PipelineSource
+    {
+        std::vector<ShaderSource>   mShaders;                       ///< @brief The pipeline's shaders, one per stage.
+        std::vector<std::uint8_t>   mState;                         ///< @brief The pipeline's state, as the backend encodes it.
+    };
+
+    /**
+     * @brief   An abstract interface for a backend's shader and pipeline
+     *          compiler.
+     *
+     * The compiled forms are opaque bytes, so that they can be cached
+     * without knowing the backend. Implementations must be safe to call from
+     * several threads at once.
+     */
+    class ACE_API IShaderCompiler
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~IShaderCompiler () = default;
+
+        /**
+         * @brief   Retrieves a value which changes whenever the compiler's
+         *          output would, such as a hash of its name, version and
+         *          target, so that binaries from other compilers are never
+         *          used.
+         *
+         * @return  The compiler's version.
+         */
+        virtual std::uint64_t GetVersion () const = 0;
+
+        /**
+         * @brief   Compiles one shader.
+         *
+         * @param   pShader The shader.
+         *
+         * @return  The compiled shader.
+         *
+         * @throw   `std::runtime_error` if the shader does not compile.
+         */
+        virtual astd::byte_buffer CompileShader (
+            const ShaderSource& pShader
+        ) = 0;
+
+        /**
+         * @brief   Builds a pipeline from its compiled shaders.
+         *
+         * @param   pShaders    The compiled shaders, in the pipeline's order.
+         * @param   pState      The pipeline's state.
+         *
+         * @return  The built pipeline.
+         *
+         * @throw   `std::runtime_error` if the pipeline cannot be built.
+         */
+        virtual astd::byte_buffer BuildPipeline (
+            std::span<const astd::byte_buffer>  pShaders,
+            std::span<const std::uint8_t>       pState
+        ) = 0;
+
+    };
+
+}
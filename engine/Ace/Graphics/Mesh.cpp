@@ -0,0 +1,235 @@
+/**
+ * @file    Ace/Graphics/Mesh.cpp
+ */
+
+#include <Ace/Graphics/Mesh.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Checks that an array of the given size lies wholly within a
+     *          blob, at an aligned offset.
+     */
+    static void RequireSection (
+        std::span<const std::uint8_t>   pBlob,
+        const std::size_t               pOffset,
+        const std::size_t               pSize,
+        const char*                     pName
+    )
+    {
+        if (pOffset % 16 != 0 || pOffset > pBlob.size() || pSize > pBlob.size() - pOffset)
+        {
+            ACE_THROW(std::runtime_error, "{}: The {} lie outside the blob!",
+                "Mesh", pName);
+        }
+    }
+
+    static float Dequantize (
+        const std::uint16_t pValue,
+        const float         pMinimum,
+        const float         pMaximum
+    )
+    {
+        return pMinimum + (pMaximum - pMinimum) * (static_cast<float>(pValue) / 65535.0f);
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::shared_ptr<Mesh> Mesh::FromBlob (
+        astd::byte_buffer   pBlob
+    )
+    {
+        auto lMesh = std::make_shared<Mesh>();
+        lMesh->mOwnedBlob = std::move(pBlob);
+        lMesh->mBlob = lMesh->mOwnedBlob;
+        lMesh->Bind();
+        return lMesh;
+    }
+
+    std::shared_ptr<Mesh> Mesh::FromFile (
+        std::unique_ptr<IVirtualFile>   pFile
+    )
+    {
+        const std::span<const std::uint8_t> lMapping = pFile->Map();
+        if (lMapping.empty() == true)
+        {
+            astd::byte_buffer lBlob(pFile->GetSize());
+            if (lBlob.empty() == false && pFile->Read(lBlob.data(), lBlob.size()) != lBlob.size())
+            {
+                ACE_THROW(std::runtime_error, "{}: Could not read the whole blob!",
+                    "Mesh");
+            }
+
+            return FromBlob(std::move(lBlob));
+        }
+
+        auto lMesh = std::make_shared<Mesh>();
+        lMesh->mFile = std::move(pFile);
+        lMesh->mBlob = lMapping;
+        lMesh->Bind();
+        return lMesh;
+    }
+
+    MeshVertex Mesh::Unpack (
+        const PackedVertex& pVertex
+    ) const
+    {
+        MeshVertex lVertex;
+        lVertex.mPosition = {
+            Dequantize(pVertex.mPosition[0], mBounds.mMin.mX, mBounds.mMax.mX),
+            Dequantize(pVertex.mPosition[1], mBounds.mMin.mY, mBounds.mMax.mY),
+            Dequantize(pVertex.mPosition[2], mBounds.mMin.mZ, mBounds.mMax.mZ)
+        };
+
+        // Undo the octahedral fold: the lower hemisphere was folded over the
+        // diagonals onto the upper one.
+        float lX = std::max(static_cast<float>(pVertex.mNormal[0]) / 127.0f, -1.0f);
+        float lY = std::max(static_cast<float>(pVertex.mNormal[1]) / 127.0f, -1.0f);
+        const float lZ = 1.0f - std::abs(lX) - std::abs(lY);
+        if (lZ < 0.0f)
+        {
+            const float lFoldedX = (1.0f - std::abs(lY)) * ((lX >= 0.0f) ? 1.0f : -1.0f);
+            const float lFoldedY = (1.0f - std::abs(lX)) * ((lY >= 0.0f) ? 1.0f : -1.0f);
+            lX = lFoldedX;
+            lY = lFoldedY;
+        }
+
+        lVertex.mNormal = Vector3f { lX, lY, lZ }.Normalized();
+        lVertex.mTexCoord = {
+            Dequantize(pVertex.mTexCoord[0], mTexCoordMin.mX, mTexCoordMax.mX),
+            Dequantize(pVertex.mTexCoord[1], mTexCoordMin.mY, mTexCoordMax.mY)
+        };
+
+        return lVertex;
+    }
+
+    std::size_t Mesh::SelectLod (
+        const Matrix4f& pModelView,
+        const Matrix4f& pProjection,
+        const float     pViewportHeight,
+        const float     pMaxPixelError
+    ) const
+    {
+        // Bound the mesh with a sphere, carried into view space; the
+        // model-view matrix may scale it.
+        const Vector3f lCenter = pModelView * mBounds.Center();
+        float lScale = 0.0f;
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            lScale = std::max(lScale, Vector3f { pModelView(0, c), pModelView(1, c), pModelView(2, c) }.Length());
+        }
+
+        const float lRadius = (mBounds.mMax - mBounds.mMin).Length() * 0.5f * lScale;
+
+        // The viewer looks down negative Z, so the sphere's nearest point has
+        // the greatest Z. Its clip-space W is its depth under a perspective
+        // projection, and one under an orthographic projection.
+        const float lNearest = lCenter.mZ + lRadius;
+        const float lW = pProjection(3, 2) * lNearest + pProjection(3, 3);
+        if (lW <= 1e-6f)
+        {
+            return 0;
+        }
+
+        const float lPixelsPerUnit = pProjection(1, 1) * pViewportHeight * 0.5f * lScale / lW;
+        for (std::size_t i = mLods.size(); i-- > 1; )
+        {
+            if (mLods[i].mError * lPixelsPerUnit <= pMaxPixelError)
+            {
+                return i;
+            }
+        }
+
+        return 0;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void Mesh::Bind ()
+    {
+        MeshBlobHeader lHeader;
+        if (mBlob.size() < sizeof(lHeader))
+        {
+            ACE_THROW(std::runtime_error, "{}: The blob is truncated!",
+                "Mesh");
+        }
+
+        // The mapping is page-aligned, and a read blob is aligned by the
+        // allocator, so arrays at aligned offsets are aligned in memory too.
+        const std::uint8_t lMagic[4] = { 'A', 'M', 'S', 'H' };
+        std::memcpy(&lHeader, mBlob.data(), sizeof(lHeader));
+        if (std::memcmp(lHeader.mMagic, lMagic, sizeof(lMagic)) != 0)
+        {
+            ACE_THROW(std::runtime_error, "{}: Data is not a cooked mesh!",
+                "Mesh");
+        }
+        else if (lHeader.mVersion != COOKED_VERSION)
+        {
+            ACE_THROW(std::runtime_error, "{}: Cooked version {} is not supported!",
+                "Mesh", lHeader.mVersion);
+        }
+
+        mWideIndices = (lHeader.mFlags & 1) != 0;
+        mIndexCount = lHeader.mIndexCount;
+
+        const std::size_t lIndexBytes = mIndexCount * ((mWideIndices == true) ? 4 : 2);
+        RequireSection(mBlob, lHeader.mVertexOffset, std::size_t { lHeader.mVertexCount } * sizeof(PackedVertex), "vertices");
+        RequireSection(mBlob, lHeader.mIndexOffset, lIndexBytes, "indices");
+        RequireSection(mBlob, lHeader.mMeshletOffset, std::size_t { lHeader.mMeshletCount } * sizeof(Meshlet), "meshlets");
+        RequireSection(mBlob, lHeader.mMeshletVertexOffset, std::size_t { lHeader.mMeshletVertexCount } * 4, "meshlet vertices");
+        RequireSection(mBlob, lHeader.mMeshletTriangleOffset, std::size_t { lHeader.mMeshletTriangleCount } * 3, "meshlet triangles");
+        RequireSection(mBlob, lHeader.mLodOffset, std::size_t { lHeader.mLodCount } * sizeof(MeshLod), "levels of detail");
+        if (lHeader.mLodCount == 0 || lHeader.mLodCount > MAX_LODS)
+        {
+            ACE_THROW(std::runtime_error, "{}: {} levels of detail are not supported!",
+                "Mesh", lHeader.mLodCount);
+        }
+
+        mVertices = { reinterpret_cast<const PackedVertex*>(mBlob.data() + lHeader.mVertexOffset), lHeader.mVertexCount };
+        mIndices = mBlob.data() + lHeader.mIndexOffset;
+        mMeshlets = { reinterpret_cast<const Meshlet*>(mBlob.data() + lHeader.mMeshletOffset), lHeader.mMeshletCount };
+        mMeshletVertices = {
+            reinterpret_cast<const std::uint32_t*>(mBlob.data() + lHeader.mMeshletVertexOffset),
+            lHeader.mMeshletVertexCount
+        };
+        mMeshletTriangles = { mBlob.data() + lHeader.mMeshletTriangleOffset, std::size_t { lHeader.mMeshletTriangleCount } * 3 };
+        mLods = { reinterpret_cast<const MeshLod*>(mBlob.data() + lHeader.mLodOffset), lHeader.mLodCount };
+
+        for (const Meshlet& lMeshlet : mMeshlets)
+        {
+            if (
+                std::size_t { lMeshlet.mVertexOffset } + lMeshlet.mVertexCount > mMeshletVertices.size() ||
+                std::size_t { lMeshlet.mTriangleOffset } + std::size_t { lMeshlet.mTriangleCount } * 3 > mMeshletTriangles.size()
+            )
+            {
+                ACE_THROW(std::runtime_error, "{}: A meshlet lies outside its lists!",
+                    "Mesh");
+            }
+        }
+
+        for (const MeshLod& lLod : mLods)
+        {
+            if (
+                std::size_t { lLod.mIndexOffset } + lLod.mIndexCount > mIndexCount ||
+                std::size_t { lLod.mMeshletOffset } + lLod.mMeshletCount > mMeshlets.size() ||
+                lLod.mVertexCount > mVertices.size() ||
+                std::isfinite(lLod.mError) == false
+            )
+            {
+                ACE_THROW(std::runtime_error, "{}: A level of detail lies outside its lists!",
+                    "Mesh");
+            }
+        }
+
+        mBounds = {
+            Vector3f { lHeader.mBoundsMin[0], lHeader.mBoundsMin[1], lHeader.mBoundsMin[2] },
+            Vector3f { lHeader.mBoundsMax[0], lHeader.mBoundsMax[1], lHeader.mBoundsMax[2] }
+        };
+        mTexCoordMin = { lHeader.mTexCoordMin[0], lHeader.mTexCoordMin[1] };
+        mTexCoordMax = { lHeader.mTexCoordMax[0], lHeader.mTexCoordMax[1] };
+    }
+
+}
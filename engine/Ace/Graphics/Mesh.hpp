@@ -0,0 +1,420 @@
+/**
+ * @file    Ace/Graphics/Mesh.hpp
+ * @brief   Provides the vertex formats of meshes, and a class which views a
+ *          cooked mesh in place, without copying it.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+#include <Ace/Maths/AABB3.hpp>
+#include <Ace/Maths/Matrix4.hpp>
+#include <Ace/Maths/Vector2.hpp>
+#include <Ace/System/IVirtualFile.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing one vertex of a mesh, at full
+     *          precision, as it is before cooking.
+     */
+    struct MeshVertex
+    {
+        Vector3f    mPosition;  ///< @brief The vertex's model-space position.
+        Vector3f    mNormal;    ///< @brief The vertex's unit normal.
+        Vector2f    mTexCoord;  ///< @brief The vertex's texture coordinates.
+    };
+
+    /**
+     * @brief   A structure containing one vertex of a cooked mesh, quantized
+     *          to 12 bytes.
+     */
+    struct PackedVertex
+    {
+        std::uint16_t   mPosition[3];   ///< @brief The position, as fractions of the mesh's bounds.
+        std::int8_t     mNormal[2];     ///< @brief The normal, octahedrally encoded.
+        std::uint16_t   mTexCoord[2];   ///< @brief The texture coordinates, as fractions of the mesh's texture coordinate range.
+    };
+
+    static_assert(sizeof(PackedVertex) == 12);
+
+    /**
+     * @brief   A structure describing a meshlet: a small cluster of a mesh's
+     *          triangles, which can be culled and drawn as a unit.
+     *
+     * Each meshlet lists the mesh vertices it uses; its triangles index into
+     * that list, with one byte per corner.
+     */
+    struct Meshlet
+    {
+        std::uint32_t   mVertexOffset = 0;      ///< @brief The index of the meshlet's first entry in the meshlet vertex list.
+        std::uint32_t   mTriangleOffset = 0;    ///< @brief The index of the meshlet's first byte in the meshlet triangle list.
+        std::uint16_t   mVertexCount = 0;       ///< @brief The number of vertices the meshlet uses.
+        std::uint16_t   mTriangleCount = 0;     ///< @brief The number of triangles in the meshlet.
+        float           mCenter[3] = {};        ///< @brief The centre of the meshlet's bounding sphere.
+        float           mRadius = 0.0f;         ///< @brief The radius of the meshlet's bounding sphere.
+        float           mConeAxis[3] = {};      ///< @brief The average direction the meshlet's triangles face.
+        float           mConeCutoff = -1.0f;    ///< @brief The least cosine between the axis and any triangle's normal; the meshlet faces wholly away from viewers beyond this, if positive.
+    };
+
+    static_assert(sizeof(Meshlet) == 44);
+
+    /**
+     * @brief   A structure describing one level of detail of a mesh.
+     *
+     * Levels share the mesh's vertices, and each has its own triangles and
+     * meshlets. Level 0 is the full-detail mesh. Levels are stored
+     * coarsest first, so each one needs only a prefix of every array.
+     */
+    struct MeshLod
+    {
+        std::uint32_t   mIndexOffset = 0;       ///< @brief The index of the level's first entry in the index list.
+        std::uint32_t   mIndexCount = 0;        ///< @brief The number of indices in the level, three per triangle; zero if the level's data is not in this blob.
+        std::uint32_t   mVertexCount = 0;       ///< @brief The number of vertices, from the start of the vertex list, which the level and every coarser one use.
+        std::uint32_t   mMeshletOffset = 0;     ///< @brief The index of the level's first meshlet.
+        std::uint32_t   mMeshletCount = 0;      ///< @brief The number of meshlets in the level.
+        float           mError = 0.0f;          ///< @brief The furthest, in model space, that the level may stray from the full-detail mesh.
+    };
+
+    static_assert(sizeof(MeshLod) == 24);
+
+    /**
+     * @brief   A structure containing the header at the start of every cooked
+     *          mesh blob.
+     *
+     * Each array follows at the offset given, aligned to 16 bytes, so that it
+     * can be used in place.
+     */
+    struct MeshBlobHeader
+    {
+        std::uint8_t    mMagic[4] = { 'A', 'M', 'S', 'H' };     ///< @brief The magic number, `AMSH`.
+        std::uint16_t   mVersion = 0;                           ///< @brief The @a `Mesh::COOKED_VERSION` the blob was written with.
+        std::uint16_t   mFlags = 0;                             ///< @brief Bit 0 is set if indices are 32 bits wide.
+        std::uint32_t   mVertexCount = 0;                       ///< @brief The number of packed vertices.
+        std::uint32_t   mIndexCount = 0;                        ///< @brief The number of indices.
+        std::uint32_t   mMeshletCount = 0;                      ///< @brief The number of meshlets.
+        std::uint32_t   mMeshletVertexCount = 0;                ///< @brief The length of the meshlet vertex list.
+        std::uint32_t   mMeshletTriangleCount = 0;              ///< @brief The number of meshlet triangles, at three bytes each.
+        std::uint32_t   mLodCount = 0;                          ///< @brief The number of levels of detail.
+        float           mBoundsMin[3] = {};                     ///< @brief The least position.
+        float           mBoundsMax[3] = {};                     ///< @brief The greatest position.
+        float           mTexCoordMin[2] = {};                   ///< @brief The least texture coordinates.
+        float           mTexCoordMax[2] = {};                   ///< @brief The greatest texture coordinates.
+        std::uint32_t   mVertexOffset = 0;                      ///< @brief The offset of the packed vertices.
+        std::uint32_t   mIndexOffset = 0;                       ///< @brief The offset of the index list.
+        std::uint32_t   mMeshletOffset = 0;                     ///< @brief The offset of the meshlets.
+        std::uint32_t   mMeshletVertexOffset = 0;               ///< @brief The offset of the meshlet vertex list.
+        std::uint32_t   mMeshletTriangleOffset = 0;             ///< @brief The offset of the meshlet triangle list.
+        std::uint32_t   mLodOffset = 0;                         ///< @brief The offset of the level of detail table.
+    };
+
+    /**
+     * @brief   A class which views a cooked mesh blob, as written by the
+     *          @a `MeshCooker`, in place.
+     *
+     * The blob is laid out so that every array in it can be used where it
+     * lies. When it comes from a file which can be mapped, the mesh keeps the
+     * file open and views the mapping, so loading costs no more than
+     * validating the header and meshlet table; otherwise, the blob is read
+     * into memory once. Either way, nothing is unpacked. Blobs are
+     * little-endian.
+     *
+     * A mesh may have several levels of detail, each with its own stretch of
+     * the index list and meshlets. @a `SelectLod` picks the coarsest one
+     * whose error, projected onto the screen, is small enough. A blob may
+     * hold only the coarser levels; the table still lists every level's
+     * error, so a viewer knows when to stream in a finer blob.
+     *
+     * Indices are not checked against the vertex count, as they are used by
+     * the GPU where they lie; blobs should come from the cooker, or from a
+     * checksummed cache.
+     */
+    class ACE_API Mesh final
+    {
+    public:
+
+        /**
+         * @brief   The version of the blob format. Bumped whenever it, or the
+         *          cooker's output, changes, so that stale blobs are rejected.
+         */
+        static constexpr std::uint16_t COOKED_VERSION = 2;
+
+        /**
+         * @brief   The most levels of detail a mesh may have.
+         */
+        static constexpr std::size_t MAX_LODS = 8;
+
+    public:
+
+        /**
+         * @brief   Views a blob held in memory, taking ownership of it.
+         *
+         * @param   pBlob   The blob.
+         *
+         * @return  The mesh.
+         *
+         * @throw   `std::runtime_error` if the blob is truncated, was written
+         *          by a different version, or describes arrays out of bounds.
+         */
+        static std::shared_ptr<Mesh> FromBlob (
+            astd::byte_buffer   pBlob
+        );
+
+        /**
+         * @brief   Views a blob stored in a file, mapping it if possible and
+         *          reading it otherwise.
+         *
+         * @param   pFile   The file.
+         *
+         * @return  The mesh.
+         *
+         * @throw   `std::runtime_error` if the file cannot be read, or the
+         *          blob is invalid as for @a `FromBlob`.
+         */
+        static std::shared_ptr<Mesh> FromFile (
+            std::unique_ptr<IVirtualFile>   pFile
+        );
+
+    public:
+
+        /**
+         * @brief   Expands a packed vertex of this mesh to full precision.
+         *
+         * @param   pVertex The packed vertex.
+         *
+         * @return  The vertex.
+         */
+        MeshVertex Unpack (
+            const PackedVertex& pVertex
+        ) const;
+
+        /**
+         * @brief   Retrieves the mesh's packed vertices.
+         *
+         * @return  The vertices.
+         */
+        inline std::span<const PackedVertex> GetVertices () const
+        {
+            return mVertices;
+        }
+
+        /**
+         * @brief   Retrieves whether the index list holds 32-bit indices,
+         *          rather than 16-bit ones.
+         *
+         * @return  `true` if indices are 32 bits wide; `false` otherwise.
+         */
+        inline bool HasWideIndices () const
+        {
+            return mWideIndices;
+        }
+
+        /**
+         * @brief   Retrieves the number of entries in the index list.
+         *
+         * @return  The number of indices, three per triangle, across every
+         *          level of detail.
+         */
+        inline std::size_t GetIndexCount () const
+        {
+            return mIndexCount;
+        }
+
+        /**
+         * @brief   Retrieves one entry of the index list, whatever its width.
+         *
+         * @param   pIndex  The entry's position in the list.
+         *
+         * @return  The vertex index.
+         */
+        inline std::uint32_t GetIndex (
+            const std::size_t   pIndex
+        ) const
+        {
+            return (mWideIndices == true) ?
+                reinterpret_cast<const std::uint32_t*>(mIndices)[pIndex] :
+                reinterpret_cast<const std::uint16_t*>(mIndices)[pIndex];
+        }
+
+        /**
+         * @brief   Retrieves the raw index list, for upload.
+         *
+         * @return  The index list's bytes.
+         */
+        inline std::span<const std::uint8_t> GetIndexData () const
+        {
+            return { mIndices, mIndexCount * ((mWideIndices == true) ? 4 : 2) };
+        }
+
+        /**
+         * @brief   Retrieves the mesh's meshlets, level after level, each
+         *          level's in drawing order.
+         *
+         * @return  The meshlets.
+         */
+        inline std::span<const Meshlet> GetMeshlets () const
+        {
+            return mMeshlets;
+        }
+
+        /**
+         * @brief   Retrieves the vertices each meshlet uses, meshlet after
+         *          meshlet.
+         *
+         * @return  The meshlet vertex list.
+         */
+        inline std::span<const std::uint32_t> GetMeshletVertices () const
+        {
+            return mMeshletVertices;
+        }
+
+        /**
+         * @brief   Retrieves the corners of each meshlet's triangles, as
+         *          indices into its vertices, meshlet after meshlet.
+         *
+         * @return  The meshlet triangle list.
+         */
+        inline std::span<const std::uint8_t> GetMeshletTriangles () const
+        {
+            return mMeshletTriangles;
+        }
+
+        /**
+         * @brief   Retrieves the mesh's levels of detail, finest first.
+         *
+         * @return  The level of detail table.
+         */
+        inline std::span<const MeshLod> GetLods () const
+        {
+            return mLods;
+        }
+
+        /**
+         * @brief   Retrieves whether this blob holds the given level of
+         *          detail's data.
+         *
+         * @param   pLevel  The level.
+         *
+         * @return  `true` if the level can be drawn from this mesh; `false`
+         *          otherwise.
+         */
+        inline bool HasLod (
+            const std::size_t   pLevel
+        ) const
+        {
+            return pLevel < mLods.size() && mLods[pLevel].mIndexCount != 0;
+        }
+
+        /**
+         * @brief   Retrieves the raw index list of one level of detail, for
+         *          upload.
+         *
+         * @param   pLevel  The level.
+         *
+         * @return  The level's index bytes.
+         */
+        inline std::span<const std::uint8_t> GetLodIndexData (
+            const std::size_t   pLevel
+        ) const
+        {
+            const std::size_t lWidth = (mWideIndices == true) ? 4 : 2;
+            return { mIndices + mLods[pLevel].mIndexOffset * lWidth, mLods[pLevel].mIndexCount * lWidth };
+        }
+
+        /**
+         * @brief   Retrieves the meshlets of one level of detail.
+         *
+         * @param   pLevel  The level.
+         *
+         * @return  The level's meshlets.
+         */
+        inline std::span<const Meshlet> GetLodMeshlets (
+            const std::size_t   pLevel
+        ) const
+        {
+            return mMeshlets.subspan(mLods[pLevel].mMeshletOffset, mLods[pLevel].mMeshletCount);
+        }
+
+        /**
+         * @brief   Picks the coarsest level of detail whose error, projected
+         *          onto the screen, is within the given number of pixels.
+         *
+         * The error is measured where the mesh's bounding sphere comes
+         * nearest the viewer, so the choice errs towards detail. The
+         * projection may be perspective or orthographic. Levels are picked
+         * from the whole table, whether or not their data is in this blob.
+         *
+         * @param   pModelView      The matrix from model space to view
+         *                          space.
+         * @param   pProjection     The projection matrix.
+         * @param   pViewportHeight The height of the viewport, in pixels.
+         * @param   pMaxPixelError  The most error to allow, in pixels.
+         *
+         * @return  The level to draw.
+         */
+        std::size_t SelectLod (
+            const Matrix4f& pModelView,
+            const Matrix4f& pProjection,
+            const float     pViewportHeight,
+            const float     pMaxPixelError
+        ) const;
+
+        /**
+         * @brief   Retrieves the mesh's bounding box.
+         *
+         * @return  The bounds.
+         */
+        inline const AABB3f& GetBounds () const
+        {
+            return mBounds;
+        }
+
+        /**
+         * @brief   Retrieves whether the mesh views a mapped file, rather than
+         *          a copy of it in memory.
+         *
+         * @return  `true` if the blob is mapped; `false` otherwise.
+         */
+        inline bool IsMapped () const
+        {
+            return mFile != nullptr;
+        }
+
+        /**
+         * @brief   Retrieves the whole blob the mesh views.
+         *
+         * @return  The blob.
+         */
+        inline std::span<const std::uint8_t> GetBlob () const
+        {
+            return mBlob;
+        }
+
+    private:
+
+        /**
+         * @brief   Validates the blob's header and points the mesh's arrays
+         *          into it.
+         */
+        void Bind ();
+
+    private:
+        std::unique_ptr<IVirtualFile>   mFile;                  ///< @brief The mapped file the blob lies in, if any.
+        astd::byte_buffer               mOwnedBlob;             ///< @brief The blob, if it was read into memory.
+        std::span<const std::uint8_t>   mBlob;                  ///< @brief The blob, wherever it lies.
+        std::span<const PackedVertex>   mVertices;              ///< @brief The packed vertices.
+        const std::uint8_t*             mIndices = nullptr;     ///< @brief The index list.
+        std::size_t                     mIndexCount = 0;        ///< @brief The number of indices.
+        bool                            mWideIndices = false;   ///< @brief Are indices 32 bits wide?
+        std::span<const Meshlet>        mMeshlets;              ///< @brief The meshlets.
+        std::span<const std::uint32_t>  mMeshletVertices;       ///< @brief The vertices each meshlet uses, meshlet after meshlet.
+        std::span<const std::uint8_t>   mMeshletTriangles;      ///< @brief The corners of each meshlet's triangles, as indices into its vertices.
+        std::span<const MeshLod>        mLods;                  ///< @brief The levels of detail, finest first.
+        AABB3f                          mBounds;                ///< @brief The bounds positions are quantized within.
+        Vector2f                        mTexCoordMin;           ///< @brief The least texture coordinates.
+        Vector2f                        mTexCoordMax;           ///< @brief The greatest texture coordinates.
+
+    };
+
+}
@@ -0,0 +1,1249 @@
+/**
+ * @file    Ace/Graphics/MeshCooker.cpp
+ */
+
+#include <bit>
+#include <numeric>
+#include <Ace/Graphics/MeshCooker.hpp>
+
+namespace ace
+{
+
+    /* Helper Structures ******************************************************/
+
+    /**
+     * @brief   A quadric error metric: the symmetric matrix which, applied to
+     *          a point, sums its weighted squared distances to a set of
+     *          planes.
+     */
+    struct Quadric
+    {
+        double  mXX = 0.0;      ///< @brief The matrix's upper triangle, row after row.
+        double  mXY = 0.0;
+        double  mXZ = 0.0;
+        double  mXW = 0.0;
+        double  mYY = 0.0;
+        double  mYZ = 0.0;
+        double  mYW = 0.0;
+        double  mZZ = 0.0;
+        double  mZW = 0.0;
+        double  mWW = 0.0;
+        double  mWeight = 0.0;  ///< @brief The total weight of the planes.
+    };
+
+    /* Helper Functions *******************************************************/
+
+    // Tipsify's clusters only end at dead ends, which a well-connected mesh
+    // may never reach; clusters are therefore also ended at the first fan
+    // boundary after they reach this many triangles, so that overdraw
+    // ordering has something to work with.
+    static constexpr std::size_t MAX_CLUSTER_TRIANGLES = 256;
+
+    static constexpr std::uint32_t NO_VERTEX = std::numeric_limits<std::uint32_t>::max();
+
+    // How much more the planes which hold open borders in place weigh than
+    // those of the faces themselves.
+    static constexpr double BORDER_WEIGHT = 10.0;
+
+    /**
+     * @brief   Hashes an array of words, one at a time.
+     */
+    static std::uint64_t HashWords (
+        std::span<const std::uint32_t>  pWords
+    )
+    {
+        std::uint64_t lHash = 0xCBF29CE484222325ull;
+        for (const std::uint32_t lWord : pWords)
+        {
+            lHash = (lHash ^ lWord) * 0x9E3779B97F4A7C15ull;
+            lHash ^= lHash >> 29;
+        }
+
+        return lHash;
+    }
+
+    static std::uint64_t HashVertex (
+        const MeshVertex&   pVertex
+    )
+    {
+        std::uint32_t lWords[sizeof(MeshVertex) / 4];
+        std::memcpy(lWords, &pVertex, sizeof(lWords));
+        return HashWords(lWords);
+    }
+
+    static std::uint64_t HashPosition (
+        const Vector3f& pPosition
+    )
+    {
+        const float lCoordinates[3] = { pPosition.mX, pPosition.mY, pPosition.mZ };
+        std::uint32_t lWords[3];
+        std::memcpy(lWords, lCoordinates, sizeof(lWords));
+        return HashWords(lWords);
+    }
+
+    static Vector3f TriangleNormal (
+        const Vector3f& pFirst,
+        const Vector3f& pSecond,
+        const Vector3f& pThird
+    )
+    {
+        return (pSecond - pFirst).Cross(pThird - pFirst);
+    }
+
+    static std::uint16_t QuantizeUnit (
+        const float pValue,
+        const float pMinimum,
+        const float pMaximum
+    )
+    {
+        if (pMaximum <= pMinimum)
+        {
+            return 0;
+        }
+
+        const float lFraction = std::clamp((pValue - pMinimum) / (pMaximum - pMinimum), 0.0f, 1.0f);
+        return static_cast<std::uint16_t>(std::lround(lFraction * 65535.0f));
+    }
+
+    /**
+     * @brief   Encodes a unit normal in two bytes, by projecting it onto an
+     *          octahedron and unfolding that onto a square.
+     */
+    static void EncodeOctahedral (
+        const Vector3f& pNormal,
+        std::int8_t     pOut[2]
+    )
+    {
+        const float lSum = std::abs(pNormal.mX) + std::abs(pNormal.mY) + std::abs(pNormal.mZ);
+        float lX = (lSum > 0.0f) ? pNormal.mX / lSum : 0.0f;
+        float lY = (lSum > 0.0f) ? pNormal.mY / lSum : 0.0f;
+        if (pNormal.mZ < 0.0f)
+        {
+            const float lFoldedX = (1.0f - std::abs(lY)) * ((lX >= 0.0f) ? 1.0f : -1.0f);
+            const float lFoldedY = (1.0f - std::abs(lX)) * ((lY >= 0.0f) ? 1.0f : -1.0f);
+            lX = lFoldedX;
+            lY = lFoldedY;
+        }
+
+        pOut[0] = static_cast<std::int8_t>(std::lround(std::clamp(lX, -1.0f, 1.0f) * 127.0f));
+        pOut[1] = static_cast<std::int8_t>(std::lround(std::clamp(lY, -1.0f, 1.0f) * 127.0f));
+    }
+
+    /**
+     * @brief   Builds the quadric of one plane, through the given point with
+     *          the given unit normal.
+     */
+    static Quadric PlaneQuadric (
+        const Vector3f& pNormal,
+        const Vector3f& pPoint,
+        const double    pWeight
+    )
+    {
+        const double lA = pNormal.mX;
+        const double lB = pNormal.mY;
+        const double lC = pNormal.mZ;
+        const double lD = -pNormal.Dot(pPoint);
+
+        return Quadric {
+            .mXX = lA * lA * pWeight, .mXY = lA * lB * pWeight, .mXZ = lA * lC * pWeight, .mXW = lA * lD * pWeight,
+            .mYY = lB * lB * pWeight, .mYZ = lB * lC * pWeight, .mYW = lB * lD * pWeight,
+            .mZZ = lC * lC * pWeight, .mZW = lC * lD * pWeight,
+            .mWW = lD * lD * pWeight,
+            .mWeight = pWeight
+        };
+    }
+
+    static void AddQuadric (
+        Quadric&        pTo,
+        const Quadric&  pFrom
+    )
+    {
+        pTo.mXX += pFrom.mXX; pTo.mXY += pFrom.mXY; pTo.mXZ += pFrom.mXZ; pTo.mXW += pFrom.mXW;
+        pTo.mYY += pFrom.mYY; pTo.mYZ += pFrom.mYZ; pTo.mYW += pFrom.mYW;
+        pTo.mZZ += pFrom.mZZ; pTo.mZW += pFrom.mZW;
+        pTo.mWW += pFrom.mWW;
+        pTo.mWeight += pFrom.mWeight;
+    }
+
+    /**
+     * @brief   Measures the distance from a point to a quadric's planes, as
+     *          the root of their weighted mean squared distance.
+     */
+    static float QuadricError (
+        const Quadric&  pQuadric,
+        const Vector3f& pPoint
+    )
+    {
+        if (pQuadric.mWeight <= 0.0)
+        {
+            return 0.0f;
+        }
+
+        const double lX = pPoint.mX;
+        const double lY = pPoint.mY;
+        const double lZ = pPoint.mZ;
+        const double lSum =
+            lX * (lX * pQuadric.mXX + 2.0 * (lY * pQuadric.mXY + lZ * pQuadric.mXZ + pQuadric.mXW)) +
+            lY * (lY * pQuadric.mYY + 2.0 * (lZ * pQuadric.mYZ + pQuadric.mYW)) +
+            lZ * (lZ * pQuadric.mZZ + 2.0 * pQuadric.mZW) +
+            pQuadric.mWW;
+
+        return static_cast<float>(std::sqrt(std::max(lSum, 0.0) / pQuadric.mWeight));
+    }
+
+    /**
+     * @brief   Splits indices into meshlets, in order, starting a new meshlet
+     *          whenever the next triangle would not fit.
+     */
+    static void BuildMeshlets (
+        std::span<const MeshVertex>     pVertices,
+        std::span<const std::uint32_t>  pIndices,
+        const MeshCookSpec&             pSpec,
+        std::vector<Meshlet>&           pMeshlets,
+        std::vector<std::uint32_t>&     pMeshletVertices,
+        std::vector<std::uint8_t>&      pMeshletTriangles
+    )
+    {
+        std::vector<std::uint32_t> lLocal(pVertices.size(), NO_VERTEX);
+        Meshlet lMeshlet;
+        lMeshlet.mVertexOffset = static_cast<std::uint32_t>(pMeshletVertices.size());
+        lMeshlet.mTriangleOffset = static_cast<std::uint32_t>(pMeshletTriangles.size());
+
+        auto lFinish =
+            [&] ()
+            {
+                if (lMeshlet.mTriangleCount == 0)
+                {
+                    return;
+                }
+
+                // Bound the meshlet's vertices with a sphere about the centre
+                // of their box.
+                auto lBox = AABB3f::Empty();
+                for (std::size_t i = 0; i < lMeshlet.mVertexCount; ++i)
+                {
+                    lBox.Merge(pVertices[pMeshletVertices[lMeshlet.mVertexOffset + i]].mPosition);
+                }
+
+                const Vector3f lCenter = lBox.Center();
+                float lRadius = 0.0f;
+                for (std::size_t i = 0; i < lMeshlet.mVertexCount; ++i)
+                {
+                    lRadius = std::max(lRadius, (pVertices[pMeshletVertices[lMeshlet.mVertexOffset + i]].mPosition - lCenter).Length());
+                }
+
+                // Bound the directions its triangles face with a cone about
+                // their average.
+                Vector3f lAxis = Vector3f::Zero();
+                std::vector<Vector3f> lNormals;
+                for (std::size_t t = 0; t < lMeshlet.mTriangleCount; ++t)
+                {
+                    const std::uint8_t* lCorners = pMeshletTriangles.data() + lMeshlet.mTriangleOffset + t * 3;
+                    const Vector3f lNormal = TriangleNormal(
+                        pVertices[pMeshletVertices[lMeshlet.mVertexOffset + lCorners[0]]].mPosition,
+                        pVertices[pMeshletVertices[lMeshlet.mVertexOffset + lCorners[1]]].mPosition,
+                        pVertices[pMeshletVertices[lMeshlet.mVertexOffset + lCorners[2]]].mPosition);
+                    const float lLength = lNormal.Length();
+                    if (lLength > 0.0f)
+                    {
+                        lNormals.push_back(lNormal / lLength);
+                        lAxis += lNormals.back();
+                    }
+                }
+
+                float lCutoff = -1.0f;
+                if (lAxis.Length() > 1e-6f)
+                {
+                    lAxis = lAxis.Normalized();
+                    lCutoff = 1.0f;
+                    for (const Vector3f& lNormal : lNormals)
+                    {
+                        lCutoff = std::min(lCutoff, lAxis.Dot(lNormal));
+                    }
+                }
+
+                lMeshlet.mCenter[0] = lCenter.mX;
+                lMeshlet.mCenter[1] = lCenter.mY;
+                lMeshlet.mCenter[2] = lCenter.mZ;
+                lMeshlet.mRadius = lRadius;
+                lMeshlet.mConeAxis[0] = lAxis.mX;
+                lMeshlet.mConeAxis[1] = lAxis.mY;
+                lMeshlet.mConeAxis[2] = lAxis.mZ;
+                lMeshlet.mConeCutoff = lCutoff;
+                pMeshlets.push_back(lMeshlet);
+
+                for (std::size_t i = 0; i < lMeshlet.mVertexCount; ++i)
+                {
+                    lLocal[pMeshletVertices[lMeshlet.mVertexOffset + i]] = NO_VERTEX;
+                }
+
+                lMeshlet = {};
+                lMeshlet.mVertexOffset = static_cast<std::uint32_t>(pMeshletVertices.size());
+                lMeshlet.mTriangleOffset = static_cast<std::uint32_t>(pMeshletTriangles.size());
+            };
+
+        for (std::size_t t = 0; t < pIndices.size(); t += 3)
+        {
+            std::size_t lNewVertices = 0;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                const bool lRepeated = (c > 0 && pIndices[t + c] == pIndices[t]) || (c > 1 && pIndices[t + 2] == pIndices[t + 1]);
+                lNewVertices += (lLocal[pIndices[t + c]] == NO_VERTEX && lRepeated == false) ? 1 : 0;
+            }
+
+            if (
+                lMeshlet.mVertexCount + lNewVertices > pSpec.mMaxMeshletVertices ||
+                lMeshlet.mTriangleCount + 1u > pSpec.mMaxMeshletTriangles
+            )
+            {
+                lFinish();
+            }
+
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                const std::uint32_t lVertex = pIndices[t + c];
+                if (lLocal[lVertex] == NO_VERTEX)
+                {
+                    lLocal[lVertex] = lMeshlet.mVertexCount++;
+                    pMeshletVertices.push_back(lVertex);
+                }
+
+                pMeshletTriangles.push_back(static_cast<std::uint8_t>(lLocal[lVertex]));
+            }
+
+            ++lMeshlet.mTriangleCount;
+        }
+
+        lFinish();
+    }
+
+    /**
+     * @brief   Appends zero bytes to a blob until its size is a multiple of
+     *          16, and returns that size.
+     */
+    static std::uint32_t AlignBlob (
+        astd::byte_buffer&  pBlob
+    )
+    {
+        pBlob.resize((pBlob.size() + 15) & ~std::size_t { 15 }, 0);
+        return static_cast<std::uint32_t>(pBlob.size());
+    }
+
+    template <typename T>
+    static void AppendArray (
+        astd::byte_buffer&  pBlob,
+        std::span<const T>  pArray
+    )
+    {
+        const auto* lBytes = reinterpret_cast<const std::uint8_t*>(pArray.data());
+        pBlob.insert(pBlob.end(), lBytes, lBytes + pArray.size_bytes());
+    }
+
+    /**
+     * @brief   Lays a blob's arrays out after its header, each aligned, then
+     *          writes the header with their counts and offsets.
+     */
+    static astd::byte_buffer WriteBlob (
+        MeshBlobHeader&                 pHeader,
+        std::span<const MeshLod>        pLods,
+        std::span<const PackedVertex>   pVertices,
+        std::span<const std::uint8_t>   pIndexData,
+        std::span<const Meshlet>        pMeshlets,
+        std::span<const std::uint32_t>  pMeshletVertices,
+        std::span<const std::uint8_t>   pMeshletTriangles
+    )
+    {
+        pHeader.mVertexCount = static_cast<std::uint32_t>(pVertices.size());
+        pHeader.mIndexCount = static_cast<std::uint32_t>(pIndexData.size() / (((pHeader.mFlags & 1) != 0) ? 4 : 2));
+        pHeader.mMeshletCount = static_cast<std::uint32_t>(pMeshlets.size());
+        pHeader.mMeshletVertexCount = static_cast<std::uint32_t>(pMeshletVertices.size());
+        pHeader.mMeshletTriangleCount = static_cast<std::uint32_t>(pMeshletTriangles.size() / 3);
+        pHeader.mLodCount = static_cast<std::uint32_t>(pLods.size());
+
+        // The level of detail table comes first, beside the header, so that
+        // choosing a level touches as little of a mapped blob as possible.
+        astd::byte_buffer lBlob(sizeof(pHeader), 0);
+        pHeader.mLodOffset = AlignBlob(lBlob);
+        AppendArray<MeshLod>(lBlob, pLods);
+        pHeader.mVertexOffset = AlignBlob(lBlob);
+        AppendArray<PackedVertex>(lBlob, pVertices);
+        pHeader.mIndexOffset = AlignBlob(lBlob);
+        AppendArray<std::uint8_t>(lBlob, pIndexData);
+        pHeader.mMeshletOffset = AlignBlob(lBlob);
+        AppendArray<Meshlet>(lBlob, pMeshlets);
+        pHeader.mMeshletVertexOffset = AlignBlob(lBlob);
+        AppendArray<std::uint32_t>(lBlob, pMeshletVertices);
+        pHeader.mMeshletTriangleOffset = AlignBlob(lBlob);
+        AppendArray<std::uint8_t>(lBlob, pMeshletTriangles);
+        AlignBlob(lBlob);
+
+        std::memcpy(lBlob.data(), &pHeader, sizeof(pHeader));
+        return lBlob;
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::vector<MeshVertex> MeshCooker::Deduplicate (
+        std::span<const MeshVertex>     pVertices,
+        std::vector<std::uint32_t>&     pIndices
+    )
+    {
+        std::size_t lTableSize = 16;
+        while (lTableSize < pVertices.size() * 2)
+        {
+            lTableSize *= 2;
+        }
+
+        std::vector<std::uint32_t> lTable(lTableSize, NO_VERTEX);
+        std::vector<std::uint32_t> lRemap(pVertices.size(), NO_VERTEX);
+        std::vector<MeshVertex> lUnique;
+        lUnique.reserve(pVertices.size());
+
+        for (std::uint32_t& lIndex : pIndices)
+        {
+            if (lRemap[lIndex] != NO_VERTEX)
+            {
+                lIndex = lRemap[lIndex];
+                continue;
+            }
+
+            // Probe linearly from the vertex's hash until either an equal
+            // vertex or an empty slot turns up.
+            const MeshVertex& lVertex = pVertices[lIndex];
+            std::size_t lSlot = HashVertex(lVertex) & (lTableSize - 1);
+            while (
+                lTable[lSlot] != NO_VERTEX &&
+                std::memcmp(&lUnique[lTable[lSlot]], &lVertex, sizeof(MeshVertex)) != 0
+            )
+            {
+                lSlot = (lSlot + 1) & (lTableSize - 1);
+            }
+
+            if (lTable[lSlot] == NO_VERTEX)
+            {
+                lTable[lSlot] = static_cast<std::uint32_t>(lUnique.size());
+                lUnique.push_back(lVertex);
+            }
+
+            lRemap[lIndex] = lTable[lSlot];
+            lIndex = lTable[lSlot];
+        }
+
+        return lUnique;
+    }
+
+    std::vector<std::uint32_t> MeshCooker::OptimizeVertexCache (
+        std::vector<std::uint32_t>&     pIndices,
+        const std::size_t               pVertexCount,
+        const std::size_t               pCacheSize
+    )
+    {
+        const std::size_t lTriangleCount = pIndices.size() / 3;
+        std::vector<std::uint32_t> lClusters;
+        if (lTriangleCount == 0)
+        {
+            return lClusters;
+        }
+
+        // Gather the triangles around each vertex.
+        std::vector<std::uint32_t> lLive(pVertexCount, 0);
+        for (const std::uint32_t lIndex : pIndices)
+        {
+            ++lLive[lIndex];
+        }
+
+        std::vector<std::uint32_t> lOffsets(pVertexCount + 1, 0);
+        for (std::size_t v = 0; v < pVertexCount; ++v)
+        {
+            lOffsets[v + 1] = lOffsets[v] + lLive[v];
+        }
+
+        std::vector<std::uint32_t> lAdjacency(pIndices.size());
+        std::vector<std::uint32_t> lFill(lOffsets.begin(), lOffsets.end() - 1);
+        for (std::size_t i = 0; i < pIndices.size(); ++i)
+        {
+            lAdjacency[lFill[pIndices[i]]++] = static_cast<std::uint32_t>(i / 3);
+        }
+
+        std::vector<std::size_t> lCacheTime(pVertexCount, 0);
+        std::vector<bool> lEmitted(lTriangleCount, false);
+        std::vector<std::uint32_t> lDeadEnds;
+        std::vector<std::uint32_t> lCandidates;
+        std::vector<std::uint32_t> lOutput;
+        lOutput.reserve(pIndices.size());
+
+        std::size_t lTime = pCacheSize + 1;
+        std::size_t lCursor = 0;
+        std::int64_t lFanning = pIndices[0];
+        lClusters.push_back(0);
+
+        while (lFanning >= 0)
+        {
+            // Emit every triangle left around the fanning vertex.
+            lCandidates.clear();
+            for (std::uint32_t a = lOffsets[lFanning]; a < lOffsets[lFanning + 1]; ++a)
+            {
+                const std::uint32_t lTriangle = lAdjacency[a];
+                if (lEmitted[lTriangle] == true)
+                {
+                    continue;
+                }
+
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    const std::uint32_t lVertex = pIndices[lTriangle * 3 + c];
+                    lOutput.push_back(lVertex);
+                    lDeadEnds.push_back(lVertex);
+                    lCandidates.push_back(lVertex);
+                    --lLive[lVertex];
+                    if (lTime - lCacheTime[lVertex] > pCacheSize)
+                    {
+                        lCacheTime[lVertex] = lTime++;
+                    }
+                }
+
+                lEmitted[lTriangle] = true;
+            }
+
+            // Prefer the candidate which has been in the cache longest, as
+            // long as fanning around it would not push it out.
+            std::int64_t lNext = -1;
+            std::int64_t lBestPriority = -1;
+            for (const std::uint32_t lVertex : lCandidates)
+            {
+                if (lLive[lVertex] == 0)
+                {
+                    continue;
+                }
+
+                std::int64_t lPriority = 0;
+                if (lTime - lCacheTime[lVertex] + 2 * lLive[lVertex] <= pCacheSize)
+                {
+                    lPriority = static_cast<std::int64_t>(lTime - lCacheTime[lVertex]);
+                }
+
+                if (lPriority > lBestPriority)
+                {
+                    lBestPriority = lPriority;
+                    lNext = lVertex;
+                }
+            }
+
+            const std::size_t lEmittedCount = lOutput.size() / 3;
+            if (lNext < 0)
+            {
+                // A dead end: back up to a recent vertex with triangles left,
+                // or failing that, the next one in input order.
+                while (lDeadEnds.empty() == false && lNext < 0)
+                {
+                    const std::uint32_t lVertex = lDeadEnds.back();
+                    lDeadEnds.pop_back();
+                    if (lLive[lVertex] > 0)
+                    {
+                        lNext = lVertex;
+                    }
+                }
+
+                while (lNext < 0 && lCursor < pIndices.size())
+                {
+                    if (lLive[pIndices[lCursor]] > 0)
+                    {
+                        lNext = pIndices[lCursor];
+                    }
+
+                    ++lCursor;
+                }
+
+                if (lNext >= 0 && lEmittedCount > lClusters.back())
+                {
+                    lClusters.push_back(static_cast<std::uint32_t>(lEmittedCount));
+                }
+            }
+            else if (lEmittedCount - lClusters.back() >= MAX_CLUSTER_TRIANGLES)
+            {
+                lClusters.push_back(static_cast<std::uint32_t>(lEmittedCount));
+            }
+
+            lFanning = lNext;
+        }
+
+        pIndices = std::move(lOutput);
+        return lClusters;
+    }
+
+    void MeshCooker::OptimizeOverdraw (
+        std::vector<std::uint32_t>&         pIndices,
+        std::span<const MeshVertex>         pVertices,
+        std::span<const std::uint32_t>      pClusters
+    )
+    {
+        if (pClusters.size() < 2)
+        {
+            return;
+        }
+
+        const std::size_t lTriangleCount = pIndices.size() / 3;
+        auto lTriangle =
+            [&] (const std::size_t pTriangle, Vector3f& pCentroid)
+            {
+                const Vector3f& lFirst = pVertices[pIndices[pTriangle * 3]].mPosition;
+                const Vector3f& lSecond = pVertices[pIndices[pTriangle * 3 + 1]].mPosition;
+                const Vector3f& lThird = pVertices[pIndices[pTriangle * 3 + 2]].mPosition;
+                pCentroid = (lFirst + lSecond + lThird) / 3.0f;
+                return TriangleNormal(lFirst, lSecond, lThird);
+            };
+
+        // Weight each triangle by its area, which is half its normal's
+        // length, so that slivers do not skew the centroids.
+        Vector3f lMeshCentroid = Vector3f::Zero();
+        float lMeshArea = 0.0f;
+        for (std::size_t t = 0; t < lTriangleCount; ++t)
+        {
+            Vector3f lCentroid;
+            const float lArea = lTriangle(t, lCentroid).Length();
+            lMeshCentroid += lCentroid * lArea;
+            lMeshArea += lArea;
+        }
+
+        lMeshCentroid = (lMeshArea > 0.0f) ? lMeshCentroid / lMeshArea : Vector3f::Zero();
+
+        // A cluster which faces away from the mesh's centre sits on its
+        // outside, and so tends to occlude the others; draw those first.
+        struct Cluster { std::size_t mBegin; std::size_t mEnd; float mPotential; };
+        std::vector<Cluster> lClusters;
+        for (std::size_t c = 0; c < pClusters.size(); ++c)
+        {
+            Cluster lCluster { pClusters[c], (c + 1 < pClusters.size()) ? pClusters[c + 1] : lTriangleCount, 0.0f };
+            Vector3f lCentroid = Vector3f::Zero();
+            Vector3f lNormal = Vector3f::Zero();
+            float lArea = 0.0f;
+            for (std::size_t t = lCluster.mBegin; t < lCluster.mEnd; ++t)
+            {
+                Vector3f lTriangleCentroid;
+                const Vector3f lTriangleNormal = lTriangle(t, lTriangleCentroid);
+                const float lTriangleArea = lTriangleNormal.Length();
+                lCentroid += lTriangleCentroid * lTriangleArea;
+                lNormal += lTriangleNormal;
+                lArea += lTriangleArea;
+            }
+
+            if (lArea > 0.0f && lNormal.Length() > 0.0f)
+            {
+                lCluster.mPotential = (lCentroid / lArea - lMeshCentroid).Dot(lNormal.Normalized());
+            }
+
+            lClusters.push_back(lCluster);
+        }
+
+        std::stable_sort(lClusters.begin(), lClusters.end(),
+            [] (const Cluster& pLeft, const Cluster& pRight)
+            {
+                return pLeft.mPotential > pRight.mPotential;
+            });
+
+        std::vector<std::uint32_t> lOutput;
+        lOutput.reserve(pIndices.size());
+        for (const Cluster& lCluster : lClusters)
+        {
+            lOutput.insert(lOutput.end(), pIndices.begin() + lCluster.mBegin * 3, pIndices.begin() + lCluster.mEnd * 3);
+        }
+
+        pIndices = std::move(lOutput);
+    }
+
+    void MeshCooker::OptimizeVertexFetch (
+        std::vector<MeshVertex>&        pVertices,
+        std::vector<std::uint32_t>&     pIndices
+    )
+    {
+        std::vector<std::uint32_t> lRemap(pVertices.size(), NO_VERTEX);
+        std::vector<MeshVertex> lOrdered;
+        lOrdered.reserve(pVertices.size());
+        for (std::uint32_t& lIndex : pIndices)
+        {
+            if (lRemap[lIndex] == NO_VERTEX)
+            {
+                lRemap[lIndex] = static_cast<std::uint32_t>(lOrdered.size());
+                lOrdered.push_back(pVertices[lIndex]);
+            }
+
+            lIndex = lRemap[lIndex];
+        }
+
+        pVertices = std::move(lOrdered);
+    }
+
+    std::vector<std::uint32_t> MeshCooker::Simplify (
+        std::span<const MeshVertex>     pVertices,
+        std::span<const std::uint32_t>  pIndices,
+        const std::size_t               pTargetIndexCount,
+        const float                     pTargetError,
+        float&                          pResultError
+    )
+    {
+        pResultError = 0.0f;
+        const std::size_t lVertexCount = pVertices.size();
+
+        // Weld vertices by position. Each position is represented by the
+        // first vertex found there, and the vertices at each position, its
+        // wedges, are linked in a ring.
+        std::vector<std::uint32_t> lPositionOf(lVertexCount);
+        std::vector<std::uint32_t> lNextWedge(lVertexCount);
+        {
+            std::size_t lTableSize = 16;
+            while (lTableSize < lVertexCount * 2)
+            {
+                lTableSize *= 2;
+            }
+
+            std::vector<std::uint32_t> lTable(lTableSize, NO_VERTEX);
+            for (std::uint32_t v = 0; v < lVertexCount; ++v)
+            {
+                const Vector3f& lPosition = pVertices[v].mPosition;
+                std::size_t lSlot = HashPosition(lPosition) & (lTableSize - 1);
+                while (
+                    lTable[lSlot] != NO_VERTEX &&
+                    std::memcmp(&pVertices[lTable[lSlot]].mPosition, &lPosition, sizeof(Vector3f)) != 0
+                )
+                {
+                    lSlot = (lSlot + 1) & (lTableSize - 1);
+                }
+
+                if (lTable[lSlot] == NO_VERTEX)
+                {
+                    lTable[lSlot] = v;
+                    lPositionOf[v] = v;
+                    lNextWedge[v] = v;
+                }
+                else
+                {
+                    const std::uint32_t lFirst = lTable[lSlot];
+                    lPositionOf[v] = lFirst;
+                    lNextWedge[v] = lNextWedge[lFirst];
+                    lNextWedge[lFirst] = v;
+                }
+            }
+        }
+
+        // Drop triangles which are already degenerate.
+        std::vector<std::uint32_t> lIndices;
+        lIndices.reserve(pIndices.size());
+        for (std::size_t t = 0; t + 2 < pIndices.size(); t += 3)
+        {
+            const std::uint32_t lA = lPositionOf[pIndices[t]];
+            const std::uint32_t lB = lPositionOf[pIndices[t + 1]];
+            const std::uint32_t lC = lPositionOf[pIndices[t + 2]];
+            if (lA != lB && lB != lC && lC != lA)
+            {
+                lIndices.insert(lIndices.end(), { pIndices[t], pIndices[t + 1], pIndices[t + 2] });
+            }
+        }
+
+        // Each position gathers the planes of the triangles about it,
+        // weighted by their area.
+        std::vector<Quadric> lQuadrics(lVertexCount);
+        std::vector<std::pair<std::uint64_t, std::uint32_t>> lEdgeUses;
+        lEdgeUses.reserve(lIndices.size());
+        for (std::size_t t = 0; t < lIndices.size(); t += 3)
+        {
+            const std::uint32_t lCorners[3] = { lPositionOf[lIndices[t]], lPositionOf[lIndices[t + 1]], lPositionOf[lIndices[t + 2]] };
+            const Vector3f lNormal = TriangleNormal(pVertices[lCorners[0]].mPosition, pVertices[lCorners[1]].mPosition, pVertices[lCorners[2]].mPosition);
+            const float lLength = lNormal.Length();
+            if (lLength > 0.0f)
+            {
+                const Quadric lQuadric = PlaneQuadric(lNormal / lLength, pVertices[lCorners[0]].mPosition, lLength * 0.5);
+                for (const std::uint32_t lCorner : lCorners)
+                {
+                    AddQuadric(lQuadrics[lCorner], lQuadric);
+                }
+            }
+
+            for (std::size_t e = 0; e < 3; ++e)
+            {
+                const std::uint32_t lA = lCorners[e];
+                const std::uint32_t lB = lCorners[(e + 1) % 3];
+                lEdgeUses.emplace_back((std::uint64_t { std::min(lA, lB) } << 32) | std::max(lA, lB), static_cast<std::uint32_t>(t / 3));
+            }
+        }
+
+        // An edge which only one triangle uses lies on an open border. Hold
+        // it in place with a plane through it, at right angles to its face.
+        std::sort(lEdgeUses.begin(), lEdgeUses.end());
+        for (std::size_t i = 0; i < lEdgeUses.size(); ++i)
+        {
+            if (
+                (i > 0 && lEdgeUses[i - 1].first == lEdgeUses[i].first) ||
+                (i + 1 < lEdgeUses.size() && lEdgeUses[i + 1].first == lEdgeUses[i].first)
+            )
+            {
+                continue;
+            }
+
+            const std::size_t lTriangle = lEdgeUses[i].second * std::size_t { 3 };
+            const auto lFrom = static_cast<std::uint32_t>(lEdgeUses[i].first >> 32);
+            const auto lTo = static_cast<std::uint32_t>(lEdgeUses[i].first);
+            const Vector3f lNormal = TriangleNormal(
+                pVertices[lIndices[lTriangle]].mPosition,
+                pVertices[lIndices[lTriangle + 1]].mPosition,
+                pVertices[lIndices[lTriangle + 2]].mPosition);
+            const Vector3f lEdge = pVertices[lTo].mPosition - pVertices[lFrom].mPosition;
+            const Vector3f lBorderNormal = lEdge.Cross(lNormal);
+            const float lLength = lBorderNormal.Length();
+            if (lLength > 0.0f)
+            {
+                const Quadric lQuadric = PlaneQuadric(lBorderNormal / lLength, pVertices[lFrom].mPosition,
+                    lEdge.Dot(lEdge) * BORDER_WEIGHT);
+                AddQuadric(lQuadrics[lFrom], lQuadric);
+                AddQuadric(lQuadrics[lTo], lQuadric);
+            }
+        }
+
+        // A position with several wedges lies on a seam, and may only slide
+        // along it, onto another position on a seam.
+        std::vector<bool> lOnSeam(lVertexCount, false);
+        for (std::uint32_t v = 0; v < lVertexCount; ++v)
+        {
+            lOnSeam[v] = lNextWedge[v] != v;
+        }
+
+        // A collapsing wedge moves onto the target position's wedge whose
+        // attributes are nearest its own.
+        auto lNearestWedge =
+            [&] (const std::uint32_t pVertex, const std::uint32_t pTarget)
+            {
+                std::uint32_t lNearest = pTarget;
+                float lNearestDistance = std::numeric_limits<float>::max();
+                std::uint32_t lWedge = pTarget;
+                do
+                {
+                    const Vector3f lNormalDelta = pVertices[lWedge].mNormal - pVertices[pVertex].mNormal;
+                    const Vector2f lTexCoordDelta = pVertices[lWedge].mTexCoord - pVertices[pVertex].mTexCoord;
+                    const float lDistance = lNormalDelta.Dot(lNormalDelta) + lTexCoordDelta.Dot(lTexCoordDelta);
+                    if (lDistance < lNearestDistance)
+                    {
+                        lNearest = lWedge;
+                        lNearestDistance = lDistance;
+                    }
+
+                    lWedge = lNextWedge[lWedge];
+                }
+                while (lWedge != pTarget);
+
+                return lNearest;
+            };
+
+        struct Collapse { std::uint32_t mFrom; std::uint32_t mTo; float mError; };
+        std::vector<Collapse> lCandidates;
+        std::vector<std::uint64_t> lOrder;
+        std::vector<std::uint32_t> lLastSeen(lVertexCount);
+        std::vector<std::uint32_t> lTriangleStart(lVertexCount + 1);
+        std::vector<std::uint32_t> lTriangles;
+        std::vector<std::uint32_t> lCollapseTo(lVertexCount, NO_VERTEX);
+        std::vector<bool> lLocked(lVertexCount);
+
+        while (lIndices.size() > pTargetIndexCount)
+        {
+            // List the triangles about each position.
+            std::fill(lTriangleStart.begin(), lTriangleStart.end(), 0);
+            for (const std::uint32_t lIndex : lIndices)
+            {
+                ++lTriangleStart[lPositionOf[lIndex] + 1];
+            }
+
+            std::partial_sum(lTriangleStart.begin(), lTriangleStart.end(), lTriangleStart.begin());
+            lTriangles.resize(lIndices.size());
+            {
+                std::vector<std::uint32_t> lCursor { lTriangleStart.begin(), lTriangleStart.end() - 1 };
+                for (std::size_t i = 0; i < lIndices.size(); ++i)
+                {
+                    lTriangles[lCursor[lPositionOf[lIndices[i]]]++] = static_cast<std::uint32_t>(i / 3);
+                }
+            }
+
+            // Cost every edge, once from its lesser end, in whichever
+            // direction is cheaper. Sort them by error, which is never
+            // negative, and so sorts as its bits do.
+            lCandidates.clear();
+            lOrder.clear();
+            std::fill(lLastSeen.begin(), lLastSeen.end(), NO_VERTEX);
+            for (std::uint32_t lA = 0; lA < lVertexCount; ++lA)
+            {
+                for (std::uint32_t i = lTriangleStart[lA]; i < lTriangleStart[lA + 1]; ++i)
+                {
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        const std::uint32_t lB = lPositionOf[lIndices[lTriangles[i] * std::size_t { 3 } + c]];
+                        if (lB <= lA || lLastSeen[lB] == lA)
+                        {
+                            continue;
+                        }
+
+                        lLastSeen[lB] = lA;
+                        Quadric lQuadric = lQuadrics[lA];
+                        AddQuadric(lQuadric, lQuadrics[lB]);
+
+                        const bool lAToB = lOnSeam[lA] == false || lOnSeam[lB] == true;
+                        const bool lBToA = lOnSeam[lB] == false || lOnSeam[lA] == true;
+                        const float lAToBError = (lAToB == true) ? QuadricError(lQuadric, pVertices[lB].mPosition) : std::numeric_limits<float>::max();
+                        const float lBToAError = (lBToA == true) ? QuadricError(lQuadric, pVertices[lA].mPosition) : std::numeric_limits<float>::max();
+                        if (lAToBError <= pTargetError || lBToAError <= pTargetError)
+                        {
+                            const Collapse lCollapse = (lAToBError <= lBToAError) ?
+                                Collapse { lA, lB, lAToBError } : Collapse { lB, lA, lBToAError };
+                            lOrder.push_back((std::uint64_t { std::bit_cast<std::uint32_t>(lCollapse.mError) } << 32) | lCandidates.size());
+                            lCandidates.push_back(lCollapse);
+                        }
+                    }
+                }
+            }
+
+            std::sort(lOrder.begin(), lOrder.end());
+
+            // Take the cheapest collapses which touch no triangle already
+            // changed in this pass, until enough triangles are gone.
+            std::fill(lLocked.begin(), lLocked.end(), false);
+            const std::size_t lWanted = (lIndices.size() - pTargetIndexCount + 2) / 3;
+            std::size_t lRemoved = 0;
+            std::size_t lCollapses = 0;
+            for (const std::uint64_t lCandidate : lOrder)
+            {
+                const Collapse& lCollapse = lCandidates[static_cast<std::uint32_t>(lCandidate)];
+                if (lLocked[lCollapse.mFrom] == true || lLocked[lCollapse.mTo] == true)
+                {
+                    continue;
+                }
+
+                // Refuse to flip any triangle which survives the collapse.
+                bool lFlips = false;
+                std::size_t lShared = 0;
+                for (std::uint32_t i = lTriangleStart[lCollapse.mFrom]; i < lTriangleStart[lCollapse.mFrom + 1] && lFlips == false; ++i)
+                {
+                    const std::size_t lTriangle = lTriangles[i] * std::size_t { 3 };
+                    Vector3f lBefore[3];
+                    Vector3f lAfter[3];
+                    bool lHasTarget = false;
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        const std::uint32_t lCorner = lPositionOf[lIndices[lTriangle + c]];
+                        lHasTarget = lHasTarget || lCorner == lCollapse.mTo;
+                        lBefore[c] = pVertices[lCorner].mPosition;
+                        lAfter[c] = (lCorner == lCollapse.mFrom) ? pVertices[lCollapse.mTo].mPosition : lBefore[c];
+                    }
+
+                    if (lHasTarget == true)
+                    {
+                        ++lShared;
+                        continue;
+                    }
+
+                    lFlips = TriangleNormal(lBefore[0], lBefore[1], lBefore[2])
+                        .Dot(TriangleNormal(lAfter[0], lAfter[1], lAfter[2])) <= 0.0f;
+                }
+
+                if (lFlips == true)
+                {
+                    continue;
+                }
+
+                lCollapseTo[lCollapse.mFrom] = lCollapse.mTo;
+                lLocked[lCollapse.mTo] = true;
+                for (std::uint32_t i = lTriangleStart[lCollapse.mFrom]; i < lTriangleStart[lCollapse.mFrom + 1]; ++i)
+                {
+                    for (std::size_t c = 0; c < 3; ++c)
+                    {
+                        lLocked[lPositionOf[lIndices[lTriangles[i] * std::size_t { 3 } + c]]] = true;
+                    }
+                }
+
+                AddQuadric(lQuadrics[lCollapse.mTo], lQuadrics[lCollapse.mFrom]);
+                pResultError = std::max(pResultError, lCollapse.mError);
+                ++lCollapses;
+                lRemoved += lShared;
+                if (lRemoved >= lWanted)
+                {
+                    break;
+                }
+            }
+
+            if (lCollapses == 0)
+            {
+                break;
+            }
+
+            // Move the collapsed wedges, and drop the triangles which
+            // collapsed with them.
+            std::size_t lKept = 0;
+            for (std::size_t t = 0; t < lIndices.size(); t += 3)
+            {
+                std::uint32_t lCorners[3];
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    lCorners[c] = lIndices[t + c];
+                    const std::uint32_t lTarget = lCollapseTo[lPositionOf[lCorners[c]]];
+                    if (lTarget != NO_VERTEX)
+                    {
+                        lCorners[c] = lNearestWedge(lCorners[c], lTarget);
+                    }
+                }
+
+                const std::uint32_t lA = lPositionOf[lCorners[0]];
+                const std::uint32_t lB = lPositionOf[lCorners[1]];
+                const std::uint32_t lC = lPositionOf[lCorners[2]];
+                if (lA != lB && lB != lC && lC != lA)
+                {
+                    lIndices[lKept++] = lCorners[0];
+                    lIndices[lKept++] = lCorners[1];
+                    lIndices[lKept++] = lCorners[2];
+                }
+            }
+
+            lIndices.resize(lKept);
+            for (const Collapse& lCollapse : lCandidates)
+            {
+                lCollapseTo[lCollapse.mFrom] = NO_VERTEX;
+            }
+        }
+
+        return lIndices;
+    }
+
+    float MeshCooker::ComputeCacheMissRatio (
+        std::span<const std::uint32_t>  pIndices,
+        const std::size_t               pVertexCount,
+        const std::size_t               pCacheSize
+    )
+    {
+        if (pIndices.size() < 3)
+        {
+            return 0.0f;
+        }
+
+        // A vertex is still cached if fewer than the cache's size of misses
+        // have happened since it was itself a miss.
+        std::vector<std::size_t> lInserted(pVertexCount, 0);
+        std::size_t lMisses = 0;
+        for (const std::uint32_t lIndex : pIndices)
+        {
+            if (lInserted[lIndex] == 0 || lMisses - lInserted[lIndex] >= pCacheSize)
+            {
+                lInserted[lIndex] = ++lMisses;
+            }
+        }
+
+        return static_cast<float>(lMisses) / static_cast<float>(pIndices.size() / 3);
+    }
+
+    astd::byte_buffer MeshCooker::Cook (
+        std::span<const MeshVertex>     pVertices,
+        std::span<const std::uint32_t>  pIndices,
+        const MeshCookSpec&             pSpec
+    )
+    {
+        if (pIndices.size() % 3 != 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: {} indices do not make whole triangles!",
+                "MeshCooker", pIndices.size());
+        }
+        else if (
+            pSpec.mMaxMeshletVertices < 3 || pSpec.mMaxMeshletVertices > 256 ||
+            pSpec.mMaxMeshletTriangles < 1 || pSpec.mMaxMeshletTriangles > std::numeric_limits<std::uint16_t>::max()
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Meshlets of {} vertices and {} triangles are not supported!",
+                "MeshCooker", pSpec.mMaxMeshletVertices, pSpec.mMaxMeshletTriangles);
+        }
+        else if (
+            pSpec.mLodCount < 1 || pSpec.mLodCount > Mesh::MAX_LODS ||
+            (pSpec.mLodReduction > 0.0f && pSpec.mLodReduction < 1.0f) == false ||
+            (pSpec.mLodMaxError >= 0.0f) == false
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: {} levels of detail, each keeping {} of the last, are not supported!",
+                "MeshCooker", pSpec.mLodCount, pSpec.mLodReduction);
+        }
+
+        std::vector<std::uint32_t> lIndices { pIndices.begin(), pIndices.end() };
+        for (const std::uint32_t lIndex : lIndices)
+        {
+            if (lIndex >= pVertices.size())
+            {
+                ACE_THROW(std::invalid_argument, "{}: Index {} is out of range!",
+                    "MeshCooker", lIndex);
+            }
+        }
+
+        std::vector<MeshVertex> lVertices = Deduplicate(pVertices, lIndices);
+
+        // Simplify each level from the one before, so that their errors add
+        // up.
+        auto lExtent = AABB3f::Empty();
+        for (const MeshVertex& lVertex : lVertices)
+        {
+            lExtent.Merge(lVertex.mPosition);
+        }
+
+        const float lMaxError = (lVertices.empty() == true) ? 0.0f :
+            pSpec.mLodMaxError * (lExtent.mMax - lExtent.mMin).Length();
+        std::vector<std::vector<std::uint32_t>> lLevels;
+        std::vector<float> lErrors { 0.0f };
+        lLevels.push_back(std::move(lIndices));
+        while (lLevels.size() < pSpec.mLodCount)
+        {
+            const std::vector<std::uint32_t>& lPrevious = lLevels.back();
+            const std::size_t lTarget = static_cast<std::size_t>(static_cast<float>(lPrevious.size() / 3) * pSpec.mLodReduction) * 3;
+
+            float lError = 0.0f;
+            std::vector<std::uint32_t> lLevel = Simplify(lVertices, lPrevious, lTarget, lMaxError - lErrors.back(), lError);
+
+            // A level which falls short of halfway to its target is not
+            // worth its memory; nor would any coarser one be.
+            if (lLevel.empty() == true || lLevel.size() > (lPrevious.size() + lTarget) / 2)
+            {
+                break;
+            }
+
+            lErrors.push_back(lErrors.back() + lError);
+            lLevels.push_back(std::move(lLevel));
+        }
+
+        for (std::vector<std::uint32_t>& lLevel : lLevels)
+        {
+            const std::vector<std::uint32_t> lClusters = OptimizeVertexCache(lLevel, lVertices.size(), pSpec.mCacheSize);
+            if (pSpec.mOptimizeOverdraw == true)
+            {
+                OptimizeOverdraw(lLevel, lVertices, lClusters);
+            }
+        }
+
+        // Lay the levels out coarsest first, and order the vertices by their
+        // first use there, so that each level needs only a prefix of every
+        // array.
+        std::vector<MeshLod> lLods(lLevels.size());
+        lIndices.clear();
+        for (std::size_t i = lLevels.size(); i-- > 0; )
+        {
+            lLods[i].mIndexOffset = static_cast<std::uint32_t>(lIndices.size());
+            lLods[i].mIndexCount = static_cast<std::uint32_t>(lLevels[i].size());
+            lLods[i].mError = lErrors[i];
+            lIndices.insert(lIndices.end(), lLevels[i].begin(), lLevels[i].end());
+        }
+
+        OptimizeVertexFetch(lVertices, lIndices);
+
+        std::vector<Meshlet> lMeshlets;
+        std::vector<std::uint32_t> lMeshletVertices;
+        std::vector<std::uint8_t> lMeshletTriangles;
+        std::uint32_t lUsedVertices = 0;
+        for (std::size_t i = lLods.size(); i-- > 0; )
+        {
+            const auto lLevel = std::span<const std::uint32_t> { lIndices }.subspan(lLods[i].mIndexOffset, lLods[i].mIndexCount);
+            for (const std::uint32_t lIndex : lLevel)
+            {
+                lUsedVertices = std::max(lUsedVertices, lIndex + 1);
+            }
+
+            lLods[i].mVertexCount = lUsedVertices;
+            lLods[i].mMeshletOffset = static_cast<std::uint32_t>(lMeshlets.size());
+            BuildMeshlets(lVertices, lLevel, pSpec, lMeshlets, lMeshletVertices, lMeshletTriangles);
+            lLods[i].mMeshletCount = static_cast<std::uint32_t>(lMeshlets.size()) - lLods[i].mMeshletOffset;
+        }
+
+        // Quantize positions and texture coordinates within their bounds.
+        MeshBlobHeader lHeader;
+        auto lBounds = AABB3f::Empty();
+        Vector2f lTexCoordMin { std::numeric_limits<float>::max(), std::numeric_limits<float>::max() };
+        Vector2f lTexCoordMax { std::numeric_limits<float>::lowest(), std::numeric_limits<float>::lowest() };
+        for (const MeshVertex& lVertex : lVertices)
+        {
+            lBounds.Merge(lVertex.mPosition);
+            lTexCoordMin = { std::min(lTexCoordMin.mX, lVertex.mTexCoord.mX), std::min(lTexCoordMin.mY, lVertex.mTexCoord.mY) };
+            lTexCoordMax = { std::max(lTexCoordMax.mX, lVertex.mTexCoord.mX), std::max(lTexCoordMax.mY, lVertex.mTexCoord.mY) };
+        }
+
+        if (lVertices.empty() == true)
+        {
+            lBounds = {};
+            lTexCoordMin = lTexCoordMax = Vector2f::Zero();
+        }
+
+        std::vector<PackedVertex> lPacked(lVertices.size());
+        for (std::size_t i = 0; i < lVertices.size(); ++i)
+        {
+            const MeshVertex& lVertex = lVertices[i];
+            lPacked[i].mPosition[0] = QuantizeUnit(lVertex.mPosition.mX, lBounds.mMin.mX, lBounds.mMax.mX);
+            lPacked[i].mPosition[1] = QuantizeUnit(lVertex.mPosition.mY, lBounds.mMin.mY, lBounds.mMax.mY);
+            lPacked[i].mPosition[2] = QuantizeUnit(lVertex.mPosition.mZ, lBounds.mMin.mZ, lBounds.mMax.mZ);
+            EncodeOctahedral(lVertex.mNormal, lPacked[i].mNormal);
+            lPacked[i].mTexCoord[0] = QuantizeUnit(lVertex.mTexCoord.mX, lTexCoordMin.mX, lTexCoordMax.mX);
+            lPacked[i].mTexCoord[1] = QuantizeUnit(lVertex.mTexCoord.mY, lTexCoordMin.mY, lTexCoordMax.mY);
+        }
+
+        lHeader.mVersion = Mesh::COOKED_VERSION;
+        lHeader.mFlags = (lVertices.size() > 65536) ? 1 : 0;
+        lHeader.mBoundsMin[0] = lBounds.mMin.mX;
+        lHeader.mBoundsMin[1] = lBounds.mMin.mY;
+        lHeader.mBoundsMin[2] = lBounds.mMin.mZ;
+        lHeader.mBoundsMax[0] = lBounds.mMax.mX;
+        lHeader.mBoundsMax[1] = lBounds.mMax.mY;
+        lHeader.mBoundsMax[2] = lBounds.mMax.mZ;
+        lHeader.mTexCoordMin[0] = lTexCoordMin.mX;
+        lHeader.mTexCoordMin[1] = lTexCoordMin.mY;
+        lHeader.mTexCoordMax[0] = lTexCoordMax.mX;
+        lHeader.mTexCoordMax[1] = lTexCoordMax.mY;
+
+        if ((lHeader.mFlags & 1) != 0)
+        {
+            return WriteBlob(lHeader, lLods, lPacked, { reinterpret_cast<const std::uint8_t*>(lIndices.data()), lIndices.size() * 4 },
+                lMeshlets, lMeshletVertices, lMeshletTriangles);
+        }
+
+        const std::vector<std::uint16_t> lNarrow { lIndices.begin(), lIndices.end() };
+        return WriteBlob(lHeader, lLods, lPacked, { reinterpret_cast<const std::uint8_t*>(lNarrow.data()), lNarrow.size() * 2 },
+            lMeshlets, lMeshletVertices, lMeshletTriangles);
+    }
+
+    astd::byte_buffer MeshCooker::ExtractLod (
+        const Mesh&         pMesh,
+        const std::size_t   pLevel
+    )
+    {
+        if (pMesh.HasLod(pLevel) == false)
+        {
+            ACE_THROW(std::invalid_argument, "{}: The mesh does not hold level of detail {}!",
+                "MeshCooker", pLevel);
+        }
+
+        MeshBlobHeader lHeader;
+        std::memcpy(&lHeader, pMesh.GetBlob().data(), sizeof(lHeader));
+
+        // Keep every array up to the end of the level's stretch of it; finer
+        // levels keep only their errors.
+        std::vector<MeshLod> lLods { pMesh.GetLods().begin(), pMesh.GetLods().end() };
+        const MeshLod lKept = lLods[pLevel];
+        for (std::size_t i = 0; i < pLevel; ++i)
+        {
+            lLods[i] = { .mError = lLods[i].mError };
+        }
+
+        const std::span<const Meshlet> lMeshlets = pMesh.GetMeshlets().first(lKept.mMeshletOffset + lKept.mMeshletCount);
+        std::size_t lMeshletVertexCount = 0;
+        std::size_t lMeshletTriangleCount = 0;
+        for (const Meshlet& lMeshlet : lMeshlets)
+        {
+            lMeshletVertexCount = std::max(lMeshletVertexCount, std::size_t { lMeshlet.mVertexOffset } + lMeshlet.mVertexCount);
+            lMeshletTriangleCount = std::max(lMeshletTriangleCount, std::size_t { lMeshlet.mTriangleOffset } + lMeshlet.mTriangleCount * 3u);
+        }
+
+        const std::size_t lIndexWidth = (pMesh.HasWideIndices() == true) ? 4 : 2;
+        return WriteBlob(
+            lHeader,
+            lLods,
+            pMesh.GetVertices().first(lKept.mVertexCount),
+            pMesh.GetIndexData().first((lKept.mIndexOffset + std::size_t { lKept.mIndexCount }) * lIndexWidth),
+            lMeshlets,
+            pMesh.GetMeshletVertices().first(lMeshletVertexCount),
+            pMesh.GetMeshletTriangles().first(lMeshletTriangleCount)
+        );
+    }
+
+}
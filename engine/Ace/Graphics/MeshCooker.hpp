@@ -0,0 +1,209 @@
+/**
+ * @file    Ace/Graphics/MeshCooker.hpp
+ * @brief   Provides a static class which optimizes and simplifies meshes
+ *          for drawing, and writes them out as blobs which can be used in
+ *          place.
+ */
+
+#pragma once
+#include <Ace/Graphics/Mesh.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing the settings meshes are cooked with.
+     */
+    struct MeshCookSpec
+    {
+        std::size_t     mCacheSize = 16;                ///< @brief The number of entries in the post-transform vertex cache to optimize for.
+        bool            mOptimizeOverdraw = true;       ///< @brief Reorder clusters of triangles so that those likely to occlude are drawn first?
+        std::size_t     mMaxMeshletVertices = 64;       ///< @brief The most vertices one meshlet may use; at most 256.
+        std::size_t     mMaxMeshletTriangles = 124;     ///< @brief The most triangles one meshlet may hold.
+        std::size_t     mLodCount = 1;                  ///< @brief The most levels of detail to generate, counting the full-detail mesh; at most @a `Mesh::MAX_LODS`.
+        float           mLodReduction = 0.5f;           ///< @brief The fraction of the previous level's triangles each level aims to keep.
+        float           mLodMaxError = 0.02f;           ///< @brief The furthest any level may stray from the full-detail mesh, as a fraction of the length of its bounds' diagonal.
+    };
+
+    /**
+     * @brief   A static class which cooks meshes: deduplicating their
+     *          vertices, simplifying them into levels of detail, reordering
+     *          them for the GPU, splitting them into meshlets, quantizing
+     *          them, and writing the result as a blob.
+     *
+     * Each step is exposed alone, for tools; @a `Cook` runs them all.
+     */
+    class ACE_API MeshCooker final
+    {
+    public:
+
+        /**
+         * @brief   Merges vertices which are bitwise identical, using a hash
+         *          table, and rewrites the indices to match.
+         *
+         * @param   pVertices   The vertices.
+         * @param   pIndices    The indices into them, three per triangle;
+         *                      rewritten in place.
+         *
+         * @return  The unique vertices, in order of first use.
+         */
+        static std::vector<MeshVertex> Deduplicate (
+            std::span<const MeshVertex>     pVertices,
+            std::vector<std::uint32_t>&     pIndices
+        );
+
+        /**
+         * @brief   Reorders triangles for post-transform vertex cache
+         *          locality, using Tipsify.
+         *
+         * Tipsify fans around one vertex at a time, then moves on to whichever
+         * recently used vertex still has triangles left and would stay in the
+         * cache; when none would, it jumps to a fresh part of the mesh. Each
+         * jump starts a new cluster of triangles, whose starts are returned
+         * so that clusters can be reordered for overdraw without hurting
+         * cache locality.
+         *
+         * @param   pIndices        The indices, three per triangle; reordered
+         *                          in place.
+         * @param   pVertexCount    The number of vertices.
+         * @param   pCacheSize      The number of cache entries to optimize
+         *                          for.
+         *
+         * @return  The index, in triangles, at which each cluster starts.
+         */
+        static std::vector<std::uint32_t> OptimizeVertexCache (
+            std::vector<std::uint32_t>&     pIndices,
+            const std::size_t               pVertexCount,
+            const std::size_t               pCacheSize
+        );
+
+        /**
+         * @brief   Reorders whole clusters of triangles so that those facing
+         *          away from the mesh's centre, which tend to occlude the rest,
+         *          are drawn first.
+         *
+         * @param   pIndices        The indices; reordered in place.
+         * @param   pVertices       The vertices.
+         * @param   pClusters       The start of each cluster, in triangles.
+         */
+        static void OptimizeOverdraw (
+            std::vector<std::uint32_t>&         pIndices,
+            std::span<const MeshVertex>         pVertices,
+            std::span<const std::uint32_t>      pClusters
+        );
+
+        /**
+         * @brief   Reorders vertices into the order the indices first use
+         *          them, so that vertex fetches walk memory forwards, and drops
+         *          any which are unused.
+         *
+         * @param   pVertices   The vertices; reordered in place.
+         * @param   pIndices    The indices; rewritten to match.
+         */
+        static void OptimizeVertexFetch (
+            std::vector<MeshVertex>&        pVertices,
+            std::vector<std::uint32_t>&     pIndices
+        );
+
+        /**
+         * @brief   Simplifies a mesh by collapsing edges, cheapest first, as
+         *          measured by quadric error metrics.
+         *
+         * Each vertex gathers a quadric which measures the squared distance
+         * to the planes of the triangles about it; open borders add planes
+         * at right angles to their faces, which hold them in place. Edges
+         * are collapsed in passes, each of which sorts the remaining edges by
+         * the error of collapsing them and takes the cheapest which touch
+         * nothing else collapsed in that pass and would flip no triangle.
+         * Vertices only ever collapse onto other vertices, so the result
+         * indexes into the same vertices. Vertices which share a position
+         * but not attributes, along UV seams, move together, and may only
+         * collapse along the seam.
+         *
+         * @param   pVertices           The vertices.
+         * @param   pIndices            The indices, three per triangle.
+         * @param   pTargetIndexCount   The number of indices to aim for.
+         * @param   pTargetError        The furthest, in model space, the
+         *                              result may stray from the mesh.
+         * @param   pResultError        Set to how far the result does stray.
+         *
+         * @return  The simplified indices; no fewer than the target, unless
+         *          the mesh can be simplified no further within the error.
+         */
+        static std::vector<std::uint32_t> Simplify (
+            std::span<const MeshVertex>     pVertices,
+            std::span<const std::uint32_t>  pIndices,
+            const std::size_t               pTargetIndexCount,
+            const float                     pTargetError,
+            float&                          pResultError
+        );
+
+        /**
+         * @brief   Simulates a FIFO post-transform vertex cache over a list
+         *          of indices.
+         *
+         * @param   pIndices        The indices, three per triangle.
+         * @param   pVertexCount    The number of vertices.
+         * @param   pCacheSize      The number of cache entries.
+         *
+         * @return  The average cache miss ratio: the number of vertices
+         *          transformed per triangle, from 0.5 at best to 3 at worst.
+         */
+        static float ComputeCacheMissRatio (
+            std::span<const std::uint32_t>  pIndices,
+            const std::size_t               pVertexCount,
+            const std::size_t               pCacheSize
+        );
+
+        /**
+         * @brief   Runs every step, then quantizes the vertices and writes the
+         *          mesh as a blob for @a `Mesh` to view.
+         *
+         * Each level of detail is simplified from the one before, until the
+         * requested count is reached, the error allowed is used up, or
+         * simplification stops paying off; so the blob may hold fewer levels
+         * than requested. Each level is optimized on its own; the vertices
+         * are then ordered by first use, coarsest level first, so that every
+         * level uses a prefix of them.
+         *
+         * @param   pVertices   The vertices.
+         * @param   pIndices    The indices, three per triangle.
+         * @param   pSpec       The settings to cook with.
+         *
+         * @return  The blob.
+         *
+         * @throw   `std::invalid_argument` if the index count is not a
+         *          multiple of three, an index is out of range, or the
+         *          meshlet or level of detail settings are out of range.
+         */
+        static astd::byte_buffer Cook (
+            std::span<const MeshVertex>     pVertices,
+            std::span<const std::uint32_t>  pIndices,
+            const MeshCookSpec&             pSpec = {}
+        );
+
+        /**
+         * @brief   Writes a blob holding one level of detail of a cooked mesh,
+         *          and every coarser one, for streaming.
+         *
+         * As levels are stored coarsest first, this only truncates each
+         * array. The blob keeps the whole level of detail table, so that a
+         * viewer of it can tell when a finer level is wanted; finer levels
+         * are listed with no data.
+         *
+         * @param   pMesh   The mesh.
+         * @param   pLevel  The finest level to keep.
+         *
+         * @return  The blob.
+         *
+         * @throw   `std::invalid_argument` if the mesh does not hold the
+         *          level.
+         */
+        static astd::byte_buffer ExtractLod (
+            const Mesh&         pMesh,
+            const std::size_t   pLevel
+        );
+
+    };
+
+}
@@ -0,0 +1,280 @@
+/**
+ * @file    Ace/Graphics/MeshLoaders.cpp
+ */
+
+#include <bit>
+#include <charconv>
+#include <Ace/Graphics/MeshLoaders.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Splits the next whitespace-separated token off the front of a
+     *          line.
+     */
+    static std::string_view NextToken (
+        std::string_view&   pLine
+    )
+    {
+        const std::size_t lStart = pLine.find_first_not_of(" \t\r");
+        if (lStart == std::string_view::npos)
+        {
+            pLine = {};
+            return {};
+        }
+
+        const std::size_t lEnd = pLine.find_first_of(" \t\r", lStart);
+        const std::string_view lToken = pLine.substr(lStart, lEnd - lStart);
+        pLine = (lEnd == std::string_view::npos) ? std::string_view {} : pLine.substr(lEnd);
+        return lToken;
+    }
+
+    static float ParseFloat (
+        std::string_view    pToken
+    )
+    {
+        float lValue = 0.0f;
+        std::from_chars(pToken.data(), pToken.data() + pToken.size(), lValue);
+        return lValue;
+    }
+
+    /**
+     * @brief   Resolves a one-based, or negative and relative, `.obj` element
+     *          reference to an index into the elements read so far.
+     *
+     * @return  The index, or `-1` if the reference is empty.
+     */
+    static std::int64_t ResolveReference (
+        std::string_view    pToken,
+        const std::size_t   pCount
+    )
+    {
+        if (pToken.empty() == true)
+        {
+            return -1;
+        }
+
+        std::int64_t lReference = 0;
+        std::from_chars(pToken.data(), pToken.data() + pToken.size(), lReference);
+
+        const std::int64_t lIndex = (lReference < 0) ? static_cast<std::int64_t>(pCount) + lReference : lReference - 1;
+        if (lIndex < 0 || lIndex >= static_cast<std::int64_t>(pCount))
+        {
+            ACE_THROW(std::runtime_error, "{}: Face refers to element {}, of {}!",
+                "ObjMeshLoader", lReference, pCount);
+        }
+
+        return lIndex;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    ObjMeshLoader::ObjMeshLoader (
+        const MeshLoaderSpec&   pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    bool ObjMeshLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".obj");
+    }
+
+    std::shared_ptr<Mesh> ObjMeshLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        std::string lSource(pVirtualFile->GetSize(), '\0');
+        if (
+            lSource.empty() == false &&
+            pVirtualFile->Read(lSource.data(), lSource.size()) != lSource.size()
+        )
+        {
+            return nullptr;
+        }
+
+        // Key the blob on everything which changes it.
+        const std::uint32_t lSettings[7] = {
+            static_cast<std::uint32_t>(mSpec.mCook.mCacheSize),
+            static_cast<std::uint32_t>(mSpec.mCook.mOptimizeOverdraw),
+            static_cast<std::uint32_t>(mSpec.mCook.mMaxMeshletVertices),
+            static_cast<std::uint32_t>(mSpec.mCook.mMaxMeshletTriangles),
+            static_cast<std::uint32_t>(mSpec.mCook.mLodCount),
+            std::bit_cast<std::uint32_t>(mSpec.mCook.mLodReduction),
+            std::bit_cast<std::uint32_t>(mSpec.mCook.mLodMaxError)
+        };
+        const std::uint64_t lHash = ContentHash64(lSource, ContentHash64(
+            std::span<const std::uint8_t> { reinterpret_cast<const std::uint8_t*>(lSettings), sizeof(lSettings) },
+            Mesh::COOKED_VERSION));
+
+        if (mSpec.mCache != nullptr)
+        {
+            if (auto lBlob = mSpec.mCache->Get(CACHE_BUCKET, lHash))
+            {
+                try
+                {
+                    return Mesh::FromBlob(std::move(*lBlob));
+                }
+                catch (const std::exception&)
+                {
+                    // Damaged or stale; fall through and cook again.
+                }
+            }
+        }
+
+        try
+        {
+            std::vector<MeshVertex> lVertices;
+            std::vector<std::uint32_t> lIndices;
+            Parse(lSource, lVertices, lIndices);
+
+            astd::byte_buffer lBlob = MeshCooker::Cook(lVertices, lIndices, mSpec.mCook);
+            mCookCount.fetch_add(1, std::memory_order_relaxed);
+            if (mSpec.mCache != nullptr)
+            {
+                mSpec.mCache->Put(CACHE_BUCKET, lHash, lBlob);
+            }
+
+            return Mesh::FromBlob(std::move(lBlob));
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    void ObjMeshLoader::Parse (
+        std::string_view                pSource,
+        std::vector<MeshVertex>&        pVertices,
+        std::vector<std::uint32_t>&     pIndices
+    )
+    {
+        std::vector<Vector3f> lPositions;
+        std::vector<Vector2f> lTexCoords;
+        std::vector<Vector3f> lNormals;
+        std::vector<MeshVertex> lCorners;
+        std::vector<bool> lHasNormals;
+
+        while (pSource.empty() == false)
+        {
+            const std::size_t lEnd = pSource.find('\n');
+            std::string_view lLine = pSource.substr(0, lEnd);
+            pSource = (lEnd == std::string_view::npos) ? std::string_view {} : pSource.substr(lEnd + 1);
+
+            const std::string_view lKeyword = NextToken(lLine);
+            if (lKeyword == "v")
+            {
+                const float lX = ParseFloat(NextToken(lLine));
+                const float lY = ParseFloat(NextToken(lLine));
+                const float lZ = ParseFloat(NextToken(lLine));
+                lPositions.push_back({ lX, lY, lZ });
+            }
+            else if (lKeyword == "vt")
+            {
+                const float lU = ParseFloat(NextToken(lLine));
+                const float lV = ParseFloat(NextToken(lLine));
+                lTexCoords.push_back({ lU, lV });
+            }
+            else if (lKeyword == "vn")
+            {
+                const float lX = ParseFloat(NextToken(lLine));
+                const float lY = ParseFloat(NextToken(lLine));
+                const float lZ = ParseFloat(NextToken(lLine));
+                lNormals.push_back(Vector3f { lX, lY, lZ }.Normalized());
+            }
+            else if (lKeyword == "f")
+            {
+                // Each corner is `v`, `v/vt`, `v//vn` or `v/vt/vn`.
+                lCorners.clear();
+                lHasNormals.clear();
+                for (std::string_view lToken = NextToken(lLine); lToken.empty() == false; lToken = NextToken(lLine))
+                {
+                    const std::size_t lFirstSlash = lToken.find('/');
+                    const std::size_t lSecondSlash = (lFirstSlash == std::string_view::npos) ?
+                        std::string_view::npos : lToken.find('/', lFirstSlash + 1);
+
+                    const std::int64_t lPosition = ResolveReference(lToken.substr(0, lFirstSlash), lPositions.size());
+                    const std::int64_t lTexCoord = (lFirstSlash == std::string_view::npos) ? -1 :
+                        ResolveReference(lToken.substr(lFirstSlash + 1, lSecondSlash - lFirstSlash - 1), lTexCoords.size());
+                    const std::int64_t lNormal = (lSecondSlash == std::string_view::npos) ? -1 :
+                        ResolveReference(lToken.substr(lSecondSlash + 1), lNormals.size());
+                    if (lPosition < 0)
+                    {
+                        ACE_THROW(std::runtime_error, "{}: Face corner '{}' has no position!",
+                            "ObjMeshLoader", lToken);
+                    }
+
+                    MeshVertex lCorner;
+                    lCorner.mPosition = lPositions[lPosition];
+                    lCorner.mTexCoord = (lTexCoord >= 0) ? lTexCoords[lTexCoord] : Vector2f::Zero();
+                    lCorner.mNormal = (lNormal >= 0) ? lNormals[lNormal] : Vector3f::Zero();
+                    lCorners.push_back(lCorner);
+                    lHasNormals.push_back(lNormal >= 0);
+                }
+
+                if (lCorners.size() < 3)
+                {
+                    continue;
+                }
+
+                // Corners without normals take the face's own.
+                const Vector3f lFaceNormal = (lCorners[1].mPosition - lCorners[0].mPosition)
+                    .Cross(lCorners[2].mPosition - lCorners[0].mPosition).Normalized();
+                const auto lBase = static_cast<std::uint32_t>(pVertices.size());
+                for (std::size_t i = 0; i < lCorners.size(); ++i)
+                {
+                    if (lHasNormals[i] == false)
+                    {
+                        lCorners[i].mNormal = lFaceNormal;
+                    }
+
+                    pVertices.push_back(lCorners[i]);
+                }
+
+                for (std::uint32_t i = 1; i + 1 < lCorners.size(); ++i)
+                {
+                    pIndices.insert(pIndices.end(), { lBase, lBase + i, lBase + i + 1 });
+                }
+            }
+        }
+    }
+
+    bool MeshBlobLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".amesh");
+    }
+
+    std::shared_ptr<Mesh> MeshBlobLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        try
+        {
+            return Mesh::FromFile(std::move(pVirtualFile));
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    Ace/Graphics/MeshLoaders.hpp
+ * @brief   Provides asset loaders which cook @a `Mesh`es from `.obj` files,
+ *          and view cooked `.amesh` blobs in place.
+ */
+
+#pragma once
+#include <Ace/Graphics/MeshCooker.hpp>
+#include <Ace/System/AssetRegistry.hpp>
+#include <Ace/System/DerivedDataCache.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing the settings the mesh loaders cook
+     *          with.
+     */
+    struct MeshLoaderSpec
+    {
+        MeshCookSpec                        mCook;              ///< @brief The settings meshes are cooked with.
+        std::shared_ptr<DerivedDataCache>   mCache = nullptr;   ///< @brief The cache cooked blobs are stored in, or `nullptr` to cook on every load.
+    };
+
+    /**
+     * @brief   An asset loader which parses `.obj` files and cooks them into
+     *          @a `Mesh`es.
+     *
+     * Positions, texture coordinates, normals and polygonal faces are read;
+     * polygons are split into fans of triangles, and faces without normals
+     * take their own. Everything else, such as materials and groups, is
+     * ignored. With a cache, each file's blob is stored under the hash of
+     * its source and cook settings, and later loads of an unchanged file view
+     * the cached blob rather than parsing and cooking again.
+     */
+    class ACE_API ObjMeshLoader final : public IAssetLoader<Mesh>
+    {
+    public:
+
+        /**
+         * @brief   The cache bucket cooked blobs are stored in.
+         */
+        static constexpr std::string_view CACHE_BUCKET = "meshes";
+
+    public:
+
+        /**
+         * @brief   Constructs a loader.
+         *
+         * @param   pSpec   The loader's settings.
+         */
+        explicit ObjMeshLoader (
+            const MeshLoaderSpec&   pSpec = {}
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Mesh> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+        /**
+         * @brief   Parses the source of a `.obj` file into triangles, with one
+         *          vertex per corner, ready for cooking.
+         *
+         * @param   pSource     The file's text.
+         * @param   pVertices   The vertices, appended to.
+         * @param   pIndices    The indices, three per triangle, appended to.
+         *
+         * @throw   `std::runtime_error` if a face refers to an element which
+         *          does not exist.
+         */
+        static void Parse (
+            std::string_view                pSource,
+            std::vector<MeshVertex>&        pVertices,
+            std::vector<std::uint32_t>&     pIndices
+        );
+
+        /**
+         * @brief   Retrieves the number of meshes cooked so far, rather than
+         *          found in the cache.
+         *
+         * @return  The number of meshes cooked.
+         */
+        inline std::size_t GetCookCount () const
+        {
+            return mCookCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        MeshLoaderSpec              mSpec;                  ///< @brief The loader's settings.
+        std::atomic<std::size_t>    mCookCount { 0 };       ///< @brief The number of meshes cooked.
+
+    };
+
+    /**
+     * @brief   An asset loader which views cooked `.amesh` blobs, as written
+     *          by @a `MeshCooker::Cook`, mapping them where the file allows.
+     */
+    class ACE_API MeshBlobLoader final : public IAssetLoader<Mesh>
+    {
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Mesh> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    };
+
+}
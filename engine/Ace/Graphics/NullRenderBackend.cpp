@@ -0,0 +1,31 @@
+/**
+ * @file    Ace/Graphics/NullRenderBackend.cpp
+ */
+
+#include <Ace/Graphics/NullRenderBackend.hpp>
+
+namespace ace
+{
+
+    /* Public Methods *********************************************************/
+
+    void NullRenderBackend::BeginFrame ()
+    {
+        mSortKeys.clear();
+    }
+
+    void NullRenderBackend::Draw (
+        const std::uint64_t&    pSortKey,
+        const DrawCommand&      pCommand
+    )
+    {
+        (void) pCommand;
+        mSortKeys.push_back(pSortKey);
+    }
+
+    void NullRenderBackend::EndFrame ()
+    {
+        ++mFrameCount;
+    }
+
+}
@@ -0,0 +1,63 @@
+/**
+ * @file    Ace/Graphics/NullRenderBackend.hpp
+ * @brief   Provides a render backend which executes nothing, recording the
+ *          draw commands it receives instead.
+ */
+
+#pragma once
+#include <Ace/Graphics/IRenderBackend.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A render backend which executes nothing, recording the sort
+     *          keys of the draw commands it receives instead.
+     *
+     * This backend is useful for measuring the cost of recording and sorting
+     * commands in isolation, and for checking the order in which commands
+     * arrive at a backend.
+     */
+    class ACE_API NullRenderBackend final : public IRenderBackend
+    {
+    public:
+
+        void BeginFrame () override;
+
+        void Draw (
+            const std::uint64_t&    pSortKey,
+            const DrawCommand&      pCommand
+        ) override;
+
+        void EndFrame () override;
+
+    public:
+
+        /**
+         * @brief   Retrieves the sort keys of the draw commands received since
+         *          the last call to @a `BeginFrame`, in the order received.
+         *
+         * @return  The received sort keys.
+         */
+        inline const std::vector<std::uint64_t>& GetSortKeys () const
+        {
+            return mSortKeys;
+        }
+
+        /**
+         * @brief   Retrieves the number of frames which have been ended.
+         *
+         * @return  The number of frames.
+         */
+        inline std::size_t GetFrameCount () const
+        {
+            return mFrameCount;
+        }
+
+    private:
+        std::vector<std::uint64_t>  mSortKeys;          ///< @brief The sort keys received during the current frame.
+        std::size_t                 mFrameCount = 0;    ///< @brief The number of frames which have been ended.
+
+    };
+
+}
@@ -0,0 +1,351 @@
+/**
+ * @file    Ace/Graphics/ParticleSystem.cpp
+ */
+
+#include <Ace/Graphics/ParticleSystem.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Advances an emitter's random number generator, returning a
+     *          number from `-1` up to, but not including, `1`.
+     */
+    static inline float NextSigned (
+        std::uint32_t&  pState
+    )
+    {
+        pState ^= pState << 13;
+        pState ^= pState >> 17;
+        pState ^= pState << 5;
+        return static_cast<float>(pState >> 8) * (2.0f / 16777216.0f) - 1.0f;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    ParticleSystem::ParticleSystem (
+        const ParticleSystemSpec&   pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+        mSpec.mChunkSize = std::max<std::size_t>(mSpec.mChunkSize, 4);
+    }
+
+    /* Public Methods *********************************************************/
+
+    EmitterId ParticleSystem::CreateEmitter (
+        const EmitterDesc&  pDesc
+    )
+    {
+        if (pDesc.mCapacity == 0 || pDesc.mRate < 0.0f || pDesc.mLifetime < 0.0f)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Emitters need a capacity, and a non-negative rate and lifetime!",
+                "ParticleSystem");
+        }
+
+        EmitterId lEmitter = INVALID_EMITTER;
+        if (mFreeEmitters.empty() == false)
+        {
+            lEmitter = mFreeEmitters.back();
+            mFreeEmitters.pop_back();
+        }
+        else
+        {
+            lEmitter = static_cast<EmitterId>(mEmitters.size());
+            mEmitters.emplace_back();
+        }
+
+        // The streams are sized to the emitter's capacity here, once, so that
+        // spawning never allocates.
+        Emitter& lState = mEmitters[lEmitter];
+        lState.mDesc = pDesc;
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            lState.mPosition[c].assign(pDesc.mCapacity, 0.0f);
+            lState.mVelocity[c].assign(pDesc.mCapacity, 0.0f);
+        }
+
+        lState.mLifetime.assign(pDesc.mCapacity, 0.0f);
+        lState.mCount = 0;
+        lState.mSpawnDebt = 0.0f;
+        lState.mRandom = (pDesc.mSeed != 0) ? pDesc.mSeed : 1;
+        lState.mAlive = true;
+        return lEmitter;
+    }
+
+    void ParticleSystem::DestroyEmitter (
+        const EmitterId pEmitter
+    )
+    {
+        if (pEmitter >= mEmitters.size() || mEmitters[pEmitter].mAlive == false)
+        {
+            return;
+        }
+
+        Emitter& lState = mEmitters[pEmitter];
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            lState.mPosition[c] = {};
+            lState.mVelocity[c] = {};
+        }
+
+        lState.mLifetime = {};
+        lState.mCount = 0;
+        lState.mAlive = false;
+        mFreeEmitters.push_back(pEmitter);
+    }
+
+    void ParticleSystem::SetEmitterPosition (
+        const EmitterId pEmitter,
+        const Vector3f& pPosition
+    )
+    {
+        if (pEmitter < mEmitters.size() && mEmitters[pEmitter].mAlive == true)
+        {
+            mEmitters[pEmitter].mDesc.mPosition = pPosition;
+        }
+    }
+
+    void ParticleSystem::SetEmitterRate (
+        const EmitterId pEmitter,
+        const float     pRate
+    )
+    {
+        if (pEmitter < mEmitters.size() && mEmitters[pEmitter].mAlive == true)
+        {
+            mEmitters[pEmitter].mDesc.mRate = std::max(pRate, 0.0f);
+        }
+    }
+
+    std::size_t ParticleSystem::Emit (
+        const EmitterId     pEmitter,
+        const std::size_t   pCount
+    )
+    {
+        if (pEmitter >= mEmitters.size() || mEmitters[pEmitter].mAlive == false)
+        {
+            return 0;
+        }
+
+        return Spawn(mEmitters[pEmitter], pCount);
+    }
+
+    void ParticleSystem::Update (
+        const float pDeltaTime
+    )
+    {
+        // Cut every live emitter's particles into chunks.
+        mChunks.clear();
+        mLiveEmitters.clear();
+        for (std::size_t i = 0; i < mEmitters.size(); ++i)
+        {
+            const Emitter& lEmitter = mEmitters[i];
+            if (lEmitter.mAlive == false)
+            {
+                continue;
+            }
+
+            mLiveEmitters.push_back(static_cast<std::uint32_t>(i));
+            for (std::size_t lBegin = 0; lBegin < lEmitter.mCount; lBegin += mSpec.mChunkSize)
+            {
+                mChunks.push_back({ static_cast<std::uint32_t>(i), lBegin,
+                    std::min(lBegin + mSpec.mChunkSize, lEmitter.mCount) });
+            }
+        }
+
+        // Integrate the chunks.
+        const float lDamping = 1.0f / (1.0f + std::max(mSpec.mDrag, 0.0f) * pDeltaTime);
+        auto lIntegrate =
+            [this, pDeltaTime, lDamping] (const std::size_t pIndex)
+            {
+                IntegrateChunk(mChunks[pIndex], pDeltaTime, lDamping);
+            };
+
+        if (mSpec.mThreadPool != nullptr && mChunks.size() > 1)
+        {
+            mSpec.mThreadPool->ParallelFor(mChunks.size(), lIntegrate);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mChunks.size(); ++i)
+            {
+                lIntegrate(i);
+            }
+        }
+
+        // Then let each emitter clear out its dead and spawn anew.
+        auto lCompact =
+            [this, pDeltaTime] (const std::size_t pIndex)
+            {
+                CompactAndSpawn(mEmitters[mLiveEmitters[pIndex]], pDeltaTime);
+            };
+
+        if (mSpec.mThreadPool != nullptr && mLiveEmitters.size() > 1)
+        {
+            mSpec.mThreadPool->ParallelFor(mLiveEmitters.size(), lCompact);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mLiveEmitters.size(); ++i)
+            {
+                lCompact(i);
+            }
+        }
+    }
+
+    ParticleView ParticleSystem::GetParticles (
+        const EmitterId pEmitter
+    ) const
+    {
+        if (pEmitter >= mEmitters.size() || mEmitters[pEmitter].mAlive == false)
+        {
+            return {};
+        }
+
+        const Emitter& lState = mEmitters[pEmitter];
+        ParticleView lView;
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            lView.mPosition[c] = { lState.mPosition[c].data(), lState.mCount };
+            lView.mVelocity[c] = { lState.mVelocity[c].data(), lState.mCount };
+        }
+
+        lView.mLifetime = { lState.mLifetime.data(), lState.mCount };
+        return lView;
+    }
+
+    std::size_t ParticleSystem::GetParticleCount () const
+    {
+        std::size_t lCount = 0;
+        for (const Emitter& lEmitter : mEmitters)
+        {
+            lCount += lEmitter.mCount;
+        }
+
+        return lCount;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void ParticleSystem::IntegrateChunk (
+        const Chunk&    pChunk,
+        const float     pDeltaTime,
+        const float     pDamping
+    )
+    {
+        Emitter& lEmitter = mEmitters[pChunk.mEmitter];
+        float* lPositionX = lEmitter.mPosition[0].data();
+        float* lPositionY = lEmitter.mPosition[1].data();
+        float* lPositionZ = lEmitter.mPosition[2].data();
+        float* lVelocityX = lEmitter.mVelocity[0].data();
+        float* lVelocityY = lEmitter.mVelocity[1].data();
+        float* lVelocityZ = lEmitter.mVelocity[2].data();
+        float* lLifetime = lEmitter.mLifetime.data();
+
+        const float lGravityX = mSpec.mGravity.mX * pDeltaTime;
+        const float lGravityY = mSpec.mGravity.mY * pDeltaTime;
+        const float lGravityZ = mSpec.mGravity.mZ * pDeltaTime;
+
+        std::size_t i = pChunk.mBegin;
+
+        #if defined(__SSE2__)
+        {
+            const __m128 lDelta = _mm_set1_ps(pDeltaTime);
+            const __m128 lDamping = _mm_set1_ps(pDamping);
+            const __m128 lGX = _mm_set1_ps(lGravityX);
+            const __m128 lGY = _mm_set1_ps(lGravityY);
+            const __m128 lGZ = _mm_set1_ps(lGravityZ);
+            for (; i + 4 <= pChunk.mEnd; i += 4)
+            {
+                const __m128 lVX = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(lVelocityX + i), lGX), lDamping);
+                const __m128 lVY = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(lVelocityY + i), lGY), lDamping);
+                const __m128 lVZ = _mm_mul_ps(_mm_add_ps(_mm_loadu_ps(lVelocityZ + i), lGZ), lDamping);
+                _mm_storeu_ps(lVelocityX + i, lVX);
+                _mm_storeu_ps(lVelocityY + i, lVY);
+                _mm_storeu_ps(lVelocityZ + i, lVZ);
+                _mm_storeu_ps(lPositionX + i, _mm_add_ps(_mm_loadu_ps(lPositionX + i), _mm_mul_ps(lVX, lDelta)));
+                _mm_storeu_ps(lPositionY + i, _mm_add_ps(_mm_loadu_ps(lPositionY + i), _mm_mul_ps(lVY, lDelta)));
+                _mm_storeu_ps(lPositionZ + i, _mm_add_ps(_mm_loadu_ps(lPositionZ + i), _mm_mul_ps(lVZ, lDelta)));
+                _mm_storeu_ps(lLifetime + i, _mm_sub_ps(_mm_loadu_ps(lLifetime + i), lDelta));
+            }
+        }
+        #endif
+
+        for (; i < pChunk.mEnd; ++i)
+        {
+            lVelocityX[i] = (lVelocityX[i] + lGravityX) * pDamping;
+            lVelocityY[i] = (lVelocityY[i] + lGravityY) * pDamping;
+            lVelocityZ[i] = (lVelocityZ[i] + lGravityZ) * pDamping;
+            lPositionX[i] += lVelocityX[i] * pDeltaTime;
+            lPositionY[i] += lVelocityY[i] * pDeltaTime;
+            lPositionZ[i] += lVelocityZ[i] * pDeltaTime;
+            lLifetime[i] -= pDeltaTime;
+        }
+    }
+
+    void ParticleSystem::CompactAndSpawn (
+        Emitter&    pEmitter,
+        const float pDeltaTime
+    )
+    {
+        // Fill each dead particle's slot with the last live particle. The
+        // moved particle is checked in turn, as it may have died too.
+        std::size_t lCount = pEmitter.mCount;
+        for (std::size_t i = 0; i < lCount; )
+        {
+            if (pEmitter.mLifetime[i] > 0.0f)
+            {
+                ++i;
+                continue;
+            }
+
+            --lCount;
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                pEmitter.mPosition[c][i] = pEmitter.mPosition[c][lCount];
+                pEmitter.mVelocity[c][i] = pEmitter.mVelocity[c][lCount];
+            }
+
+            pEmitter.mLifetime[i] = pEmitter.mLifetime[lCount];
+        }
+
+        pEmitter.mCount = lCount;
+
+        // Whole particles owed are spawned together; the fraction left over
+        // carries into the next update.
+        pEmitter.mSpawnDebt += pEmitter.mDesc.mRate * pDeltaTime;
+        const float lOwed = std::floor(pEmitter.mSpawnDebt);
+        pEmitter.mSpawnDebt -= lOwed;
+        Spawn(pEmitter, static_cast<std::size_t>(lOwed));
+    }
+
+    std::size_t ParticleSystem::Spawn (
+        Emitter&            pEmitter,
+        const std::size_t   pCount
+    )
+    {
+        const EmitterDesc& lDesc = pEmitter.mDesc;
+        const std::size_t lBegin = pEmitter.mCount;
+        const std::size_t lEnd = lBegin + std::min(pCount, lDesc.mCapacity - lBegin);
+        for (std::size_t i = lBegin; i < lEnd; ++i)
+        {
+            pEmitter.mPosition[0][i] = lDesc.mPosition.mX;
+            pEmitter.mPosition[1][i] = lDesc.mPosition.mY;
+            pEmitter.mPosition[2][i] = lDesc.mPosition.mZ;
+            pEmitter.mVelocity[0][i] = lDesc.mVelocity.mX + lDesc.mVelocitySpread.mX * NextSigned(pEmitter.mRandom);
+            pEmitter.mVelocity[1][i] = lDesc.mVelocity.mY + lDesc.mVelocitySpread.mY * NextSigned(pEmitter.mRandom);
+            pEmitter.mVelocity[2][i] = lDesc.mVelocity.mZ + lDesc.mVelocitySpread.mZ * NextSigned(pEmitter.mRandom);
+            pEmitter.mLifetime[i] = lDesc.mLifetime + lDesc.mLifetimeSpread * NextSigned(pEmitter.mRandom);
+        }
+
+        pEmitter.mCount = lEnd;
+        return lEnd - lBegin;
+    }
+
+}
@@ -0,0 +1,263 @@
+/**
+ * @file    Ace/Graphics/ParticleSystem.hpp
+ * @brief   Provides a class used for simulating large numbers of particles on
+ *          the CPU.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Maths/Vector3.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   The handle of an emitter in a @a `ParticleSystem`.
+     */
+    using EmitterId = std::uint32_t;
+
+    /**
+     * @brief   The handle which never refers to an emitter.
+     */
+    constexpr EmitterId INVALID_EMITTER = std::numeric_limits<EmitterId>::max();
+
+    /**
+     * @brief   A structure describing a particle emitter to be created.
+     */
+    struct EmitterDesc
+    {
+        std::size_t     mCapacity = 1024;               ///< @brief The most particles the emitter keeps alive at once.
+        Vector3f        mPosition;                      ///< @brief The point particles are spawned at.
+        Vector3f        mVelocity { 0.0f, 1.0f, 0.0f }; ///< @brief The mean velocity particles are spawned with.
+        Vector3f        mVelocitySpread;                ///< @brief How far each component of a particle's velocity may stray from the mean.
+        float           mRate = 0.0f;                   ///< @brief The number of particles spawned per second.
+        float           mLifetime = 1.0f;               ///< @brief The mean time a particle lives for, in seconds.
+        float           mLifetimeSpread = 0.0f;         ///< @brief How far a particle's lifetime may stray from the mean.
+        std::uint32_t   mSeed = 1;                      ///< @brief The seed of the emitter's random numbers.
+    };
+
+    /**
+     * @brief   A structure containing the settings a @a `ParticleSystem` is
+     *          created with.
+     */
+    struct ParticleSystemSpec
+    {
+        ThreadPool*     mThreadPool = nullptr;              ///< @brief The thread pool to update on, or `nullptr` to update on the calling thread.
+        Vector3f        mGravity { 0.0f, -9.81f, 0.0f };    ///< @brief The acceleration applied to every particle.
+        float           mDrag = 0.0f;                       ///< @brief The fraction of its velocity a particle loses per second.
+        std::size_t     mChunkSize = 16384;                 ///< @brief The number of particles integrated by each job.
+    };
+
+    /**
+     * @brief   A structure exposing the live particles of one emitter, for
+     *          rendering. Valid until the system is next updated.
+     */
+    struct ParticleView
+    {
+        std::array<std::span<const float>, 3>   mPosition;  ///< @brief The X, Y and Z streams of each particle's position.
+        std::array<std::span<const float>, 3>   mVelocity;  ///< @brief The X, Y and Z streams of each particle's velocity.
+        std::span<const float>                  mLifetime;  ///< @brief Each particle's remaining lifetime, in seconds.
+    };
+
+    /**
+     * @brief   A class used for simulating large numbers of particles, spawned
+     *          by emitters, on the CPU.
+     *
+     * Each emitter keeps its particles in streams of its own, one per
+     * component, allocated once at its capacity. Updating happens in two
+     * passes, both spread across the thread pool:
+     *
+     * - every emitter's particles are cut into chunks, and each chunk is
+     *   integrated four particles at a time with SSE2 where available;
+     * - each emitter then removes its dead particles by moving its last live
+     *   particle into their place, and spawns its new particles in one batch
+     *   at the end of its streams.
+     *
+     * No particle is ever allocated or freed individually. Each emitter draws
+     * its random numbers from its own generator, so the results do not
+     * depend on how the work is spread.
+     */
+    class ACE_API ParticleSystem final
+    {
+    public:
+
+        /**
+         * @brief   Creates an empty particle system.
+         *
+         * @param   pSpec   The system's settings.
+         */
+        explicit ParticleSystem (
+            const ParticleSystemSpec&   pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Adds an emitter to the system.
+         *
+         * @param   pDesc   The emitter's description.
+         *
+         * @return  The new emitter's handle.
+         *
+         * @throw   `std::invalid_argument` if the emitter's capacity is zero,
+         *          or its rate or lifetime is negative.
+         */
+        EmitterId CreateEmitter (
+            const EmitterDesc&  pDesc
+        );
+
+        /**
+         * @brief   Removes an emitter and its particles from the system. Its
+         *          handle may be given to a later emitter.
+         *
+         * @param   pEmitter    The emitter's handle.
+         */
+        void DestroyEmitter (
+            const EmitterId pEmitter
+        );
+
+        /**
+         * @brief   Moves an emitter. Particles already spawned stay where they
+         *          are.
+         *
+         * @param   pEmitter    The emitter's handle.
+         * @param   pPosition   The point particles are now spawned at.
+         */
+        void SetEmitterPosition (
+            const EmitterId pEmitter,
+            const Vector3f& pPosition
+        );
+
+        /**
+         * @brief   Changes the number of particles an emitter spawns per
+         *          second.
+         *
+         * @param   pEmitter    The emitter's handle.
+         * @param   pRate       The new rate. Negative rates count as zero.
+         */
+        void SetEmitterRate (
+            const EmitterId pEmitter,
+            const float     pRate
+        );
+
+        /**
+         * @brief   Spawns a burst of particles from an emitter at once, as
+         *          far as its capacity allows.
+         *
+         * @param   pEmitter    The emitter's handle.
+         * @param   pCount      The number of particles to spawn.
+         *
+         * @return  The number of particles actually spawned.
+         */
+        std::size_t Emit (
+            const EmitterId     pEmitter,
+            const std::size_t   pCount
+        );
+
+        /**
+         * @brief   Advances every particle, removes those which have died, and
+         *          spawns new ones.
+         *
+         * @param   pDeltaTime  The time to advance by, in seconds.
+         */
+        void Update (
+            const float pDeltaTime
+        );
+
+        /**
+         * @brief   Retrieves an emitter's live particles.
+         *
+         * @param   pEmitter    The emitter's handle.
+         *
+         * @return  A view of the emitter's particles, empty if the handle is
+         *          not valid.
+         */
+        ParticleView GetParticles (
+            const EmitterId pEmitter
+        ) const;
+
+        /**
+         * @brief   Retrieves the number of live particles across every
+         *          emitter.
+         *
+         * @return  The number of live particles.
+         */
+        std::size_t GetParticleCount () const;
+
+    private:
+        ParticleSystem (const ParticleSystem&) = delete;
+        ParticleSystem (ParticleSystem&&) = delete;
+        void operator= (const ParticleSystem&) = delete;
+        void operator= (ParticleSystem&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one emitter's settings and
+         *          particles.
+         */
+        struct Emitter
+        {
+            EmitterDesc                         mDesc;                  ///< @brief The emitter's settings.
+            std::array<std::vector<float>, 3>   mPosition;              ///< @brief The X, Y and Z streams of each particle's position.
+            std::array<std::vector<float>, 3>   mVelocity;              ///< @brief The X, Y and Z streams of each particle's velocity.
+            std::vector<float>                  mLifetime;              ///< @brief Each particle's remaining lifetime.
+            std::size_t                         mCount = 0;             ///< @brief The number of live particles, at the start of each stream.
+            float                               mSpawnDebt = 0.0f;      ///< @brief The fraction of a particle owed from earlier updates.
+            std::uint32_t                       mRandom = 1;            ///< @brief The state of the emitter's random number generator.
+            bool                                mAlive = false;         ///< @brief Is this slot in use?
+        };
+
+        /**
+         * @brief   A structure describing one run of an emitter's particles,
+         *          integrated by one job.
+         */
+        struct Chunk
+        {
+            std::uint32_t   mEmitter = 0;   ///< @brief The emitter's index.
+            std::size_t     mBegin = 0;     ///< @brief The first particle in the run.
+            std::size_t     mEnd = 0;       ///< @brief One past the last particle in the run.
+        };
+
+    private:
+
+        /**
+         * @brief   Integrates one chunk of particles.
+         */
+        void IntegrateChunk (
+            const Chunk&    pChunk,
+            const float     pDeltaTime,
+            const float     pDamping
+        );
+
+        /**
+         * @brief   Removes an emitter's dead particles, then spawns its new
+         *          ones.
+         */
+        void CompactAndSpawn (
+            Emitter&    pEmitter,
+            const float pDeltaTime
+        );
+
+        /**
+         * @brief   Spawns particles at the end of an emitter's streams, as far
+         *          as its capacity allows.
+         *
+         * @return  The number of particles spawned.
+         */
+        std::size_t Spawn (
+            Emitter&            pEmitter,
+            const std::size_t   pCount
+        );
+
+    private:
+        ParticleSystemSpec          mSpec;              ///< @brief The system's settings.
+        std::vector<Emitter>        mEmitters;          ///< @brief Every emitter slot, live or free.
+        std::vector<EmitterId>      mFreeEmitters;      ///< @brief Handles free to be given out again.
+        std::vector<Chunk>          mChunks;            ///< @brief The chunks of the current update, kept to avoid reallocating.
+        std::vector<std::uint32_t>  mLiveEmitters;      ///< @brief The live emitters of the current update, kept to avoid reallocating.
+
+    };
+
+}
@@ -0,0 +1,172 @@
+/**
+ * @file    Ace/Graphics/RenderCommandBuffer.hpp
+ * @brief   Provides a linear buffer into which a single thread records draw
+ *          commands, each tagged with a 64-bit sort key.
+ */
+
+#pragma once
+#include <bit>
+#include <Ace/Common.hpp>
+#include <Ace/Maths/Matrix4.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing a single, backend-agnostic draw command.
+     *
+     * Geometry and materials are referred to by handles, which are issued by
+     * whichever @a `IRenderBackend` the commands will be submitted to.
+     *
+     * A command may draw its geometry once per instance transform, by pointing
+     * at an array of transforms which stays alive until the command has been
+     * executed, typically one reserved from a @a `StagingRing`.
+     */
+    struct DrawCommand
+    {
+        std::uint32_t   mGeometry = 0;          ///< @brief The backend handle of the geometry to draw.
+        std::uint32_t   mMaterial = 0;          ///< @brief The backend handle of the material to draw with.
+        Matrix4f        mTransform;             ///< @brief The matrix transforming the geometry, or each instance of it, into clip space.
+        const Matrix4f* mInstances = nullptr;   ///< @brief The instances' model transforms, applied before @a `mTransform`, if the geometry is instanced.
+        std::uint32_t   mInstanceCount = 0;     ///< @brief The number of instance transforms pointed to by @a `mInstances`.
+    };
+
+    /**
+     * @brief   A structure pairing a draw command with its sort key.
+     */
+    struct RenderPacket
+    {
+        std::uint64_t       mSortKey = 0;           ///< @brief The key by which the command is ordered.
+        const DrawCommand*  mCommand = nullptr;     ///< @brief The draw command being ordered.
+    };
+
+    /**
+     * @brief   The number of bits of a sort key holding the render pass.
+     */
+    constexpr std::size_t SORT_KEY_PASS_BITS = 8;
+
+    /**
+     * @brief   The number of bits of a sort key holding the material handle.
+     */
+    constexpr std::size_t SORT_KEY_MATERIAL_BITS = 24;
+
+    /**
+     * @brief   The number of bits of a sort key holding the view depth.
+     */
+    constexpr std::size_t SORT_KEY_DEPTH_BITS = 32;
+
+    /**
+     * @brief   Builds a 64-bit sort key from a render pass, a material handle
+     *          and a view depth.
+     *
+     * From most to least significant, the key holds the pass, then the
+     * material, then the depth, so that sorted commands are grouped by pass,
+     * then batched by material, then ordered by depth.
+     *
+     * @param   pPass           The render pass. Only the lowest 8 bits are
+     *                          used.
+     * @param   pMaterial       The material handle. Only the lowest 24 bits
+     *                          are used.
+     * @param   pDepth          The view depth. Negative depths are clamped to
+     *                          zero.
+     * @param   pBackToFront    Order commands farthest first, as translucent
+     *                          passes need, instead of nearest first?
+     *
+     * @return  The sort key.
+     */
+    inline std::uint64_t MakeSortKey (
+        const std::uint32_t pPass,
+        const std::uint32_t pMaterial,
+        const float         pDepth,
+        const bool          pBackToFront = false
+    )
+    {
+        // The bit patterns of non-negative IEEE 754 floats sort in the same
+        // order as the floats they represent.
+        std::uint32_t lDepthBits = std::bit_cast<std::uint32_t>(
+            std::max(pDepth, 0.0f));
+        if (pBackToFront == true)
+        {
+            lDepthBits = ~lDepthBits;
+        }
+
+        constexpr std::uint64_t PASS_MASK     = (1ull << SORT_KEY_PASS_BITS) - 1;
+        constexpr std::uint64_t MATERIAL_MASK = (1ull << SORT_KEY_MATERIAL_BITS) - 1;
+
+        return
+            ((pPass & PASS_MASK) << (SORT_KEY_MATERIAL_BITS + SORT_KEY_DEPTH_BITS)) |
+            ((pMaterial & MATERIAL_MASK) << SORT_KEY_DEPTH_BITS) |
+            lDepthBits;
+    }
+
+    /**
+     * @brief   A linear buffer into which a single thread records draw
+     *          commands, each tagged with a 64-bit sort key.
+     *
+     * Command buffers are created by, and submitted through, a
+     * @a `RenderQueue`. Each thread records into its own buffer, so
+     * recording needs no synchronization. Resetting a buffer keeps its
+     * storage, so steady-state recording does not allocate.
+     */
+    class ACE_API RenderCommandBuffer final
+    {
+    public:
+
+        /**
+         * @brief   Records a draw command with the given sort key.
+         *
+         * @param   pSortKey    The key by which the command is ordered.
+         * @param   pCommand    The draw command to record.
+         */
+        inline void Draw (
+            const std::uint64_t&    pSortKey,
+            const DrawCommand&      pCommand
+        )
+        {
+            mSortKeys.push_back(pSortKey);
+            mCommands.push_back(pCommand);
+        }
+
+        /**
+         * @brief   Discards all recorded commands, keeping the buffer's
+         *          storage for reuse.
+         */
+        inline void Reset ()
+        {
+            mSortKeys.clear();
+            mCommands.clear();
+        }
+
+        /**
+         * @brief   Retrieves the number of recorded commands.
+         *
+         * @return  The number of recorded commands.
+         */
+        inline std::size_t GetCommandCount () const
+        {
+            return mCommands.size();
+        }
+
+        /**
+         * @brief   Writes a packet for each recorded command, in recording
+         *          order, to the given output.
+         *
+         * @param   pOut    A pointer to room for @a `GetCommandCount` packets.
+         */
+        inline void WritePackets (
+            RenderPacket*   pOut
+        ) const
+        {
+            for (std::size_t i = 0; i < mCommands.size(); ++i)
+            {
+                pOut[i] = RenderPacket { mSortKeys[i], &mCommands[i] };
+            }
+        }
+
+    private:
+        std::vector<std::uint64_t>  mSortKeys;  ///< @brief The recorded commands' sort keys.
+        std::vector<DrawCommand>    mCommands;  ///< @brief The recorded commands.
+
+    };
+
+}
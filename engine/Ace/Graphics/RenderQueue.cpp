@@ -0,0 +1,191 @@
+/**
+ * @file    Ace/Graphics/RenderQueue.cpp
+ */
+
+#include <Ace/Graphics/RenderQueue.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    RenderQueue::RenderQueue (
+        std::size_t pThreadCount
+    ) :
+        mThreadPool { pThreadCount }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    RenderCommandBuffer& RenderQueue::CreateCommandBuffer ()
+    {
+        std::lock_guard lGuard { mBuffersMutex };
+        mBuffers.push_back(std::make_unique<RenderCommandBuffer>());
+        return *mBuffers.back();
+    }
+
+    void RenderQueue::Submit (
+        IRenderBackend& pBackend
+    )
+    {
+        std::lock_guard lGuard { mBuffersMutex };
+
+        // Gather every buffer's packets into one array, in buffer creation
+        // order.
+        std::size_t lCount = 0;
+        for (const auto& lBuffer : mBuffers)
+        {
+            lCount += lBuffer->GetCommandCount();
+        }
+
+        mPackets.resize(lCount);
+        mScratch.resize(lCount);
+        std::size_t lOffset = 0;
+        for (const auto& lBuffer : mBuffers)
+        {
+            lBuffer->WritePackets(mPackets.data() + lOffset);
+            lOffset += lBuffer->GetCommandCount();
+        }
+
+        // Sort fixed-size runs of the packet array in parallel, then merge the
+        // sorted runs. The sorted result ends up in the scratch array.
+        std::size_t lRunCount = (lCount + RUN_SIZE - 1) / RUN_SIZE;
+        mThreadPool.ParallelFor(
+            lRunCount,
+            [this, lCount] (const std::size_t& pRun)
+            {
+                std::size_t lBegin = pRun * RUN_SIZE;
+                std::size_t lLength = std::min(RUN_SIZE, lCount - lBegin);
+                RadixSort(mPackets.data() + lBegin, mScratch.data() + lBegin,
+                    lLength);
+            }
+        );
+        MergeRuns(lRunCount);
+
+        // Execute the sorted commands.
+        pBackend.BeginFrame();
+        for (const auto& lPacket : mScratch)
+        {
+            pBackend.Draw(lPacket.mSortKey, *lPacket.mCommand);
+        }
+        pBackend.EndFrame();
+
+        for (auto& lBuffer : mBuffers)
+        {
+            lBuffer->Reset();
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    void RenderQueue::RadixSort (
+        RenderPacket*       pPackets,
+        RenderPacket*       pScratch,
+        const std::size_t&  pCount
+    )
+    {
+        // Build the histograms of all eight key bytes in a single pass.
+        std::array<std::array<std::size_t, 256>, 8> lHistograms {};
+        for (std::size_t i = 0; i < pCount; ++i)
+        {
+            std::uint64_t lKey = pPackets[i].mSortKey;
+            for (std::size_t lByte = 0; lByte < 8; ++lByte)
+            {
+                ++lHistograms[lByte][(lKey >> (lByte * 8)) & 0xFF];
+            }
+        }
+
+        RenderPacket* lSource = pPackets;
+        RenderPacket* lDestination = pScratch;
+        for (std::size_t lByte = 0; lByte < 8; ++lByte)
+        {
+            // If every key shares this byte, this pass would not move any
+            // packet - skip it.
+            auto& lHistogram = lHistograms[lByte];
+            if (lHistogram[(lSource[0].mSortKey >> (lByte * 8)) & 0xFF] == pCount)
+            {
+                continue;
+            }
+
+            // Turn the histogram into each bucket's starting offset, then
+            // scatter the packets into their buckets, preserving their order
+            // within each bucket.
+            std::size_t lSum = 0;
+            for (auto& lBucket : lHistogram)
+            {
+                std::size_t lBucketCount = lBucket;
+                lBucket = lSum;
+                lSum += lBucketCount;
+            }
+
+            for (std::size_t i = 0; i < pCount; ++i)
+            {
+                std::size_t lBucket = (lSource[i].mSortKey >> (lByte * 8)) & 0xFF;
+                lDestination[lHistogram[lBucket]++] = lSource[i];
+            }
+
+            std::swap(lSource, lDestination);
+        }
+
+        // An odd number of passes leaves the sorted packets in the scratch
+        // range; move them back.
+        if (lSource != pPackets)
+        {
+            std::copy_n(lSource, pCount, pPackets);
+        }
+    }
+
+    void RenderQueue::MergeRuns (
+        const std::size_t&  pRunCount
+    )
+    {
+        const std::size_t lCount = mPackets.size();
+        if (pRunCount <= 1)
+        {
+            std::copy_n(mPackets.data(), lCount, mScratch.data());
+            return;
+        }
+
+        // Each heap entry is the position of the next unmerged packet of one
+        // run. Ties between equal keys go to the earlier run, which keeps the
+        // merge stable.
+        auto lGreater =
+            [this] (const std::size_t& pFirst, const std::size_t& pSecond)
+            {
+                const auto& lFirstKey = mPackets[pFirst].mSortKey;
+                const auto& lSecondKey = mPackets[pSecond].mSortKey;
+                return
+                    lFirstKey > lSecondKey ||
+                    (lFirstKey == lSecondKey && pFirst > pSecond);
+            };
+
+        std::vector<std::size_t> lHeap;
+        lHeap.reserve(pRunCount);
+        for (std::size_t i = 0; i < pRunCount; ++i)
+        {
+            lHeap.push_back(i * RUN_SIZE);
+        }
+        std::make_heap(lHeap.begin(), lHeap.end(), lGreater);
+
+        for (std::size_t i = 0; i < lCount; ++i)
+        {
+            std::pop_heap(lHeap.begin(), lHeap.end(), lGreater);
+            std::size_t lPosition = lHeap.back();
+            mScratch[i] = mPackets[lPosition];
+
+            // Advance to the run's next packet, unless the run is exhausted.
+            if (++lPosition % RUN_SIZE != 0 && lPosition < lCount)
+            {
+                lHeap.back() = lPosition;
+                std::push_heap(lHeap.begin(), lHeap.end(), lGreater);
+            }
+            else
+            {
+                lHeap.pop_back();
+            }
+        }
+    }
+
+}
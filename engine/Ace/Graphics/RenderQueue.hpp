@@ -0,0 +1,110 @@
+/**
+ * @file    Ace/Graphics/RenderQueue.hpp
+ * @brief   Provides a class which collects draw commands recorded across
+ *          threads, sorts them by key, and submits them to a backend.
+ */
+
+#pragma once
+#include <Ace/Graphics/IRenderBackend.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class which collects draw commands recorded into per-thread
+     *          @a `RenderCommandBuffer`s, sorts them by their 64-bit keys, and
+     *          submits them to an @a `IRenderBackend` in that order.
+     *
+     * On @a `Submit`, the recorded packets are split into runs, the runs are
+     * radix-sorted in parallel, and the sorted runs are merged. Runs follow
+     * buffer creation order and recording order, and both the sort and the
+     * merge are stable, so commands with equal keys are always submitted in
+     * the same order.
+     */
+    class ACE_API RenderQueue final
+    {
+    public:
+
+        /**
+         * @brief   The maximum number of packets sorted together as one run.
+         */
+        static constexpr std::size_t RUN_SIZE = 16384;
+
+    public:
+
+        /**
+         * @brief   Constructs a render queue which sorts with the given number
+         *          of worker threads.
+         *
+         * @param   pThreadCount    The number of worker threads to sort with.
+         */
+        explicit RenderQueue (
+            std::size_t pThreadCount = std::thread::hardware_concurrency()
+        );
+
+    public:
+
+        /**
+         * @brief   Creates a new command buffer owned by this queue.
+         *
+         * This method is thread-safe. The returned buffer should only be
+         * recorded into by one thread at a time, and remains valid for the
+         * lifetime of this queue.
+         *
+         * @return  A handle to the new command buffer.
+         */
+        RenderCommandBuffer& CreateCommandBuffer ();
+
+        /**
+         * @brief   Sorts the commands recorded into all of this queue's
+         *          command buffers, executes them on the given backend, then
+         *          resets the buffers.
+         *
+         * No thread may record into this queue's buffers during submission.
+         *
+         * @param   pBackend    The backend to execute the commands on.
+         */
+        void Submit (
+            IRenderBackend& pBackend
+        );
+
+    private:
+
+        /**
+         * @brief   Sorts a range of packets by key using a stable,
+         *          least-significant-digit radix sort, one byte per pass.
+         *
+         * Passes in which every key shares the same byte are skipped.
+         *
+         * @param   pPackets    The first packet of the range to sort.
+         * @param   pScratch    The first packet of a scratch range of the same
+         *                      length.
+         * @param   pCount      The number of packets in the range.
+         */
+        static void RadixSort (
+            RenderPacket*       pPackets,
+            RenderPacket*       pScratch,
+            const std::size_t&  pCount
+        );
+
+        /**
+         * @brief   Merges the sorted runs of @a `mPackets` into
+         *          @a `mScratch`.
+         *
+         * @param   pRunCount   The number of sorted runs.
+         */
+        void MergeRuns (
+            const std::size_t&  pRunCount
+        );
+
+    private:
+        ThreadPool                                          mThreadPool;        ///< @brief The thread pool which sorts runs of packets.
+        std::mutex                                          mBuffersMutex;      ///< @brief The mutex used for locking down the command buffer list.
+        std::vector<std::unique_ptr<RenderCommandBuffer>>   mBuffers;           ///< @brief The command buffers owned by this queue, in creation order.
+        std::vector<RenderPacket>                           mPackets;           ///< @brief The gathered packets of the current submission.
+        std::vector<RenderPacket>                           mScratch;           ///< @brief Scratch space for sorting and merging packets.
+
+    };
+
+}
@@ -0,0 +1,577 @@
+/**
+ * @file    Ace/Graphics/ShaderCache.cpp
+ */
+
+#include <charconv>
+#include <Ace/Graphics/ShaderCache.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    static constexpr std::size_t NO_SHADER = static_cast<std::size_t>(-1);
+
+    static std::string_view StageName (
+        const ShaderStage   pStage
+    )
+    {
+        switch (pStage)
+        {
+            case ShaderStage::Vertex:   return "vertex";
+            case ShaderStage::Fragment: return "fragment";
+            case ShaderStage::Compute:  return "compute";
+        }
+
+        return "vertex";
+    }
+
+    static std::optional<ShaderStage> ParseStage (
+        std::string_view    pName
+    )
+    {
+        for (const ShaderStage lStage : { ShaderStage::Vertex, ShaderStage::Fragment, ShaderStage::Compute })
+        {
+            if (StageName(lStage) == pName)
+            {
+                return lStage;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    /**
+     * @brief   Splits the next whitespace-separated token off the front of a
+     *          line.
+     */
+    static std::string_view NextToken (
+        std::string_view&   pLine
+    )
+    {
+        const std::size_t lStart = pLine.find_first_not_of(" \t\r");
+        if (lStart == std::string_view::npos)
+        {
+            pLine = {};
+            return {};
+        }
+
+        const std::size_t lEnd = pLine.find_first_of(" \t\r", lStart);
+        const std::string_view lToken = pLine.substr(lStart, lEnd - lStart);
+        pLine = (lEnd == std::string_view::npos) ? std::string_view {} : pLine.substr(lEnd);
+        return lToken;
+    }
+
+    /**
+     * @brief   Reads the whole of a file from the virtual filesystem as text.
+     */
+    static std::optional<std::string> ReadText (
+        const std::string&  pLogicalPath
+    )
+    {
+        auto lFile = VFS::OpenFile(pLogicalPath);
+        if (lFile == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        std::string lText(lFile->GetSize(), '\0');
+        if (lText.empty() == false && lFile->Read(lText.data(), lText.size()) != lText.size())
+        {
+            return std::nullopt;
+        }
+
+        return lText;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    ShaderCache::ShaderCache (
+        const ShaderCacheSpec&  pSpec
+    ) :
+        mCompiler   { pSpec.mCompiler },
+        mCache      { pSpec.mCache },
+        mThreadPool { pSpec.mThreadPool }
+    {
+        if (mCompiler == nullptr)
+        {
+            ACE_THROW(std::invalid_argument, "{}: A shader cache needs a compiler!",
+                "ShaderCache");
+        }
+
+        if (mThreadPool == nullptr)
+        {
+            mOwnedThreadPool = std::make_unique<ThreadPool>();
+            mThreadPool = mOwnedThreadPool.get();
+        }
+
+        mCompilerVersion = mCompiler->GetVersion();
+    }
+
+    ShaderCache::~ShaderCache ()
+    {
+        WaitIdle();
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::uint64_t ShaderCache::MakeShaderKey (
+        const ShaderSource& pShader,
+        const std::uint64_t pCompilerVersion
+    )
+    {
+        // Definitions are sorted, so that their order makes no difference.
+        std::vector<std::string_view> lDefines { pShader.mDefines.begin(), pShader.mDefines.end() };
+        std::sort(lDefines.begin(), lDefines.end());
+
+        std::string lHeader = std::format("{}\n{}\n", StageName(pShader.mStage), pShader.mEntryPoint);
+        for (const std::string_view lDefine : lDefines)
+        {
+            lHeader += lDefine;
+            lHeader += '\n';
+        }
+
+        return ContentHash64(pShader.mSource, ContentHash64(lHeader, pCompilerVersion));
+    }
+
+    std::uint64_t ShaderCache::MakePipelineKey (
+        std::span<const std::uint64_t>  pShaderKeys,
+        std::span<const std::uint8_t>   pState,
+        const std::uint64_t             pCompilerVersion
+    )
+    {
+        return ContentHash64(pState, ContentHash64(
+            std::span<const std::uint8_t> { reinterpret_cast<const std::uint8_t*>(pShaderKeys.data()), pShaderKeys.size_bytes() },
+            pCompilerVersion));
+    }
+
+    std::shared_ptr<const CompiledShader> ShaderCache::GetShader (
+        const ShaderSource& pShader
+    )
+    {
+        const std::uint64_t lKey = MakeShaderKey(pShader, mCompilerVersion);
+        RecordShader(pShader, lKey);
+        return Acquire<CompiledShader>(mShaders, lKey,
+            [this, &pShader, lKey] () { return ResolveShader(pShader, lKey); }, false).get();
+    }
+
+    ShaderCache::ShaderFuture ShaderCache::GetShaderAsync (
+        const ShaderSource& pShader
+    )
+    {
+        const std::uint64_t lKey = MakeShaderKey(pShader, mCompilerVersion);
+        RecordShader(pShader, lKey);
+        return Acquire<CompiledShader>(mShaders, lKey,
+            [this, pShader, lKey] () { return ResolveShader(pShader, lKey); }, true);
+    }
+
+    std::shared_ptr<const CompiledPipeline> ShaderCache::GetPipeline (
+        const PipelineSource&   pPipeline
+    )
+    {
+        std::vector<std::uint64_t> lShaderKeys;
+        for (const ShaderSource& lShader : pPipeline.mShaders)
+        {
+            lShaderKeys.push_back(MakeShaderKey(lShader, mCompilerVersion));
+        }
+
+        const std::uint64_t lKey = MakePipelineKey(lShaderKeys, pPipeline.mState, mCompilerVersion);
+        RecordPipeline(pPipeline, lKey);
+        return Acquire<CompiledPipeline>(mPipelines, lKey,
+            [this, &pPipeline, lKey] () { return ResolvePipeline(pPipeline, lKey); }, false).get();
+    }
+
+    ShaderCache::PipelineFuture ShaderCache::GetPipelineAsync (
+        const PipelineSource&   pPipeline
+    )
+    {
+        std::vector<std::uint64_t> lShaderKeys;
+        for (const ShaderSource& lShader : pPipeline.mShaders)
+        {
+            lShaderKeys.push_back(MakeShaderKey(lShader, mCompilerVersion));
+        }
+
+        const std::uint64_t lKey = MakePipelineKey(lShaderKeys, pPipeline.mState, mCompilerVersion);
+        RecordPipeline(pPipeline, lKey);
+        return Acquire<CompiledPipeline>(mPipelines, lKey,
+            [this, pPipeline, lKey] () { return ResolvePipeline(pPipeline, lKey); }, true);
+    }
+
+    std::size_t ShaderCache::Prewarm (
+        const std::string&  pManifestPath
+    )
+    {
+        const std::optional<std::string> lManifest = ReadText(pManifestPath);
+        if (lManifest.has_value() == false)
+        {
+            ACE_THROW(std::runtime_error, "{}: Could not open manifest '{}'!",
+                "ShaderCache", pManifestPath);
+        }
+
+        // Shaders are started before the pipelines which use them, so a
+        // pipeline's task only ever waits on shaders already under way.
+        std::vector<std::optional<ShaderSource>> lShaders;
+        std::vector<PipelineSource> lPipelines;
+        std::size_t lLineNumber = 0;
+        std::string_view lSource = *lManifest;
+        while (lSource.empty() == false)
+        {
+            const std::size_t lEnd = lSource.find('\n');
+            std::string_view lLine = lSource.substr(0, lEnd);
+            lSource = (lEnd == std::string_view::npos) ? std::string_view {} : lSource.substr(lEnd + 1);
+            ++lLineNumber;
+
+            std::vector<std::string> lTokens;
+            for (std::string_view lToken = NextToken(lLine); lToken.empty() == false; lToken = NextToken(lLine))
+            {
+                lTokens.emplace_back(lToken);
+            }
+
+            if (lTokens.empty() == true || lTokens[0].starts_with('#') == true)
+            {
+                continue;
+            }
+            else if (lTokens[0] == "shader" && lTokens.size() >= 4 && ParseStage(lTokens[1]).has_value() == true)
+            {
+                std::optional<std::string> lSource = ReadText(lTokens[2]);
+                if (lSource.has_value() == false)
+                {
+                    lShaders.emplace_back();
+                    continue;
+                }
+
+                lShaders.push_back(ShaderSource {
+                    .mPath = lTokens[2],
+                    .mStage = *ParseStage(lTokens[1]),
+                    .mEntryPoint = lTokens[3],
+                    .mDefines = { lTokens.begin() + 4, lTokens.end() },
+                    .mSource = std::move(*lSource)
+                });
+                continue;
+            }
+            else if (lTokens[0] == "pipeline" && lTokens.size() >= 3 && (lTokens[1] == "-" || lTokens[1].size() % 2 == 0))
+            {
+                PipelineSource lPipeline;
+                bool lValid = true;
+                for (std::size_t i = 0; lTokens[1] != "-" && i < lTokens[1].size(); i += 2)
+                {
+                    std::uint8_t lByte = 0;
+                    const auto lResult = std::from_chars(lTokens[1].data() + i, lTokens[1].data() + i + 2, lByte, 16);
+                    lValid = lValid && lResult.ec == std::errc {} && lResult.ptr == lTokens[1].data() + i + 2;
+                    lPipeline.mState.push_back(lByte);
+                }
+
+                bool lAvailable = true;
+                for (std::size_t i = 2; i < lTokens.size() && lValid == true; ++i)
+                {
+                    std::size_t lIndex = 0;
+                    const auto lResult = std::from_chars(lTokens[i].data(), lTokens[i].data() + lTokens[i].size(), lIndex);
+                    lValid = lResult.ec == std::errc {} && lResult.ptr == lTokens[i].data() + lTokens[i].size() && lIndex < lShaders.size();
+                    if (lValid == true && lShaders[lIndex].has_value() == true)
+                    {
+                        lPipeline.mShaders.push_back(*lShaders[lIndex]);
+                    }
+                    else
+                    {
+                        lAvailable = false;
+                    }
+                }
+
+                if (lValid == true)
+                {
+                    if (lAvailable == true)
+                    {
+                        lPipelines.push_back(std::move(lPipeline));
+                    }
+
+                    continue;
+                }
+            }
+
+            ACE_THROW(std::runtime_error, "{}: Line {} of manifest '{}' is malformed!",
+                "ShaderCache", lLineNumber, pManifestPath);
+        }
+
+        std::size_t lStarted = 0;
+        for (const std::optional<ShaderSource>& lShader : lShaders)
+        {
+            if (lShader.has_value() == true)
+            {
+                GetShaderAsync(*lShader);
+                ++lStarted;
+            }
+        }
+
+        for (const PipelineSource& lPipeline : lPipelines)
+        {
+            GetPipelineAsync(lPipeline);
+            ++lStarted;
+        }
+
+        return lStarted;
+    }
+
+    void ShaderCache::WaitIdle ()
+    {
+        // A pipeline's task may add entries for its shaders, so look again
+        // until everything seen is finished.
+        while (true)
+        {
+            std::vector<ShaderFuture> lShaders;
+            std::vector<PipelineFuture> lPipelines;
+            {
+                std::lock_guard lGuard { mMutex };
+                for (const auto& [lKey, lFuture] : mShaders)
+                {
+                    if (lFuture.wait_for(std::chrono::seconds { 0 }) != std::future_status::ready)
+                    {
+                        lShaders.push_back(lFuture);
+                    }
+                }
+
+                for (const auto& [lKey, lFuture] : mPipelines)
+                {
+                    if (lFuture.wait_for(std::chrono::seconds { 0 }) != std::future_status::ready)
+                    {
+                        lPipelines.push_back(lFuture);
+                    }
+                }
+            }
+
+            if (lShaders.empty() == true && lPipelines.empty() == true)
+            {
+                return;
+            }
+
+            for (const ShaderFuture& lFuture : lShaders)
+            {
+                lFuture.wait();
+            }
+
+            for (const PipelineFuture& lFuture : lPipelines)
+            {
+                lFuture.wait();
+            }
+        }
+    }
+
+    std::string ShaderCache::BuildManifest () const
+    {
+        std::lock_guard lGuard { mMutex };
+
+        std::string lManifest = "# Shader cache manifest\n";
+        for (const std::string& lLine : mManifest)
+        {
+            lManifest += lLine;
+            lManifest += '\n';
+        }
+
+        return lManifest;
+    }
+
+    /* Private Methods ********************************************************/
+
+    template <typename T>
+    std::shared_future<std::shared_ptr<const T>> ShaderCache::Acquire (
+        std::unordered_map<std::uint64_t, std::shared_future<std::shared_ptr<const T>>>&    pEntries,
+        const std::uint64_t                                                                 pKey,
+        std::function<std::shared_ptr<const T> ()>                                          pResolve,
+        const bool                                                                          pAsync
+    )
+    {
+        auto lPromise = std::make_shared<std::promise<std::shared_ptr<const T>>>();
+        std::shared_future<std::shared_ptr<const T>> lFuture;
+        {
+            std::lock_guard lGuard { mMutex };
+            auto lIter = pEntries.find(pKey);
+            if (lIter != pEntries.end())
+            {
+                return lIter->second;
+            }
+
+            lFuture = lPromise->get_future().share();
+            pEntries.emplace(pKey, lFuture);
+        }
+
+        // A failed entry is forgotten before its waiters hear of it, so that
+        // the next request tries again.
+        auto lTask =
+            [this, &pEntries, pKey, lPromise, lResolve = std::move(pResolve)] ()
+            {
+                try
+                {
+                    lPromise->set_value(lResolve());
+                }
+                catch (...)
+                {
+                    {
+                        std::lock_guard lGuard { mMutex };
+                        pEntries.erase(pKey);
+                    }
+
+                    lPromise->set_exception(std::current_exception());
+                }
+            };
+
+        if (pAsync == true)
+        {
+            mThreadPool->Enqueue(std::move(lTask));
+        }
+        else
+        {
+            lTask();
+        }
+
+        return lFuture;
+    }
+
+    std::shared_ptr<const CompiledShader> ShaderCache::ResolveShader (
+        const ShaderSource& pShader,
+        const std::uint64_t pKey
+    )
+    {
+        auto lShader = std::make_shared<CompiledShader>();
+        lShader->mKey = pKey;
+        lShader->mStage = pShader.mStage;
+
+        if (mCache != nullptr)
+        {
+            if (auto lCode = mCache->Get(SHADER_BUCKET, pKey))
+            {
+                mDiskHitCount.fetch_add(1, std::memory_order_relaxed);
+                lShader->mCode = std::move(*lCode);
+                return lShader;
+            }
+        }
+
+        lShader->mCode = mCompiler->CompileShader(pShader);
+        mCompileCount.fetch_add(1, std::memory_order_relaxed);
+        if (mCache != nullptr)
+        {
+            mCache->Put(SHADER_BUCKET, pKey, lShader->mCode);
+        }
+
+        return lShader;
+    }
+
+    std::shared_ptr<const CompiledPipeline> ShaderCache::ResolvePipeline (
+        const PipelineSource&   pPipeline,
+        const std::uint64_t     pKey
+    )
+    {
+        auto lPipeline = std::make_shared<CompiledPipeline>();
+        lPipeline->mKey = pKey;
+
+        if (mCache != nullptr)
+        {
+            if (auto lCode = mCache->Get(PIPELINE_BUCKET, pKey))
+            {
+                mDiskHitCount.fetch_add(1, std::memory_order_relaxed);
+                lPipeline->mCode = std::move(*lCode);
+                return lPipeline;
+            }
+        }
+
+        // Only a pipeline which must be built needs its shaders. This may run
+        // on a worker, so a shader still under way is resolved again here
+        // rather than waited on, lest every worker wait on tasks queued
+        // behind it.
+        std::vector<astd::byte_buffer> lShaders;
+        for (const ShaderSource& lShader : pPipeline.mShaders)
+        {
+            const std::uint64_t lShaderKey = MakeShaderKey(lShader, mCompilerVersion);
+            bool lPending = false;
+            {
+                std::lock_guard lGuard { mMutex };
+                auto lIter = mShaders.find(lShaderKey);
+                lPending = lIter != mShaders.end() &&
+                    lIter->second.wait_for(std::chrono::seconds { 0 }) != std::future_status::ready;
+            }
+
+            lShaders.push_back((lPending == true) ? ResolveShader(lShader, lShaderKey)->mCode :
+                Acquire<CompiledShader>(mShaders, lShaderKey,
+                    [this, &lShader, lShaderKey] () { return ResolveShader(lShader, lShaderKey); }, false).get()->mCode);
+        }
+
+        lPipeline->mCode = mCompiler->BuildPipeline(lShaders, pPipeline.mState);
+        mCompileCount.fetch_add(1, std::memory_order_relaxed);
+        if (mCache != nullptr)
+        {
+            mCache->Put(PIPELINE_BUCKET, pKey, lPipeline->mCode);
+        }
+
+        return lPipeline;
+    }
+
+    std::size_t ShaderCache::RecordShader (
+        const ShaderSource& pShader,
+        const std::uint64_t pKey
+    )
+    {
+        if (pShader.mPath.empty() == true)
+        {
+            return NO_SHADER;
+        }
+
+        std::lock_guard lGuard { mMutex };
+        auto lIter = mManifestShaders.find(pKey);
+        if (lIter != mManifestShaders.end())
+        {
+            return lIter->second;
+        }
+
+        std::string lLine = std::format("shader {} {} {}", StageName(pShader.mStage), pShader.mPath, pShader.mEntryPoint);
+        for (const std::string& lDefine : pShader.mDefines)
+        {
+            lLine += ' ';
+            lLine += lDefine;
+        }
+
+        const std::size_t lIndex = mManifestShaders.size();
+        mManifestShaders.emplace(pKey, lIndex);
+        mManifest.push_back(std::move(lLine));
+        return lIndex;
+    }
+
+    void ShaderCache::RecordPipeline (
+        const PipelineSource&   pPipeline,
+        const std::uint64_t     pKey
+    )
+    {
+        std::vector<std::size_t> lIndices;
+        for (const ShaderSource& lShader : pPipeline.mShaders)
+        {
+            const std::size_t lIndex = RecordShader(lShader, MakeShaderKey(lShader, mCompilerVersion));
+            if (lIndex == NO_SHADER)
+            {
+                return;
+            }
+
+            lIndices.push_back(lIndex);
+        }
+
+        std::string lLine = "pipeline ";
+        if (pPipeline.mState.empty() == true)
+        {
+            lLine += '-';
+        }
+
+        for (const std::uint8_t lByte : pPipeline.mState)
+        {
+            lLine += "0123456789abcdef"[lByte >> 4];
+            lLine += "0123456789abcdef"[lByte & 15];
+        }
+
+        for (const std::size_t lIndex : lIndices)
+        {
+            lLine += std::format(" {}", lIndex);
+        }
+
+        std::lock_guard lGuard { mMutex };
+        if (mManifestPipelines.insert(pKey).second == true)
+        {
+            mManifest.push_back(std::move(lLine));
+        }
+    }
+
+}
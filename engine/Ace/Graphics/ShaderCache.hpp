@@ -0,0 +1,316 @@
+/**
+ * @file    Ace/Graphics/ShaderCache.hpp
+ * @brief   Provides a backend-agnostic cache of compiled shaders and
+ *          pipelines, kept in memory and persisted on disk.
+ */
+
+#pragma once
+#include <Ace/Graphics/IShaderCompiler.hpp>
+#include <Ace/System/DerivedDataCache.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing one compiled shader.
+     */
+    struct CompiledShader
+    {
+        std::uint64_t       mKey = 0;                       ///< @brief The key the shader is cached under.
+        ShaderStage         mStage = ShaderStage::Vertex;   ///< @brief The stage the shader runs at.
+        astd::byte_buffer   mCode;                          ///< @brief The compiled shader, as its compiler produced it.
+    };
+
+    /**
+     * @brief   A structure containing one built pipeline.
+     */
+    struct CompiledPipeline
+    {
+        std::uint64_t       mKey = 0;                       ///< @brief The key the pipeline is cached under.
+        astd::byte_buffer   mCode;                          ///< @brief The built pipeline, as its compiler produced it.
+    };
+
+    /**
+     * @brief   A structure containing the settings of a shader cache.
+     */
+    struct ShaderCacheSpec
+    {
+        std::shared_ptr<IShaderCompiler>    mCompiler = nullptr;    ///< @brief The compiler misses are compiled with.
+        std::shared_ptr<DerivedDataCache>   mCache = nullptr;       ///< @brief The cache binaries persist in, or `nullptr` to keep them in memory only.
+        ThreadPool*                         mThreadPool = nullptr;  ///< @brief The pool asynchronous work runs on, or `nullptr` for one of the cache's own.
+    };
+
+    /**
+     * @brief   A class which caches compiled shaders and pipelines, so that
+     *          each is compiled once, ever, rather than on every start.
+     *
+     * A shader is keyed by a hash of its source, stage, entry point and
+     * definitions, in any order, seeded with the compiler's version; a
+     * pipeline, by its shaders' keys and its state. Lookups try memory, then
+     * the @a `DerivedDataCache` on disk, and only then the compiler, storing
+     * what it produces in both. Concurrent requests for one key share a
+     * single load or compile.
+     *
+     * Everything requested is recorded, and @a `BuildManifest` writes it out
+     * as text; on the next start, @a `Prewarm` reads that manifest back and
+     * loads or compiles every entry in the background, before the first
+     * frame asks for them. Shaders whose source did not come from a logical
+     * path cannot be recorded, nor can pipelines which use them.
+     *
+     * All methods may be called from any thread.
+     */
+    class ACE_API ShaderCache final
+    {
+    public:
+
+        /**
+         * @brief   The cache bucket compiled shaders are stored in.
+         */
+        static constexpr std::string_view SHADER_BUCKET = "shaders";
+
+        /**
+         * @brief   The cache bucket built pipelines are stored in.
+         */
+        static constexpr std::string_view PIPELINE_BUCKET = "pipelines";
+
+        using ShaderFuture = std::shared_future<std::shared_ptr<const CompiledShader>>;
+        using PipelineFuture = std::shared_future<std::shared_ptr<const CompiledPipeline>>;
+
+    public:
+
+        /**
+         * @brief   Constructs a shader cache.
+         *
+         * @param   pSpec   The cache's settings.
+         *
+         * @throw   `std::invalid_argument` if no compiler is given.
+         */
+        explicit ShaderCache (
+            const ShaderCacheSpec&  pSpec
+        );
+
+        /**
+         * @brief   The destructor waits for any asynchronous work to finish.
+         */
+        ~ShaderCache ();
+
+    public:
+
+        /**
+         * @brief   Forms the key a shader is cached under.
+         *
+         * @param   pShader             The shader.
+         * @param   pCompilerVersion    The version of the compiler.
+         *
+         * @return  The key.
+         */
+        static std::uint64_t MakeShaderKey (
+            const ShaderSource& pShader,
+            const std::uint64_t pCompilerVersion
+        );
+
+        /**
+         * @brief   Forms the key a pipeline is cached under.
+         *
+         * @param   pShaderKeys         The keys of the pipeline's shaders.
+         * @param   pState              The pipeline's state.
+         * @param   pCompilerVersion    The version of the compiler.
+         *
+         * @return  The key.
+         */
+        static std::uint64_t MakePipelineKey (
+            std::span<const std::uint64_t>  pShaderKeys,
+            std::span<const std::uint8_t>   pState,
+            const std::uint64_t             pCompilerVersion
+        );
+
+        /**
+         * @brief   Retrieves a compiled shader, loading or compiling it on
+         *          this thread if need be.
+         *
+         * @param   pShader The shader.
+         *
+         * @return  The compiled shader.
+         *
+         * @throw   `std::runtime_error` if the shader does not compile.
+         */
+        std::shared_ptr<const CompiledShader> GetShader (
+            const ShaderSource& pShader
+        );
+
+        /**
+         * @brief   Retrieves a compiled shader, loading or compiling it in the
+         *          background if need be.
+         *
+         * @param   pShader The shader.
+         *
+         * @return  A future holding the compiled shader, or the error it
+         *          failed to compile with.
+         */
+        ShaderFuture GetShaderAsync (
+            const ShaderSource& pShader
+        );
+
+        /**
+         * @brief   Retrieves a built pipeline, loading or building it, and
+         *          any of its shaders, on this thread if need be.
+         *
+         * @param   pPipeline   The pipeline.
+         *
+         * @return  The built pipeline.
+         *
+         * @throw   `std::runtime_error` if the pipeline, or one of its
+         *          shaders, cannot be built.
+         */
+        std::shared_ptr<const CompiledPipeline> GetPipeline (
+            const PipelineSource&   pPipeline
+        );
+
+        /**
+         * @brief   Retrieves a built pipeline, loading or building it in the
+         *          background if need be.
+         *
+         * @param   pPipeline   The pipeline.
+         *
+         * @return  A future holding the built pipeline, or the error it
+         *          failed to build with.
+         */
+        PipelineFuture GetPipelineAsync (
+            const PipelineSource&   pPipeline
+        );
+
+        /**
+         * @brief   Reads a manifest written by @a `BuildManifest`, and starts
+         *          loading or compiling each of its entries in the
+         *          background.
+         *
+         * Entries whose source can no longer be opened are skipped.
+         *
+         * @param   pManifestPath   The manifest's logical path.
+         *
+         * @return  The number of shaders and pipelines started.
+         *
+         * @throw   `std::runtime_error` if the manifest cannot be opened, or
+         *          is malformed.
+         */
+        std::size_t Prewarm (
+            const std::string&  pManifestPath
+        );
+
+        /**
+         * @brief   Waits until every load and compile started so far has
+         *          finished, whether or not it succeeded.
+         */
+        void WaitIdle ();
+
+        /**
+         * @brief   Writes out every shader and pipeline requested so far, as a
+         *          manifest for @a `Prewarm`.
+         *
+         * Each line is either `shader <stage> <path> <entry> [defines...]`,
+         * or `pipeline <state> <shader>...`, where the state is in
+         * hexadecimal, or `-` if empty, and each shader is the index of an
+         * earlier `shader` line. Paths and definitions may not contain
+         * whitespace.
+         *
+         * @return  The manifest's text.
+         */
+        std::string BuildManifest () const;
+
+        /**
+         * @brief   Retrieves the number of shaders and pipelines compiled so
+         *          far, rather than found in memory or on disk.
+         *
+         * @return  The number compiled.
+         */
+        inline std::size_t GetCompileCount () const
+        {
+            return mCompileCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Retrieves the number of shaders and pipelines found on disk
+         *          so far.
+         *
+         * @return  The number of disk hits.
+         */
+        inline std::size_t GetDiskHitCount () const
+        {
+            return mDiskHitCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        ShaderCache (const ShaderCache&) = delete;
+        ShaderCache (ShaderCache&&) = delete;
+        void operator= (const ShaderCache&) = delete;
+        void operator= (ShaderCache&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Finds the entry for a key, or adds one and resolves it,
+         *          either on this thread or on the pool.
+         */
+        template <typename T>
+        std::shared_future<std::shared_ptr<const T>> Acquire (
+            std::unordered_map<std::uint64_t, std::shared_future<std::shared_ptr<const T>>>&    pEntries,
+            const std::uint64_t                                                                 pKey,
+            std::function<std::shared_ptr<const T> ()>                                          pResolve,
+            const bool                                                                          pAsync
+        );
+
+        /**
+         * @brief   Loads a shader from disk, or compiles and stores it.
+         */
+        std::shared_ptr<const CompiledShader> ResolveShader (
+            const ShaderSource& pShader,
+            const std::uint64_t pKey
+        );
+
+        /**
+         * @brief   Loads a pipeline from disk, or builds and stores it.
+         */
+        std::shared_ptr<const CompiledPipeline> ResolvePipeline (
+            const PipelineSource&   pPipeline,
+            const std::uint64_t     pKey
+        );
+
+        /**
+         * @brief   Records a shader in the manifest, if it has a path.
+         *
+         * @return  The shader's index in the manifest, or `-1` if it cannot
+         *          be recorded.
+         */
+        std::size_t RecordShader (
+            const ShaderSource& pShader,
+            const std::uint64_t pKey
+        );
+
+        /**
+         * @brief   Records a pipeline in the manifest, if all of its shaders
+         *          have paths.
+         */
+        void RecordPipeline (
+            const PipelineSource&   pPipeline,
+            const std::uint64_t     pKey
+        );
+
+    private:
+        std::shared_ptr<IShaderCompiler>                        mCompiler;              ///< @brief The compiler misses are compiled with.
+        std::shared_ptr<DerivedDataCache>                       mCache;                 ///< @brief The cache binaries persist in, if any.
+        std::unique_ptr<ThreadPool>                             mOwnedThreadPool;       ///< @brief The cache's own pool, if it was given none.
+        ThreadPool*                                             mThreadPool = nullptr;  ///< @brief The pool asynchronous work runs on.
+        std::uint64_t                                           mCompilerVersion = 0;   ///< @brief The compiler's version, which seeds every key.
+        mutable std::mutex                                      mMutex;                 ///< @brief Guards the entries and the manifest.
+        std::unordered_map<std::uint64_t, ShaderFuture>         mShaders;               ///< @brief Every shader requested, by key.
+        std::unordered_map<std::uint64_t, PipelineFuture>       mPipelines;             ///< @brief Every pipeline requested, by key.
+        std::vector<std::string>                                mManifest;              ///< @brief The manifest's lines.
+        std::unordered_map<std::uint64_t, std::size_t>          mManifestShaders;       ///< @brief The manifest index of each recorded shader, by key.
+        std::unordered_set<std::uint64_t>                       mManifestPipelines;     ///< @brief The keys of the recorded pipelines.
+        std::atomic<std::size_t>                                mCompileCount { 0 };    ///< @brief The number of shaders and pipelines compiled.
+        std::atomic<std::size_t>                                mDiskHitCount { 0 };    ///< @brief The number of shaders and pipelines found on disk.
+
+    };
+
+}
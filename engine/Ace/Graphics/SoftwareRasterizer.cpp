@@ -0,0 +1,556 @@
+/**
+ * @file    Ace/Graphics/SoftwareRasterizer.cpp
+ */
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+#include <Ace/Graphics/SoftwareRasterizer.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    SoftwareRasterizer::SoftwareRasterizer (
+        Framebuffer&    pTarget,
+        std::size_t     pThreadCount
+    ) :
+        mTarget     { pTarget },
+        mThreadPool { pThreadCount },
+        mTilesX     { (pTarget.GetWidth() + TILE_SIZE - 1) / TILE_SIZE },
+        mTilesY     { (pTarget.GetHeight() + TILE_SIZE - 1) / TILE_SIZE }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    void SoftwareRasterizer::Submit (
+        const std::vector<RasterVertex>&    pVertices,
+        const std::vector<std::uint32_t>&   pIndices,
+        const Matrix4f&                     pTransform,
+        const RasterState&                  pState
+    )
+    {
+        // Transform every vertex into clip space up front, so that vertices
+        // shared between triangles are only transformed once.
+        mClipVertices.resize(pVertices.size());
+        mThreadPool.ParallelFor(
+            pVertices.size(),
+            [&] (const std::size_t& i)
+            {
+                const RasterVertex& lVertex = pVertices[i];
+                mClipVertices[i] = ClipVertex {
+                    pTransform * Vector4f { lVertex.mPosition.mX,
+                        lVertex.mPosition.mY, lVertex.mPosition.mZ, 1.0f },
+                    lVertex.mColor
+                };
+            },
+            4096
+        );
+
+        // Assemble, clip and set up each triangle.
+        for (std::size_t i = 0; i + 2 < pIndices.size(); i += 3)
+        {
+            if (
+                pIndices[i + 0] >= mClipVertices.size() ||
+                pIndices[i + 1] >= mClipVertices.size() ||
+                pIndices[i + 2] >= mClipVertices.size()
+            )
+            {
+                ACE_THROW(
+                    std::out_of_range,
+                    "{}: Triangle {} indexes past the end of its {} vertices!",
+                    "SoftwareRasterizer", i / 3, mClipVertices.size()
+                );
+            }
+
+            ClipAndSetup(
+                {
+                    mClipVertices[pIndices[i + 0]],
+                    mClipVertices[pIndices[i + 1]],
+                    mClipVertices[pIndices[i + 2]]
+                },
+                pState
+            );
+        }
+    }
+
+    void SoftwareRasterizer::Flush ()
+    {
+        if (mTriangles.empty() == true)
+        {
+            return;
+        }
+
+        // Bin the queued triangles in parallel chunks. Each chunk gets its own
+        // set of per-tile bins, so binning needs no synchronization, and a
+        // tile visiting the chunks in order sees its triangles in submission
+        // order.
+        std::size_t lChunks = (mTriangles.size() + BIN_CHUNK_SIZE - 1) /
+            BIN_CHUNK_SIZE;
+        mBins.resize(lChunks * mTilesX * mTilesY);
+        mThreadPool.ParallelFor(
+            lChunks,
+            [this] (const std::size_t& pChunk) { BinChunk(pChunk); }
+        );
+
+        // Rasterize the tiles in parallel.
+        mThreadPool.ParallelFor(
+            mTilesX * mTilesY,
+            [this] (const std::size_t& pTile) { RasterizeTile(pTile); }
+        );
+
+        mTriangles.clear();
+    }
+
+    /* Private Methods ********************************************************/
+
+    void SoftwareRasterizer::ClipAndSetup (
+        const std::array<ClipVertex, 3>&    pVertices,
+        const RasterState&                  pState
+    )
+    {
+        // A vertex lies in front of the near plane if `z >= -w`. Measure each
+        // vertex's signed distance to that plane.
+        std::array<float, 3> lDistances;
+        std::size_t lInside = 0;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lDistances[i] = pVertices[i].mPosition.mZ + pVertices[i].mPosition.mW;
+            lInside += (lDistances[i] >= 0.0f) ? 1 : 0;
+        }
+
+        if (lInside == 0)
+        {
+            return;
+        }
+        else if (lInside == 3)
+        {
+            Setup(pVertices, pState);
+            return;
+        }
+
+        // Clip the triangle against the near plane, keeping the vertices in
+        // front of it and adding one where each edge crosses it. This yields
+        // a triangle or a quad, which is then split into a fan of triangles.
+        std::array<ClipVertex, 4> lPolygon;
+        std::size_t lCount = 0;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            std::size_t j = (i + 1) % 3;
+            const ClipVertex& lCurrent = pVertices[i];
+            const ClipVertex& lNext = pVertices[j];
+
+            if (lDistances[i] >= 0.0f)
+            {
+                lPolygon[lCount++] = lCurrent;
+            }
+
+            if ((lDistances[i] >= 0.0f) != (lDistances[j] >= 0.0f))
+            {
+                float lT = lDistances[i] / (lDistances[i] - lDistances[j]);
+                lPolygon[lCount++] = ClipVertex {
+                    lCurrent.mPosition + (lNext.mPosition - lCurrent.mPosition) * lT,
+                    lCurrent.mColor + (lNext.mColor - lCurrent.mColor) * lT
+                };
+            }
+        }
+
+        for (std::size_t i = 1; i + 1 < lCount; ++i)
+        {
+            Setup({ lPolygon[0], lPolygon[i], lPolygon[i + 1] }, pState);
+        }
+    }
+
+    void SoftwareRasterizer::Setup (
+        const std::array<ClipVertex, 3>&    pVertices,
+        const RasterState&                  pState
+    )
+    {
+        const float lWidth  = static_cast<float>(mTarget.GetWidth());
+        const float lHeight = static_cast<float>(mTarget.GetHeight());
+
+        // Project each vertex into window space. Screen Y grows downwards, and
+        // positions are snapped to a 1/16th-pixel grid so that vertices shared
+        // between triangles always land in exactly the same place.
+        Triangle lTriangle;
+        std::array<float, 3> lX, lY;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const Vector4f& lPosition = pVertices[i].mPosition;
+            float lInverseW = 1.0f / lPosition.mW;
+
+            lX[i] = std::round(((lPosition.mX * lInverseW) * 0.5f + 0.5f) * lWidth * 16.0f) / 16.0f;
+            lY[i] = std::round((0.5f - (lPosition.mY * lInverseW) * 0.5f) * lHeight * 16.0f) / 16.0f;
+
+            lTriangle.mDepth[i]      = (lPosition.mZ * lInverseW) * 0.5f + 0.5f;
+            lTriangle.mInverseW[i]   = lInverseW;
+            lTriangle.mColorOverW[i] = pVertices[i].mColor * lInverseW;
+        }
+
+        // Set up the edge functions. The constant term is written as a cross
+        // product of the edge's endpoints, so that the edge shared by two
+        // adjacent triangles evaluates to exactly opposite values in each,
+        // leaving no cracks and no double-drawn pixels between them.
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            std::size_t a = (i + 1) % 3;
+            std::size_t b = (i + 2) % 3;
+
+            lTriangle.mEdgeA[i] = lY[a] - lY[b];
+            lTriangle.mEdgeB[i] = lX[b] - lX[a];
+            lTriangle.mEdgeC[i] = lX[a] * lY[b] - lY[a] * lX[b];
+        }
+
+        // The edge opposite vertex 0, evaluated at vertex 0, gives twice the
+        // triangle's signed area. Screen Y grows downwards, which reverses the
+        // winding, so a negative area means the triangle was wound
+        // counter-clockwise in normalized device coordinates, and is
+        // front-facing.
+        float lArea =
+            lTriangle.mEdgeA[0] * lX[0] +
+            lTriangle.mEdgeB[0] * lY[0] +
+            lTriangle.mEdgeC[0];
+        if (
+            lArea == 0.0f ||
+            (pState.mCullMode == CullMode::Back  && lArea > 0.0f) ||
+            (pState.mCullMode == CullMode::Front && lArea < 0.0f)
+        )
+        {
+            return;
+        }
+
+        // Flip the edge functions of front-facing triangles, so that they are
+        // positive inside every triangle.
+        if (lArea < 0.0f)
+        {
+            lArea = -lArea;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                lTriangle.mEdgeA[i] = -lTriangle.mEdgeA[i];
+                lTriangle.mEdgeB[i] = -lTriangle.mEdgeB[i];
+                lTriangle.mEdgeC[i] = -lTriangle.mEdgeC[i];
+            }
+        }
+
+        // Pixel centers lying exactly on an edge are claimed by only one of
+        // the two triangles sharing that edge: the one in which the edge's
+        // normal points right, or straight down.
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lTriangle.mInclusive[i] =
+                lTriangle.mEdgeA[i] > 0.0f ||
+                (lTriangle.mEdgeA[i] == 0.0f && lTriangle.mEdgeB[i] > 0.0f);
+        }
+
+        // Clamp the triangle's bounds to the framebuffer, discarding it if it
+        // lies entirely offscreen.
+        float lMinX = std::min({ lX[0], lX[1], lX[2] });
+        float lMinY = std::min({ lY[0], lY[1], lY[2] });
+        float lMaxX = std::max({ lX[0], lX[1], lX[2] });
+        float lMaxY = std::max({ lY[0], lY[1], lY[2] });
+        if (lMaxX < 0.0f || lMaxY < 0.0f || lMinX >= lWidth || lMinY >= lHeight)
+        {
+            return;
+        }
+
+        lTriangle.mMinX = static_cast<std::int32_t>(std::max(std::floor(lMinX), 0.0f));
+        lTriangle.mMinY = static_cast<std::int32_t>(std::max(std::floor(lMinY), 0.0f));
+        lTriangle.mMaxX = static_cast<std::int32_t>(std::min(std::ceil(lMaxX), lWidth - 1.0f));
+        lTriangle.mMaxY = static_cast<std::int32_t>(std::min(std::ceil(lMaxY), lHeight - 1.0f));
+
+        lTriangle.mInverseArea  = 1.0f / lArea;
+        lTriangle.mDepthTest    = pState.mDepthTest;
+        lTriangle.mDepthWrite   = pState.mDepthWrite;
+        mTriangles.push_back(lTriangle);
+    }
+
+    void SoftwareRasterizer::BinChunk (
+        const std::size_t&  pChunk
+    )
+    {
+        const std::size_t lTileCount = mTilesX * mTilesY;
+        auto lBins = mBins.begin() + pChunk * lTileCount;
+        for (std::size_t i = 0; i < lTileCount; ++i)
+        {
+            lBins[i].clear();
+        }
+
+        std::size_t lBegin = pChunk * BIN_CHUNK_SIZE;
+        std::size_t lEnd = std::min(lBegin + BIN_CHUNK_SIZE, mTriangles.size());
+        for (std::size_t i = lBegin; i < lEnd; ++i)
+        {
+            const Triangle& lTriangle = mTriangles[i];
+            std::size_t lTileMinX = lTriangle.mMinX / TILE_SIZE;
+            std::size_t lTileMinY = lTriangle.mMinY / TILE_SIZE;
+            std::size_t lTileMaxX = lTriangle.mMaxX / TILE_SIZE;
+            std::size_t lTileMaxY = lTriangle.mMaxY / TILE_SIZE;
+
+            for (std::size_t y = lTileMinY; y <= lTileMaxY; ++y)
+            {
+                for (std::size_t x = lTileMinX; x <= lTileMaxX; ++x)
+                {
+                    lBins[y * mTilesX + x].push_back(static_cast<std::uint32_t>(i));
+                }
+            }
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTile (
+        const std::size_t&  pTile
+    )
+    {
+        const std::size_t lTileCount = mTilesX * mTilesY;
+        const std::size_t lChunks = mBins.size() / lTileCount;
+
+        std::int32_t lTileMinX = static_cast<std::int32_t>((pTile % mTilesX) * TILE_SIZE);
+        std::int32_t lTileMinY = static_cast<std::int32_t>((pTile / mTilesX) * TILE_SIZE);
+        std::int32_t lTileMaxX = std::min<std::int32_t>(lTileMinX + TILE_SIZE,
+            mTarget.GetWidth()) - 1;
+        std::int32_t lTileMaxY = std::min<std::int32_t>(lTileMinY + TILE_SIZE,
+            mTarget.GetHeight()) - 1;
+
+        for (std::size_t lChunk = 0; lChunk < lChunks; ++lChunk)
+        {
+            for (const auto& lIndex : mBins[lChunk * lTileCount + pTile])
+            {
+                const Triangle& lTriangle = mTriangles[lIndex];
+                RasterizeTriangle(
+                    lTriangle,
+                    std::max(lTriangle.mMinX, lTileMinX),
+                    std::max(lTriangle.mMinY, lTileMinY),
+                    std::min(lTriangle.mMaxX, lTileMaxX),
+                    std::min(lTriangle.mMaxY, lTileMaxY)
+                );
+            }
+        }
+    }
+
+    void SoftwareRasterizer::RasterizeTriangle (
+        const Triangle&     pTriangle,
+        const std::int32_t  pMinX,
+        const std::int32_t  pMinY,
+        const std::int32_t  pMaxX,
+        const std::int32_t  pMaxY
+    )
+    {
+        const auto& lA = pTriangle.mEdgeA;
+        const auto& lB = pTriangle.mEdgeB;
+        const auto& lC = pTriangle.mEdgeC;
+
+    #if defined(__SSE2__)
+
+        // Tiles start on a multiple of four pixels and framebuffer rows are
+        // padded to one, so stepping four pixels at a time from the aligned
+        // start column never leaves the row.
+        const std::int32_t lStartX = pMinX & ~3;
+        const __m128 lZero        = _mm_setzero_ps();
+        const __m128 lOne         = _mm_set1_ps(1.0f);
+        const __m128 lByteScale   = _mm_set1_ps(255.0f);
+        const __m128 lLaneOffsets = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+        const __m128i lLaneIndices = _mm_setr_epi32(0, 1, 2, 3);
+        const __m128i lMinXVector  = _mm_set1_epi32(pMinX - 1);
+        const __m128i lMaxXVector  = _mm_set1_epi32(pMaxX + 1);
+
+        __m128 lEdgeA[3], lInclusive[3];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lEdgeA[i]     = _mm_set1_ps(lA[i]);
+            lInclusive[i] = _mm_castsi128_ps(
+                _mm_set1_epi32(pTriangle.mInclusive[i] ? -1 : 0));
+        }
+
+        const __m128 lInverseArea = _mm_set1_ps(pTriangle.mInverseArea);
+        __m128 lDepth[3], lInverseW[3], lColor[3][4];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lDepth[i]      = _mm_set1_ps(pTriangle.mDepth[i]);
+            lInverseW[i]   = _mm_set1_ps(pTriangle.mInverseW[i]);
+            lColor[i][0]   = _mm_set1_ps(pTriangle.mColorOverW[i].mX);
+            lColor[i][1]   = _mm_set1_ps(pTriangle.mColorOverW[i].mY);
+            lColor[i][2]   = _mm_set1_ps(pTriangle.mColorOverW[i].mZ);
+            lColor[i][3]   = _mm_set1_ps(pTriangle.mColorOverW[i].mW);
+        }
+
+        for (std::int32_t y = pMinY; y <= pMaxY; ++y)
+        {
+            const float lPixelY = static_cast<float>(y) + 0.5f;
+            std::uint32_t* lColorRow = mTarget.GetColorRow(y);
+            float* lDepthRow = mTarget.GetDepthRow(y);
+
+            __m128 lRowBase[3];
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                lRowBase[i] = _mm_set1_ps(lB[i] * lPixelY + lC[i]);
+            }
+
+            for (std::int32_t x = lStartX; x <= pMaxX; x += 4)
+            {
+                // Evaluate each edge function directly at the four pixel
+                // centers, rather than stepping it, so that every pixel's edge
+                // values are exact regardless of where the span started.
+                __m128 lPixelX = _mm_add_ps(
+                    _mm_set1_ps(static_cast<float>(x)), lLaneOffsets);
+
+                __m128 lEdge[3];
+                __m128 lMask = _mm_castsi128_ps(_mm_and_si128(
+                    _mm_cmpgt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lLaneIndices), lMinXVector),
+                    _mm_cmplt_epi32(_mm_add_epi32(_mm_set1_epi32(x), lLaneIndices), lMaxXVector)
+                ));
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    lEdge[i] = _mm_add_ps(_mm_mul_ps(lEdgeA[i], lPixelX), lRowBase[i]);
+                    lMask = _mm_and_ps(lMask, _mm_or_ps(
+                        _mm_cmpgt_ps(lEdge[i], lZero),
+                        _mm_and_ps(_mm_cmpeq_ps(lEdge[i], lZero), lInclusive[i])
+                    ));
+                }
+
+                if (_mm_movemask_ps(lMask) == 0)
+                {
+                    continue;
+                }
+
+                // Depth is affine in screen space, so it is interpolated with
+                // the plain barycentric weights.
+                __m128 lWeight[3];
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    lWeight[i] = _mm_mul_ps(lEdge[i], lInverseArea);
+                }
+
+                __m128 lFragmentDepth = _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(lWeight[0], lDepth[0]),
+                        _mm_mul_ps(lWeight[1], lDepth[1])
+                    ),
+                    _mm_mul_ps(lWeight[2], lDepth[2])
+                );
+                lMask = _mm_and_ps(lMask, _mm_cmple_ps(lFragmentDepth, lOne));
+
+                __m128 lStoredDepth = _mm_loadu_ps(lDepthRow + x);
+                if (pTriangle.mDepthTest == true)
+                {
+                    lMask = _mm_and_ps(lMask, _mm_cmplt_ps(lFragmentDepth, lStoredDepth));
+                }
+
+                if (_mm_movemask_ps(lMask) == 0)
+                {
+                    continue;
+                }
+
+                // Colours are interpolated perspective-correctly: interpolate
+                // `colour / w` and `1 / w`, then divide the former by the
+                // latter.
+                __m128 lW = _mm_div_ps(lOne, _mm_add_ps(
+                    _mm_add_ps(
+                        _mm_mul_ps(lWeight[0], lInverseW[0]),
+                        _mm_mul_ps(lWeight[1], lInverseW[1])
+                    ),
+                    _mm_mul_ps(lWeight[2], lInverseW[2])
+                ));
+
+                __m128i lPixels = _mm_setzero_si128();
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    __m128 lChannel = _mm_mul_ps(_mm_add_ps(
+                        _mm_add_ps(
+                            _mm_mul_ps(lWeight[0], lColor[0][c]),
+                            _mm_mul_ps(lWeight[1], lColor[1][c])
+                        ),
+                        _mm_mul_ps(lWeight[2], lColor[2][c])
+                    ), lW);
+
+                    lChannel = _mm_min_ps(_mm_max_ps(lChannel, lZero), lOne);
+                    __m128i lByte = _mm_cvtps_epi32(_mm_mul_ps(lChannel, lByteScale));
+                    lPixels = _mm_or_si128(lPixels,
+                        _mm_sll_epi32(lByte, _mm_cvtsi32_si128(static_cast<int>(c * 8))));
+                }
+
+                // Blend the covered lanes into the framebuffer.
+                __m128i lMaskBits = _mm_castps_si128(lMask);
+                __m128i lStoredColor = _mm_loadu_si128(
+                    reinterpret_cast<const __m128i*>(lColorRow + x));
+                _mm_storeu_si128(
+                    reinterpret_cast<__m128i*>(lColorRow + x),
+                    _mm_or_si128(
+                        _mm_and_si128(lMaskBits, lPixels),
+                        _mm_andnot_si128(lMaskBits, lStoredColor)
+                    )
+                );
+
+                if (pTriangle.mDepthWrite == true)
+                {
+                    _mm_storeu_ps(lDepthRow + x, _mm_or_ps(
+                        _mm_and_ps(lMask, lFragmentDepth),
+                        _mm_andnot_ps(lMask, lStoredDepth)
+                    ));
+                }
+            }
+        }
+
+    #else
+
+        for (std::int32_t y = pMinY; y <= pMaxY; ++y)
+        {
+            const float lPixelY = static_cast<float>(y) + 0.5f;
+            std::uint32_t* lColorRow = mTarget.GetColorRow(y);
+            float* lDepthRow = mTarget.GetDepthRow(y);
+
+            for (std::int32_t x = pMinX; x <= pMaxX; ++x)
+            {
+                const float lPixelX = static_cast<float>(x) + 0.5f;
+
+                std::array<float, 3> lWeight;
+                bool lCovered = true;
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    float lEdge = lA[i] * lPixelX + (lB[i] * lPixelY + lC[i]);
+                    lCovered = lCovered && (lEdge > 0.0f ||
+                        (lEdge == 0.0f && pTriangle.mInclusive[i]));
+                    lWeight[i] = lEdge * pTriangle.mInverseArea;
+                }
+
+                if (lCovered == false)
+                {
+                    continue;
+                }
+
+                float lFragmentDepth =
+                    lWeight[0] * pTriangle.mDepth[0] +
+                    lWeight[1] * pTriangle.mDepth[1] +
+                    lWeight[2] * pTriangle.mDepth[2];
+                if (
+                    lFragmentDepth > 1.0f ||
+                    (pTriangle.mDepthTest == true && lFragmentDepth >= lDepthRow[x])
+                )
+                {
+                    continue;
+                }
+
+                float lW = 1.0f / (
+                    lWeight[0] * pTriangle.mInverseW[0] +
+                    lWeight[1] * pTriangle.mInverseW[1] +
+                    lWeight[2] * pTriangle.mInverseW[2]
+                );
+
+                lColorRow[x] = Framebuffer::PackColor((
+                    pTriangle.mColorOverW[0] * lWeight[0] +
+                    pTriangle.mColorOverW[1] * lWeight[1] +
+                    pTriangle.mColorOverW[2] * lWeight[2]
+                ) * lW);
+
+                if (pTriangle.mDepthWrite == true)
+                {
+                    lDepthRow[x] = lFragmentDepth;
+                }
+            }
+        }
+
+    #endif
+    }
+
+}
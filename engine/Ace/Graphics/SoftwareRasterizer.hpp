@@ -0,0 +1,254 @@
+/**
+ * @file    Ace/Graphics/SoftwareRasterizer.hpp
+ * @brief   Provides a tile-based, multithreaded triangle rasterizer which
+ *          renders into an in-memory framebuffer on the CPU.
+ */
+
+#pragma once
+#include <Ace/Graphics/Framebuffer.hpp>
+#include <Ace/Maths/Matrix4.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates which triangles, if any, are discarded based on the
+     *          direction they face.
+     */
+    enum class CullMode
+    {
+        None,       ///< @brief No triangles are culled.
+        Back,       ///< @brief Triangles wound clockwise in normalized device coordinates are culled.
+        Front       ///< @brief Triangles wound counter-clockwise in normalized device coordinates are culled.
+    };
+
+    /**
+     * @brief   A structure containing a single vertex submitted to the
+     *          @a `SoftwareRasterizer`.
+     */
+    struct RasterVertex
+    {
+        Vector3f    mPosition;  ///< @brief The vertex's model-space position.
+        Vector4f    mColor;     ///< @brief The vertex's RGBA colour.
+    };
+
+    /**
+     * @brief   A structure containing the fixed-function state which triangles
+     *          are rasterized with.
+     */
+    struct RasterState
+    {
+        CullMode    mCullMode   = CullMode::Back;   ///< @brief Which triangles to cull.
+        bool        mDepthTest  = true;             ///< @brief Discard pixels which are not nearer than the depth plane?
+        bool        mDepthWrite = true;             ///< @brief Write the depths of drawn pixels to the depth plane?
+    };
+
+    /**
+     * @brief   A tile-based, multithreaded triangle rasterizer, which renders
+     *          into an in-memory @a `Framebuffer` without any GPU.
+     *
+     * Triangles are transformed and set up as they are submitted. On
+     * @a `Flush`, they are binned into screen-space tiles, then the tiles are
+     * rasterized in parallel. Each tile is owned by exactly one thread, and
+     * draws its triangles in submission order, so the output is identical
+     * regardless of the number of threads used.
+     *
+     * Edge functions, depth testing and perspective-correct colour
+     * interpolation are evaluated four pixels at a time with SSE2 where
+     * available, falling back to scalar code elsewhere.
+     */
+    class ACE_API SoftwareRasterizer final
+    {
+    public:
+
+        /**
+         * @brief   The length of each side of a screen-space tile, in pixels.
+         */
+        static constexpr std::size_t TILE_SIZE = 64;
+
+        /**
+         * @brief   The number of triangles binned together by one thread.
+         */
+        static constexpr std::size_t BIN_CHUNK_SIZE = 1024;
+
+    public:
+
+        /**
+         * @brief   Constructs a rasterizer which renders into the given
+         *          framebuffer.
+         *
+         * @param   pTarget         The framebuffer to render into. It must
+         *                          outlive the rasterizer.
+         * @param   pThreadCount    The number of worker threads to rasterize
+         *                          tiles with.
+         */
+        explicit SoftwareRasterizer (
+            Framebuffer&    pTarget,
+            std::size_t     pThreadCount = std::thread::hardware_concurrency()
+        );
+
+    public:
+
+        /**
+         * @brief   Transforms, clips and sets up a list of indexed triangles,
+         *          queueing them to be rasterized on the next @a `Flush`.
+         *
+         * @param   pVertices   The triangles' vertices.
+         * @param   pIndices    Three vertex indices per triangle.
+         * @param   pTransform  The matrix transforming model-space positions
+         *                      into clip space.
+         * @param   pState      The state to rasterize the triangles with.
+         *
+         * @throw   `std::out_of_range` if an index is out of range.
+         */
+        void Submit (
+            const std::vector<RasterVertex>&    pVertices,
+            const std::vector<std::uint32_t>&   pIndices,
+            const Matrix4f&                     pTransform,
+            const RasterState&                  pState = {}
+        );
+
+        /**
+         * @brief   Bins and rasterizes all queued triangles into the target
+         *          framebuffer, then clears the queue.
+         */
+        void Flush ();
+
+        /**
+         * @brief   Retrieves the number of triangles queued for the next
+         *          @a `Flush`.
+         *
+         * @return  The number of queued triangles.
+         */
+        inline std::size_t GetPendingTriangleCount () const
+        {
+            return mTriangles.size();
+        }
+
+        /**
+         * @brief   Retrieves the framebuffer being rendered into.
+         *
+         * @return  A handle to the target framebuffer.
+         */
+        inline Framebuffer& GetTarget ()
+        {
+            return mTarget;
+        }
+
+    private:
+
+        /**
+         * @brief   A structure containing a vertex after it has been
+         *          transformed into clip space.
+         */
+        struct ClipVertex
+        {
+            Vector4f    mPosition;  ///< @brief The vertex's clip-space position.
+            Vector4f    mColor;     ///< @brief The vertex's RGBA colour.
+        };
+
+        /**
+         * @brief   A structure containing a triangle which has been set up in
+         *          screen space, ready to be rasterized.
+         *
+         * Edge `i` is the edge opposite vertex `i`, and is evaluated at a
+         * pixel center `(x, y)` as `A * x + B * y + C`. That value is positive
+         * inside the triangle, and proportional to vertex `i`'s barycentric
+         * weight.
+         */
+        struct Triangle
+        {
+            std::array<float, 3>    mEdgeA;         ///< @brief The edge functions' X coefficients.
+            std::array<float, 3>    mEdgeB;         ///< @brief The edge functions' Y coefficients.
+            std::array<float, 3>    mEdgeC;         ///< @brief The edge functions' constant terms.
+            std::array<bool, 3>     mInclusive;     ///< @brief Do pixel centers lying exactly on each edge belong to this triangle?
+            float                   mInverseArea;   ///< @brief Normalizes edge values into barycentric weights.
+            std::array<float, 3>    mDepth;         ///< @brief The vertices' window-space depths.
+            std::array<float, 3>    mInverseW;      ///< @brief The reciprocals of the vertices' clip-space W components.
+            std::array<Vector4f, 3> mColorOverW;    ///< @brief The vertices' colours, divided by their clip-space W components.
+            std::int32_t            mMinX;          ///< @brief The leftmost pixel column covered by the triangle's bounds.
+            std::int32_t            mMinY;          ///< @brief The topmost pixel row covered by the triangle's bounds.
+            std::int32_t            mMaxX;          ///< @brief The rightmost pixel column covered by the triangle's bounds.
+            std::int32_t            mMaxY;          ///< @brief The bottommost pixel row covered by the triangle's bounds.
+            bool                    mDepthTest;     ///< @brief Depth-test the triangle's pixels?
+            bool                    mDepthWrite;    ///< @brief Write the triangle's pixels' depths?
+        };
+
+    private:
+
+        /**
+         * @brief   Clips a triangle against the near plane, then sets up the
+         *          resulting one or two triangles for rasterization.
+         *
+         * @param   pVertices   The triangle's three clip-space vertices.
+         * @param   pState      The state to rasterize the triangle with.
+         */
+        void ClipAndSetup (
+            const std::array<ClipVertex, 3>&    pVertices,
+            const RasterState&                  pState
+        );
+
+        /**
+         * @brief   Projects a clipped triangle into screen space, culls it if
+         *          needed, and queues it for rasterization.
+         *
+         * @param   pVertices   The triangle's three clip-space vertices, all of
+         *                      which lie on or in front of the near plane.
+         * @param   pState      The state to rasterize the triangle with.
+         */
+        void Setup (
+            const std::array<ClipVertex, 3>&    pVertices,
+            const RasterState&                  pState
+        );
+
+        /**
+         * @brief   Bins a chunk of queued triangles into the tiles their
+         *          bounds overlap.
+         *
+         * @param   pChunk  The index of the chunk to bin.
+         */
+        void BinChunk (
+            const std::size_t&  pChunk
+        );
+
+        /**
+         * @brief   Rasterizes all triangles binned into the given tile, in
+         *          submission order.
+         *
+         * @param   pTile   The index of the tile to rasterize.
+         */
+        void RasterizeTile (
+            const std::size_t&  pTile
+        );
+
+        /**
+         * @brief   Rasterizes the part of a triangle which lies inside the
+         *          given pixel rectangle.
+         *
+         * @param   pTriangle   The triangle to rasterize.
+         * @param   pMinX       The leftmost column to rasterize.
+         * @param   pMinY       The topmost row to rasterize.
+         * @param   pMaxX       The rightmost column to rasterize.
+         * @param   pMaxY       The bottommost row to rasterize.
+         */
+        void RasterizeTriangle (
+            const Triangle&     pTriangle,
+            const std::int32_t  pMinX,
+            const std::int32_t  pMinY,
+            const std::int32_t  pMaxX,
+            const std::int32_t  pMaxY
+        );
+
+    private:
+        Framebuffer&                                mTarget;            ///< @brief The framebuffer being rendered into.
+        ThreadPool                                  mThreadPool;        ///< @brief The thread pool which bins and rasterizes tiles.
+        std::size_t                                 mTilesX = 0;        ///< @brief The number of tile columns covering the framebuffer.
+        std::size_t                                 mTilesY = 0;        ///< @brief The number of tile rows covering the framebuffer.
+        std::vector<ClipVertex>                     mClipVertices;      ///< @brief Scratch space for transformed vertices.
+        std::vector<Triangle>                       mTriangles;         ///< @brief The triangles queued for the next flush.
+        std::vector<std::vector<std::uint32_t>>     mBins;              ///< @brief The triangle indices binned per chunk, then per tile.
+
+    };
+
+}
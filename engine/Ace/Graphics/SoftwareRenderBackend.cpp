@@ -0,0 +1,98 @@
+/**
+ * @file    Ace/Graphics/SoftwareRenderBackend.cpp
+ */
+
+#include <Ace/Graphics/SoftwareRenderBackend.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    SoftwareRenderBackend::SoftwareRenderBackend (
+        const std::size_t&  pWidth,
+        const std::size_t&  pHeight,
+        std::size_t         pThreadCount
+    ) :
+        mFramebuffer    { pWidth, pHeight },
+        mRasterizer     { mFramebuffer, pThreadCount },
+        mClearColor     { 0.0f, 0.0f, 0.0f, 1.0f }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::uint32_t SoftwareRenderBackend::CreateGeometry (
+        std::vector<RasterVertex>   pVertices,
+        std::vector<std::uint32_t>  pIndices
+    )
+    {
+        mGeometries.emplace_back(std::move(pVertices), std::move(pIndices));
+        return static_cast<std::uint32_t>(mGeometries.size() - 1);
+    }
+
+    std::uint32_t SoftwareRenderBackend::CreateMaterial (
+        const RasterState&  pState
+    )
+    {
+        mMaterials.push_back(pState);
+        return static_cast<std::uint32_t>(mMaterials.size() - 1);
+    }
+
+    void SoftwareRenderBackend::BeginFrame ()
+    {
+        mFramebuffer.Clear(mClearColor);
+    }
+
+    void SoftwareRenderBackend::Draw (
+        const std::uint64_t&    pSortKey,
+        const DrawCommand&      pCommand
+    )
+    {
+        (void) pSortKey;
+
+        if (
+            pCommand.mGeometry >= mGeometries.size() ||
+            pCommand.mMaterial >= mMaterials.size()
+        )
+        {
+            ACE_THROW(
+                std::out_of_range,
+                "{}: Unknown geometry {} or material {}!",
+                "SoftwareRenderBackend", pCommand.mGeometry, pCommand.mMaterial
+            );
+        }
+
+        const Geometry& lGeometry = mGeometries[pCommand.mGeometry];
+        if (pCommand.mInstances == nullptr)
+        {
+            mRasterizer.Submit(
+                lGeometry.mVertices,
+                lGeometry.mIndices,
+                pCommand.mTransform,
+                mMaterials[pCommand.mMaterial]
+            );
+
+            return;
+        }
+
+        // Instance transforms are read straight from wherever the command
+        // points, without being copied.
+        for (std::uint32_t i = 0; i < pCommand.mInstanceCount; ++i)
+        {
+            mRasterizer.Submit(
+                lGeometry.mVertices,
+                lGeometry.mIndices,
+                pCommand.mTransform * pCommand.mInstances[i],
+                mMaterials[pCommand.mMaterial]
+            );
+        }
+    }
+
+    void SoftwareRenderBackend::EndFrame ()
+    {
+        mRasterizer.Flush();
+    }
+
+}
@@ -0,0 +1,126 @@
+/**
+ * @file    Ace/Graphics/SoftwareRenderBackend.hpp
+ * @brief   Provides a render backend which draws through the software
+ *          rasterizer.
+ */
+
+#pragma once
+#include <Ace/Graphics/IRenderBackend.hpp>
+#include <Ace/Graphics/SoftwareRasterizer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A render backend which draws commands through a
+     *          @a `SoftwareRasterizer`, into a framebuffer which it owns.
+     *
+     * Geometry handles refer to indexed triangle lists, and material handles
+     * refer to raster states, both registered with this backend up front.
+     */
+    class ACE_API SoftwareRenderBackend final : public IRenderBackend
+    {
+    public:
+
+        /**
+         * @brief   Constructs a backend rendering into a framebuffer of the
+         *          given dimensions.
+         *
+         * @param   pWidth          The framebuffer's width, in pixels.
+         * @param   pHeight         The framebuffer's height, in pixels.
+         * @param   pThreadCount    The number of worker threads to rasterize
+         *                          with.
+         */
+        SoftwareRenderBackend (
+            const std::size_t&  pWidth,
+            const std::size_t&  pHeight,
+            std::size_t         pThreadCount = std::thread::hardware_concurrency()
+        );
+
+    public:
+
+        /**
+         * @brief   Registers an indexed triangle list which draw commands may
+         *          refer to.
+         *
+         * @param   pVertices   The geometry's vertices.
+         * @param   pIndices    Three vertex indices per triangle.
+         *
+         * @return  The geometry's handle.
+         */
+        std::uint32_t CreateGeometry (
+            std::vector<RasterVertex>   pVertices,
+            std::vector<std::uint32_t>  pIndices
+        );
+
+        /**
+         * @brief   Registers a raster state which draw commands may refer to
+         *          as their material.
+         *
+         * @param   pState  The raster state.
+         *
+         * @return  The material's handle.
+         */
+        std::uint32_t CreateMaterial (
+            const RasterState&  pState
+        );
+
+        /**
+         * @brief   Sets the colour the framebuffer is cleared to at the start
+         *          of each frame.
+         *
+         * @param   pColor  The clear colour.
+         */
+        inline void SetClearColor (
+            const Vector4f& pColor
+        )
+        {
+            mClearColor = pColor;
+        }
+
+        /**
+         * @brief   Retrieves the framebuffer being rendered into.
+         *
+         * @return  A handle to the framebuffer.
+         */
+        inline Framebuffer& GetFramebuffer ()
+        {
+            return mFramebuffer;
+        }
+
+    public:
+
+        void BeginFrame () override;
+
+        /**
+         * @throw   `std::out_of_range` if the command's geometry or material
+         *          handle was not issued by this backend.
+         */
+        void Draw (
+            const std::uint64_t&    pSortKey,
+            const DrawCommand&      pCommand
+        ) override;
+
+        void EndFrame () override;
+
+    private:
+
+        /**
+         * @brief   A structure containing a registered triangle list.
+         */
+        struct Geometry
+        {
+            std::vector<RasterVertex>   mVertices;  ///< @brief The geometry's vertices.
+            std::vector<std::uint32_t>  mIndices;   ///< @brief The geometry's triangle indices.
+        };
+
+    private:
+        Framebuffer                 mFramebuffer;   ///< @brief The framebuffer being rendered into.
+        SoftwareRasterizer          mRasterizer;    ///< @brief The rasterizer drawing into the framebuffer.
+        Vector4f                    mClearColor;    ///< @brief The colour the framebuffer is cleared to each frame.
+        std::vector<Geometry>       mGeometries;    ///< @brief The registered geometries, indexed by handle.
+        std::vector<RasterState>    mMaterials;     ///< @brief The registered materials, indexed by handle.
+
+    };
+
+}
@@ -0,0 +1,136 @@
+/**
+ * @file    Ace/Graphics/StagingRing.cpp
+ */
+
+#include <Ace/Graphics/StagingRing.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    StagingRing::StagingRing (
+        const std::size_t&  pCapacity
+    ) :
+        mCapacity { pCapacity }
+    {
+        if (
+            pCapacity < MAX_ALIGNMENT ||
+            (pCapacity & (pCapacity - 1)) != 0
+        )
+        {
+            ACE_THROW(
+                std::invalid_argument,
+                "{}: Capacity {} is not a power of two of at least {} bytes!",
+                "StagingRing", pCapacity, MAX_ALIGNMENT
+            );
+        }
+
+        mArena.resize(pCapacity / MAX_ALIGNMENT);
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::span<std::byte> StagingRing::ReserveBytes (
+        const std::size_t&  pSize,
+        const std::size_t&  pAlignment
+    )
+    {
+        if (
+            pAlignment == 0 ||
+            pAlignment > MAX_ALIGNMENT ||
+            (pAlignment & (pAlignment - 1)) != 0
+        )
+        {
+            ACE_THROW(
+                std::invalid_argument,
+                "{}: Alignment {} is not a power of two of at most {} bytes!",
+                "StagingRing", pAlignment, MAX_ALIGNMENT
+            );
+        }
+        else if (pSize > mCapacity)
+        {
+            ACE_THROW(
+                std::invalid_argument,
+                "{}: Reservation of {} bytes exceeds the capacity of {} bytes!",
+                "StagingRing", pSize, mCapacity
+            );
+        }
+        else if (pSize == 0)
+        {
+            return {};
+        }
+
+        // The head and tail are monotonic byte positions; masking a position
+        // by the capacity yields its offset into the arena.
+        const std::size_t MASK = mCapacity - 1;
+
+        std::size_t lHead = mHead.load(std::memory_order_relaxed);
+        while (true)
+        {
+            // Align the reservation's start. If the reservation would then run
+            // past the end of the arena, skip ahead to its beginning instead.
+            std::size_t lStart  = (lHead + pAlignment - 1) & ~(pAlignment - 1);
+            std::size_t lOffset = lStart & MASK;
+            if (lOffset + pSize > mCapacity)
+            {
+                lStart += mCapacity - lOffset;
+                lOffset = 0;
+            }
+
+            // Make sure the reservation does not overrun data which has not
+            // been reclaimed yet.
+            std::size_t lEnd = lStart + pSize;
+            if (lEnd - mTail.load(std::memory_order_acquire) > mCapacity)
+            {
+                return {};
+            }
+
+            // Claim the range by advancing the head past it. If another
+            // writer advanced the head first, `lHead` is refreshed; try again.
+            if (
+                mHead.compare_exchange_weak(lHead, lEnd,
+                    std::memory_order_acq_rel, std::memory_order_relaxed)
+            )
+            {
+                auto lBytes = reinterpret_cast<std::byte*>(mArena.data());
+                return { lBytes + lOffset, pSize };
+            }
+        }
+    }
+
+    std::uint64_t StagingRing::InsertFence ()
+    {
+        std::lock_guard lGuard { mFenceMutex };
+
+        Fence lFence { mNextFence++, mHead.load(std::memory_order_acquire) };
+        mPendingFences.push(lFence);
+        return lFence.mValue;
+    }
+
+    void StagingRing::SignalFence (
+        const std::uint64_t&    pFence
+    )
+    {
+        std::lock_guard lGuard { mFenceMutex };
+
+        // Retire every pending fence up to and including the signalled one,
+        // then reclaim everything reserved before the last of them.
+        std::optional<Fence> lRetired;
+        while (
+            mPendingFences.empty() == false &&
+            mPendingFences.front().mValue <= pFence
+        )
+        {
+            lRetired = mPendingFences.front();
+            mPendingFences.pop();
+        }
+
+        if (lRetired.has_value() == true)
+        {
+            mTail.store(lRetired->mPosition, std::memory_order_release);
+            mCompletedFence.store(lRetired->mValue, std::memory_order_release);
+        }
+    }
+
+}
@@ -0,0 +1,205 @@
+/**
+ * @file    Ace/Graphics/StagingRing.hpp
+ * @brief   Provides a persistently-allocated ring arena into which per-frame
+ *          data, such as instance transforms, is staged for a render backend.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A persistently-allocated ring arena into which worker threads
+     *          write per-frame data, such as instance transforms, in place for
+     *          a render backend to read.
+     *
+     * Reservations are variable-sized byte ranges, claimed lock-free by
+     * advancing an atomic head position, much like slots are claimed in a
+     * @a `RingBuffer`. A reservation never straddles the end of the arena;
+     * if one would, the remainder of the arena is skipped and the reservation
+     * starts back at the beginning.
+     *
+     * Memory is reclaimed with fences. Once a frame's data is written,
+     * @a `InsertFence` marks the current head position, and once the backend
+     * is done reading that frame's data, @a `SignalFence` frees everything
+     * reserved before that fence. A synchronous, CPU-side backend can signal
+     * each fence as soon as its frame is submitted; a backend with frames in
+     * flight signals them as they retire.
+     */
+    class ACE_API StagingRing final
+    {
+    public:
+
+        /**
+         * @brief   The largest alignment a reservation may request, and the
+         *          alignment of the arena itself.
+         */
+        static constexpr std::size_t MAX_ALIGNMENT = 64;
+
+    public:
+
+        /**
+         * @brief   Constructs a staging ring with an arena of the given size.
+         *
+         * @param   pCapacity   The size of the arena, in bytes. Must be a
+         *                      power of two, and at least @a `MAX_ALIGNMENT`.
+         *
+         * @throw   `std::invalid_argument` if the capacity is invalid.
+         */
+        explicit StagingRing (
+            const std::size_t&  pCapacity
+        );
+
+    public:
+
+        /**
+         * @brief   Attempts to reserve a range of bytes in the arena.
+         *
+         * This method is lock-free, and may be called from any thread.
+         *
+         * @param   pSize       The number of bytes to reserve.
+         * @param   pAlignment  The alignment of the range. Must be a power of
+         *                      two, no larger than @a `MAX_ALIGNMENT`.
+         *
+         * @return  The reserved range, or an empty range if there is not
+         *          enough unreclaimed space in the arena.
+         *
+         * @throw   `std::invalid_argument` if the size exceeds the arena's
+         *          capacity, or the alignment is invalid.
+         */
+        std::span<std::byte> ReserveBytes (
+            const std::size_t&  pSize,
+            const std::size_t&  pAlignment = alignof(std::max_align_t)
+        );
+
+        /**
+         * @brief   Attempts to reserve room for an array of objects in the
+         *          arena, so they can be constructed in place.
+         *
+         * This method is lock-free, and may be called from any thread.
+         *
+         * @tparam  T       The type of object to reserve room for.
+         *
+         * @param   pCount  The number of objects to reserve room for.
+         *
+         * @return  The reserved array, or an empty array if there is not
+         *          enough unreclaimed space in the arena.
+         */
+        template <typename T>
+            requires std::is_trivially_copyable_v<T> &&
+                std::is_trivially_destructible_v<T> &&
+                (alignof(T) <= MAX_ALIGNMENT)
+        inline std::span<T> Reserve (
+            const std::size_t&  pCount
+        )
+        {
+            auto lBytes = ReserveBytes(pCount * sizeof(T), alignof(T));
+            if (lBytes.empty() == true)
+            {
+                return {};
+            }
+
+            return { reinterpret_cast<T*>(lBytes.data()), pCount };
+        }
+
+        /**
+         * @brief   Marks the end of the data reserved so far, returning a
+         *          fence which frees that data once signalled.
+         *
+         * All writes into the data being fenced must be complete before this
+         * method is called.
+         *
+         * @return  The new fence's value. Fence values increase monotonically,
+         *          starting from one.
+         */
+        std::uint64_t InsertFence ();
+
+        /**
+         * @brief   Signals that the backend is done reading the data reserved
+         *          before the given fence, and all earlier fences, freeing that
+         *          data for reuse.
+         *
+         * @param   pFence  The value of the fence to signal.
+         */
+        void SignalFence (
+            const std::uint64_t&    pFence
+        );
+
+        /**
+         * @brief   Retrieves the value of the most recently signalled fence.
+         *
+         * @return  The most recently signalled fence's value, or zero if no
+         *          fence has been signalled.
+         */
+        inline std::uint64_t GetCompletedFence () const
+        {
+            return mCompletedFence.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief   Retrieves the size of the arena.
+         *
+         * @return  The size of the arena, in bytes.
+         */
+        inline std::size_t GetCapacity () const
+        {
+            return mCapacity;
+        }
+
+        /**
+         * @brief   Retrieves the number of bytes which are reserved and not
+         *          yet reclaimed, including any bytes skipped for alignment or
+         *          at the end of the arena.
+         *
+         * @return  The number of bytes in use.
+         */
+        inline std::size_t GetUsedBytes () const
+        {
+            return
+                mHead.load(std::memory_order_acquire) -
+                mTail.load(std::memory_order_acquire);
+        }
+
+    private:
+        StagingRing (const StagingRing&) = delete;
+        StagingRing (StagingRing&&) = delete;
+        void operator= (const StagingRing&) = delete;
+        void operator= (StagingRing&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A helper structure representing one maximally-aligned block
+         *          of the arena.
+         */
+        struct alignas(MAX_ALIGNMENT) Block
+        {
+            std::byte   mBytes[MAX_ALIGNMENT];  ///< @brief The block's bytes.
+        };
+
+        /**
+         * @brief   A helper structure pairing a fence with the head position
+         *          it marks.
+         */
+        struct Fence
+        {
+            std::uint64_t   mValue = 0;     ///< @brief The fence's value.
+            std::size_t     mPosition = 0;  ///< @brief The head position at the time the fence was inserted.
+        };
+
+    private:
+                    std::size_t                 mCapacity = 0;          ///< @brief The size of the arena, in bytes.
+                    std::vector<Block>          mArena;                 ///< @brief The arena's storage.
+                    std::mutex                  mFenceMutex;            ///< @brief The mutex used for locking down the pending fence queue.
+                    std::queue<Fence>           mPendingFences;         ///< @brief The fences inserted but not yet signalled, in insertion order.
+                    std::uint64_t               mNextFence = 1;         ///< @brief The value of the next fence to be inserted.
+                    std::atomic<std::uint64_t>  mCompletedFence { 0 };  ///< @brief The value of the most recently signalled fence.
+        alignas(64) std::atomic<std::size_t>    mHead { 0 };            ///< @brief The arena's head position, atomically advanced by writers to reserve a range.
+        alignas(64) std::atomic<std::size_t>    mTail { 0 };            ///< @brief The arena's tail position, advanced as fences are signalled to reclaim ranges.
+
+    };
+
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    Ace/Graphics/StreamedMesh.cpp
+ */
+
+#include <Ace/Graphics/StreamedMesh.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    StreamedMesh::StreamedMesh (
+        std::vector<std::string>    pLevelPaths
+    ) :
+        mLevelPaths { std::move(pLevelPaths) }
+    {
+        if (mLevelPaths.empty() == true)
+        {
+            ACE_THROW(std::invalid_argument, "{}: A mesh needs at least one level of detail!",
+                "StreamedMesh");
+        }
+
+        const std::size_t lCoarsest = mLevelPaths.size() - 1;
+        mBase = AssetRegistry::Load<Mesh>(mLevelPaths.back());
+        if (mBase.IsValid() == false || mBase->HasLod(lCoarsest) == false)
+        {
+            ACE_THROW(std::runtime_error, "{}: Could not load level of detail {} from '{}'!",
+                "StreamedMesh", lCoarsest, mLevelPaths.back());
+        }
+        else if (mBase->GetLods().size() != mLevelPaths.size())
+        {
+            ACE_THROW(std::runtime_error, "{}: '{}' has {} levels of detail, but {} paths were given!",
+                "StreamedMesh", mLevelPaths.back(), mBase->GetLods().size(), mLevelPaths.size());
+        }
+
+        mDetailLevel = lCoarsest;
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::size_t StreamedMesh::Select (
+        const Matrix4f& pModelView,
+        const Matrix4f& pProjection,
+        const float     pViewportHeight,
+        const float     pMaxPixelError
+    )
+    {
+        // Take in a level which has finished streaming.
+        if (
+            mPending.valid() == true &&
+            mPending.wait_for(std::chrono::seconds { 0 }) == std::future_status::ready
+        )
+        {
+            AssetHandle<Mesh> lLoaded = mPending.get();
+            if (lLoaded.IsValid() == true && lLoaded->HasLod(mPendingLevel) == true)
+            {
+                mDetail = std::move(lLoaded);
+                mDetailLevel = mPendingLevel;
+            }
+            else
+            {
+                mUnavailable |= 1u << mPendingLevel;
+            }
+        }
+
+        const std::size_t lCoarsest = mLevelPaths.size() - 1;
+        const std::size_t lWanted = mBase->SelectLod(pModelView, pProjection, pViewportHeight, pMaxPixelError);
+        if (lWanted == lCoarsest)
+        {
+            mDetail = {};
+            mDetailLevel = lCoarsest;
+        }
+        else if (
+            lWanted < mDetailLevel &&
+            mPending.valid() == false &&
+            (mUnavailable & (1u << lWanted)) == 0
+        )
+        {
+            mPending = AssetRegistry::LoadAsync<Mesh>(mLevelPaths[lWanted]);
+            mPendingLevel = lWanted;
+        }
+
+        return std::max(lWanted, mDetailLevel);
+    }
+
+}
@@ -0,0 +1,112 @@
+/**
+ * @file    Ace/Graphics/StreamedMesh.hpp
+ * @brief   Provides a class which streams a mesh's finer levels of detail in
+ *          through the asset registry, as the view calls for them.
+ */
+
+#pragma once
+#include <Ace/Graphics/Mesh.hpp>
+#include <Ace/System/AssetRegistry.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class which draws a mesh from its coarsest level of detail at
+     *          first, and streams finer ones in through the
+     *          @a `AssetRegistry` as the view calls for them.
+     *
+     * Each level has a blob of its own, as written by
+     * @a `MeshCooker::ExtractLod`, holding that level and every coarser one.
+     * The coarsest blob is loaded up front, and its level of detail table
+     * decides which level each view wants. A finer level is loaded in the
+     * background once it is wanted, and the finest resident level is drawn
+     * meanwhile; when only the coarsest is wanted again, the finer blob is
+     * let go. The registry shares what it loads, so every instance of a
+     * mesh shares one copy of each level.
+     *
+     * An instance is meant to be used from one thread at a time.
+     */
+    class ACE_API StreamedMesh final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a streamed mesh, loading its coarsest level.
+         *
+         * @param   pLevelPaths The logical path of each level's blob, finest
+         *                      first.
+         *
+         * @throw   `std::invalid_argument` if no paths are given.
+         * @throw   `std::runtime_error` if the coarsest blob cannot be
+         *          loaded, does not hold its level, or has a different number
+         *          of levels than there are paths.
+         */
+        explicit StreamedMesh (
+            std::vector<std::string>    pLevelPaths
+        );
+
+    public:
+
+        /**
+         * @brief   Picks the level of detail to draw for the given view, and
+         *          starts streaming in a finer one if the view calls for it.
+         *
+         * @param   pModelView      The matrix from model space to view
+         *                          space.
+         * @param   pProjection     The projection matrix.
+         * @param   pViewportHeight The height of the viewport, in pixels.
+         * @param   pMaxPixelError  The most error to allow, in pixels.
+         *
+         * @return  The level to draw from @a `GetMesh`: the one wanted, if it
+         *          is resident, or else the finest one which is.
+         */
+        std::size_t Select (
+            const Matrix4f& pModelView,
+            const Matrix4f& pProjection,
+            const float     pViewportHeight,
+            const float     pMaxPixelError
+        );
+
+        /**
+         * @brief   Retrieves the blob holding the finest resident level.
+         *
+         * @return  The mesh.
+         */
+        inline const Mesh& GetMesh () const
+        {
+            return (mDetail.IsValid() == true) ? *mDetail : *mBase;
+        }
+
+        /**
+         * @brief   Retrieves the finest level of detail which is resident.
+         *
+         * @return  The level.
+         */
+        inline std::size_t GetResidentLevel () const
+        {
+            return mDetailLevel;
+        }
+
+        /**
+         * @brief   Retrieves whether a finer level is being streamed in.
+         *
+         * @return  `true` if a level is loading; `false` otherwise.
+         */
+        inline bool IsStreaming () const
+        {
+            return mPending.valid();
+        }
+
+    private:
+        std::vector<std::string>            mLevelPaths;            ///< @brief The logical path of each level's blob, finest first.
+        AssetHandle<Mesh>                   mBase;                  ///< @brief The blob holding the coarsest level.
+        AssetHandle<Mesh>                   mDetail;                ///< @brief The blob holding a finer level, if one is resident.
+        std::size_t                         mDetailLevel = 0;       ///< @brief The finest resident level.
+        std::future<AssetHandle<Mesh>>      mPending;               ///< @brief The blob being streamed in, if any.
+        std::size_t                         mPendingLevel = 0;      ///< @brief The level being streamed in.
+        std::uint32_t                       mUnavailable = 0;       ///< @brief A bit for each level whose blob failed to load, so that it is not asked for again.
+
+    };
+
+}
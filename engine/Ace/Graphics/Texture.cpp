@@ -0,0 +1,511 @@
+/**
+ * @file    Ace/Graphics/Texture.cpp
+ */
+
+#include <Ace/Graphics/Texture.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Structures ******************************************************/
+
+    /**
+     * @brief   A structure containing the tables used to move 8-bit sRGB
+     *          values in and out of linear space.
+     */
+    struct SrgbTables
+    {
+        static constexpr std::size_t ENCODE_SIZE = 4096;
+
+        std::array<float, 256>                  mDecode {};     ///< @brief Each 8-bit sRGB value, in linear space.
+        std::array<std::uint8_t, ENCODE_SIZE>   mEncode {};     ///< @brief The 8-bit sRGB value nearest each step of linear space.
+
+        SrgbTables ()
+        {
+            for (std::size_t i = 0; i < mDecode.size(); ++i)
+            {
+                const float lValue = static_cast<float>(i) / 255.0f;
+                mDecode[i] = (lValue <= 0.04045f) ?
+                    lValue / 12.92f :
+                    std::pow((lValue + 0.055f) / 1.055f, 2.4f);
+            }
+
+            for (std::size_t i = 0; i < mEncode.size(); ++i)
+            {
+                const float lValue = (static_cast<float>(i) + 0.5f) / static_cast<float>(ENCODE_SIZE);
+                const float lEncoded = (lValue <= 0.0031308f) ?
+                    lValue * 12.92f :
+                    1.055f * std::pow(lValue, 1.0f / 2.4f) - 0.055f;
+                mEncode[i] = static_cast<std::uint8_t>(std::clamp(lEncoded * 255.0f + 0.5f, 0.0f, 255.0f));
+            }
+        }
+
+        inline std::uint8_t Encode (const float pLinear) const
+        {
+            const auto lIndex = static_cast<std::size_t>(std::clamp(pLinear, 0.0f, 1.0f) * ENCODE_SIZE);
+            return mEncode[std::min(lIndex, ENCODE_SIZE - 1)];
+        }
+
+        static const SrgbTables& Get ()
+        {
+            static const SrgbTables sTables;
+            return sTables;
+        }
+    };
+
+    /* Helper Functions *******************************************************/
+
+    //
+    // The serialized form is little-endian throughout:
+    //
+    // | Size | Field                                                         |
+    // |------|---------------------------------------------------------------|
+    // | 4    | The magic number, `ATEX`.                                     |
+    // | 2    | The cooked version.                                           |
+    // | 1    | The format.                                                   |
+    // | 1    | `1` if the colour is sRGB-encoded; `0` otherwise.             |
+    // | 4    | The mip count, then each mip's width (4 bytes), height        |
+    // |      | (4 bytes) and data, whose size follows from the other two.    |
+    //
+    static constexpr std::uint8_t TEXTURE_MAGIC[4] = { 'A', 'T', 'E', 'X' };
+
+    static void WriteU32 (
+        astd::byte_buffer&  pOut,
+        const std::uint32_t pValue
+    )
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            pOut.push_back(static_cast<std::uint8_t>(pValue >> (i * 8)));
+        }
+    }
+
+    /**
+     * @brief   Reads a little-endian value from a byte span, throwing if the
+     *          span runs out.
+     */
+    static std::uint32_t ReadLittleEndian (
+        std::span<const std::uint8_t>   pIn,
+        std::size_t&                    pOffset,
+        const std::size_t               pBytes
+    )
+    {
+        if (pBytes > pIn.size() - pOffset)
+        {
+            ACE_THROW(std::runtime_error, "{}: Cooked texture is truncated!",
+                "Texture");
+        }
+
+        std::uint32_t lValue = 0;
+        for (std::size_t i = 0; i < pBytes; ++i)
+        {
+            lValue |= static_cast<std::uint32_t>(pIn[pOffset++]) << (i * 8);
+        }
+
+        return lValue;
+    }
+
+    /* Public Methods *********************************************************/
+
+    astd::byte_buffer Texture::Serialize () const
+    {
+        std::size_t lSize = 12;
+        for (const TextureMip& lMip : mMips)
+        {
+            lSize += 8 + lMip.mData.size();
+        }
+
+        astd::byte_buffer lOut;
+        lOut.reserve(lSize);
+        lOut.insert(lOut.end(), std::begin(TEXTURE_MAGIC), std::end(TEXTURE_MAGIC));
+        lOut.push_back(static_cast<std::uint8_t>(COOKED_VERSION));
+        lOut.push_back(static_cast<std::uint8_t>(COOKED_VERSION >> 8));
+        lOut.push_back(static_cast<std::uint8_t>(mFormat));
+        lOut.push_back((mSrgb == true) ? 1 : 0);
+
+        WriteU32(lOut, static_cast<std::uint32_t>(mMips.size()));
+        for (const TextureMip& lMip : mMips)
+        {
+            WriteU32(lOut, lMip.mWidth);
+            WriteU32(lOut, lMip.mHeight);
+            lOut.insert(lOut.end(), lMip.mData.begin(), lMip.mData.end());
+        }
+
+        return lOut;
+    }
+
+    std::shared_ptr<Texture> Texture::Deserialize (
+        std::span<const std::uint8_t>   pData
+    )
+    {
+        std::size_t lOffset = 0;
+        for (const std::uint8_t lByte : TEXTURE_MAGIC)
+        {
+            if (ReadLittleEndian(pData, lOffset, 1) != lByte)
+            {
+                ACE_THROW(std::runtime_error, "{}: Data is not a cooked texture!",
+                    "Texture");
+            }
+        }
+
+        const std::uint32_t lVersion = ReadLittleEndian(pData, lOffset, 2);
+        if (lVersion != COOKED_VERSION)
+        {
+            ACE_THROW(std::runtime_error, "{}: Cooked version {} is not supported!",
+                "Texture", lVersion);
+        }
+
+        auto lTexture = std::make_shared<Texture>();
+        const std::uint32_t lFormat = ReadLittleEndian(pData, lOffset, 1);
+        if (lFormat > static_cast<std::uint32_t>(TextureFormat::BC7))
+        {
+            ACE_THROW(std::runtime_error, "{}: Format {} is not known!",
+                "Texture", lFormat);
+        }
+
+        lTexture->mFormat = static_cast<TextureFormat>(lFormat);
+        lTexture->mSrgb = (ReadLittleEndian(pData, lOffset, 1) != 0);
+
+        const std::uint32_t lMipCount = ReadLittleEndian(pData, lOffset, 4);
+        if (lMipCount > 32)
+        {
+            ACE_THROW(std::runtime_error, "{}: {} mips is too many!",
+                "Texture", lMipCount);
+        }
+
+        lTexture->mMips.resize(lMipCount);
+        for (TextureMip& lMip : lTexture->mMips)
+        {
+            lMip.mWidth = ReadLittleEndian(pData, lOffset, 4);
+            lMip.mHeight = ReadLittleEndian(pData, lOffset, 4);
+            if (
+                lMip.mWidth == 0 || lMip.mWidth > MAX_DIMENSION ||
+                lMip.mHeight == 0 || lMip.mHeight > MAX_DIMENSION
+            )
+            {
+                ACE_THROW(std::runtime_error, "{}: A {}x{} mip is not a valid size!",
+                    "Texture", lMip.mWidth, lMip.mHeight);
+            }
+
+            const std::size_t lSize = GetMipSize(lTexture->mFormat, lMip.mWidth, lMip.mHeight);
+            if (lSize > pData.size() - lOffset)
+            {
+                ACE_THROW(std::runtime_error, "{}: Cooked texture is truncated!",
+                    "Texture");
+            }
+
+            lMip.mData.assign(pData.begin() + lOffset, pData.begin() + lOffset + lSize);
+            lOffset += lSize;
+        }
+
+        if (lOffset != pData.size())
+        {
+            ACE_THROW(std::runtime_error, "{}: Cooked texture has trailing data!",
+                "Texture");
+        }
+
+        return lTexture;
+    }
+
+    void TextureConversion::ExpandRGBToRGBA (
+        const std::uint8_t* pSource,
+        std::uint8_t*       pDestination,
+        const std::size_t   pPixelCount
+    )
+    {
+        std::size_t i = 0;
+
+        #if defined(__SSE2__)
+        {
+            // Each pixel is read as four bytes, the fourth belonging to the
+            // next pixel and then overwritten with alpha, so the last pixel is
+            // left to the scalar loop.
+            const __m128i lAlpha = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+            for (; i + 5 <= pPixelCount; i += 4)
+            {
+                std::array<std::int32_t, 4> lWords;
+                std::memcpy(&lWords[0], pSource + i * 3, 4);
+                std::memcpy(&lWords[1], pSource + i * 3 + 3, 4);
+                std::memcpy(&lWords[2], pSource + i * 3 + 6, 4);
+                std::memcpy(&lWords[3], pSource + i * 3 + 9, 4);
+
+                const __m128i lPixels = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lWords.data()));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(pDestination + i * 4), _mm_or_si128(lPixels, lAlpha));
+            }
+        }
+        #endif
+
+        for (; i < pPixelCount; ++i)
+        {
+            pDestination[i * 4] = pSource[i * 3];
+            pDestination[i * 4 + 1] = pSource[i * 3 + 1];
+            pDestination[i * 4 + 2] = pSource[i * 3 + 2];
+            pDestination[i * 4 + 3] = 0xFF;
+        }
+    }
+
+    void TextureConversion::SwizzleBGRAToRGBA (
+        std::uint8_t*       pPixels,
+        const std::size_t   pPixelCount
+    )
+    {
+        std::size_t i = 0;
+
+        #if defined(__SSE2__)
+        {
+            // Green and alpha stay put; red and blue trade places within each
+            // 32-bit pixel.
+            const __m128i lKeep = _mm_set1_epi32(static_cast<int>(0xFF00FF00u));
+            const __m128i lLow = _mm_set1_epi32(0x000000FF);
+            for (; i + 4 <= pPixelCount; i += 4)
+            {
+                auto* lAddress = reinterpret_cast<__m128i*>(pPixels + i * 4);
+                const __m128i lPixels = _mm_loadu_si128(lAddress);
+                const __m128i lSwapped = _mm_or_si128(
+                    _mm_and_si128(lPixels, lKeep),
+                    _mm_or_si128(
+                        _mm_and_si128(_mm_srli_epi32(lPixels, 16), lLow),
+                        _mm_slli_epi32(_mm_and_si128(lPixels, lLow), 16)
+                    )
+                );
+                _mm_storeu_si128(lAddress, lSwapped);
+            }
+        }
+        #endif
+
+        for (; i < pPixelCount; ++i)
+        {
+            std::swap(pPixels[i * 4], pPixels[i * 4 + 2]);
+        }
+    }
+
+    void TextureConversion::ConvertToLinear (
+        Texture&            pTexture,
+        ThreadPool*         pThreadPool,
+        const std::size_t   pRowsPerJob
+    )
+    {
+        if (pTexture.mFormat != TextureFormat::RGBA8)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Only RGBA8 textures can be converted to linear!",
+                "TextureConversion");
+        }
+
+        const SrgbTables& lTables = SrgbTables::Get();
+        const bool lSrgb = pTexture.mSrgb;
+        for (TextureMip& lMip : pTexture.mMips)
+        {
+            astd::byte_buffer lLinear(Texture::GetMipSize(TextureFormat::RGBA32F, lMip.mWidth, lMip.mHeight));
+            const std::uint8_t* lSource = lMip.mData.data();
+            auto* lDestination = reinterpret_cast<float*>(lLinear.data());
+            const std::size_t lWidth = lMip.mWidth;
+
+            ForEachRows(lMip.mHeight, pThreadPool, pRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    for (std::size_t p = pBegin * lWidth; p < pEnd * lWidth; ++p)
+                    {
+                        const std::uint8_t* lPixel = lSource + p * 4;
+                        const float lR = lSrgb ? lTables.mDecode[lPixel[0]] : lPixel[0] * (1.0f / 255.0f);
+                        const float lG = lSrgb ? lTables.mDecode[lPixel[1]] : lPixel[1] * (1.0f / 255.0f);
+                        const float lB = lSrgb ? lTables.mDecode[lPixel[2]] : lPixel[2] * (1.0f / 255.0f);
+
+                        #if defined(__SSE2__)
+                            const __m128 lColor = _mm_mul_ps(
+                                _mm_setr_ps(lR, lG, lB, static_cast<float>(lPixel[3])),
+                                _mm_setr_ps(1.0f, 1.0f, 1.0f, 1.0f / 255.0f)
+                            );
+                            _mm_storeu_ps(lDestination + p * 4, lColor);
+                        #else
+                            lDestination[p * 4] = lR;
+                            lDestination[p * 4 + 1] = lG;
+                            lDestination[p * 4 + 2] = lB;
+                            lDestination[p * 4 + 3] = lPixel[3] * (1.0f / 255.0f);
+                        #endif
+                    }
+                });
+
+            lMip.mData = std::move(lLinear);
+        }
+
+        pTexture.mFormat = TextureFormat::RGBA32F;
+        pTexture.mSrgb = false;
+    }
+
+    void TextureConversion::GenerateMips (
+        Texture&            pTexture,
+        ThreadPool*         pThreadPool,
+        const std::size_t   pRowsPerJob
+    )
+    {
+        if (Texture::IsBlockCompressed(pTexture.mFormat) == true || pTexture.mMips.empty() == true)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Mips can only be generated from uncompressed pixels!",
+                "TextureConversion");
+        }
+
+        pTexture.mMips.resize(1);
+        while (pTexture.mMips.back().mWidth > 1 || pTexture.mMips.back().mHeight > 1)
+        {
+            const TextureMip& lSource = pTexture.mMips.back();
+            TextureMip lMip;
+            lMip.mWidth = std::max<std::uint32_t>(lSource.mWidth / 2, 1);
+            lMip.mHeight = std::max<std::uint32_t>(lSource.mHeight / 2, 1);
+            lMip.mData.resize(Texture::GetMipSize(pTexture.mFormat, lMip.mWidth, lMip.mHeight));
+
+            ForEachRows(lMip.mHeight, pThreadPool, pRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    if (pTexture.mFormat == TextureFormat::RGBA8)
+                    {
+                        DownsampleRGBA8(lSource, lMip, pTexture.mSrgb, pBegin, pEnd);
+                    }
+                    else
+                    {
+                        DownsampleRGBA32F(lSource, lMip, pBegin, pEnd);
+                    }
+                });
+
+            pTexture.mMips.push_back(std::move(lMip));
+        }
+    }
+
+    void TextureConversion::ForEachRows (
+        const std::size_t                                                   pRowCount,
+        ThreadPool*                                                         pThreadPool,
+        const std::size_t                                                   pRowsPerJob,
+        const std::function<void(const std::size_t, const std::size_t)>&    pFunction
+    )
+    {
+        const std::size_t lRowsPerJob = std::max<std::size_t>(pRowsPerJob, 1);
+        const std::size_t lJobCount = (pRowCount + lRowsPerJob - 1) / lRowsPerJob;
+        auto lJob =
+            [&] (const std::size_t pJob)
+            {
+                pFunction(pJob * lRowsPerJob, std::min(pRowCount, (pJob + 1) * lRowsPerJob));
+            };
+
+        if (pThreadPool != nullptr && lJobCount > 1)
+        {
+            pThreadPool->ParallelFor(lJobCount, lJob);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < lJobCount; ++i)
+            {
+                lJob(i);
+            }
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    void TextureConversion::DownsampleRGBA8 (
+        const TextureMip&   pSource,
+        TextureMip&         pDestination,
+        const bool          pSrgb,
+        const std::size_t   pRowBegin,
+        const std::size_t   pRowEnd
+    )
+    {
+        const SrgbTables& lTables = SrgbTables::Get();
+        const std::size_t lSourceWidth = pSource.mWidth;
+        const std::size_t lWidth = pDestination.mWidth;
+        for (std::size_t y = pRowBegin; y < pRowEnd; ++y)
+        {
+            // Odd edges are clamped, so their last row or column is counted
+            // twice.
+            const std::uint8_t* lRow0 = pSource.mData.data() + std::min<std::size_t>(y * 2, pSource.mHeight - 1) * lSourceWidth * 4;
+            const std::uint8_t* lRow1 = pSource.mData.data() + std::min<std::size_t>(y * 2 + 1, pSource.mHeight - 1) * lSourceWidth * 4;
+            std::uint8_t* lOut = pDestination.mData.data() + y * lWidth * 4;
+
+            std::size_t x = 0;
+
+            #if defined(__SSE2__)
+                if (pSrgb == false)
+                {
+                    // Two output pixels from four input pixels of each row,
+                    // summed exactly in 16 bits.
+                    const __m128i lZero = _mm_setzero_si128();
+                    const __m128i lRound = _mm_set1_epi16(2);
+                    for (; x + 2 <= lWidth && x * 2 + 4 <= lSourceWidth; x += 2)
+                    {
+                        const __m128i lTop = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lRow0 + x * 8));
+                        const __m128i lBottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lRow1 + x * 8));
+                        const __m128i lLow = _mm_add_epi16(_mm_unpacklo_epi8(lTop, lZero), _mm_unpacklo_epi8(lBottom, lZero));
+                        const __m128i lHigh = _mm_add_epi16(_mm_unpackhi_epi8(lTop, lZero), _mm_unpackhi_epi8(lBottom, lZero));
+                        const __m128i lSums = _mm_unpacklo_epi64(
+                            _mm_add_epi16(lLow, _mm_srli_si128(lLow, 8)),
+                            _mm_add_epi16(lHigh, _mm_srli_si128(lHigh, 8))
+                        );
+                        const __m128i lAverage = _mm_srli_epi16(_mm_add_epi16(lSums, lRound), 2);
+                        _mm_storel_epi64(reinterpret_cast<__m128i*>(lOut + x * 4), _mm_packus_epi16(lAverage, lZero));
+                    }
+                }
+            #endif
+
+            for (; x < lWidth; ++x)
+            {
+                const std::size_t lX0 = std::min<std::size_t>(x * 2, lSourceWidth - 1) * 4;
+                const std::size_t lX1 = std::min<std::size_t>(x * 2 + 1, lSourceWidth - 1) * 4;
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    if (pSrgb == true && c < 3)
+                    {
+                        const float lSum =
+                            lTables.mDecode[lRow0[lX0 + c]] + lTables.mDecode[lRow0[lX1 + c]] +
+                            lTables.mDecode[lRow1[lX0 + c]] + lTables.mDecode[lRow1[lX1 + c]];
+                        lOut[x * 4 + c] = lTables.Encode(lSum * 0.25f);
+                    }
+                    else
+                    {
+                        const std::uint32_t lSum = lRow0[lX0 + c] + lRow0[lX1 + c] + lRow1[lX0 + c] + lRow1[lX1 + c];
+                        lOut[x * 4 + c] = static_cast<std::uint8_t>((lSum + 2) >> 2);
+                    }
+                }
+            }
+        }
+    }
+
+    void TextureConversion::DownsampleRGBA32F (
+        const TextureMip&   pSource,
+        TextureMip&         pDestination,
+        const std::size_t   pRowBegin,
+        const std::size_t   pRowEnd
+    )
+    {
+        const std::size_t lSourceWidth = pSource.mWidth;
+        const std::size_t lWidth = pDestination.mWidth;
+        const auto* lSource = reinterpret_cast<const float*>(pSource.mData.data());
+        auto* lDestination = reinterpret_cast<float*>(pDestination.mData.data());
+        for (std::size_t y = pRowBegin; y < pRowEnd; ++y)
+        {
+            const float* lRow0 = lSource + std::min<std::size_t>(y * 2, pSource.mHeight - 1) * lSourceWidth * 4;
+            const float* lRow1 = lSource + std::min<std::size_t>(y * 2 + 1, pSource.mHeight - 1) * lSourceWidth * 4;
+            float* lOut = lDestination + y * lWidth * 4;
+            for (std::size_t x = 0; x < lWidth; ++x)
+            {
+                const std::size_t lX0 = std::min<std::size_t>(x * 2, lSourceWidth - 1) * 4;
+                const std::size_t lX1 = std::min<std::size_t>(x * 2 + 1, lSourceWidth - 1) * 4;
+
+                #if defined(__SSE2__)
+                    const __m128 lSum = _mm_add_ps(
+                        _mm_add_ps(_mm_loadu_ps(lRow0 + lX0), _mm_loadu_ps(lRow0 + lX1)),
+                        _mm_add_ps(_mm_loadu_ps(lRow1 + lX0), _mm_loadu_ps(lRow1 + lX1))
+                    );
+                    _mm_storeu_ps(lOut + x * 4, _mm_mul_ps(lSum, _mm_set1_ps(0.25f)));
+                #else
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        lOut[x * 4 + c] = ((lRow0[lX0 + c] + lRow0[lX1 + c]) + (lRow1[lX0 + c] + lRow1[lX1 + c])) * 0.25f;
+                    }
+                #endif
+            }
+        }
+    }
+
+}
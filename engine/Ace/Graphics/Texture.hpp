@@ -0,0 +1,278 @@
+/**
+ * @file    Ace/Graphics/Texture.hpp
+ * @brief   Provides a structure containing a decoded texture and its mips,
+ *          and a static class of SIMD pixel conversions used to prepare one.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the pixel formats a @a `Texture` may hold.
+     */
+    enum class TextureFormat : std::uint8_t
+    {
+        RGBA8,      ///< @brief Four 8-bit channels per pixel, red first.
+        RGBA32F,    ///< @brief Four 32-bit floating-point channels per pixel, red first.
+        BC1,        ///< @brief 4x4 blocks of 8 bytes: two RGB565 endpoints and 2-bit indices.
+        BC3,        ///< @brief 4x4 blocks of 16 bytes: a BC4 alpha block, then a BC1 colour block.
+        BC5,        ///< @brief 4x4 blocks of 16 bytes: two BC4 blocks, for red and green.
+        BC7         ///< @brief 4x4 blocks of 16 bytes, in one of eight modes.
+    };
+
+    /**
+     * @brief   A structure containing one mip level of a texture.
+     */
+    struct TextureMip
+    {
+        std::uint32_t               mWidth = 0;     ///< @brief The mip's width, in pixels.
+        std::uint32_t               mHeight = 0;    ///< @brief The mip's height, in pixels.
+        astd::byte_buffer           mData;          ///< @brief The mip's pixels or blocks, row after row.
+    };
+
+    /**
+     * @brief   A structure containing a decoded texture, with its mip chain.
+     *
+     * Textures serialize to a compact binary form, so that cooked textures
+     * can be cached and loaded back as they are, without being decoded or
+     * compressed again.
+     */
+    struct ACE_API Texture
+    {
+
+        /**
+         * @brief   The version of the serialized form. Bumped whenever it, or
+         *          the output of the texture compressor, changes, so that
+         *          stale cooked textures are rejected.
+         */
+        static constexpr std::uint16_t COOKED_VERSION = 1;
+
+        /**
+         * @brief   The largest width or height a texture may have, in pixels.
+         *          Loaders reject larger images before sizing any buffers, so
+         *          that no mip size computed from a header can overflow.
+         */
+        static constexpr std::uint32_t MAX_DIMENSION = 16384;
+
+        TextureFormat               mFormat = TextureFormat::RGBA8;     ///< @brief The format of every mip's data.
+        bool                        mSrgb = false;                      ///< @brief Is the colour data sRGB-encoded?
+        std::vector<TextureMip>     mMips;                              ///< @brief The mips, largest first.
+
+        /**
+         * @brief   Retrieves the width of the texture's largest mip.
+         *
+         * @return  The width, in pixels, or zero if there are no mips.
+         */
+        inline std::uint32_t GetWidth () const
+        {
+            return (mMips.empty() == false) ? mMips[0].mWidth : 0;
+        }
+
+        /**
+         * @brief   Retrieves the height of the texture's largest mip.
+         *
+         * @return  The height, in pixels, or zero if there are no mips.
+         */
+        inline std::uint32_t GetHeight () const
+        {
+            return (mMips.empty() == false) ? mMips[0].mHeight : 0;
+        }
+
+        /**
+         * @brief   Retrieves whether a format stores 4x4 blocks rather than
+         *          pixels.
+         *
+         * @param   pFormat The format.
+         *
+         * @return  `true` if the format is block-compressed; `false`
+         *          otherwise.
+         */
+        static constexpr bool IsBlockCompressed (
+            const TextureFormat pFormat
+        )
+        {
+            return pFormat != TextureFormat::RGBA8 && pFormat != TextureFormat::RGBA32F;
+        }
+
+        /**
+         * @brief   Retrieves the number of bytes one mip of a format takes up.
+         *
+         * @param   pFormat The format.
+         * @param   pWidth  The mip's width, in pixels.
+         * @param   pHeight The mip's height, in pixels.
+         *
+         * @return  The size of the mip's data, in bytes.
+         *
+         * @throw   `std::length_error` if either dimension exceeds
+         *          @a `MAX_DIMENSION`.
+         */
+        static constexpr std::size_t GetMipSize (
+            const TextureFormat pFormat,
+            const std::size_t   pWidth,
+            const std::size_t   pHeight
+        )
+        {
+            if (pWidth > MAX_DIMENSION || pHeight > MAX_DIMENSION)
+            {
+                ACE_THROW(std::length_error, "{}: A {}x{} mip exceeds the maximum dimension of {}!",
+                    "Texture", pWidth, pHeight, MAX_DIMENSION);
+            }
+
+            switch (pFormat)
+            {
+                case TextureFormat::RGBA8:      return pWidth * pHeight * 4;
+                case TextureFormat::RGBA32F:    return pWidth * pHeight * 16;
+                case TextureFormat::BC1:        return ((pWidth + 3) / 4) * ((pHeight + 3) / 4) * 8;
+                default:                        return ((pWidth + 3) / 4) * ((pHeight + 3) / 4) * 16;
+            }
+        }
+
+        /**
+         * @brief   Serializes the texture into its binary form.
+         *
+         * @return  The serialized texture.
+         */
+        astd::byte_buffer Serialize () const;
+
+        /**
+         * @brief   Deserializes a texture.
+         *
+         * @param   pData   The serialized texture.
+         *
+         * @return  The texture.
+         *
+         * @throw   `std::runtime_error` if the data is truncated, was written
+         *          by a different version, or holds mips of the wrong size.
+         */
+        static std::shared_ptr<Texture> Deserialize (
+            std::span<const std::uint8_t>   pData
+        );
+    };
+
+    /**
+     * @brief   A static class containing the pixel conversions used to prepare
+     *          decoded images as textures.
+     *
+     * Each conversion works on whole rows, and may be given a thread pool to
+     * spread those rows across; it must then not be called from one of that
+     * pool's own workers. The inner loops use SSE2 where available.
+     */
+    class ACE_API TextureConversion final
+    {
+    public:
+
+        /**
+         * @brief   Expands rows of 8-bit RGB pixels into 8-bit RGBA pixels,
+         *          with opaque alpha.
+         *
+         * @param   pSource         The RGB pixels.
+         * @param   pDestination    The RGBA pixels. Must hold four bytes for
+         *                          every three in the source.
+         * @param   pPixelCount     The number of pixels to expand.
+         */
+        static void ExpandRGBToRGBA (
+            const std::uint8_t* pSource,
+            std::uint8_t*       pDestination,
+            const std::size_t   pPixelCount
+        );
+
+        /**
+         * @brief   Swaps the red and blue channels of 8-bit BGRA pixels, in
+         *          place.
+         *
+         * @param   pPixels     The pixels.
+         * @param   pPixelCount The number of pixels.
+         */
+        static void SwizzleBGRAToRGBA (
+            std::uint8_t*       pPixels,
+            const std::size_t   pPixelCount
+        );
+
+        /**
+         * @brief   Converts an 8-bit RGBA texture into a floating-point one
+         *          in linear space, mips and all, decoding sRGB-encoded
+         *          colour. Alpha is always linear, and is only rescaled.
+         *
+         * @param   pTexture    The texture to convert, in @a `RGBA8`.
+         * @param   pThreadPool The thread pool to spread rows across, or
+         *                      `nullptr`.
+         * @param   pRowsPerJob The number of rows converted by each job.
+         *
+         * @throw   `std::invalid_argument` if the texture is not @a `RGBA8`.
+         */
+        static void ConvertToLinear (
+            Texture&            pTexture,
+            ThreadPool*         pThreadPool = nullptr,
+            const std::size_t   pRowsPerJob = 64
+        );
+
+        /**
+         * @brief   Replaces a texture's mips below the first with a full
+         *          chain, each a 2x2 box filter of the one above.
+         *
+         * sRGB-encoded textures are filtered in linear space, so that mips do
+         * not darken.
+         *
+         * @param   pTexture    The texture, in @a `RGBA8` or @a `RGBA32F`.
+         * @param   pThreadPool The thread pool to spread rows across, or
+         *                      `nullptr`.
+         * @param   pRowsPerJob The number of rows filtered by each job.
+         *
+         * @throw   `std::invalid_argument` if the texture is block-compressed
+         *          or has no mips.
+         */
+        static void GenerateMips (
+            Texture&            pTexture,
+            ThreadPool*         pThreadPool = nullptr,
+            const std::size_t   pRowsPerJob = 64
+        );
+
+        /**
+         * @brief   Runs a function over a range of rows, in jobs of the given
+         *          size, on a thread pool if one is given.
+         *
+         * @param   pRowCount   The number of rows.
+         * @param   pThreadPool The thread pool, or `nullptr` to run on the
+         *                      calling thread.
+         * @param   pRowsPerJob The number of rows in each job.
+         * @param   pFunction   The function, taking the first row of a job
+         *                      and one past its last.
+         */
+        static void ForEachRows (
+            const std::size_t                                               pRowCount,
+            ThreadPool*                                                     pThreadPool,
+            const std::size_t                                               pRowsPerJob,
+            const std::function<void(const std::size_t, const std::size_t)>& pFunction
+        );
+
+    private:
+
+        /**
+         * @brief   Filters one mip of an 8-bit texture into the next.
+         */
+        static void DownsampleRGBA8 (
+            const TextureMip&   pSource,
+            TextureMip&         pDestination,
+            const bool          pSrgb,
+            const std::size_t   pRowBegin,
+            const std::size_t   pRowEnd
+        );
+
+        /**
+         * @brief   Filters one mip of a floating-point texture into the next.
+         */
+        static void DownsampleRGBA32F (
+            const TextureMip&   pSource,
+            TextureMip&         pDestination,
+            const std::size_t   pRowBegin,
+            const std::size_t   pRowEnd
+        );
+
+    };
+
+}
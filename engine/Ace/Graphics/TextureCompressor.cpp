@@ -0,0 +1,1008 @@
+/**
+ * @file    Ace/Graphics/TextureCompressor.cpp
+ */
+
+#include <Ace/Graphics/TextureCompressor.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Structures ******************************************************/
+
+    /**
+     * @brief   The pixels of one 4x4 block, channel by channel, so that four
+     *          pixels' worth of one channel fill a vector.
+     */
+    struct BlockPixels
+    {
+        alignas(16) float   mChannels[4][16];   ///< @brief Red, green, blue and alpha, each for the 16 pixels in row order.
+    };
+
+    /**
+     * @brief   A pair of endpoints, as a palette is interpolated between them.
+     */
+    struct BlockEndpoints
+    {
+        float   mLow[4];    ///< @brief The first endpoint.
+        float   mHigh[4];   ///< @brief The second endpoint.
+    };
+
+    /**
+     * @brief   Writes values into a block, least significant bit first.
+     */
+    struct BlockBitWriter
+    {
+        std::uint8_t*   mBlock = nullptr;   ///< @brief The block being written.
+        std::size_t     mBit = 0;           ///< @brief The next bit to write.
+
+        void Write (
+            const std::uint32_t pValue,
+            const std::size_t   pBits
+        )
+        {
+            for (std::size_t i = 0; i < pBits; ++i, ++mBit)
+            {
+                mBlock[mBit / 8] |= static_cast<std::uint8_t>(((pValue >> i) & 1) << (mBit % 8));
+            }
+        }
+    };
+
+    /**
+     * @brief   Reads values from a block, least significant bit first.
+     */
+    struct BlockBitReader
+    {
+        const std::uint8_t* mBlock = nullptr;   ///< @brief The block being read.
+        std::size_t         mBit = 0;           ///< @brief The next bit to read.
+
+        std::uint32_t Read (
+            const std::size_t   pBits
+        )
+        {
+            std::uint32_t lValue = 0;
+            for (std::size_t i = 0; i < pBits; ++i, ++mBit)
+            {
+                lValue |= static_cast<std::uint32_t>((mBlock[mBit / 8] >> (mBit % 8)) & 1) << i;
+            }
+
+            return lValue;
+        }
+    };
+
+    /* Helper Functions *******************************************************/
+
+    // How far along from the first endpoint to the second each BC1 index
+    // lies, in four-colour mode.
+    static constexpr float BC1_WEIGHTS[4] = { 0.0f, 1.0f, 1.0f / 3.0f, 2.0f / 3.0f };
+
+    // The same for each of BC7's 4-bit indices, in sixty-fourths.
+    static constexpr std::uint32_t BC7_WEIGHTS[16] = { 0, 4, 9, 13, 17, 21, 26, 30, 34, 38, 43, 47, 51, 55, 60, 64 };
+
+    /**
+     * @brief   Copies the 4x4 block at the given block coordinates out of a
+     *          mip, repeating the last row and column where it overhangs.
+     */
+    static void GatherBlock (
+        const TextureMip&   pMip,
+        const std::size_t   pBlockX,
+        const std::size_t   pBlockY,
+        std::uint8_t        pPixels[64]
+    )
+    {
+        for (std::size_t y = 0; y < 4; ++y)
+        {
+            const std::size_t lY = std::min<std::size_t>(pBlockY * 4 + y, pMip.mHeight - 1);
+            for (std::size_t x = 0; x < 4; ++x)
+            {
+                const std::size_t lX = std::min<std::size_t>(pBlockX * 4 + x, pMip.mWidth - 1);
+                std::memcpy(pPixels + (y * 4 + x) * 4, pMip.mData.data() + (lY * pMip.mWidth + lX) * 4, 4);
+            }
+        }
+    }
+
+    /**
+     * @brief   Copies a decoded 4x4 block into a mip, dropping whatever
+     *          overhangs it.
+     */
+    static void ScatterBlock (
+        TextureMip&         pMip,
+        const std::size_t   pBlockX,
+        const std::size_t   pBlockY,
+        const std::uint8_t  pPixels[64]
+    )
+    {
+        for (std::size_t y = 0; y < 4 && pBlockY * 4 + y < pMip.mHeight; ++y)
+        {
+            const std::size_t lColumns = std::min<std::size_t>(4, pMip.mWidth - pBlockX * 4);
+            std::memcpy(pMip.mData.data() + ((pBlockY * 4 + y) * pMip.mWidth + pBlockX * 4) * 4,
+                pPixels + y * 16, lColumns * 4);
+        }
+    }
+
+    /**
+     * @brief   Splits a block's pixels into channels, zeroing those past the
+     *          given count so that they take no part in fitting.
+     */
+    static void LoadBlockPixels (
+        const std::uint8_t  pPixels[64],
+        const std::size_t   pChannelCount,
+        BlockPixels&        pBlock
+    )
+    {
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                pBlock.mChannels[c][i] = (c < pChannelCount) ? static_cast<float>(pPixels[i * 4 + c]) : 0.0f;
+            }
+        }
+    }
+
+    /**
+     * @brief   Finds endpoints spanning a block's colours along their
+     *          principal axis.
+     *
+     * The axis is found by power iteration on the colours' covariance; each
+     * pixel is then projected onto it, and the extremes become the endpoints.
+     */
+    static BlockEndpoints FitPrincipalAxis (
+        const BlockPixels&  pBlock
+    )
+    {
+        float lMean[4] = {};
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                lMean[c] += pBlock.mChannels[c][i];
+            }
+
+            lMean[c] /= 16.0f;
+        }
+
+        float lCovariance[4][4] = {};
+        for (std::size_t a = 0; a < 4; ++a)
+        {
+            for (std::size_t b = a; b < 4; ++b)
+            {
+                float lSum = 0.0f;
+                for (std::size_t i = 0; i < 16; ++i)
+                {
+                    lSum += (pBlock.mChannels[a][i] - lMean[a]) * (pBlock.mChannels[b][i] - lMean[b]);
+                }
+
+                lCovariance[a][b] = lSum;
+                lCovariance[b][a] = lSum;
+            }
+        }
+
+        // Start from the channel which varies most, which is never
+        // orthogonal to the principal axis unless the block is flat.
+        float lAxis[4] = {};
+        std::size_t lWidest = 0;
+        for (std::size_t c = 1; c < 4; ++c)
+        {
+            if (lCovariance[c][c] > lCovariance[lWidest][lWidest])
+            {
+                lWidest = c;
+            }
+        }
+
+        lAxis[lWidest] = 1.0f;
+        for (std::size_t lIteration = 0; lIteration < 8; ++lIteration)
+        {
+            float lNext[4] = {};
+            float lLength = 0.0f;
+            for (std::size_t a = 0; a < 4; ++a)
+            {
+                for (std::size_t b = 0; b < 4; ++b)
+                {
+                    lNext[a] += lCovariance[a][b] * lAxis[b];
+                }
+
+                lLength += lNext[a] * lNext[a];
+            }
+
+            if (lLength < 1e-12f)
+            {
+                break;
+            }
+
+            const float lScale = 1.0f / std::sqrt(lLength);
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                lAxis[c] = lNext[c] * lScale;
+            }
+        }
+
+        float lMinimum = 0.0f;
+        float lMaximum = 0.0f;
+
+        #if defined(__SSE2__)
+            __m128 lLowest = _mm_set1_ps(0.0f);
+            __m128 lHighest = _mm_set1_ps(0.0f);
+            for (std::size_t i = 0; i < 16; i += 4)
+            {
+                __m128 lProjection = _mm_setzero_ps();
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    const __m128 lOffset = _mm_sub_ps(_mm_load_ps(pBlock.mChannels[c] + i), _mm_set1_ps(lMean[c]));
+                    lProjection = _mm_add_ps(lProjection, _mm_mul_ps(lOffset, _mm_set1_ps(lAxis[c])));
+                }
+
+                lLowest = _mm_min_ps(lLowest, lProjection);
+                lHighest = _mm_max_ps(lHighest, lProjection);
+            }
+
+            alignas(16) float lLows[4];
+            alignas(16) float lHighs[4];
+            _mm_store_ps(lLows, lLowest);
+            _mm_store_ps(lHighs, lHighest);
+            lMinimum = std::min({ lLows[0], lLows[1], lLows[2], lLows[3] });
+            lMaximum = std::max({ lHighs[0], lHighs[1], lHighs[2], lHighs[3] });
+        #else
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                float lProjection = 0.0f;
+                for (std::size_t c = 0; c < 4; ++c)
+                {
+                    lProjection += (pBlock.mChannels[c][i] - lMean[c]) * lAxis[c];
+                }
+
+                lMinimum = std::min(lMinimum, lProjection);
+                lMaximum = std::max(lMaximum, lProjection);
+            }
+        #endif
+
+        BlockEndpoints lEndpoints;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            lEndpoints.mLow[c] = std::clamp(lMean[c] + lAxis[c] * lMinimum, 0.0f, 255.0f);
+            lEndpoints.mHigh[c] = std::clamp(lMean[c] + lAxis[c] * lMaximum, 0.0f, 255.0f);
+        }
+
+        return lEndpoints;
+    }
+
+    /**
+     * @brief   Picks, for each pixel of a block, the nearest entry of a
+     *          palette.
+     *
+     * @return  The block's total squared error.
+     */
+    static float SelectIndices (
+        const BlockPixels&  pBlock,
+        const float         pPalette[16][4],
+        const std::size_t   pPaletteSize,
+        std::uint8_t        pIndices[16]
+    )
+    {
+        float lTotal = 0.0f;
+
+        #if defined(__SSE2__)
+            for (std::size_t i = 0; i < 16; i += 4)
+            {
+                const __m128 lRed = _mm_load_ps(pBlock.mChannels[0] + i);
+                const __m128 lGreen = _mm_load_ps(pBlock.mChannels[1] + i);
+                const __m128 lBlue = _mm_load_ps(pBlock.mChannels[2] + i);
+                const __m128 lAlpha = _mm_load_ps(pBlock.mChannels[3] + i);
+
+                __m128 lBest = _mm_set1_ps(std::numeric_limits<float>::max());
+                __m128i lBestIndex = _mm_setzero_si128();
+                for (std::size_t k = 0; k < pPaletteSize; ++k)
+                {
+                    const __m128 lDeltaRed = _mm_sub_ps(lRed, _mm_set1_ps(pPalette[k][0]));
+                    const __m128 lDeltaGreen = _mm_sub_ps(lGreen, _mm_set1_ps(pPalette[k][1]));
+                    const __m128 lDeltaBlue = _mm_sub_ps(lBlue, _mm_set1_ps(pPalette[k][2]));
+                    const __m128 lDeltaAlpha = _mm_sub_ps(lAlpha, _mm_set1_ps(pPalette[k][3]));
+                    const __m128 lError = _mm_add_ps(
+                        _mm_add_ps(_mm_mul_ps(lDeltaRed, lDeltaRed), _mm_mul_ps(lDeltaGreen, lDeltaGreen)),
+                        _mm_add_ps(_mm_mul_ps(lDeltaBlue, lDeltaBlue), _mm_mul_ps(lDeltaAlpha, lDeltaAlpha)));
+
+                    const __m128i lCloser = _mm_castps_si128(_mm_cmplt_ps(lError, lBest));
+                    lBest = _mm_min_ps(lError, lBest);
+                    lBestIndex = _mm_or_si128(
+                        _mm_and_si128(lCloser, _mm_set1_epi32(static_cast<int>(k))),
+                        _mm_andnot_si128(lCloser, lBestIndex));
+                }
+
+                alignas(16) float lErrors[4];
+                alignas(16) std::int32_t lChosen[4];
+                _mm_store_ps(lErrors, lBest);
+                _mm_store_si128(reinterpret_cast<__m128i*>(lChosen), lBestIndex);
+                for (std::size_t j = 0; j < 4; ++j)
+                {
+                    pIndices[i + j] = static_cast<std::uint8_t>(lChosen[j]);
+                    lTotal += lErrors[j];
+                }
+            }
+        #else
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                float lBest = std::numeric_limits<float>::max();
+                for (std::size_t k = 0; k < pPaletteSize; ++k)
+                {
+                    float lError = 0.0f;
+                    for (std::size_t c = 0; c < 4; ++c)
+                    {
+                        const float lDelta = pBlock.mChannels[c][i] - pPalette[k][c];
+                        lError += lDelta * lDelta;
+                    }
+
+                    if (lError < lBest)
+                    {
+                        lBest = lError;
+                        pIndices[i] = static_cast<std::uint8_t>(k);
+                    }
+                }
+
+                lTotal += lBest;
+            }
+        #endif
+
+        return lTotal;
+    }
+
+    /**
+     * @brief   Solves for the endpoints which best fit a block by least
+     *          squares, given where along the line each pixel lies.
+     *
+     * @return  `false` if every pixel lies at the same point, so there is no
+     *          unique solution; `true` otherwise.
+     */
+    static bool FitLeastSquares (
+        const BlockPixels&  pBlock,
+        const std::uint8_t  pIndices[16],
+        const float*        pWeights,
+        BlockEndpoints&     pEndpoints
+    )
+    {
+        float lLowLow = 0.0f;
+        float lLowHigh = 0.0f;
+        float lHighHigh = 0.0f;
+        float lLowSums[4] = {};
+        float lHighSums[4] = {};
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const float lHigh = pWeights[pIndices[i]];
+            const float lLow = 1.0f - lHigh;
+            lLowLow += lLow * lLow;
+            lLowHigh += lLow * lHigh;
+            lHighHigh += lHigh * lHigh;
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                lLowSums[c] += lLow * pBlock.mChannels[c][i];
+                lHighSums[c] += lHigh * pBlock.mChannels[c][i];
+            }
+        }
+
+        const float lDeterminant = lLowLow * lHighHigh - lLowHigh * lLowHigh;
+        if (std::abs(lDeterminant) < 1e-6f)
+        {
+            return false;
+        }
+
+        const float lInverse = 1.0f / lDeterminant;
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            pEndpoints.mLow[c] = std::clamp((lHighHigh * lLowSums[c] - lLowHigh * lHighSums[c]) * lInverse, 0.0f, 255.0f);
+            pEndpoints.mHigh[c] = std::clamp((lLowLow * lHighSums[c] - lLowHigh * lLowSums[c]) * lInverse, 0.0f, 255.0f);
+        }
+
+        return true;
+    }
+
+    static std::uint16_t PackRGB565 (
+        const float pColor[4]
+    )
+    {
+        const auto lRed = static_cast<std::uint16_t>(std::lround(pColor[0] * 31.0f / 255.0f));
+        const auto lGreen = static_cast<std::uint16_t>(std::lround(pColor[1] * 63.0f / 255.0f));
+        const auto lBlue = static_cast<std::uint16_t>(std::lround(pColor[2] * 31.0f / 255.0f));
+        return static_cast<std::uint16_t>((lRed << 11) | (lGreen << 5) | lBlue);
+    }
+
+    static void UnpackRGB565 (
+        const std::uint16_t pPacked,
+        std::uint8_t        pColor[3]
+    )
+    {
+        const std::uint32_t lRed = (pPacked >> 11) & 0x1F;
+        const std::uint32_t lGreen = (pPacked >> 5) & 0x3F;
+        const std::uint32_t lBlue = pPacked & 0x1F;
+        pColor[0] = static_cast<std::uint8_t>((lRed << 3) | (lRed >> 2));
+        pColor[1] = static_cast<std::uint8_t>((lGreen << 2) | (lGreen >> 4));
+        pColor[2] = static_cast<std::uint8_t>((lBlue << 3) | (lBlue >> 2));
+    }
+
+    /**
+     * @brief   Builds the four-colour BC1 palette between two packed
+     *          endpoints.
+     */
+    static void MakeBC1Palette (
+        const std::uint16_t pFirst,
+        const std::uint16_t pSecond,
+        std::uint8_t        pPalette[4][3]
+    )
+    {
+        UnpackRGB565(pFirst, pPalette[0]);
+        UnpackRGB565(pSecond, pPalette[1]);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            pPalette[2][c] = static_cast<std::uint8_t>((2 * pPalette[0][c] + pPalette[1][c]) / 3);
+            pPalette[3][c] = static_cast<std::uint8_t>((pPalette[0][c] + 2 * pPalette[1][c]) / 3);
+        }
+    }
+
+    /**
+     * @brief   Quantizes a pair of endpoints to RGB565 and picks each pixel's
+     *          index.
+     *
+     * @return  The block's total squared error.
+     */
+    static float QuantizeBC1 (
+        const BlockPixels&      pBlock,
+        const BlockEndpoints&   pEndpoints,
+        std::uint16_t&          pFirst,
+        std::uint16_t&          pSecond,
+        std::uint8_t            pIndices[16]
+    )
+    {
+        pFirst = PackRGB565(pEndpoints.mLow);
+        pSecond = PackRGB565(pEndpoints.mHigh);
+
+        std::uint8_t lColors[4][3];
+        MakeBC1Palette(pFirst, pSecond, lColors);
+
+        float lPalette[16][4] = {};
+        for (std::size_t k = 0; k < 4; ++k)
+        {
+            for (std::size_t c = 0; c < 3; ++c)
+            {
+                lPalette[k][c] = lColors[k][c];
+            }
+        }
+
+        return SelectIndices(pBlock, lPalette, 4, pIndices);
+    }
+
+    /**
+     * @brief   Compresses the colour of a block into an 8-byte BC1 block, in
+     *          four-colour mode.
+     */
+    static void EncodeBC1 (
+        const std::uint8_t  pPixels[64],
+        std::uint8_t        pOut[8]
+    )
+    {
+        BlockPixels lBlock;
+        LoadBlockPixels(pPixels, 3, lBlock);
+
+        BlockEndpoints lEndpoints = FitPrincipalAxis(lBlock);
+        std::uint16_t lFirst = 0;
+        std::uint16_t lSecond = 0;
+        std::uint8_t lIndices[16];
+        float lError = QuantizeBC1(lBlock, lEndpoints, lFirst, lSecond, lIndices);
+
+        for (std::size_t lIteration = 0; lIteration < 2 && lError > 0.0f; ++lIteration)
+        {
+            std::uint16_t lTryFirst = 0;
+            std::uint16_t lTrySecond = 0;
+            std::uint8_t lTryIndices[16];
+            if (FitLeastSquares(lBlock, lIndices, BC1_WEIGHTS, lEndpoints) == false)
+            {
+                break;
+            }
+
+            const float lTryError = QuantizeBC1(lBlock, lEndpoints, lTryFirst, lTrySecond, lTryIndices);
+            if (lTryError >= lError)
+            {
+                break;
+            }
+
+            lError = lTryError;
+            lFirst = lTryFirst;
+            lSecond = lTrySecond;
+            std::memcpy(lIndices, lTryIndices, sizeof(lIndices));
+        }
+
+        // Four-colour mode needs the first endpoint to be the greater;
+        // swapping them swaps indices 0 and 1, and 2 and 3. Equal endpoints
+        // select three-colour mode, where index 0 still means the first.
+        if (lFirst < lSecond)
+        {
+            std::swap(lFirst, lSecond);
+            for (std::uint8_t& lIndex : lIndices)
+            {
+                lIndex ^= 1;
+            }
+        }
+        else if (lFirst == lSecond)
+        {
+            std::memset(lIndices, 0, sizeof(lIndices));
+        }
+
+        std::uint32_t lPacked = 0;
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            lPacked |= static_cast<std::uint32_t>(lIndices[i]) << (i * 2);
+        }
+
+        pOut[0] = static_cast<std::uint8_t>(lFirst);
+        pOut[1] = static_cast<std::uint8_t>(lFirst >> 8);
+        pOut[2] = static_cast<std::uint8_t>(lSecond);
+        pOut[3] = static_cast<std::uint8_t>(lSecond >> 8);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            pOut[4 + i] = static_cast<std::uint8_t>(lPacked >> (i * 8));
+        }
+    }
+
+    static void DecodeBC1 (
+        const std::uint8_t  pBlock[8],
+        std::uint8_t        pPixels[64],
+        const bool          pAlwaysFourColors
+    )
+    {
+        const auto lFirst = static_cast<std::uint16_t>(pBlock[0] | (pBlock[1] << 8));
+        const auto lSecond = static_cast<std::uint16_t>(pBlock[2] | (pBlock[3] << 8));
+
+        std::uint8_t lPalette[4][4];
+        for (auto& lColor : lPalette)
+        {
+            lColor[3] = 0xFF;
+        }
+
+        UnpackRGB565(lFirst, lPalette[0]);
+        UnpackRGB565(lSecond, lPalette[1]);
+        for (std::size_t c = 0; c < 3; ++c)
+        {
+            if (lFirst > lSecond || pAlwaysFourColors == true)
+            {
+                lPalette[2][c] = static_cast<std::uint8_t>((2 * lPalette[0][c] + lPalette[1][c]) / 3);
+                lPalette[3][c] = static_cast<std::uint8_t>((lPalette[0][c] + 2 * lPalette[1][c]) / 3);
+            }
+            else
+            {
+                lPalette[2][c] = static_cast<std::uint8_t>((lPalette[0][c] + lPalette[1][c]) / 2);
+                lPalette[3][c] = 0;
+            }
+        }
+
+        if (lFirst <= lSecond && pAlwaysFourColors == false)
+        {
+            lPalette[3][3] = 0;
+        }
+
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const std::size_t lIndex = (pBlock[4 + i / 4] >> ((i % 4) * 2)) & 0x3;
+            std::memcpy(pPixels + i * 4, lPalette[lIndex], 4);
+        }
+    }
+
+    /**
+     * @brief   Compresses one channel of a block into an 8-byte BC4 block,
+     *          interpolating eight values between its extremes.
+     */
+    static void EncodeBC4 (
+        const std::uint8_t  pPixels[64],
+        const std::size_t   pChannel,
+        std::uint8_t        pOut[8]
+    )
+    {
+        alignas(16) std::uint8_t lValues[16];
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            lValues[i] = pPixels[i * 4 + pChannel];
+        }
+
+        std::uint8_t lMinimum = 255;
+        std::uint8_t lMaximum = 0;
+
+        #if defined(__SSE2__)
+            __m128i lLowest = _mm_load_si128(reinterpret_cast<const __m128i*>(lValues));
+            __m128i lHighest = lLowest;
+            // Fold the upper half onto the lower until the first byte holds
+            // the extreme of all sixteen.
+            lLowest = _mm_min_epu8(lLowest, _mm_srli_si128(lLowest, 8));
+            lHighest = _mm_max_epu8(lHighest, _mm_srli_si128(lHighest, 8));
+            lLowest = _mm_min_epu8(lLowest, _mm_srli_si128(lLowest, 4));
+            lHighest = _mm_max_epu8(lHighest, _mm_srli_si128(lHighest, 4));
+            lLowest = _mm_min_epu8(lLowest, _mm_srli_si128(lLowest, 2));
+            lHighest = _mm_max_epu8(lHighest, _mm_srli_si128(lHighest, 2));
+            lLowest = _mm_min_epu8(lLowest, _mm_srli_si128(lLowest, 1));
+            lHighest = _mm_max_epu8(lHighest, _mm_srli_si128(lHighest, 1));
+
+            lMinimum = static_cast<std::uint8_t>(_mm_cvtsi128_si32(lLowest) & 0xFF);
+            lMaximum = static_cast<std::uint8_t>(_mm_cvtsi128_si32(lHighest) & 0xFF);
+        #else
+            for (const std::uint8_t lValue : lValues)
+            {
+                lMinimum = std::min(lMinimum, lValue);
+                lMaximum = std::max(lMaximum, lValue);
+            }
+        #endif
+
+        std::uint64_t lPacked = 0;
+        if (lMaximum > lMinimum)
+        {
+            // With the maximum first, index 0 is the maximum, 1 the minimum,
+            // and 2 to 7 step down from one to the other.
+            const std::uint32_t lRange = lMaximum - lMinimum;
+            for (std::size_t i = 0; i < 16; ++i)
+            {
+                const std::uint32_t lStep = ((lValues[i] - lMinimum) * 14 + lRange) / (lRange * 2);
+                const std::uint64_t lIndex = (lStep == 7) ? 0 : (lStep == 0) ? 1 : 8 - lStep;
+                lPacked |= lIndex << (i * 3);
+            }
+        }
+
+        pOut[0] = lMaximum;
+        pOut[1] = lMinimum;
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            pOut[2 + i] = static_cast<std::uint8_t>(lPacked >> (i * 8));
+        }
+    }
+
+    static void DecodeBC4 (
+        const std::uint8_t  pBlock[8],
+        std::uint8_t        pPixels[64],
+        const std::size_t   pChannel
+    )
+    {
+        const std::uint32_t lFirst = pBlock[0];
+        const std::uint32_t lSecond = pBlock[1];
+
+        std::uint8_t lPalette[8] = { pBlock[0], pBlock[1] };
+        if (lFirst > lSecond)
+        {
+            for (std::uint32_t i = 2; i < 8; ++i)
+            {
+                lPalette[i] = static_cast<std::uint8_t>(((8 - i) * lFirst + (i - 1) * lSecond + 3) / 7);
+            }
+        }
+        else
+        {
+            for (std::uint32_t i = 2; i < 6; ++i)
+            {
+                lPalette[i] = static_cast<std::uint8_t>(((6 - i) * lFirst + (i - 1) * lSecond + 2) / 5);
+            }
+
+            lPalette[6] = 0;
+            lPalette[7] = 255;
+        }
+
+        std::uint64_t lPacked = 0;
+        for (std::size_t i = 0; i < 6; ++i)
+        {
+            lPacked |= static_cast<std::uint64_t>(pBlock[2 + i]) << (i * 8);
+        }
+
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            pPixels[i * 4 + pChannel] = lPalette[(lPacked >> (i * 3)) & 0x7];
+        }
+    }
+
+    /**
+     * @brief   Quantizes an endpoint to BC7 mode 6's seven bits per channel,
+     *          plus a shared low bit, choosing the low bit which fits best.
+     */
+    static void QuantizeBC7Endpoint (
+        const float     pEndpoint[4],
+        std::uint32_t   pQuantized[4],
+        std::uint32_t&  pParity
+    )
+    {
+        float lBestError = std::numeric_limits<float>::max();
+        for (std::uint32_t lParity = 0; lParity < 2; ++lParity)
+        {
+            std::uint32_t lChannels[4];
+            float lError = 0.0f;
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                lChannels[c] = static_cast<std::uint32_t>(
+                    std::clamp<long>(std::lround((pEndpoint[c] - static_cast<float>(lParity)) / 2.0f), 0, 127));
+                const float lDelta = static_cast<float>((lChannels[c] << 1) | lParity) - pEndpoint[c];
+                lError += lDelta * lDelta;
+            }
+
+            if (lError < lBestError)
+            {
+                lBestError = lError;
+                pParity = lParity;
+                std::memcpy(pQuantized, lChannels, sizeof(lChannels));
+            }
+        }
+    }
+
+    /**
+     * @brief   Quantizes a pair of endpoints for BC7 mode 6 and picks each
+     *          pixel's index.
+     *
+     * @return  The block's total squared error.
+     */
+    static float QuantizeBC7 (
+        const BlockPixels&      pBlock,
+        const BlockEndpoints&   pEndpoints,
+        std::uint32_t           pQuantized[2][4],
+        std::uint32_t           pParities[2],
+        std::uint8_t            pIndices[16]
+    )
+    {
+        QuantizeBC7Endpoint(pEndpoints.mLow, pQuantized[0], pParities[0]);
+        QuantizeBC7Endpoint(pEndpoints.mHigh, pQuantized[1], pParities[1]);
+
+        float lPalette[16][4];
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            const std::uint32_t lLow = (pQuantized[0][c] << 1) | pParities[0];
+            const std::uint32_t lHigh = (pQuantized[1][c] << 1) | pParities[1];
+            for (std::size_t k = 0; k < 16; ++k)
+            {
+                lPalette[k][c] = static_cast<float>(((64 - BC7_WEIGHTS[k]) * lLow + BC7_WEIGHTS[k] * lHigh + 32) >> 6);
+            }
+        }
+
+        return SelectIndices(pBlock, lPalette, 16, pIndices);
+    }
+
+    /**
+     * @brief   Compresses a block into a 16-byte BC7 block, in mode 6.
+     */
+    static void EncodeBC7 (
+        const std::uint8_t  pPixels[64],
+        std::uint8_t        pOut[16]
+    )
+    {
+        static constexpr auto WEIGHTS =
+            [] ()
+            {
+                std::array<float, 16> lWeights {};
+                for (std::size_t k = 0; k < 16; ++k)
+                {
+                    lWeights[k] = static_cast<float>(BC7_WEIGHTS[k]) / 64.0f;
+                }
+
+                return lWeights;
+            }();
+
+        BlockPixels lBlock;
+        LoadBlockPixels(pPixels, 4, lBlock);
+
+        BlockEndpoints lEndpoints = FitPrincipalAxis(lBlock);
+        std::uint32_t lQuantized[2][4];
+        std::uint32_t lParities[2];
+        std::uint8_t lIndices[16];
+        float lError = QuantizeBC7(lBlock, lEndpoints, lQuantized, lParities, lIndices);
+
+        for (std::size_t lIteration = 0; lIteration < 2 && lError > 0.0f; ++lIteration)
+        {
+            std::uint32_t lTryQuantized[2][4];
+            std::uint32_t lTryParities[2];
+            std::uint8_t lTryIndices[16];
+            if (FitLeastSquares(lBlock, lIndices, WEIGHTS.data(), lEndpoints) == false)
+            {
+                break;
+            }
+
+            const float lTryError = QuantizeBC7(lBlock, lEndpoints, lTryQuantized, lTryParities, lTryIndices);
+            if (lTryError >= lError)
+            {
+                break;
+            }
+
+            lError = lTryError;
+            std::memcpy(lQuantized, lTryQuantized, sizeof(lQuantized));
+            std::memcpy(lParities, lTryParities, sizeof(lParities));
+            std::memcpy(lIndices, lTryIndices, sizeof(lIndices));
+        }
+
+        // The first pixel's index is stored without its top bit, which must
+        // therefore be clear; swapping the endpoints mirrors every index.
+        if (lIndices[0] >= 8)
+        {
+            std::swap(lQuantized[0], lQuantized[1]);
+            std::swap(lParities[0], lParities[1]);
+            for (std::uint8_t& lIndex : lIndices)
+            {
+                lIndex = static_cast<std::uint8_t>(15 - lIndex);
+            }
+        }
+
+        std::memset(pOut, 0, 16);
+        BlockBitWriter lWriter { pOut };
+        lWriter.Write(1 << 6, 7);
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            lWriter.Write(lQuantized[0][c], 7);
+            lWriter.Write(lQuantized[1][c], 7);
+        }
+
+        lWriter.Write(lParities[0], 1);
+        lWriter.Write(lParities[1], 1);
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            lWriter.Write(lIndices[i], (i == 0) ? 3 : 4);
+        }
+    }
+
+    static void DecodeBC7 (
+        const std::uint8_t  pBlock[16],
+        std::uint8_t        pPixels[64]
+    )
+    {
+        BlockBitReader lReader { pBlock };
+        if (lReader.Read(7) != (1 << 6))
+        {
+            ACE_THROW(std::runtime_error, "{}: Only mode 6 BC7 blocks can be decompressed!",
+                "TextureCompressor");
+        }
+
+        std::uint32_t lEndpoints[2][4];
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            lEndpoints[0][c] = lReader.Read(7);
+            lEndpoints[1][c] = lReader.Read(7);
+        }
+
+        const std::uint32_t lFirstParity = lReader.Read(1);
+        const std::uint32_t lSecondParity = lReader.Read(1);
+        for (std::size_t c = 0; c < 4; ++c)
+        {
+            lEndpoints[0][c] = (lEndpoints[0][c] << 1) | lFirstParity;
+            lEndpoints[1][c] = (lEndpoints[1][c] << 1) | lSecondParity;
+        }
+
+        for (std::size_t i = 0; i < 16; ++i)
+        {
+            const std::uint32_t lWeight = BC7_WEIGHTS[lReader.Read((i == 0) ? 3 : 4)];
+            for (std::size_t c = 0; c < 4; ++c)
+            {
+                pPixels[i * 4 + c] = static_cast<std::uint8_t>(
+                    ((64 - lWeight) * lEndpoints[0][c] + lWeight * lEndpoints[1][c] + 32) >> 6);
+            }
+        }
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::shared_ptr<Texture> TextureCompressor::Compress (
+        const Texture&      pTexture,
+        const TextureFormat pFormat,
+        ThreadPool*         pThreadPool,
+        const std::size_t   pRowsPerJob
+    )
+    {
+        if (pTexture.mFormat != TextureFormat::RGBA8 || Texture::IsBlockCompressed(pFormat) == false)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Only RGBA8 textures can be compressed, into a block format!",
+                "TextureCompressor");
+        }
+
+        auto lTexture = std::make_shared<Texture>();
+        lTexture->mFormat = pFormat;
+        lTexture->mSrgb = (pFormat != TextureFormat::BC5) ? pTexture.mSrgb : false;
+
+        const std::size_t lBlockSize = (pFormat == TextureFormat::BC1) ? 8 : 16;
+        for (const TextureMip& lSource : pTexture.mMips)
+        {
+            TextureMip lMip;
+            lMip.mWidth = lSource.mWidth;
+            lMip.mHeight = lSource.mHeight;
+            lMip.mData.resize(Texture::GetMipSize(pFormat, lMip.mWidth, lMip.mHeight));
+
+            const std::size_t lBlocksWide = (lMip.mWidth + 3) / 4;
+            TextureConversion::ForEachRows((lMip.mHeight + 3) / 4, pThreadPool, pRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    std::uint8_t lPixels[64];
+                    for (std::size_t y = pBegin; y < pEnd; ++y)
+                    {
+                        for (std::size_t x = 0; x < lBlocksWide; ++x)
+                        {
+                            GatherBlock(lSource, x, y, lPixels);
+
+                            std::uint8_t* lOut = lMip.mData.data() + (y * lBlocksWide + x) * lBlockSize;
+                            switch (pFormat)
+                            {
+                                case TextureFormat::BC1:
+                                    EncodeBC1(lPixels, lOut);
+                                    break;
+                                case TextureFormat::BC3:
+                                    EncodeBC4(lPixels, 3, lOut);
+                                    EncodeBC1(lPixels, lOut + 8);
+                                    break;
+                                case TextureFormat::BC5:
+                                    EncodeBC4(lPixels, 0, lOut);
+                                    EncodeBC4(lPixels, 1, lOut + 8);
+                                    break;
+                                default:
+                                    EncodeBC7(lPixels, lOut);
+                                    break;
+                            }
+                        }
+                    }
+                });
+
+            lTexture->mMips.push_back(std::move(lMip));
+        }
+
+        return lTexture;
+    }
+
+    std::shared_ptr<Texture> TextureCompressor::Decompress (
+        const Texture&      pTexture,
+        ThreadPool*         pThreadPool,
+        const std::size_t   pRowsPerJob
+    )
+    {
+        if (Texture::IsBlockCompressed(pTexture.mFormat) == false)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Only block-compressed textures can be decompressed!",
+                "TextureCompressor");
+        }
+
+        auto lTexture = std::make_shared<Texture>();
+        lTexture->mFormat = TextureFormat::RGBA8;
+        lTexture->mSrgb = pTexture.mSrgb;
+
+        const std::size_t lBlockSize = (pTexture.mFormat == TextureFormat::BC1) ? 8 : 16;
+        for (const TextureMip& lSource : pTexture.mMips)
+        {
+            TextureMip lMip;
+            lMip.mWidth = lSource.mWidth;
+            lMip.mHeight = lSource.mHeight;
+            lMip.mData.resize(Texture::GetMipSize(TextureFormat::RGBA8, lMip.mWidth, lMip.mHeight));
+
+            const std::size_t lBlocksWide = (lMip.mWidth + 3) / 4;
+            TextureConversion::ForEachRows((lMip.mHeight + 3) / 4, pThreadPool, pRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    std::uint8_t lPixels[64];
+                    for (std::size_t y = pBegin; y < pEnd; ++y)
+                    {
+                        for (std::size_t x = 0; x < lBlocksWide; ++x)
+                        {
+                            const std::uint8_t* lBlock = lSource.mData.data() + (y * lBlocksWide + x) * lBlockSize;
+                            switch (pTexture.mFormat)
+                            {
+                                case TextureFormat::BC1:
+                                    DecodeBC1(lBlock, lPixels, false);
+                                    break;
+                                case TextureFormat::BC3:
+                                    DecodeBC1(lBlock + 8, lPixels, true);
+                                    DecodeBC4(lBlock, lPixels, 3);
+                                    break;
+                                case TextureFormat::BC5:
+                                    DecodeBC4(lBlock, lPixels, 0);
+                                    DecodeBC4(lBlock + 8, lPixels, 1);
+                                    for (std::size_t i = 0; i < 16; ++i)
+                                    {
+                                        lPixels[i * 4 + 2] = 0;
+                                        lPixels[i * 4 + 3] = 0xFF;
+                                    }
+                                    break;
+                                default:
+                                    DecodeBC7(lBlock, lPixels);
+                                    break;
+                            }
+
+                            ScatterBlock(lMip, x, y, lPixels);
+                        }
+                    }
+                });
+
+            lTexture->mMips.push_back(std::move(lMip));
+        }
+
+        return lTexture;
+    }
+
+}
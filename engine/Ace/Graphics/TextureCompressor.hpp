@@ -0,0 +1,86 @@
+/**
+ * @file    Ace/Graphics/TextureCompressor.hpp
+ * @brief   Provides a static class which compresses textures into the BC1,
+ *          BC3, BC5 and BC7 block formats, and decompresses them again.
+ */
+
+#pragma once
+#include <Ace/Graphics/Texture.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A static class which compresses 8-bit textures into 4x4 block
+     *          formats, for cooking, so that they can be uploaded without
+     *          being decompressed.
+     *
+     * Each block's endpoints are found along the principal axis of its
+     * colours, then refined by least squares; the fitting and the index
+     * search use SSE2 where available. Rows of blocks are compressed in jobs,
+     * spread across a thread pool if one is given; the result is the same
+     * either way.
+     *
+     * - BC1 stores colour only, always in four-colour mode; alpha is dropped.
+     * - BC3 adds alpha as a BC4 block.
+     * - BC5 stores red and green as two BC4 blocks; the rest is dropped.
+     * - BC7 is written in mode 6 alone: one subset, RGBA endpoints and 4-bit
+     *   indices. This is the mode which suits most blocks, and skipping the
+     *   partitioned modes makes compression many times faster.
+     */
+    class ACE_API TextureCompressor final
+    {
+    public:
+
+        /**
+         * @brief   Compresses every mip of a texture.
+         *
+         * @param   pTexture    The texture, in @a `RGBA8`.
+         * @param   pFormat     The block format to compress into.
+         * @param   pThreadPool The thread pool to spread rows of blocks
+         *                      across, or `nullptr`. Must not be called from
+         *                      one of this pool's own workers.
+         * @param   pRowsPerJob The number of rows of blocks compressed by
+         *                      each job.
+         *
+         * @return  The compressed texture.
+         *
+         * @throw   `std::invalid_argument` if the texture is not @a `RGBA8`,
+         *          or the format is not block-compressed.
+         */
+        static std::shared_ptr<Texture> Compress (
+            const Texture&      pTexture,
+            const TextureFormat pFormat,
+            ThreadPool*         pThreadPool = nullptr,
+            const std::size_t   pRowsPerJob = 8
+        );
+
+        /**
+         * @brief   Decompresses every mip of a block-compressed texture into
+         *          @a `RGBA8`, for tools and for hardware which lacks the
+         *          format.
+         *
+         * BC7 blocks must be in mode 6, as @a `Compress` writes them.
+         *
+         * @param   pTexture    The texture.
+         * @param   pThreadPool The thread pool to spread rows of blocks
+         *                      across, or `nullptr`.
+         * @param   pRowsPerJob The number of rows of blocks decompressed by
+         *                      each job.
+         *
+         * @return  The decompressed texture.
+         *
+         * @throw   `std::invalid_argument` if the texture is not
+         *          block-compressed.
+         * @throw   `std::runtime_error` if a BC7 block is in a mode other than
+         *          6.
+         */
+        static std::shared_ptr<Texture> Decompress (
+            const Texture&      pTexture,
+            ThreadPool*         pThreadPool = nullptr,
+            const std::size_t   pRowsPerJob = 8
+        );
+
+    };
+
+}
@@ -0,0 +1,945 @@
+/**
+ * @file    Ace/Graphics/TextureLoaders.cpp
+ */
+
+#include <miniz.h>
+#include <Ace/Graphics/TextureCompressor.hpp>
+#include <Ace/Graphics/TextureLoaders.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    static std::uint16_t ReadU16 (
+        const std::uint8_t* pSource
+    )
+    {
+        return static_cast<std::uint16_t>(pSource[0] | (pSource[1] << 8));
+    }
+
+    static std::uint32_t ReadU32 (
+        const std::uint8_t* pSource
+    )
+    {
+        return ReadU16(pSource) |
+            (static_cast<std::uint32_t>(ReadU16(pSource + 2)) << 16);
+    }
+
+    static std::uint32_t ReadU32BigEndian (
+        const std::uint8_t* pSource
+    )
+    {
+        return
+            (static_cast<std::uint32_t>(pSource[0]) << 24) |
+            (static_cast<std::uint32_t>(pSource[1]) << 16) |
+            (static_cast<std::uint32_t>(pSource[2]) << 8) |
+            static_cast<std::uint32_t>(pSource[3]);
+    }
+
+    static constexpr std::uint32_t FourCC (
+        const char  pCode[5]
+    )
+    {
+        return
+            static_cast<std::uint32_t>(static_cast<std::uint8_t>(pCode[0])) |
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(pCode[1])) << 8) |
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(pCode[2])) << 16) |
+            (static_cast<std::uint32_t>(static_cast<std::uint8_t>(pCode[3])) << 24);
+    }
+
+    /**
+     * @brief   Reads the whole of a virtual file into memory.
+     */
+    static astd::byte_buffer ReadWholeFile (
+        IVirtualFile&   pFile
+    )
+    {
+        astd::byte_buffer lBuffer(pFile.GetSize());
+        if (pFile.Read(lBuffer.data(), lBuffer.size()) != lBuffer.size())
+        {
+            ACE_THROW(std::runtime_error, "{}: Could not read the whole file!",
+                "TextureLoaders");
+        }
+
+        return lBuffer;
+    }
+
+    /**
+     * @brief   The cache bucket cooked textures are stored in.
+     */
+    static constexpr std::string_view CACHE_BUCKET = "textures";
+
+    /**
+     * @brief   Forms the key a file's cooked texture is cached under, which
+     *          covers every setting that changes the result.
+     */
+    static std::uint64_t MakeCookedKey (
+        const astd::byte_buffer&    pFile,
+        const TextureLoaderSpec&    pSpec
+    )
+    {
+        const std::uint8_t lSettings[4] = {
+            static_cast<std::uint8_t>(pSpec.mCompression),
+            static_cast<std::uint8_t>(pSpec.mSrgb),
+            static_cast<std::uint8_t>(pSpec.mGenerateMips),
+            0
+        };
+
+        return ContentHash64(pFile, ContentHash64(lSettings, Texture::COOKED_VERSION));
+    }
+
+    /**
+     * @brief   Looks up a file's cooked texture, if the loaders' settings
+     *          cook textures into a cache.
+     *
+     * @return  The cooked texture, or `nullptr` if there is none, or it is
+     *          damaged or stale.
+     */
+    static std::shared_ptr<Texture> FindCookedTexture (
+        const astd::byte_buffer&    pFile,
+        const TextureLoaderSpec&    pSpec
+    )
+    {
+        if (pSpec.mCache == nullptr || Texture::IsBlockCompressed(pSpec.mCompression) == false)
+        {
+            return nullptr;
+        }
+
+        if (auto lData = pSpec.mCache->Get(CACHE_BUCKET, MakeCookedKey(pFile, pSpec)))
+        {
+            try
+            {
+                return Texture::Deserialize(*lData);
+            }
+            catch (const std::exception&)
+            {
+                // Damaged; fall through and cook again.
+            }
+        }
+
+        return nullptr;
+    }
+
+    /**
+     * @brief   Generates mips, then converts to linear space or compresses,
+     *          as the loaders' settings ask, for textures which are not
+     *          block-compressed; compressed textures are also cached.
+     */
+    static std::shared_ptr<Texture> FinishTexture (
+        std::shared_ptr<Texture>    pTexture,
+        const TextureLoaderSpec&    pSpec,
+        const astd::byte_buffer&    pFile
+    )
+    {
+        if (Texture::IsBlockCompressed(pTexture->mFormat) == true)
+        {
+            return pTexture;
+        }
+
+        if (pSpec.mGenerateMips == true && pTexture->mMips.size() == 1)
+        {
+            TextureConversion::GenerateMips(*pTexture, pSpec.mThreadPool, pSpec.mRowsPerJob);
+        }
+
+        if (Texture::IsBlockCompressed(pSpec.mCompression) == true && pTexture->mFormat == TextureFormat::RGBA8)
+        {
+            pTexture = TextureCompressor::Compress(*pTexture, pSpec.mCompression, pSpec.mThreadPool,
+                std::max<std::size_t>(pSpec.mRowsPerJob / 4, 1));
+            if (pSpec.mCache != nullptr)
+            {
+                pSpec.mCache->Put(CACHE_BUCKET, MakeCookedKey(pFile, pSpec), pTexture->Serialize());
+            }
+        }
+        else if (pSpec.mConvertToLinear == true && pTexture->mFormat == TextureFormat::RGBA8)
+        {
+            TextureConversion::ConvertToLinear(*pTexture, pSpec.mThreadPool, pSpec.mRowsPerJob);
+        }
+
+        return pTexture;
+    }
+
+    /**
+     * @brief   Checks that an image's dimensions, as read from its header, are
+     *          non-zero and no larger than @a `Texture::MAX_DIMENSION`. Every
+     *          loader checks this before sizing any buffer from them.
+     */
+    static bool IsValidSize (
+        const std::uint32_t pWidth,
+        const std::uint32_t pHeight
+    )
+    {
+        return
+            pWidth > 0 && pWidth <= Texture::MAX_DIMENSION &&
+            pHeight > 0 && pHeight <= Texture::MAX_DIMENSION;
+    }
+
+    /**
+     * @brief   Multiplies two sizes, failing rather than wrapping around.
+     *
+     * @return  The product, or `std::nullopt` if it does not fit.
+     */
+    static std::optional<std::size_t> CheckedMultiply (
+        const std::size_t   pFirst,
+        const std::size_t   pSecond
+    )
+    {
+        if (pSecond != 0 && pFirst > std::numeric_limits<std::size_t>::max() / pSecond)
+        {
+            return std::nullopt;
+        }
+
+        return pFirst * pSecond;
+    }
+
+    /**
+     * @brief   Reads the mips of a block-compressed or 8-bit texture stored one
+     *          after another, largest first, as in `.dds` files.
+     */
+    static void ReadPackedMips (
+        Texture&                    pTexture,
+        const astd::byte_buffer&    pFile,
+        std::size_t                 pOffset,
+        const std::uint32_t         pWidth,
+        const std::uint32_t         pHeight,
+        const std::size_t           pMipCount
+    )
+    {
+        for (std::size_t i = 0; i < pMipCount; ++i)
+        {
+            TextureMip lMip;
+            lMip.mWidth = std::max<std::uint32_t>(pWidth >> i, 1);
+            lMip.mHeight = std::max<std::uint32_t>(pHeight >> i, 1);
+
+            const std::size_t lSize = Texture::GetMipSize(pTexture.mFormat, lMip.mWidth, lMip.mHeight);
+            if (pOffset > pFile.size() || lSize > pFile.size() - pOffset)
+            {
+                ACE_THROW(std::runtime_error, "{}: The file ends partway through mip {}!",
+                    "TextureLoaders", i);
+            }
+
+            const bool lLast = (lMip.mWidth == 1 && lMip.mHeight == 1);
+            lMip.mData.assign(pFile.begin() + pOffset, pFile.begin() + pOffset + lSize);
+            pTexture.mMips.push_back(std::move(lMip));
+            pOffset += lSize;
+
+            if (lLast == true)
+            {
+                break;
+            }
+        }
+    }
+
+    /**
+     * @brief   Predicts a byte of a `.png` row from its neighbours, for the
+     *          Paeth filter.
+     */
+    static inline std::uint8_t PaethPredictor (
+        const std::int32_t  pLeft,
+        const std::int32_t  pAbove,
+        const std::int32_t  pAboveLeft
+    )
+    {
+        const std::int32_t lEstimate = pLeft + pAbove - pAboveLeft;
+        const std::int32_t lLeftDistance = std::abs(lEstimate - pLeft);
+        const std::int32_t lAboveDistance = std::abs(lEstimate - pAbove);
+        const std::int32_t lAboveLeftDistance = std::abs(lEstimate - pAboveLeft);
+        if (lLeftDistance <= lAboveDistance && lLeftDistance <= lAboveLeftDistance)
+        {
+            return static_cast<std::uint8_t>(pLeft);
+        }
+
+        return static_cast<std::uint8_t>((lAboveDistance <= lAboveLeftDistance) ? pAbove : pAboveLeft);
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    PngTextureLoader::PngTextureLoader (
+        const TextureLoaderSpec&    pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    TgaTextureLoader::TgaTextureLoader (
+        const TextureLoaderSpec&    pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    DdsTextureLoader::DdsTextureLoader (
+        const TextureLoaderSpec&    pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    KtxTextureLoader::KtxTextureLoader (
+        const TextureLoaderSpec&    pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    bool PngTextureLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".png");
+    }
+
+    std::shared_ptr<Texture> PngTextureLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        static constexpr std::array<std::uint8_t, 8> SIGNATURE = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+
+        try
+        {
+            const astd::byte_buffer lFile = ReadWholeFile(*pVirtualFile);
+            if (lFile.size() < SIGNATURE.size() || std::equal(SIGNATURE.begin(), SIGNATURE.end(), lFile.begin()) == false)
+            {
+                return nullptr;
+            }
+
+            if (auto lCooked = FindCookedTexture(lFile, mSpec))
+            {
+                return lCooked;
+            }
+
+            // Gather the header, palette and image data from the chunks.
+            std::uint32_t lWidth = 0;
+            std::uint32_t lHeight = 0;
+            std::uint8_t lDepth = 0;
+            std::uint8_t lColorType = 0;
+            std::uint8_t lInterlace = 0;
+            std::array<std::array<std::uint8_t, 4>, 256> lPalette {};
+            for (auto& lEntry : lPalette)
+            {
+                lEntry = { 0, 0, 0, 0xFF };
+            }
+
+            astd::byte_buffer lCompressed;
+            std::size_t lOffset = SIGNATURE.size();
+            while (lOffset + 12 <= lFile.size())
+            {
+                const std::uint32_t lLength = ReadU32BigEndian(lFile.data() + lOffset);
+                const std::uint32_t lType = FourCC(reinterpret_cast<const char*>(lFile.data() + lOffset + 4));
+                const std::uint8_t* lData = lFile.data() + lOffset + 8;
+                if (lOffset + 12 + std::size_t { lLength } > lFile.size())
+                {
+                    return nullptr;
+                }
+
+                if (lType == FourCC("IHDR") && lLength >= 13)
+                {
+                    lWidth = ReadU32BigEndian(lData);
+                    lHeight = ReadU32BigEndian(lData + 4);
+                    lDepth = lData[8];
+                    lColorType = lData[9];
+                    lInterlace = lData[12];
+                    if (IsValidSize(lWidth, lHeight) == false || lData[10] != 0 || lData[11] != 0)
+                    {
+                        return nullptr;
+                    }
+                }
+                else if (lType == FourCC("PLTE"))
+                {
+                    for (std::size_t i = 0; i < std::min<std::size_t>(lLength / 3, 256); ++i)
+                    {
+                        lPalette[i] = { lData[i * 3], lData[i * 3 + 1], lData[i * 3 + 2], 0xFF };
+                    }
+                }
+                else if (lType == FourCC("tRNS") && lColorType == 3)
+                {
+                    for (std::size_t i = 0; i < std::min<std::size_t>(lLength, 256); ++i)
+                    {
+                        lPalette[i][3] = lData[i];
+                    }
+                }
+                else if (lType == FourCC("IDAT"))
+                {
+                    lCompressed.insert(lCompressed.end(), lData, lData + lLength);
+                }
+                else if (lType == FourCC("IEND"))
+                {
+                    break;
+                }
+
+                lOffset += 12 + std::size_t { lLength };
+            }
+
+            std::size_t lChannels = 0;
+            switch (lColorType)
+            {
+                case 0: lChannels = 1; break;
+                case 2: lChannels = 3; break;
+                case 3: lChannels = 1; break;
+                case 4: lChannels = 2; break;
+                case 6: lChannels = 4; break;
+                default: return nullptr;
+            }
+
+            const bool lValidDepth =
+                (lDepth == 8) ||
+                (lDepth == 16 && lColorType != 3) ||
+                ((lDepth == 1 || lDepth == 2 || lDepth == 4) && (lColorType == 0 || lColorType == 3));
+            if (IsValidSize(lWidth, lHeight) == false || lValidDepth == false || lInterlace != 0)
+            {
+                return nullptr;
+            }
+
+            // Inflate the image data: each row is prefixed by its filter type.
+            const std::size_t lBitsPerPixel = lChannels * lDepth;
+            const std::size_t lRowBytes = (std::size_t { lWidth } * lBitsPerPixel + 7) / 8;
+            const std::size_t lFilterStride = std::max<std::size_t>(lBitsPerPixel / 8, 1);
+            const auto lFilteredSize = CheckedMultiply(lHeight, lRowBytes + 1);
+            const auto lPixelsSize = CheckedMultiply(lHeight, lRowBytes);
+            if (lFilteredSize.has_value() == false || lPixelsSize.has_value() == false)
+            {
+                return nullptr;
+            }
+
+            astd::byte_buffer lFiltered(*lFilteredSize);
+            const std::size_t lInflated = tinfl_decompress_mem_to_mem(lFiltered.data(), lFiltered.size(),
+                lCompressed.data(), lCompressed.size(), TINFL_FLAG_PARSE_ZLIB_HEADER);
+            if (lInflated != lFiltered.size())
+            {
+                return nullptr;
+            }
+
+            // Undo each row's filter. Rows depend on the rows above them, so
+            // this pass is serial.
+            astd::byte_buffer lPixels(*lPixelsSize);
+            for (std::size_t y = 0; y < lHeight; ++y)
+            {
+                const std::uint8_t lFilter = lFiltered[y * (lRowBytes + 1)];
+                const std::uint8_t* lSource = lFiltered.data() + y * (lRowBytes + 1) + 1;
+                std::uint8_t* lRow = lPixels.data() + y * lRowBytes;
+                const std::uint8_t* lAbove = (y > 0) ? lRow - lRowBytes : nullptr;
+                for (std::size_t i = 0; i < lRowBytes; ++i)
+                {
+                    const std::int32_t lLeft = (i >= lFilterStride) ? lRow[i - lFilterStride] : 0;
+                    const std::int32_t lUp = (lAbove != nullptr) ? lAbove[i] : 0;
+                    const std::int32_t lUpLeft = (lAbove != nullptr && i >= lFilterStride) ? lAbove[i - lFilterStride] : 0;
+                    std::int32_t lPrediction = 0;
+                    switch (lFilter)
+                    {
+                        case 0: lPrediction = 0; break;
+                        case 1: lPrediction = lLeft; break;
+                        case 2: lPrediction = lUp; break;
+                        case 3: lPrediction = (lLeft + lUp) / 2; break;
+                        case 4: lPrediction = PaethPredictor(lLeft, lUp, lUpLeft); break;
+                        default: return nullptr;
+                    }
+
+                    lRow[i] = static_cast<std::uint8_t>(lSource[i] + lPrediction);
+                }
+            }
+
+            // Convert the rows to RGBA, in parallel.
+            auto lTexture = std::make_shared<Texture>();
+            lTexture->mSrgb = mSpec.mSrgb;
+            TextureMip& lMip = lTexture->mMips.emplace_back();
+            lMip.mWidth = lWidth;
+            lMip.mHeight = lHeight;
+            lMip.mData.resize(Texture::GetMipSize(TextureFormat::RGBA8, lWidth, lHeight));
+
+            const std::uint32_t lMaxSample = (lDepth == 16) ? 0xFF : (1u << lDepth) - 1;
+            TextureConversion::ForEachRows(lHeight, mSpec.mThreadPool, mSpec.mRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    for (std::size_t y = pBegin; y < pEnd; ++y)
+                    {
+                        const std::uint8_t* lRow = lPixels.data() + y * lRowBytes;
+                        std::uint8_t* lOut = lMip.mData.data() + y * lWidth * 4;
+                        if (lDepth == 8 && lColorType == 6)
+                        {
+                            std::memcpy(lOut, lRow, lWidth * 4);
+                            continue;
+                        }
+                        else if (lDepth == 8 && lColorType == 2)
+                        {
+                            TextureConversion::ExpandRGBToRGBA(lRow, lOut, lWidth);
+                            continue;
+                        }
+
+                        // Everything else is read sample by sample, 16-bit
+                        // samples narrowed to their high byte.
+                        auto lSample =
+                            [&] (const std::size_t pIndex) -> std::uint32_t
+                            {
+                                if (lDepth == 16)
+                                {
+                                    return lRow[pIndex * 2];
+                                }
+                                else if (lDepth == 8)
+                                {
+                                    return lRow[pIndex];
+                                }
+
+                                const std::size_t lBit = pIndex * lDepth;
+                                return (lRow[lBit / 8] >> (8 - lDepth - (lBit % 8))) & lMaxSample;
+                            };
+
+                        for (std::size_t x = 0; x < lWidth; ++x)
+                        {
+                            std::uint8_t* lPixel = lOut + x * 4;
+                            if (lColorType == 3)
+                            {
+                                std::memcpy(lPixel, lPalette[lSample(x)].data(), 4);
+                                continue;
+                            }
+
+                            const std::size_t lFirst = x * lChannels;
+                            if (lColorType == 0 || lColorType == 4)
+                            {
+                                const auto lGrey = static_cast<std::uint8_t>(lSample(lFirst) * 255 / lMaxSample);
+                                lPixel[0] = lGrey;
+                                lPixel[1] = lGrey;
+                                lPixel[2] = lGrey;
+                                lPixel[3] = (lColorType == 4) ? static_cast<std::uint8_t>(lSample(lFirst + 1)) : 0xFF;
+                            }
+                            else
+                            {
+                                lPixel[0] = static_cast<std::uint8_t>(lSample(lFirst));
+                                lPixel[1] = static_cast<std::uint8_t>(lSample(lFirst + 1));
+                                lPixel[2] = static_cast<std::uint8_t>(lSample(lFirst + 2));
+                                lPixel[3] = (lColorType == 6) ? static_cast<std::uint8_t>(lSample(lFirst + 3)) : 0xFF;
+                            }
+                        }
+                    }
+                });
+
+            return FinishTexture(std::move(lTexture), mSpec, lFile);
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    bool TgaTextureLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".tga");
+    }
+
+    std::shared_ptr<Texture> TgaTextureLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        try
+        {
+            const astd::byte_buffer lFile = ReadWholeFile(*pVirtualFile);
+            if (lFile.size() < 18)
+            {
+                return nullptr;
+            }
+
+            if (auto lCooked = FindCookedTexture(lFile, mSpec))
+            {
+                return lCooked;
+            }
+
+            const std::uint8_t lImageType = lFile[2];
+            const std::uint32_t lWidth = ReadU16(lFile.data() + 12);
+            const std::uint32_t lHeight = ReadU16(lFile.data() + 14);
+            const std::size_t lBytesPerPixel = lFile[16] / 8;
+            const bool lTopDown = (lFile[17] & 0x20) != 0;
+            const bool lGrey = (lImageType == 3 || lImageType == 11);
+            const bool lEncoded = (lImageType == 10 || lImageType == 11);
+            if (
+                (lImageType != 2 && lImageType != 3 && lImageType != 10 && lImageType != 11) ||
+                IsValidSize(lWidth, lHeight) == false ||
+                (lGrey == true && lBytesPerPixel != 1) ||
+                (lGrey == false && lBytesPerPixel != 3 && lBytesPerPixel != 4)
+            )
+            {
+                return nullptr;
+            }
+
+            // Skip the image ID and any colour map.
+            const std::size_t lMapSize = (lFile[1] != 0) ? ReadU16(lFile.data() + 5) * ((lFile[7] + 7) / 8) : 0;
+            const std::size_t lDataOffset = 18 + lFile[0] + lMapSize;
+            const std::size_t lImageSize = std::size_t { lWidth } * lHeight * lBytesPerPixel;
+
+            // Run-length-encoded images are expanded first, serially, as a
+            // row's start can only be found by decoding the rows before it.
+            astd::byte_buffer lExpanded;
+            const std::uint8_t* lImage = lFile.data() + lDataOffset;
+            if (lEncoded == true)
+            {
+                lExpanded.resize(lImageSize);
+                std::size_t lRead = lDataOffset;
+                std::size_t lWritten = 0;
+                while (lWritten < lImageSize)
+                {
+                    if (lRead >= lFile.size())
+                    {
+                        return nullptr;
+                    }
+
+                    const std::uint8_t lPacket = lFile[lRead++];
+                    const std::size_t lBytes = std::min<std::size_t>(((lPacket & 0x7F) + 1) * lBytesPerPixel,
+                        lImageSize - lWritten);
+                    if ((lPacket & 0x80) != 0)
+                    {
+                        if (lRead + lBytesPerPixel > lFile.size())
+                        {
+                            return nullptr;
+                        }
+
+                        for (std::size_t i = 0; i < lBytes; i += lBytesPerPixel)
+                        {
+                            std::memcpy(lExpanded.data() + lWritten + i, lFile.data() + lRead, lBytesPerPixel);
+                        }
+
+                        lRead += lBytesPerPixel;
+                    }
+                    else
+                    {
+                        if (lRead + lBytes > lFile.size())
+                        {
+                            return nullptr;
+                        }
+
+                        std::memcpy(lExpanded.data() + lWritten, lFile.data() + lRead, lBytes);
+                        lRead += lBytes;
+                    }
+
+                    lWritten += lBytes;
+                }
+
+                lImage = lExpanded.data();
+            }
+            else if (lDataOffset + lImageSize > lFile.size())
+            {
+                return nullptr;
+            }
+
+            auto lTexture = std::make_shared<Texture>();
+            lTexture->mSrgb = mSpec.mSrgb;
+            TextureMip& lMip = lTexture->mMips.emplace_back();
+            lMip.mWidth = lWidth;
+            lMip.mHeight = lHeight;
+            lMip.mData.resize(Texture::GetMipSize(TextureFormat::RGBA8, lWidth, lHeight));
+
+            // Swizzle each row into place, flipping bottom-up images.
+            TextureConversion::ForEachRows(lHeight, mSpec.mThreadPool, mSpec.mRowsPerJob,
+                [&] (const std::size_t pBegin, const std::size_t pEnd)
+                {
+                    for (std::size_t y = pBegin; y < pEnd; ++y)
+                    {
+                        const std::size_t lSourceRow = lTopDown ? y : lHeight - 1 - y;
+                        const std::uint8_t* lRow = lImage + lSourceRow * lWidth * lBytesPerPixel;
+                        std::uint8_t* lOut = lMip.mData.data() + y * lWidth * 4;
+                        if (lBytesPerPixel == 1)
+                        {
+                            for (std::size_t x = 0; x < lWidth; ++x)
+                            {
+                                lOut[x * 4] = lRow[x];
+                                lOut[x * 4 + 1] = lRow[x];
+                                lOut[x * 4 + 2] = lRow[x];
+                                lOut[x * 4 + 3] = 0xFF;
+                            }
+
+                            continue;
+                        }
+
+                        if (lBytesPerPixel == 4)
+                        {
+                            std::memcpy(lOut, lRow, lWidth * 4);
+                        }
+                        else
+                        {
+                            TextureConversion::ExpandRGBToRGBA(lRow, lOut, lWidth);
+                        }
+
+                        TextureConversion::SwizzleBGRAToRGBA(lOut, lWidth);
+                    }
+                });
+
+            return FinishTexture(std::move(lTexture), mSpec, lFile);
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    bool DdsTextureLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".dds");
+    }
+
+    std::shared_ptr<Texture> DdsTextureLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        static constexpr std::uint32_t PIXEL_FORMAT_FOURCC = 0x4;
+        static constexpr std::uint32_t PIXEL_FORMAT_RGB = 0x40;
+        static constexpr std::uint32_t CAPS2_CUBEMAP = 0x200;
+        static constexpr std::uint32_t CAPS2_VOLUME = 0x200000;
+
+        try
+        {
+            const astd::byte_buffer lFile = ReadWholeFile(*pVirtualFile);
+            if (lFile.size() < 128 || ReadU32(lFile.data()) != FourCC("DDS ") || ReadU32(lFile.data() + 4) != 124)
+            {
+                return nullptr;
+            }
+
+            if (auto lCooked = FindCookedTexture(lFile, mSpec))
+            {
+                return lCooked;
+            }
+
+            const std::uint32_t lHeight = ReadU32(lFile.data() + 12);
+            const std::uint32_t lWidth = ReadU32(lFile.data() + 16);
+            const std::size_t lMipCount = std::max<std::uint32_t>(ReadU32(lFile.data() + 28), 1);
+            const std::uint32_t lPixelFlags = ReadU32(lFile.data() + 80);
+            const std::uint32_t lFourCC = ReadU32(lFile.data() + 84);
+            const std::uint32_t lBitCount = ReadU32(lFile.data() + 88);
+            const std::uint32_t lRedMask = ReadU32(lFile.data() + 92);
+            const std::uint32_t lAlphaMask = ReadU32(lFile.data() + 104);
+            const std::uint32_t lCaps2 = ReadU32(lFile.data() + 112);
+            if (IsValidSize(lWidth, lHeight) == false || (lCaps2 & (CAPS2_CUBEMAP | CAPS2_VOLUME)) != 0)
+            {
+                return nullptr;
+            }
+
+            auto lTexture = std::make_shared<Texture>();
+            std::size_t lOffset = 128;
+            bool lSwizzle = false;
+            bool lOpaque = false;
+            if ((lPixelFlags & PIXEL_FORMAT_FOURCC) != 0 && lFourCC == FourCC("DX10"))
+            {
+                if (lFile.size() < 148 || ReadU32(lFile.data() + 132) != 3 || ReadU32(lFile.data() + 140) > 1)
+                {
+                    return nullptr;
+                }
+
+                lOffset = 148;
+                switch (ReadU32(lFile.data() + 128))
+                {
+                    case 28: lTexture->mFormat = TextureFormat::RGBA8; break;
+                    case 29: lTexture->mFormat = TextureFormat::RGBA8; lTexture->mSrgb = true; break;
+                    case 71: lTexture->mFormat = TextureFormat::BC1; break;
+                    case 72: lTexture->mFormat = TextureFormat::BC1; lTexture->mSrgb = true; break;
+                    case 77: lTexture->mFormat = TextureFormat::BC3; break;
+                    case 78: lTexture->mFormat = TextureFormat::BC3; lTexture->mSrgb = true; break;
+                    case 83: lTexture->mFormat = TextureFormat::BC5; break;
+                    case 98: lTexture->mFormat = TextureFormat::BC7; break;
+                    case 99: lTexture->mFormat = TextureFormat::BC7; lTexture->mSrgb = true; break;
+                    default: return nullptr;
+                }
+            }
+            else if ((lPixelFlags & PIXEL_FORMAT_FOURCC) != 0)
+            {
+                // The legacy codes do not say whether colour is sRGB-encoded,
+                // so the loader's setting decides; BC5 holds data, not colour.
+                if (lFourCC == FourCC("DXT1"))
+                {
+                    lTexture->mFormat = TextureFormat::BC1;
+                }
+                else if (lFourCC == FourCC("DXT5"))
+                {
+                    lTexture->mFormat = TextureFormat::BC3;
+                }
+                else if (lFourCC == FourCC("ATI2") || lFourCC == FourCC("BC5U"))
+                {
+                    lTexture->mFormat = TextureFormat::BC5;
+                }
+                else
+                {
+                    return nullptr;
+                }
+
+                lTexture->mSrgb = (lTexture->mFormat != TextureFormat::BC5) && mSpec.mSrgb;
+            }
+            else if ((lPixelFlags & PIXEL_FORMAT_RGB) != 0 && lBitCount == 32 &&
+                (lRedMask == 0x000000FF || lRedMask == 0x00FF0000))
+            {
+                lTexture->mFormat = TextureFormat::RGBA8;
+                lTexture->mSrgb = mSpec.mSrgb;
+                lSwizzle = (lRedMask == 0x00FF0000);
+                lOpaque = (lAlphaMask == 0);
+            }
+            else
+            {
+                return nullptr;
+            }
+
+            ReadPackedMips(*lTexture, lFile, lOffset, lWidth, lHeight, lMipCount);
+
+            // Uncompressed BGRA or BGRX pixels are brought into RGBA order.
+            if (lSwizzle == true || lOpaque == true)
+            {
+                for (TextureMip& lMip : lTexture->mMips)
+                {
+                    TextureConversion::ForEachRows(lMip.mHeight, mSpec.mThreadPool, mSpec.mRowsPerJob,
+                        [&] (const std::size_t pBegin, const std::size_t pEnd)
+                        {
+                            std::uint8_t* lRows = lMip.mData.data() + pBegin * lMip.mWidth * 4;
+                            const std::size_t lPixelCount = (pEnd - pBegin) * lMip.mWidth;
+                            if (lSwizzle == true)
+                            {
+                                TextureConversion::SwizzleBGRAToRGBA(lRows, lPixelCount);
+                            }
+
+                            if (lOpaque == true)
+                            {
+                                for (std::size_t i = 0; i < lPixelCount; ++i)
+                                {
+                                    lRows[i * 4 + 3] = 0xFF;
+                                }
+                            }
+                        });
+                }
+            }
+
+            return FinishTexture(std::move(lTexture), mSpec, lFile);
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    bool KtxTextureLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".ktx");
+    }
+
+    std::shared_ptr<Texture> KtxTextureLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        (void) pLogicalPath;
+        static constexpr std::array<std::uint8_t, 12> IDENTIFIER = {
+            0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n'
+        };
+        static constexpr std::uint32_t GL_UNSIGNED_BYTE = 0x1401;
+
+        try
+        {
+            const astd::byte_buffer lFile = ReadWholeFile(*pVirtualFile);
+            if (
+                lFile.size() < 64 ||
+                std::equal(IDENTIFIER.begin(), IDENTIFIER.end(), lFile.begin()) == false ||
+                ReadU32(lFile.data() + 12) != 0x04030201
+            )
+            {
+                return nullptr;
+            }
+
+            if (auto lCooked = FindCookedTexture(lFile, mSpec))
+            {
+                return lCooked;
+            }
+
+            const std::uint32_t lType = ReadU32(lFile.data() + 16);
+            const std::uint32_t lInternalFormat = ReadU32(lFile.data() + 28);
+            const std::uint32_t lWidth = ReadU32(lFile.data() + 36);
+            const std::uint32_t lHeight = ReadU32(lFile.data() + 40);
+            const std::uint32_t lDepth = ReadU32(lFile.data() + 44);
+            const std::uint32_t lArrayElements = ReadU32(lFile.data() + 48);
+            const std::uint32_t lFaces = ReadU32(lFile.data() + 52);
+            const std::size_t lMipCount = std::max<std::uint32_t>(ReadU32(lFile.data() + 56), 1);
+            const std::size_t lKeyValueBytes = ReadU32(lFile.data() + 60);
+            if (IsValidSize(lWidth, lHeight) == false || lDepth > 1 || lArrayElements > 0 || lFaces != 1)
+            {
+                return nullptr;
+            }
+
+            auto lTexture = std::make_shared<Texture>();
+            switch (lInternalFormat)
+            {
+                case 0x8058: lTexture->mFormat = TextureFormat::RGBA8; break;
+                case 0x8C43: lTexture->mFormat = TextureFormat::RGBA8; lTexture->mSrgb = true; break;
+                case 0x83F0:
+                case 0x83F1: lTexture->mFormat = TextureFormat::BC1; break;
+                case 0x8C4C:
+                case 0x8C4D: lTexture->mFormat = TextureFormat::BC1; lTexture->mSrgb = true; break;
+                case 0x83F3: lTexture->mFormat = TextureFormat::BC3; break;
+                case 0x8C4F: lTexture->mFormat = TextureFormat::BC3; lTexture->mSrgb = true; break;
+                case 0x8DBD: lTexture->mFormat = TextureFormat::BC5; break;
+                case 0x8E8C: lTexture->mFormat = TextureFormat::BC7; break;
+                case 0x8E8D: lTexture->mFormat = TextureFormat::BC7; lTexture->mSrgb = true; break;
+                default: return nullptr;
+            }
+
+            if (lTexture->mFormat == TextureFormat::RGBA8 && lType != GL_UNSIGNED_BYTE)
+            {
+                return nullptr;
+            }
+
+            // Each mip is preceded by its size, and padded to four bytes.
+            std::size_t lOffset = 64 + lKeyValueBytes;
+            for (std::size_t i = 0; i < lMipCount; ++i)
+            {
+                if (lOffset + 4 > lFile.size())
+                {
+                    return nullptr;
+                }
+
+                const std::size_t lSize = ReadU32(lFile.data() + lOffset);
+                const std::uint32_t lMipWidth = std::max<std::uint32_t>(lWidth >> i, 1);
+                const std::uint32_t lMipHeight = std::max<std::uint32_t>(lHeight >> i, 1);
+                if (lSize != Texture::GetMipSize(lTexture->mFormat, lMipWidth, lMipHeight))
+                {
+                    return nullptr;
+                }
+
+                ReadPackedMips(*lTexture, lFile, lOffset + 4, lMipWidth, lMipHeight, 1);
+                lOffset += 4 + ((lSize + 3) & ~std::size_t { 3 });
+            }
+
+            return FinishTexture(std::move(lTexture), mSpec, lFile);
+        }
+        catch (const std::exception&)
+        {
+            return nullptr;
+        }
+    }
+
+    void TextureLoaders::RegisterAll (
+        const TextureLoaderSpec&    pSpec,
+        const std::size_t           pPriority
+    )
+    {
+        AssetRegistry::RegisterAssetLoader<Texture>(std::make_shared<PngTextureLoader>(pSpec), pPriority);
+        AssetRegistry::RegisterAssetLoader<Texture>(std::make_shared<TgaTextureLoader>(pSpec), pPriority);
+        AssetRegistry::RegisterAssetLoader<Texture>(std::make_shared<DdsTextureLoader>(pSpec), pPriority);
+        AssetRegistry::RegisterAssetLoader<Texture>(std::make_shared<KtxTextureLoader>(pSpec), pPriority);
+    }
+
+}
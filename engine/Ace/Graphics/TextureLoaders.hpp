@@ -0,0 +1,209 @@
+/**
+ * @file    Ace/Graphics/TextureLoaders.hpp
+ * @brief   Provides asset loaders which decode @a `Texture`s from `.png`,
+ *          `.tga`, `.dds` and `.ktx` files.
+ */
+
+#pragma once
+#include <Ace/Graphics/Texture.hpp>
+#include <Ace/System/AssetRegistry.hpp>
+#include <Ace/System/DerivedDataCache.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing the settings the texture loaders decode
+     *          with.
+     *
+     * If a compression format is given, uncompressed images are compressed
+     * into it once decoded, and @a `mConvertToLinear` is ignored. With a
+     * cache too, the compressed texture is stored in the cache under the hash
+     * of the source file and these settings, and later loads of an unchanged
+     * file read it back as it is, neither decoding nor compressing.
+     */
+    struct TextureLoaderSpec
+    {
+        ThreadPool*                         mThreadPool = nullptr;                  ///< @brief The thread pool to spread rows across, or `nullptr` to decode on the loading thread.
+        std::size_t                         mRowsPerJob = 64;                       ///< @brief The number of rows converted or filtered by each job.
+        bool                                mSrgb = true;                           ///< @brief Treat the colour of `.png` and `.tga` images, and of ambiguous `.dds` formats, as sRGB-encoded?
+        bool                                mGenerateMips = true;                   ///< @brief Generate a full mip chain for uncompressed images which lack one?
+        bool                                mConvertToLinear = false;               ///< @brief Convert uncompressed images to linear @a `RGBA32F`?
+        TextureFormat                       mCompression = TextureFormat::RGBA8;    ///< @brief The block format to compress uncompressed images into, or @a `RGBA8` to leave them be.
+        std::shared_ptr<DerivedDataCache>   mCache = nullptr;                       ///< @brief The cache compressed textures are stored in, or `nullptr` to compress on every load.
+    };
+
+    /**
+     * @brief   An asset loader which decodes @a `Texture`s from `.png` files.
+     *
+     * Every colour type is supported, at every bit depth, as are palette
+     * transparency and 16-bit samples, which are narrowed to 8 bits.
+     * Interlaced images are not supported. The image data is inflated with
+     * `miniz` and unfiltered row by row, as each row depends on the one
+     * above; conversion to @a `RGBA8` is then spread across rows.
+     */
+    class ACE_API PngTextureLoader final : public IAssetLoader<Texture>
+    {
+    public:
+
+        /**
+         * @brief   Constructs a loader.
+         *
+         * @param   pSpec   The loader's settings.
+         */
+        explicit PngTextureLoader (
+            const TextureLoaderSpec&    pSpec = {}
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Texture> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    private:
+        TextureLoaderSpec   mSpec;  ///< @brief The loader's settings.
+
+    };
+
+    /**
+     * @brief   An asset loader which decodes @a `Texture`s from `.tga` files.
+     *
+     * Uncompressed and run-length-encoded true-colour and greyscale images
+     * are supported, at 8, 24 or 32 bits per pixel. Run-length decoding is
+     * serial; swizzling into @a `RGBA8` is spread across rows.
+     */
+    class ACE_API TgaTextureLoader final : public IAssetLoader<Texture>
+    {
+    public:
+
+        /**
+         * @brief   Constructs a loader.
+         *
+         * @param   pSpec   The loader's settings.
+         */
+        explicit TgaTextureLoader (
+            const TextureLoaderSpec&    pSpec = {}
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Texture> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    private:
+        TextureLoaderSpec   mSpec;  ///< @brief The loader's settings.
+
+    };
+
+    /**
+     * @brief   An asset loader which reads @a `Texture`s, mips and all, from
+     *          `.dds` files.
+     *
+     * BC1, BC3, BC5 and BC7 blocks are passed through as stored, through
+     * either the legacy four-character codes or the `DX10` header. 32-bit
+     * uncompressed RGBA and BGRA images are also supported.
+     */
+    class ACE_API DdsTextureLoader final : public IAssetLoader<Texture>
+    {
+    public:
+
+        /**
+         * @brief   Constructs a loader.
+         *
+         * @param   pSpec   The loader's settings.
+         */
+        explicit DdsTextureLoader (
+            const TextureLoaderSpec&    pSpec = {}
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Texture> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    private:
+        TextureLoaderSpec   mSpec;  ///< @brief The loader's settings.
+
+    };
+
+    /**
+     * @brief   An asset loader which reads @a `Texture`s, mips and all, from
+     *          little-endian KTX 1 files.
+     *
+     * 2D textures in `GL_RGBA8`, `GL_SRGB8_ALPHA8`, or the S3TC, RGTC and
+     * BPTC formats matching BC1, BC3, BC5 and BC7, are supported.
+     */
+    class ACE_API KtxTextureLoader final : public IAssetLoader<Texture>
+    {
+    public:
+
+        /**
+         * @brief   Constructs a loader.
+         *
+         * @param   pSpec   The loader's settings.
+         */
+        explicit KtxTextureLoader (
+            const TextureLoaderSpec&    pSpec = {}
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<Texture> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+    private:
+        TextureLoaderSpec   mSpec;  ///< @brief The loader's settings.
+
+    };
+
+    /**
+     * @brief   A static class used for registering every built-in texture
+     *          loader at once.
+     */
+    class ACE_API TextureLoaders final
+    {
+    public:
+
+        /**
+         * @brief   Registers the `.png`, `.tga`, `.dds` and `.ktx` loaders with
+         *          the @a `AssetRegistry`.
+         *
+         * @param   pSpec       The settings every loader decodes with.
+         * @param   pPriority   The loaders' priority.
+         */
+        static void RegisterAll (
+            const TextureLoaderSpec&    pSpec = {},
+            const std::size_t           pPriority = 0
+        );
+
+    };
+
+}
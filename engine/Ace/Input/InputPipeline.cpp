@@ -0,0 +1,163 @@
+/**
+ * @file    Ace/Input/InputPipeline.cpp
+ */
+
+#include <Ace/Input/InputPipeline.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    InputPipeline::InputPipeline () :
+        mRecords { std::make_unique<SpscRingBuffer<InputRecord, CAPACITY>>() }
+    {
+        // A single sample can consume at most a full ring's worth of records.
+        mFrameRecords.reserve(CAPACITY);
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::uint64_t InputPipeline::Now ()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()
+        ).count();
+    }
+
+    void InputPipeline::Sample (
+        const std::uint64_t&    pSampleTime
+    )
+    {
+        // Clear the previous frame's edges and accumulated motion; held states
+        // carry over.
+        for (auto& lAction : mSnapshot.mActions)
+        {
+            lAction.mPressed = false;
+            lAction.mReleased = false;
+            lAction.mPressCount = 0;
+        }
+
+        mSnapshot.mMouseDelta = {};
+        mSnapshot.mScrollDelta = {};
+        mFrameRecords.clear();
+
+        // Consume every record up to the sample time in one batch.
+        mRecords->DequeueWhile(
+            [this, &pSampleTime] (const InputRecord& pRecord)
+            {
+                if (pRecord.mTimestamp > pSampleTime)
+                {
+                    return false;
+                }
+
+                mFrameRecords.push_back(pRecord);
+                Apply(pRecord);
+                return true;
+            }
+        );
+
+        mSnapshot.mFrame += 1;
+        mSnapshot.mSampleTime = pSampleTime;
+    }
+
+    void InputPipeline::BindAction (
+        const std::size_t&  pAction,
+        const InputSource   pSource,
+        const std::uint32_t pCode
+    )
+    {
+        BoundInput& lInput = mBindings[MakeBindingKey(pSource, pCode)];
+        if (
+            std::find(lInput.mActions.begin(), lInput.mActions.end(), pAction) !=
+                lInput.mActions.end()
+        )
+        {
+            return;
+        }
+
+        lInput.mActions.push_back(pAction);
+        if (pAction >= mSnapshot.mActions.size())
+        {
+            mSnapshot.mActions.resize(pAction + 1);
+            mHeldCounts.resize(pAction + 1, 0);
+        }
+
+        // If the input is already held, so is the action.
+        if (lInput.mDown == true)
+        {
+            mHeldCounts[pAction] += 1;
+            mSnapshot.mActions[pAction].mDown = true;
+        }
+    }
+
+    void InputPipeline::ClearBindings ()
+    {
+        mBindings.clear();
+        mHeldCounts.clear();
+        mSnapshot.mActions.clear();
+    }
+
+    /* Private Methods ********************************************************/
+
+    void InputPipeline::Apply (
+        const InputRecord&  pRecord
+    )
+    {
+        InputSource lSource = InputSource::Key;
+        bool lDown = false;
+        switch (pRecord.mType)
+        {
+            case InputEventType::KeyDown:
+                lDown = true;
+                break;
+            case InputEventType::KeyUp:
+                break;
+            case InputEventType::MouseButtonDown:
+                lSource = InputSource::MouseButton;
+                lDown = true;
+                break;
+            case InputEventType::MouseButtonUp:
+                lSource = InputSource::MouseButton;
+                break;
+            case InputEventType::MouseMoved:
+                mSnapshot.mMousePosition = { pRecord.mX, pRecord.mY };
+                return;
+            case InputEventType::MouseDelta:
+                mSnapshot.mMouseDelta += Vector2f { pRecord.mX, pRecord.mY };
+                return;
+            case InputEventType::MouseScrolled:
+                mSnapshot.mScrollDelta += Vector2f { pRecord.mX, pRecord.mY };
+                return;
+        }
+
+        auto lIter = mBindings.find(MakeBindingKey(lSource, pRecord.mCode));
+        if (lIter == mBindings.end() || lIter->second.mDown == lDown)
+        {
+            // Unbound inputs and auto-repeats do not change any action.
+            return;
+        }
+
+        BoundInput& lInput = lIter->second;
+        lInput.mDown = lDown;
+
+        // An action goes down with the first of its inputs to be held, and up
+        // with the last of them to be released.
+        for (const auto& lIndex : lInput.mActions)
+        {
+            ActionState& lAction = mSnapshot.mActions[lIndex];
+            if (lDown == true && mHeldCounts[lIndex]++ == 0)
+            {
+                lAction.mDown = true;
+                lAction.mPressed = true;
+                lAction.mPressCount += 1;
+            }
+            else if (lDown == false && --mHeldCounts[lIndex] == 0)
+            {
+                lAction.mDown = false;
+                lAction.mReleased = true;
+            }
+        }
+    }
+
+}
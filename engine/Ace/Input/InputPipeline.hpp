@@ -0,0 +1,276 @@
+/**
+ * @file    Ace/Input/InputPipeline.hpp
+ * @brief   Provides a class which carries timestamped input from the platform
+ *          thread to the game thread, and derives per-frame action states from
+ *          it.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Maths/Vector2.hpp>
+#include <Ace/System/SpscRingBuffer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the kinds of input an @a `InputRecord` can describe.
+     */
+    enum class InputEventType : std::uint8_t
+    {
+        KeyDown,            ///< @brief A key was pressed, or auto-repeated.
+        KeyUp,              ///< @brief A key was released.
+        MouseButtonDown,    ///< @brief A mouse button was pressed.
+        MouseButtonUp,      ///< @brief A mouse button was released.
+        MouseMoved,         ///< @brief The pointer moved to an absolute position.
+        MouseDelta,         ///< @brief The mouse reported raw, relative motion.
+        MouseScrolled       ///< @brief The scroll wheel moved.
+    };
+
+    /**
+     * @brief   A fixed-size structure describing a single piece of input, and
+     *          when it happened.
+     *
+     * Key and button codes are opaque to the pipeline; they are defined by
+     * whichever platform layer produces the records.
+     */
+    struct InputRecord
+    {
+        std::uint64_t   mTimestamp = 0;                     ///< @brief When the input happened, as returned by @a `InputPipeline::Now`.
+        InputEventType  mType = InputEventType::KeyDown;    ///< @brief The kind of input.
+        std::uint32_t   mCode = 0;                          ///< @brief The key or button code, for key and button input.
+        float           mX = 0.0f;                          ///< @brief The X position, motion or scroll amount, for mouse input.
+        float           mY = 0.0f;                          ///< @brief The Y position, motion or scroll amount, for mouse input.
+    };
+
+    static_assert(std::is_trivially_copyable_v<InputRecord>,
+        "'ace::InputRecord' must be trivially copyable.");
+
+    /**
+     * @brief   Enumerates the inputs which actions can be bound to.
+     */
+    enum class InputSource : std::uint8_t
+    {
+        Key,            ///< @brief A keyboard key.
+        MouseButton     ///< @brief A mouse button.
+    };
+
+    /**
+     * @brief   A structure containing one action's state for one frame.
+     */
+    struct ActionState
+    {
+        bool            mDown = false;      ///< @brief Is any input bound to the action held, as of the frame's sample time?
+        bool            mPressed = false;   ///< @brief Did the action go down during the frame?
+        bool            mReleased = false;  ///< @brief Did the action go up during the frame?
+        std::uint32_t   mPressCount = 0;    ///< @brief How many times the action went down during the frame, counting taps shorter than a frame.
+    };
+
+    /**
+     * @brief   A structure containing the state of all actions, and of the
+     *          mouse, as of one frame's sample time.
+     */
+    struct InputSnapshot
+    {
+        std::uint64_t               mFrame = 0;         ///< @brief The number of frames sampled so far, including this one.
+        std::uint64_t               mSampleTime = 0;    ///< @brief The time up to which input was sampled for this frame.
+        std::vector<ActionState>    mActions;           ///< @brief The actions' states, indexed by action.
+        Vector2f                    mMousePosition;     ///< @brief The pointer's latest absolute position.
+        Vector2f                    mMouseDelta;        ///< @brief The raw mouse motion accumulated over the frame.
+        Vector2f                    mScrollDelta;       ///< @brief The scrolling accumulated over the frame.
+
+        /**
+         * @brief   Retrieves the state of the given action.
+         *
+         * @param   pAction     The action's index.
+         *
+         * @return  The action's state, or a released state if no input has
+         *          ever been bound to the action.
+         */
+        inline const ActionState& GetAction (
+            const std::size_t&  pAction
+        ) const
+        {
+            static const ActionState NONE {};
+            return (pAction < mActions.size()) ? mActions[pAction] : NONE;
+        }
+    };
+
+    /**
+     * @brief   A class which carries timestamped input from the platform
+     *          thread to the game thread, and derives per-frame action states
+     *          from it.
+     *
+     * The platform thread pushes fixed-size @a `InputRecord`s into a lock-free
+     * @a `SpscRingBuffer`, which neither allocates nor takes locks, no matter
+     * how high the rate of input. Once per frame, at a fixed point in the
+     * frame, the game thread samples every record up to that point in one
+     * batch, updating an @a `InputSnapshot` of the actions bound to keys and
+     * buttons.
+     */
+    class ACE_API InputPipeline final
+    {
+    public:
+
+        /**
+         * @brief   The maximum number of records which can be waiting to be
+         *          sampled.
+         */
+        static constexpr std::size_t CAPACITY = 4096;
+
+    public:
+
+        /**
+         * @brief   The default constructor.
+         */
+        explicit InputPipeline ();
+
+    public:
+
+        /**
+         * @brief   Retrieves the current time, in the clock that input records
+         *          are timestamped with.
+         *
+         * @return  The current time, in nanoseconds.
+         */
+        static std::uint64_t Now ();
+
+        /**
+         * @brief   Pushes a record into the pipeline. May only be called from
+         *          the one platform thread which produces input.
+         *
+         * @param   pRecord     The record to push.
+         *
+         * @return  `true` if the record is pushed; `false` if the pipeline is
+         *          full, and the record was dropped.
+         */
+        inline bool Push (
+            const InputRecord&  pRecord
+        )
+        {
+            if (mRecords->Enqueue(pRecord) == false)
+            {
+                mDroppedCount.fetch_add(1, std::memory_order_relaxed);
+                return false;
+            }
+
+            return true;
+        }
+
+        /**
+         * @brief   Samples every record timestamped up to the given time, and
+         *          updates the snapshot from them. May only be called from the
+         *          game thread.
+         *
+         * Records timestamped after the sample time are left for the next
+         * frame.
+         *
+         * @param   pSampleTime     The time up to which to sample.
+         */
+        void Sample (
+            const std::uint64_t&    pSampleTime = Now()
+        );
+
+        /**
+         * @brief   Binds an action to a key or mouse button. An action is down
+         *          while any of its bound inputs are held.
+         *
+         * This method must not be called while another thread is sampling.
+         *
+         * @param   pAction     The action's index.
+         * @param   pSource     The kind of input being bound.
+         * @param   pCode       The key or button code being bound.
+         */
+        void BindAction (
+            const std::size_t&  pAction,
+            const InputSource   pSource,
+            const std::uint32_t pCode
+        );
+
+        /**
+         * @brief   Removes all action bindings, and releases all actions.
+         */
+        void ClearBindings ();
+
+        /**
+         * @brief   Retrieves the snapshot derived from the most recent sample.
+         *
+         * @return  The current snapshot.
+         */
+        inline const InputSnapshot& GetSnapshot () const
+        {
+            return mSnapshot;
+        }
+
+        /**
+         * @brief   Retrieves the records consumed by the most recent sample, in
+         *          the order they were pushed.
+         *
+         * @return  This frame's records.
+         */
+        inline std::span<const InputRecord> GetFrameRecords () const
+        {
+            return mFrameRecords;
+        }
+
+        /**
+         * @brief   Retrieves the total number of records dropped because the
+         *          pipeline was full.
+         *
+         * @return  The number of dropped records.
+         */
+        inline std::size_t GetDroppedCount () const
+        {
+            return mDroppedCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+
+        /**
+         * @brief   A structure containing a bound input's held state, and the
+         *          actions bound to it.
+         */
+        struct BoundInput
+        {
+            bool                        mDown = false;  ///< @brief Is the input held?
+            std::vector<std::size_t>    mActions;       ///< @brief The indices of the actions bound to the input.
+        };
+
+    private:
+
+        /**
+         * @brief   Applies a single record to the snapshot.
+         *
+         * @param   pRecord     The record to apply.
+         */
+        void Apply (
+            const InputRecord&  pRecord
+        );
+
+        /**
+         * @brief   Packs a bound input's source and code into a lookup key.
+         *
+         * @param   pSource     The kind of input.
+         * @param   pCode       The key or button code.
+         *
+         * @return  The lookup key.
+         */
+        static constexpr std::uint64_t MakeBindingKey (
+            const InputSource   pSource,
+            const std::uint32_t pCode
+        )
+        {
+            return (static_cast<std::uint64_t>(pSource) << 32) | pCode;
+        }
+
+    private:
+        std::unique_ptr<SpscRingBuffer<InputRecord, CAPACITY>>  mRecords;               ///< @brief The records waiting to be sampled.
+        std::atomic<std::size_t>                                mDroppedCount { 0 };    ///< @brief The number of records dropped because the pipeline was full.
+        std::vector<InputRecord>                                mFrameRecords;          ///< @brief The records consumed by the most recent sample.
+        std::unordered_map<std::uint64_t, BoundInput>           mBindings;              ///< @brief The bound inputs, keyed by source and code.
+        std::vector<std::uint32_t>                              mHeldCounts;            ///< @brief The number of bound inputs held per action.
+        InputSnapshot                                           mSnapshot;              ///< @brief The snapshot derived from the most recent sample.
+
+    };
+
+}
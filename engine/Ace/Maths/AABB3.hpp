@@ -0,0 +1,369 @@
+/**
+ * @file    Ace/Maths/AABB3.hpp
+ * @brief   Contains a 3D axis-aligned bounding box structure.
+ */
+
+#pragma once
+#include <Ace/Maths/Vector3.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A 3D axis-aligned bounding box (AABB), represented by its
+     *          minimum and maximum corner points.
+     *
+     * @tparam  T   The numeric types of the box's corner components.
+     */
+    template <Numeric T>
+    struct AABB3
+    {
+        Vector3<T> mMin;    ///< @brief The box's minimum corner point.
+        Vector3<T> mMax;    ///< @brief The box's maximum corner point.
+
+    public:
+
+        /**
+         * @brief   The default constructor creates a degenerate box, with both
+         *          corners at the origin.
+         */
+        constexpr AABB3<T> () noexcept :
+            mMin    { Vector3<T>::Zero() },
+            mMax    { Vector3<T>::Zero() }
+        {}
+
+        /**
+         * @brief   Constructs a box from the given corner points.
+         *
+         * @param   pMin    The box's minimum corner point.
+         * @param   pMax    The box's maximum corner point.
+         */
+        constexpr AABB3<T> (
+            const Vector3<T>&   pMin,
+            const Vector3<T>&   pMax
+        ) noexcept :
+            mMin    { pMin },
+            mMax    { pMax }
+        {}
+
+    public:
+
+        /**
+         * @brief   Constructs an empty, inverted box, whose minimum corner is
+         *          at the type's highest value and whose maximum corner is at
+         *          its lowest value.
+         *
+         * Merging any point or box into an empty box yields that point or box,
+         * which makes this the natural starting value for accumulating bounds.
+         *
+         * @return  The constructed box.
+         */
+        static constexpr AABB3<T> Empty () noexcept
+        {
+            constexpr T lHighest = std::numeric_limits<T>::max();
+            constexpr T lLowest  = std::numeric_limits<T>::lowest();
+
+            return AABB3<T> {
+                Vector3<T> { lHighest, lHighest, lHighest },
+                Vector3<T> { lLowest, lLowest, lLowest }
+            };
+        }
+
+        /**
+         * @brief   Constructs a box from its center point and half-extents.
+         *
+         * @param   pCenter     The box's center point.
+         * @param   pExtents    The box's half-size along each axis.
+         *
+         * @return  The constructed box.
+         */
+        static constexpr AABB3<T> FromCenterExtents (
+            const Vector3<T>&   pCenter,
+            const Vector3<T>&   pExtents
+        ) noexcept
+        {
+            return AABB3<T> { pCenter - pExtents, pCenter + pExtents };
+        }
+
+    public:
+
+        /**
+         * @brief   Checks to see if this box's and the given box's corners are
+         *          equal.
+         *
+         * @param   pOther  The other box.
+         *
+         * @return  `true` if the boxes are equal; `false` otherwise.
+         */
+        constexpr bool operator== (
+            const AABB3<T>& pOther
+        ) const noexcept
+        {
+            return mMin == pOther.mMin && mMax == pOther.mMax;
+        }
+
+    public:
+
+        /**
+         * @brief   Retrieves whether or not this box is empty; that is, if its
+         *          minimum corner lies beyond its maximum corner on any axis.
+         *
+         * @return  `true` if the box is empty; `false` otherwise.
+         */
+        constexpr bool IsEmpty () const noexcept
+        {
+            return
+                mMin.mX > mMax.mX ||
+                mMin.mY > mMax.mY ||
+                mMin.mZ > mMax.mZ;
+        }
+
+        /**
+         * @brief   Calculates the center point of this box.
+         *
+         * @return  The box's center point.
+         */
+        constexpr Vector3<T> Center () const noexcept
+        {
+            return (mMin + mMax) / TWO<T>;
+        }
+
+        /**
+         * @brief   Calculates the size of this box along each axis.
+         *
+         * @return  The box's size.
+         */
+        constexpr Vector3<T> Size () const noexcept
+        {
+            return mMax - mMin;
+        }
+
+        /**
+         * @brief   Calculates the half-size of this box along each axis.
+         *
+         * @return  The box's half-extents.
+         */
+        constexpr Vector3<T> Extents () const noexcept
+        {
+            return Size() / TWO<T>;
+        }
+
+        /**
+         * @brief   Calculates the volume enclosed by this box.
+         *
+         * @return  The box's volume.
+         */
+        constexpr T Volume () const noexcept
+        {
+            Vector3<T> lSize = Size();
+            return lSize.mX * lSize.mY * lSize.mZ;
+        }
+
+        /**
+         * @brief   Calculates the total area of this box's six faces.
+         *
+         * @return  The box's surface area.
+         */
+        constexpr T SurfaceArea () const noexcept
+        {
+            Vector3<T> lSize = Size();
+            return TWO<T> * (
+                lSize.mX * lSize.mY +
+                lSize.mY * lSize.mZ +
+                lSize.mZ * lSize.mX
+            );
+        }
+
+        /**
+         * @brief   Checks to see if the given point lies inside of, or on the
+         *          surface of, this box.
+         *
+         * @param   pPoint  The point to check.
+         *
+         * @return  `true` if the point is contained; `false` otherwise.
+         */
+        constexpr bool Contains (
+            const Vector3<T>&   pPoint
+        ) const noexcept
+        {
+            return
+                pPoint.mX >= mMin.mX && pPoint.mX <= mMax.mX &&
+                pPoint.mY >= mMin.mY && pPoint.mY <= mMax.mY &&
+                pPoint.mZ >= mMin.mZ && pPoint.mZ <= mMax.mZ;
+        }
+
+        /**
+         * @brief   Checks to see if the given box lies entirely inside of this
+         *          box.
+         *
+         * @param   pOther  The box to check.
+         *
+         * @return  `true` if the box is contained; `false` otherwise.
+         */
+        constexpr bool Contains (
+            const AABB3<T>& pOther
+        ) const noexcept
+        {
+            return Contains(pOther.mMin) && Contains(pOther.mMax);
+        }
+
+        /**
+         * @brief   Checks to see if this box and the given box overlap.
+         *
+         * Boxes which only touch along a face, edge or corner are considered
+         * to be overlapping.
+         *
+         * @param   pOther  The other box.
+         *
+         * @return  `true` if the boxes overlap; `false` otherwise.
+         */
+        constexpr bool Intersects (
+            const AABB3<T>& pOther
+        ) const noexcept
+        {
+            return
+                mMin.mX <= pOther.mMax.mX && mMax.mX >= pOther.mMin.mX &&
+                mMin.mY <= pOther.mMax.mY && mMax.mY >= pOther.mMin.mY &&
+                mMin.mZ <= pOther.mMax.mZ && mMax.mZ >= pOther.mMin.mZ;
+        }
+
+        /**
+         * @brief   Calculates the squared distance between the given point and
+         *          the nearest point on or inside this box.
+         *
+         * @param   pPoint  The point to measure from.
+         *
+         * @return  The squared distance, or zero if the point is contained.
+         */
+        constexpr T DistanceSquared (
+            const Vector3<T>&   pPoint
+        ) const noexcept
+        {
+            Vector3<T> lClamped {
+                std::clamp(pPoint.mX, mMin.mX, mMax.mX),
+                std::clamp(pPoint.mY, mMin.mY, mMax.mY),
+                std::clamp(pPoint.mZ, mMin.mZ, mMax.mZ)
+            };
+
+            return (pPoint - lClamped).LengthSquared();
+        }
+
+        /**
+         * @brief   Grows this box, if needed, so that it encloses the given
+         *          point.
+         *
+         * @param   pPoint  The point to enclose.
+         *
+         * @return  This box.
+         */
+        constexpr AABB3<T>& Merge (
+            const Vector3<T>&   pPoint
+        ) noexcept
+        {
+            mMin.mX = std::min(mMin.mX, pPoint.mX);
+            mMin.mY = std::min(mMin.mY, pPoint.mY);
+            mMin.mZ = std::min(mMin.mZ, pPoint.mZ);
+            mMax.mX = std::max(mMax.mX, pPoint.mX);
+            mMax.mY = std::max(mMax.mY, pPoint.mY);
+            mMax.mZ = std::max(mMax.mZ, pPoint.mZ);
+            return *this;
+        }
+
+        /**
+         * @brief   Grows this box, if needed, so that it encloses the given
+         *          box.
+         *
+         * @param   pOther  The box to enclose.
+         *
+         * @return  This box.
+         */
+        constexpr AABB3<T>& Merge (
+            const AABB3<T>& pOther
+        ) noexcept
+        {
+            Merge(pOther.mMin);
+            Merge(pOther.mMax);
+            return *this;
+        }
+
+        /**
+         * @brief   Calculates a copy of this box, grown by the given margin on
+         *          every side.
+         *
+         * @param   pMargin The margin to grow by. Negative margins shrink the
+         *                  box.
+         *
+         * @return  The expanded box.
+         */
+        constexpr AABB3<T> Expanded (
+            const T pMargin
+        ) const noexcept
+        {
+            return AABB3<T> { mMin - pMargin, mMax + pMargin };
+        }
+
+    };
+
+    /**
+     * @brief   Calculates the smallest box enclosing both of the given boxes.
+     *
+     * @tparam  T       The numeric type of the boxes' corner components.
+     *
+     * @param   pFirst  The first box.
+     * @param   pSecond The second box.
+     *
+     * @return  The enclosing box.
+     */
+    template <Numeric T>
+    inline constexpr AABB3<T> Union (
+        AABB3<T>        pFirst,
+        const AABB3<T>& pSecond
+    ) noexcept
+    {
+        return pFirst.Merge(pSecond);
+    }
+
+    /**
+     * @brief   Checks to see if two boxes overlap.
+     *
+     * @tparam  T       The numeric type of the boxes' corner components.
+     *
+     * @param   pFirst  The first box.
+     * @param   pSecond The second box.
+     *
+     * @return  `true` if the boxes overlap; `false` otherwise.
+     */
+    template <Numeric T>
+    inline constexpr bool Intersects (
+        const AABB3<T>& pFirst,
+        const AABB3<T>& pSecond
+    ) noexcept
+    {
+        return pFirst.Intersects(pSecond);
+    }
+
+    /**
+     * @brief   Checks to see if two boxes are close enough to equal, using an
+     *          epsilon value.
+     *
+     * @param   pFirst      The first box.
+     * @param   pSecond     The second box.
+     *
+     * @return  `true` if the boxes are close enough to equal; `false` if not.
+     */
+    template <typename T>
+    inline constexpr bool EpsilonEqual (
+        const AABB3<T>& pFirst,
+        const AABB3<T>& pSecond
+    ) noexcept
+    {
+        return
+            EpsilonEqual(pFirst.mMin, pSecond.mMin) &&
+            EpsilonEqual(pFirst.mMax, pSecond.mMax);
+    }
+
+    using AABB3f    = AABB3<float>;
+    using AABB3d    = AABB3<double>;
+    using AABB3i    = AABB3<std::int32_t>;
+
+}
@@ -181,6 +181,83 @@ namespace ace
 
     public:
 
+        /**
+         * @brief   Combines this quaternion with the given quaternion, so that
+         *          this quaternion's rotation is applied after the other's.
+         * 
+         * @param   pOther  The other quaternion.
+         * 
+         * @return  This quaternion.
+         */
+        constexpr Quaternion4<T>& operator*= (
+            const Quaternion4<T>&   pOther
+        ) noexcept
+        {
+            *this = *this * pOther;
+            return *this;
+        }
+
+        /**
+         * @brief   Calculates the product of two quaternions: a rotation by
+         *          the right quaternion, followed by one by the left.
+         * 
+         * @param   pLeft   The left quaternion.
+         * @param   pRight  The right quaternion.
+         * 
+         * @return  The product of the two quaternions.
+         */
+        friend constexpr Quaternion4<T> operator* (
+            const Quaternion4<T>&   pLeft,
+            const Quaternion4<T>&   pRight
+        ) noexcept
+        {
+            return Quaternion4<T> {
+                pLeft.mW * pRight.mX + pLeft.mX * pRight.mW + pLeft.mY * pRight.mZ - pLeft.mZ * pRight.mY,
+                pLeft.mW * pRight.mY - pLeft.mX * pRight.mZ + pLeft.mY * pRight.mW + pLeft.mZ * pRight.mX,
+                pLeft.mW * pRight.mZ + pLeft.mX * pRight.mY - pLeft.mY * pRight.mX + pLeft.mZ * pRight.mW,
+                pLeft.mW * pRight.mW - pLeft.mX * pRight.mX - pLeft.mY * pRight.mY - pLeft.mZ * pRight.mZ
+            };
+        }
+
+    public:
+
+        /**
+         * @brief   Converts this quaternion into a 3x3 column-major rotation
+         *          matrix.
+         * 
+         * @return  The converted rotation matrix.
+         * 
+         * @note    This method assumes that this quaternion is normalized. Be
+         *          sure to normalize this quaternion if not already.
+         */
+        constexpr Matrix3<T> ToMatrix3 () const noexcept
+        {
+            T lXX = mX * mX;
+            T lYY = mY * mY;
+            T lZZ = mZ * mZ;
+            T lXY = mX * mY;
+            T lXZ = mX * mZ;
+            T lYZ = mY * mZ;
+            T lWX = mW * mX;
+            T lWY = mW * mY;
+            T lWZ = mW * mZ;
+
+            // Generate and return the matrix.
+            return Matrix3<T> {
+                ONE<T> - TWO<T> * (lYY + lZZ),
+                TWO<T> * (lXY + lWZ),
+                TWO<T> * (lXZ - lWY),
+
+                TWO<T> * (lXY - lWZ),
+                ONE<T> - TWO<T> * (lXX + lZZ),
+                TWO<T> * (lYZ + lWX),
+
+                TWO<T> * (lXZ + lWY),
+                TWO<T> * (lYZ - lWX),
+                ONE<T> - TWO<T> * (lXX + lYY)
+            };
+        }
+
         /**
          * @brief   Converts this quaternion into a 4x4 column-major rotation
          *          matrix.
@@ -0,0 +1,244 @@
+/**
+ * @file    Ace/Networking/BitStream.hpp
+ * @brief   Provides classes for packing values into, and unpacking them from,
+ *          a buffer at the granularity of single bits.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class which packs values of any width up to 32 bits into a
+     *          fixed-size byte buffer, least significant bit first.
+     *
+     * Bits are gathered in a 64-bit scratch word and flushed to the buffer a
+     * byte at a time. Writing past the end of the buffer does not throw; the
+     * writer is marked overflowed and ignores further writes, so that callers
+     * can check once after writing a whole message.
+     */
+    class BitWriter final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a writer over the given buffer.
+         *
+         * @param   pBuffer     The buffer to write into.
+         */
+        explicit BitWriter (
+            std::span<std::uint8_t> pBuffer
+        ) :
+            mBuffer { pBuffer }
+        {}
+
+    public:
+
+        /**
+         * @brief   Writes the low bits of a value.
+         *
+         * @param   pValue  The value to write. Bits above the count are
+         *                  ignored.
+         * @param   pCount  The number of bits to write, from 0 to 32.
+         */
+        inline void WriteBits (
+            const std::uint32_t pValue,
+            const std::uint32_t pCount
+        )
+        {
+            if (mOverflowed == true || pCount == 0)
+            {
+                return;
+            }
+            else if (mBitCount + pCount > mBuffer.size() * 8)
+            {
+                mOverflowed = true;
+                return;
+            }
+
+            const std::uint64_t lMask = (std::uint64_t { 1 } << pCount) - 1;
+            mScratch |= (static_cast<std::uint64_t>(pValue) & lMask) << mScratchBits;
+            mScratchBits += pCount;
+            mBitCount += pCount;
+
+            while (mScratchBits >= 8)
+            {
+                mBuffer[mBytesFlushed++] = static_cast<std::uint8_t>(mScratch);
+                mScratch >>= 8;
+                mScratchBits -= 8;
+            }
+        }
+
+        /**
+         * @brief   Writes a single bit.
+         *
+         * @param   pValue  The bit to write.
+         */
+        inline void WriteBool (
+            const bool  pValue
+        )
+        {
+            WriteBits(pValue ? 1 : 0, 1);
+        }
+
+        /**
+         * @brief   Writes any bits still held in the scratch word to the
+         *          buffer, padding the last byte with zeroes.
+         *
+         * @return  The number of bytes written, or zero if the writer
+         *          overflowed.
+         */
+        inline std::size_t Flush ()
+        {
+            if (mOverflowed == true)
+            {
+                return 0;
+            }
+
+            if (mScratchBits > 0)
+            {
+                mBuffer[mBytesFlushed++] = static_cast<std::uint8_t>(mScratch);
+                mScratch = 0;
+                mBitCount += 8 - mScratchBits;
+                mScratchBits = 0;
+            }
+
+            return mBytesFlushed;
+        }
+
+        /**
+         * @brief   Retrieves the number of bits written so far.
+         *
+         * @return  The number of bits written.
+         */
+        inline std::size_t GetBitCount () const
+        {
+            return mBitCount;
+        }
+
+        /**
+         * @brief   Retrieves the number of bits which may still be written
+         *          before the buffer is full.
+         *
+         * @return  The number of bits remaining.
+         */
+        inline std::size_t GetBitsRemaining () const
+        {
+            return mBuffer.size() * 8 - mBitCount;
+        }
+
+        /**
+         * @brief   Retrieves whether or not a write ran past the end of the
+         *          buffer.
+         *
+         * @return  `true` if the writer overflowed; `false` otherwise.
+         */
+        inline bool IsOverflowed () const
+        {
+            return mOverflowed;
+        }
+
+    private:
+        std::span<std::uint8_t>     mBuffer;                ///< @brief The buffer being written into.
+        std::uint64_t               mScratch = 0;           ///< @brief Bits not yet flushed to the buffer.
+        std::uint32_t               mScratchBits = 0;       ///< @brief The number of bits in @a `mScratch`.
+        std::size_t                 mBitCount = 0;          ///< @brief The number of bits written.
+        std::size_t                 mBytesFlushed = 0;      ///< @brief The number of whole bytes flushed to the buffer.
+        bool                        mOverflowed = false;    ///< @brief Did a write run past the end of the buffer?
+
+    };
+
+    /**
+     * @brief   A class which unpacks values written by a @a `BitWriter`.
+     *
+     * Reading past the end of the buffer does not throw; the reader is marked
+     * overflowed and returns zeroes, so that callers can check once after
+     * reading a whole message.
+     */
+    class BitReader final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a reader over the given buffer.
+         *
+         * @param   pBuffer     The buffer to read from.
+         */
+        explicit BitReader (
+            std::span<const std::uint8_t>   pBuffer
+        ) :
+            mBuffer { pBuffer }
+        {}
+
+    public:
+
+        /**
+         * @brief   Reads a value of the given width.
+         *
+         * @param   pCount  The number of bits to read, from 0 to 32.
+         *
+         * @return  The value read, or zero if the reader overflowed.
+         */
+        inline std::uint32_t ReadBits (
+            const std::uint32_t pCount
+        )
+        {
+            if (mOverflowed == true || pCount == 0)
+            {
+                return 0;
+            }
+            else if (mBitCount + pCount > mBuffer.size() * 8)
+            {
+                mOverflowed = true;
+                return 0;
+            }
+
+            while (mScratchBits < pCount)
+            {
+                mScratch |= static_cast<std::uint64_t>(mBuffer[mBytesRead++]) << mScratchBits;
+                mScratchBits += 8;
+            }
+
+            const std::uint64_t lMask = (std::uint64_t { 1 } << pCount) - 1;
+            const std::uint32_t lValue = static_cast<std::uint32_t>(mScratch & lMask);
+            mScratch >>= pCount;
+            mScratchBits -= pCount;
+            mBitCount += pCount;
+            return lValue;
+        }
+
+        /**
+         * @brief   Reads a single bit.
+         *
+         * @return  The bit read.
+         */
+        inline bool ReadBool ()
+        {
+            return ReadBits(1) != 0;
+        }
+
+        /**
+         * @brief   Retrieves whether or not a read ran past the end of the
+         *          buffer.
+         *
+         * @return  `true` if the reader overflowed; `false` otherwise.
+         */
+        inline bool IsOverflowed () const
+        {
+            return mOverflowed;
+        }
+
+    private:
+        std::span<const std::uint8_t>   mBuffer;                ///< @brief The buffer being read from.
+        std::uint64_t                   mScratch = 0;           ///< @brief Bits read from the buffer, not yet returned.
+        std::uint32_t                   mScratchBits = 0;       ///< @brief The number of bits in @a `mScratch`.
+        std::size_t                     mBitCount = 0;          ///< @brief The number of bits returned.
+        std::size_t                     mBytesRead = 0;         ///< @brief The number of bytes read into @a `mScratch`.
+        bool                            mOverflowed = false;    ///< @brief Did a read run past the end of the buffer?
+
+    };
+
+}
@@ -0,0 +1,86 @@
+/**
+ * @file    Ace/Networking/INetworkTransport.hpp
+ * @brief   Provides an abstract interface for sending and receiving batches of
+ *          datagrams.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Networking/PacketPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An abstract interface for an unreliable, unordered datagram
+     *          transport, such as a UDP socket.
+     *
+     * Datagrams are moved in batches of pooled @a `Packet`s. Apart from
+     * @a `Wake`, which may be called from any thread, a transport is only ever
+     * used by the one thread running a @a `NetworkHost`'s event loop.
+     */
+    class ACE_API INetworkTransport
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~INetworkTransport () = default;
+
+    public:
+
+        /**
+         * @brief   Sends a batch of datagrams, each to its packet's address.
+         *          Never blocks.
+         *
+         * @param   pPackets    The packets to send. The transport does not
+         *                      keep them.
+         *
+         * @return  The number of packets sent, from the start of the batch.
+         *          The rest were dropped.
+         */
+        virtual std::size_t Send (
+            std::span<Packet* const>    pPackets
+        ) = 0;
+
+        /**
+         * @brief   Receives as many waiting datagrams as fit in the given
+         *          packets. Never blocks.
+         *
+         * @param   pPackets    The packets to receive into, in order. Each
+         *                      received packet's size and address are set.
+         *
+         * @return  The number of packets received into.
+         */
+        virtual std::size_t Receive (
+            std::span<Packet*>  pPackets
+        ) = 0;
+
+        /**
+         * @brief   Blocks until a datagram may be waiting, @a `Wake` is
+         *          called, or the timeout expires.
+         *
+         * @param   pTimeout    The longest time to block for.
+         */
+        virtual void Wait (
+            const std::chrono::nanoseconds& pTimeout
+        ) = 0;
+
+        /**
+         * @brief   Interrupts a current or next call to @a `Wait`. May be
+         *          called from any thread.
+         */
+        virtual void Wake () = 0;
+
+        /**
+         * @brief   Retrieves the address this transport receives datagrams
+         *          at.
+         *
+         * @return  The local address.
+         */
+        virtual NetworkAddress GetLocalAddress () const = 0;
+
+    };
+
+}
@@ -0,0 +1,169 @@
+/**
+ * @file    Ace/Networking/LoopbackTransport.cpp
+ */
+
+#include <Ace/Networking/LoopbackTransport.hpp>
+
+namespace ace
+{
+
+    /* `LoopbackNetwork` Class ************************************************/
+
+    LoopbackNetwork::LoopbackNetwork (
+        const LoopbackConditions&   pConditions
+    ) :
+        mConditions { pConditions },
+        mRandom     { pConditions.mSeed }
+    {
+
+    }
+
+    void LoopbackNetwork::SetConditions (
+        const LoopbackConditions&   pConditions
+    )
+    {
+        std::lock_guard lGuard { mMutex };
+        mConditions = pConditions;
+        mRandom.seed(pConditions.mSeed);
+    }
+
+    std::size_t LoopbackNetwork::GetDroppedCount () const
+    {
+        std::lock_guard lGuard { mMutex };
+        return mDroppedCount;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    LoopbackTransport::LoopbackTransport (
+        LoopbackNetwork&        pNetwork,
+        const NetworkAddress&   pAddress
+    ) :
+        mNetwork    { pNetwork },
+        mAddress    { pAddress }
+    {
+        std::lock_guard lGuard { mNetwork.mMutex };
+        if (mNetwork.mTransports.emplace(pAddress.GetKey(), this).second == false)
+        {
+            ACE_THROW(std::invalid_argument, "{}: '{}' is already bound!",
+                "LoopbackTransport", pAddress.ToString());
+        }
+    }
+
+    LoopbackTransport::~LoopbackTransport ()
+    {
+        std::lock_guard lGuard { mNetwork.mMutex };
+        mNetwork.mTransports.erase(mAddress.GetKey());
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::size_t LoopbackTransport::Send (
+        std::span<Packet* const>    pPackets
+    )
+    {
+        const auto lNow = std::chrono::steady_clock::now();
+
+        std::lock_guard lGuard { mNetwork.mMutex };
+        const auto& lConditions = mNetwork.mConditions;
+        std::uniform_real_distribution<float> lChance { 0.0f, 1.0f };
+        std::uniform_int_distribution<std::int64_t> lJitter {
+            0, lConditions.mJitter.count() };
+
+        for (const Packet* lPacket : pPackets)
+        {
+            auto lIter = mNetwork.mTransports.find(lPacket->mAddress.GetKey());
+            if (
+                lIter == mNetwork.mTransports.end() ||
+                lChance(mNetwork.mRandom) < lConditions.mLossRate
+            )
+            {
+                mNetwork.mDroppedCount += 1;
+                continue;
+            }
+
+            LoopbackTransport* lDestination = lIter->second;
+            lDestination->mInbox.push({
+                lNow + lConditions.mLatency +
+                    std::chrono::nanoseconds { lJitter(mNetwork.mRandom) },
+                mNetwork.mNextOrder++,
+                mAddress,
+                astd::byte_buffer {
+                    lPacket->mData.begin(),
+                    lPacket->mData.begin() + lPacket->mSize
+                }
+            });
+            lDestination->mCondition.notify_one();
+        }
+
+        // Datagrams sent into a network are always "sent", even the ones it
+        // loses.
+        return pPackets.size();
+    }
+
+    std::size_t LoopbackTransport::Receive (
+        std::span<Packet*>  pPackets
+    )
+    {
+        const auto lNow = std::chrono::steady_clock::now();
+
+        std::lock_guard lGuard { mNetwork.mMutex };
+        std::size_t lReceived = 0;
+        while (
+            lReceived < pPackets.size() &&
+            mInbox.empty() == false &&
+            mInbox.top().mDeliveryTime <= lNow
+        )
+        {
+            const auto& lDatagram = mInbox.top();
+            Packet* lPacket = pPackets[lReceived++];
+            lPacket->mAddress = lDatagram.mSource;
+            lPacket->mSize = std::min(lDatagram.mData.size(), MAX_PACKET_SIZE);
+            std::memcpy(lPacket->mData.data(), lDatagram.mData.data(),
+                lPacket->mSize);
+            mInbox.pop();
+        }
+
+        return lReceived;
+    }
+
+    void LoopbackTransport::Wait (
+        const std::chrono::nanoseconds& pTimeout
+    )
+    {
+        const auto lDeadline = std::chrono::steady_clock::now() + pTimeout;
+
+        std::unique_lock lLock { mNetwork.mMutex };
+        while (mWoken == false)
+        {
+            // Wake when the earliest datagram in flight arrives, if that is
+            // sooner than the deadline.
+            auto lUntil = lDeadline;
+            if (mInbox.empty() == false)
+            {
+                lUntil = std::min(lUntil, mInbox.top().mDeliveryTime);
+            }
+
+            if (
+                mCondition.wait_until(lLock, lUntil) == std::cv_status::timeout &&
+                std::chrono::steady_clock::now() >= lUntil
+            )
+            {
+                break;
+            }
+        }
+
+        mWoken = false;
+    }
+
+    void LoopbackTransport::Wake ()
+    {
+        {
+            std::lock_guard lGuard { mNetwork.mMutex };
+            mWoken = true;
+        }
+
+        mCondition.notify_one();
+    }
+
+}
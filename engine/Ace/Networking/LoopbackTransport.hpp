@@ -0,0 +1,167 @@
+/**
+ * @file    Ace/Networking/LoopbackTransport.hpp
+ * @brief   Provides an in-process network, with simulated latency and loss,
+ *          for testing networking code offline.
+ */
+
+#pragma once
+#include <Ace/Networking/INetworkTransport.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing the conditions a @a `LoopbackNetwork`
+     *          simulates.
+     */
+    struct LoopbackConditions
+    {
+        std::chrono::nanoseconds    mLatency { 0 };     ///< @brief The one-way delay applied to every datagram.
+        std::chrono::nanoseconds    mJitter { 0 };      ///< @brief The largest extra delay, chosen at random per datagram. Causes reordering.
+        float                       mLossRate = 0.0f;   ///< @brief The fraction of datagrams dropped, from `0` to `1`.
+        std::uint32_t               mSeed = 1;          ///< @brief The seed of the random numbers deciding loss and jitter.
+    };
+
+    class LoopbackTransport;
+
+    /**
+     * @brief   A class simulating a network inside the process, through which
+     *          @a `LoopbackTransport`s exchange datagrams.
+     *
+     * Datagrams are copied on send, and handed to the transport bound to
+     * their address once their simulated delay has passed. Datagrams to
+     * addresses no transport is bound to are dropped, as are those chosen at
+     * random by the simulated loss rate.
+     */
+    class ACE_API LoopbackNetwork final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a network simulating the given conditions.
+         *
+         * @param   pConditions     The conditions to simulate.
+         */
+        explicit LoopbackNetwork (
+            const LoopbackConditions&   pConditions = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Changes the simulated conditions. Datagrams already in
+         *          flight keep their delay.
+         *
+         * @param   pConditions     The conditions to simulate.
+         */
+        void SetConditions (
+            const LoopbackConditions&   pConditions
+        );
+
+        /**
+         * @brief   Retrieves the number of datagrams dropped so far, whether
+         *          by simulated loss or for lack of a destination.
+         *
+         * @return  The number of dropped datagrams.
+         */
+        std::size_t GetDroppedCount () const;
+
+    private:
+        LoopbackNetwork (const LoopbackNetwork&) = delete;
+        LoopbackNetwork (LoopbackNetwork&&) = delete;
+        void operator= (const LoopbackNetwork&) = delete;
+        void operator= (LoopbackNetwork&&) = delete;
+
+    private:
+        friend class LoopbackTransport;
+
+        /**
+         * @brief   A structure containing one datagram in flight.
+         */
+        struct Datagram
+        {
+            std::chrono::steady_clock::time_point   mDeliveryTime;      ///< @brief When the datagram arrives.
+            std::uint64_t                           mOrder = 0;         ///< @brief Breaks ties between datagrams arriving at once.
+            NetworkAddress                          mSource;            ///< @brief The sending transport's address.
+            astd::byte_buffer                       mData;              ///< @brief The datagram's bytes.
+
+            inline bool operator> (const Datagram& pOther) const
+            {
+                return (mDeliveryTime != pOther.mDeliveryTime) ?
+                    mDeliveryTime > pOther.mDeliveryTime :
+                    mOrder > pOther.mOrder;
+            }
+        };
+
+        /**
+         * @brief   The queue of datagrams in flight to one transport, earliest
+         *          arrival first.
+         */
+        using Inbox = std::priority_queue<Datagram, std::vector<Datagram>,
+            std::greater<Datagram>>;
+
+    private:
+        mutable std::mutex                                      mMutex;                 ///< @brief The mutex used for locking down the network's state.
+        LoopbackConditions                                      mConditions;            ///< @brief The simulated conditions.
+        std::mt19937                                            mRandom;                ///< @brief Decides loss and jitter.
+        std::unordered_map<std::uint64_t, LoopbackTransport*>   mTransports;            ///< @brief The bound transports, keyed by address.
+        std::uint64_t                                           mNextOrder = 0;         ///< @brief The order of the next datagram sent.
+        std::size_t                                             mDroppedCount = 0;      ///< @brief The number of datagrams dropped.
+
+    };
+
+    /**
+     * @brief   A datagram transport bound to an address on a
+     *          @a `LoopbackNetwork`.
+     */
+    class ACE_API LoopbackTransport final : public INetworkTransport
+    {
+    public:
+
+        /**
+         * @brief   Binds a transport to an address on the given network.
+         *
+         * @param   pNetwork    The network to join. It must outlive the
+         *                      transport.
+         * @param   pAddress    The address to bind to.
+         *
+         * @throw   `std::invalid_argument` if the address is already bound.
+         */
+        explicit LoopbackTransport (
+            LoopbackNetwork&        pNetwork,
+            const NetworkAddress&   pAddress
+        );
+
+        /**
+         * @brief   The destructor unbinds the transport, dropping any datagrams
+         *          still in flight to it.
+         */
+        ~LoopbackTransport () override;
+
+    public:
+        std::size_t Send (std::span<Packet* const> pPackets) override;
+        std::size_t Receive (std::span<Packet*> pPackets) override;
+        void Wait (const std::chrono::nanoseconds& pTimeout) override;
+        void Wake () override;
+
+        inline NetworkAddress GetLocalAddress () const override
+        {
+            return mAddress;
+        }
+
+    private:
+        LoopbackTransport (const LoopbackTransport&) = delete;
+        LoopbackTransport (LoopbackTransport&&) = delete;
+        void operator= (const LoopbackTransport&) = delete;
+        void operator= (LoopbackTransport&&) = delete;
+
+    private:
+        LoopbackNetwork&            mNetwork;           ///< @brief The network the transport is bound on.
+        NetworkAddress              mAddress;           ///< @brief The address the transport is bound to.
+        LoopbackNetwork::Inbox      mInbox;             ///< @brief The datagrams in flight to the transport. Guarded by the network's mutex.
+        std::condition_variable     mCondition;         ///< @brief Signalled when a datagram is sent to the transport, or it is woken.
+        bool                        mWoken = false;     ///< @brief Has @a `Wake` been called since the last @a `Wait`?
+
+    };
+
+}
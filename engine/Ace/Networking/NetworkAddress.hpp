@@ -0,0 +1,88 @@
+/**
+ * @file    Ace/Networking/NetworkAddress.hpp
+ * @brief   Provides a structure identifying an endpoint on the network.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure identifying an IPv4 endpoint - a host and a port -
+     *          on the network.
+     */
+    struct NetworkAddress
+    {
+        std::uint32_t   mHost = 0;  ///< @brief The host's IPv4 address, in host byte order.
+        std::uint16_t   mPort = 0;  ///< @brief The port, in host byte order.
+
+        /**
+         * @brief   Creates an address from the four octets of an IPv4 address
+         *          and a port.
+         *
+         * @param   pA, pB, pC, pD  The address's octets, most significant
+         *                          first.
+         * @param   pPort           The port.
+         *
+         * @return  The new address.
+         */
+        static constexpr NetworkAddress FromIPv4 (
+            const std::uint8_t  pA,
+            const std::uint8_t  pB,
+            const std::uint8_t  pC,
+            const std::uint8_t  pD,
+            const std::uint16_t pPort
+        )
+        {
+            return {
+                (static_cast<std::uint32_t>(pA) << 24) |
+                (static_cast<std::uint32_t>(pB) << 16) |
+                (static_cast<std::uint32_t>(pC) << 8) |
+                static_cast<std::uint32_t>(pD),
+                pPort
+            };
+        }
+
+        /**
+         * @brief   Creates an address on the local loopback interface.
+         *
+         * @param   pPort   The port.
+         *
+         * @return  The new address.
+         */
+        static constexpr NetworkAddress Loopback (
+            const std::uint16_t pPort
+        )
+        {
+            return FromIPv4(127, 0, 0, 1, pPort);
+        }
+
+        /**
+         * @brief   Packs the address into a single integer, for use as a
+         *          lookup key.
+         *
+         * @return  The packed address.
+         */
+        constexpr std::uint64_t GetKey () const
+        {
+            return (static_cast<std::uint64_t>(mHost) << 16) | mPort;
+        }
+
+        /**
+         * @brief   Formats the address as `a.b.c.d:port`.
+         *
+         * @return  The formatted address.
+         */
+        inline std::string ToString () const
+        {
+            return std::format("{}.{}.{}.{}:{}",
+                (mHost >> 24) & 0xFF, (mHost >> 16) & 0xFF,
+                (mHost >> 8) & 0xFF, mHost & 0xFF, mPort);
+        }
+
+        constexpr bool operator== (const NetworkAddress&) const = default;
+    };
+
+}
@@ -0,0 +1,330 @@
+/**
+ * @file    Ace/Networking/NetworkHost.cpp
+ */
+
+#include <Ace/Networking/NetworkHost.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    NetworkHost::NetworkHost (
+        std::unique_ptr<INetworkTransport>  pTransport,
+        const NetworkHostSpec&              pSpec
+    ) :
+        mSpec       { pSpec },
+        mTransport  { std::move(pTransport) },
+        mPool       { pSpec.mPacketCount },
+        mOutgoing   { std::make_unique<OutgoingQueue>() },
+        mIncoming   { std::make_unique<IncomingQueue>() }
+    {
+        if (mTransport == nullptr || pSpec.mMaxPeers == 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: A transport and a peer limit are required!",
+                "NetworkHost");
+        }
+
+        mPeers.reserve(pSpec.mMaxPeers);
+        mReceiveBatch.reserve(RECEIVE_BATCH_SIZE);
+        mDelivered.reserve(ReliableChannel::WINDOW_SIZE);
+    }
+
+    NetworkHost::~NetworkHost ()
+    {
+        Stop();
+        ReleaseAll();
+    }
+
+    /* Public Methods *********************************************************/
+
+    void NetworkHost::Start ()
+    {
+        // If the event loop is currently running, then early out.
+        if (mRunning.exchange(true) == true)
+        {
+            return;
+        }
+
+        mThread = std::thread {
+            [this] -> void
+            {
+                while (mRunning.load(std::memory_order_relaxed) == true)
+                {
+                    const auto lNow = Clock::now();
+                    const auto lNextTick = Tick(lNow);
+                    mTransport->Wait(
+                        std::chrono::duration_cast<std::chrono::nanoseconds>(
+                            lNextTick - Clock::now())
+                    );
+                }
+            }
+        };
+    }
+
+    void NetworkHost::Stop ()
+    {
+        // If the event loop is not running, early out.
+        if (mRunning.exchange(false) == false)
+        {
+            return;
+        }
+
+        mTransport->Wake();
+        if (mThread.joinable() == true)
+        {
+            mThread.join();
+        }
+    }
+
+    void NetworkHost::Update ()
+    {
+        Tick(Clock::now());
+    }
+
+    bool NetworkHost::Send (
+        const NetworkAddress&           pAddress,
+        std::span<const std::uint8_t>   pPayload,
+        const NetworkDelivery           pDelivery
+    )
+    {
+        if (pPayload.size() > ReliableChannel::MAX_PAYLOAD_SIZE)
+        {
+            return false;
+        }
+
+        Packet* lPacket = mPool.Acquire();
+        if (lPacket == nullptr)
+        {
+            return false;
+        }
+
+        lPacket->mAddress = pAddress;
+        lPacket->mSize = ReliableChannel::HEADER_SIZE + pPayload.size();
+        std::memcpy(lPacket->mData.data() + ReliableChannel::HEADER_SIZE,
+            pPayload.data(), pPayload.size());
+
+        if (mOutgoing->Enqueue({ lPacket, pDelivery }) == false)
+        {
+            mPool.Release(lPacket);
+            return false;
+        }
+
+        return true;
+    }
+
+    std::optional<NetworkEvent> NetworkHost::Receive ()
+    {
+        auto lIncoming = mIncoming->Dequeue();
+        if (lIncoming.has_value() == false)
+        {
+            return std::nullopt;
+        }
+
+        return NetworkEvent {
+            lIncoming->mType,
+            lIncoming->mAddress,
+            lIncoming->mDelivery,
+            PacketHandle { lIncoming->mPacket, PacketReleaser { &mPool } }
+        };
+    }
+
+    /* Private Methods ********************************************************/
+
+    NetworkHost::Clock::time_point NetworkHost::Tick (
+        const Clock::time_point pNow
+    )
+    {
+        // Hand over any events which did not fit last tick, before any newer
+        // ones, so that the game thread still sees them in order.
+        while (mOverflow.empty() == false && mIncoming->Enqueue(mOverflow.front()) == true)
+        {
+            mOverflow.pop_front();
+        }
+
+        // Route the game thread's messages to their peers' channels.
+        // Unreliable messages go straight into this tick's batch.
+        mOutgoing->DequeueWhile(
+            [this, pNow] (const Outgoing& pOutgoing)
+            {
+                Peer* lPeer = FindOrAddPeer(pOutgoing.mPacket->mAddress, pNow);
+                if (lPeer == nullptr)
+                {
+                    mPool.Release(pOutgoing.mPacket);
+                }
+                else if (pOutgoing.mDelivery == NetworkDelivery::ReliableOrdered)
+                {
+                    lPeer->mChannel->QueueReliable(pOutgoing.mPacket);
+                }
+                else
+                {
+                    lPeer->mChannel->PrepareUnreliable(pOutgoing.mPacket);
+                    lPeer->mLastSent = pNow;
+                    mSendBatch.push_back(pOutgoing.mPacket);
+                }
+
+                return true;
+            }
+        );
+
+        // Receive every waiting datagram, a batch at a time.
+        while (true)
+        {
+            while (mReceiveBatch.size() < RECEIVE_BATCH_SIZE)
+            {
+                Packet* lPacket = mPool.Acquire();
+                if (lPacket == nullptr)
+                {
+                    break;
+                }
+
+                mReceiveBatch.push_back(lPacket);
+            }
+
+            const std::size_t lBatchSize = mReceiveBatch.size();
+            const std::size_t lReceived = mTransport->Receive(mReceiveBatch);
+            for (std::size_t i = 0; i < lReceived; ++i)
+            {
+                Packet* lPacket = mReceiveBatch[i];
+                Peer* lPeer = FindOrAddPeer(lPacket->mAddress, pNow);
+                if (lPeer == nullptr)
+                {
+                    mPool.Release(lPacket);
+                    continue;
+                }
+
+                lPeer->mLastReceived = pNow;
+                lPeer->mChannel->Receive(lPacket, pNow, mDelivered);
+                for (Packet* lMessage : mDelivered)
+                {
+                    PushIncoming({
+                        NetworkEventType::Message,
+                        lMessage->mAddress,
+                        ReliableChannel::GetDelivery(*lMessage),
+                        lMessage
+                    });
+                }
+
+                mDelivered.clear();
+            }
+
+            mReceiveBatch.erase(mReceiveBatch.begin(), mReceiveBatch.begin() + lReceived);
+            if (lReceived == 0 || lReceived < lBatchSize)
+            {
+                break;
+            }
+        }
+
+        // Forget silent peers, keep idle ones alive, and collect every
+        // channel's due sends and resends.
+        const auto lKeepAlive = mSpec.mPeerTimeout / 4;
+        auto lNextTick = pNow + mSpec.mTickInterval;
+        for (auto lIter = mPeers.begin(); lIter != mPeers.end(); )
+        {
+            Peer& lPeer = lIter->second;
+            if (pNow - lPeer.mLastReceived >= mSpec.mPeerTimeout)
+            {
+                PushIncoming({ NetworkEventType::Disconnected, lPeer.mAddress });
+                lIter = mPeers.erase(lIter);
+                continue;
+            }
+
+            if (pNow - lPeer.mLastSent >= lKeepAlive)
+            {
+                lPeer.mChannel->RequestAck();
+            }
+
+            const std::size_t lResends = lPeer.mChannel->GetResendCount();
+            if (lPeer.mChannel->Update(pNow, mSendBatch) > 0)
+            {
+                lPeer.mLastSent = pNow;
+            }
+
+            mResendCount.fetch_add(lPeer.mChannel->GetResendCount() - lResends,
+                std::memory_order_relaxed);
+            lNextTick = std::min(lNextTick, lPeer.mChannel->GetNextDeadline());
+            ++lIter;
+        }
+
+        // Send this tick's datagrams in one batch. Whatever the transport could
+        // not send is lost, like any other datagram; reliable messages are
+        // resent from their channels' windows.
+        mTransport->Send(mSendBatch);
+        for (Packet* lPacket : mSendBatch)
+        {
+            mPool.Release(lPacket);
+        }
+
+        mSendBatch.clear();
+        return lNextTick;
+    }
+
+    NetworkHost::Peer* NetworkHost::FindOrAddPeer (
+        const NetworkAddress&   pAddress,
+        const Clock::time_point pNow
+    )
+    {
+        auto lIter = mPeers.find(pAddress.GetKey());
+        if (lIter != mPeers.end())
+        {
+            return &lIter->second;
+        }
+        else if (mPeers.size() >= mSpec.mMaxPeers)
+        {
+            return nullptr;
+        }
+
+        Peer& lPeer = mPeers[pAddress.GetKey()];
+        lPeer.mAddress = pAddress;
+        lPeer.mChannel = std::make_unique<ReliableChannel>(mPool, pAddress);
+        lPeer.mLastReceived = pNow;
+        lPeer.mLastSent = pNow;
+
+        PushIncoming({ NetworkEventType::Connected, pAddress });
+        return &lPeer;
+    }
+
+    void NetworkHost::PushIncoming (
+        const Incoming& pIncoming
+    )
+    {
+        if (mOverflow.empty() == false || mIncoming->Enqueue(pIncoming) == false)
+        {
+            mOverflow.push_back(pIncoming);
+        }
+    }
+
+    void NetworkHost::ReleaseAll ()
+    {
+        mOutgoing->DequeueWhile(
+            [this] (const Outgoing& pOutgoing)
+            {
+                mPool.Release(pOutgoing.mPacket);
+                return true;
+            }
+        );
+
+        mIncoming->DequeueWhile(
+            [this] (const Incoming& pIncoming)
+            {
+                mPool.Release(pIncoming.mPacket);
+                return true;
+            }
+        );
+
+        for (const auto& lIncoming : mOverflow)
+        {
+            mPool.Release(lIncoming.mPacket);
+        }
+
+        for (Packet* lPacket : mReceiveBatch)
+        {
+            mPool.Release(lPacket);
+        }
+
+        mOverflow.clear();
+        mReceiveBatch.clear();
+        mPeers.clear();
+    }
+
+}
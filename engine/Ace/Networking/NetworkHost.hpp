@@ -0,0 +1,315 @@
+/**
+ * @file    Ace/Networking/NetworkHost.hpp
+ * @brief   Provides a class which runs a networking event loop on its own
+ *          thread, exchanging messages with any number of peers.
+ */
+
+#pragma once
+#include <Ace/Networking/INetworkTransport.hpp>
+#include <Ace/Networking/ReliableChannel.hpp>
+#include <Ace/System/SpscRingBuffer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the kinds of event a @a `NetworkHost` reports to the
+     *          game thread.
+     */
+    enum class NetworkEventType : std::uint8_t
+    {
+        Connected,      ///< @brief A peer was sent to, or heard from, for the first time.
+        Message,        ///< @brief A message arrived from a peer.
+        Disconnected    ///< @brief A peer has not been heard from for the peer timeout, and was forgotten.
+    };
+
+    /**
+     * @brief   A structure containing one event reported by a
+     *          @a `NetworkHost`.
+     */
+    struct NetworkEvent
+    {
+        NetworkEventType    mType = NetworkEventType::Message;          ///< @brief The kind of event.
+        NetworkAddress      mAddress;                                   ///< @brief The peer's address.
+        NetworkDelivery     mDelivery = NetworkDelivery::Unreliable;    ///< @brief How the message was sent, for messages.
+        PacketHandle        mPacket;                                    ///< @brief The packet holding the message, for messages. Returned to the host's pool when the event is destroyed.
+
+        /**
+         * @brief   Retrieves the message's payload.
+         *
+         * @return  The payload, or an empty span if the event is not a
+         *          message.
+         */
+        inline std::span<const std::uint8_t> GetPayload () const
+        {
+            if (mPacket == nullptr)
+            {
+                return {};
+            }
+
+            return { mPacket->mData.data() + ReliableChannel::HEADER_SIZE,
+                mPacket->mSize - ReliableChannel::HEADER_SIZE };
+        }
+    };
+
+    /**
+     * @brief   A structure containing the settings a @a `NetworkHost` is
+     *          created with.
+     */
+    struct NetworkHostSpec
+    {
+        std::size_t                 mPacketCount = 8192;    ///< @brief The number of packets in the host's pool.
+        std::size_t                 mMaxPeers = 64;         ///< @brief The largest number of peers tracked at once. Datagrams from further peers are dropped.
+        std::chrono::milliseconds   mPeerTimeout { 5000 };  ///< @brief How long a peer may go unheard from before it is forgotten.
+        std::chrono::milliseconds   mTickInterval { 10 };   ///< @brief The longest the event loop waits between ticks when idle.
+    };
+
+    /**
+     * @brief   A class which exchanges messages with any number of peers over
+     *          an @a `INetworkTransport`, on an event loop running on its own
+     *          thread.
+     *
+     * The game thread sends messages with @a `Send`, which copies them into
+     * pooled packets and passes them to the event loop through a lock-free
+     * @a `SpscRingBuffer`; @a `Flush` wakes the loop to send everything queued
+     * so far in one batch. The loop passes received messages, and peers
+     * connecting and disconnecting, back to the game thread through another
+     * @a `SpscRingBuffer`, which @a `Receive` drains.
+     *
+     * Each peer gets a @a `ReliableChannel`, which carries both unreliable
+     * and reliable, ordered messages. Peers are tracked by address, from the
+     * first datagram sent to or received from them, and are forgotten once
+     * they have been silent for the peer timeout. Idle peers are sent a bare
+     * acknowledgement every quarter timeout to keep them from timing out.
+     *
+     * Apart from @a `Flush`, the public methods may only be called from one
+     * game thread.
+     */
+    class ACE_API NetworkHost final
+    {
+    public:
+
+        /**
+         * @brief   The largest number of messages which can be queued in each
+         *          direction between the game thread and the event loop.
+         */
+        static constexpr std::size_t QUEUE_CAPACITY = 4096;
+
+        /**
+         * @brief   The largest number of datagrams received per batch.
+         */
+        static constexpr std::size_t RECEIVE_BATCH_SIZE = 64;
+
+        using Clock = std::chrono::steady_clock;
+
+    public:
+
+        /**
+         * @brief   Constructs a host which exchanges datagrams over the given
+         *          transport.
+         *
+         * @param   pTransport  The transport to use.
+         * @param   pSpec       The host's settings.
+         *
+         * @throw   `std::invalid_argument` if the transport is `nullptr`, or
+         *          the packet count or peer limit is zero.
+         */
+        explicit NetworkHost (
+            std::unique_ptr<INetworkTransport>  pTransport,
+            const NetworkHostSpec&              pSpec = {}
+        );
+
+        /**
+         * @brief   The destructor stops the event loop, if it is running. Any
+         *          @a `NetworkEvent`s received from the host must be destroyed
+         *          first.
+         */
+        ~NetworkHost ();
+
+    public:
+
+        /**
+         * @brief   Starts the event loop on its own thread.
+         */
+        void Start ();
+
+        /**
+         * @brief   Stops the event loop, if it is running.
+         */
+        void Stop ();
+
+        /**
+         * @brief   Runs one tick of the event loop on the calling thread,
+         *          without waiting: queued messages are sent, waiting
+         *          datagrams are received, and due resends are made.
+         *
+         * This method must not be called while the event loop is running.
+         */
+        void Update ();
+
+        /**
+         * @brief   Queues a message to be sent to a peer.
+         *
+         * @param   pAddress    The peer's address.
+         * @param   pPayload    The message's bytes. Copied.
+         * @param   pDelivery   The delivery guarantee to send the message
+         *                      with.
+         *
+         * @return  `true` if the message was queued; `false` if it is larger
+         *          than @a `ReliableChannel::MAX_PAYLOAD_SIZE`, or the pool or
+         *          queue is exhausted.
+         */
+        bool Send (
+            const NetworkAddress&           pAddress,
+            std::span<const std::uint8_t>   pPayload,
+            const NetworkDelivery           pDelivery
+        );
+
+        /**
+         * @brief   Wakes the event loop to send every message queued so far.
+         *          May be called from any thread.
+         */
+        inline void Flush ()
+        {
+            mTransport->Wake();
+        }
+
+        /**
+         * @brief   Retrieves the oldest event reported by the event loop.
+         *
+         * @return  An `std::optional` which contains the event, if any.
+         */
+        std::optional<NetworkEvent> Receive ();
+
+        /**
+         * @brief   Retrieves the address this host receives datagrams at.
+         *
+         * @return  The local address.
+         */
+        inline NetworkAddress GetLocalAddress () const
+        {
+            return mTransport->GetLocalAddress();
+        }
+
+        /**
+         * @brief   Retrieves the total number of reliable datagrams resent so
+         *          far, across all peers.
+         *
+         * @return  The number of resends.
+         */
+        inline std::size_t GetResendCount () const
+        {
+            return mResendCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Retrieves the host's packet pool.
+         *
+         * @return  A handle to the packet pool.
+         */
+        inline const PacketPool& GetPool () const
+        {
+            return mPool;
+        }
+
+    private:
+        NetworkHost (const NetworkHost&) = delete;
+        NetworkHost (NetworkHost&&) = delete;
+        void operator= (const NetworkHost&) = delete;
+        void operator= (NetworkHost&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one message queued by the game
+         *          thread.
+         */
+        struct Outgoing
+        {
+            Packet*             mPacket = nullptr;                          ///< @brief The packet holding the message, addressed to its peer.
+            NetworkDelivery     mDelivery = NetworkDelivery::Unreliable;    ///< @brief The message's delivery guarantee.
+        };
+
+        /**
+         * @brief   A structure containing one event queued by the event loop.
+         */
+        struct Incoming
+        {
+            NetworkEventType    mType = NetworkEventType::Message;          ///< @brief The kind of event.
+            NetworkAddress      mAddress;                                   ///< @brief The peer's address.
+            NetworkDelivery     mDelivery = NetworkDelivery::Unreliable;    ///< @brief How the message was sent, for messages.
+            Packet*             mPacket = nullptr;                          ///< @brief The packet holding the message, for messages.
+        };
+
+        /**
+         * @brief   A structure containing one peer's state. Event loop only.
+         */
+        struct Peer
+        {
+            NetworkAddress                      mAddress;       ///< @brief The peer's address.
+            std::unique_ptr<ReliableChannel>    mChannel;       ///< @brief The peer's message channel.
+            Clock::time_point                   mLastReceived;  ///< @brief When the peer was last heard from.
+            Clock::time_point                   mLastSent;      ///< @brief When the peer was last sent a datagram.
+        };
+
+        using OutgoingQueue = SpscRingBuffer<Outgoing, QUEUE_CAPACITY>;
+        using IncomingQueue = SpscRingBuffer<Incoming, QUEUE_CAPACITY>;
+
+    private:
+
+        /**
+         * @brief   Runs one tick of the event loop.
+         *
+         * @param   pNow    The current time.
+         *
+         * @return  The time by which the next tick is due.
+         */
+        Clock::time_point Tick (
+            const Clock::time_point pNow
+        );
+
+        /**
+         * @brief   Finds the peer at the given address, starting to track it
+         *          if it is new and the peer limit allows.
+         *
+         * @return  A pointer to the peer, or `nullptr` if the peer limit has
+         *          been reached.
+         */
+        Peer* FindOrAddPeer (
+            const NetworkAddress&   pAddress,
+            const Clock::time_point pNow
+        );
+
+        /**
+         * @brief   Passes an event to the game thread, holding on to it if the
+         *          queue is full.
+         */
+        void PushIncoming (
+            const Incoming& pIncoming
+        );
+
+        /**
+         * @brief   Returns every packet still held by the event loop and its
+         *          queues to the pool, and forgets every peer.
+         */
+        void ReleaseAll ();
+
+    private:
+        NetworkHostSpec                                     mSpec;                      ///< @brief The host's settings.
+        std::unique_ptr<INetworkTransport>                  mTransport;                 ///< @brief The transport datagrams are exchanged over.
+        PacketPool                                          mPool;                      ///< @brief The pool every packet is borrowed from.
+        std::unique_ptr<OutgoingQueue>                      mOutgoing;                  ///< @brief Messages passed from the game thread to the event loop.
+        std::unique_ptr<IncomingQueue>                      mIncoming;                  ///< @brief Events passed from the event loop to the game thread.
+        std::atomic<bool>                                   mRunning { false };         ///< @brief Indicates whether or not the event loop is running.
+        std::thread                                         mThread;                    ///< @brief The thread running the event loop.
+        std::atomic<std::size_t>                            mResendCount { 0 };         ///< @brief The number of reliable datagrams resent, across all peers.
+
+        std::unordered_map<std::uint64_t, Peer>             mPeers;                     ///< @brief The tracked peers, keyed by address. Event loop only.
+        std::deque<Incoming>                                mOverflow;                  ///< @brief Events waiting for room in @a `mIncoming`. Event loop only.
+        std::vector<Packet*>                                mReceiveBatch;              ///< @brief The packets the next batch is received into. Event loop only.
+        std::vector<Packet*>                                mSendBatch;                 ///< @brief The datagrams to send this tick. Event loop only.
+        std::vector<Packet*>                                mDelivered;                 ///< @brief Scratch space for messages a channel delivers. Event loop only.
+
+    };
+
+}
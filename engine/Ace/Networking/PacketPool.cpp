@@ -0,0 +1,82 @@
+/**
+ * @file    Ace/Networking/PacketPool.cpp
+ */
+
+#include <Ace/Networking/PacketPool.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Validates a pool's capacity before anything is sized from it.
+     */
+    static std::size_t CheckCapacity (
+        const std::size_t&  pCapacity
+    )
+    {
+        if (pCapacity == 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Capacity must not be zero!",
+                "PacketPool");
+        }
+
+        return pCapacity;
+    }
+
+    /* `PacketReleaser` Structure *********************************************/
+
+    void PacketReleaser::operator() (
+        Packet* pPacket
+    ) const
+    {
+        if (mPool != nullptr)
+        {
+            mPool->Release(pPacket);
+        }
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    PacketPool::PacketPool (
+        const std::size_t&  pCapacity
+    ) :
+        mCapacity   { CheckCapacity(pCapacity) },
+        mPackets    { std::make_unique<Packet[]>(pCapacity) },
+        mFree       { pCapacity }
+    {}
+
+    /* Public Methods *********************************************************/
+
+    Packet* PacketPool::Acquire ()
+    {
+        const std::uint32_t lIndex = mFree.Pop();
+        if (lIndex == ConcurrentFreeList::NONE)
+        {
+            return nullptr;
+        }
+
+        Packet* lPacket = &mPackets[lIndex];
+        lPacket->mSize = 0;
+        return lPacket;
+    }
+
+    void PacketPool::Release (
+        Packet* pPacket
+    )
+    {
+        if (pPacket == nullptr)
+        {
+            return;
+        }
+
+        mFree.Push(static_cast<std::uint32_t>(pPacket - mPackets.get()));
+    }
+
+    std::size_t PacketPool::GetFreeCount () const
+    {
+        return mFree.GetFreeCount();
+    }
+
+}
@@ -0,0 +1,122 @@
+/**
+ * @file    Ace/Networking/PacketPool.hpp
+ * @brief   Provides a fixed pool of reusable datagram buffers.
+ */
+
+#pragma once
+#include <Ace/Networking/NetworkAddress.hpp>
+#include <Ace/System/ConcurrentFreeList.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   The largest datagram, in bytes, sent or received by the
+     *          networking layer. Kept below common path MTUs so that datagrams
+     *          are never fragmented.
+     */
+    constexpr std::size_t MAX_PACKET_SIZE = 1200;
+
+    /**
+     * @brief   A structure containing one datagram, and the address it was
+     *          sent from or is being sent to.
+     */
+    struct Packet
+    {
+        NetworkAddress                              mAddress;       ///< @brief The remote endpoint.
+        std::size_t                                 mSize = 0;      ///< @brief The number of bytes of @a `mData` in use.
+        std::array<std::uint8_t, MAX_PACKET_SIZE>   mData;          ///< @brief The datagram's bytes.
+    };
+
+    class PacketPool;
+
+    /**
+     * @brief   A deleter which returns a packet to the pool it came from.
+     */
+    struct PacketReleaser
+    {
+        PacketPool* mPool = nullptr;    ///< @brief The pool which owns the packet.
+
+        void operator() (Packet* pPacket) const;
+    };
+
+    /**
+     * @brief   A handle to a pooled packet, which returns the packet to its
+     *          pool when destroyed.
+     */
+    using PacketHandle = std::unique_ptr<Packet, PacketReleaser>;
+
+    /**
+     * @brief   A class which owns a fixed number of packets, allocated once up
+     *          front, and lends them out so that sending and receiving never
+     *          allocate.
+     *
+     * Packets may be acquired and released from any thread. The free packets
+     * are tracked by a lock-free stack of indices.
+     */
+    class ACE_API PacketPool final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a pool of the given number of packets.
+         *
+         * @param   pCapacity   The number of packets in the pool.
+         *
+         * @throw   `std::invalid_argument` if the capacity is zero.
+         */
+        explicit PacketPool (
+            const std::size_t&  pCapacity
+        );
+
+    public:
+
+        /**
+         * @brief   Borrows a packet from the pool. The packet's size is reset
+         *          to zero.
+         *
+         * @return  A pointer to the packet, or `nullptr` if every packet is in
+         *          use.
+         */
+        Packet* Acquire ();
+
+        /**
+         * @brief   Returns a borrowed packet to the pool.
+         *
+         * @param   pPacket     The packet to return. Ignored if `nullptr`.
+         */
+        void Release (
+            Packet* pPacket
+        );
+
+        /**
+         * @brief   Retrieves the number of packets in the pool.
+         *
+         * @return  The pool's capacity.
+         */
+        inline std::size_t GetCapacity () const
+        {
+            return mCapacity;
+        }
+
+        /**
+         * @brief   Retrieves the number of packets not currently borrowed.
+         *
+         * @return  The number of free packets.
+         */
+        std::size_t GetFreeCount () const;
+
+    private:
+        PacketPool (const PacketPool&) = delete;
+        PacketPool (PacketPool&&) = delete;
+        void operator= (const PacketPool&) = delete;
+        void operator= (PacketPool&&) = delete;
+
+    private:
+        std::size_t                 mCapacity = 0;      ///< @brief The number of packets in the pool.
+        std::unique_ptr<Packet[]>   mPackets;           ///< @brief The packets' storage.
+        ConcurrentFreeList          mFree;              ///< @brief The indices of the packets not currently borrowed.
+
+    };
+
+}
@@ -0,0 +1,262 @@
+/**
+ * @file    Ace/Networking/Quantization.hpp
+ * @brief   Provides functions and classes for reducing positions and rotations
+ *          to small, fixed-width integers for replication.
+ */
+
+#pragma once
+#include <bit>
+#include <cmath>
+#include <Ace/Maths/AABB3.hpp>
+#include <Ace/Maths/Quaternion4.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Maps a value in a range onto an unsigned integer of the given
+     *          width, rounding to the nearest step. Values outside the range
+     *          are clamped.
+     *
+     * @param   pValue  The value to quantize.
+     * @param   pMin    The lowest value in the range.
+     * @param   pMax    The highest value in the range.
+     * @param   pBits   The width of the result, from 1 to 32.
+     *
+     * @return  The quantized value.
+     */
+    inline std::uint32_t QuantizeFloat (
+        const float         pValue,
+        const float         pMin,
+        const float         pMax,
+        const std::uint32_t pBits
+    )
+    {
+        const double lSteps = static_cast<double>((std::uint64_t { 1 } << pBits) - 1);
+        const double lNormal = std::clamp(
+            (static_cast<double>(pValue) - pMin) / (static_cast<double>(pMax) - pMin),
+            0.0, 1.0);
+        return static_cast<std::uint32_t>(lNormal * lSteps + 0.5);
+    }
+
+    /**
+     * @brief   Maps a value produced by @a `QuantizeFloat` back into its range.
+     *
+     * @param   pValue  The quantized value.
+     * @param   pMin    The lowest value in the range.
+     * @param   pMax    The highest value in the range.
+     * @param   pBits   The width of the quantized value, from 1 to 32.
+     *
+     * @return  The dequantized value.
+     */
+    inline float DequantizeFloat (
+        const std::uint32_t pValue,
+        const float         pMin,
+        const float         pMax,
+        const std::uint32_t pBits
+    )
+    {
+        const double lSteps = static_cast<double>((std::uint64_t { 1 } << pBits) - 1);
+        return static_cast<float>(
+            pMin + (static_cast<double>(pMax) - pMin) * (pValue / lSteps));
+    }
+
+    /**
+     * @brief   A class which quantizes positions inside a bounding box to
+     *          fixed-point integers, at a fixed resolution.
+     *
+     * Each axis gets just enough bits to cover its extent at the requested
+     * resolution, so a 4 km wide world at 1/512 unit resolution costs 21 bits
+     * per axis rather than 32.
+     */
+    class PositionQuantizer final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a quantizer covering the given bounds.
+         *
+         * @param   pBounds         The box every quantized position lies in.
+         *                          Positions outside it are clamped.
+         * @param   pResolution     The largest distance between adjacent
+         *                          quantized positions, in world units.
+         *
+         * @throw   `std::invalid_argument` if the bounds are empty, the
+         *          resolution is not positive, or an axis would need more
+         *          than 32 bits.
+         */
+        explicit PositionQuantizer (
+            const AABB3f&   pBounds = AABB3f::FromCenterExtents({}, { 2048.0f, 2048.0f, 2048.0f }),
+            const float     pResolution = 1.0f / 512.0f
+        ) :
+            mBounds { pBounds }
+        {
+            if (pBounds.IsEmpty() == true || (pResolution > 0.0f) == false)
+            {
+                ACE_THROW(std::invalid_argument, "{}: Invalid bounds or resolution!",
+                    "PositionQuantizer");
+            }
+
+            const Vector3f lSize = pBounds.Size();
+            const float lExtents[3] = { lSize.mX, lSize.mY, lSize.mZ };
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const double lSteps = std::ceil(lExtents[i] / pResolution);
+                if (lSteps >= 4294967295.0)
+                {
+                    ACE_THROW(std::invalid_argument, "{}: Resolution is too fine for the bounds!",
+                        "PositionQuantizer");
+                }
+
+                mBits[i] = std::max<std::uint32_t>(1,
+                    std::bit_width(static_cast<std::uint32_t>(lSteps)));
+            }
+        }
+
+    public:
+
+        /**
+         * @brief   Quantizes a position.
+         *
+         * @param   pPosition   The position to quantize.
+         *
+         * @return  The position's fixed-point coordinates.
+         */
+        inline Vector3u Quantize (
+            const Vector3f& pPosition
+        ) const
+        {
+            return {
+                QuantizeFloat(pPosition.mX, mBounds.mMin.mX, mBounds.mMax.mX, mBits[0]),
+                QuantizeFloat(pPosition.mY, mBounds.mMin.mY, mBounds.mMax.mY, mBits[1]),
+                QuantizeFloat(pPosition.mZ, mBounds.mMin.mZ, mBounds.mMax.mZ, mBits[2])
+            };
+        }
+
+        /**
+         * @brief   Restores a quantized position.
+         *
+         * @param   pQuantized  The position's fixed-point coordinates.
+         *
+         * @return  The dequantized position.
+         */
+        inline Vector3f Dequantize (
+            const Vector3u& pQuantized
+        ) const
+        {
+            return {
+                DequantizeFloat(pQuantized.mX, mBounds.mMin.mX, mBounds.mMax.mX, mBits[0]),
+                DequantizeFloat(pQuantized.mY, mBounds.mMin.mY, mBounds.mMax.mY, mBits[1]),
+                DequantizeFloat(pQuantized.mZ, mBounds.mMin.mZ, mBounds.mMax.mZ, mBits[2])
+            };
+        }
+
+        /**
+         * @brief   Retrieves the number of bits used for an axis.
+         *
+         * @param   pAxis   The axis: `0` for X, `1` for Y, `2` for Z.
+         *
+         * @return  The axis's width, in bits.
+         */
+        inline std::uint32_t GetBits (
+            const std::size_t&  pAxis
+        ) const
+        {
+            return mBits[pAxis];
+        }
+
+    private:
+        AABB3f                          mBounds;        ///< @brief The box every quantized position lies in.
+        std::array<std::uint32_t, 3>    mBits {};       ///< @brief The width of each axis, in bits.
+
+    };
+
+    /**
+     * @brief   Packs a rotation into `2 + 3 * pBits` bits with "smallest
+     *          three" compression.
+     *
+     * A unit quaternion's largest component can be recovered from the other
+     * three, since their squares sum to one; and as `q` and `-q` are the same
+     * rotation, it can always be made positive. So only the largest
+     * component's index is stored, in 2 bits, followed by the other three,
+     * which all lie within `[-1/sqrt(2), 1/sqrt(2)]`.
+     *
+     * @param   pRotation   The rotation to pack. Need not be normalized.
+     * @param   pBits       The width of each stored component, from 2 to 10.
+     *
+     * @return  The packed rotation.
+     */
+    inline std::uint32_t QuantizeRotation (
+        const Quaternion4f& pRotation,
+        const std::uint32_t pBits = 10
+    )
+    {
+        const Quaternion4f lRotation = pRotation.Normalized();
+        const float lComponents[4] = {
+            lRotation.mX, lRotation.mY, lRotation.mZ, lRotation.mW };
+
+        std::uint32_t lLargest = 0;
+        for (std::uint32_t i = 1; i < 4; ++i)
+        {
+            if (std::abs(lComponents[i]) > std::abs(lComponents[lLargest]))
+            {
+                lLargest = i;
+            }
+        }
+
+        constexpr float LIMIT = 0.70710678f;
+        const float lSign = (lComponents[lLargest] < 0.0f) ? -1.0f : 1.0f;
+
+        std::uint32_t lPacked = lLargest;
+        std::uint32_t lShift = 2;
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            if (i != lLargest)
+            {
+                lPacked |= QuantizeFloat(lComponents[i] * lSign, -LIMIT, LIMIT, pBits)
+                    << lShift;
+                lShift += pBits;
+            }
+        }
+
+        return lPacked;
+    }
+
+    /**
+     * @brief   Restores a rotation packed by @a `QuantizeRotation`.
+     *
+     * @param   pPacked     The packed rotation.
+     * @param   pBits       The width each component was stored with.
+     *
+     * @return  The restored, normalized rotation.
+     */
+    inline Quaternion4f DequantizeRotation (
+        const std::uint32_t pPacked,
+        const std::uint32_t pBits = 10
+    )
+    {
+        constexpr float LIMIT = 0.70710678f;
+        const std::uint32_t lLargest = pPacked & 0x3;
+        const std::uint32_t lMask = (1u << pBits) - 1;
+
+        float lComponents[4] = {};
+        float lSumSquares = 0.0f;
+        std::uint32_t lShift = 2;
+        for (std::uint32_t i = 0; i < 4; ++i)
+        {
+            if (i != lLargest)
+            {
+                lComponents[i] = DequantizeFloat((pPacked >> lShift) & lMask,
+                    -LIMIT, LIMIT, pBits);
+                lSumSquares += lComponents[i] * lComponents[i];
+                lShift += pBits;
+            }
+        }
+
+        lComponents[lLargest] = std::sqrt(std::max(0.0f, 1.0f - lSumSquares));
+        return Quaternion4f {
+            lComponents[0], lComponents[1], lComponents[2], lComponents[3]
+        }.Normalized();
+    }
+
+}
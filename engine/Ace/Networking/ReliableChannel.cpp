@@ -0,0 +1,436 @@
+/**
+ * @file    Ace/Networking/ReliableChannel.cpp
+ */
+
+#include <Ace/Networking/ReliableChannel.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    static void WriteU16 (
+        std::uint8_t*       pDestination,
+        const std::uint16_t pValue
+    )
+    {
+        pDestination[0] = static_cast<std::uint8_t>(pValue);
+        pDestination[1] = static_cast<std::uint8_t>(pValue >> 8);
+    }
+
+    static void WriteU32 (
+        std::uint8_t*       pDestination,
+        const std::uint32_t pValue
+    )
+    {
+        WriteU16(pDestination, static_cast<std::uint16_t>(pValue));
+        WriteU16(pDestination + 2, static_cast<std::uint16_t>(pValue >> 16));
+    }
+
+    static std::uint16_t ReadU16 (
+        const std::uint8_t* pSource
+    )
+    {
+        return static_cast<std::uint16_t>(pSource[0] | (pSource[1] << 8));
+    }
+
+    static std::uint32_t ReadU32 (
+        const std::uint8_t* pSource
+    )
+    {
+        return ReadU16(pSource) |
+            (static_cast<std::uint32_t>(ReadU16(pSource + 2)) << 16);
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    ReliableChannel::ReliableChannel (
+        PacketPool&             pPool,
+        const NetworkAddress&   pAddress
+    ) :
+        mPool       { pPool },
+        mAddress    { pAddress }
+    {
+
+    }
+
+    ReliableChannel::~ReliableChannel ()
+    {
+        for (auto& lSlot : mSendSlots)
+        {
+            mPool.Release(lSlot.mPacket);
+        }
+
+        for (Packet* lPacket : mReceiveSlots)
+        {
+            mPool.Release(lPacket);
+        }
+
+        for (Packet* lPacket : mPending)
+        {
+            mPool.Release(lPacket);
+        }
+    }
+
+    /* Public Methods *********************************************************/
+
+    void ReliableChannel::QueueReliable (
+        Packet* pPacket
+    )
+    {
+        pPacket->mAddress = mAddress;
+        mPending.push_back(pPacket);
+    }
+
+    void ReliableChannel::PrepareUnreliable (
+        Packet* pPacket
+    )
+    {
+        WriteHeader(pPacket, Kind::Unreliable, 0);
+        mAckPending = false;
+    }
+
+    void ReliableChannel::Receive (
+        Packet*                 pPacket,
+        const Clock::time_point pNow,
+        std::vector<Packet*>&   pDelivered
+    )
+    {
+        if (pPacket->mSize < HEADER_SIZE || pPacket->mData[0] > static_cast<std::uint8_t>(Kind::Ack))
+        {
+            mPool.Release(pPacket);
+            return;
+        }
+
+        const std::uint8_t* lHeader = pPacket->mData.data();
+        const Kind lKind = static_cast<Kind>(lHeader[0]);
+        const std::uint16_t lSequence = ReadU16(lHeader + 1);
+        ProcessAcks(ReadU16(lHeader + 3), ReadU16(lHeader + 5),
+            ReadU32(lHeader + 7), pNow);
+
+        if (lKind == Kind::Ack)
+        {
+            mPool.Release(pPacket);
+            return;
+        }
+        else if (lKind == Kind::Unreliable)
+        {
+            pDelivered.push_back(pPacket);
+            return;
+        }
+
+        // Every reliable datagram is acknowledged, even a duplicate; its
+        // sender may have missed the first acknowledgement.
+        mAckPending = true;
+
+        const std::uint16_t lAhead = lSequence - mNextExpected;
+        if (lAhead >= WINDOW_SIZE)
+        {
+            // Already delivered.
+            mPool.Release(pPacket);
+            return;
+        }
+        else if (lAhead > 0)
+        {
+            // Hold on to it until the gap before it is filled.
+            const std::size_t lIndex = lSequence % WINDOW_SIZE;
+            if (mReceiveSlots[lIndex] != nullptr)
+            {
+                mPool.Release(pPacket);
+            }
+            else
+            {
+                mReceiveSlots[lIndex] = pPacket;
+            }
+
+            if (mAckOwed[lIndex] == false)
+            {
+                mAckOwed[lIndex] = true;
+                ++mAckOwedCount;
+            }
+
+            return;
+        }
+
+        // This is the next message in order. Deliver it, along with any which
+        // arrived early and were waiting on it.
+        pDelivered.push_back(pPacket);
+        ++mNextExpected;
+        while (mReceiveSlots[mNextExpected % WINDOW_SIZE] != nullptr)
+        {
+            // Once delivered, a message is covered by the cumulative ack.
+            const std::size_t lIndex = mNextExpected % WINDOW_SIZE;
+            if (mAckOwed[lIndex] == true)
+            {
+                mAckOwed[lIndex] = false;
+                --mAckOwedCount;
+            }
+
+            pDelivered.push_back(mReceiveSlots[lIndex]);
+            mReceiveSlots[lIndex] = nullptr;
+            ++mNextExpected;
+        }
+    }
+
+    std::size_t ReliableChannel::Update (
+        const Clock::time_point pNow,
+        std::vector<Packet*>&   pOutgoing
+    )
+    {
+        FillWindow();
+
+        std::size_t lCount = 0;
+        for (std::uint16_t lSequence = mOldestUnacked; lSequence != mNextSequence; ++lSequence)
+        {
+            SendSlot& lSlot = mSendSlots[lSequence % WINDOW_SIZE];
+            if (
+                lSlot.mPacket == nullptr ||
+                (lSlot.mSendCount > 0 && pNow - lSlot.mLastSent < GetResendTimeout(lSlot))
+            )
+            {
+                continue;
+            }
+
+            // The original stays in the window until it is acknowledged; the
+            // copy is sent with the latest acknowledgements.
+            Packet* lCopy = mPool.Acquire();
+            if (lCopy == nullptr)
+            {
+                break;
+            }
+
+            lCopy->mAddress = mAddress;
+            lCopy->mSize = lSlot.mPacket->mSize;
+            std::memcpy(lCopy->mData.data(), lSlot.mPacket->mData.data(), lCopy->mSize);
+            WriteHeader(lCopy, Kind::Reliable, lSequence);
+            pOutgoing.push_back(lCopy);
+            ++lCount;
+
+            if (lSlot.mSendCount == 0)
+            {
+                lSlot.mFirstSent = pNow;
+            }
+            else
+            {
+                ++mResendCount;
+            }
+
+            lSlot.mLastSent = pNow;
+            ++lSlot.mSendCount;
+        }
+
+        if (lCount > 0)
+        {
+            mAckPending = false;
+        }
+
+        // Add bare acks until every message received out of order has been
+        // acknowledged. Each one covers at least the oldest still owed.
+        while (mAckPending == true || mAckOwedCount > 0)
+        {
+            Packet* lAck = mPool.Acquire();
+            if (lAck == nullptr)
+            {
+                break;
+            }
+
+            lAck->mAddress = mAddress;
+            lAck->mSize = HEADER_SIZE;
+            WriteHeader(lAck, Kind::Ack, 0);
+            pOutgoing.push_back(lAck);
+            mAckPending = false;
+            ++lCount;
+        }
+
+        return lCount;
+    }
+
+    ReliableChannel::Clock::time_point ReliableChannel::GetNextDeadline () const
+    {
+        auto lDeadline = Clock::time_point::max();
+        for (std::uint16_t lSequence = mOldestUnacked; lSequence != mNextSequence; ++lSequence)
+        {
+            const SendSlot& lSlot = mSendSlots[lSequence % WINDOW_SIZE];
+            if (lSlot.mPacket != nullptr)
+            {
+                lDeadline = std::min(lDeadline,
+                    lSlot.mLastSent + GetResendTimeout(lSlot));
+            }
+        }
+
+        return lDeadline;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void ReliableChannel::WriteHeader (
+        Packet*             pPacket,
+        const Kind          pKind,
+        const std::uint16_t pSequence
+    )
+    {
+        // Bit `i` of the ack bits covers the sequence number `i` past the
+        // base.
+        const std::uint16_t lBase = FindAckBase();
+        std::uint32_t lAckBits = 0;
+        for (std::uint32_t i = 0; i < 32; ++i)
+        {
+            const std::uint16_t lSequence = lBase + i;
+            if (static_cast<std::uint16_t>(lSequence - mNextExpected) >= WINDOW_SIZE)
+            {
+                break;
+            }
+
+            const std::size_t lIndex = lSequence % WINDOW_SIZE;
+            if (mReceiveSlots[lIndex] != nullptr)
+            {
+                lAckBits |= (1u << i);
+                if (mAckOwed[lIndex] == true)
+                {
+                    mAckOwed[lIndex] = false;
+                    --mAckOwedCount;
+                }
+            }
+        }
+
+        std::uint8_t* lHeader = pPacket->mData.data();
+        lHeader[0] = static_cast<std::uint8_t>(pKind);
+        WriteU16(lHeader + 1, pSequence);
+        WriteU16(lHeader + 3, mNextExpected);
+        WriteU16(lHeader + 5, lBase);
+        WriteU32(lHeader + 7, lAckBits);
+    }
+
+    std::uint16_t ReliableChannel::FindAckBase () const
+    {
+        // The next message expected has not arrived, or it would have been
+        // delivered, so the ack bits can start just past it.
+        const std::uint16_t lFirst = mNextExpected + 1;
+        if (mAckOwedCount == 0)
+        {
+            return lFirst;
+        }
+
+        for (std::uint16_t i = 0; i < WINDOW_SIZE - 1; ++i)
+        {
+            const std::uint16_t lSequence = lFirst + i;
+            if (mAckOwed[lSequence % WINDOW_SIZE] == true)
+            {
+                return lSequence;
+            }
+        }
+
+        return lFirst;
+    }
+
+    void ReliableChannel::ProcessAcks (
+        const std::uint16_t     pAck,
+        const std::uint16_t     pAckBase,
+        const std::uint32_t     pAckBits,
+        const Clock::time_point pNow
+    )
+    {
+        // Ignore acknowledgements of sequence numbers never sent, such as
+        // those carried by a stale, reordered datagram.
+        const std::uint16_t lInFlight = mNextSequence - mOldestUnacked;
+        const std::uint16_t lCumulative = pAck - mOldestUnacked;
+        if (lCumulative > lInFlight)
+        {
+            return;
+        }
+
+        // Everything before the ack has been received...
+        for (std::uint16_t i = 0; i < lCumulative; ++i)
+        {
+            Acknowledge(mOldestUnacked + i, pNow);
+        }
+
+        // ...as has anything the ack bits mark as received out of order.
+        for (std::uint32_t i = 0; i < 32; ++i)
+        {
+            const std::uint16_t lSequence = pAckBase + i;
+            if (
+                (pAckBits & (1u << i)) != 0 &&
+                static_cast<std::uint16_t>(lSequence - mOldestUnacked) < lInFlight
+            )
+            {
+                Acknowledge(lSequence, pNow);
+            }
+        }
+
+        while (
+            mOldestUnacked != mNextSequence &&
+            mSendSlots[mOldestUnacked % WINDOW_SIZE].mPacket == nullptr
+        )
+        {
+            ++mOldestUnacked;
+        }
+    }
+
+    void ReliableChannel::Acknowledge (
+        const std::uint16_t     pSequence,
+        const Clock::time_point pNow
+    )
+    {
+        SendSlot& lSlot = mSendSlots[pSequence % WINDOW_SIZE];
+        if (lSlot.mPacket == nullptr)
+        {
+            return;
+        }
+
+        // Only a message sent once gives an unambiguous round trip time.
+        if (lSlot.mSendCount == 1)
+        {
+            const auto lSample = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                pNow - lSlot.mFirstSent);
+            if (mSmoothedRtt == std::chrono::nanoseconds::zero())
+            {
+                mSmoothedRtt = lSample;
+                mRttVariance = lSample / 2;
+            }
+            else
+            {
+                const auto lError = (lSample > mSmoothedRtt) ?
+                    lSample - mSmoothedRtt : mSmoothedRtt - lSample;
+                mRttVariance = (mRttVariance * 3 + lError) / 4;
+                mSmoothedRtt = (mSmoothedRtt * 7 + lSample) / 8;
+            }
+
+            mResendTimeout = std::clamp<std::chrono::nanoseconds>(
+                mSmoothedRtt + mRttVariance * 4,
+                MIN_RESEND_TIMEOUT, MAX_RESEND_TIMEOUT);
+        }
+
+        mPool.Release(lSlot.mPacket);
+        lSlot = {};
+    }
+
+    void ReliableChannel::FillWindow ()
+    {
+        while (
+            mPending.empty() == false &&
+            static_cast<std::uint16_t>(mNextSequence - mOldestUnacked) < WINDOW_SIZE
+        )
+        {
+            SendSlot& lSlot = mSendSlots[mNextSequence % WINDOW_SIZE];
+            lSlot = {};
+            lSlot.mPacket = mPending.front();
+            mPending.pop_front();
+            ++mNextSequence;
+        }
+    }
+
+    ReliableChannel::Clock::duration ReliableChannel::GetResendTimeout (
+        const SendSlot& pSlot
+    ) const
+    {
+        // Double the timeout with each resend, up to eight times over, so that
+        // a congested link is not flooded with copies.
+        const std::uint32_t lShift = std::min<std::uint32_t>(
+            (pSlot.mSendCount > 0) ? pSlot.mSendCount - 1 : 0, 3);
+        return std::chrono::duration_cast<Clock::duration>(
+            std::min<std::chrono::nanoseconds>(mResendTimeout * (1 << lShift),
+                MAX_RESEND_TIMEOUT * 8));
+    }
+
+}
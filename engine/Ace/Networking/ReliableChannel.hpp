@@ -0,0 +1,332 @@
+/**
+ * @file    Ace/Networking/ReliableChannel.hpp
+ * @brief   Provides a class which layers reliable, ordered delivery over an
+ *          unreliable datagram transport.
+ */
+
+#pragma once
+#include <deque>
+#include <Ace/Networking/PacketPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the delivery guarantees a message can be sent with.
+     */
+    enum class NetworkDelivery : std::uint8_t
+    {
+        Unreliable,         ///< @brief The message may be lost, duplicated or reordered.
+        ReliableOrdered     ///< @brief The message arrives exactly once, after every reliable message sent before it.
+    };
+
+    /**
+     * @brief   A class which keeps one peer's end of a reliable, ordered
+     *          message stream, on top of datagrams which may be lost,
+     *          duplicated or reordered.
+     *
+     * Every datagram starts with a @a `HEADER_SIZE`-byte header:
+     *
+     * | Offset | Size | Field                                              |
+     * |--------|------|----------------------------------------------------|
+     * | 0      | 1    | The datagram's kind: unreliable, reliable or ack.  |
+     * | 1      | 2    | The reliable sequence number, if reliable.         |
+     * | 3      | 2    | The next reliable sequence number expected; every  |
+     * |        |      | one before it has been received.                   |
+     * | 5      | 2    | The first sequence number covered by the ack bits. |
+     * | 7      | 4    | A bit per sequence number from the one above, set  |
+     * |        |      | if it has been received out of order.              |
+     *
+     * Every datagram sent, of any kind, acknowledges what has been received,
+     * so acknowledgements ride along with traffic; a bare ack is only sent
+     * when there is nothing else to carry one. The ack bits cover the oldest
+     * out-of-order messages not yet acknowledged, and bare acks are added
+     * until every one has been, so that a single loss does not cause the
+     * whole window behind it to be resent. Reliable datagrams are resent
+     * until acknowledged, after a timeout derived from the measured round trip
+     * time, which backs off with each resend. Up to @a `WINDOW_SIZE` reliable
+     * datagrams may be unacknowledged at once; later ones wait their turn.
+     *
+     * A channel is not thread-safe; it is only ever used by the thread
+     * running a @a `NetworkHost`'s event loop.
+     */
+    class ACE_API ReliableChannel final
+    {
+    public:
+
+        /**
+         * @brief   The size of the header at the start of every datagram.
+         */
+        static constexpr std::size_t HEADER_SIZE = 11;
+
+        /**
+         * @brief   The largest payload a single message can carry.
+         */
+        static constexpr std::size_t MAX_PAYLOAD_SIZE = MAX_PACKET_SIZE - HEADER_SIZE;
+
+        /**
+         * @brief   The largest number of reliable datagrams which may be
+         *          unacknowledged at once.
+         */
+        static constexpr std::size_t WINDOW_SIZE = 256;
+
+        /**
+         * @brief   The shortest and longest time waited for an
+         *          acknowledgement before the first resend.
+         */
+        static constexpr std::chrono::milliseconds MIN_RESEND_TIMEOUT { 10 };
+        static constexpr std::chrono::milliseconds MAX_RESEND_TIMEOUT { 1000 };
+
+        using Clock = std::chrono::steady_clock;
+
+    public:
+
+        /**
+         * @brief   Constructs a channel to the given peer.
+         *
+         * @param   pPool       The pool which packets are borrowed from, and
+         *                      returned to. It must outlive the channel.
+         * @param   pAddress    The peer's address.
+         */
+        explicit ReliableChannel (
+            PacketPool&             pPool,
+            const NetworkAddress&   pAddress
+        );
+
+        /**
+         * @brief   The destructor returns every packet still held by the
+         *          channel to its pool.
+         */
+        ~ReliableChannel ();
+
+    public:
+
+        /**
+         * @brief   Queues a message for reliable, ordered delivery. It is sent
+         *          by the next call to @a `Update` which has room for it in
+         *          the window.
+         *
+         * @param   pPacket     A packet containing the message's payload,
+         *                      starting @a `HEADER_SIZE` bytes in. The channel
+         *                      takes ownership of it.
+         */
+        void QueueReliable (
+            Packet* pPacket
+        );
+
+        /**
+         * @brief   Writes the header of an unreliable message, carrying the
+         *          latest acknowledgements.
+         *
+         * @param   pPacket     A packet containing the message's payload,
+         *                      starting @a `HEADER_SIZE` bytes in. The caller
+         *                      keeps ownership of it, and sends it.
+         */
+        void PrepareUnreliable (
+            Packet* pPacket
+        );
+
+        /**
+         * @brief   Processes a datagram received from the peer.
+         *
+         * @param   pPacket     The received packet. The channel takes
+         *                      ownership of it.
+         * @param   pNow        The current time.
+         * @param   pDelivered  Receives, in order, every packet which is now
+         *                      ready to be delivered. The caller takes
+         *                      ownership of them.
+         */
+        void Receive (
+            Packet*                 pPacket,
+            const Clock::time_point pNow,
+            std::vector<Packet*>&   pDelivered
+        );
+
+        /**
+         * @brief   Collects the datagrams which are due to be sent: reliable
+         *          messages not yet sent, or not acknowledged in time, and a
+         *          bare acknowledgement if one is owed.
+         *
+         * @param   pNow        The current time.
+         * @param   pOutgoing   Receives copies of the datagrams to send. The
+         *                      caller takes ownership of them.
+         *
+         * @return  The number of datagrams collected.
+         */
+        std::size_t Update (
+            const Clock::time_point pNow,
+            std::vector<Packet*>&   pOutgoing
+        );
+
+        /**
+         * @brief   Retrieves the delivery guarantee a received message was sent
+         *          with.
+         *
+         * @param   pPacket     A packet delivered by @a `Receive`.
+         *
+         * @return  The message's delivery guarantee.
+         */
+        static inline NetworkDelivery GetDelivery (
+            const Packet&   pPacket
+        )
+        {
+            return (pPacket.mData[0] == static_cast<std::uint8_t>(Kind::Reliable)) ?
+                NetworkDelivery::ReliableOrdered : NetworkDelivery::Unreliable;
+        }
+
+        /**
+         * @brief   Forces the next call to @a `Update` to send at least a bare
+         *          acknowledgement, such as to keep the peer from timing out.
+         */
+        inline void RequestAck ()
+        {
+            mAckPending = true;
+        }
+
+        /**
+         * @brief   Retrieves the time by which @a `Update` next needs to be
+         *          called to resend an unacknowledged message.
+         *
+         * @return  The next resend deadline, or `Clock::time_point::max()` if
+         *          nothing is waiting to be acknowledged.
+         */
+        Clock::time_point GetNextDeadline () const;
+
+        /**
+         * @brief   Retrieves the smoothed round trip time to the peer.
+         *
+         * @return  The round trip time, or zero if none has been measured.
+         */
+        inline std::chrono::nanoseconds GetRoundTripTime () const
+        {
+            return mSmoothedRtt;
+        }
+
+        /**
+         * @brief   Retrieves the number of reliable datagrams resent so far.
+         *
+         * @return  The number of resends.
+         */
+        inline std::size_t GetResendCount () const
+        {
+            return mResendCount;
+        }
+
+        /**
+         * @brief   Retrieves the number of reliable messages which have not
+         *          yet been acknowledged, including those waiting for room in
+         *          the window.
+         *
+         * @return  The number of unacknowledged messages.
+         */
+        inline std::size_t GetUnackedCount () const
+        {
+            return static_cast<std::uint16_t>(mNextSequence - mOldestUnacked) +
+                mPending.size();
+        }
+
+    private:
+        ReliableChannel (const ReliableChannel&) = delete;
+        ReliableChannel (ReliableChannel&&) = delete;
+        void operator= (const ReliableChannel&) = delete;
+        void operator= (ReliableChannel&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Enumerates the kinds of datagram.
+         */
+        enum class Kind : std::uint8_t
+        {
+            Unreliable,
+            Reliable,
+            Ack
+        };
+
+        /**
+         * @brief   A structure containing one reliable message awaiting
+         *          acknowledgement.
+         */
+        struct SendSlot
+        {
+            Packet*             mPacket = nullptr;  ///< @brief The message, or `nullptr` if the slot is free.
+            Clock::time_point   mFirstSent;         ///< @brief When the message was first sent.
+            Clock::time_point   mLastSent;          ///< @brief When the message was last sent.
+            std::uint32_t       mSendCount = 0;     ///< @brief The number of times the message has been sent.
+        };
+
+    private:
+
+        /**
+         * @brief   Writes the datagram's kind and sequence number, and the
+         *          latest acknowledgements, into a packet's header. Clears the
+         *          owed flags of the messages its ack bits cover.
+         */
+        void WriteHeader (
+            Packet*             pPacket,
+            const Kind          pKind,
+            const std::uint16_t pSequence
+        );
+
+        /**
+         * @brief   Finds the sequence number the next header's ack bits should
+         *          start at: the oldest message received out of order and not
+         *          yet acknowledged, if any.
+         */
+        std::uint16_t FindAckBase () const;
+
+        /**
+         * @brief   Releases the messages the peer has acknowledged.
+         */
+        void ProcessAcks (
+            const std::uint16_t     pAck,
+            const std::uint16_t     pAckBase,
+            const std::uint32_t     pAckBits,
+            const Clock::time_point pNow
+        );
+
+        /**
+         * @brief   Releases one acknowledged message, sampling the round trip
+         *          time if it was only sent once.
+         */
+        void Acknowledge (
+            const std::uint16_t     pSequence,
+            const Clock::time_point pNow
+        );
+
+        /**
+         * @brief   Moves queued messages into the window while it has room.
+         */
+        void FillWindow ();
+
+        /**
+         * @brief   Retrieves how long to wait for a message's acknowledgement
+         *          before resending it.
+         */
+        Clock::duration GetResendTimeout (
+            const SendSlot& pSlot
+        ) const;
+
+    private:
+        PacketPool&                             mPool;                  ///< @brief The pool packets are borrowed from.
+        NetworkAddress                          mAddress;               ///< @brief The peer's address.
+
+        std::array<SendSlot, WINDOW_SIZE>       mSendSlots {};          ///< @brief The messages awaiting acknowledgement, by sequence number.
+        std::deque<Packet*>                     mPending;               ///< @brief The messages waiting for room in the window.
+        std::uint16_t                           mOldestUnacked = 0;     ///< @brief The oldest sequence number not yet acknowledged.
+        std::uint16_t                           mNextSequence = 0;      ///< @brief The next sequence number to be sent.
+
+        std::array<Packet*, WINDOW_SIZE>        mReceiveSlots {};       ///< @brief The messages received out of order, by sequence number.
+        std::uint16_t                           mNextExpected = 0;      ///< @brief The next sequence number to be delivered.
+        std::array<bool, WINDOW_SIZE>           mAckOwed {};            ///< @brief Has the message in each receive slot arrived since its ack bit was last sent?
+        std::size_t                             mAckOwedCount = 0;      ///< @brief The number of set flags in @a `mAckOwed`.
+        bool                                    mAckPending = false;    ///< @brief Is an acknowledgement owed to the peer?
+
+        std::chrono::nanoseconds                mSmoothedRtt { 0 };     ///< @brief The smoothed round trip time.
+        std::chrono::nanoseconds                mRttVariance { 0 };     ///< @brief The round trip time's smoothed variation.
+        std::chrono::nanoseconds                mResendTimeout { 100'000'000 }; ///< @brief The time waited before a message's first resend.
+        std::size_t                             mResendCount = 0;       ///< @brief The number of resends so far.
+
+    };
+
+}
@@ -0,0 +1,540 @@
+/**
+ * @file    Ace/Networking/SnapshotReplication.cpp
+ */
+
+#include <Ace/Networking/SnapshotReplication.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    //
+    // Every chunk starts with a byte-aligned header:
+    //
+    // | Offset | Size | Field                                                |
+    // |--------|------|------------------------------------------------------|
+    // | 0      | 2    | The snapshot's sequence number.                      |
+    // | 2      | 2    | The baseline's sequence number, if there is one.     |
+    // | 4      | 1    | Flags; bit 0 is set if there is a baseline.          |
+    // | 5      | 2    | The first entity slot in the chunk.                  |
+    // | 7      | 2    | The number of entity slots in the chunk.             |
+    //
+    // The entity count is not known until the chunk is full, so it is patched
+    // in afterwards.
+    //
+    static constexpr std::size_t CHUNK_HEADER_SIZE = 9;
+    static constexpr std::size_t CHUNK_COUNT_OFFSET = 7;
+
+    //
+    // Each position axis is sent as one of four size classes: unchanged, a
+    // zigzag-encoded delta which fits in `SMALL_DELTA_BITS` or
+    // `MEDIUM_DELTA_BITS`, or the axis's absolute value.
+    //
+    static constexpr std::uint32_t SMALL_DELTA_BITS = 6;
+    static constexpr std::uint32_t MEDIUM_DELTA_BITS = 12;
+
+    static void ValidateSpec (
+        const SnapshotSpec& pSpec,
+        const char*         pOwner
+    )
+    {
+        if (
+            pSpec.mEntityCount == 0 ||
+            pSpec.mEntityCount > 65535 ||
+            pSpec.mRotationBits < 2 ||
+            pSpec.mRotationBits > 10 ||
+            pSpec.mMaxChunkSize < CHUNK_HEADER_SIZE + 24
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Invalid snapshot settings!",
+                pOwner);
+        }
+    }
+
+    static void EncodeAxis (
+        BitWriter&          pWriter,
+        const std::uint32_t pBase,
+        const std::uint32_t pCurrent,
+        const std::uint32_t pAxisBits
+    )
+    {
+        const std::int64_t lDelta = static_cast<std::int64_t>(pCurrent) - pBase;
+        const std::uint64_t lZigZag = (lDelta >= 0) ?
+            static_cast<std::uint64_t>(lDelta) << 1 :
+            (static_cast<std::uint64_t>(-lDelta) << 1) - 1;
+
+        if (lDelta == 0)
+        {
+            pWriter.WriteBits(0, 2);
+        }
+        else if (lZigZag < (1u << SMALL_DELTA_BITS))
+        {
+            pWriter.WriteBits(1, 2);
+            pWriter.WriteBits(static_cast<std::uint32_t>(lZigZag), SMALL_DELTA_BITS);
+        }
+        else if (lZigZag < (1u << MEDIUM_DELTA_BITS))
+        {
+            pWriter.WriteBits(2, 2);
+            pWriter.WriteBits(static_cast<std::uint32_t>(lZigZag), MEDIUM_DELTA_BITS);
+        }
+        else
+        {
+            pWriter.WriteBits(3, 2);
+            pWriter.WriteBits(pCurrent, pAxisBits);
+        }
+    }
+
+    static std::uint32_t DecodeAxis (
+        BitReader&          pReader,
+        const std::uint32_t pBase,
+        const std::uint32_t pAxisBits
+    )
+    {
+        const std::uint32_t lClass = pReader.ReadBits(2);
+        if (lClass == 0)
+        {
+            return pBase;
+        }
+        else if (lClass == 3)
+        {
+            return pReader.ReadBits(pAxisBits);
+        }
+
+        const std::uint32_t lZigZag = pReader.ReadBits(
+            (lClass == 1) ? SMALL_DELTA_BITS : MEDIUM_DELTA_BITS);
+        const std::int64_t lDelta = (lZigZag & 1) ?
+            -static_cast<std::int64_t>((lZigZag + 1) >> 1) :
+            static_cast<std::int64_t>(lZigZag >> 1);
+        return static_cast<std::uint32_t>(pBase + lDelta);
+    }
+
+    static void EncodeEntity (
+        BitWriter&                  pWriter,
+        const QuantizedEntity&      pBase,
+        const QuantizedEntity&      pCurrent,
+        const PositionQuantizer&    pQuantizer,
+        const std::uint32_t         pRotationBits
+    )
+    {
+        // An unchanged entity costs a single bit.
+        if (pCurrent == pBase)
+        {
+            pWriter.WriteBool(false);
+            return;
+        }
+
+        pWriter.WriteBool(true);
+        pWriter.WriteBool(pCurrent.mActive);
+        if (pCurrent.mActive == false)
+        {
+            return;
+        }
+
+        const std::uint32_t lCurrent[3] = {
+            pCurrent.mPosition.mX, pCurrent.mPosition.mY, pCurrent.mPosition.mZ };
+
+        // A newly active entity has nothing to be a delta against.
+        if (pBase.mActive == false)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                pWriter.WriteBits(lCurrent[i], pQuantizer.GetBits(i));
+            }
+
+            pWriter.WriteBits(pCurrent.mRotation, pRotationBits);
+            return;
+        }
+
+        const bool lMoved = (pCurrent.mPosition == pBase.mPosition) == false;
+        pWriter.WriteBool(lMoved);
+        if (lMoved == true)
+        {
+            const std::uint32_t lBase[3] = {
+                pBase.mPosition.mX, pBase.mPosition.mY, pBase.mPosition.mZ };
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                EncodeAxis(pWriter, lBase[i], lCurrent[i], pQuantizer.GetBits(i));
+            }
+        }
+
+        const bool lTurned = pCurrent.mRotation != pBase.mRotation;
+        pWriter.WriteBool(lTurned);
+        if (lTurned == true)
+        {
+            pWriter.WriteBits(pCurrent.mRotation, pRotationBits);
+        }
+    }
+
+    static QuantizedEntity DecodeEntity (
+        BitReader&                  pReader,
+        const QuantizedEntity&      pBase,
+        const PositionQuantizer&    pQuantizer,
+        const std::uint32_t         pRotationBits
+    )
+    {
+        if (pReader.ReadBool() == false)
+        {
+            return pBase;
+        }
+
+        QuantizedEntity lEntity;
+        lEntity.mActive = pReader.ReadBool();
+        if (lEntity.mActive == false)
+        {
+            return lEntity;
+        }
+
+        if (pBase.mActive == false)
+        {
+            lEntity.mPosition.mX = pReader.ReadBits(pQuantizer.GetBits(0));
+            lEntity.mPosition.mY = pReader.ReadBits(pQuantizer.GetBits(1));
+            lEntity.mPosition.mZ = pReader.ReadBits(pQuantizer.GetBits(2));
+            lEntity.mRotation = pReader.ReadBits(pRotationBits);
+            return lEntity;
+        }
+
+        lEntity.mPosition = pBase.mPosition;
+        if (pReader.ReadBool() == true)
+        {
+            lEntity.mPosition.mX = DecodeAxis(pReader, pBase.mPosition.mX, pQuantizer.GetBits(0));
+            lEntity.mPosition.mY = DecodeAxis(pReader, pBase.mPosition.mY, pQuantizer.GetBits(1));
+            lEntity.mPosition.mZ = DecodeAxis(pReader, pBase.mPosition.mZ, pQuantizer.GetBits(2));
+        }
+
+        lEntity.mRotation = (pReader.ReadBool() == true) ?
+            pReader.ReadBits(pRotationBits) : pBase.mRotation;
+        return lEntity;
+    }
+
+    /* `SnapshotReplicator` Class *********************************************/
+
+    SnapshotReplicator::SnapshotReplicator (
+        const SnapshotSpec& pSpec
+    ) :
+        mSpec       { pSpec },
+        mQuantizer  { pSpec.mBounds, pSpec.mPositionResolution }
+    {
+        ValidateSpec(pSpec, "SnapshotReplicator");
+
+        // The changed, active, moved and turned flags, plus the larger of a
+        // delta-encoded and an absolute entity.
+        std::uint32_t lMaxAxisBits = 0;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lMaxAxisBits = std::max(lMaxAxisBits, mQuantizer.GetBits(i));
+        }
+
+        mMaxEntityBits = 4 + 3 * (2 + std::max(lMaxAxisBits, MEDIUM_DELTA_BITS)) +
+            (2 + 3 * pSpec.mRotationBits);
+
+        mCurrent.resize(pSpec.mEntityCount);
+        mEmpty.resize(pSpec.mEntityCount);
+        mChunk.resize(pSpec.mMaxChunkSize);
+    }
+
+    void SnapshotReplicator::SetEntity (
+        const std::size_t&  pIndex,
+        const Vector3f&     pPosition,
+        const Quaternion4f& pRotation
+    )
+    {
+        QuantizedEntity& lEntity = mCurrent.at(pIndex);
+        lEntity.mActive = true;
+        lEntity.mPosition = mQuantizer.Quantize(pPosition);
+        lEntity.mRotation = QuantizeRotation(pRotation, mSpec.mRotationBits);
+    }
+
+    void SnapshotReplicator::RemoveEntity (
+        const std::size_t&  pIndex
+    )
+    {
+        mCurrent.at(pIndex) = {};
+    }
+
+    std::uint16_t SnapshotReplicator::Capture ()
+    {
+        if (mHasLatest == true)
+        {
+            ++mLatest;
+        }
+
+        Snapshot& lSnapshot = mHistory[mLatest % HISTORY_SIZE];
+        lSnapshot.mSequence = mLatest;
+        lSnapshot.mValid = true;
+        lSnapshot.mEntities = mCurrent;
+        mHasLatest = true;
+        return mLatest;
+    }
+
+    SnapshotReplicator::ClientId SnapshotReplicator::AddClient ()
+    {
+        const ClientId lClient = mNextClient++;
+        mClients.emplace(lClient, Client {});
+        return lClient;
+    }
+
+    void SnapshotReplicator::RemoveClient (
+        const ClientId  pClient
+    )
+    {
+        mClients.erase(pClient);
+    }
+
+    void SnapshotReplicator::Acknowledge (
+        const ClientId      pClient,
+        const std::uint16_t pSequence
+    )
+    {
+        auto lIter = mClients.find(pClient);
+        if (lIter == mClients.end() || FindSnapshot(pSequence) == nullptr)
+        {
+            return;
+        }
+
+        // Acknowledgements may arrive out of order; only ever move forwards.
+        Client& lClient = lIter->second;
+        if (
+            lClient.mHasBaseline == false ||
+            static_cast<std::int16_t>(pSequence - lClient.mBaseline) > 0
+        )
+        {
+            lClient.mBaseline = pSequence;
+            lClient.mHasBaseline = true;
+        }
+    }
+
+    std::size_t SnapshotReplicator::Encode (
+        const ClientId                                                  pClient,
+        const std::function<void (std::span<const std::uint8_t>)>&      pEmit
+    )
+    {
+        auto lIter = mClients.find(pClient);
+        if (lIter == mClients.end() || mHasLatest == false)
+        {
+            return 0;
+        }
+
+        const Snapshot& lLatest = mHistory[mLatest % HISTORY_SIZE];
+        const Client& lClient = lIter->second;
+        const Snapshot* lBaseline = (lClient.mHasBaseline == true) ?
+            FindSnapshot(lClient.mBaseline) : nullptr;
+        const auto& lBase = (lBaseline != nullptr) ? lBaseline->mEntities : mEmpty;
+
+        std::size_t lTotal = 0;
+        std::size_t lIndex = 0;
+        while (lIndex < mSpec.mEntityCount)
+        {
+            BitWriter lWriter { mChunk };
+            lWriter.WriteBits(mLatest, 16);
+            lWriter.WriteBits((lBaseline != nullptr) ? lBaseline->mSequence : 0, 16);
+            lWriter.WriteBits((lBaseline != nullptr) ? 1 : 0, 8);
+            lWriter.WriteBits(static_cast<std::uint32_t>(lIndex), 16);
+            lWriter.WriteBits(0, 16);
+
+            // Fill the chunk while the worst case entity still fits.
+            const std::size_t lFirst = lIndex;
+            while (
+                lIndex < mSpec.mEntityCount &&
+                lWriter.GetBitsRemaining() >= mMaxEntityBits
+            )
+            {
+                EncodeEntity(lWriter, lBase[lIndex], lLatest.mEntities[lIndex],
+                    mQuantizer, 2 + 3 * mSpec.mRotationBits);
+                ++lIndex;
+            }
+
+            const std::size_t lSize = lWriter.Flush();
+            const std::size_t lCount = lIndex - lFirst;
+            mChunk[CHUNK_COUNT_OFFSET] = static_cast<std::uint8_t>(lCount);
+            mChunk[CHUNK_COUNT_OFFSET + 1] = static_cast<std::uint8_t>(lCount >> 8);
+
+            pEmit(std::span<const std::uint8_t> { mChunk.data(), lSize });
+            lTotal += lSize;
+        }
+
+        return lTotal;
+    }
+
+    const SnapshotReplicator::Snapshot* SnapshotReplicator::FindSnapshot (
+        const std::uint16_t pSequence
+    ) const
+    {
+        const Snapshot& lSnapshot = mHistory[pSequence % HISTORY_SIZE];
+        if (
+            lSnapshot.mValid == false ||
+            lSnapshot.mSequence != pSequence ||
+            static_cast<std::uint16_t>(mLatest - pSequence) >= HISTORY_SIZE
+        )
+        {
+            return nullptr;
+        }
+
+        return &lSnapshot;
+    }
+
+    /* `SnapshotReceiver` Class ***********************************************/
+
+    SnapshotReceiver::SnapshotReceiver (
+        const SnapshotSpec& pSpec
+    ) :
+        mSpec       { pSpec },
+        mQuantizer  { pSpec.mBounds, pSpec.mPositionResolution }
+    {
+        ValidateSpec(pSpec, "SnapshotReceiver");
+
+        mEmpty.resize(pSpec.mEntityCount);
+        for (auto& lSnapshot : mHistory)
+        {
+            lSnapshot.mEntities.resize(pSpec.mEntityCount);
+            lSnapshot.mDecoded.resize(pSpec.mEntityCount);
+        }
+    }
+
+    bool SnapshotReceiver::Receive (
+        std::span<const std::uint8_t>   pChunk
+    )
+    {
+        BitReader lReader { pChunk };
+        const std::uint16_t lSequence = static_cast<std::uint16_t>(lReader.ReadBits(16));
+        const std::uint16_t lBaseSequence = static_cast<std::uint16_t>(lReader.ReadBits(16));
+        const bool lHasBaseline = (lReader.ReadBits(8) & 1) != 0;
+        const std::size_t lFirst = lReader.ReadBits(16);
+        const std::size_t lCount = lReader.ReadBits(16);
+        if (
+            lReader.IsOverflowed() == true ||
+            lCount == 0 ||
+            lFirst + lCount > mSpec.mEntityCount ||
+            (mHasLatest == true && static_cast<std::int16_t>(lSequence - mLatest) <= 0)
+        )
+        {
+            return false;
+        }
+
+        // The baseline must be a whole snapshot this receiver still holds.
+        Snapshot& lSnapshot = mHistory[lSequence % SnapshotReplicator::HISTORY_SIZE];
+        const std::vector<QuantizedEntity>* lBase = &mEmpty;
+        if (lHasBaseline == true)
+        {
+            const Snapshot& lBaseline =
+                mHistory[lBaseSequence % SnapshotReplicator::HISTORY_SIZE];
+            if (
+                lBaseline.mInUse == false ||
+                lBaseline.mComplete == false ||
+                lBaseline.mSequence != lBaseSequence ||
+                &lBaseline == &lSnapshot
+            )
+            {
+                return false;
+            }
+
+            lBase = &lBaseline.mEntities;
+        }
+
+        if (lSnapshot.mInUse == false || lSnapshot.mSequence != lSequence)
+        {
+            // Never reuse the slot of the latest whole snapshot; it is still
+            // being read.
+            if (
+                mHasLatest == true &&
+                &lSnapshot == &mHistory[mLatest % SnapshotReplicator::HISTORY_SIZE]
+            )
+            {
+                return false;
+            }
+
+            lSnapshot.mSequence = lSequence;
+            lSnapshot.mInUse = true;
+            lSnapshot.mComplete = false;
+            lSnapshot.mCovered = 0;
+            std::fill(lSnapshot.mDecoded.begin(), lSnapshot.mDecoded.end(), false);
+        }
+        else if (lSnapshot.mComplete == true || lSnapshot.mDecoded[lFirst] == true)
+        {
+            // A duplicate.
+            return false;
+        }
+
+        const std::uint32_t lRotationBits = 2 + 3 * mSpec.mRotationBits;
+        for (std::size_t i = lFirst; i < lFirst + lCount; ++i)
+        {
+            lSnapshot.mEntities[i] =
+                DecodeEntity(lReader, (*lBase)[i], mQuantizer, lRotationBits);
+        }
+
+        if (lReader.IsOverflowed() == true)
+        {
+            return false;
+        }
+
+        for (std::size_t i = lFirst; i < lFirst + lCount; ++i)
+        {
+            if (lSnapshot.mDecoded[i] == false)
+            {
+                lSnapshot.mDecoded[i] = true;
+                ++lSnapshot.mCovered;
+            }
+        }
+
+        if (lSnapshot.mCovered < mSpec.mEntityCount)
+        {
+            return false;
+        }
+
+        lSnapshot.mComplete = true;
+        mLatest = lSequence;
+        mHasLatest = true;
+        mAckPending = true;
+        return true;
+    }
+
+    std::optional<std::uint16_t> SnapshotReceiver::TakeAcknowledgement ()
+    {
+        if (mAckPending == false)
+        {
+            return std::nullopt;
+        }
+
+        mAckPending = false;
+        return mLatest;
+    }
+
+    std::optional<std::uint16_t> SnapshotReceiver::GetLatestSequence () const
+    {
+        if (mHasLatest == false)
+        {
+            return std::nullopt;
+        }
+
+        return mLatest;
+    }
+
+    std::span<const QuantizedEntity> SnapshotReceiver::GetEntities () const
+    {
+        if (mHasLatest == false)
+        {
+            return {};
+        }
+
+        return mHistory[mLatest % SnapshotReplicator::HISTORY_SIZE].mEntities;
+    }
+
+    bool SnapshotReceiver::GetEntity (
+        const std::size_t&  pIndex,
+        Vector3f&           pPosition,
+        Quaternion4f&       pRotation
+    ) const
+    {
+        const auto lEntities = GetEntities();
+        if (pIndex >= lEntities.size() || lEntities[pIndex].mActive == false)
+        {
+            return false;
+        }
+
+        pPosition = mQuantizer.Dequantize(lEntities[pIndex].mPosition);
+        pRotation = DequantizeRotation(lEntities[pIndex].mRotation,
+            mSpec.mRotationBits);
+        return true;
+    }
+
+}
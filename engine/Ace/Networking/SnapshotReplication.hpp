@@ -0,0 +1,334 @@
+/**
+ * @file    Ace/Networking/SnapshotReplication.hpp
+ * @brief   Provides classes which replicate the state of many entities from a
+ *          server to its clients as delta-compressed snapshots.
+ */
+
+#pragma once
+#include <Ace/Networking/BitStream.hpp>
+#include <Ace/Networking/Quantization.hpp>
+#include <Ace/Networking/ReliableChannel.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure containing the settings shared by a
+     *          @a `SnapshotReplicator` and the @a `SnapshotReceiver`s of its
+     *          clients. Both ends must use the same settings.
+     */
+    struct SnapshotSpec
+    {
+        std::size_t     mEntityCount = 1024;                                                ///< @brief The number of entity slots replicated. At most 65535.
+        AABB3f          mBounds = AABB3f::FromCenterExtents({}, { 2048.0f, 2048.0f, 2048.0f }); ///< @brief The box every replicated position lies in.
+        float           mPositionResolution = 1.0f / 512.0f;                                ///< @brief The precision positions are replicated to, in world units.
+        std::uint32_t   mRotationBits = 10;                                                 ///< @brief The width of each stored rotation component, from 2 to 10.
+        std::size_t     mMaxChunkSize = ReliableChannel::MAX_PAYLOAD_SIZE;                  ///< @brief The largest chunk a snapshot is split into, in bytes.
+    };
+
+    /**
+     * @brief   A structure containing one entity's quantized state.
+     */
+    struct QuantizedEntity
+    {
+        Vector3u        mPosition;          ///< @brief The entity's fixed-point position.
+        std::uint32_t   mRotation = 0;      ///< @brief The entity's packed rotation.
+        bool            mActive = false;    ///< @brief Does the entity exist?
+
+        constexpr bool operator== (const QuantizedEntity&) const = default;
+    };
+
+    /**
+     * @brief   A class which captures snapshots of the server's entities, and
+     *          encodes them for each client as a delta against the latest
+     *          snapshot that client has acknowledged.
+     *
+     * Entity states are quantized as they are set: positions to fixed point
+     * within the spec's bounds, and rotations with "smallest three"
+     * compression. @a `Capture` copies them into a history of the most recent
+     * @a `HISTORY_SIZE` snapshots, which serve as baselines.
+     *
+     * @a `Encode` splits a snapshot into chunks no larger than the spec's
+     * chunk size, each covering a contiguous range of entities, so that every
+     * chunk fits in one unreliable datagram and can be decoded on its own.
+     * Within a chunk, each entity unchanged since the baseline costs one bit.
+     * A changed entity encodes each position axis as a small delta where it
+     * can, and its rotation only if it has changed. A client with no usable
+     * baseline is sent the snapshot in full.
+     *
+     * A replicator is not thread-safe. It is intended to be owned and updated
+     * by the game thread.
+     */
+    class ACE_API SnapshotReplicator final
+    {
+    public:
+
+        /**
+         * @brief   The number of recent snapshots kept as potential baselines.
+         *          A client whose latest acknowledged snapshot is older than
+         *          this is sent full snapshots until it acknowledges another.
+         */
+        static constexpr std::size_t HISTORY_SIZE = 64;
+
+        /**
+         * @brief   A handle to a client tracked by the replicator.
+         */
+        using ClientId = std::uint32_t;
+
+    public:
+
+        /**
+         * @brief   Constructs a replicator with the given settings. Every
+         *          entity starts inactive.
+         *
+         * @param   pSpec   The replicator's settings.
+         *
+         * @throw   `std::invalid_argument` if the settings are invalid.
+         */
+        explicit SnapshotReplicator (
+            const SnapshotSpec& pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Activates an entity, or updates an active entity's state.
+         *
+         * @param   pIndex      The entity's slot.
+         * @param   pPosition   The entity's position.
+         * @param   pRotation   The entity's rotation.
+         */
+        void SetEntity (
+            const std::size_t&  pIndex,
+            const Vector3f&     pPosition,
+            const Quaternion4f& pRotation
+        );
+
+        /**
+         * @brief   Deactivates an entity.
+         *
+         * @param   pIndex  The entity's slot.
+         */
+        void RemoveEntity (
+            const std::size_t&  pIndex
+        );
+
+        /**
+         * @brief   Captures the entities' current states into a new snapshot.
+         *
+         * @return  The new snapshot's sequence number.
+         */
+        std::uint16_t Capture ();
+
+        /**
+         * @brief   Starts tracking a new client, which has no baseline.
+         *
+         * @return  The new client's handle.
+         */
+        ClientId AddClient ();
+
+        /**
+         * @brief   Stops tracking a client.
+         *
+         * @param   pClient     The client's handle.
+         */
+        void RemoveClient (
+            const ClientId  pClient
+        );
+
+        /**
+         * @brief   Records that a client has received a whole snapshot, making
+         *          it the client's baseline if it is newer than the current
+         *          one and still in the history.
+         *
+         * @param   pClient     The client's handle.
+         * @param   pSequence   The snapshot's sequence number.
+         */
+        void Acknowledge (
+            const ClientId      pClient,
+            const std::uint16_t pSequence
+        );
+
+        /**
+         * @brief   Encodes the latest snapshot for a client, as a delta
+         *          against its baseline.
+         *
+         * @param   pClient     The client's handle.
+         * @param   pEmit       Called once per chunk, with the chunk's bytes.
+         *
+         * @return  The total number of bytes emitted.
+         */
+        std::size_t Encode (
+            const ClientId                                                  pClient,
+            const std::function<void (std::span<const std::uint8_t>)>&      pEmit
+        );
+
+        /**
+         * @brief   Retrieves the settings shared with the clients.
+         *
+         * @return  The replicator's settings.
+         */
+        inline const SnapshotSpec& GetSpec () const
+        {
+            return mSpec;
+        }
+
+    private:
+
+        /**
+         * @brief   A structure containing one captured snapshot.
+         */
+        struct Snapshot
+        {
+            std::uint16_t                   mSequence = 0;      ///< @brief The snapshot's sequence number.
+            bool                            mValid = false;     ///< @brief Has a snapshot been captured into this slot?
+            std::vector<QuantizedEntity>    mEntities;          ///< @brief The entities' states.
+        };
+
+        /**
+         * @brief   A structure containing one client's replication state.
+         */
+        struct Client
+        {
+            std::uint16_t   mBaseline = 0;          ///< @brief The client's latest acknowledged snapshot.
+            bool            mHasBaseline = false;   ///< @brief Has the client acknowledged any snapshot?
+        };
+
+    private:
+
+        /**
+         * @brief   Finds a snapshot in the history, if it is still there.
+         *
+         * @return  A pointer to the snapshot, or `nullptr` if it is too old.
+         */
+        const Snapshot* FindSnapshot (
+            const std::uint16_t pSequence
+        ) const;
+
+    private:
+        SnapshotSpec                                mSpec;                  ///< @brief The replicator's settings.
+        PositionQuantizer                           mQuantizer;             ///< @brief Quantizes positions.
+        std::size_t                                 mMaxEntityBits = 0;     ///< @brief The most bits a single entity can be encoded in.
+        std::vector<QuantizedEntity>                mCurrent;               ///< @brief The entities' current states.
+        std::vector<QuantizedEntity>                mEmpty;                 ///< @brief An all-inactive baseline, for clients with none.
+        std::array<Snapshot, HISTORY_SIZE>          mHistory;               ///< @brief The most recent snapshots, by sequence number.
+        std::uint16_t                               mLatest = 0;            ///< @brief The latest snapshot's sequence number.
+        bool                                        mHasLatest = false;     ///< @brief Has any snapshot been captured?
+        std::unordered_map<ClientId, Client>        mClients;               ///< @brief The tracked clients.
+        ClientId                                    mNextClient = 1;        ///< @brief The next client handle to be issued.
+        astd::byte_buffer                           mChunk;                 ///< @brief Scratch space for the chunk being encoded.
+
+    };
+
+    /**
+     * @brief   A class which reassembles and decodes the snapshots encoded by a
+     *          @a `SnapshotReplicator`, on the client.
+     *
+     * Chunks may arrive lost, duplicated or out of order. A snapshot becomes
+     * the latest once every one of its chunks has arrived, and is then kept as
+     * a baseline for later deltas. Chunks of snapshots older than the latest,
+     * or encoded against a baseline the receiver does not have, are dropped.
+     *
+     * A receiver is not thread-safe. It is intended to be owned and updated by
+     * the game thread.
+     */
+    class ACE_API SnapshotReceiver final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a receiver with the given settings, which must
+         *          match the replicator's.
+         *
+         * @param   pSpec   The receiver's settings.
+         *
+         * @throw   `std::invalid_argument` if the settings are invalid.
+         */
+        explicit SnapshotReceiver (
+            const SnapshotSpec& pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Decodes one chunk of a snapshot.
+         *
+         * @param   pChunk  The chunk's bytes.
+         *
+         * @return  `true` if the chunk completed a snapshot, which is now the
+         *          latest; `false` otherwise.
+         */
+        bool Receive (
+            std::span<const std::uint8_t>   pChunk
+        );
+
+        /**
+         * @brief   Retrieves the sequence number of a snapshot completed since
+         *          the last call, to be acknowledged to the server.
+         *
+         * @return  An `std::optional` which contains the latest snapshot's
+         *          sequence number, if it has not been taken yet.
+         */
+        std::optional<std::uint16_t> TakeAcknowledgement ();
+
+        /**
+         * @brief   Retrieves the sequence number of the latest whole snapshot.
+         *
+         * @return  An `std::optional` which contains the sequence number, if
+         *          any snapshot has been completed.
+         */
+        std::optional<std::uint16_t> GetLatestSequence () const;
+
+        /**
+         * @brief   Retrieves the entities' quantized states, as of the latest
+         *          whole snapshot.
+         *
+         * @return  The entities' states, or an empty span if no snapshot has
+         *          been completed.
+         */
+        std::span<const QuantizedEntity> GetEntities () const;
+
+        /**
+         * @brief   Restores an entity's position and rotation from the latest
+         *          whole snapshot.
+         *
+         * @param   pIndex      The entity's slot.
+         * @param   pPosition   Receives the entity's position.
+         * @param   pRotation   Receives the entity's rotation.
+         *
+         * @return  `true` if the entity is active; `false` otherwise.
+         */
+        bool GetEntity (
+            const std::size_t&  pIndex,
+            Vector3f&           pPosition,
+            Quaternion4f&       pRotation
+        ) const;
+
+    private:
+
+        /**
+         * @brief   A structure containing one snapshot, whole or being
+         *          reassembled.
+         */
+        struct Snapshot
+        {
+            std::uint16_t                   mSequence = 0;          ///< @brief The snapshot's sequence number.
+            bool                            mInUse = false;         ///< @brief Is a snapshot being reassembled in, or held in, this slot?
+            bool                            mComplete = false;      ///< @brief Have all of the snapshot's chunks arrived?
+            std::size_t                     mCovered = 0;           ///< @brief The number of entities decoded so far.
+            std::vector<bool>               mDecoded;               ///< @brief Marks the entities decoded so far, to skip duplicate chunks.
+            std::vector<QuantizedEntity>    mEntities;              ///< @brief The entities' states.
+        };
+
+    private:
+        SnapshotSpec                                                    mSpec;                  ///< @brief The receiver's settings.
+        PositionQuantizer                                               mQuantizer;             ///< @brief Restores positions.
+        std::vector<QuantizedEntity>                                    mEmpty;                 ///< @brief The all-inactive baseline of full snapshots.
+        std::array<Snapshot, SnapshotReplicator::HISTORY_SIZE>          mHistory;               ///< @brief The most recent snapshots, by sequence number.
+        std::uint16_t                                                   mLatest = 0;            ///< @brief The latest whole snapshot's sequence number.
+        bool                                                            mHasLatest = false;     ///< @brief Has any snapshot been completed?
+        bool                                                            mAckPending = false;    ///< @brief Has the latest snapshot not been taken for acknowledgement yet?
+
+    };
+
+}
@@ -0,0 +1,278 @@
+/**
+ * @file    Ace/Networking/UdpTransport.cpp
+ */
+
+#if defined(ACE_LINUX)
+    #include <arpa/inet.h>
+    #include <netinet/in.h>
+    #include <sys/epoll.h>
+    #include <sys/eventfd.h>
+    #include <sys/socket.h>
+    #include <unistd.h>
+    #include <cerrno>
+#endif
+
+#include <Ace/Networking/UdpTransport.hpp>
+
+namespace ace
+{
+
+    /* `UdpTransportContext` Structure ****************************************/
+
+    struct UdpTransportContext
+    {
+    #if defined(ACE_LINUX)
+        std::int32_t mSocket = -1;
+        std::int32_t mEpoll = -1;
+        std::int32_t mWakeEvent = -1;
+        std::array<mmsghdr, UdpTransport::BATCH_SIZE> mMessages {};
+        std::array<iovec, UdpTransport::BATCH_SIZE> mVectors {};
+        std::array<sockaddr_in, UdpTransport::BATCH_SIZE> mAddresses {};
+
+        ~UdpTransportContext ()
+        {
+            if (mWakeEvent >= 0) { ::close(mWakeEvent); }
+            if (mEpoll >= 0) { ::close(mEpoll); }
+            if (mSocket >= 0) { ::close(mSocket); }
+        }
+
+        /**
+         * @brief   Points the batch's message headers at the given packets.
+         */
+        void Prepare (
+            std::span<Packet* const>    pPackets,
+            const bool                  pReceiving
+        )
+        {
+            for (std::size_t i = 0; i < pPackets.size(); ++i)
+            {
+                Packet* lPacket = pPackets[i];
+                mVectors[i].iov_base = lPacket->mData.data();
+                mVectors[i].iov_len = pReceiving ? MAX_PACKET_SIZE : lPacket->mSize;
+
+                if (pReceiving == false)
+                {
+                    mAddresses[i] = {};
+                    mAddresses[i].sin_family = AF_INET;
+                    mAddresses[i].sin_addr.s_addr = htonl(lPacket->mAddress.mHost);
+                    mAddresses[i].sin_port = htons(lPacket->mAddress.mPort);
+                }
+
+                mMessages[i] = {};
+                mMessages[i].msg_hdr.msg_name = &mAddresses[i];
+                mMessages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+                mMessages[i].msg_hdr.msg_iov = &mVectors[i];
+                mMessages[i].msg_hdr.msg_iovlen = 1;
+            }
+        }
+    #endif
+    };
+
+    /* Constructors and Destructor ********************************************/
+
+    UdpTransport::UdpTransport (
+        const NetworkAddress&   pAddress
+    ) :
+        mContext    { std::make_shared<UdpTransportContext>() }
+    {
+        #if defined(ACE_LINUX)
+        {
+            auto& lContext = *mContext;
+
+            lContext.mSocket = ::socket(AF_INET, SOCK_DGRAM | SOCK_NONBLOCK, 0);
+            if (lContext.mSocket < 0)
+            {
+                ACE_THROW(std::runtime_error, "{}: Could not open a socket!",
+                    "UdpTransport");
+            }
+
+            // Give bursts of datagrams some room to queue up between batches.
+            std::int32_t lBufferSize = 1 << 20;
+            ::setsockopt(lContext.mSocket, SOL_SOCKET, SO_RCVBUF,
+                &lBufferSize, sizeof(lBufferSize));
+            ::setsockopt(lContext.mSocket, SOL_SOCKET, SO_SNDBUF,
+                &lBufferSize, sizeof(lBufferSize));
+
+            sockaddr_in lAddress {};
+            lAddress.sin_family = AF_INET;
+            lAddress.sin_addr.s_addr = htonl(pAddress.mHost);
+            lAddress.sin_port = htons(pAddress.mPort);
+            if (
+                ::bind(lContext.mSocket,
+                    reinterpret_cast<const sockaddr*>(&lAddress),
+                    sizeof(lAddress)) < 0
+            )
+            {
+                ACE_THROW(std::runtime_error, "{}: Could not bind to '{}'!",
+                    "UdpTransport", pAddress.ToString());
+            }
+
+            // Find out which port was actually bound, in case any was asked
+            // for.
+            socklen_t lLength = sizeof(lAddress);
+            ::getsockname(lContext.mSocket,
+                reinterpret_cast<sockaddr*>(&lAddress), &lLength);
+            mLocalAddress.mHost = ntohl(lAddress.sin_addr.s_addr);
+            mLocalAddress.mPort = ntohs(lAddress.sin_port);
+
+            lContext.mWakeEvent = ::eventfd(0, EFD_NONBLOCK);
+            lContext.mEpoll = ::epoll_create1(0);
+            if (lContext.mWakeEvent < 0 || lContext.mEpoll < 0)
+            {
+                ACE_THROW(std::runtime_error, "{}: Could not create an event loop!",
+                    "UdpTransport");
+            }
+
+            epoll_event lEvent {};
+            lEvent.events = EPOLLIN;
+            lEvent.data.fd = lContext.mSocket;
+            ::epoll_ctl(lContext.mEpoll, EPOLL_CTL_ADD, lContext.mSocket, &lEvent);
+            lEvent.data.fd = lContext.mWakeEvent;
+            ::epoll_ctl(lContext.mEpoll, EPOLL_CTL_ADD, lContext.mWakeEvent, &lEvent);
+        }
+        #else
+        {
+            ACE_THROW(std::runtime_error, "{}: Not supported on this platform!",
+                "UdpTransport");
+        }
+        #endif
+    }
+
+    UdpTransport::~UdpTransport ()
+    {
+
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::size_t UdpTransport::Send (
+        std::span<Packet* const>    pPackets
+    )
+    {
+        std::size_t lSent = 0;
+
+        #if defined(ACE_LINUX)
+        {
+            auto& lContext = *mContext;
+            while (lSent < pPackets.size())
+            {
+                const std::size_t lCount =
+                    std::min(pPackets.size() - lSent, BATCH_SIZE);
+                lContext.Prepare(pPackets.subspan(lSent, lCount), false);
+
+                std::int32_t lResult = ::sendmmsg(lContext.mSocket,
+                    lContext.mMessages.data(), lCount, 0);
+                if (lResult < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (lResult <= 0)
+                {
+                    // The send buffer is full, or the datagram was refused.
+                    // Either way, UDP is free to drop the rest.
+                    break;
+                }
+
+                lSent += lResult;
+                if (static_cast<std::size_t>(lResult) < lCount)
+                {
+                    break;
+                }
+            }
+        }
+        #endif
+
+        return lSent;
+    }
+
+    std::size_t UdpTransport::Receive (
+        std::span<Packet*>  pPackets
+    )
+    {
+        std::size_t lReceived = 0;
+
+        #if defined(ACE_LINUX)
+        {
+            auto& lContext = *mContext;
+            while (lReceived < pPackets.size())
+            {
+                const std::size_t lCount =
+                    std::min(pPackets.size() - lReceived, BATCH_SIZE);
+                auto lBatch = pPackets.subspan(lReceived, lCount);
+                lContext.Prepare(lBatch, true);
+
+                std::int32_t lResult = ::recvmmsg(lContext.mSocket,
+                    lContext.mMessages.data(), lCount, MSG_DONTWAIT, nullptr);
+                if (lResult < 0 && errno == EINTR)
+                {
+                    continue;
+                }
+                else if (lResult <= 0)
+                {
+                    break;
+                }
+
+                for (std::int32_t i = 0; i < lResult; ++i)
+                {
+                    lBatch[i]->mSize = lContext.mMessages[i].msg_len;
+                    lBatch[i]->mAddress.mHost =
+                        ntohl(lContext.mAddresses[i].sin_addr.s_addr);
+                    lBatch[i]->mAddress.mPort =
+                        ntohs(lContext.mAddresses[i].sin_port);
+                }
+
+                lReceived += lResult;
+                if (static_cast<std::size_t>(lResult) < lCount)
+                {
+                    break;
+                }
+            }
+        }
+        #endif
+
+        return lReceived;
+    }
+
+    void UdpTransport::Wait (
+        const std::chrono::nanoseconds& pTimeout
+    )
+    {
+        #if defined(ACE_LINUX)
+        {
+            auto& lContext = *mContext;
+
+            // `epoll_wait` counts in milliseconds; round up, so that a short
+            // timeout does not turn into a busy loop.
+            const auto lTimeout = std::chrono::ceil<std::chrono::milliseconds>(
+                std::max(pTimeout, std::chrono::nanoseconds::zero()));
+
+            std::array<epoll_event, 2> lEvents {};
+            std::int32_t lCount = ::epoll_wait(lContext.mEpoll, lEvents.data(),
+                lEvents.size(), static_cast<std::int32_t>(lTimeout.count()));
+            for (std::int32_t i = 0; i < lCount; ++i)
+            {
+                if (lEvents[i].data.fd == lContext.mWakeEvent)
+                {
+                    std::uint64_t lValue = 0;
+                    (void) ::read(lContext.mWakeEvent, &lValue, sizeof(lValue));
+                }
+            }
+        }
+        #else
+        {
+            std::this_thread::sleep_for(pTimeout);
+        }
+        #endif
+    }
+
+    void UdpTransport::Wake ()
+    {
+        #if defined(ACE_LINUX)
+        {
+            const std::uint64_t lValue = 1;
+            (void) ::write(mContext->mWakeEvent, &lValue, sizeof(lValue));
+        }
+        #endif
+    }
+
+}
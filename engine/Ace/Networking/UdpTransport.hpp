@@ -0,0 +1,84 @@
+/**
+ * @file    Ace/Networking/UdpTransport.hpp
+ * @brief   Provides a datagram transport over a UDP socket.
+ */
+
+#pragma once
+#include <Ace/Networking/INetworkTransport.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Forward-declaration of a structure containing the
+     *          @a `UdpTransport`'s platform-specific components.
+     */
+    struct UdpTransportContext;
+
+    /**
+     * @brief   A datagram transport over a non-blocking UDP socket.
+     *
+     * On Linux, batches are moved with one `sendmmsg` or `recvmmsg` call per
+     * @a `BATCH_SIZE` datagrams, rather than one system call per datagram, and
+     * @a `Wait` blocks in `epoll_wait` on the socket and an `eventfd` which
+     * @a `Wake` signals.
+     */
+    class ACE_API UdpTransport final : public INetworkTransport
+    {
+    public:
+
+        /**
+         * @brief   The largest number of datagrams moved per system call.
+         */
+        static constexpr std::size_t BATCH_SIZE = 64;
+
+    public:
+
+        /**
+         * @brief   Opens a UDP socket bound to the given address.
+         *
+         * @param   pAddress    The address to bind to. A port of zero binds to
+         *                      any free port.
+         *
+         * @throw   `std::runtime_error` if the socket could not be opened or
+         *          bound.
+         */
+        explicit UdpTransport (
+            const NetworkAddress&   pAddress
+        );
+
+        /**
+         * @brief   The destructor closes the socket.
+         */
+        ~UdpTransport () override;
+
+    public:
+        std::size_t Send (std::span<Packet* const> pPackets) override;
+        std::size_t Receive (std::span<Packet*> pPackets) override;
+        void Wait (const std::chrono::nanoseconds& pTimeout) override;
+        void Wake () override;
+
+        inline NetworkAddress GetLocalAddress () const override
+        {
+            return mLocalAddress;
+        }
+
+    private:
+        UdpTransport (const UdpTransport&) = delete;
+        UdpTransport (UdpTransport&&) = delete;
+        void operator= (const UdpTransport&) = delete;
+        void operator= (UdpTransport&&) = delete;
+
+    private:
+        NetworkAddress  mLocalAddress;  ///< @brief The address the socket is bound to.
+
+        /**
+         * @brief   Contains the transport's platform-specific components.
+         */
+        std::shared_ptr<
+            UdpTransportContext
+        > mContext = nullptr;
+
+    };
+
+}
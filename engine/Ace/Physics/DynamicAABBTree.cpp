@@ -0,0 +1,507 @@
+/**
+ * @file    Ace/Physics/DynamicAABBTree.cpp
+ */
+
+#include <Ace/Physics/DynamicAABBTree.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    DynamicAABBTree::DynamicAABBTree (
+        const BroadphaseSpec&   pSpec
+    ) :
+        mThreadPool         { pSpec.mThreadPool },
+        mGrainSize          { std::max<std::size_t>(pSpec.mGrainSize, 1) },
+        mMargin             { pSpec.mMargin },
+        mDisplacementScale  { pSpec.mDisplacementScale }
+    {}
+
+    /* Public Methods *********************************************************/
+
+    ProxyId DynamicAABBTree::CreateProxy (
+        const AABB3f&       pBounds,
+        const std::uint64_t pUserData
+    )
+    {
+        const std::int32_t lLeaf = AllocateNode();
+        mNodes[lLeaf].mBounds = pBounds.Expanded(mMargin);
+        mNodes[lLeaf].mUserData = pUserData;
+        mNodes[lLeaf].mHeight = 0;
+        InsertLeaf(lLeaf);
+        MarkMoved(lLeaf);
+        ++mLeafCount;
+        return static_cast<ProxyId>(lLeaf);
+    }
+
+    void DynamicAABBTree::DestroyProxy (
+        const ProxyId   pProxy
+    )
+    {
+        if (pProxy >= mNodes.size() || mNodes[pProxy].mHeight != 0)
+        {
+            return;
+        }
+
+        RemoveLeaf(static_cast<std::int32_t>(pProxy));
+        FreeNode(static_cast<std::int32_t>(pProxy));
+        --mLeafCount;
+    }
+
+    void DynamicAABBTree::MoveProxy (
+        const ProxyId       pProxy,
+        const AABB3f&       pBounds,
+        const Vector3f&     pDisplacement
+    )
+    {
+        // Fatten the new box, and stretch it ahead of the body.
+        AABB3f lFat = pBounds.Expanded(mMargin);
+        const Vector3f lAhead = pDisplacement * mDisplacementScale;
+        (lAhead.mX < 0.0f ? lFat.mMin.mX : lFat.mMax.mX) += lAhead.mX;
+        (lAhead.mY < 0.0f ? lFat.mMin.mY : lFat.mMax.mY) += lAhead.mY;
+        (lAhead.mZ < 0.0f ? lFat.mMin.mZ : lFat.mMax.mZ) += lAhead.mZ;
+
+        // Keep the leaf where it is while the body stays inside it, unless it
+        // has grown so much larger than the new one that it would report
+        // pairs the body is nowhere near. The stored box may trail the body by
+        // as far as the new one reaches ahead of it.
+        AABB3f lLargest = lFat.Expanded(4.0f * mMargin);
+        (lAhead.mX < 0.0f ? lLargest.mMax.mX : lLargest.mMin.mX) -= lAhead.mX;
+        (lAhead.mY < 0.0f ? lLargest.mMax.mY : lLargest.mMin.mY) -= lAhead.mY;
+        (lAhead.mZ < 0.0f ? lLargest.mMax.mZ : lLargest.mMin.mZ) -= lAhead.mZ;
+
+        const std::int32_t lLeaf = static_cast<std::int32_t>(pProxy);
+        const AABB3f& lStored = mNodes[lLeaf].mBounds;
+        if (lStored.Contains(pBounds) == true && lLargest.Contains(lStored) == true)
+        {
+            return;
+        }
+
+        RemoveLeaf(lLeaf);
+        mNodes[lLeaf].mBounds = lFat;
+        InsertLeaf(lLeaf);
+        MarkMoved(lLeaf);
+        ++mReinsertCount;
+    }
+
+    void DynamicAABBTree::FindPairs (
+        std::vector<ProxyPair>& pPairs
+    )
+    {
+        pPairs.clear();
+
+        // Drop the pairs carried over from the last call which involve a leaf
+        // which has since moved or been destroyed. A destroyed leaf's node is
+        // either unused now, an inner node, or a new, moved leaf.
+        std::erase_if(mPairs,
+            [this] (const ProxyPair& pPair) -> bool
+            {
+                const Node& lFirst = mNodes[pPair.mFirst];
+                const Node& lSecond = mNodes[pPair.mSecond];
+                return
+                    lFirst.mHeight != 0 || lFirst.mMoved == true ||
+                    lSecond.mHeight != 0 || lSecond.mMoved == true;
+            });
+
+        // The move buffer may hold leaves destroyed since, or the same node
+        // twice if it was destroyed and reused. Sorting it also keeps the new
+        // pairs in the same order however the batches are spread across the
+        // threads.
+        std::erase_if(mMoveBuffer,
+            [this] (std::int32_t pLeaf) -> bool
+            {
+                return mNodes[pLeaf].mHeight != 0 || mNodes[pLeaf].mMoved == false;
+            });
+        std::sort(mMoveBuffer.begin(), mMoveBuffer.end());
+        mMoveBuffer.erase(std::unique(mMoveBuffer.begin(), mMoveBuffer.end()), mMoveBuffer.end());
+
+        const std::size_t lCount = mMoveBuffer.size();
+        const std::size_t lBatchCount = (lCount + mGrainSize - 1) / mGrainSize;
+        mBatchPairs.resize(lBatchCount);
+
+        auto lQueryBatch =
+            [this, lCount] (std::size_t pBatch) -> void
+            {
+                std::vector<ProxyPair>& lPairs = mBatchPairs[pBatch];
+                std::vector<std::int32_t> lStack;
+                lPairs.clear();
+
+                const std::size_t lEnd = std::min(lCount, (pBatch + 1) * mGrainSize);
+                for (std::size_t i = pBatch * mGrainSize; i < lEnd; ++i)
+                {
+                    // A pair of two moved leaves is found from both of them;
+                    // only the lower handle's query reports it.
+                    const std::int32_t lLeaf = mMoveBuffer[i];
+                    Traverse(mNodes[lLeaf].mBounds, lStack,
+                        [&] (std::int32_t pOther) -> void
+                        {
+                            if (
+                                pOther != lLeaf &&
+                                (mNodes[pOther].mMoved == false || pOther > lLeaf)
+                            )
+                            {
+                                lPairs.push_back({
+                                    static_cast<ProxyId>(std::min(lLeaf, pOther)),
+                                    static_cast<ProxyId>(std::max(lLeaf, pOther))
+                                });
+                            }
+                        });
+                }
+            };
+
+        if (mThreadPool != nullptr && lBatchCount > 1)
+        {
+            mThreadPool->ParallelFor(lBatchCount, lQueryBatch);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < lBatchCount; ++i)
+            {
+                lQueryBatch(i);
+            }
+        }
+
+        mNewPairs.clear();
+        for (std::size_t i = 0; i < lBatchCount; ++i)
+        {
+            mNewPairs.insert(mNewPairs.end(), mBatchPairs[i].begin(), mBatchPairs[i].end());
+        }
+
+        std::sort(mNewPairs.begin(), mNewPairs.end());
+        pPairs.reserve(mPairs.size() + mNewPairs.size());
+        std::merge(mPairs.begin(), mPairs.end(), mNewPairs.begin(), mNewPairs.end(),
+            std::back_inserter(pPairs));
+        mPairs = pPairs;
+
+        for (const std::int32_t lLeaf : mMoveBuffer)
+        {
+            mNodes[lLeaf].mMoved = false;
+        }
+
+        mMoveBuffer.clear();
+    }
+
+    void DynamicAABBTree::Query (
+        const AABB3f&           pBounds,
+        std::vector<ProxyId>&   pProxies
+    ) const
+    {
+        std::vector<std::int32_t> lStack;
+        Traverse(pBounds, lStack,
+            [&] (std::int32_t pLeaf) -> void
+            {
+                pProxies.push_back(static_cast<ProxyId>(pLeaf));
+            });
+    }
+
+    std::uint64_t DynamicAABBTree::GetUserData (
+        const ProxyId   pProxy
+    ) const
+    {
+        return mNodes[pProxy].mUserData;
+    }
+
+    std::size_t DynamicAABBTree::GetProxyCount () const
+    {
+        return mLeafCount;
+    }
+
+    const AABB3f& DynamicAABBTree::GetFatBounds (
+        const ProxyId   pProxy
+    ) const
+    {
+        return mNodes[pProxy].mBounds;
+    }
+
+    std::size_t DynamicAABBTree::GetHeight () const
+    {
+        return (mRoot == NULL_NODE) ? 0 : static_cast<std::size_t>(mNodes[mRoot].mHeight);
+    }
+
+    /* Private Methods ********************************************************/
+
+    std::int32_t DynamicAABBTree::AllocateNode ()
+    {
+        std::int32_t lNode = mFreeNode;
+        if (lNode == NULL_NODE)
+        {
+            lNode = static_cast<std::int32_t>(mNodes.size());
+            mNodes.emplace_back();
+        }
+        else
+        {
+            mFreeNode = mNodes[lNode].mParent;
+        }
+
+        mNodes[lNode] = Node {};
+        return lNode;
+    }
+
+    void DynamicAABBTree::FreeNode (
+        const std::int32_t  pNode
+    )
+    {
+        mNodes[pNode].mParent = mFreeNode;
+        mNodes[pNode].mChild1 = NULL_NODE;
+        mNodes[pNode].mChild2 = NULL_NODE;
+        mNodes[pNode].mHeight = -1;
+        mFreeNode = pNode;
+    }
+
+    void DynamicAABBTree::MarkMoved (
+        const std::int32_t  pLeaf
+    )
+    {
+        if (mNodes[pLeaf].mMoved == false)
+        {
+            mNodes[pLeaf].mMoved = true;
+            mMoveBuffer.push_back(pLeaf);
+        }
+    }
+
+    void DynamicAABBTree::InsertLeaf (
+        const std::int32_t  pLeaf
+    )
+    {
+        if (mRoot == NULL_NODE)
+        {
+            mRoot = pLeaf;
+            mNodes[pLeaf].mParent = NULL_NODE;
+            return;
+        }
+
+        // Search for the cheapest sibling. Pairing the leaf with a node costs
+        // the area of their union, plus however much every ancestor of the
+        // node grows to enclose the leaf. Below a node, the cost can be no
+        // less than the leaf's own area plus what the node and its ancestors
+        // grow by, so subtrees which cannot beat the best sibling so far are
+        // skipped.
+        const AABB3f lBounds = mNodes[pLeaf].mBounds;
+        const float lLeafArea = lBounds.SurfaceArea();
+        std::int32_t lSibling = mRoot;
+        float lBestCost = Union(mNodes[mRoot].mBounds, lBounds).SurfaceArea();
+
+        mSearchStack.clear();
+        mSearchStack.push_back({ mRoot, 0.0f });
+        while (mSearchStack.empty() == false)
+        {
+            const auto [lIndex, lInheritedCost] = mSearchStack.back();
+            mSearchStack.pop_back();
+
+            const Node& lNode = mNodes[lIndex];
+            const float lUnionArea = Union(lNode.mBounds, lBounds).SurfaceArea();
+            const float lCost = lUnionArea + lInheritedCost;
+            if (lCost < lBestCost)
+            {
+                lSibling = lIndex;
+                lBestCost = lCost;
+            }
+
+            const float lChildInheritedCost = lInheritedCost + lUnionArea - lNode.mBounds.SurfaceArea();
+            if (lNode.IsLeaf() == false && lLeafArea + lChildInheritedCost < lBestCost)
+            {
+                // Visit the child nearer the leaf first, so that good
+                // siblings are found early and prune more.
+                const float lGrowth1 = Union(mNodes[lNode.mChild1].mBounds, lBounds).SurfaceArea() -
+                    mNodes[lNode.mChild1].mBounds.SurfaceArea();
+                const float lGrowth2 = Union(mNodes[lNode.mChild2].mBounds, lBounds).SurfaceArea() -
+                    mNodes[lNode.mChild2].mBounds.SurfaceArea();
+                const bool lFirstNearer = lGrowth1 <= lGrowth2;
+                mSearchStack.push_back({ lFirstNearer ? lNode.mChild2 : lNode.mChild1, lChildInheritedCost });
+                mSearchStack.push_back({ lFirstNearer ? lNode.mChild1 : lNode.mChild2, lChildInheritedCost });
+            }
+        }
+
+        // Give the leaf and its sibling a new parent, in the sibling's place.
+        const std::int32_t lOldParent = mNodes[lSibling].mParent;
+        const std::int32_t lNewParent = AllocateNode();
+        Node& lParent = mNodes[lNewParent];
+        lParent.mParent = lOldParent;
+        lParent.mBounds = Union(lBounds, mNodes[lSibling].mBounds);
+        lParent.mHeight = mNodes[lSibling].mHeight + 1;
+        lParent.mChild1 = lSibling;
+        lParent.mChild2 = pLeaf;
+        mNodes[lSibling].mParent = lNewParent;
+        mNodes[pLeaf].mParent = lNewParent;
+
+        if (lOldParent == NULL_NODE)
+        {
+            mRoot = lNewParent;
+        }
+        else if (mNodes[lOldParent].mChild1 == lSibling)
+        {
+            mNodes[lOldParent].mChild1 = lNewParent;
+        }
+        else
+        {
+            mNodes[lOldParent].mChild2 = lNewParent;
+        }
+
+        Refit(mNodes[pLeaf].mParent);
+    }
+
+    void DynamicAABBTree::RemoveLeaf (
+        const std::int32_t  pLeaf
+    )
+    {
+        if (pLeaf == mRoot)
+        {
+            mRoot = NULL_NODE;
+            return;
+        }
+
+        const std::int32_t lParent = mNodes[pLeaf].mParent;
+        const std::int32_t lGrandparent = mNodes[lParent].mParent;
+        const std::int32_t lSibling = (mNodes[lParent].mChild1 == pLeaf) ?
+            mNodes[lParent].mChild2 : mNodes[lParent].mChild1;
+
+        // Put the sibling in the parent's place, and drop the parent.
+        mNodes[lSibling].mParent = lGrandparent;
+        if (lGrandparent == NULL_NODE)
+        {
+            mRoot = lSibling;
+        }
+        else if (mNodes[lGrandparent].mChild1 == lParent)
+        {
+            mNodes[lGrandparent].mChild1 = lSibling;
+        }
+        else
+        {
+            mNodes[lGrandparent].mChild2 = lSibling;
+        }
+
+        FreeNode(lParent);
+        mNodes[pLeaf].mParent = NULL_NODE;
+        Refit(lGrandparent);
+    }
+
+    void DynamicAABBTree::Refit (
+        std::int32_t    pNode
+    )
+    {
+        while (pNode != NULL_NODE)
+        {
+            pNode = Balance(pNode);
+
+            Node& lNode = mNodes[pNode];
+            const Node& lChild1 = mNodes[lNode.mChild1];
+            const Node& lChild2 = mNodes[lNode.mChild2];
+            lNode.mHeight = 1 + std::max(lChild1.mHeight, lChild2.mHeight);
+            lNode.mBounds = Union(lChild1.mBounds, lChild2.mBounds);
+
+            pNode = lNode.mParent;
+        }
+    }
+
+    std::int32_t DynamicAABBTree::Balance (
+        const std::int32_t  pNode
+    )
+    {
+        Node& lA = mNodes[pNode];
+        if (lA.IsLeaf() == true || lA.mHeight < 2)
+        {
+            return pNode;
+        }
+
+        const std::int32_t lIndexB = lA.mChild1;
+        const std::int32_t lIndexC = lA.mChild2;
+        Node& lB = mNodes[lIndexB];
+        Node& lC = mNodes[lIndexC];
+        const std::int32_t lBalance = lC.mHeight - lB.mHeight;
+        if (lBalance >= -1 && lBalance <= 1)
+        {
+            return pNode;
+        }
+
+        // Rotate the taller child up into this node's place. This node keeps
+        // the shorter child, and takes the shorter of the taller child's own
+        // children; the taller child keeps the taller of them.
+        const std::int32_t lIndexUp = (lBalance > 1) ? lIndexC : lIndexB;
+        const std::int32_t lIndexKept = (lBalance > 1) ? lIndexB : lIndexC;
+        Node& lUp = mNodes[lIndexUp];
+        Node& lKept = mNodes[lIndexKept];
+        const std::int32_t lIndexF = lUp.mChild1;
+        const std::int32_t lIndexG = lUp.mChild2;
+        Node& lF = mNodes[lIndexF];
+        Node& lG = mNodes[lIndexG];
+
+        lUp.mChild1 = pNode;
+        lUp.mParent = lA.mParent;
+        lA.mParent = lIndexUp;
+        if (lUp.mParent == NULL_NODE)
+        {
+            mRoot = lIndexUp;
+        }
+        else if (mNodes[lUp.mParent].mChild1 == pNode)
+        {
+            mNodes[lUp.mParent].mChild1 = lIndexUp;
+        }
+        else
+        {
+            mNodes[lUp.mParent].mChild2 = lIndexUp;
+        }
+
+        const bool lKeepF = lF.mHeight > lG.mHeight;
+        const std::int32_t lIndexStays = lKeepF ? lIndexF : lIndexG;
+        const std::int32_t lIndexMoves = lKeepF ? lIndexG : lIndexF;
+        Node& lStays = mNodes[lIndexStays];
+        Node& lMoves = mNodes[lIndexMoves];
+
+        lUp.mChild2 = lIndexStays;
+        if (lBalance > 1)
+        {
+            lA.mChild2 = lIndexMoves;
+        }
+        else
+        {
+            lA.mChild1 = lIndexMoves;
+        }
+
+        lMoves.mParent = pNode;
+        lA.mBounds = Union(lKept.mBounds, lMoves.mBounds);
+        lA.mHeight = 1 + std::max(lKept.mHeight, lMoves.mHeight);
+        lUp.mBounds = Union(lA.mBounds, lStays.mBounds);
+        lUp.mHeight = 1 + std::max(lA.mHeight, lStays.mHeight);
+
+        return lIndexUp;
+    }
+
+    template <typename Fn>
+    void DynamicAABBTree::Traverse (
+        const AABB3f&               pBounds,
+        std::vector<std::int32_t>&  pStack,
+        Fn&&                        pFunction
+    ) const
+    {
+        if (mRoot == NULL_NODE)
+        {
+            return;
+        }
+
+        pStack.clear();
+        pStack.push_back(mRoot);
+        while (pStack.empty() == false)
+        {
+            const std::int32_t lIndex = pStack.back();
+            pStack.pop_back();
+
+            const Node& lNode = mNodes[lIndex];
+            if (lNode.mBounds.Intersects(pBounds) == false)
+            {
+                continue;
+            }
+
+            if (lNode.IsLeaf() == true)
+            {
+                pFunction(lIndex);
+            }
+            else
+            {
+                pStack.push_back(lNode.mChild2);
+                pStack.push_back(lNode.mChild1);
+            }
+        }
+    }
+
+}
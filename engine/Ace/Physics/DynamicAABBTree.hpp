@@ -0,0 +1,226 @@
+/**
+ * @file    Ace/Physics/DynamicAABBTree.hpp
+ * @brief   Provides a broadphase which keeps fattened boxes in a balanced
+ *          bounding volume hierarchy.
+ */
+
+#pragma once
+#include <Ace/Physics/IBroadphase.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A broadphase which keeps its proxies' boxes as the leaves of a
+     *          binary tree, each inner node's box enclosing its children's.
+     *
+     * Each leaf holds a fattened box: its body's box grown by a margin on
+     * every side, and stretched ahead of the body by a multiple of its last
+     * displacement. While a body stays within its fattened box,
+     * @a `MoveProxy` leaves the tree alone; only once it strays out, or its
+     * fattened box has grown far larger than it needs to be, is its leaf
+     * removed and inserted afresh. Slow or resting bodies therefore cost
+     * next to nothing to update.
+     *
+     * Leaves are inserted next to the sibling which grows the tree's total
+     * surface area the least, and the tree is rebalanced by rotations on the
+     * way back up, so that its height stays logarithmic in the number of
+     * leaves.
+     *
+     * Pairs are found between fattened boxes, so some pairs' bodies' boxes
+     * may not quite overlap. Since a leaf which stays put keeps the same
+     * box, the pairs between such leaves carry over from one call to
+     * @a `FindPairs` to the next. Only the leaves inserted since the last
+     * call are queried against the tree, in batches spread across the thread
+     * pool, and their new pairs merged with those carried over.
+     */
+    class ACE_API DynamicAABBTree final : public IBroadphase
+    {
+    public:
+
+        /**
+         * @brief   Creates an empty tree.
+         *
+         * @param   pSpec   The tree's settings. @a `FindPairs` must not be
+         *                  called from one of the thread pool's own workers.
+         */
+        explicit DynamicAABBTree (
+            const BroadphaseSpec&   pSpec = {}
+        );
+
+    public:
+
+        ProxyId CreateProxy (
+            const AABB3f&       pBounds,
+            const std::uint64_t pUserData
+        ) override;
+
+        void DestroyProxy (
+            const ProxyId   pProxy
+        ) override;
+
+        void MoveProxy (
+            const ProxyId       pProxy,
+            const AABB3f&       pBounds,
+            const Vector3f&     pDisplacement
+        ) override;
+
+        void FindPairs (
+            std::vector<ProxyPair>& pPairs
+        ) override;
+
+        void Query (
+            const AABB3f&           pBounds,
+            std::vector<ProxyId>&   pProxies
+        ) const override;
+
+        std::uint64_t GetUserData (
+            const ProxyId   pProxy
+        ) const override;
+
+        std::size_t GetProxyCount () const override;
+
+        /**
+         * @brief   Retrieves a proxy's fattened box.
+         *
+         * @param   pProxy  The proxy's handle.
+         *
+         * @return  The box stored in the proxy's leaf.
+         */
+        const AABB3f& GetFatBounds (
+            const ProxyId   pProxy
+        ) const;
+
+        /**
+         * @brief   Retrieves the height of the tree.
+         *
+         * @return  The number of edges from the root to the deepest leaf, or
+         *          zero if the tree is empty.
+         */
+        std::size_t GetHeight () const;
+
+        /**
+         * @brief   Retrieves the number of leaves which have been removed and
+         *          inserted afresh by @a `MoveProxy`.
+         *
+         * @return  The number of reinsertions since the tree was created.
+         */
+        inline std::size_t GetReinsertCount () const
+        {
+            return mReinsertCount;
+        }
+
+    private:
+
+        /**
+         * @brief   The index which never refers to a node.
+         */
+        static constexpr std::int32_t NULL_NODE = -1;
+
+        /**
+         * @brief   A structure containing one node of the tree: a leaf, an
+         *          inner node, or an unused node on the free list.
+         */
+        struct Node
+        {
+            AABB3f          mBounds;                    ///< @brief The node's box: fattened for a leaf, enclosing its children for an inner node.
+            std::uint64_t   mUserData = 0;              ///< @brief The user data of a leaf's proxy.
+            std::int32_t    mParent = NULL_NODE;        ///< @brief The node's parent, or the next free node if unused.
+            std::int32_t    mChild1 = NULL_NODE;        ///< @brief The node's first child, if an inner node.
+            std::int32_t    mChild2 = NULL_NODE;        ///< @brief The node's second child, if an inner node.
+            std::int32_t    mHeight = -1;               ///< @brief Zero for a leaf, one more than its taller child for an inner node, and -1 if unused.
+            bool            mMoved = false;             ///< @brief Has the leaf been inserted since the last call to @a `FindPairs`?
+
+            inline bool IsLeaf () const
+            {
+                return mChild1 == NULL_NODE;
+            }
+        };
+
+    private:
+
+        /**
+         * @brief   Takes a node from the free list, or adds a new one.
+         */
+        std::int32_t AllocateNode ();
+
+        /**
+         * @brief   Returns a node to the free list.
+         */
+        void FreeNode (
+            const std::int32_t  pNode
+        );
+
+        /**
+         * @brief   Adds a leaf to the move buffer, if it is not there already.
+         */
+        void MarkMoved (
+            const std::int32_t  pLeaf
+        );
+
+        /**
+         * @brief   Inserts a leaf next to its cheapest sibling, then refits
+         *          and rebalances its ancestors.
+         */
+        void InsertLeaf (
+            const std::int32_t  pLeaf
+        );
+
+        /**
+         * @brief   Removes a leaf, replacing its parent with its sibling, then
+         *          refits and rebalances its former ancestors.
+         */
+        void RemoveLeaf (
+            const std::int32_t  pLeaf
+        );
+
+        /**
+         * @brief   Refits and rebalances every node from the given one up to
+         *          the root.
+         */
+        void Refit (
+            std::int32_t    pNode
+        );
+
+        /**
+         * @brief   Rotates a node's taller child up in its place, if its
+         *          children's heights differ by more than one.
+         *
+         * @return  The node now in the given node's place.
+         */
+        std::int32_t Balance (
+            const std::int32_t  pNode
+        );
+
+        /**
+         * @brief   Calls a function with each leaf whose box overlaps the
+         *          given box, using the given list as the traversal stack.
+         */
+        template <typename Fn>
+        void Traverse (
+            const AABB3f&               pBounds,
+            std::vector<std::int32_t>&  pStack,
+            Fn&&                        pFunction
+        ) const;
+
+    private:
+        ThreadPool*                             mThreadPool = nullptr;  ///< @brief The thread pool pairs are found on, if any.
+        std::size_t                             mGrainSize = 0;         ///< @brief The number of leaves queried by each task.
+        float                                   mMargin = 0.0f;         ///< @brief How far a fattened box reaches past its body's box.
+        float                                   mDisplacementScale = 0.0f;  ///< @brief How many of a body's displacements a fattened box reaches ahead.
+
+        std::vector<Node>                       mNodes;                 ///< @brief The pool of nodes, used and unused.
+        std::int32_t                            mRoot = NULL_NODE;      ///< @brief The root node, if the tree is not empty.
+        std::int32_t                            mFreeNode = NULL_NODE;  ///< @brief The first node on the free list.
+        std::size_t                             mLeafCount = 0;         ///< @brief The number of leaves.
+        std::size_t                             mReinsertCount = 0;     ///< @brief The number of reinsertions by @a `MoveProxy`.
+
+        std::vector<std::pair<std::int32_t, float>> mSearchStack;       ///< @brief Scratch space for searching for a new leaf's sibling.
+        std::vector<std::int32_t>               mMoveBuffer;            ///< @brief The leaves inserted since the last call to @a `FindPairs`. May hold leaves destroyed since.
+        std::vector<ProxyPair>                  mPairs;                 ///< @brief The pairs found by the last call to @a `FindPairs`, sorted.
+        std::vector<ProxyPair>                  mNewPairs;              ///< @brief Scratch space for the pairs found for moved leaves.
+        std::vector<std::vector<ProxyPair>>     mBatchPairs;            ///< @brief The pairs found by each batch of the last call to @a `FindPairs`.
+
+    };
+
+}
@@ -0,0 +1,155 @@
+/**
+ * @file    Ace/Physics/IBroadphase.hpp
+ * @brief   Provides an abstract interface for finding the pairs of bodies
+ *          whose bounding boxes overlap.
+ */
+
+#pragma once
+#include <Ace/Maths/AABB3.hpp>
+#include <Ace/System/ThreadPool.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   The handle of a proxy: the bounding box a broadphase keeps for
+     *          one body.
+     */
+    using ProxyId = std::uint32_t;
+
+    /**
+     * @brief   The handle which never refers to a proxy.
+     */
+    constexpr ProxyId INVALID_PROXY = std::numeric_limits<ProxyId>::max();
+
+    /**
+     * @brief   A structure containing a pair of proxies whose bounding boxes
+     *          overlap. The lower handle always comes first, so each pair is
+     *          reported once.
+     */
+    struct ProxyPair
+    {
+        ProxyId     mFirst = INVALID_PROXY;     ///< @brief The lower of the two handles.
+        ProxyId     mSecond = INVALID_PROXY;    ///< @brief The higher of the two handles.
+
+        constexpr auto operator<=> (const ProxyPair&) const = default;
+    };
+
+    /**
+     * @brief   A structure containing the settings a broadphase is created
+     *          with.
+     */
+    struct BroadphaseSpec
+    {
+        ThreadPool*     mThreadPool = nullptr;          ///< @brief The thread pool pairs are found on, or `nullptr` to find them on the calling thread.
+        std::size_t     mGrainSize = 2048;              ///< @brief The number of proxies each task finds the pairs of.
+        float           mMargin = 0.1f;                 ///< @brief How far a fattened box reaches past its body's box, on every side.
+        float           mDisplacementScale = 2.0f;      ///< @brief How many of a moving body's displacements a fattened box reaches ahead of it.
+    };
+
+    /**
+     * @brief   An abstract interface for a broadphase: a structure which keeps
+     *          the bounding boxes of many bodies, and cheaply narrows them
+     *          down to the pairs which may be touching.
+     *
+     * Bodies are added with @a `CreateProxy`, kept up to date with
+     * @a `MoveProxy` as they move, and every overlapping pair is found once
+     * per step with @a `FindPairs`. A broadphase may report pairs whose
+     * bodies' boxes do not quite overlap, if it keeps boxes fattened, but
+     * never misses a pair which does. The pairs are reported in the same
+     * order for the same sequence of calls, however many threads find them.
+     *
+     * A broadphase is not thread-safe. Only @a `FindPairs` and @a `Query`
+     * use more than one thread, and they return once every thread is done.
+     */
+    class ACE_API IBroadphase
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~IBroadphase () = default;
+
+    public:
+
+        /**
+         * @brief   Adds a proxy for a body.
+         *
+         * @param   pBounds     The body's bounding box.
+         * @param   pUserData   A value kept with the proxy, such as the
+         *                      body's index.
+         *
+         * @return  The new proxy's handle.
+         */
+        virtual ProxyId CreateProxy (
+            const AABB3f&       pBounds,
+            const std::uint64_t pUserData
+        ) = 0;
+
+        /**
+         * @brief   Removes a proxy. Its handle may be given to a later proxy.
+         *
+         * @param   pProxy  The proxy's handle.
+         */
+        virtual void DestroyProxy (
+            const ProxyId   pProxy
+        ) = 0;
+
+        /**
+         * @brief   Updates a proxy's bounding box after its body has moved.
+         *
+         * @param   pProxy          The proxy's handle.
+         * @param   pBounds         The body's new bounding box.
+         * @param   pDisplacement   How far the body moved since its last
+         *                          update, which broadphases with fattened
+         *                          boxes use to predict where it goes next.
+         */
+        virtual void MoveProxy (
+            const ProxyId       pProxy,
+            const AABB3f&       pBounds,
+            const Vector3f&     pDisplacement
+        ) = 0;
+
+        /**
+         * @brief   Finds every pair of proxies whose boxes overlap.
+         *
+         * @param   pPairs  The list the pairs are written to. Any pairs
+         *                  already in it are cleared first.
+         */
+        virtual void FindPairs (
+            std::vector<ProxyPair>& pPairs
+        ) = 0;
+
+        /**
+         * @brief   Finds every proxy whose box overlaps the given box.
+         *
+         * @param   pBounds     The box to look in.
+         * @param   pProxies    The list the proxies' handles are appended to.
+         */
+        virtual void Query (
+            const AABB3f&           pBounds,
+            std::vector<ProxyId>&   pProxies
+        ) const = 0;
+
+        /**
+         * @brief   Retrieves the value a proxy was created with.
+         *
+         * @param   pProxy  The proxy's handle.
+         *
+         * @return  The proxy's user data.
+         */
+        virtual std::uint64_t GetUserData (
+            const ProxyId   pProxy
+        ) const = 0;
+
+        /**
+         * @brief   Retrieves the number of proxies.
+         *
+         * @return  The number of proxies.
+         */
+        virtual std::size_t GetProxyCount () const = 0;
+
+    };
+
+}
@@ -0,0 +1,1588 @@
+/**
+ * @file    Ace/Physics/PhysicsWorld.cpp
+ */
+
+#include <bit>
+#include <numeric>
+#include <Ace/Physics/PhysicsWorld.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Structures ******************************************************/
+
+    /**
+     * @brief   A structure containing the placement and size of a shape, in
+     *          world space.
+     */
+    struct ShapeView
+    {
+        Vector3f    mCentre;        ///< @brief The shape's centre.
+        Matrix3f    mRotation;      ///< @brief The shape's orientation, whose columns are its local axes.
+        Vector3f    mHalfExtents;   ///< @brief The box's half extents, or the sphere's radius in X.
+    };
+
+    /**
+     * @brief   A structure containing one contact point found between two
+     *          shapes.
+     */
+    struct ShapeContact
+    {
+        Vector3f        mPosition;      ///< @brief The point, in world space.
+        Vector3f        mNormal;        ///< @brief The direction the second shape is pushed away from the first.
+        float           mDepth = 0.0f;  ///< @brief How far the shapes overlap along the normal.
+        std::uint32_t   mFeature = 0;   ///< @brief Identifies the point from one step to the next.
+    };
+
+    /**
+     * @brief   A structure containing the contact points found between two
+     *          shapes: at most one per box corner.
+     */
+    struct ShapeContacts
+    {
+        std::array<ShapeContact, 16>    mPoints;        ///< @brief The contact points.
+        std::size_t                     mCount = 0;     ///< @brief The number of points found.
+
+        void Add (
+            const Vector3f&     pPosition,
+            const Vector3f&     pNormal,
+            const float         pDepth,
+            const std::uint32_t pFeature
+        )
+        {
+            mPoints[mCount++] = { pPosition, pNormal, pDepth, pFeature };
+        }
+    };
+
+    /**
+     * @brief   A structure containing the solver's copy of one contact point,
+     *          before it is packed into a batch.
+     */
+    struct SolverContact
+    {
+        std::size_t     mManifold = 0;              ///< @brief The manifold the point belongs to.
+        std::size_t     mPoint = 0;                 ///< @brief The point's index in its manifold.
+        Vector3f        mDirections[3];             ///< @brief The normal, then the two tangents.
+        Vector3f        mAngularA[3];               ///< @brief The first body's lever arm crossed with each direction.
+        Vector3f        mAngularB[3];               ///< @brief The second body's lever arm crossed with each direction.
+        Vector3f        mTurnA[3];                  ///< @brief How the first body's spin changes per unit impulse along each direction.
+        Vector3f        mTurnB[3];                  ///< @brief How the second body's spin changes per unit impulse along each direction.
+        float           mMasses[3] = {};            ///< @brief The effective mass along each direction.
+        float           mImpulses[3] = {};          ///< @brief The impulse applied along each direction.
+        float           mInverseMassA = 0.0f;       ///< @brief The first body's inverse mass.
+        float           mInverseMassB = 0.0f;       ///< @brief The second body's inverse mass.
+        float           mFriction = 0.0f;           ///< @brief The combined coefficient of friction.
+        float           mBias = 0.0f;               ///< @brief The separating speed the normal impulse aims for.
+    };
+
+    /**
+     * @brief   A structure containing the solver's view of one manifold: its
+     *          bodies, and its range of the island's contact points.
+     */
+    struct SolverManifold
+    {
+        std::uint32_t   mBodyA = 0;             ///< @brief The first body's index in the island's solver arrays.
+        std::uint32_t   mBodyB = 0;             ///< @brief The second body's index in the island's solver arrays.
+        std::uint32_t   mFirstContact = 0;      ///< @brief The manifold's first point in the island's contacts.
+        std::uint32_t   mContactCount = 0;      ///< @brief The number of points in the manifold.
+    };
+
+    /**
+     * @brief   A structure containing the same point of four manifolds, laid
+     *          out to be solved side by side. Unused lanes have zero masses.
+     */
+    struct alignas(16) ContactLanes
+    {
+        alignas(16) float           mBias[4];               ///< @brief Each lane's separating speed.
+        alignas(16) float           mDirection[3][3][4];    ///< @brief Each direction's components, per lane.
+        alignas(16) float           mAngularA[3][3][4];     ///< @brief The first lever arm crossed with each direction, per lane.
+        alignas(16) float           mAngularB[3][3][4];     ///< @brief The second lever arm crossed with each direction, per lane.
+        alignas(16) float           mTurnA[3][3][4];        ///< @brief The first body's spin per unit impulse, per lane.
+        alignas(16) float           mTurnB[3][3][4];        ///< @brief The second body's spin per unit impulse, per lane.
+        alignas(16) float           mMass[3][4];            ///< @brief The effective mass along each direction, per lane.
+        alignas(16) float           mImpulse[3][4];         ///< @brief The impulse along each direction, per lane.
+        std::uint32_t               mContacts[4];           ///< @brief Each lane's contact, or @a `UNUSED_LANE`.
+    };
+
+    /**
+     * @brief   A structure containing four manifolds, none of which share a
+     *          dynamic body, whose points are solved side by side. Unused
+     *          lanes refer to the island's placeholder for static bodies.
+     */
+    struct alignas(16) ContactBatch
+    {
+        alignas(16) std::uint32_t   mBodyA[4];              ///< @brief Each lane's first body.
+        alignas(16) std::uint32_t   mBodyB[4];              ///< @brief Each lane's second body.
+        alignas(16) float           mInverseMassA[4];       ///< @brief Each lane's first body's inverse mass.
+        alignas(16) float           mInverseMassB[4];       ///< @brief Each lane's second body's inverse mass.
+        alignas(16) float           mFriction[4];           ///< @brief Each lane's coefficient of friction.
+        std::size_t                 mFirstPoint = 0;        ///< @brief The batch's first set of points in the island's lanes.
+        std::size_t                 mPointCount = 0;        ///< @brief The most points any lane's manifold has.
+    };
+
+    /**
+     * @brief   A structure containing one thread's scratch space for solving
+     *          islands.
+     */
+    struct IslandScratch
+    {
+        std::vector<float>          mVelocity[6];   ///< @brief Each body's linear then angular velocity components.
+        std::vector<SolverContact>  mContacts;      ///< @brief The island's contact points.
+        std::vector<SolverManifold> mManifolds;     ///< @brief The island's manifolds.
+        std::vector<std::uint64_t>  mColorMasks;    ///< @brief The colours each body's manifolds already use.
+        std::vector<std::uint8_t>   mColors;        ///< @brief Each manifold's colour.
+        std::vector<ContactBatch>   mBatches;       ///< @brief The island's batches, colour by colour.
+        std::vector<ContactLanes>   mPoints;        ///< @brief The points of every batch, batch by batch.
+    };
+
+    /* Static Members *********************************************************/
+
+    static constexpr std::uint32_t  UNUSED_LANE = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::uint8_t   OVERFLOW_COLOR = 64;
+    static constexpr float          CONTACT_MARGIN = 0.02f;
+    static thread_local IslandScratch sScratch;
+
+    /* Helper Functions *******************************************************/
+
+    #if defined(__SSE2__)
+
+        /**
+         * @brief   Four floats, processed side by side.
+         */
+        struct Lanes
+        {
+            __m128  mValue;
+        };
+
+        static inline Lanes Load (const float* pData) { return { _mm_load_ps(pData) }; }
+        static inline void Store (float* pData, const Lanes pLanes) { _mm_store_ps(pData, pLanes.mValue); }
+        static inline Lanes Splat (const float pValue) { return { _mm_set1_ps(pValue) }; }
+        static inline Lanes operator+ (const Lanes pLeft, const Lanes pRight) { return { _mm_add_ps(pLeft.mValue, pRight.mValue) }; }
+        static inline Lanes operator- (const Lanes pLeft, const Lanes pRight) { return { _mm_sub_ps(pLeft.mValue, pRight.mValue) }; }
+        static inline Lanes operator* (const Lanes pLeft, const Lanes pRight) { return { _mm_mul_ps(pLeft.mValue, pRight.mValue) }; }
+        static inline Lanes Min (const Lanes pLeft, const Lanes pRight) { return { _mm_min_ps(pLeft.mValue, pRight.mValue) }; }
+        static inline Lanes Max (const Lanes pLeft, const Lanes pRight) { return { _mm_max_ps(pLeft.mValue, pRight.mValue) }; }
+
+        static inline Lanes Gather (
+            const float*            pArray,
+            const std::uint32_t*    pIndices
+        )
+        {
+            return { _mm_setr_ps(pArray[pIndices[0]], pArray[pIndices[1]],
+                pArray[pIndices[2]], pArray[pIndices[3]]) };
+        }
+
+    #else
+
+        /**
+         * @brief   Four floats, processed one after another.
+         */
+        struct Lanes
+        {
+            float   mValue[4];
+        };
+
+        template <typename Fn>
+        static inline Lanes Apply (const Lanes pLeft, const Lanes pRight, Fn&& pFunction)
+        {
+            Lanes lResult;
+            for (std::size_t i = 0; i < 4; ++i)
+            {
+                lResult.mValue[i] = pFunction(pLeft.mValue[i], pRight.mValue[i]);
+            }
+
+            return lResult;
+        }
+
+        static inline Lanes Load (const float* pData) { return { pData[0], pData[1], pData[2], pData[3] }; }
+        static inline void Store (float* pData, const Lanes pLanes) { std::copy_n(pLanes.mValue, 4, pData); }
+        static inline Lanes Splat (const float pValue) { return { pValue, pValue, pValue, pValue }; }
+        static inline Lanes operator+ (const Lanes pLeft, const Lanes pRight) { return Apply(pLeft, pRight, [] (float a, float b) { return a + b; }); }
+        static inline Lanes operator- (const Lanes pLeft, const Lanes pRight) { return Apply(pLeft, pRight, [] (float a, float b) { return a - b; }); }
+        static inline Lanes operator* (const Lanes pLeft, const Lanes pRight) { return Apply(pLeft, pRight, [] (float a, float b) { return a * b; }); }
+        static inline Lanes Min (const Lanes pLeft, const Lanes pRight) { return Apply(pLeft, pRight, [] (float a, float b) { return b < a ? b : a; }); }
+        static inline Lanes Max (const Lanes pLeft, const Lanes pRight) { return Apply(pLeft, pRight, [] (float a, float b) { return a < b ? b : a; }); }
+
+        static inline Lanes Gather (
+            const float*            pArray,
+            const std::uint32_t*    pIndices
+        )
+        {
+            return { pArray[pIndices[0]], pArray[pIndices[1]], pArray[pIndices[2]], pArray[pIndices[3]] };
+        }
+
+    #endif
+
+    static inline void Scatter (
+        float*                  pArray,
+        const std::uint32_t*    pIndices,
+        const Lanes             pLanes
+    )
+    {
+        alignas(16) float lValues[4];
+        Store(lValues, pLanes);
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            pArray[pIndices[i]] = lValues[i];
+        }
+    }
+
+    /**
+     * @brief   Retrieves one of a rotation matrix's columns: a shape's local
+     *          axis, in world space.
+     */
+    static inline Vector3f GetAxis (
+        const Matrix3f&     pRotation,
+        const std::size_t   pAxis
+    )
+    {
+        return { pRotation.mI[pAxis * 3], pRotation.mI[pAxis * 3 + 1], pRotation.mI[pAxis * 3 + 2] };
+    }
+
+    static inline float GetComponent (
+        const Vector3f&     pVector,
+        const std::size_t   pAxis
+    )
+    {
+        return (pAxis == 0) ? pVector.mX : (pAxis == 1) ? pVector.mY : pVector.mZ;
+    }
+
+    static inline void SetComponent (
+        Vector3f&           pVector,
+        const std::size_t   pAxis,
+        const float         pValue
+    )
+    {
+        ((pAxis == 0) ? pVector.mX : (pAxis == 1) ? pVector.mY : pVector.mZ) = pValue;
+    }
+
+    /**
+     * @brief   Picks a unit vector perpendicular to the given unit vector,
+     *          the same one every time.
+     */
+    static inline Vector3f Perpendicular (
+        const Vector3f&     pNormal
+    )
+    {
+        Vector3f lTangent = (std::abs(pNormal.mX) >= 0.57735f) ?
+            Vector3f { pNormal.mY, -pNormal.mX, 0.0f } :
+            Vector3f { 0.0f, pNormal.mZ, -pNormal.mY };
+        return lTangent.Normalize();
+    }
+
+    /**
+     * @brief   Finds the contact between two spheres.
+     */
+    static void CollideSpheres (
+        const ShapeView&    pFirst,
+        const ShapeView&    pSecond,
+        ShapeContacts&      pContacts
+    )
+    {
+        const Vector3f lOffset = pSecond.mCentre - pFirst.mCentre;
+        const float lRadii = pFirst.mHalfExtents.mX + pSecond.mHalfExtents.mX;
+        const float lDistanceSquared = lOffset.LengthSquared();
+        if (lDistanceSquared > (lRadii + CONTACT_MARGIN) * (lRadii + CONTACT_MARGIN))
+        {
+            return;
+        }
+
+        const float lDistance = std::sqrt(lDistanceSquared);
+        const Vector3f lNormal = (lDistance > 1e-6f) ? lOffset / lDistance : Vector3f { 0.0f, 1.0f, 0.0f };
+        const float lDepth = lRadii - lDistance;
+        pContacts.Add(pFirst.mCentre + lNormal * (pFirst.mHalfExtents.mX - 0.5f * lDepth),
+            lNormal, lDepth, 0);
+    }
+
+    /**
+     * @brief   Finds the contact between a sphere and a box, with its normal
+     *          pointing away from whichever comes first.
+     */
+    static void CollideSphereBox (
+        const ShapeView&    pSphere,
+        const ShapeView&    pBox,
+        const bool          pSphereFirst,
+        ShapeContacts&      pContacts
+    )
+    {
+        const float lRadius = pSphere.mHalfExtents.mX;
+        const Vector3f lCentre = (pSphere.mCentre - pBox.mCentre) * pBox.mRotation;
+        Vector3f lClosest {
+            std::clamp(lCentre.mX, -pBox.mHalfExtents.mX, pBox.mHalfExtents.mX),
+            std::clamp(lCentre.mY, -pBox.mHalfExtents.mY, pBox.mHalfExtents.mY),
+            std::clamp(lCentre.mZ, -pBox.mHalfExtents.mZ, pBox.mHalfExtents.mZ)
+        };
+
+        Vector3f lNormal;
+        float lDepth = 0.0f;
+        if (lClosest == lCentre)
+        {
+            // The centre is inside the box: push it out through the nearest
+            // face.
+            std::size_t lAxis = 0;
+            float lNearest = std::numeric_limits<float>::max();
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                const float lGap = GetComponent(pBox.mHalfExtents, i) - std::abs(GetComponent(lCentre, i));
+                if (lGap < lNearest)
+                {
+                    lNearest = lGap;
+                    lAxis = i;
+                }
+            }
+
+            const float lSign = (GetComponent(lCentre, lAxis) < 0.0f) ? -1.0f : 1.0f;
+            SetComponent(lClosest, lAxis, lSign * GetComponent(pBox.mHalfExtents, lAxis));
+            lNormal = GetAxis(pBox.mRotation, lAxis) * lSign;
+            lDepth = lRadius + lNearest;
+        }
+        else
+        {
+            const Vector3f lOffset = lCentre - lClosest;
+            const float lDistanceSquared = lOffset.LengthSquared();
+            if (lDistanceSquared > (lRadius + CONTACT_MARGIN) * (lRadius + CONTACT_MARGIN))
+            {
+                return;
+            }
+
+            const float lDistance = std::sqrt(lDistanceSquared);
+            lNormal = pBox.mRotation * (lOffset / lDistance);
+            lDepth = lRadius - lDistance;
+        }
+
+        pContacts.Add(pBox.mCentre + pBox.mRotation * lClosest,
+            pSphereFirst == true ? -lNormal : lNormal, lDepth, 0);
+    }
+
+    /**
+     * @brief   Clips a polygon against the plane `Dot(pNormal, p) <= pOffset`,
+     *          keeping each vertex's feature, and giving new vertices one
+     *          made of the plane's and the clipped edge's.
+     */
+    static std::size_t ClipPolygon (
+        const Vector3f*         pVertices,
+        const std::uint32_t*    pFeatures,
+        const std::size_t       pCount,
+        const Vector3f&         pNormal,
+        const float             pOffset,
+        const std::uint32_t     pPlane,
+        Vector3f*               pOutVertices,
+        std::uint32_t*          pOutFeatures
+    )
+    {
+        std::size_t lCount = 0;
+        for (std::size_t i = 0; i < pCount; ++i)
+        {
+            const std::size_t lNext = (i + 1) % pCount;
+            const float lDistance = pNormal.Dot(pVertices[i]) - pOffset;
+            const float lNextDistance = pNormal.Dot(pVertices[lNext]) - pOffset;
+            if (lDistance <= 0.0f)
+            {
+                pOutVertices[lCount] = pVertices[i];
+                pOutFeatures[lCount++] = pFeatures[i];
+            }
+
+            if ((lDistance <= 0.0f) != (lNextDistance <= 0.0f))
+            {
+                const float lFraction = lDistance / (lDistance - lNextDistance);
+                pOutVertices[lCount] = pVertices[i] + (pVertices[lNext] - pVertices[i]) * lFraction;
+                pOutFeatures[lCount++] = ((pPlane + 1) << 4) | (pFeatures[i] & 0xF);
+            }
+        }
+
+        return lCount;
+    }
+
+    /**
+     * @brief   Finds the contacts between two boxes.
+     *
+     * The separating axes are tested first: each box's face normals, and
+     * the cross products of their edges. If the axis of least overlap is a
+     * face normal, the other box's face most opposed to it is clipped
+     * against that face's sides, and each clipped vertex becomes a contact.
+     * If it is a cross product, the two edges it came from touch at a
+     * single point. Face axes are preferred over axes which overlap only a
+     * little less, so that resting contacts keep the same reference face
+     * from one step to the next.
+     */
+    static void CollideBoxes (
+        const ShapeView&    pFirst,
+        const ShapeView&    pSecond,
+        ShapeContacts&      pContacts
+    )
+    {
+        const Vector3f lOffset = pSecond.mCentre - pFirst.mCentre;
+        std::array<Vector3f, 6> lFaceAxes;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lFaceAxes[i] = GetAxis(pFirst.mRotation, i);
+            lFaceAxes[3 + i] = GetAxis(pSecond.mRotation, i);
+        }
+
+        // Finds the overlap along an axis, or returns false if the boxes are
+        // too far apart along it to touch.
+        auto lTestAxis =
+            [&] (Vector3f pAxis, float& pOverlap, Vector3f& pDirection) -> bool
+            {
+                const float lLengthSquared = pAxis.LengthSquared();
+                if (lLengthSquared < 1e-6f)
+                {
+                    pOverlap = std::numeric_limits<float>::max();
+                    return true;
+                }
+
+                pAxis /= std::sqrt(lLengthSquared);
+                float lReach = 0.0f;
+                for (std::size_t i = 0; i < 3; ++i)
+                {
+                    lReach += GetComponent(pFirst.mHalfExtents, i) * std::abs(lFaceAxes[i].Dot(pAxis));
+                    lReach += GetComponent(pSecond.mHalfExtents, i) * std::abs(lFaceAxes[3 + i].Dot(pAxis));
+                }
+
+                const float lDistance = lOffset.Dot(pAxis);
+                pOverlap = lReach - std::abs(lDistance);
+                pDirection = (lDistance < 0.0f) ? -pAxis : pAxis;
+                return pOverlap >= -CONTACT_MARGIN;
+            };
+
+        std::size_t lBestIndex = 0;
+        float lBestOverlap = std::numeric_limits<float>::max();
+        Vector3f lBestDirection;
+        for (std::size_t i = 0; i < 15; ++i)
+        {
+            float lOverlap = 0.0f;
+            Vector3f lDirection;
+            const Vector3f lAxis = (i < 6) ? lFaceAxes[i] : lFaceAxes[(i - 6) / 3].Cross(lFaceAxes[3 + (i - 6) % 3]);
+            if (lTestAxis(lAxis, lOverlap, lDirection) == false)
+            {
+                return;
+            }
+
+            const float lTolerance = (i < 3) ? 0.0f : (i < 6) ? 0.005f : 0.01f;
+            if (lOverlap + lTolerance < lBestOverlap)
+            {
+                lBestIndex = i;
+                lBestOverlap = lOverlap;
+                lBestDirection = lDirection;
+            }
+        }
+
+        if (lBestIndex >= 6)
+        {
+            // Find the edge of each box along the axis' edges, nearest the
+            // other box, and the closest points between them.
+            const std::size_t lAxisA = (lBestIndex - 6) / 3;
+            const std::size_t lAxisB = (lBestIndex - 6) % 3;
+            Vector3f lPointA = pFirst.mCentre;
+            Vector3f lPointB = pSecond.mCentre;
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                if (i != lAxisA)
+                {
+                    const float lExtent = GetComponent(pFirst.mHalfExtents, i);
+                    lPointA += lFaceAxes[i] * ((lFaceAxes[i].Dot(lBestDirection) > 0.0f) ? lExtent : -lExtent);
+                }
+
+                if (i != lAxisB)
+                {
+                    const float lExtent = GetComponent(pSecond.mHalfExtents, i);
+                    lPointB += lFaceAxes[3 + i] * ((lFaceAxes[3 + i].Dot(lBestDirection) > 0.0f) ? -lExtent : lExtent);
+                }
+            }
+
+            const Vector3f& lEdgeA = lFaceAxes[lAxisA];
+            const Vector3f& lEdgeB = lFaceAxes[3 + lAxisB];
+            const Vector3f lBetween = lPointA - lPointB;
+            const float lCosine = lEdgeA.Dot(lEdgeB);
+            const float lAlongA = lEdgeA.Dot(lBetween);
+            const float lAlongB = lEdgeB.Dot(lBetween);
+            const float lDenominator = std::max(1.0f - lCosine * lCosine, 1e-6f);
+            const float lExtentA = GetComponent(pFirst.mHalfExtents, lAxisA);
+            const float lExtentB = GetComponent(pSecond.mHalfExtents, lAxisB);
+            const float lS = std::clamp((lCosine * lAlongB - lAlongA) / lDenominator, -lExtentA, lExtentA);
+            const float lT = std::clamp(lCosine * lS + lAlongB, -lExtentB, lExtentB);
+            pContacts.Add(((lPointA + lEdgeA * lS) + (lPointB + lEdgeB * lT)) * 0.5f,
+                lBestDirection, lBestOverlap, static_cast<std::uint32_t>(0x100 | lBestIndex));
+            return;
+        }
+
+        // The reference face belongs to the box the axis came from, and
+        // faces the other box.
+        const bool lFirstIsReference = lBestIndex < 3;
+        const ShapeView& lReference = (lFirstIsReference == true) ? pFirst : pSecond;
+        const ShapeView& lIncident = (lFirstIsReference == true) ? pSecond : pFirst;
+        const Vector3f lNormal = (lFirstIsReference == true) ? lBestDirection : -lBestDirection;
+        const std::size_t lReferenceAxis = lBestIndex % 3;
+
+        // The incident face is the other box's face most opposed to it.
+        std::size_t lIncidentAxis = 0;
+        float lMostOpposed = -1.0f;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            const float lAlignment = std::abs(GetAxis(lIncident.mRotation, i).Dot(lNormal));
+            if (lAlignment > lMostOpposed)
+            {
+                lMostOpposed = lAlignment;
+                lIncidentAxis = i;
+            }
+        }
+
+        const Vector3f lIncidentNormal = GetAxis(lIncident.mRotation, lIncidentAxis);
+        const float lIncidentSign = (lIncidentNormal.Dot(lNormal) > 0.0f) ? -1.0f : 1.0f;
+        const Vector3f lIncidentCentre = lIncident.mCentre +
+            lIncidentNormal * (lIncidentSign * GetComponent(lIncident.mHalfExtents, lIncidentAxis));
+        const Vector3f lU = GetAxis(lIncident.mRotation, (lIncidentAxis + 1) % 3) *
+            GetComponent(lIncident.mHalfExtents, (lIncidentAxis + 1) % 3);
+        const Vector3f lV = GetAxis(lIncident.mRotation, (lIncidentAxis + 2) % 3) *
+            GetComponent(lIncident.mHalfExtents, (lIncidentAxis + 2) % 3);
+
+        std::array<Vector3f, 8> lVertices {
+            lIncidentCentre + lU + lV,
+            lIncidentCentre - lU + lV,
+            lIncidentCentre - lU - lV,
+            lIncidentCentre + lU - lV
+        };
+        std::array<std::uint32_t, 8> lFeatures { 0, 1, 2, 3 };
+        std::size_t lCount = 4;
+
+        // Clip against the four sides of the reference face, pushed out by
+        // the margin, so that the corners of a face resting squarely on
+        // another stay the same points from one step to the next.
+        std::array<Vector3f, 8> lClipped;
+        std::array<std::uint32_t, 8> lClippedFeatures;
+        std::uint32_t lPlane = 0;
+        for (std::size_t lStep = 1; lStep < 3 && lCount > 0; ++lStep)
+        {
+            const std::size_t lSideAxis = (lReferenceAxis + lStep) % 3;
+            const Vector3f lSide = GetAxis(lReference.mRotation, lSideAxis);
+            const float lCentre = lSide.Dot(lReference.mCentre);
+            const float lExtent = GetComponent(lReference.mHalfExtents, lSideAxis) + CONTACT_MARGIN;
+
+            lCount = ClipPolygon(lVertices.data(), lFeatures.data(), lCount, lSide, lCentre + lExtent,
+                lPlane++, lClipped.data(), lClippedFeatures.data());
+            lCount = ClipPolygon(lClipped.data(), lClippedFeatures.data(), lCount, -lSide, lExtent - lCentre,
+                lPlane++, lVertices.data(), lFeatures.data());
+        }
+
+        // Each clipped vertex below the reference face, or close enough
+        // above it, becomes a contact halfway between the faces. Clipping
+        // along a side the incident face lines up with can leave vertices
+        // on top of each other; only the first of them is kept.
+        const float lFace = lNormal.Dot(lReference.mCentre) +
+            GetComponent(lReference.mHalfExtents, lReferenceAxis);
+        const std::uint32_t lFaceFeature = static_cast<std::uint32_t>(lBestIndex * 3 + lIncidentAxis) << 8;
+        for (std::size_t i = 0; i < lCount; ++i)
+        {
+            const float lDepth = lFace - lNormal.Dot(lVertices[i]);
+            const bool lDuplicate = std::any_of(lVertices.begin(), lVertices.begin() + i,
+                [&] (const Vector3f& pOther) -> bool
+                {
+                    return (pOther - lVertices[i]).LengthSquared() < 1e-6f;
+                });
+            if (lDepth >= -CONTACT_MARGIN && lDuplicate == false)
+            {
+                pContacts.Add(lVertices[i] + lNormal * (0.5f * lDepth),
+                    lBestDirection, lDepth, lFaceFeature | lFeatures[i]);
+            }
+        }
+    }
+
+    /**
+     * @brief   Finds the root of a body's island, halving the path to it.
+     */
+    static BodyId FindRoot (
+        std::vector<BodyId>&    pParents,
+        BodyId                  pBody
+    )
+    {
+        while (pParents[pBody] != pBody)
+        {
+            pParents[pBody] = pParents[pParents[pBody]];
+            pBody = pParents[pBody];
+        }
+
+        return pBody;
+    }
+
+    /**
+     * @brief   Packs a contact point into one lane of a set of points, or
+     *          clears the lane if there is no point.
+     */
+    static void PackLane (
+        ContactLanes&           pLanes,
+        const std::size_t       pLane,
+        const SolverContact*    pContact,
+        const std::uint32_t     pIndex
+    )
+    {
+        static const SolverContact sEmpty {};
+        const SolverContact& lContact = (pContact != nullptr) ? *pContact : sEmpty;
+
+        pLanes.mBias[pLane] = lContact.mBias;
+        pLanes.mContacts[pLane] = (pContact != nullptr) ? pIndex : UNUSED_LANE;
+        for (std::size_t lRow = 0; lRow < 3; ++lRow)
+        {
+            for (std::size_t i = 0; i < 3; ++i)
+            {
+                pLanes.mDirection[lRow][i][pLane] = GetComponent(lContact.mDirections[lRow], i);
+                pLanes.mAngularA[lRow][i][pLane] = GetComponent(lContact.mAngularA[lRow], i);
+                pLanes.mAngularB[lRow][i][pLane] = GetComponent(lContact.mAngularB[lRow], i);
+                pLanes.mTurnA[lRow][i][pLane] = GetComponent(lContact.mTurnA[lRow], i);
+                pLanes.mTurnB[lRow][i][pLane] = GetComponent(lContact.mTurnB[lRow], i);
+            }
+
+            pLanes.mMass[lRow][pLane] = lContact.mMasses[lRow];
+            pLanes.mImpulse[lRow][pLane] = lContact.mImpulses[lRow];
+        }
+    }
+
+    /**
+     * @brief   Runs one pass of the solver over a batch. The lanes' bodies'
+     *          velocities are gathered once, then each point in turn is
+     *          solved for all four manifolds: friction along each tangent,
+     *          clamped by the point's normal impulse so far, then the normal,
+     *          which may only push.
+     */
+    static void SolveBatch (
+        const ContactBatch& pBatch,
+        ContactLanes*       pPoints,
+        float* const        (&pVelocity)[6]
+    )
+    {
+        const std::uint32_t* lA = pBatch.mBodyA;
+        const std::uint32_t* lB = pBatch.mBodyB;
+        Lanes lLinearA[3], lAngularA[3], lLinearB[3], lAngularB[3];
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            lLinearA[i] = Gather(pVelocity[i], lA);
+            lAngularA[i] = Gather(pVelocity[3 + i], lA);
+            lLinearB[i] = Gather(pVelocity[i], lB);
+            lAngularB[i] = Gather(pVelocity[3 + i], lB);
+        }
+
+        const Lanes lInverseMassA = Load(pBatch.mInverseMassA);
+        const Lanes lInverseMassB = Load(pBatch.mInverseMassB);
+        const Lanes lFriction = Load(pBatch.mFriction);
+        const Lanes lZero = Splat(0.0f);
+        const Lanes lUnbounded = Splat(std::numeric_limits<float>::max());
+
+        for (std::size_t lPoint = 0; lPoint < pBatch.mPointCount; ++lPoint)
+        {
+            ContactLanes& lLanes = pPoints[pBatch.mFirstPoint + lPoint];
+            auto lSolveRow =
+                [&] (const std::size_t pRow, const Lanes pTarget, const Lanes pLower, const Lanes pUpper) -> void
+                {
+                    Lanes lDirection[3], lLeverA[3], lLeverB[3];
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        lDirection[i] = Load(lLanes.mDirection[pRow][i]);
+                        lLeverA[i] = Load(lLanes.mAngularA[pRow][i]);
+                        lLeverB[i] = Load(lLanes.mAngularB[pRow][i]);
+                    }
+
+                    // The relative speed of the contact points along the
+                    // direction.
+                    Lanes lSpeed = lZero;
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        lSpeed = lSpeed + lDirection[i] * (lLinearB[i] - lLinearA[i]) +
+                            lLeverB[i] * lAngularB[i] - lLeverA[i] * lAngularA[i];
+                    }
+
+                    const Lanes lOld = Load(lLanes.mImpulse[pRow]);
+                    const Lanes lNew = Min(Max(lOld + Load(lLanes.mMass[pRow]) * (pTarget - lSpeed), pLower), pUpper);
+                    const Lanes lDelta = lNew - lOld;
+                    Store(lLanes.mImpulse[pRow], lNew);
+
+                    for (std::size_t i = 0; i < 3; ++i)
+                    {
+                        lLinearA[i] = lLinearA[i] - lDirection[i] * lDelta * lInverseMassA;
+                        lLinearB[i] = lLinearB[i] + lDirection[i] * lDelta * lInverseMassB;
+                        lAngularA[i] = lAngularA[i] - Load(lLanes.mTurnA[pRow][i]) * lDelta;
+                        lAngularB[i] = lAngularB[i] + Load(lLanes.mTurnB[pRow][i]) * lDelta;
+                    }
+                };
+
+            const Lanes lFrictionLimit = lFriction * Load(lLanes.mImpulse[0]);
+            const Lanes lLowerFriction = lZero - lFrictionLimit;
+            lSolveRow(1, lZero, lLowerFriction, lFrictionLimit);
+            lSolveRow(2, lZero, lLowerFriction, lFrictionLimit);
+            lSolveRow(0, Load(lLanes.mBias), lZero, lUnbounded);
+        }
+
+        // Unused lanes, and lanes against static bodies, all refer to the
+        // placeholder, whose velocity stays zero, so the order of the
+        // scatters does not matter.
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            Scatter(pVelocity[i], lA, lLinearA[i]);
+            Scatter(pVelocity[3 + i], lA, lAngularA[i]);
+            Scatter(pVelocity[i], lB, lLinearB[i]);
+            Scatter(pVelocity[3 + i], lB, lAngularB[i]);
+        }
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    PhysicsWorld::PhysicsWorld (
+        const PhysicsWorldSpec& pSpec
+    ) :
+        mSpec       { pSpec },
+        mBroadphase { BroadphaseSpec { .mThreadPool = pSpec.mThreadPool, .mGrainSize = 512 } }
+    {}
+
+    /* Public Methods *********************************************************/
+
+    BodyId PhysicsWorld::CreateBody (
+        const RigidBodyDesc&    pDesc
+    )
+    {
+        if (pDesc.mMass < 0.0f)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Mass must not be negative!",
+                "PhysicsWorld");
+        }
+
+        const float lRadius = pDesc.mHalfExtents.mX;
+        if (
+            lRadius <= 0.0f ||
+            (pDesc.mShape == BodyShape::Box && (pDesc.mHalfExtents.mY <= 0.0f || pDesc.mHalfExtents.mZ <= 0.0f))
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Half extents must be positive!",
+                "PhysicsWorld");
+        }
+
+        BodyId lBody = INVALID_BODY;
+        if (mFreeBodies.empty() == false)
+        {
+            lBody = mFreeBodies.back();
+            mFreeBodies.pop_back();
+        }
+        else
+        {
+            lBody = static_cast<BodyId>(mBodies.size());
+            mBodies.emplace_back();
+        }
+
+        Body& lState = mBodies[lBody];
+        lState = Body {};
+        lState.mShape = pDesc.mShape;
+        lState.mHalfExtents = pDesc.mHalfExtents;
+        lState.mPosition = pDesc.mPosition;
+        lState.mOrientation = pDesc.mOrientation.Normalized();
+        lState.mFriction = pDesc.mFriction;
+        lState.mRestitution = pDesc.mRestitution;
+        lState.mAlive = true;
+
+        if (pDesc.mMass > 0.0f)
+        {
+            // The inertia of a solid sphere or box about its centre.
+            Vector3f lInertia;
+            if (pDesc.mShape == BodyShape::Sphere)
+            {
+                const float lMoment = 0.4f * pDesc.mMass * lRadius * lRadius;
+                lInertia = { lMoment, lMoment, lMoment };
+            }
+            else
+            {
+                const Vector3f lSquared = pDesc.mHalfExtents * pDesc.mHalfExtents;
+                lInertia = Vector3f {
+                    lSquared.mY + lSquared.mZ,
+                    lSquared.mX + lSquared.mZ,
+                    lSquared.mX + lSquared.mY
+                } * (pDesc.mMass / 3.0f);
+            }
+
+            lState.mInverseMass = 1.0f / pDesc.mMass;
+            lState.mLocalInverseInertia = { 1.0f / lInertia.mX, 1.0f / lInertia.mY, 1.0f / lInertia.mZ };
+            lState.mLinearVelocity = pDesc.mLinearVelocity;
+            lState.mAngularVelocity = pDesc.mAngularVelocity;
+            lState.mAwake = true;
+        }
+
+        UpdateDerived(lState);
+        lState.mProxy = mBroadphase.CreateProxy(ComputeBounds(lState), lBody);
+        ++mBodyCount;
+        return lBody;
+    }
+
+    void PhysicsWorld::DestroyBody (
+        const BodyId    pBody
+    )
+    {
+        if (pBody >= mBodies.size() || mBodies[pBody].mAlive == false)
+        {
+            return;
+        }
+
+        // Wake whatever touches the body. Sleeping bodies have no manifolds,
+        // so they are found through the broadphase.
+        std::vector<ProxyId> lTouching;
+        mBroadphase.Query(ComputeBounds(mBodies[pBody]).Expanded(CONTACT_MARGIN), lTouching);
+        for (const ProxyId lProxy : lTouching)
+        {
+            Body& lOther = mBodies[static_cast<BodyId>(mBroadphase.GetUserData(lProxy))];
+            if (lOther.mInverseMass > 0.0f && lOther.mAwake == false)
+            {
+                lOther.mAwake = true;
+                lOther.mSlowTime = 0.0f;
+            }
+        }
+
+        // Forget the impulses of its contacts, so that they cannot carry over
+        // to a later body given the same handle.
+        for (const Manifold& lManifold : mManifolds)
+        {
+            if (lManifold.mFirst == pBody || lManifold.mSecond == pBody)
+            {
+                mLastManifolds.erase((std::uint64_t { lManifold.mFirst } << 32) | lManifold.mSecond);
+            }
+        }
+
+        std::erase_if(mManifolds,
+            [pBody] (const Manifold& pManifold) -> bool
+            {
+                return pManifold.mFirst == pBody || pManifold.mSecond == pBody;
+            });
+
+        mBroadphase.DestroyProxy(mBodies[pBody].mProxy);
+        mBodies[pBody].mAlive = false;
+        mBodies[pBody].mAwake = false;
+        mFreeBodies.push_back(pBody);
+        --mBodyCount;
+    }
+
+    void PhysicsWorld::Step (
+        const float pDeltaTime
+    )
+    {
+        mStats = PhysicsStepStats {};
+        if (pDeltaTime <= 0.0f)
+        {
+            return;
+        }
+
+        // Apply gravity, and move the awake bodies' proxies to where they are
+        // heading, so that the pairs cover this step's motion.
+        const Vector3f lGravityStep = mSpec.mGravity * pDeltaTime;
+        for (Body& lBody : mBodies)
+        {
+            if (lBody.mAwake == true)
+            {
+                lBody.mLinearVelocity += lGravityStep;
+                mBroadphase.MoveProxy(lBody.mProxy, ComputeBounds(lBody),
+                    lBody.mLinearVelocity * pDeltaTime);
+            }
+        }
+
+        Collide();
+        BuildIslands();
+
+        mIslandResults.assign(mIslands.size(), {});
+        auto lSolve =
+            [this, pDeltaTime] (std::size_t pIsland) -> void
+            {
+                mIslandResults[pIsland] = SolveIsland(mIslands[pIsland], pDeltaTime);
+            };
+
+        if (mSpec.mThreadPool != nullptr && mIslands.size() > 1)
+        {
+            mSpec.mThreadPool->ParallelFor(mIslands.size(), lSolve, 4);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < mIslands.size(); ++i)
+            {
+                lSolve(i);
+            }
+        }
+
+        // Keep this step's impulses for the next step's warm start.
+        mLastManifolds.clear();
+        for (const Manifold& lManifold : mManifolds)
+        {
+            mLastManifolds.emplace((std::uint64_t { lManifold.mFirst } << 32) | lManifold.mSecond, lManifold);
+            mStats.mContactCount += lManifold.mPointCount;
+        }
+
+        for (const auto& [lBatches, lColors] : mIslandResults)
+        {
+            mStats.mBatchCount += lBatches;
+            mStats.mColorCount = std::max(mStats.mColorCount, lColors);
+        }
+
+        for (const Body& lBody : mBodies)
+        {
+            mStats.mAwakeBodyCount += (lBody.mAwake == true) ? 1 : 0;
+        }
+
+        mStats.mPairCount = mPairs.size();
+        mStats.mIslandCount = mIslands.size();
+    }
+
+    void PhysicsWorld::SetVelocity (
+        const BodyId        pBody,
+        const Vector3f&     pLinearVelocity,
+        const Vector3f&     pAngularVelocity
+    )
+    {
+        Body& lBody = mBodies[pBody];
+        if (lBody.mInverseMass == 0.0f)
+        {
+            return;
+        }
+
+        lBody.mLinearVelocity = pLinearVelocity;
+        lBody.mAngularVelocity = pAngularVelocity;
+        lBody.mAwake = true;
+        lBody.mSlowTime = 0.0f;
+    }
+
+    const Vector3f& PhysicsWorld::GetPosition (
+        const BodyId    pBody
+    ) const
+    {
+        return mBodies[pBody].mPosition;
+    }
+
+    const Quaternion4f& PhysicsWorld::GetOrientation (
+        const BodyId    pBody
+    ) const
+    {
+        return mBodies[pBody].mOrientation;
+    }
+
+    const Vector3f& PhysicsWorld::GetLinearVelocity (
+        const BodyId    pBody
+    ) const
+    {
+        return mBodies[pBody].mLinearVelocity;
+    }
+
+    const Vector3f& PhysicsWorld::GetAngularVelocity (
+        const BodyId    pBody
+    ) const
+    {
+        return mBodies[pBody].mAngularVelocity;
+    }
+
+    bool PhysicsWorld::IsAwake (
+        const BodyId    pBody
+    ) const
+    {
+        return mBodies[pBody].mAwake;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void PhysicsWorld::UpdateDerived (
+        Body&   pBody
+    )
+    {
+        // I⁻¹ = R · diag(I⁻¹ local) · Rᵀ
+        pBody.mRotation = pBody.mOrientation.ToMatrix3();
+        Matrix3f lScaled = pBody.mRotation;
+        for (std::size_t lColumn = 0; lColumn < 3; ++lColumn)
+        {
+            const float lScale = GetComponent(pBody.mLocalInverseInertia, lColumn);
+            for (std::size_t lRow = 0; lRow < 3; ++lRow)
+            {
+                lScaled(lRow, lColumn) *= lScale;
+            }
+        }
+
+        pBody.mInverseInertia = lScaled * pBody.mRotation.Transpose();
+    }
+
+    AABB3f PhysicsWorld::ComputeBounds (
+        const Body& pBody
+    )
+    {
+        if (pBody.mShape == BodyShape::Sphere)
+        {
+            return AABB3f::FromCenterExtents(pBody.mPosition, Vector3f {
+                pBody.mHalfExtents.mX, pBody.mHalfExtents.mX, pBody.mHalfExtents.mX });
+        }
+
+        // A rotated box reaches along each world axis by the sum of its half
+        // extents, each scaled by how closely its axis lines up.
+        Vector3f lReach;
+        for (std::size_t lRow = 0; lRow < 3; ++lRow)
+        {
+            float lSum = 0.0f;
+            for (std::size_t lColumn = 0; lColumn < 3; ++lColumn)
+            {
+                lSum += std::abs(pBody.mRotation(lRow, lColumn)) * GetComponent(pBody.mHalfExtents, lColumn);
+            }
+
+            SetComponent(lReach, lRow, lSum);
+        }
+
+        return AABB3f::FromCenterExtents(pBody.mPosition, lReach);
+    }
+
+    bool PhysicsWorld::CollideBodies (
+        const Body& pFirst,
+        const Body& pSecond,
+        Manifold&   pManifold
+    )
+    {
+        const ShapeView lFirst { pFirst.mPosition, pFirst.mRotation, pFirst.mHalfExtents };
+        const ShapeView lSecond { pSecond.mPosition, pSecond.mRotation, pSecond.mHalfExtents };
+        ShapeContacts lContacts;
+        if (pFirst.mShape == BodyShape::Sphere && pSecond.mShape == BodyShape::Sphere)
+        {
+            CollideSpheres(lFirst, lSecond, lContacts);
+        }
+        else if (pFirst.mShape == BodyShape::Sphere)
+        {
+            CollideSphereBox(lFirst, lSecond, true, lContacts);
+        }
+        else if (pSecond.mShape == BodyShape::Sphere)
+        {
+            CollideSphereBox(lSecond, lFirst, false, lContacts);
+        }
+        else
+        {
+            CollideBoxes(lFirst, lSecond, lContacts);
+        }
+
+        // Keep the deepest points, if there are too many. Ties are broken by
+        // feature, so that the choice is the same every time.
+        auto lBegin = lContacts.mPoints.begin();
+        auto lEnd = lBegin + lContacts.mCount;
+        if (lContacts.mCount > MAX_MANIFOLD_POINTS)
+        {
+            std::sort(lBegin, lEnd,
+                [] (const ShapeContact& pLeft, const ShapeContact& pRight) -> bool
+                {
+                    return (pLeft.mDepth != pRight.mDepth) ?
+                        pLeft.mDepth > pRight.mDepth :
+                        pLeft.mFeature < pRight.mFeature;
+                });
+            lEnd = lBegin + MAX_MANIFOLD_POINTS;
+        }
+
+        pManifold.mPointCount = 0;
+        for (auto lIter = lBegin; lIter != lEnd; ++lIter)
+        {
+            ContactPoint& lPoint = pManifold.mPoints[pManifold.mPointCount++];
+            lPoint = ContactPoint {};
+            lPoint.mPosition = lIter->mPosition;
+            lPoint.mNormal = lIter->mNormal;
+            lPoint.mDepth = lIter->mDepth;
+            lPoint.mFeature = lIter->mFeature;
+        }
+
+        return pManifold.mPointCount > 0;
+    }
+
+    void PhysicsWorld::Collide ()
+    {
+        mBroadphase.FindPairs(mPairs);
+
+        // Generate the manifolds in batches of pairs, each batch writing to a
+        // list of its own, so that the lists can be joined in order.
+        constexpr std::size_t GRAIN_SIZE = 256;
+        const std::size_t lBatchCount = (mPairs.size() + GRAIN_SIZE - 1) / GRAIN_SIZE;
+        mBatchManifolds.resize(lBatchCount);
+
+        auto lCollideBatch =
+            [this] (std::size_t pBatch) -> void
+            {
+                std::vector<Manifold>& lManifolds = mBatchManifolds[pBatch];
+                lManifolds.clear();
+
+                const std::size_t lEnd = std::min(mPairs.size(), (pBatch + 1) * GRAIN_SIZE);
+                for (std::size_t i = pBatch * GRAIN_SIZE; i < lEnd; ++i)
+                {
+                    BodyId lFirst = static_cast<BodyId>(mBroadphase.GetUserData(mPairs[i].mFirst));
+                    BodyId lSecond = static_cast<BodyId>(mBroadphase.GetUserData(mPairs[i].mSecond));
+                    if (lFirst > lSecond)
+                    {
+                        std::swap(lFirst, lSecond);
+                    }
+
+                    // Pairs with no awake body are left as they were.
+                    const Body& lBodyA = mBodies[lFirst];
+                    const Body& lBodyB = mBodies[lSecond];
+                    if (
+                        (lBodyA.mAwake == false && lBodyB.mAwake == false) ||
+                        ComputeBounds(lBodyA).Expanded(CONTACT_MARGIN).Intersects(ComputeBounds(lBodyB)) == false
+                    )
+                    {
+                        continue;
+                    }
+
+                    Manifold lManifold;
+                    lManifold.mFirst = lFirst;
+                    lManifold.mSecond = lSecond;
+                    if (CollideBodies(lBodyA, lBodyB, lManifold) == false)
+                    {
+                        continue;
+                    }
+
+                    // Carry over the impulses of the points which were there
+                    // last step.
+                    const auto lLast = mLastManifolds.find((std::uint64_t { lFirst } << 32) | lSecond);
+                    if (lLast != mLastManifolds.end())
+                    {
+                        for (std::uint32_t lPoint = 0; lPoint < lManifold.mPointCount; ++lPoint)
+                        {
+                            ContactPoint& lNew = lManifold.mPoints[lPoint];
+                            for (std::uint32_t lOld = 0; lOld < lLast->second.mPointCount; ++lOld)
+                            {
+                                const ContactPoint& lPrevious = lLast->second.mPoints[lOld];
+                                if (lPrevious.mFeature == lNew.mFeature)
+                                {
+                                    lNew.mNormalImpulse = lPrevious.mNormalImpulse;
+                                    lNew.mTangentImpulse1 = lPrevious.mTangentImpulse1;
+                                    lNew.mTangentImpulse2 = lPrevious.mTangentImpulse2;
+                                    break;
+                                }
+                            }
+                        }
+                    }
+
+                    lManifolds.push_back(lManifold);
+                }
+            };
+
+        if (mSpec.mThreadPool != nullptr && lBatchCount > 1)
+        {
+            mSpec.mThreadPool->ParallelFor(lBatchCount, lCollideBatch);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < lBatchCount; ++i)
+            {
+                lCollideBatch(i);
+            }
+        }
+
+        mManifolds.clear();
+        for (std::size_t i = 0; i < lBatchCount; ++i)
+        {
+            mManifolds.insert(mManifolds.end(), mBatchManifolds[i].begin(), mBatchManifolds[i].end());
+        }
+    }
+
+    void PhysicsWorld::BuildIslands ()
+    {
+        const std::size_t lBodyCount = mBodies.size();
+        mIslandParents.resize(lBodyCount);
+        std::iota(mIslandParents.begin(), mIslandParents.end(), BodyId { 0 });
+
+        // Join the bodies of every manifold between two dynamic bodies. The
+        // lower root always becomes the parent, so that the islands come out
+        // the same every time.
+        for (const Manifold& lManifold : mManifolds)
+        {
+            if (mBodies[lManifold.mFirst].mInverseMass > 0.0f && mBodies[lManifold.mSecond].mInverseMass > 0.0f)
+            {
+                const BodyId lRootA = FindRoot(mIslandParents, lManifold.mFirst);
+                const BodyId lRootB = FindRoot(mIslandParents, lManifold.mSecond);
+                mIslandParents[std::max(lRootA, lRootB)] = std::min(lRootA, lRootB);
+            }
+        }
+
+        // Wake every body in an island with an awake body, and number the
+        // islands in the order of their lowest body.
+        constexpr std::size_t NO_ISLAND = std::numeric_limits<std::size_t>::max();
+        std::vector<std::size_t> lIslandOfRoot(lBodyCount, NO_ISLAND);
+        for (std::size_t i = 0; i < lBodyCount; ++i)
+        {
+            if (mBodies[i].mAwake == true)
+            {
+                lIslandOfRoot[FindRoot(mIslandParents, static_cast<BodyId>(i))] = 0;
+            }
+        }
+
+        mIslands.clear();
+        std::vector<std::size_t> lIslandOfBody(lBodyCount, NO_ISLAND);
+        for (std::size_t i = 0; i < lBodyCount; ++i)
+        {
+            Body& lBody = mBodies[i];
+            if (lBody.mAlive == false || lBody.mInverseMass == 0.0f)
+            {
+                continue;
+            }
+
+            const BodyId lRoot = FindRoot(mIslandParents, static_cast<BodyId>(i));
+            if (lIslandOfRoot[lRoot] == NO_ISLAND)
+            {
+                continue;
+            }
+
+            if (lRoot == i)
+            {
+                lIslandOfRoot[lRoot] = mIslands.size();
+                mIslands.emplace_back();
+            }
+
+            if (lBody.mAwake == false)
+            {
+                lBody.mAwake = true;
+                lBody.mSlowTime = 0.0f;
+            }
+
+            lIslandOfBody[i] = lIslandOfRoot[lRoot];
+            ++mIslands[lIslandOfBody[i]].mBodyEnd;
+        }
+
+        // Lay the islands' bodies and manifolds out island by island, each
+        // in its original order.
+        std::size_t lOffset = 0;
+        for (Island& lIsland : mIslands)
+        {
+            lIsland.mBodyBegin = lOffset;
+            lOffset += lIsland.mBodyEnd;
+            lIsland.mBodyEnd = lIsland.mBodyBegin;
+        }
+
+        mIslandBodies.resize(lOffset);
+        for (std::size_t i = 0; i < lBodyCount; ++i)
+        {
+            if (lIslandOfBody[i] != NO_ISLAND)
+            {
+                mIslandBodies[mIslands[lIslandOfBody[i]].mBodyEnd++] = static_cast<BodyId>(i);
+            }
+        }
+
+        std::vector<std::size_t> lIslandOfManifold(mManifolds.size());
+        for (std::size_t i = 0; i < mManifolds.size(); ++i)
+        {
+            const BodyId lDynamic = (mBodies[mManifolds[i].mFirst].mInverseMass > 0.0f) ?
+                mManifolds[i].mFirst : mManifolds[i].mSecond;
+            lIslandOfManifold[i] = lIslandOfBody[lDynamic];
+            ++mIslands[lIslandOfManifold[i]].mManifoldEnd;
+        }
+
+        lOffset = 0;
+        for (Island& lIsland : mIslands)
+        {
+            lIsland.mManifoldBegin = lOffset;
+            lOffset += lIsland.mManifoldEnd;
+            lIsland.mManifoldEnd = lIsland.mManifoldBegin;
+        }
+
+        mIslandManifolds.resize(lOffset);
+        for (std::size_t i = 0; i < mManifolds.size(); ++i)
+        {
+            mIslandManifolds[mIslands[lIslandOfManifold[i]].mManifoldEnd++] = i;
+        }
+
+        mLocalIndices.resize(lBodyCount);
+    }
+
+    std::pair<std::size_t, std::size_t> PhysicsWorld::SolveIsland (
+        const Island&   pIsland,
+        const float     pDeltaTime
+    )
+    {
+        IslandScratch& lScratch = sScratch;
+
+        // Copy the island's velocities into the solver's arrays. Slot zero
+        // stands in for every static body, which never moves.
+        const std::size_t lBodyCount = pIsland.mBodyEnd - pIsland.mBodyBegin;
+        for (auto& lComponent : lScratch.mVelocity)
+        {
+            lComponent.assign(lBodyCount + 1, 0.0f);
+        }
+
+        for (std::size_t i = 0; i < lBodyCount; ++i)
+        {
+            const BodyId lId = mIslandBodies[pIsland.mBodyBegin + i];
+            const Body& lBody = mBodies[lId];
+            mLocalIndices[lId] = static_cast<std::uint32_t>(i + 1);
+            lScratch.mVelocity[0][i + 1] = lBody.mLinearVelocity.mX;
+            lScratch.mVelocity[1][i + 1] = lBody.mLinearVelocity.mY;
+            lScratch.mVelocity[2][i + 1] = lBody.mLinearVelocity.mZ;
+            lScratch.mVelocity[3][i + 1] = lBody.mAngularVelocity.mX;
+            lScratch.mVelocity[4][i + 1] = lBody.mAngularVelocity.mY;
+            lScratch.mVelocity[5][i + 1] = lBody.mAngularVelocity.mZ;
+        }
+
+        float* const lVelocity[6] = {
+            lScratch.mVelocity[0].data(), lScratch.mVelocity[1].data(), lScratch.mVelocity[2].data(),
+            lScratch.mVelocity[3].data(), lScratch.mVelocity[4].data(), lScratch.mVelocity[5].data()
+        };
+
+        auto lGetVelocity =
+            [&] (std::uint32_t pSlot, std::size_t pFirst) -> Vector3f
+            {
+                return { lVelocity[pFirst][pSlot], lVelocity[pFirst + 1][pSlot], lVelocity[pFirst + 2][pSlot] };
+            };
+
+        auto lAddVelocity =
+            [&] (std::uint32_t pSlot, std::size_t pFirst, const Vector3f& pDelta) -> void
+            {
+                lVelocity[pFirst][pSlot] += pDelta.mX;
+                lVelocity[pFirst + 1][pSlot] += pDelta.mY;
+                lVelocity[pFirst + 2][pSlot] += pDelta.mZ;
+            };
+
+        // Prepare each contact point: its directions, lever arms, effective
+        // masses and bias, then apply its carried-over impulses.
+        const float lInverseDeltaTime = 1.0f / pDeltaTime;
+        lScratch.mContacts.clear();
+        lScratch.mManifolds.clear();
+        for (std::size_t m = pIsland.mManifoldBegin; m < pIsland.mManifoldEnd; ++m)
+        {
+            const std::size_t lManifoldIndex = mIslandManifolds[m];
+            const Manifold& lManifold = mManifolds[lManifoldIndex];
+            const Body& lBodyA = mBodies[lManifold.mFirst];
+            const Body& lBodyB = mBodies[lManifold.mSecond];
+            const std::uint32_t lSlotA = (lBodyA.mInverseMass > 0.0f) ? mLocalIndices[lManifold.mFirst] : 0;
+            const std::uint32_t lSlotB = (lBodyB.mInverseMass > 0.0f) ? mLocalIndices[lManifold.mSecond] : 0;
+            const float lFriction = std::sqrt(lBodyA.mFriction * lBodyB.mFriction);
+            const float lRestitution = std::max(lBodyA.mRestitution, lBodyB.mRestitution);
+            lScratch.mManifolds.push_back({ lSlotA, lSlotB,
+                static_cast<std::uint32_t>(lScratch.mContacts.size()), lManifold.mPointCount });
+
+            for (std::uint32_t p = 0; p < lManifold.mPointCount; ++p)
+            {
+                const ContactPoint& lPoint = lManifold.mPoints[p];
+                SolverContact& lContact = lScratch.mContacts.emplace_back();
+                lContact.mManifold = lManifoldIndex;
+                lContact.mPoint = p;
+                lContact.mInverseMassA = lBodyA.mInverseMass;
+                lContact.mInverseMassB = lBodyB.mInverseMass;
+                lContact.mFriction = lFriction;
+                lContact.mDirections[0] = lPoint.mNormal;
+                lContact.mDirections[1] = Perpendicular(lPoint.mNormal);
+                lContact.mDirections[2] = lPoint.mNormal.Cross(lContact.mDirections[1]);
+                lContact.mImpulses[0] = lPoint.mNormalImpulse;
+                lContact.mImpulses[1] = lPoint.mTangentImpulse1;
+                lContact.mImpulses[2] = lPoint.mTangentImpulse2;
+
+                const Vector3f lLeverA = lPoint.mPosition - lBodyA.mPosition;
+                const Vector3f lLeverB = lPoint.mPosition - lBodyB.mPosition;
+                for (std::size_t lRow = 0; lRow < 3; ++lRow)
+                {
+                    const Vector3f& lDirection = lContact.mDirections[lRow];
+                    lContact.mAngularA[lRow] = lLeverA.Cross(lDirection);
+                    lContact.mAngularB[lRow] = lLeverB.Cross(lDirection);
+                    lContact.mTurnA[lRow] = lBodyA.mInverseInertia * lContact.mAngularA[lRow];
+                    lContact.mTurnB[lRow] = lBodyB.mInverseInertia * lContact.mAngularB[lRow];
+
+                    const float lK =
+                        lBodyA.mInverseMass + lBodyB.mInverseMass +
+                        lContact.mAngularA[lRow].Dot(lContact.mTurnA[lRow]) +
+                        lContact.mAngularB[lRow].Dot(lContact.mTurnB[lRow]);
+                    lContact.mMasses[lRow] = (lK > 0.0f) ? 1.0f / lK : 0.0f;
+                }
+
+                // Push out penetration beyond the slop, let points which are
+                // still apart close the gap within the step, and bounce
+                // contacts which close fast enough.
+                const float lClosing =
+                    lPoint.mNormal.Dot(lGetVelocity(lSlotB, 0) - lGetVelocity(lSlotA, 0)) +
+                    lContact.mAngularB[0].Dot(lGetVelocity(lSlotB, 3)) -
+                    lContact.mAngularA[0].Dot(lGetVelocity(lSlotA, 3));
+                lContact.mBias = (lPoint.mDepth < 0.0f) ?
+                    lPoint.mDepth * lInverseDeltaTime :
+                    mSpec.mBaumgarte * lInverseDeltaTime * std::max(lPoint.mDepth - mSpec.mLinearSlop, 0.0f);
+                if (lClosing < -mSpec.mRestitutionThreshold)
+                {
+                    lContact.mBias = std::max(lContact.mBias, -lRestitution * lClosing);
+                }
+
+                for (std::size_t lRow = 0; lRow < 3; ++lRow)
+                {
+                    const float lImpulse = lContact.mImpulses[lRow];
+                    if (lSlotA != 0)
+                    {
+                        lAddVelocity(lSlotA, 0, lContact.mDirections[lRow] * (-lImpulse * lContact.mInverseMassA));
+                        lAddVelocity(lSlotA, 3, lContact.mTurnA[lRow] * -lImpulse);
+                    }
+
+                    if (lSlotB != 0)
+                    {
+                        lAddVelocity(lSlotB, 0, lContact.mDirections[lRow] * (lImpulse * lContact.mInverseMassB));
+                        lAddVelocity(lSlotB, 3, lContact.mTurnB[lRow] * lImpulse);
+                    }
+                }
+            }
+        }
+
+        // Colour the manifolds greedily, in order, so that no two manifolds
+        // of a colour share a dynamic body. Manifolds which find no free
+        // colour among the first 64 are solved on their own.
+        const std::size_t lManifoldCount = lScratch.mManifolds.size();
+        lScratch.mColorMasks.assign(lBodyCount + 1, 0);
+        lScratch.mColors.resize(lManifoldCount);
+        std::uint8_t lColorCount = 0;
+        for (std::size_t i = 0; i < lManifoldCount; ++i)
+        {
+            const SolverManifold& lManifold = lScratch.mManifolds[i];
+            const std::uint64_t lUsed =
+                ((lManifold.mBodyA != 0) ? lScratch.mColorMasks[lManifold.mBodyA] : 0) |
+                ((lManifold.mBodyB != 0) ? lScratch.mColorMasks[lManifold.mBodyB] : 0);
+            if (lUsed == ~std::uint64_t { 0 })
+            {
+                lScratch.mColors[i] = OVERFLOW_COLOR;
+                continue;
+            }
+
+            const std::uint8_t lColor = static_cast<std::uint8_t>(std::countr_one(lUsed));
+            lScratch.mColors[i] = lColor;
+            lScratch.mColorMasks[lManifold.mBodyA] |= std::uint64_t { 1 } << lColor;
+            lScratch.mColorMasks[lManifold.mBodyB] |= std::uint64_t { 1 } << lColor;
+            lColorCount = std::max<std::uint8_t>(lColorCount, lColor + 1);
+        }
+
+        // Pack each colour's manifolds into batches of four, in order, each
+        // batch followed by its points, lane by lane.
+        lScratch.mBatches.clear();
+        lScratch.mPoints.clear();
+        std::array<std::size_t, 4> lLaneManifolds {};
+        std::size_t lLaneCount = 0;
+        auto lFlushBatch =
+            [&] () -> void
+            {
+                if (lLaneCount == 0)
+                {
+                    return;
+                }
+
+                ContactBatch& lBatch = lScratch.mBatches.emplace_back();
+                lBatch.mFirstPoint = lScratch.mPoints.size();
+                for (std::size_t lLane = 0; lLane < 4; ++lLane)
+                {
+                    const SolverManifold* lManifold = (lLane < lLaneCount) ?
+                        &lScratch.mManifolds[lLaneManifolds[lLane]] : nullptr;
+                    const SolverContact* lFirst = (lManifold != nullptr) ?
+                        &lScratch.mContacts[lManifold->mFirstContact] : nullptr;
+                    lBatch.mBodyA[lLane] = (lManifold != nullptr) ? lManifold->mBodyA : 0;
+                    lBatch.mBodyB[lLane] = (lManifold != nullptr) ? lManifold->mBodyB : 0;
+                    lBatch.mInverseMassA[lLane] = (lFirst != nullptr) ? lFirst->mInverseMassA : 0.0f;
+                    lBatch.mInverseMassB[lLane] = (lFirst != nullptr) ? lFirst->mInverseMassB : 0.0f;
+                    lBatch.mFriction[lLane] = (lFirst != nullptr) ? lFirst->mFriction : 0.0f;
+                    if (lManifold != nullptr)
+                    {
+                        lBatch.mPointCount = std::max<std::size_t>(lBatch.mPointCount, lManifold->mContactCount);
+                    }
+                }
+
+                for (std::size_t lPoint = 0; lPoint < lBatch.mPointCount; ++lPoint)
+                {
+                    ContactLanes& lLanes = lScratch.mPoints.emplace_back();
+                    for (std::size_t lLane = 0; lLane < 4; ++lLane)
+                    {
+                        const SolverManifold* lManifold = (lLane < lLaneCount) ?
+                            &lScratch.mManifolds[lLaneManifolds[lLane]] : nullptr;
+                        const bool lUsed = lManifold != nullptr && lPoint < lManifold->mContactCount;
+                        const std::uint32_t lIndex = lUsed == true ?
+                            lManifold->mFirstContact + static_cast<std::uint32_t>(lPoint) : 0;
+                        PackLane(lLanes, lLane, lUsed == true ? &lScratch.mContacts[lIndex] : nullptr, lIndex);
+                    }
+                }
+
+                lLaneCount = 0;
+            };
+
+        for (std::uint8_t lColor = 0; lColor <= OVERFLOW_COLOR; ++lColor)
+        {
+            if (lColor == lColorCount)
+            {
+                lColor = OVERFLOW_COLOR;
+            }
+
+            for (std::size_t i = 0; i < lManifoldCount; ++i)
+            {
+                if (lScratch.mColors[i] == lColor)
+                {
+                    lLaneManifolds[lLaneCount++] = i;
+                    if (lLaneCount == 4 || lColor == OVERFLOW_COLOR)
+                    {
+                        lFlushBatch();
+                    }
+                }
+            }
+
+            lFlushBatch();
+        }
+
+        for (std::size_t lIteration = 0; lIteration < mSpec.mVelocityIterations; ++lIteration)
+        {
+            for (const ContactBatch& lBatch : lScratch.mBatches)
+            {
+                SolveBatch(lBatch, lScratch.mPoints.data(), lVelocity);
+            }
+        }
+
+        // Keep the final impulses for the next step's warm start.
+        for (const ContactLanes& lLanes : lScratch.mPoints)
+        {
+            for (std::size_t lLane = 0; lLane < 4; ++lLane)
+            {
+                if (lLanes.mContacts[lLane] == UNUSED_LANE)
+                {
+                    continue;
+                }
+
+                const SolverContact& lContact = lScratch.mContacts[lLanes.mContacts[lLane]];
+                ContactPoint& lPoint = mManifolds[lContact.mManifold].mPoints[lContact.mPoint];
+                lPoint.mNormalImpulse = lLanes.mImpulse[0][lLane];
+                lPoint.mTangentImpulse1 = lLanes.mImpulse[1][lLane];
+                lPoint.mTangentImpulse2 = lLanes.mImpulse[2][lLane];
+            }
+        }
+
+        // Integrate the bodies, and let the island fall asleep once every one
+        // of its bodies has been slow for long enough.
+        const float lSleepLinear = mSpec.mSleepLinearSpeed * mSpec.mSleepLinearSpeed;
+        const float lSleepAngular = mSpec.mSleepAngularSpeed * mSpec.mSleepAngularSpeed;
+        float lMinSlowTime = std::numeric_limits<float>::max();
+        for (std::size_t i = 0; i < lBodyCount; ++i)
+        {
+            Body& lBody = mBodies[mIslandBodies[pIsland.mBodyBegin + i]];
+            lBody.mLinearVelocity = lGetVelocity(static_cast<std::uint32_t>(i + 1), 0);
+            lBody.mAngularVelocity = lGetVelocity(static_cast<std::uint32_t>(i + 1), 3);
+            lBody.mPosition += lBody.mLinearVelocity * pDeltaTime;
+
+            const Vector3f& lSpin = lBody.mAngularVelocity;
+            const Quaternion4f lTurn = Quaternion4f { lSpin.mX, lSpin.mY, lSpin.mZ, 0.0f } * lBody.mOrientation;
+            lBody.mOrientation.mX += 0.5f * pDeltaTime * lTurn.mX;
+            lBody.mOrientation.mY += 0.5f * pDeltaTime * lTurn.mY;
+            lBody.mOrientation.mZ += 0.5f * pDeltaTime * lTurn.mZ;
+            lBody.mOrientation.mW += 0.5f * pDeltaTime * lTurn.mW;
+            lBody.mOrientation.Normalize();
+            UpdateDerived(lBody);
+
+            if (
+                lBody.mLinearVelocity.LengthSquared() < lSleepLinear &&
+                lBody.mAngularVelocity.LengthSquared() < lSleepAngular
+            )
+            {
+                lBody.mSlowTime += pDeltaTime;
+            }
+            else
+            {
+                lBody.mSlowTime = 0.0f;
+            }
+
+            lMinSlowTime = std::min(lMinSlowTime, lBody.mSlowTime);
+        }
+
+        if (lMinSlowTime >= mSpec.mSleepTime)
+        {
+            for (std::size_t i = 0; i < lBodyCount; ++i)
+            {
+                Body& lBody = mBodies[mIslandBodies[pIsland.mBodyBegin + i]];
+                lBody.mLinearVelocity = {};
+                lBody.mAngularVelocity = {};
+                lBody.mAwake = false;
+            }
+        }
+
+        return { lScratch.mBatches.size(), lColorCount };
+    }
+
+}
@@ -0,0 +1,401 @@
+/**
+ * @file    Ace/Physics/PhysicsWorld.hpp
+ * @brief   Provides a class used for simulating rigid bodies.
+ */
+
+#pragma once
+#include <unordered_map>
+#include <Ace/Maths/Quaternion4.hpp>
+#include <Ace/Physics/DynamicAABBTree.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   The handle of a rigid body in a @a `PhysicsWorld`.
+     */
+    using BodyId = std::uint32_t;
+
+    /**
+     * @brief   The handle which never refers to a body.
+     */
+    constexpr BodyId INVALID_BODY = std::numeric_limits<BodyId>::max();
+
+    /**
+     * @brief   Enumerates the shapes a rigid body can have.
+     */
+    enum class BodyShape : std::uint8_t
+    {
+        Sphere,     ///< @brief A sphere, whose radius is the X component of the half extents.
+        Box         ///< @brief A box, with the given half extents along its local axes.
+    };
+
+    /**
+     * @brief   A structure describing a rigid body to be created.
+     */
+    struct RigidBodyDesc
+    {
+        BodyShape       mShape = BodyShape::Box;                    ///< @brief The body's shape.
+        Vector3f        mHalfExtents { 0.5f, 0.5f, 0.5f };          ///< @brief The box's half extents, or the sphere's radius in X.
+        float           mMass = 1.0f;                               ///< @brief The body's mass, or zero for a static body.
+        Vector3f        mPosition;                                  ///< @brief The position of the body's centre.
+        Quaternion4f    mOrientation;                               ///< @brief The body's orientation.
+        Vector3f        mLinearVelocity;                            ///< @brief The body's initial linear velocity.
+        Vector3f        mAngularVelocity;                           ///< @brief The body's initial angular velocity, in radians per second.
+        float           mFriction = 0.5f;                           ///< @brief The body's coefficient of friction.
+        float           mRestitution = 0.0f;                        ///< @brief The body's bounciness, from zero to one.
+    };
+
+    /**
+     * @brief   A structure containing the settings a @a `PhysicsWorld` is
+     *          created with.
+     */
+    struct PhysicsWorldSpec
+    {
+        ThreadPool*     mThreadPool = nullptr;                      ///< @brief The thread pool to step on, or `nullptr` to step on the calling thread.
+        Vector3f        mGravity { 0.0f, -9.81f, 0.0f };            ///< @brief The acceleration applied to every dynamic body.
+        std::size_t     mVelocityIterations = 8;                    ///< @brief The number of passes the solver makes over the contacts each step.
+        float           mBaumgarte = 0.2f;                          ///< @brief The fraction of the penetration corrected each step.
+        float           mLinearSlop = 0.01f;                        ///< @brief The penetration allowed before it is corrected.
+        float           mRestitutionThreshold = 1.0f;               ///< @brief The closing speed below which contacts do not bounce.
+        float           mSleepLinearSpeed = 0.05f;                  ///< @brief The linear speed below which a body may fall asleep.
+        float           mSleepAngularSpeed = 0.05f;                 ///< @brief The angular speed below which a body may fall asleep.
+        float           mSleepTime = 0.5f;                          ///< @brief The time an island must stay slow before it falls asleep.
+    };
+
+    /**
+     * @brief   A structure containing counts gathered by the last step of a
+     *          @a `PhysicsWorld`.
+     */
+    struct PhysicsStepStats
+    {
+        std::size_t     mPairCount = 0;         ///< @brief The number of pairs found by the broadphase.
+        std::size_t     mContactCount = 0;      ///< @brief The number of contact points solved.
+        std::size_t     mIslandCount = 0;       ///< @brief The number of awake islands solved.
+        std::size_t     mAwakeBodyCount = 0;    ///< @brief The number of dynamic bodies awake after the step.
+        std::size_t     mBatchCount = 0;        ///< @brief The number of four-wide manifold batches solved per iteration.
+        std::size_t     mColorCount = 0;        ///< @brief The largest number of colours any island's manifolds needed.
+    };
+
+    /**
+     * @brief   A class used for simulating rigid spheres and boxes, colliding
+     *          with each other and resting in stacks.
+     *
+     * Each step integrates gravity, finds the pairs of bodies whose boxes
+     * overlap with a @a `DynamicAABBTree`, and generates contact points for
+     * each pair. Bodies which touch, directly or through others, are grouped
+     * into islands, and each island is solved on its own, so islands are
+     * spread across the thread pool.
+     *
+     * Contacts are solved by sequential impulses, warm started with the
+     * impulses the same contact points ended the previous step with, and
+     * with penetration pushed out by a Baumgarte bias. Within an island, the
+     * manifolds are coloured so that no two manifolds of the same colour
+     * share a dynamic body, and each colour is solved in batches of four
+     * manifolds at once, point by point, with SSE2 where available.
+     * Manifolds of the same colour are independent, so solving them together
+     * gives the same result as solving them one after another.
+     *
+     * An island whose bodies all stay slow for long enough falls asleep, and
+     * costs nothing until an awake body touches it.
+     *
+     * Stepping is deterministic: every stage either runs on one thread, or
+     * writes its results to separate places which are then combined in a
+     * fixed order. The same sequence of calls produces the same bodies, bit
+     * for bit, whatever the number of threads.
+     */
+    class ACE_API PhysicsWorld final
+    {
+    public:
+
+        /**
+         * @brief   The largest number of contact points kept between two
+         *          bodies.
+         */
+        static constexpr std::size_t MAX_MANIFOLD_POINTS = 8;
+
+    public:
+
+        /**
+         * @brief   Creates an empty world.
+         *
+         * @param   pSpec   The world's settings. @a `Step` must not be called
+         *                  from one of the thread pool's own workers.
+         */
+        explicit PhysicsWorld (
+            const PhysicsWorldSpec& pSpec = {}
+        );
+
+    public:
+
+        /**
+         * @brief   Adds a body to the world.
+         *
+         * @param   pDesc   The body's description.
+         *
+         * @return  The new body's handle.
+         */
+        BodyId CreateBody (
+            const RigidBodyDesc&    pDesc
+        );
+
+        /**
+         * @brief   Removes a body from the world, waking any island it
+         *          touched. Its handle may be given to a later body.
+         *
+         * @param   pBody   The body's handle.
+         */
+        void DestroyBody (
+            const BodyId    pBody
+        );
+
+        /**
+         * @brief   Advances the simulation.
+         *
+         * @param   pDeltaTime  The time to advance by, in seconds. Steps of a
+         *                      fixed length give the most stable results.
+         */
+        void Step (
+            const float pDeltaTime
+        );
+
+        /**
+         * @brief   Sets a body's velocities, waking it.
+         *
+         * @param   pBody               The body's handle.
+         * @param   pLinearVelocity     The body's new linear velocity.
+         * @param   pAngularVelocity    The body's new angular velocity.
+         */
+        void SetVelocity (
+            const BodyId        pBody,
+            const Vector3f&     pLinearVelocity,
+            const Vector3f&     pAngularVelocity
+        );
+
+        /**
+         * @brief   Retrieves a body's position.
+         *
+         * @param   pBody   The body's handle.
+         *
+         * @return  The position of the body's centre.
+         */
+        const Vector3f& GetPosition (
+            const BodyId    pBody
+        ) const;
+
+        /**
+         * @brief   Retrieves a body's orientation.
+         *
+         * @param   pBody   The body's handle.
+         *
+         * @return  The body's orientation.
+         */
+        const Quaternion4f& GetOrientation (
+            const BodyId    pBody
+        ) const;
+
+        /**
+         * @brief   Retrieves a body's linear velocity.
+         *
+         * @param   pBody   The body's handle.
+         *
+         * @return  The body's linear velocity.
+         */
+        const Vector3f& GetLinearVelocity (
+            const BodyId    pBody
+        ) const;
+
+        /**
+         * @brief   Retrieves a body's angular velocity.
+         *
+         * @param   pBody   The body's handle.
+         *
+         * @return  The body's angular velocity.
+         */
+        const Vector3f& GetAngularVelocity (
+            const BodyId    pBody
+        ) const;
+
+        /**
+         * @brief   Retrieves whether or not a body is awake. Static bodies
+         *          are never awake.
+         *
+         * @param   pBody   The body's handle.
+         *
+         * @return  `true` if the body is simulated; `false` if it sleeps or
+         *          is static.
+         */
+        bool IsAwake (
+            const BodyId    pBody
+        ) const;
+
+        /**
+         * @brief   Retrieves the number of bodies in the world.
+         *
+         * @return  The number of bodies.
+         */
+        inline std::size_t GetBodyCount () const
+        {
+            return mBodyCount;
+        }
+
+        /**
+         * @brief   Retrieves the counts gathered by the last step.
+         *
+         * @return  The last step's counts.
+         */
+        inline const PhysicsStepStats& GetLastStepStats () const
+        {
+            return mStats;
+        }
+
+    private:
+        PhysicsWorld (const PhysicsWorld&) = delete;
+        PhysicsWorld (PhysicsWorld&&) = delete;
+        void operator= (const PhysicsWorld&) = delete;
+        void operator= (PhysicsWorld&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one rigid body's state.
+         */
+        struct Body
+        {
+            Vector3f        mPosition;                      ///< @brief The position of the body's centre.
+            Quaternion4f    mOrientation;                   ///< @brief The body's orientation.
+            Matrix3f        mRotation;                      ///< @brief The body's orientation, as a matrix.
+            Vector3f        mLinearVelocity;                ///< @brief The body's linear velocity.
+            Vector3f        mAngularVelocity;               ///< @brief The body's angular velocity.
+            Vector3f        mHalfExtents;                   ///< @brief The box's half extents, or the sphere's radius in X.
+            Vector3f        mLocalInverseInertia;           ///< @brief The inverse of the body's inertia about its local axes.
+            Matrix3f        mInverseInertia;                ///< @brief The inverse of the body's inertia tensor, in world space.
+            float           mInverseMass = 0.0f;            ///< @brief The inverse of the body's mass, or zero if static.
+            float           mFriction = 0.0f;               ///< @brief The body's coefficient of friction.
+            float           mRestitution = 0.0f;            ///< @brief The body's bounciness.
+            float           mSlowTime = 0.0f;               ///< @brief How long the body has stayed slow enough to sleep.
+            ProxyId         mProxy = INVALID_PROXY;         ///< @brief The body's proxy in the broadphase.
+            BodyShape       mShape = BodyShape::Box;        ///< @brief The body's shape.
+            bool            mAlive = false;                 ///< @brief Is this handle in use?
+            bool            mAwake = false;                 ///< @brief Is the body simulated? Always `false` for static bodies.
+        };
+
+        /**
+         * @brief   A structure containing one point of contact between two
+         *          bodies.
+         */
+        struct ContactPoint
+        {
+            Vector3f        mPosition;                      ///< @brief The point, in world space.
+            Vector3f        mNormal;                        ///< @brief The direction the second body is pushed away from the first.
+            float           mDepth = 0.0f;                  ///< @brief How far the bodies overlap along the normal.
+            std::uint32_t   mFeature = 0;                   ///< @brief Identifies the point from one step to the next.
+            float           mNormalImpulse = 0.0f;          ///< @brief The impulse applied along the normal.
+            float           mTangentImpulse1 = 0.0f;        ///< @brief The friction impulse applied along the first tangent.
+            float           mTangentImpulse2 = 0.0f;        ///< @brief The friction impulse applied along the second tangent.
+        };
+
+        /**
+         * @brief   A structure containing the contact points between two
+         *          bodies, the lower handle first.
+         */
+        struct Manifold
+        {
+            BodyId                                          mFirst = INVALID_BODY;  ///< @brief The first body.
+            BodyId                                          mSecond = INVALID_BODY; ///< @brief The second body.
+            std::uint32_t                                   mPointCount = 0;        ///< @brief The number of points in use.
+            std::array<ContactPoint, MAX_MANIFOLD_POINTS>   mPoints;                ///< @brief The contact points.
+        };
+
+    private:
+
+        /**
+         * @brief   A structure containing the bodies and manifolds of one
+         *          island, as ranges of the world's island lists.
+         */
+        struct Island
+        {
+            std::size_t     mBodyBegin = 0;         ///< @brief The first of the island's bodies in @a `mIslandBodies`.
+            std::size_t     mBodyEnd = 0;           ///< @brief One past the last of the island's bodies.
+            std::size_t     mManifoldBegin = 0;     ///< @brief The first of the island's manifolds in @a `mIslandManifolds`.
+            std::size_t     mManifoldEnd = 0;       ///< @brief One past the last of the island's manifolds.
+        };
+
+    private:
+
+        /**
+         * @brief   Updates a body's world-space rotation and inertia from its
+         *          orientation.
+         */
+        static void UpdateDerived (
+            Body&   pBody
+        );
+
+        /**
+         * @brief   Calculates the bounding box of a body.
+         */
+        static AABB3f ComputeBounds (
+            const Body& pBody
+        );
+
+        /**
+         * @brief   Generates the contact points between two bodies whose
+         *          bounding boxes overlap.
+         *
+         * @return  `true` if the bodies touch; `false` otherwise.
+         */
+        static bool CollideBodies (
+            const Body& pFirst,
+            const Body& pSecond,
+            Manifold&   pManifold
+        );
+
+        /**
+         * @brief   Finds the broadphase's pairs, and generates their contact
+         *          points, carrying over the impulses of points which match
+         *          the last step's.
+         */
+        void Collide ();
+
+        /**
+         * @brief   Groups the awake bodies, and those they touch, into
+         *          islands, waking sleeping bodies touched by awake ones.
+         */
+        void BuildIslands ();
+
+        /**
+         * @brief   Solves one island's contacts, integrates its bodies, and
+         *          puts it to sleep if it has stayed slow for long enough.
+         *
+         * @return  The number of batches solved per iteration, and the
+         *          number of colours used.
+         */
+        std::pair<std::size_t, std::size_t> SolveIsland (
+            const Island&   pIsland,
+            const float     pDeltaTime
+        );
+
+    private:
+        PhysicsWorldSpec                                mSpec;                  ///< @brief The world's settings.
+        DynamicAABBTree                                 mBroadphase;            ///< @brief The broadphase holding every body's proxy.
+        std::vector<Body>                               mBodies;                ///< @brief Every body, indexed by handle.
+        std::vector<BodyId>                             mFreeBodies;            ///< @brief Handles free to be given out again.
+        std::size_t                                     mBodyCount = 0;         ///< @brief The number of live bodies.
+
+        std::vector<ProxyPair>                          mPairs;                 ///< @brief The broadphase's pairs, this step.
+        std::vector<Manifold>                           mManifolds;             ///< @brief The contact manifolds, this step.
+        std::vector<std::vector<Manifold>>              mBatchManifolds;        ///< @brief The manifolds generated by each batch of pairs.
+        std::unordered_map<std::uint64_t, Manifold>     mLastManifolds;         ///< @brief The last step's manifolds, keyed by their bodies.
+
+        std::vector<std::uint32_t>                      mLocalIndices;          ///< @brief Each dynamic body's index within its island's solver arrays.
+        std::vector<BodyId>                             mIslandParents;         ///< @brief Each body's parent while grouping bodies into islands.
+        std::vector<BodyId>                             mIslandBodies;          ///< @brief The bodies of every island, island by island.
+        std::vector<std::size_t>                        mIslandManifolds;       ///< @brief The manifolds of every island, island by island.
+        std::vector<Island>                             mIslands;               ///< @brief The awake islands, this step.
+        std::vector<std::pair<std::size_t, std::size_t>> mIslandResults;   ///< @brief The batch and colour counts of each island.
+
+        PhysicsStepStats                                mStats;                 ///< @brief The counts gathered by the last step.
+
+    };
+
+}
@@ -0,0 +1,363 @@
+/**
+ * @file    Ace/Physics/SweepAndPrune.cpp
+ */
+
+#include <bit>
+#include <Ace/Physics/SweepAndPrune.hpp>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+#endif
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Makes the pair of two proxies, lower handle first.
+     */
+    static inline ProxyPair MakePair (
+        const ProxyId   pFirst,
+        const ProxyId   pSecond
+    )
+    {
+        return (pFirst < pSecond) ?
+            ProxyPair { pFirst, pSecond } :
+            ProxyPair { pSecond, pFirst };
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    SweepAndPrune::SweepAndPrune (
+        const BroadphaseSpec&   pSpec
+    ) :
+        mThreadPool { pSpec.mThreadPool },
+        mGrainSize  { std::max<std::size_t>(pSpec.mGrainSize, 1) }
+    {}
+
+    /* Public Methods *********************************************************/
+
+    ProxyId SweepAndPrune::CreateProxy (
+        const AABB3f&       pBounds,
+        const std::uint64_t pUserData
+    )
+    {
+        ProxyId lProxy = INVALID_PROXY;
+        if (mFreeProxies.empty() == false)
+        {
+            lProxy = mFreeProxies.back();
+            mFreeProxies.pop_back();
+        }
+        else
+        {
+            lProxy = static_cast<ProxyId>(mAlive.size());
+            for (std::size_t lAxis = 0; lAxis < 3; ++lAxis)
+            {
+                mMin[lAxis].push_back(0.0f);
+                mMax[lAxis].push_back(0.0f);
+            }
+
+            mUserData.push_back(0);
+            mAlive.push_back(0);
+        }
+
+        StoreBounds(lProxy, pBounds);
+        mUserData[lProxy] = pUserData;
+        mAlive[lProxy] = 1;
+        mOrder.push_back(lProxy);
+        ++mUnsorted;
+        ++mProxyCount;
+        return lProxy;
+    }
+
+    void SweepAndPrune::DestroyProxy (
+        const ProxyId   pProxy
+    )
+    {
+        if (pProxy >= mAlive.size() || mAlive[pProxy] == 0)
+        {
+            return;
+        }
+
+        // The handle stays in the sort order until the next sweep drops it,
+        // so it cannot be given out again before then.
+        mAlive[pProxy] = 0;
+        mDeadProxies.push_back(pProxy);
+        --mProxyCount;
+    }
+
+    void SweepAndPrune::MoveProxy (
+        const ProxyId       pProxy,
+        const AABB3f&       pBounds,
+        const Vector3f&     pDisplacement
+    )
+    {
+        (void) pDisplacement;
+        StoreBounds(pProxy, pBounds);
+    }
+
+    void SweepAndPrune::FindPairs (
+        std::vector<ProxyPair>& pPairs
+    )
+    {
+        pPairs.clear();
+        SortOrder();
+        GatherSorted();
+
+        const std::size_t lCount = mOrder.size();
+        const std::size_t lBatchCount = (lCount + mGrainSize - 1) / mGrainSize;
+        mBatchPairs.resize(lBatchCount);
+
+        auto lSweepBatch =
+            [this, lCount] (std::size_t pBatch) -> void
+            {
+                mBatchPairs[pBatch].clear();
+                Sweep(pBatch * mGrainSize, std::min(lCount, (pBatch + 1) * mGrainSize),
+                    mBatchPairs[pBatch]);
+            };
+
+        if (mThreadPool != nullptr && lBatchCount > 1)
+        {
+            mThreadPool->ParallelFor(lBatchCount, lSweepBatch);
+        }
+        else
+        {
+            for (std::size_t i = 0; i < lBatchCount; ++i)
+            {
+                lSweepBatch(i);
+            }
+        }
+
+        // Concatenating the batches in order keeps the pairs in the same
+        // order, however the batches were spread across the threads.
+        std::size_t lTotal = 0;
+        for (std::size_t i = 0; i < lBatchCount; ++i)
+        {
+            lTotal += mBatchPairs[i].size();
+        }
+
+        pPairs.reserve(lTotal);
+        for (std::size_t i = 0; i < lBatchCount; ++i)
+        {
+            pPairs.insert(pPairs.end(), mBatchPairs[i].begin(), mBatchPairs[i].end());
+        }
+    }
+
+    void SweepAndPrune::Query (
+        const AABB3f&           pBounds,
+        std::vector<ProxyId>&   pProxies
+    ) const
+    {
+        // The sorted arrays are only as fresh as the last sweep, so every
+        // proxy is tested against its current bounds.
+        for (std::size_t i = 0; i < mAlive.size(); ++i)
+        {
+            if (
+                mAlive[i] != 0 &&
+                mMin[0][i] <= pBounds.mMax.mX && mMax[0][i] >= pBounds.mMin.mX &&
+                mMin[1][i] <= pBounds.mMax.mY && mMax[1][i] >= pBounds.mMin.mY &&
+                mMin[2][i] <= pBounds.mMax.mZ && mMax[2][i] >= pBounds.mMin.mZ
+            )
+            {
+                pProxies.push_back(static_cast<ProxyId>(i));
+            }
+        }
+    }
+
+    std::uint64_t SweepAndPrune::GetUserData (
+        const ProxyId   pProxy
+    ) const
+    {
+        return mUserData[pProxy];
+    }
+
+    std::size_t SweepAndPrune::GetProxyCount () const
+    {
+        return mProxyCount;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void SweepAndPrune::StoreBounds (
+        const ProxyId   pProxy,
+        const AABB3f&   pBounds
+    )
+    {
+        mMin[0][pProxy] = pBounds.mMin.mX;
+        mMin[1][pProxy] = pBounds.mMin.mY;
+        mMin[2][pProxy] = pBounds.mMin.mZ;
+        mMax[0][pProxy] = pBounds.mMax.mX;
+        mMax[1][pProxy] = pBounds.mMax.mY;
+        mMax[2][pProxy] = pBounds.mMax.mZ;
+    }
+
+    void SweepAndPrune::SortOrder ()
+    {
+        if (mDeadProxies.empty() == false)
+        {
+            std::erase_if(mOrder,
+                [this] (ProxyId pProxy) -> bool
+                {
+                    return mAlive[pProxy] == 0;
+                });
+            mFreeProxies.insert(mFreeProxies.end(), mDeadProxies.begin(), mDeadProxies.end());
+            mDeadProxies.clear();
+        }
+
+        // Sort copies of the keys alongside the handles, so that the sort
+        // reads them in sequence. Ties are broken by handle, so that the
+        // order only depends on the bounds.
+        const std::vector<float>& lMin = mMin[mAxis];
+        mKeys.resize(mOrder.size());
+        for (std::size_t i = 0; i < mOrder.size(); ++i)
+        {
+            mKeys[i] = { lMin[mOrder[i]], mOrder[i] };
+        }
+
+        if (mAxis != mSortedAxis || mUnsorted > RESORT_THRESHOLD)
+        {
+            std::sort(mKeys.begin(), mKeys.end());
+        }
+        else
+        {
+            for (std::size_t i = 1; i < mKeys.size(); ++i)
+            {
+                const auto lKey = mKeys[i];
+                std::size_t j = i;
+                for (; j > 0 && lKey < mKeys[j - 1]; --j)
+                {
+                    mKeys[j] = mKeys[j - 1];
+                }
+
+                mKeys[j] = lKey;
+            }
+        }
+
+        for (std::size_t i = 0; i < mKeys.size(); ++i)
+        {
+            mOrder[i] = mKeys[i].second;
+        }
+
+        mSortedAxis = mAxis;
+        mUnsorted = 0;
+    }
+
+    void SweepAndPrune::GatherSorted ()
+    {
+        const std::size_t lCount = mOrder.size();
+        const std::array<std::size_t, 3> lAxes {
+            mSortedAxis,
+            (mSortedAxis + 1) % 3,
+            (mSortedAxis + 2) % 3
+        };
+
+        std::array<double, 3> lSum {};
+        std::array<double, 3> lSumSquared {};
+        for (std::size_t lSlot = 0; lSlot < 3; ++lSlot)
+        {
+            const std::vector<float>& lMin = mMin[lAxes[lSlot]];
+            const std::vector<float>& lMax = mMax[lAxes[lSlot]];
+            mSortedMin[lSlot].resize(lCount);
+            mSortedMax[lSlot].resize(lCount);
+            for (std::size_t i = 0; i < lCount; ++i)
+            {
+                const ProxyId lProxy = mOrder[i];
+                mSortedMin[lSlot][i] = lMin[lProxy];
+                mSortedMax[lSlot][i] = lMax[lProxy];
+
+                const double lCentre = 0.5 * (double(lMin[lProxy]) + double(lMax[lProxy]));
+                lSum[lAxes[lSlot]] += lCentre;
+                lSumSquared[lAxes[lSlot]] += lCentre * lCentre;
+            }
+        }
+
+        // Sweep along the axis the centres are most spread out on next time.
+        // Sums are taken per axis, in order, so the choice is deterministic.
+        double lBestVariance = -1.0;
+        for (std::size_t lAxis = 0; lAxis < 3 && lCount > 0; ++lAxis)
+        {
+            const double lMean = lSum[lAxis] / double(lCount);
+            const double lVariance = lSumSquared[lAxis] / double(lCount) - lMean * lMean;
+            if (lVariance > lBestVariance)
+            {
+                lBestVariance = lVariance;
+                mAxis = lAxis;
+            }
+        }
+    }
+
+    void SweepAndPrune::Sweep (
+        const std::size_t       pBegin,
+        const std::size_t       pEnd,
+        std::vector<ProxyPair>& pPairs
+    ) const
+    {
+        const std::size_t lCount = mOrder.size();
+        const float* lMin0 = mSortedMin[0].data();
+        const float* lMin1 = mSortedMin[1].data();
+        const float* lMin2 = mSortedMin[2].data();
+        const float* lMax0 = mSortedMax[0].data();
+        const float* lMax1 = mSortedMax[1].data();
+        const float* lMax2 = mSortedMax[2].data();
+
+        for (std::size_t i = pBegin; i < pEnd; ++i)
+        {
+            // Every box after this one starts no earlier along the sweep axis,
+            // so they overlap it along that axis until one starts after it
+            // ends.
+            std::size_t j = i + 1;
+            bool lEnded = false;
+
+            #if defined(__SSE2__)
+                const __m128 lEnd0 = _mm_set1_ps(lMax0[i]);
+                const __m128 lStart1 = _mm_set1_ps(lMin1[i]);
+                const __m128 lEnd1 = _mm_set1_ps(lMax1[i]);
+                const __m128 lStart2 = _mm_set1_ps(lMin2[i]);
+                const __m128 lEnd2 = _mm_set1_ps(lMax2[i]);
+                for (; j + 4 <= lCount; j += 4)
+                {
+                    const __m128 lInRange = _mm_cmple_ps(_mm_loadu_ps(lMin0 + j), lEnd0);
+                    const int lInRangeMask = _mm_movemask_ps(lInRange);
+                    if (lInRangeMask == 0)
+                    {
+                        lEnded = true;
+                        break;
+                    }
+
+                    __m128 lOverlap = _mm_and_ps(lInRange, _mm_and_ps(
+                        _mm_cmple_ps(_mm_loadu_ps(lMin1 + j), lEnd1),
+                        _mm_cmpge_ps(_mm_loadu_ps(lMax1 + j), lStart1)));
+                    lOverlap = _mm_and_ps(lOverlap, _mm_and_ps(
+                        _mm_cmple_ps(_mm_loadu_ps(lMin2 + j), lEnd2),
+                        _mm_cmpge_ps(_mm_loadu_ps(lMax2 + j), lStart2)));
+
+                    for (int lMask = _mm_movemask_ps(lOverlap); lMask != 0; lMask &= lMask - 1)
+                    {
+                        pPairs.push_back(MakePair(mOrder[i], mOrder[j + std::countr_zero(unsigned(lMask))]));
+                    }
+
+                    // The lanes are in sorted order, so once one is out of
+                    // range, so is every box after it.
+                    if (lInRangeMask != 0xF)
+                    {
+                        lEnded = true;
+                        break;
+                    }
+                }
+            #endif
+
+            for (; lEnded == false && j < lCount && lMin0[j] <= lMax0[i]; ++j)
+            {
+                if (
+                    lMin1[j] <= lMax1[i] && lMax1[j] >= lMin1[i] &&
+                    lMin2[j] <= lMax2[i] && lMax2[j] >= lMin2[i]
+                )
+                {
+                    pPairs.push_back(MakePair(mOrder[i], mOrder[j]));
+                }
+            }
+        }
+    }
+
+}
@@ -0,0 +1,159 @@
+/**
+ * @file    Ace/Physics/SweepAndPrune.hpp
+ * @brief   Provides a broadphase which sorts boxes along one axis, then
+ *          sweeps along it for overlaps.
+ */
+
+#pragma once
+#include <Ace/Physics/IBroadphase.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A broadphase which finds overlapping pairs by sorting boxes by
+     *          their lower bound along one axis, then sweeping along it: each
+     *          box only needs testing against those which start before it
+     *          ends.
+     *
+     * The boxes' bounds are kept in separate arrays, one per bound and axis,
+     * rather than as an array of boxes. The sort order is kept between calls
+     * to @a `FindPairs`, and bodies only move a little each step, so it is
+     * restored with an insertion sort in close to linear time; only when
+     * many proxies have been added since, or the sweep axis changes, is it
+     * sorted afresh. The axis is the one along which the boxes' centres were
+     * most spread out at the previous call, which keeps the number of boxes
+     * each sweep passes over down.
+     *
+     * Before sweeping, the bounds are gathered into sorted order, so that the
+     * sweep reads them in sequence, and tested against four boxes at a time
+     * with SSE2 where available. The sorted boxes are split into batches,
+     * each swept on its own task, and the batches' pairs concatenated in
+     * order afterwards.
+     *
+     * Boxes are tested exactly; no fattening is done.
+     */
+    class ACE_API SweepAndPrune final : public IBroadphase
+    {
+    public:
+
+        /**
+         * @brief   The number of proxies which may be added between sweeps
+         *          before the order is sorted afresh, rather than restored by
+         *          insertion.
+         */
+        static constexpr std::size_t RESORT_THRESHOLD = 64;
+
+    public:
+
+        /**
+         * @brief   Creates an empty broadphase.
+         *
+         * @param   pSpec   The broadphase's settings. Only the thread pool and
+         *                  grain size are used. @a `FindPairs` must not be
+         *                  called from one of the thread pool's own workers.
+         */
+        explicit SweepAndPrune (
+            const BroadphaseSpec&   pSpec = {}
+        );
+
+    public:
+
+        ProxyId CreateProxy (
+            const AABB3f&       pBounds,
+            const std::uint64_t pUserData
+        ) override;
+
+        void DestroyProxy (
+            const ProxyId   pProxy
+        ) override;
+
+        void MoveProxy (
+            const ProxyId       pProxy,
+            const AABB3f&       pBounds,
+            const Vector3f&     pDisplacement
+        ) override;
+
+        void FindPairs (
+            std::vector<ProxyPair>& pPairs
+        ) override;
+
+        void Query (
+            const AABB3f&           pBounds,
+            std::vector<ProxyId>&   pProxies
+        ) const override;
+
+        std::uint64_t GetUserData (
+            const ProxyId   pProxy
+        ) const override;
+
+        std::size_t GetProxyCount () const override;
+
+        /**
+         * @brief   Retrieves the axis the last sweep was made along.
+         *
+         * @return  `0`, `1` or `2`, for the X, Y and Z axes.
+         */
+        inline std::size_t GetSweepAxis () const
+        {
+            return mSortedAxis;
+        }
+
+    private:
+
+        /**
+         * @brief   Sets a proxy's bounds in the per-axis arrays.
+         */
+        void StoreBounds (
+            const ProxyId   pProxy,
+            const AABB3f&   pBounds
+        );
+
+        /**
+         * @brief   Drops destroyed proxies from the sort order, then restores
+         *          the order along the sweep axis.
+         */
+        void SortOrder ();
+
+        /**
+         * @brief   Gathers the bounds into sorted order, with the sweep axis
+         *          first, and picks the next sweep axis from the spread of
+         *          the boxes' centres.
+         */
+        void GatherSorted ();
+
+        /**
+         * @brief   Sweeps the sorted boxes in the range `[pBegin, pEnd)`
+         *          against every box after them, appending the pairs found.
+         */
+        void Sweep (
+            const std::size_t       pBegin,
+            const std::size_t       pEnd,
+            std::vector<ProxyPair>& pPairs
+        ) const;
+
+    private:
+        ThreadPool*                         mThreadPool = nullptr;  ///< @brief The thread pool pairs are found on, if any.
+        std::size_t                         mGrainSize = 0;         ///< @brief The number of sorted boxes swept by each task.
+
+        std::array<std::vector<float>, 3>   mMin;                   ///< @brief Each proxy's lower bound, per axis.
+        std::array<std::vector<float>, 3>   mMax;                   ///< @brief Each proxy's upper bound, per axis.
+        std::vector<std::uint64_t>          mUserData;              ///< @brief Each proxy's user data.
+        std::vector<std::uint8_t>           mAlive;                 ///< @brief Is each handle in use?
+        std::vector<ProxyId>                mFreeProxies;           ///< @brief Handles free to be given out again.
+        std::vector<ProxyId>                mDeadProxies;           ///< @brief Handles destroyed since the last sweep, still in the sort order.
+        std::size_t                         mProxyCount = 0;        ///< @brief The number of live proxies.
+
+        std::vector<ProxyId>                mOrder;                 ///< @brief The handles, sorted by lower bound along the sweep axis as of the last sweep.
+        std::size_t                         mUnsorted = 0;          ///< @brief The number of handles appended to the order since the last sweep.
+        std::size_t                         mAxis = 0;              ///< @brief The axis the next sweep is made along.
+        std::size_t                         mSortedAxis = 0;        ///< @brief The axis the order was last sorted along.
+
+        std::vector<std::pair<float, ProxyId>>  mKeys;              ///< @brief Scratch space for sorting the order by key.
+        std::array<std::vector<float>, 3>   mSortedMin;             ///< @brief The lower bounds in sorted order, sweep axis first.
+        std::array<std::vector<float>, 3>   mSortedMax;             ///< @brief The upper bounds in sorted order, sweep axis first.
+        std::vector<std::vector<ProxyPair>> mBatchPairs;            ///< @brief The pairs found by each batch of the last sweep.
+
+    };
+
+}
@@ -0,0 +1,583 @@
+/**
+ * @file    Ace/Scene/WorldStreamer.hpp
+ * @brief   Provides a class used for streaming a level's spatial cells in and
+ *          out of memory around a set of focus points.
+ */
+
+#pragma once
+#include <Ace/Maths/AABB3.hpp>
+#include <Ace/System/AssetRegistry.hpp>
+#include <Ace/System/EventBus.hpp>
+#include <Ace/System/Logger.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the means by which a cell's residency can change to
+     *          emit a @a `CellStreamedEvent`.
+     */
+    enum class CellStreamMethod
+    {
+        StreamedIn,
+        StreamedOut
+    };
+
+    /**
+     * @brief   An event structure which is emitted when a @a `WorldStreamer`
+     *          finishes streaming a cell in, or releases a resident cell.
+     */
+    struct CellStreamedEvent
+    {
+        Vector3i            mCoord;         ///< @brief The grid coordinate of the cell which was streamed.
+        std::string         mLogicalPath;   ///< @brief The logical path of the cell's asset.
+        CellStreamMethod    mMethod;        ///< @brief The method by which the cell was streamed.
+    };
+
+    /**
+     * @brief   A structure containing attributes which define a world streamer
+     *          and its streaming behaviour.
+     */
+    struct WorldStreamerSpec
+    {
+        float       mCellSize       = 64.0f;                ///< @brief The length of each side of a grid cell, in world units.
+        float       mLoadRadius     = 128.0f;               ///< @brief Cells closer than this to a focus point are streamed in.
+        float       mUnloadRadius   = 192.0f;               ///< @brief Cells farther than this from every focus point are streamed out. Must not be less than @a `mLoadRadius`.
+        std::size_t mMemoryBudget   = 256 * 1024 * 1024;    ///< @brief The maximum number of bytes which may be resident or in flight at once.
+        std::size_t mMaxInFlight    = 4;                    ///< @brief The maximum number of cell loads which may be in flight at once.
+        std::size_t mRetryDelay     = 30;                   ///< @brief The number of updates to wait before retrying a cell whose load failed; doubled for each further failure in a row.
+        std::size_t mMaxRetryDelay  = 1800;                 ///< @brief The most updates a failed cell is ever made to wait.
+    };
+
+    /**
+     * @brief   A class used for streaming a level's spatial cells, each of
+     *          which is an asset of type `T`, in and out of memory around a
+     *          set of focus points, such as cameras or players.
+     *
+     * The level is split into a uniform grid of cubic cells. Each frame,
+     * @a `Update` issues asynchronous loads through
+     * @a `AssetRegistry::LoadAsync` for the cells nearest to the focus points
+     * first, keeping the bytes resident and in flight under a memory budget.
+     * Cells are only released once they lie beyond the unload radius, which
+     * is larger than the load radius, so that a focus point moving back and
+     * forth across a cell boundary does not cause that cell to thrash.
+     *
+     * A cell whose load fails is returned to the unloaded state, but is not
+     * tried again for @a `WorldStreamerSpec::mRetryDelay` updates, a delay
+     * which doubles with each failure in a row, up to
+     * @a `WorldStreamerSpec::mMaxRetryDelay`. A transient failure, such as
+     * an archive being mounted late, therefore heals by itself, while a cell
+     * which never loads costs little.
+     *
+     * @tparam  T   The type of asset each cell is loaded as.
+     *
+     * @note    A world streamer is not thread-safe. It is intended to be
+     *          owned and updated by the game thread.
+     */
+    template <typename T>
+    class WorldStreamer final
+    {
+    public:
+
+        /**
+         * @brief   The default constructor constructs a world streamer with
+         *          the given specification.
+         *
+         * @param   pSpec   The world streamer's specification.
+         *
+         * @throw   `std::invalid_argument` if the cell size is not positive, or
+         *          if the unload radius is less than the load radius.
+         */
+        explicit WorldStreamer (
+            const WorldStreamerSpec& pSpec = {}
+        ) :
+            mSpec   { pSpec }
+        {
+            if (mSpec.mCellSize <= 0.0f)
+            {
+                ACE_THROW(
+                    std::invalid_argument,
+                    "{}: Cell size must be positive!",
+                    "WorldStreamer"
+                );
+            }
+            else if (mSpec.mUnloadRadius < mSpec.mLoadRadius)
+            {
+                ACE_THROW(
+                    std::invalid_argument,
+                    "{}: Unload radius ({}) is less than load radius ({})!",
+                    "WorldStreamer", mSpec.mUnloadRadius, mSpec.mLoadRadius
+                );
+            }
+        }
+
+    public:
+
+        /**
+         * @brief   Registers a cell of the level with the streamer.
+         *
+         * @param   pCoord          The cell's grid coordinate.
+         * @param   pLogicalPath    The logical path to the cell's asset data.
+         * @param   pByteSize       The estimated memory footprint of the cell
+         *                          once loaded, in bytes.
+         */
+        void AddCell (
+            const Vector3i&     pCoord,
+            const std::string&  pLogicalPath,
+            const std::size_t&  pByteSize
+        )
+        {
+            Cell& lCell         = mCells[pCoord];
+            lCell.mLogicalPath  = pLogicalPath;
+            lCell.mByteSize     = pByteSize;
+            lCell.mBounds       = GetCellBounds(pCoord);
+        }
+
+        /**
+         * @brief   Retrieves the grid coordinate of the cell containing the
+         *          given world-space position.
+         *
+         * @param   pPosition   The world-space position.
+         *
+         * @return  The containing cell's grid coordinate.
+         */
+        Vector3i GetCellAt (
+            const Vector3f& pPosition
+        ) const
+        {
+            return Vector3i {
+                static_cast<std::int32_t>(std::floor(pPosition.mX / mSpec.mCellSize)),
+                static_cast<std::int32_t>(std::floor(pPosition.mY / mSpec.mCellSize)),
+                static_cast<std::int32_t>(std::floor(pPosition.mZ / mSpec.mCellSize))
+            };
+        }
+
+        /**
+         * @brief   Retrieves the world-space bounds of the cell at the given
+         *          grid coordinate.
+         *
+         * @param   pCoord  The cell's grid coordinate.
+         *
+         * @return  The cell's bounding box.
+         */
+        AABB3f GetCellBounds (
+            const Vector3i& pCoord
+        ) const
+        {
+            Vector3f lMin {
+                static_cast<float>(pCoord.mX) * mSpec.mCellSize,
+                static_cast<float>(pCoord.mY) * mSpec.mCellSize,
+                static_cast<float>(pCoord.mZ) * mSpec.mCellSize
+            };
+
+            return AABB3f { lMin, lMin + mSpec.mCellSize };
+        }
+
+        /**
+         * @brief   Retrieves a handle to the asset of the cell at the given
+         *          grid coordinate, if that cell is resident.
+         *
+         * @param   pCoord  The cell's grid coordinate.
+         *
+         * @return  An `AssetHandle<T>` referencing the cell's asset if it is
+         *          resident; an empty `AssetHandle<T>` otherwise.
+         */
+        AssetHandle<T> GetCell (
+            const Vector3i& pCoord
+        ) const
+        {
+            auto lIter = mCells.find(pCoord);
+            if (lIter == mCells.end() || lIter->second.mState != CellState::Resident)
+            {
+                return AssetHandle<T> {};
+            }
+
+            return lIter->second.mHandle;
+        }
+
+        /**
+         * @brief   Retrieves the number of times in a row the cell at the
+         *          given grid coordinate has failed to load.
+         *
+         * @param   pCoord  The cell's grid coordinate.
+         *
+         * @return  The number of consecutive failures; zero once the cell
+         *          loads, or if no such cell is registered.
+         */
+        std::size_t GetFailureCount (
+            const Vector3i& pCoord
+        ) const
+        {
+            auto lIter = mCells.find(pCoord);
+            return (lIter != mCells.end()) ? lIter->second.mFailureCount : 0;
+        }
+
+        /**
+         * @brief   Retrieves the number of bytes currently resident or in
+         *          flight, as counted against the memory budget.
+         *
+         * @return  The number of budgeted bytes.
+         */
+        inline std::size_t GetBudgetedBytes () const
+        {
+            return mBudgetedBytes;
+        }
+
+        /**
+         * @brief   Retrieves the number of cell loads currently in flight.
+         *
+         * @return  The number of in-flight loads.
+         */
+        inline std::size_t GetInFlightCount () const
+        {
+            return mInFlightCount;
+        }
+
+        /**
+         * @brief   Updates the streamer, collecting finished loads, releasing
+         *          cells which have left the unload radius and issuing new
+         *          loads for the nearest cells within the load radius.
+         *
+         * @param   pFocusPoints    The world-space positions to stream around.
+         */
+        void Update (
+            const std::vector<Vector3f>& pFocusPoints
+        )
+        {
+            // Refresh the focus distances of every cell which is resident or
+            // in flight, then gather the unloaded cells within the load radius
+            // as candidates for streaming in.
+            for (auto& lCoord : mActive)
+            {
+                Cell& lCell = mCells.at(lCoord);
+                lCell.mDistance = MeasureDistance(lCell, pFocusPoints);
+            }
+            GatherCandidates(pFocusPoints);
+
+            // Collect finished loads and release cells which have wandered
+            // beyond the unload radius.
+            std::erase_if(
+                mActive,
+                [&] (const Vector3i& pCoord)
+                {
+                    Cell& lCell = mCells.at(pCoord);
+                    if (lCell.mState == CellState::Loading)
+                    {
+                        return CollectLoad(pCoord, lCell);
+                    }
+                    else if (lCell.mDistance > mSpec.mUnloadRadius)
+                    {
+                        Release(pCoord, lCell);
+                        return true;
+                    }
+
+                    return false;
+                }
+            );
+
+            // Issue loads for the nearest candidates first, while there is room
+            // in flight and under the memory budget.
+            std::sort(
+                mCandidates.begin(),
+                mCandidates.end(),
+                [this] (const Vector3i& pFirst, const Vector3i& pSecond)
+                {
+                    return mCells.at(pFirst).mDistance < mCells.at(pSecond).mDistance;
+                }
+            );
+            for (auto& lCoord : mCandidates)
+            {
+                if (mInFlightCount >= mSpec.mMaxInFlight)
+                {
+                    break;
+                }
+
+                Cell& lCell = mCells.at(lCoord);
+                if (MakeRoom(lCell.mByteSize, lCell.mDistance) == false)
+                {
+                    break;
+                }
+
+                lCell.mState    = CellState::Loading;
+                lCell.mFuture   = AssetRegistry::LoadAsync<T>(lCell.mLogicalPath);
+                mBudgetedBytes += lCell.mByteSize;
+                ++mInFlightCount;
+                mActive.push_back(lCoord);
+            }
+        }
+
+    private:
+
+        /**
+         * @brief   Enumerates the residency states of a cell.
+         */
+        enum class CellState
+        {
+            Unloaded,
+            Loading,
+            Resident
+        };
+
+        /**
+         * @brief   A structure representing a single registered cell.
+         */
+        struct Cell
+        {
+            std::string                     mLogicalPath = "";                  ///< @brief The logical path to the cell's asset data.
+            std::size_t                     mByteSize = 0;                      ///< @brief The estimated memory footprint of the cell, in bytes.
+            AABB3f                          mBounds;                            ///< @brief The cell's world-space bounds.
+            CellState                       mState = CellState::Unloaded;       ///< @brief The cell's current residency state.
+            float                           mDistance = 0.0f;                   ///< @brief The distance from the cell to the nearest focus point, as of the last update.
+            std::size_t                     mCandidateFrame = 0;                ///< @brief The last update in which this cell was gathered as a candidate.
+            std::size_t                     mFailureCount = 0;                  ///< @brief The number of times in a row the cell's load has failed.
+            std::size_t                     mRetryFrame = 0;                    ///< @brief The first update in which the cell may be loaded again, after a failure.
+            std::future<AssetHandle<T>>     mFuture;                            ///< @brief The in-flight load of the cell's asset, if any.
+            AssetHandle<T>                  mHandle;                            ///< @brief A handle to the cell's asset, if resident.
+        };
+
+        /**
+         * @brief   A structure used for hashing cell grid coordinates.
+         */
+        struct CellCoordHash
+        {
+            inline std::size_t operator () (const Vector3i& pCoord) const noexcept
+            {
+                return
+                    (static_cast<std::size_t>(static_cast<std::uint32_t>(pCoord.mX)) * 73856093) ^
+                    (static_cast<std::size_t>(static_cast<std::uint32_t>(pCoord.mY)) * 19349663) ^
+                    (static_cast<std::size_t>(static_cast<std::uint32_t>(pCoord.mZ)) * 83492791);
+            }
+        };
+
+    private:
+
+        /**
+         * @brief   Measures the distance from the given cell's bounds to the
+         *          nearest of the given focus points.
+         *
+         * @param   pCell           The cell to measure.
+         * @param   pFocusPoints    The focus points to measure from.
+         *
+         * @return  The distance to the nearest focus point.
+         */
+        static float MeasureDistance (
+            const Cell&                     pCell,
+            const std::vector<Vector3f>&    pFocusPoints
+        )
+        {
+            float lNearest = std::numeric_limits<float>::max();
+            for (const auto& lPoint : pFocusPoints)
+            {
+                lNearest = std::min(lNearest, pCell.mBounds.DistanceSquared(lPoint));
+            }
+
+            return std::sqrt(lNearest);
+        }
+
+        /**
+         * @brief   Gathers the unloaded cells lying within the load radius of
+         *          any of the given focus points into the candidate list.
+         *
+         * Only the grid coordinates around each focus point are visited, so
+         * the cost of this method does not grow with the size of the level.
+         *
+         * @param   pFocusPoints    The focus points to gather around.
+         */
+        void GatherCandidates (
+            const std::vector<Vector3f>& pFocusPoints
+        )
+        {
+            mCandidates.clear();
+            ++mFrame;
+
+            for (const auto& lPoint : pFocusPoints)
+            {
+                Vector3i lLow  = GetCellAt(lPoint - mSpec.mLoadRadius);
+                Vector3i lHigh = GetCellAt(lPoint + mSpec.mLoadRadius);
+
+                for (std::int32_t x = lLow.mX; x <= lHigh.mX; ++x)
+                {
+                    for (std::int32_t y = lLow.mY; y <= lHigh.mY; ++y)
+                    {
+                        for (std::int32_t z = lLow.mZ; z <= lHigh.mZ; ++z)
+                        {
+                            Vector3i lCoord { x, y, z };
+                            auto lIter = mCells.find(lCoord);
+                            if (
+                                lIter == mCells.end() ||
+                                lIter->second.mState != CellState::Unloaded ||
+                                lIter->second.mCandidateFrame == mFrame ||
+                                lIter->second.mRetryFrame > mFrame
+                            )
+                            {
+                                continue;
+                            }
+
+                            Cell& lCell = lIter->second;
+                            lCell.mDistance = MeasureDistance(lCell, pFocusPoints);
+                            if (lCell.mDistance <= mSpec.mLoadRadius)
+                            {
+                                lCell.mCandidateFrame = mFrame;
+                                mCandidates.push_back(lCoord);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief   Checks to see if the given cell's in-flight load has
+         *          finished, and if so, makes the cell resident.
+         *
+         * A load which finishes after its cell has left the unload radius is
+         * released right away. A load which failed returns its cell to the
+         * unloaded state, to be retried after a backoff.
+         *
+         * @param   pCoord  The cell's grid coordinate.
+         * @param   pCell   The cell being loaded.
+         *
+         * @return  `true` if the cell is no longer active; `false` otherwise.
+         */
+        bool CollectLoad (
+            const Vector3i& pCoord,
+            Cell&           pCell
+        )
+        {
+            if (
+                pCell.mFuture.wait_for(std::chrono::seconds(0)) !=
+                    std::future_status::ready
+            )
+            {
+                return false;
+            }
+
+            --mInFlightCount;
+            pCell.mHandle = pCell.mFuture.get();
+            if (pCell.mHandle.IsValid() == false)
+            {
+                const std::size_t lShift = std::min<std::size_t>(pCell.mFailureCount, 16);
+                const std::size_t lDelay = std::min(mSpec.mRetryDelay << lShift, mSpec.mMaxRetryDelay);
+                ++pCell.mFailureCount;
+                ACE_LOG_WARNING("Could not stream in cell '{}'; retrying in {} updates.",
+                    pCell.mLogicalPath, lDelay);
+                pCell.mState = CellState::Unloaded;
+                pCell.mRetryFrame = mFrame + lDelay;
+                mBudgetedBytes -= pCell.mByteSize;
+                return true;
+            }
+
+            pCell.mState = CellState::Resident;
+            pCell.mFailureCount = 0;
+            EventBus::Emit(
+                CellStreamedEvent { pCoord, pCell.mLogicalPath,
+                    CellStreamMethod::StreamedIn }
+            );
+
+            if (pCell.mDistance > mSpec.mUnloadRadius)
+            {
+                Release(pCoord, pCell);
+                return true;
+            }
+
+            return false;
+        }
+
+        /**
+         * @brief   Releases the given resident cell's asset.
+         *
+         * @param   pCoord  The cell's grid coordinate.
+         * @param   pCell   The cell being released.
+         */
+        void Release (
+            const Vector3i& pCoord,
+            Cell&           pCell
+        )
+        {
+            pCell.mHandle   = AssetHandle<T> {};
+            pCell.mState    = CellState::Unloaded;
+            mBudgetedBytes -= pCell.mByteSize;
+
+            EventBus::Emit(
+                CellStreamedEvent { pCoord, pCell.mLogicalPath,
+                    CellStreamMethod::StreamedOut }
+            );
+        }
+
+        /**
+         * @brief   Makes room under the memory budget for a cell of the given
+         *          size, releasing resident cells farther away than that cell,
+         *          farthest first, if needed.
+         *
+         * Only cells farther than the incoming cell are ever released, so two
+         * cells cannot repeatedly evict one another.
+         *
+         * @param   pByteSize   The size of the incoming cell, in bytes.
+         * @param   pDistance   The incoming cell's focus distance.
+         *
+         * @return  `true` if the incoming cell now fits; `false` otherwise.
+         */
+        bool MakeRoom (
+            const std::size_t&  pByteSize,
+            const float         pDistance
+        )
+        {
+            if (mBudgetedBytes + pByteSize <= mSpec.mMemoryBudget)
+            {
+                return true;
+            }
+
+            // Find the resident cells which could be released, and check
+            // whether releasing all of them would even be enough.
+            std::vector<Vector3i> lEvictable;
+            std::size_t lEvictableBytes = 0;
+            for (auto& lCoord : mActive)
+            {
+                Cell& lCell = mCells.at(lCoord);
+                if (lCell.mState == CellState::Resident && lCell.mDistance > pDistance)
+                {
+                    lEvictable.push_back(lCoord);
+                    lEvictableBytes += lCell.mByteSize;
+                }
+            }
+
+            if (mBudgetedBytes - lEvictableBytes + pByteSize > mSpec.mMemoryBudget)
+            {
+                return false;
+            }
+
+            // Release the farthest cells first, until the incoming cell fits.
+            std::sort(
+                lEvictable.begin(),
+                lEvictable.end(),
+                [this] (const Vector3i& pFirst, const Vector3i& pSecond)
+                {
+                    return mCells.at(pFirst).mDistance > mCells.at(pSecond).mDistance;
+                }
+            );
+            for (auto& lCoord : lEvictable)
+            {
+                if (mBudgetedBytes + pByteSize <= mSpec.mMemoryBudget)
+                {
+                    break;
+                }
+
+                Release(lCoord, mCells.at(lCoord));
+                std::erase(mActive, lCoord);
+            }
+
+            return true;
+        }
+
+    private:
+        WorldStreamerSpec                                   mSpec;                  ///< @brief The world streamer's specification.
+        std::unordered_map<Vector3i, Cell, CellCoordHash>   mCells;                 ///< @brief The map of registered cells, keyed by grid coordinate.
+        std::vector<Vector3i>                               mActive;                ///< @brief The coordinates of the cells which are resident or in flight.
+        std::vector<Vector3i>                               mCandidates;            ///< @brief The coordinates of the cells gathered for streaming in during the current update.
+        std::size_t                                         mBudgetedBytes = 0;     ///< @brief The number of bytes resident or in flight.
+        std::size_t                                         mInFlightCount = 0;     ///< @brief The number of loads in flight.
+        std::size_t                                         mFrame = 0;             ///< @brief The number of updates performed so far.
+
+    };
+
+}
@@ -0,0 +1,877 @@
+/**
+ * @file    Ace/Scripting/ScriptCompiler.cpp
+ */
+
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <Ace/Scripting/ScriptCompiler.hpp>
+#include <Ace/System/ContentHash.hpp>
+
+namespace ace
+{
+
+    /* Helper Types ***********************************************************/
+
+    /**
+     * @brief   Enumerates the kinds of token in a script.
+     */
+    enum class ScriptTokenType : std::uint8_t
+    {
+        Number, Identifier,
+        Fn, Let, If, Else, While, Return,
+        LeftParen, RightParen, LeftBrace, RightBrace, Comma, Semicolon,
+        Assign, Plus, Minus, Star, Slash, Percent,
+        Less, LessEqual, Greater, GreaterEqual, EqualEqual, NotEqual,
+        Bang, AndAnd, OrOr,
+        End
+    };
+
+    /**
+     * @brief   A structure containing one token of a script.
+     */
+    struct ScriptToken
+    {
+        ScriptTokenType     mType = ScriptTokenType::End;   ///< @brief The kind of token.
+        std::string_view    mText;                          ///< @brief The token's text.
+        double              mNumber = 0.0;                  ///< @brief The token's value, for numbers.
+        std::size_t         mLine = 1;                      ///< @brief The line the token starts on.
+    };
+
+    [[noreturn]] static void Fail (
+        const std::string&  pName,
+        const std::size_t&  pLine,
+        const std::string&  pMessage
+    )
+    {
+        ACE_THROW(std::runtime_error, "{}: {}:{}: {}", "ScriptCompiler",
+            pName, pLine, pMessage);
+    }
+
+    static std::vector<ScriptToken> Tokenize (
+        std::string_view    pSource,
+        const std::string&  pName
+    )
+    {
+        static const std::unordered_map<std::string_view, ScriptTokenType> KEYWORDS = {
+            { "fn", ScriptTokenType::Fn },          { "let", ScriptTokenType::Let },
+            { "if", ScriptTokenType::If },          { "else", ScriptTokenType::Else },
+            { "while", ScriptTokenType::While },    { "return", ScriptTokenType::Return }
+        };
+
+        std::vector<ScriptToken> lTokens;
+        std::size_t lLine = 1;
+        std::size_t i = 0;
+        while (i < pSource.size())
+        {
+            const char lChar = pSource[i];
+            const char lNext = (i + 1 < pSource.size()) ? pSource[i + 1] : '\0';
+            const std::size_t lStart = i;
+
+            if (lChar == '\n')
+            {
+                ++lLine;
+                ++i;
+                continue;
+            }
+            else if (std::isspace(static_cast<unsigned char>(lChar)))
+            {
+                ++i;
+                continue;
+            }
+            else if (lChar == '/' && lNext == '/')
+            {
+                while (i < pSource.size() && pSource[i] != '\n') { ++i; }
+                continue;
+            }
+
+            ScriptToken lToken;
+            lToken.mLine = lLine;
+
+            if (std::isdigit(static_cast<unsigned char>(lChar)) || (lChar == '.' &&
+                std::isdigit(static_cast<unsigned char>(lNext))))
+            {
+                while (i < pSource.size() && (std::isdigit(
+                    static_cast<unsigned char>(pSource[i])) || pSource[i] == '.'))
+                {
+                    ++i;
+                }
+
+                lToken.mType = ScriptTokenType::Number;
+                const auto lResult = std::from_chars(pSource.data() + lStart,
+                    pSource.data() + i, lToken.mNumber);
+                if (lResult.ec != std::errc {} || lResult.ptr != pSource.data() + i)
+                {
+                    Fail(pName, lLine, std::format("Malformed number '{}'.",
+                        pSource.substr(lStart, i - lStart)));
+                }
+            }
+            else if (std::isalpha(static_cast<unsigned char>(lChar)) || lChar == '_')
+            {
+                while (i < pSource.size() && (std::isalnum(
+                    static_cast<unsigned char>(pSource[i])) || pSource[i] == '_'))
+                {
+                    ++i;
+                }
+
+                auto lKeyword = KEYWORDS.find(pSource.substr(lStart, i - lStart));
+                lToken.mType = (lKeyword != KEYWORDS.end()) ?
+                    lKeyword->second : ScriptTokenType::Identifier;
+            }
+            else
+            {
+                // Two-character operators first.
+                i += 2;
+                if (lChar == '<' && lNext == '=')       { lToken.mType = ScriptTokenType::LessEqual; }
+                else if (lChar == '>' && lNext == '=')  { lToken.mType = ScriptTokenType::GreaterEqual; }
+                else if (lChar == '=' && lNext == '=')  { lToken.mType = ScriptTokenType::EqualEqual; }
+                else if (lChar == '!' && lNext == '=')  { lToken.mType = ScriptTokenType::NotEqual; }
+                else if (lChar == '&' && lNext == '&')  { lToken.mType = ScriptTokenType::AndAnd; }
+                else if (lChar == '|' && lNext == '|')  { lToken.mType = ScriptTokenType::OrOr; }
+                else
+                {
+                    i -= 1;
+                    switch (lChar)
+                    {
+                        case '(': lToken.mType = ScriptTokenType::LeftParen; break;
+                        case ')': lToken.mType = ScriptTokenType::RightParen; break;
+                        case '{': lToken.mType = ScriptTokenType::LeftBrace; break;
+                        case '}': lToken.mType = ScriptTokenType::RightBrace; break;
+                        case ',': lToken.mType = ScriptTokenType::Comma; break;
+                        case ';': lToken.mType = ScriptTokenType::Semicolon; break;
+                        case '=': lToken.mType = ScriptTokenType::Assign; break;
+                        case '+': lToken.mType = ScriptTokenType::Plus; break;
+                        case '-': lToken.mType = ScriptTokenType::Minus; break;
+                        case '*': lToken.mType = ScriptTokenType::Star; break;
+                        case '/': lToken.mType = ScriptTokenType::Slash; break;
+                        case '%': lToken.mType = ScriptTokenType::Percent; break;
+                        case '<': lToken.mType = ScriptTokenType::Less; break;
+                        case '>': lToken.mType = ScriptTokenType::Greater; break;
+                        case '!': lToken.mType = ScriptTokenType::Bang; break;
+                        default:
+                            Fail(pName, lLine, std::format("Unexpected character '{}'.", lChar));
+                    }
+                }
+            }
+
+            lToken.mText = pSource.substr(lStart, i - lStart);
+            lTokens.push_back(lToken);
+        }
+
+        ScriptToken lEnd;
+        lEnd.mLine = lLine;
+        lTokens.push_back(lEnd);
+        return lTokens;
+    }
+
+    /**
+     * @brief   A class which parses a script's tokens, emitting bytecode into a
+     *          module as it goes.
+     */
+    class ScriptParser final
+    {
+    public:
+        ScriptParser (
+            const std::vector<ScriptToken>& pTokens,
+            const std::string&              pName,
+            ScriptModule&                   pModule
+        ) :
+            mTokens { pTokens },
+            mName   { pName },
+            mModule { pModule }
+        {}
+
+        void ParseModule ()
+        {
+            DeclareFunctions();
+            while (Check(ScriptTokenType::End) == false)
+            {
+                FunctionDeclaration();
+            }
+        }
+
+    private:
+
+        /**
+         * @brief   A structure containing one local variable in scope.
+         */
+        struct Local
+        {
+            std::string_view    mName;          ///< @brief The variable's name.
+            std::uint8_t        mRegister = 0;  ///< @brief The register holding the variable.
+            std::size_t         mDepth = 0;     ///< @brief The block depth it was declared at.
+        };
+
+        /* Tokens *************************************************************/
+
+        const ScriptToken& Peek (const std::size_t& pAhead = 0) const
+        {
+            return mTokens[std::min(mPosition + pAhead, mTokens.size() - 1)];
+        }
+
+        bool Check (const ScriptTokenType pType) const
+        {
+            return Peek().mType == pType;
+        }
+
+        bool Match (const ScriptTokenType pType)
+        {
+            if (Check(pType) == false)
+            {
+                return false;
+            }
+
+            ++mPosition;
+            return true;
+        }
+
+        const ScriptToken& Expect (
+            const ScriptTokenType   pType,
+            const char*             pWhat
+        )
+        {
+            if (Check(pType) == false)
+            {
+                Fail(mName, Peek().mLine, std::format("Expected {}, found '{}'.",
+                    pWhat, (Check(ScriptTokenType::End) == true) ?
+                        std::string_view { "end of file" } : Peek().mText));
+            }
+
+            return mTokens[mPosition++];
+        }
+
+        /* Registers and Code *************************************************/
+
+        bool IsTemporary (const std::uint8_t pRegister) const
+        {
+            return pRegister >= mLocals.size();
+        }
+
+        std::uint8_t Allocate ()
+        {
+            if (mTop >= 255)
+            {
+                Fail(mName, Peek().mLine, "Function needs more than 255 registers.");
+            }
+
+            mFunction->mRegisterCount = std::max<std::uint8_t>(
+                mFunction->mRegisterCount, static_cast<std::uint8_t>(mTop + 1));
+            return static_cast<std::uint8_t>(mTop++);
+        }
+
+        void Free (const std::uint8_t pRegister)
+        {
+            if (IsTemporary(pRegister) == true && pRegister + 1u == mTop)
+            {
+                --mTop;
+            }
+        }
+
+        void Emit (const std::uint32_t pInstruction)
+        {
+            mFunction->mCode.push_back(pInstruction);
+        }
+
+        std::uint32_t Constant (const double pValue)
+        {
+            const std::uint64_t lBits = std::bit_cast<std::uint64_t>(pValue);
+            auto lIter = mConstantIndices.find(lBits);
+            if (lIter != mConstantIndices.end())
+            {
+                return lIter->second;
+            }
+
+            if (mModule.mConstants.size() > 0xFFFF)
+            {
+                Fail(mName, Peek().mLine, "Script has more than 65536 constants.");
+            }
+
+            const std::uint32_t lIndex = static_cast<std::uint32_t>(mModule.mConstants.size());
+            mModule.mConstants.push_back(pValue);
+            mConstantIndices.emplace(lBits, lIndex);
+            return lIndex;
+        }
+
+        std::uint8_t LoadConstant (const double pValue)
+        {
+            const std::uint8_t lRegister = Allocate();
+            Emit(ScriptInstruction::MakeBx(ScriptOpCode::LoadConstant, lRegister,
+                Constant(pValue)));
+            return lRegister;
+        }
+
+        std::size_t EmitJump (
+            const ScriptOpCode  pOpCode,
+            const std::uint8_t  pRegister
+        )
+        {
+            Emit(ScriptInstruction::MakeJump(pOpCode, pRegister, 0));
+            return mFunction->mCode.size() - 1;
+        }
+
+        void CheckJump (const std::int64_t pOffset) const
+        {
+            if (pOffset < -ScriptInstruction::JUMP_BIAS || pOffset > ScriptInstruction::JUMP_BIAS)
+            {
+                Fail(mName, Peek().mLine, "Jump is too far; split the function up.");
+            }
+        }
+
+        void PatchJump (const std::size_t& pJump)
+        {
+            auto& lCode = mFunction->mCode;
+            const std::int64_t lOffset = static_cast<std::int64_t>(lCode.size() - pJump - 1);
+            CheckJump(lOffset);
+
+            lCode[pJump] = ScriptInstruction::MakeJump(
+                ScriptInstruction::GetOpCode(lCode[pJump]),
+                ScriptInstruction::GetA(lCode[pJump]),
+                static_cast<std::int32_t>(lOffset));
+            mLabel = lCode.size();
+        }
+
+        void EmitLoop (const std::size_t& pStart)
+        {
+            const std::int64_t lOffset = static_cast<std::int64_t>(pStart) -
+                static_cast<std::int64_t>(mFunction->mCode.size() + 1);
+            CheckJump(lOffset);
+            Emit(ScriptInstruction::MakeJump(ScriptOpCode::Jump, 0,
+                static_cast<std::int32_t>(lOffset)));
+        }
+
+        /**
+         * @brief   Stores a value in a local's register, by rewriting the
+         *          instruction which produced it where that is safe, or with a
+         *          move otherwise.
+         */
+        void StoreInto (
+            const std::uint8_t  pLocal,
+            const std::uint8_t  pValue
+        )
+        {
+            if (pLocal == pValue)
+            {
+                return;
+            }
+
+            auto& lCode = mFunction->mCode;
+            if (
+                IsTemporary(pValue) == true &&
+                lCode.empty() == false &&
+                mLabel != lCode.size() &&
+                ScriptInstruction::GetA(lCode.back()) == pValue
+            )
+            {
+                const ScriptOpCode lOpCode = ScriptInstruction::GetOpCode(lCode.back());
+                if (lOpCode <= ScriptOpCode::Not)
+                {
+                    lCode.back() = (lCode.back() & ~0xFF00u) |
+                        (static_cast<std::uint32_t>(pLocal) << 8);
+                    return;
+                }
+            }
+
+            Emit(ScriptInstruction::Make(ScriptOpCode::Move, pLocal, pValue));
+        }
+
+        const Local* Resolve (std::string_view pName) const
+        {
+            for (auto lIter = mLocals.rbegin(); lIter != mLocals.rend(); ++lIter)
+            {
+                if (lIter->mName == pName)
+                {
+                    return &*lIter;
+                }
+            }
+
+            return nullptr;
+        }
+
+        /* Declarations *******************************************************/
+
+        /**
+         * @brief   Collects the name and arity of every function up front, so
+         *          that functions may be called before they are declared.
+         */
+        void DeclareFunctions ()
+        {
+            for (std::size_t i = 0; i + 2 < mTokens.size(); ++i)
+            {
+                if (
+                    mTokens[i].mType != ScriptTokenType::Fn ||
+                    mTokens[i + 1].mType != ScriptTokenType::Identifier ||
+                    mTokens[i + 2].mType != ScriptTokenType::LeftParen
+                )
+                {
+                    continue;
+                }
+
+                const std::string_view lName = mTokens[i + 1].mText;
+                if (mFunctionIndices.contains(lName) == true)
+                {
+                    Fail(mName, mTokens[i].mLine,
+                        std::format("Function '{}' is declared twice.", lName));
+                }
+                else if (mModule.mFunctions.size() == 256)
+                {
+                    Fail(mName, mTokens[i].mLine, "Script has more than 256 functions.");
+                }
+
+                ScriptFunction lFunction;
+                lFunction.mName = std::string { lName };
+                for (std::size_t j = i + 3; j < mTokens.size() &&
+                    mTokens[j].mType != ScriptTokenType::RightParen; ++j)
+                {
+                    if (mTokens[j].mType == ScriptTokenType::Identifier)
+                    {
+                        ++lFunction.mParameterCount;
+                    }
+                }
+
+                mFunctionIndices.emplace(lName, mModule.mFunctions.size());
+                mModule.mFunctions.push_back(std::move(lFunction));
+            }
+        }
+
+        void FunctionDeclaration ()
+        {
+            Expect(ScriptTokenType::Fn, "'fn'");
+            const ScriptToken& lName = Expect(ScriptTokenType::Identifier, "a function name");
+            mFunction = &mModule.mFunctions[mFunctionIndices.at(lName.mText)];
+            mLocals.clear();
+            mDepth = 0;
+            mTop = 0;
+            mLabel = 0;
+
+            Expect(ScriptTokenType::LeftParen, "'('");
+            if (Check(ScriptTokenType::RightParen) == false)
+            {
+                do
+                {
+                    const ScriptToken& lParameter =
+                        Expect(ScriptTokenType::Identifier, "a parameter name");
+                    mLocals.push_back({ lParameter.mText, Allocate(), 0 });
+                }
+                while (Match(ScriptTokenType::Comma) == true);
+            }
+            Expect(ScriptTokenType::RightParen, "')'");
+
+            Block();
+
+            // Falling off the end returns zero.
+            const std::uint8_t lZero = LoadConstant(0.0);
+            Emit(ScriptInstruction::Make(ScriptOpCode::Return, lZero));
+        }
+
+        /* Statements *********************************************************/
+
+        void Block ()
+        {
+            Expect(ScriptTokenType::LeftBrace, "'{'");
+            const std::size_t lLocalCount = mLocals.size();
+            ++mDepth;
+
+            while (
+                Check(ScriptTokenType::RightBrace) == false &&
+                Check(ScriptTokenType::End) == false
+            )
+            {
+                Statement();
+            }
+            Expect(ScriptTokenType::RightBrace, "'}'");
+
+            --mDepth;
+            mLocals.resize(lLocalCount);
+            mTop = static_cast<std::uint32_t>(lLocalCount);
+        }
+
+        void Statement ()
+        {
+            switch (Peek().mType)
+            {
+                case ScriptTokenType::Let:          LetStatement(); break;
+                case ScriptTokenType::If:           IfStatement(); break;
+                case ScriptTokenType::While:        WhileStatement(); break;
+                case ScriptTokenType::Return:       ReturnStatement(); break;
+                case ScriptTokenType::LeftBrace:    Block(); break;
+                default:
+                    if (
+                        Check(ScriptTokenType::Identifier) == true &&
+                        Peek(1).mType == ScriptTokenType::Assign
+                    )
+                    {
+                        AssignStatement();
+                    }
+                    else
+                    {
+                        Free(Expression());
+                        Expect(ScriptTokenType::Semicolon, "';'");
+                    }
+                    break;
+            }
+
+            // Every temporary is dead between statements.
+            mTop = static_cast<std::uint32_t>(mLocals.size());
+        }
+
+        void LetStatement ()
+        {
+            Expect(ScriptTokenType::Let, "'let'");
+            const ScriptToken& lName = Expect(ScriptTokenType::Identifier, "a variable name");
+            const Local* lExisting = Resolve(lName.mText);
+            if (lExisting != nullptr && lExisting->mDepth == mDepth)
+            {
+                Fail(mName, lName.mLine, std::format(
+                    "Variable '{}' is already declared in this block.", lName.mText));
+            }
+
+            std::uint8_t lValue = (Match(ScriptTokenType::Assign) == true) ?
+                Expression() : LoadConstant(0.0);
+            if (IsTemporary(lValue) == false)
+            {
+                const std::uint8_t lCopy = Allocate();
+                Emit(ScriptInstruction::Make(ScriptOpCode::Move, lCopy, lValue));
+                lValue = lCopy;
+            }
+            Expect(ScriptTokenType::Semicolon, "';'");
+
+            // The value is the lowest temporary, so it simply becomes a local.
+            mLocals.push_back({ lName.mText, lValue, mDepth });
+        }
+
+        void AssignStatement ()
+        {
+            const ScriptToken& lName = Expect(ScriptTokenType::Identifier, "a variable name");
+            const Local* lLocal = Resolve(lName.mText);
+            if (lLocal == nullptr)
+            {
+                Fail(mName, lName.mLine, std::format("Undeclared variable '{}'.", lName.mText));
+            }
+
+            const std::uint8_t lRegister = lLocal->mRegister;
+            Expect(ScriptTokenType::Assign, "'='");
+            const std::uint8_t lValue = Expression();
+            Expect(ScriptTokenType::Semicolon, "';'");
+
+            StoreInto(lRegister, lValue);
+            Free(lValue);
+        }
+
+        void IfStatement ()
+        {
+            Expect(ScriptTokenType::If, "'if'");
+            Expect(ScriptTokenType::LeftParen, "'('");
+            const std::uint8_t lCondition = Expression();
+            Expect(ScriptTokenType::RightParen, "')'");
+            Free(lCondition);
+
+            const std::size_t lSkipThen = EmitJump(ScriptOpCode::JumpIfFalse, lCondition);
+            Block();
+
+            if (Match(ScriptTokenType::Else) == true)
+            {
+                const std::size_t lSkipElse = EmitJump(ScriptOpCode::Jump, 0);
+                PatchJump(lSkipThen);
+                if (Check(ScriptTokenType::If) == true)
+                {
+                    IfStatement();
+                }
+                else
+                {
+                    Block();
+                }
+
+                PatchJump(lSkipElse);
+            }
+            else
+            {
+                PatchJump(lSkipThen);
+            }
+        }
+
+        void WhileStatement ()
+        {
+            Expect(ScriptTokenType::While, "'while'");
+            const std::size_t lStart = mFunction->mCode.size();
+            mLabel = lStart;
+
+            Expect(ScriptTokenType::LeftParen, "'('");
+            const std::uint8_t lCondition = Expression();
+            Expect(ScriptTokenType::RightParen, "')'");
+            Free(lCondition);
+
+            const std::size_t lExit = EmitJump(ScriptOpCode::JumpIfFalse, lCondition);
+            Block();
+            EmitLoop(lStart);
+            PatchJump(lExit);
+        }
+
+        void ReturnStatement ()
+        {
+            Expect(ScriptTokenType::Return, "'return'");
+            const std::uint8_t lValue = (Check(ScriptTokenType::Semicolon) == true) ?
+                LoadConstant(0.0) : Expression();
+            Expect(ScriptTokenType::Semicolon, "';'");
+            Emit(ScriptInstruction::Make(ScriptOpCode::Return, lValue));
+        }
+
+        /* Expressions ********************************************************/
+
+        static int Precedence (const ScriptTokenType pType)
+        {
+            switch (pType)
+            {
+                case ScriptTokenType::OrOr:             return 1;
+                case ScriptTokenType::AndAnd:           return 2;
+                case ScriptTokenType::EqualEqual:
+                case ScriptTokenType::NotEqual:         return 3;
+                case ScriptTokenType::Less:
+                case ScriptTokenType::LessEqual:
+                case ScriptTokenType::Greater:
+                case ScriptTokenType::GreaterEqual:     return 4;
+                case ScriptTokenType::Plus:
+                case ScriptTokenType::Minus:            return 5;
+                case ScriptTokenType::Star:
+                case ScriptTokenType::Slash:
+                case ScriptTokenType::Percent:          return 6;
+                default:                                return 0;
+            }
+        }
+
+        /**
+         * @brief   Compiles an expression whose operators bind at least as
+         *          tightly as the given precedence.
+         *
+         * @return  The register holding the result: either a local's own
+         *          register, or the topmost temporary.
+         */
+        std::uint8_t Expression (const int pMinPrecedence = 1)
+        {
+            std::uint8_t lLeft = Unary();
+            while (true)
+            {
+                const ScriptTokenType lOperator = Peek().mType;
+                const int lPrecedence = Precedence(lOperator);
+                if (lPrecedence == 0 || lPrecedence < pMinPrecedence)
+                {
+                    return lLeft;
+                }
+                ++mPosition;
+
+                if (
+                    lOperator == ScriptTokenType::AndAnd ||
+                    lOperator == ScriptTokenType::OrOr
+                )
+                {
+                    std::uint8_t lResult = lLeft;
+                    if (IsTemporary(lLeft) == false)
+                    {
+                        lResult = Allocate();
+                        Emit(ScriptInstruction::Make(ScriptOpCode::Move, lResult, lLeft));
+                    }
+
+                    const std::size_t lShortCircuit = EmitJump(
+                        (lOperator == ScriptTokenType::AndAnd) ?
+                            ScriptOpCode::JumpIfFalse : ScriptOpCode::JumpIfTrue,
+                        lResult);
+                    const std::uint8_t lRight = Expression(lPrecedence + 1);
+                    if (lRight != lResult)
+                    {
+                        Emit(ScriptInstruction::Make(ScriptOpCode::Move, lResult, lRight));
+                    }
+
+                    Free(lRight);
+                    PatchJump(lShortCircuit);
+                    lLeft = lResult;
+                    continue;
+                }
+
+                const std::uint8_t lRight = Expression(lPrecedence + 1);
+                Free(lRight);
+                Free(lLeft);
+                const std::uint8_t lResult = Allocate();
+
+                ScriptOpCode lOpCode = ScriptOpCode::Add;
+                bool lSwap = false;
+                switch (lOperator)
+                {
+                    case ScriptTokenType::Plus:         lOpCode = ScriptOpCode::Add; break;
+                    case ScriptTokenType::Minus:        lOpCode = ScriptOpCode::Subtract; break;
+                    case ScriptTokenType::Star:         lOpCode = ScriptOpCode::Multiply; break;
+                    case ScriptTokenType::Slash:        lOpCode = ScriptOpCode::Divide; break;
+                    case ScriptTokenType::Percent:      lOpCode = ScriptOpCode::Modulo; break;
+                    case ScriptTokenType::Less:         lOpCode = ScriptOpCode::Less; break;
+                    case ScriptTokenType::LessEqual:    lOpCode = ScriptOpCode::LessEqual; break;
+                    case ScriptTokenType::Greater:      lOpCode = ScriptOpCode::Less; lSwap = true; break;
+                    case ScriptTokenType::GreaterEqual: lOpCode = ScriptOpCode::LessEqual; lSwap = true; break;
+                    case ScriptTokenType::EqualEqual:   lOpCode = ScriptOpCode::Equal; break;
+                    default:                            lOpCode = ScriptOpCode::NotEqual; break;
+                }
+
+                Emit(ScriptInstruction::Make(lOpCode, lResult,
+                    lSwap ? lRight : lLeft, lSwap ? lLeft : lRight));
+                lLeft = lResult;
+            }
+        }
+
+        std::uint8_t Unary ()
+        {
+            if (Match(ScriptTokenType::Minus) == true)
+            {
+                // Fold negative literals into constants.
+                if (Check(ScriptTokenType::Number) == true)
+                {
+                    return LoadConstant(-mTokens[mPosition++].mNumber);
+                }
+
+                const std::uint8_t lOperand = Unary();
+                Free(lOperand);
+                const std::uint8_t lResult = Allocate();
+                Emit(ScriptInstruction::Make(ScriptOpCode::Negate, lResult, lOperand));
+                return lResult;
+            }
+            else if (Match(ScriptTokenType::Bang) == true)
+            {
+                const std::uint8_t lOperand = Unary();
+                Free(lOperand);
+                const std::uint8_t lResult = Allocate();
+                Emit(ScriptInstruction::Make(ScriptOpCode::Not, lResult, lOperand));
+                return lResult;
+            }
+
+            return Primary();
+        }
+
+        std::uint8_t Primary ()
+        {
+            const ScriptToken& lToken = Peek();
+            if (Match(ScriptTokenType::Number) == true)
+            {
+                return LoadConstant(lToken.mNumber);
+            }
+            else if (Match(ScriptTokenType::LeftParen) == true)
+            {
+                const std::uint8_t lValue = Expression();
+                Expect(ScriptTokenType::RightParen, "')'");
+                return lValue;
+            }
+
+            Expect(ScriptTokenType::Identifier, "an expression");
+            if (Check(ScriptTokenType::LeftParen) == true)
+            {
+                return Call(lToken);
+            }
+
+            const Local* lLocal = Resolve(lToken.mText);
+            if (lLocal == nullptr)
+            {
+                Fail(mName, lToken.mLine, std::format("Undeclared variable '{}'.", lToken.mText));
+            }
+
+            return lLocal->mRegister;
+        }
+
+        std::uint8_t Call (const ScriptToken& pName)
+        {
+            Expect(ScriptTokenType::LeftParen, "'('");
+
+            // Arguments are evaluated into consecutive registers from the top,
+            // which become the callee's parameters; the result replaces the
+            // first of them.
+            const std::uint32_t lBase = mTop;
+            std::uint32_t lCount = 0;
+            if (Check(ScriptTokenType::RightParen) == false)
+            {
+                do
+                {
+                    const std::uint8_t lArgument = Expression();
+                    if (lArgument != lBase + lCount)
+                    {
+                        Emit(ScriptInstruction::Make(ScriptOpCode::Move, Allocate(), lArgument));
+                    }
+
+                    ++lCount;
+                }
+                while (Match(ScriptTokenType::Comma) == true);
+            }
+            Expect(ScriptTokenType::RightParen, "')'");
+
+            if (lCount == 0)
+            {
+                Allocate();
+            }
+            else if (lCount > 255)
+            {
+                Fail(mName, pName.mLine, "Call has more than 255 arguments.");
+            }
+
+            auto lFunction = mFunctionIndices.find(pName.mText);
+            if (lFunction != mFunctionIndices.end())
+            {
+                const std::size_t lExpected = mModule.mFunctions[lFunction->second].mParameterCount;
+                if (lExpected != lCount)
+                {
+                    Fail(mName, pName.mLine, std::format(
+                        "Function '{}' takes {} arguments, but is given {}.",
+                        pName.mText, lExpected, lCount));
+                }
+
+                Emit(ScriptInstruction::Make(ScriptOpCode::Call, lBase,
+                    static_cast<std::uint32_t>(lFunction->second), lCount));
+            }
+            else
+            {
+                auto lImport = mImportIndices.find(pName.mText);
+                if (lImport == mImportIndices.end())
+                {
+                    if (mModule.mImports.size() == 256)
+                    {
+                        Fail(mName, pName.mLine, "Script calls more than 256 native functions.");
+                    }
+
+                    lImport = mImportIndices.emplace(pName.mText, mModule.mImports.size()).first;
+                    mModule.mImports.emplace_back(pName.mText);
+                }
+
+                Emit(ScriptInstruction::Make(ScriptOpCode::CallNative, lBase,
+                    static_cast<std::uint32_t>(lImport->second), lCount));
+            }
+
+            mTop = lBase + 1;
+            return static_cast<std::uint8_t>(lBase);
+        }
+
+    private:
+        const std::vector<ScriptToken>&                 mTokens;                ///< @brief The script's tokens.
+        const std::string&                              mName;                  ///< @brief The script's name, for errors.
+        ScriptModule&                                   mModule;                ///< @brief The module being emitted.
+        std::size_t                                     mPosition = 0;          ///< @brief The index of the next token.
+        std::unordered_map<std::string_view, std::size_t>   mFunctionIndices;   ///< @brief The script's functions, by name.
+        std::unordered_map<std::string_view, std::size_t>   mImportIndices;     ///< @brief The native functions called, by name.
+        std::unordered_map<std::uint64_t, std::uint32_t>    mConstantIndices;   ///< @brief The constants emitted, by bit pattern.
+
+        ScriptFunction*                                 mFunction = nullptr;    ///< @brief The function being emitted.
+        std::vector<Local>                              mLocals;                ///< @brief The locals in scope, innermost last.
+        std::size_t                                     mDepth = 0;             ///< @brief The current block depth.
+        std::uint32_t                                   mTop = 0;               ///< @brief The lowest free register.
+        std::size_t                                     mLabel = 0;             ///< @brief The latest position a forward jump lands at.
+    };
+
+    /* Public Methods *********************************************************/
+
+    std::shared_ptr<ScriptModule> ScriptCompiler::Compile (
+        std::string_view    pSource,
+        const std::string&  pName
+    )
+    {
+        const auto lTokens = Tokenize(pSource, pName);
+
+        auto lModule = std::make_shared<ScriptModule>();
+        lModule->mSourceHash = ContentHash64(pSource, ScriptModule::BYTECODE_VERSION);
+
+        ScriptParser lParser { lTokens, pName, *lModule };
+        lParser.ParseModule();
+        return lModule;
+    }
+
+}
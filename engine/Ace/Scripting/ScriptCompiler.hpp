@@ -0,0 +1,71 @@
+/**
+ * @file    Ace/Scripting/ScriptCompiler.hpp
+ * @brief   Provides a static class which compiles script source code into
+ *          bytecode for the scripting virtual machine.
+ */
+
+#pragma once
+#include <Ace/Scripting/ScriptModule.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A static class which compiles script source code into a
+     *          @a `ScriptModule`.
+     *
+     * Scripts are a sequence of function declarations. Every value is a
+     * `double`; zero is false and anything else is true. For example:
+     *
+     * ```
+     * // Comments run to the end of the line.
+     * fn damage (base, armor) {
+     *     let dealt = base * 2 - armor;
+     *     if (dealt < 1) { return clamp_min(dealt, 1); }
+     *     return dealt;
+     * }
+     * ```
+     *
+     * - Statements: `let name = expression;`, `name = expression;`,
+     *   `if (...) { ... } else { ... }`, `while (...) { ... }`,
+     *   `return expression;` and expression statements. A function which
+     *   ends without returning returns zero.
+     * - Operators, loosest first: `||`, `&&`, `==` `!=`, `<` `<=` `>` `>=`,
+     *   `+` `-`, `*` `/` `%`, and the unary `-` and `!`. `&&` and `||`
+     *   short-circuit, and yield the last operand evaluated.
+     * - Calls: any function declared in the script, before or after the
+     *   call; any other name is imported as a native function, to be bound
+     *   when the module is linked into a @a `ScriptVM`.
+     *
+     * The compiler is single-pass, emitting register-based bytecode as it
+     * parses. Locals live in fixed registers; temporaries are allocated above
+     * them like a stack, and call arguments are evaluated straight into the
+     * registers that become the callee's parameters.
+     */
+    class ACE_API ScriptCompiler final
+    {
+    public:
+
+        /**
+         * @brief   Compiles a script.
+         *
+         * @param   pSource     The script's source code.
+         * @param   pName       The script's name, used in error messages.
+         *
+         * @return  The compiled module. Its source hash is the
+         *          @a `ContentHash64` of the source, seeded with
+         *          @a `ScriptModule::BYTECODE_VERSION`.
+         *
+         * @throw   `std::runtime_error` if the script has a syntax error,
+         *          uses an undeclared variable, calls a script function with
+         *          the wrong number of arguments, or exceeds a limit of the
+         *          instruction set.
+         */
+        static std::shared_ptr<ScriptModule> Compile (
+            std::string_view    pSource,
+            const std::string&  pName = "script"
+        );
+
+    };
+
+}
@@ -0,0 +1,84 @@
+/**
+ * @file    Ace/Scripting/ScriptLoader.cpp
+ */
+
+#include <Ace/Scripting/ScriptCompiler.hpp>
+#include <Ace/Scripting/ScriptLoader.hpp>
+#include <Ace/System/Logger.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    ScriptLoader::ScriptLoader (
+        std::shared_ptr<DerivedDataCache>   pCache
+    ) :
+        mCache  { std::move(pCache) }
+    {}
+
+    /* Public Methods *********************************************************/
+
+    bool ScriptLoader::CanLoad (
+        const std::string&  pLogicalPath,
+        const IVirtualFile& pVirtualFile
+    ) const
+    {
+        (void) pVirtualFile;
+        return pLogicalPath.ends_with(".acs");
+    }
+
+    std::shared_ptr<ScriptModule> ScriptLoader::Load (
+        const std::string&            pLogicalPath,
+        std::unique_ptr<IVirtualFile> pVirtualFile
+    )
+    {
+        std::string lSource(pVirtualFile->GetSize(), '\0');
+        if (
+            lSource.empty() == false &&
+            pVirtualFile->Read(lSource.data(), lSource.size()) != lSource.size()
+        )
+        {
+            return nullptr;
+        }
+
+        const std::uint64_t lHash = ContentHash64(lSource, ScriptModule::BYTECODE_VERSION);
+        if (mCache != nullptr)
+        {
+            if (auto lBytecode = mCache->Get(CACHE_BUCKET, lHash))
+            {
+                try
+                {
+                    auto lModule = ScriptModule::Deserialize(*lBytecode);
+                    if (lModule->mSourceHash == lHash)
+                    {
+                        return lModule;
+                    }
+                }
+                catch (const std::exception&)
+                {
+                    // Damaged; fall through and recompile.
+                }
+            }
+        }
+
+        try
+        {
+            auto lModule = ScriptCompiler::Compile(lSource, pLogicalPath);
+            mCompileCount.fetch_add(1, std::memory_order_relaxed);
+            if (mCache != nullptr)
+            {
+                mCache->Put(CACHE_BUCKET, lHash, lModule->Serialize());
+            }
+
+            return lModule;
+        }
+        catch (const std::exception& lEx)
+        {
+            ACE_LOG_ERROR("ScriptLoader: Could not compile script '{}': {}",
+                pLogicalPath, lEx.what());
+            return nullptr;
+        }
+    }
+
+}
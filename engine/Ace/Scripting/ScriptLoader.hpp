@@ -0,0 +1,77 @@
+/**
+ * @file    Ace/Scripting/ScriptLoader.hpp
+ * @brief   Provides an asset loader which compiles scripts, caching their
+ *          bytecode in a @a `DerivedDataCache`.
+ */
+
+#pragma once
+#include <Ace/Scripting/ScriptModule.hpp>
+#include <Ace/System/AssetRegistry.hpp>
+#include <Ace/System/DerivedDataCache.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   An asset loader which loads @a `ScriptModule`s from `.acs`
+     *          script source files.
+     *
+     * Each script's bytecode is cached in the @a `DerivedDataCache` under the
+     * hash of its source, seeded with the bytecode version. A script whose
+     * source has not changed since it was last compiled, by this run or an
+     * earlier one, is loaded from the cache without being compiled; editing a
+     * script, or upgrading the compiler, changes the hash and so forces a
+     * recompile. Cached bytecode which is damaged or stale is recompiled and
+     * replaced.
+     */
+    class ACE_API ScriptLoader final : public IAssetLoader<ScriptModule>
+    {
+    public:
+
+        /**
+         * @brief   The cache bucket script bytecode is stored in.
+         */
+        static constexpr std::string_view CACHE_BUCKET = "scripts";
+
+    public:
+
+        /**
+         * @brief   Constructs a loader which caches bytecode in the given
+         *          cache.
+         *
+         * @param   pCache  The cache to use, or `nullptr` to always compile.
+         */
+        explicit ScriptLoader (
+            std::shared_ptr<DerivedDataCache>   pCache = nullptr
+        );
+
+    public:
+
+        bool CanLoad (
+            const std::string&  pLogicalPath,
+            const IVirtualFile& pVirtualFile
+        ) const override;
+
+        std::shared_ptr<ScriptModule> Load (
+            const std::string&            pLogicalPath,
+            std::unique_ptr<IVirtualFile> pVirtualFile
+        ) override;
+
+        /**
+         * @brief   Retrieves the number of scripts compiled so far, rather
+         *          than loaded from the cache.
+         *
+         * @return  The number of scripts compiled.
+         */
+        inline std::size_t GetCompileCount () const
+        {
+            return mCompileCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::shared_ptr<DerivedDataCache>   mCache;                 ///< @brief The cache bytecode is stored in.
+        std::atomic<std::size_t>            mCompileCount { 0 };    ///< @brief The number of scripts compiled.
+
+    };
+
+}
@@ -0,0 +1,312 @@
+/**
+ * @file    Ace/Scripting/ScriptModule.cpp
+ */
+
+#include <bit>
+#include <Ace/Scripting/ScriptModule.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    //
+    // The serialized form is little-endian throughout:
+    //
+    // | Size | Field                                                         |
+    // |------|---------------------------------------------------------------|
+    // | 4    | The magic number, `ACES`.                                     |
+    // | 2    | The bytecode version.                                         |
+    // | 8    | The source hash.                                              |
+    // | 4    | The constant count, then each constant as 8 bytes.            |
+    // | 4    | The import count, then each name as a 2-byte length and text. |
+    // | 4    | The function count, then each function's name, parameter      |
+    // |      | count (1 byte), register count (1 byte), instruction count    |
+    // |      | (4 bytes) and instructions (4 bytes each).                    |
+    //
+    static constexpr std::uint8_t MODULE_MAGIC[4] = { 'A', 'C', 'E', 'S' };
+
+    /**
+     * @brief   Appends little-endian values to a byte buffer.
+     */
+    class ModuleWriter final
+    {
+    public:
+        explicit ModuleWriter (astd::byte_buffer& pOut) : mOut { pOut } {}
+
+        template <std::unsigned_integral T>
+        void Write (const T pValue)
+        {
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                mOut.push_back(static_cast<std::uint8_t>(pValue >> (i * 8)));
+            }
+        }
+
+        void WriteString (const std::string& pText)
+        {
+            Write(static_cast<std::uint16_t>(pText.size()));
+            mOut.insert(mOut.end(), pText.begin(), pText.end());
+        }
+
+    private:
+        astd::byte_buffer& mOut;
+    };
+
+    /**
+     * @brief   Reads little-endian values from a byte span, throwing if the
+     *          span runs out.
+     */
+    class ModuleReader final
+    {
+    public:
+        explicit ModuleReader (std::span<const std::uint8_t> pIn) : mIn { pIn } {}
+
+        template <std::unsigned_integral T>
+        T Read ()
+        {
+            Require(sizeof(T));
+            T lValue = 0;
+            for (std::size_t i = 0; i < sizeof(T); ++i)
+            {
+                lValue |= static_cast<T>(static_cast<T>(mIn[mOffset++]) << (i * 8));
+            }
+
+            return lValue;
+        }
+
+        std::string ReadString ()
+        {
+            const std::size_t lSize = Read<std::uint16_t>();
+            Require(lSize);
+            std::string lText { reinterpret_cast<const char*>(mIn.data() + mOffset), lSize };
+            mOffset += lSize;
+            return lText;
+        }
+
+        std::size_t ReadCount (const std::size_t& pElementSize)
+        {
+            // Reject counts which could not possibly fit in what is left,
+            // before anything is allocated for them.
+            const std::size_t lCount = Read<std::uint32_t>();
+            Require(lCount * pElementSize);
+            return lCount;
+        }
+
+        bool IsAtEnd () const { return mOffset == mIn.size(); }
+
+    private:
+        void Require (const std::size_t& pBytes) const
+        {
+            if (pBytes > mIn.size() - mOffset)
+            {
+                ACE_THROW(std::runtime_error, "{}: Bytecode is truncated!",
+                    "ScriptModule");
+            }
+        }
+
+    private:
+        std::span<const std::uint8_t>   mIn;
+        std::size_t                     mOffset = 0;
+    };
+
+    /* Public Methods *********************************************************/
+
+    std::optional<std::size_t> ScriptModule::FindFunction (
+        std::string_view    pName
+    ) const
+    {
+        for (std::size_t i = 0; i < mFunctions.size(); ++i)
+        {
+            if (mFunctions[i].mName == pName)
+            {
+                return i;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    astd::byte_buffer ScriptModule::Serialize () const
+    {
+        astd::byte_buffer lOut;
+        ModuleWriter lWriter { lOut };
+
+        lOut.insert(lOut.end(), std::begin(MODULE_MAGIC), std::end(MODULE_MAGIC));
+        lWriter.Write(BYTECODE_VERSION);
+        lWriter.Write(mSourceHash);
+
+        lWriter.Write(static_cast<std::uint32_t>(mConstants.size()));
+        for (const double lConstant : mConstants)
+        {
+            lWriter.Write(std::bit_cast<std::uint64_t>(lConstant));
+        }
+
+        lWriter.Write(static_cast<std::uint32_t>(mImports.size()));
+        for (const auto& lImport : mImports)
+        {
+            lWriter.WriteString(lImport);
+        }
+
+        lWriter.Write(static_cast<std::uint32_t>(mFunctions.size()));
+        for (const auto& lFunction : mFunctions)
+        {
+            lWriter.WriteString(lFunction.mName);
+            lWriter.Write(lFunction.mParameterCount);
+            lWriter.Write(lFunction.mRegisterCount);
+            lWriter.Write(static_cast<std::uint32_t>(lFunction.mCode.size()));
+            for (const std::uint32_t lInstruction : lFunction.mCode)
+            {
+                lWriter.Write(lInstruction);
+            }
+        }
+
+        return lOut;
+    }
+
+    std::shared_ptr<ScriptModule> ScriptModule::Deserialize (
+        std::span<const std::uint8_t>   pData
+    )
+    {
+        ModuleReader lReader { pData };
+        for (const std::uint8_t lByte : MODULE_MAGIC)
+        {
+            if (lReader.Read<std::uint8_t>() != lByte)
+            {
+                ACE_THROW(std::runtime_error, "{}: Data is not script bytecode!",
+                    "ScriptModule");
+            }
+        }
+
+        const std::uint16_t lVersion = lReader.Read<std::uint16_t>();
+        if (lVersion != BYTECODE_VERSION)
+        {
+            ACE_THROW(std::runtime_error, "{}: Bytecode version {} is not supported!",
+                "ScriptModule", lVersion);
+        }
+
+        auto lModule = std::make_shared<ScriptModule>();
+        lModule->mSourceHash = lReader.Read<std::uint64_t>();
+
+        lModule->mConstants.resize(lReader.ReadCount(8));
+        for (double& lConstant : lModule->mConstants)
+        {
+            lConstant = std::bit_cast<double>(lReader.Read<std::uint64_t>());
+        }
+
+        lModule->mImports.resize(lReader.ReadCount(2));
+        for (auto& lImport : lModule->mImports)
+        {
+            lImport = lReader.ReadString();
+        }
+
+        lModule->mFunctions.resize(lReader.ReadCount(8));
+        for (auto& lFunction : lModule->mFunctions)
+        {
+            lFunction.mName = lReader.ReadString();
+            lFunction.mParameterCount = lReader.Read<std::uint8_t>();
+            lFunction.mRegisterCount = lReader.Read<std::uint8_t>();
+            lFunction.mCode.resize(lReader.ReadCount(4));
+            for (std::uint32_t& lInstruction : lFunction.mCode)
+            {
+                lInstruction = lReader.Read<std::uint32_t>();
+            }
+        }
+
+        if (lReader.IsAtEnd() == false)
+        {
+            ACE_THROW(std::runtime_error, "{}: Bytecode has trailing data!",
+                "ScriptModule");
+        }
+
+        lModule->Verify();
+        return lModule;
+    }
+
+    void ScriptModule::Verify () const
+    {
+        using namespace ScriptInstruction;
+
+        for (const auto& lFunction : mFunctions)
+        {
+            const auto lFail = [&] (const std::size_t& pIndex)
+            {
+                ACE_THROW(std::runtime_error, "{}: Instruction {} of '{}' is invalid!",
+                    "ScriptModule", pIndex, lFunction.mName);
+            };
+
+            const std::size_t lRegisters = lFunction.mRegisterCount;
+            if (lFunction.mParameterCount > lRegisters || lFunction.mCode.empty() == true)
+            {
+                lFail(0);
+            }
+
+            for (std::size_t i = 0; i < lFunction.mCode.size(); ++i)
+            {
+                const std::uint32_t lInstruction = lFunction.mCode[i];
+                const std::size_t lA = GetA(lInstruction);
+                const std::size_t lB = GetB(lInstruction);
+                const std::size_t lC = GetC(lInstruction);
+                const std::int64_t lTarget = static_cast<std::int64_t>(i) + 1 +
+                    GetJump(lInstruction);
+
+                bool lValid = lA < lRegisters;
+                switch (GetOpCode(lInstruction))
+                {
+                    case ScriptOpCode::LoadConstant:
+                        lValid = lValid && GetBx(lInstruction) < mConstants.size();
+                        break;
+                    case ScriptOpCode::Move:
+                    case ScriptOpCode::Negate:
+                    case ScriptOpCode::Not:
+                        lValid = lValid && lB < lRegisters;
+                        break;
+                    case ScriptOpCode::Add:
+                    case ScriptOpCode::Subtract:
+                    case ScriptOpCode::Multiply:
+                    case ScriptOpCode::Divide:
+                    case ScriptOpCode::Modulo:
+                    case ScriptOpCode::Less:
+                    case ScriptOpCode::LessEqual:
+                    case ScriptOpCode::Equal:
+                    case ScriptOpCode::NotEqual:
+                        lValid = lValid && lB < lRegisters && lC < lRegisters;
+                        break;
+                    case ScriptOpCode::Jump:
+                        lValid = true;
+                        [[fallthrough]];
+                    case ScriptOpCode::JumpIfFalse:
+                    case ScriptOpCode::JumpIfTrue:
+                        lValid = lValid && lTarget >= 0 &&
+                            lTarget < static_cast<std::int64_t>(lFunction.mCode.size());
+                        break;
+                    case ScriptOpCode::Call:
+                        lValid = lValid && lB < mFunctions.size() &&
+                            lC == mFunctions[lB].mParameterCount && lA + lC <= lRegisters;
+                        break;
+                    case ScriptOpCode::CallNative:
+                        lValid = lValid && lB < mImports.size() && lA + lC <= lRegisters;
+                        break;
+                    case ScriptOpCode::Return:
+                        break;
+                    default:
+                        lValid = false;
+                        break;
+                }
+
+                if (lValid == false)
+                {
+                    lFail(i);
+                }
+            }
+
+            // Execution must not run off the end of the code.
+            const ScriptOpCode lLast = GetOpCode(lFunction.mCode.back());
+            if (lLast != ScriptOpCode::Return && lLast != ScriptOpCode::Jump)
+            {
+                lFail(lFunction.mCode.size() - 1);
+            }
+        }
+    }
+
+}
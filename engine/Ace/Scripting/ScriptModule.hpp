@@ -0,0 +1,180 @@
+/**
+ * @file    Ace/Scripting/ScriptModule.hpp
+ * @brief   Provides the bytecode instruction set executed by the scripting
+ *          virtual machine, and a structure containing a compiled script.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the scripting virtual machine's instructions.
+     *
+     * The machine is register-based: each function call gets a window of up
+     * to 256 registers, holding its parameters first, then its locals, then
+     * its temporaries. Instructions are 32 bits wide; the opcode is in the low
+     * byte, and the operands `A`, `B` and `C` are in the bytes above it. Some
+     * instructions instead take a 16-bit operand, `Bx`, in place of `B` and
+     * `C`; jumps treat it as a signed offset, `sBx`, from the next
+     * instruction.
+     */
+    enum class ScriptOpCode : std::uint8_t
+    {
+        LoadConstant,   ///< @brief `R[A] = K[Bx]`
+        Move,           ///< @brief `R[A] = R[B]`
+        Add,            ///< @brief `R[A] = R[B] + R[C]`
+        Subtract,       ///< @brief `R[A] = R[B] - R[C]`
+        Multiply,       ///< @brief `R[A] = R[B] * R[C]`
+        Divide,         ///< @brief `R[A] = R[B] / R[C]`
+        Modulo,         ///< @brief `R[A] = fmod(R[B], R[C])`
+        Less,           ///< @brief `R[A] = R[B] < R[C]`
+        LessEqual,      ///< @brief `R[A] = R[B] <= R[C]`
+        Equal,          ///< @brief `R[A] = R[B] == R[C]`
+        NotEqual,       ///< @brief `R[A] = R[B] != R[C]`
+        Negate,         ///< @brief `R[A] = -R[B]`
+        Not,            ///< @brief `R[A] = !R[B]`
+        Jump,           ///< @brief `pc += sBx`
+        JumpIfFalse,    ///< @brief `if (!R[A]) pc += sBx`
+        JumpIfTrue,     ///< @brief `if (R[A]) pc += sBx`
+        Call,           ///< @brief `R[A] = F[B](R[A], ..., R[A + C - 1])`
+        CallNative,     ///< @brief `R[A] = N[B](R[A], ..., R[A + C - 1])`
+        Return,         ///< @brief `return R[A]`
+
+        Count
+    };
+
+    /**
+     * @brief   Provides functions which pack and unpack the fields of a
+     *          scripting virtual machine instruction.
+     */
+    namespace ScriptInstruction
+    {
+        constexpr std::int32_t JUMP_BIAS = 0x7FFF;
+
+        constexpr std::uint32_t Make (
+            const ScriptOpCode  pOpCode,
+            const std::uint32_t pA = 0,
+            const std::uint32_t pB = 0,
+            const std::uint32_t pC = 0
+        )
+        {
+            return static_cast<std::uint32_t>(pOpCode) | (pA << 8) | (pB << 16) | (pC << 24);
+        }
+
+        constexpr std::uint32_t MakeBx (
+            const ScriptOpCode  pOpCode,
+            const std::uint32_t pA,
+            const std::uint32_t pBx
+        )
+        {
+            return static_cast<std::uint32_t>(pOpCode) | (pA << 8) | (pBx << 16);
+        }
+
+        constexpr std::uint32_t MakeJump (
+            const ScriptOpCode  pOpCode,
+            const std::uint32_t pA,
+            const std::int32_t  pOffset
+        )
+        {
+            return MakeBx(pOpCode, pA, static_cast<std::uint32_t>(pOffset + JUMP_BIAS));
+        }
+
+        constexpr ScriptOpCode GetOpCode (const std::uint32_t pInstruction)
+            { return static_cast<ScriptOpCode>(pInstruction & 0xFF); }
+        constexpr std::uint32_t GetA (const std::uint32_t pInstruction)
+            { return (pInstruction >> 8) & 0xFF; }
+        constexpr std::uint32_t GetB (const std::uint32_t pInstruction)
+            { return (pInstruction >> 16) & 0xFF; }
+        constexpr std::uint32_t GetC (const std::uint32_t pInstruction)
+            { return pInstruction >> 24; }
+        constexpr std::uint32_t GetBx (const std::uint32_t pInstruction)
+            { return pInstruction >> 16; }
+        constexpr std::int32_t GetJump (const std::uint32_t pInstruction)
+            { return static_cast<std::int32_t>(pInstruction >> 16) - JUMP_BIAS; }
+    }
+
+    /**
+     * @brief   A structure containing one compiled script function.
+     */
+    struct ScriptFunction
+    {
+        std::string                 mName;                  ///< @brief The function's name.
+        std::uint8_t                mParameterCount = 0;    ///< @brief The number of parameters, held in the first registers.
+        std::uint8_t                mRegisterCount = 0;     ///< @brief The number of registers a call uses.
+        std::vector<std::uint32_t>  mCode;                  ///< @brief The function's instructions.
+    };
+
+    /**
+     * @brief   A structure containing a compiled script: its functions, the
+     *          constants they load, and the names of the native functions they
+     *          call, which are bound when the module is linked into a
+     *          @a `ScriptVM`.
+     *
+     * Modules can be serialized to a compact binary form, so that compiled
+     * bytecode can be cached rather than recompiled. Deserialized modules are
+     * verified before use, so that damaged bytecode cannot make the virtual
+     * machine read or jump out of bounds.
+     */
+    struct ACE_API ScriptModule
+    {
+
+        /**
+         * @brief   The version of the bytecode format. Bumped whenever the
+         *          instruction set, the serialized form or the compiler's
+         *          output changes, so that stale cached bytecode is rejected.
+         */
+        static constexpr std::uint16_t BYTECODE_VERSION = 1;
+
+        std::uint64_t               mSourceHash = 0;    ///< @brief The @a `ContentHash64` of the source the module was compiled from.
+        std::vector<double>         mConstants;         ///< @brief The constants loaded by the functions.
+        std::vector<std::string>    mImports;           ///< @brief The names of the native functions called.
+        std::vector<ScriptFunction> mFunctions;         ///< @brief The module's functions.
+
+        /**
+         * @brief   Finds a function by name.
+         *
+         * @param   pName   The function's name.
+         *
+         * @return  An `std::optional` which contains the function's index, if
+         *          found.
+         */
+        std::optional<std::size_t> FindFunction (
+            std::string_view    pName
+        ) const;
+
+        /**
+         * @brief   Serializes the module into its binary form.
+         *
+         * @return  The serialized module.
+         */
+        astd::byte_buffer Serialize () const;
+
+        /**
+         * @brief   Deserializes and verifies a module.
+         *
+         * @param   pData   The serialized module.
+         *
+         * @return  The module.
+         *
+         * @throw   `std::runtime_error` if the data is truncated, was written
+         *          by a different bytecode version, or fails verification.
+         */
+        static std::shared_ptr<ScriptModule> Deserialize (
+            std::span<const std::uint8_t>   pData
+        );
+
+        /**
+         * @brief   Verifies that every instruction's operands are in bounds,
+         *          and that no function can run past the end of its code.
+         *
+         * @throw   `std::runtime_error` if verification fails.
+         */
+        void Verify () const;
+
+    };
+
+}
@@ -0,0 +1,288 @@
+/**
+ * @file    Ace/Scripting/ScriptVM.cpp
+ */
+
+#include <cmath>
+#include <Ace/Scripting/ScriptVM.hpp>
+
+namespace ace
+{
+
+    /* Helper Types ***********************************************************/
+
+    /**
+     * @brief   Marks a machine as running for as long as it is in scope, even
+     *          if the script throws.
+     */
+    class ScriptRunGuard final
+    {
+    public:
+        explicit ScriptRunGuard (bool& pRunning) :
+            mRunning { pRunning }
+        {
+            if (mRunning == true)
+            {
+                ACE_THROW(std::runtime_error, "{}: Native functions must not call "
+                    "back into the machine running them!", "ScriptVM");
+            }
+
+            mRunning = true;
+        }
+
+        ~ScriptRunGuard ()
+        {
+            mRunning = false;
+        }
+
+    private:
+        bool& mRunning;
+    };
+
+    /* Constructors and Destructor ********************************************/
+
+    ScriptVM::ScriptVM () :
+        mRegisters  ( REGISTER_COUNT, 0.0 ),
+        mFrames     ( MAX_CALL_DEPTH )
+    {}
+
+    /* Public Methods *********************************************************/
+
+    void ScriptVM::RegisterNative (
+        const std::string&  pName,
+        NativeFunction      pFunction
+    )
+    {
+        mNatives[pName] = std::move(pFunction);
+    }
+
+    std::uint32_t ScriptVM::Link (
+        std::shared_ptr<const ScriptModule> pModule
+    )
+    {
+        if (pModule == nullptr)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Module is null!", "ScriptVM");
+        }
+
+        LinkedModule lLinked;
+        lLinked.mImports.reserve(pModule->mImports.size());
+        for (const auto& lImport : pModule->mImports)
+        {
+            auto lIter = mNatives.find(lImport);
+            if (lIter == mNatives.end())
+            {
+                ACE_THROW(std::runtime_error, "{}: Native function '{}' is not registered!",
+                    "ScriptVM", lImport);
+            }
+
+            // Map nodes never move, so the binding outlives later registrations.
+            lLinked.mImports.push_back(&lIter->second);
+        }
+
+        lLinked.mModule = std::move(pModule);
+        mModules.push_back(std::move(lLinked));
+        return static_cast<std::uint32_t>(mModules.size() - 1);
+    }
+
+    std::optional<ScriptFunctionRef> ScriptVM::FindFunction (
+        const std::uint32_t pModule,
+        std::string_view    pName
+    ) const
+    {
+        if (pModule >= mModules.size())
+        {
+            return std::nullopt;
+        }
+
+        auto lIndex = mModules[pModule].mModule->FindFunction(pName);
+        if (lIndex.has_value() == false)
+        {
+            return std::nullopt;
+        }
+
+        return ScriptFunctionRef { pModule, static_cast<std::uint32_t>(*lIndex) };
+    }
+
+    double ScriptVM::Call (
+        const ScriptFunctionRef&    pFunction,
+        std::span<const double>     pArguments
+    )
+    {
+        const ScriptFunction& lFunction = Prepare(pFunction, pArguments.size());
+        ScriptRunGuard lGuard { mRunning };
+
+        std::copy(pArguments.begin(), pArguments.end(), mRegisters.begin());
+        return Execute(mModules[pFunction.mModule], lFunction);
+    }
+
+    void ScriptVM::CallBatch (
+        const ScriptFunctionRef&    pFunction,
+        std::span<const double>     pArguments,
+        std::span<double>           pResults
+    )
+    {
+        const ScriptFunction& lFunction = Prepare(pFunction,
+            pResults.empty() ? 0 : pArguments.size() / pResults.size());
+        if (pArguments.size() != pResults.size() * lFunction.mParameterCount)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Expected {} arguments for {} calls of '{}'; "
+                "got {}!", "ScriptVM", pResults.size() * lFunction.mParameterCount,
+                pResults.size(), lFunction.mName, pArguments.size());
+        }
+
+        ScriptRunGuard lGuard { mRunning };
+        const LinkedModule& lModule = mModules[pFunction.mModule];
+        const std::size_t lArity = lFunction.mParameterCount;
+        for (std::size_t i = 0; i < pResults.size(); ++i)
+        {
+            std::copy_n(pArguments.begin() + i * lArity, lArity, mRegisters.begin());
+            pResults[i] = Execute(lModule, lFunction);
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    const ScriptFunction& ScriptVM::Prepare (
+        const ScriptFunctionRef&    pFunction,
+        const std::size_t&          pArgumentCount
+    ) const
+    {
+        if (
+            pFunction.mModule >= mModules.size() ||
+            pFunction.mFunction >= mModules[pFunction.mModule].mModule->mFunctions.size()
+        )
+        {
+            ACE_THROW(std::invalid_argument, "{}: Function reference is invalid!",
+                "ScriptVM");
+        }
+
+        const ScriptFunction& lFunction =
+            mModules[pFunction.mModule].mModule->mFunctions[pFunction.mFunction];
+        if (pArgumentCount != lFunction.mParameterCount)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Function '{}' takes {} arguments; got {}!",
+                "ScriptVM", lFunction.mName, lFunction.mParameterCount, pArgumentCount);
+        }
+
+        return lFunction;
+    }
+
+    double ScriptVM::Execute (
+        const LinkedModule&     pModule,
+        const ScriptFunction&   pFunction
+    )
+    {
+        using namespace ScriptInstruction;
+
+        const ScriptFunction* lFunctions = pModule.mModule->mFunctions.data();
+        const double* lConstants = pModule.mModule->mConstants.data();
+        const double* lEnd = mRegisters.data() + mRegisters.size();
+
+        const std::uint32_t* lProgramCounter = pFunction.mCode.data();
+        double* lRegisters = mRegisters.data();
+        std::size_t lDepth = 0;
+        std::uint64_t lCount = 0;
+
+        while (true)
+        {
+            const std::uint32_t lInstruction = *lProgramCounter++;
+            const std::uint32_t lA = GetA(lInstruction);
+            ++lCount;
+
+            switch (GetOpCode(lInstruction))
+            {
+                case ScriptOpCode::LoadConstant:
+                    lRegisters[lA] = lConstants[GetBx(lInstruction)];
+                    break;
+                case ScriptOpCode::Move:
+                    lRegisters[lA] = lRegisters[GetB(lInstruction)];
+                    break;
+                case ScriptOpCode::Add:
+                    lRegisters[lA] = lRegisters[GetB(lInstruction)] + lRegisters[GetC(lInstruction)];
+                    break;
+                case ScriptOpCode::Subtract:
+                    lRegisters[lA] = lRegisters[GetB(lInstruction)] - lRegisters[GetC(lInstruction)];
+                    break;
+                case ScriptOpCode::Multiply:
+                    lRegisters[lA] = lRegisters[GetB(lInstruction)] * lRegisters[GetC(lInstruction)];
+                    break;
+                case ScriptOpCode::Divide:
+                    lRegisters[lA] = lRegisters[GetB(lInstruction)] / lRegisters[GetC(lInstruction)];
+                    break;
+                case ScriptOpCode::Modulo:
+                    lRegisters[lA] = std::fmod(lRegisters[GetB(lInstruction)],
+                        lRegisters[GetC(lInstruction)]);
+                    break;
+                case ScriptOpCode::Less:
+                    lRegisters[lA] = (lRegisters[GetB(lInstruction)] < lRegisters[GetC(lInstruction)]) ? 1.0 : 0.0;
+                    break;
+                case ScriptOpCode::LessEqual:
+                    lRegisters[lA] = (lRegisters[GetB(lInstruction)] <= lRegisters[GetC(lInstruction)]) ? 1.0 : 0.0;
+                    break;
+                case ScriptOpCode::Equal:
+                    lRegisters[lA] = (lRegisters[GetB(lInstruction)] == lRegisters[GetC(lInstruction)]) ? 1.0 : 0.0;
+                    break;
+                case ScriptOpCode::NotEqual:
+                    lRegisters[lA] = (lRegisters[GetB(lInstruction)] != lRegisters[GetC(lInstruction)]) ? 1.0 : 0.0;
+                    break;
+                case ScriptOpCode::Negate:
+                    lRegisters[lA] = -lRegisters[GetB(lInstruction)];
+                    break;
+                case ScriptOpCode::Not:
+                    lRegisters[lA] = (lRegisters[GetB(lInstruction)] == 0.0) ? 1.0 : 0.0;
+                    break;
+                case ScriptOpCode::Jump:
+                    lProgramCounter += GetJump(lInstruction);
+                    break;
+                case ScriptOpCode::JumpIfFalse:
+                    if (lRegisters[lA] == 0.0) { lProgramCounter += GetJump(lInstruction); }
+                    break;
+                case ScriptOpCode::JumpIfTrue:
+                    if (lRegisters[lA] != 0.0) { lProgramCounter += GetJump(lInstruction); }
+                    break;
+                case ScriptOpCode::Call:
+                {
+                    // The callee's window starts at its first argument, so
+                    // the arguments are already in its parameter registers.
+                    const ScriptFunction& lCallee = lFunctions[GetB(lInstruction)];
+                    double* lCalleeRegisters = lRegisters + lA;
+                    if (lDepth == MAX_CALL_DEPTH || lCalleeRegisters + lCallee.mRegisterCount > lEnd)
+                    {
+                        mInstructionCount += lCount;
+                        ACE_THROW(std::runtime_error, "{}: Call stack overflow in '{}'!",
+                            "ScriptVM", lCallee.mName);
+                    }
+
+                    mFrames[lDepth++] = { lProgramCounter, lRegisters };
+                    lProgramCounter = lCallee.mCode.data();
+                    lRegisters = lCalleeRegisters;
+                    break;
+                }
+                case ScriptOpCode::CallNative:
+                    lRegisters[lA] = (*pModule.mImports[GetB(lInstruction)])(
+                        std::span<const double> { lRegisters + lA, GetC(lInstruction) });
+                    break;
+                case ScriptOpCode::Return:
+                {
+                    const double lValue = lRegisters[lA];
+                    if (lDepth == 0)
+                    {
+                        mInstructionCount += lCount;
+                        return lValue;
+                    }
+
+                    // The result replaces the first argument, which is the
+                    // caller's destination register.
+                    lRegisters[0] = lValue;
+                    const Frame& lFrame = mFrames[--lDepth];
+                    lProgramCounter = lFrame.mProgramCounter;
+                    lRegisters = lFrame.mRegisters;
+                    break;
+                }
+                default:
+                    break;
+            }
+        }
+    }
+
+}
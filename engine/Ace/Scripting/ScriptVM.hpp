@@ -0,0 +1,220 @@
+/**
+ * @file    Ace/Scripting/ScriptVM.hpp
+ * @brief   Provides a register-based virtual machine which runs compiled
+ *          scripts.
+ */
+
+#pragma once
+#include <Ace/Scripting/ScriptModule.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure identifying a script function linked into a
+     *          @a `ScriptVM`.
+     */
+    struct ScriptFunctionRef
+    {
+        std::uint32_t   mModule = 0;        ///< @brief The index of the linked module.
+        std::uint32_t   mFunction = 0;      ///< @brief The index of the function in the module.
+    };
+
+    /**
+     * @brief   A register-based virtual machine which runs the bytecode of
+     *          linked @a `ScriptModule`s.
+     *
+     * Native functions are registered by name, then bound to the imports of
+     * each module as it is linked, so that a call from a script is an indexed
+     * call with no lookup. Their arguments are passed as a span over the
+     * caller's registers, without copying.
+     *
+     * All registers and call frames are allocated once, when the machine is
+     * constructed. Calling a script function from native code, with @a `Call`
+     * or @a `CallBatch`, therefore never allocates; @a `CallBatch` also
+     * amortizes the cost of entering the machine over many calls.
+     *
+     * A machine is not thread-safe, and is not re-entrant: native functions
+     * must not call back into the machine running them. Use one machine per
+     * thread to run scripts in parallel; linked modules may be shared.
+     */
+    class ACE_API ScriptVM final
+    {
+    public:
+
+        /**
+         * @brief   The signature of a native function callable from scripts.
+         */
+        using NativeFunction = std::function<double (std::span<const double>)>;
+
+        /**
+         * @brief   The deepest nesting of script calls allowed.
+         */
+        static constexpr std::size_t MAX_CALL_DEPTH = 256;
+
+        /**
+         * @brief   The number of registers shared by every call frame.
+         */
+        static constexpr std::size_t REGISTER_COUNT = 16384;
+
+    public:
+
+        /**
+         * @brief   Constructs a machine with no natives or linked modules.
+         */
+        ScriptVM ();
+
+    public:
+
+        /**
+         * @brief   Registers a native function, replacing any already
+         *          registered under the same name. Only modules linked
+         *          afterwards can call it.
+         *
+         * @param   pName       The name scripts call the function by.
+         * @param   pFunction   The function.
+         */
+        void RegisterNative (
+            const std::string&  pName,
+            NativeFunction      pFunction
+        );
+
+        /**
+         * @brief   Links a module, binding its imports to registered native
+         *          functions.
+         *
+         * @param   pModule     The module to link.
+         *
+         * @return  The index of the linked module.
+         *
+         * @throw   `std::invalid_argument` if the module is `nullptr`.
+         * @throw   `std::runtime_error` if the module imports a native
+         *          function which has not been registered.
+         */
+        std::uint32_t Link (
+            std::shared_ptr<const ScriptModule> pModule
+        );
+
+        /**
+         * @brief   Finds a function in a linked module by name.
+         *
+         * @param   pModule     The index of the linked module.
+         * @param   pName       The function's name.
+         *
+         * @return  An `std::optional` which contains a reference to the
+         *          function, if found.
+         */
+        std::optional<ScriptFunctionRef> FindFunction (
+            const std::uint32_t pModule,
+            std::string_view    pName
+        ) const;
+
+        /**
+         * @brief   Calls a script function.
+         *
+         * @param   pFunction   The function to call.
+         * @param   pArguments  The function's arguments.
+         *
+         * @return  The function's return value.
+         *
+         * @throw   `std::invalid_argument` if the function does not exist, or
+         *          takes a different number of arguments.
+         * @throw   `std::runtime_error` if the calls nest too deeply, or the
+         *          machine is already running.
+         */
+        double Call (
+            const ScriptFunctionRef&    pFunction,
+            std::span<const double>     pArguments
+        );
+
+        /**
+         * @brief   Calls a script function once for each set of arguments.
+         *
+         * @param   pFunction   The function to call.
+         * @param   pArguments  The arguments of every call, one set after
+         *                      another.
+         * @param   pResults    Receives each call's return value. There must
+         *                      be one set of arguments per result.
+         *
+         * @throw   `std::invalid_argument` if the function does not exist, or
+         *          the argument count does not match.
+         * @throw   `std::runtime_error` if the calls nest too deeply, or the
+         *          machine is already running.
+         */
+        void CallBatch (
+            const ScriptFunctionRef&    pFunction,
+            std::span<const double>     pArguments,
+            std::span<double>           pResults
+        );
+
+        /**
+         * @brief   Retrieves the total number of instructions executed so far.
+         *
+         * @return  The number of instructions executed.
+         */
+        inline std::uint64_t GetInstructionCount () const
+        {
+            return mInstructionCount;
+        }
+
+    private:
+        ScriptVM (const ScriptVM&) = delete;
+        ScriptVM (ScriptVM&&) = delete;
+        void operator= (const ScriptVM&) = delete;
+        void operator= (ScriptVM&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing a linked module.
+         */
+        struct LinkedModule
+        {
+            std::shared_ptr<const ScriptModule>     mModule;    ///< @brief The module.
+            std::vector<const NativeFunction*>      mImports;   ///< @brief The natives bound to its imports.
+        };
+
+        /**
+         * @brief   A structure containing the state of a suspended caller.
+         */
+        struct Frame
+        {
+            const std::uint32_t*    mProgramCounter = nullptr;  ///< @brief The caller's next instruction.
+            double*                 mRegisters = nullptr;       ///< @brief The caller's register window.
+        };
+
+    private:
+
+        /**
+         * @brief   Checks a function reference and argument count before a
+         *          call from native code.
+         *
+         * @return  The function to call.
+         */
+        const ScriptFunction& Prepare (
+            const ScriptFunctionRef&    pFunction,
+            const std::size_t&          pArgumentCount
+        ) const;
+
+        /**
+         * @brief   Runs a function whose arguments are in the first registers,
+         *          until it returns.
+         *
+         * @return  The function's return value.
+         */
+        double Execute (
+            const LinkedModule&     pModule,
+            const ScriptFunction&   pFunction
+        );
+
+    private:
+        std::unordered_map<std::string, NativeFunction>     mNatives;                   ///< @brief The registered native functions, by name.
+        std::vector<LinkedModule>                           mModules;                   ///< @brief The linked modules.
+        std::vector<double>                                 mRegisters;                 ///< @brief The register file shared by every call frame.
+        std::vector<Frame>                                  mFrames;                    ///< @brief The suspended callers.
+        std::uint64_t                                       mInstructionCount = 0;      ///< @brief The number of instructions executed.
+        bool                                                mRunning = false;           ///< @brief Is the machine executing?
+
+    };
+
+}
@@ -4,6 +4,7 @@
  */
 
 #pragma once
+#include <Ace/System/ConcurrentSkipList.hpp>
 #include <Ace/System/ThreadPool.hpp>
 #include <Ace/System/VirtualFilesystem.hpp>
 
@@ -117,6 +118,7 @@ namespace ace
          * @brief   Loads an asset's data from a virtual file loaded from the
          *          virtual filesystem (VFS).
          * 
+         * @param   pLogicalPath    The asset file's logical path string.
          * @param   pVirtualFile    An `std::unique_ptr` to the opened virtual
          *                          file.
          * 
@@ -124,6 +126,7 @@ namespace ace
          *          `nullptr` otherwise.
          */
         virtual std::shared_ptr<T> Load (
+            const std::string&            pLogicalPath,
             std::unique_ptr<IVirtualFile> pVirtualFile
         ) = 0;
 
@@ -154,20 +157,10 @@ namespace ace
             const std::size_t&                  pPriority = 0
         )
         {
-            // Under a lock, register the asset loader.
-            std::lock_guard lGuard { sLoadersMutex };
-
-            // Emplace the loader into the loader list, then re-sort the list
-            // based on the loaders' priority values.
-            LoaderList<T>::sLoaders.emplace_back(pPriority, pLoader);
-            std::sort(
-                LoaderList<T>::sLoaders.begin(),
-                LoaderList<T>::sLoaders.end(),
-                [] (auto& pFirst, auto& pSecond)
-                {
-                    return pFirst.first > pSecond.first;
-                }
-            );
+            // Insert the loader into the loader list, which keeps it ordered by
+            // priority, and by registration order among equal priorities.
+            const std::size_t lSequence = sLoaderSequence.fetch_add(1, std::memory_order_relaxed);
+            LoaderList<T>::sLoaders.TryEmplace({ pPriority, lSequence }, std::move(pLoader));
         }
 
         /**
@@ -212,15 +205,15 @@ namespace ace
                 return AssetHandle<T> {};
             }
 
-            // Under a lock, get a snapshot of the appropriate loaders list.
+            // Get a snapshot of the appropriate loaders list. The list is never
+            // locked, so loaders may be registered while this is underway.
             std::vector<std::shared_ptr<IAssetLoader<T>>> lLoaderSnapshot;
-            {
-                std::lock_guard lGuard { sLoadersMutex };
-                for (auto& [_, lLoader] : LoaderList<T>::sLoaders)
+            LoaderList<T>::sLoaders.ForEach(
+                [&lLoaderSnapshot] (const LoaderKey&, const std::shared_ptr<IAssetLoader<T>>& pLoader)
                 {
-                    lLoaderSnapshot.push_back(lLoader);
+                    lLoaderSnapshot.push_back(pLoader);
                 }
-            }
+            );
 
 
             // Iterate over the loaders in the snapshot, looking for the
@@ -235,7 +228,7 @@ namespace ace
 
                     // Attempt to load the asset file.
                     auto lAssetData = std::static_pointer_cast<T>(
-                        lLoader->Load(std::move(lAssetFile))
+                        lLoader->Load(pLogicalPath, std::move(lAssetFile))
                     );
                     if (lAssetData == nullptr)
                     {
@@ -315,6 +308,26 @@ namespace ace
 
     private:
 
+        /**
+         * @brief   The key a loader is registered under: its priority, and the
+         *          order it was registered in.
+         */
+        using LoaderKey = std::pair<std::size_t, std::size_t>;
+
+        /**
+         * @brief   Orders loaders by descending priority, then by ascending
+         *          registration order.
+         */
+        struct LoaderOrder
+        {
+            inline bool operator () (const LoaderKey& pFirst, const LoaderKey& pSecond) const noexcept
+            {
+                return (pFirst.first != pSecond.first) ?
+                    pFirst.first > pSecond.first :
+                    pFirst.second < pSecond.second;
+            }
+        };
+
         /**
          * @brief   A templated static structure containing the map of
          *          registered asset loaders.
@@ -325,9 +338,10 @@ namespace ace
         template <typename T>
         struct LoaderList
         {
-            static inline astd::vector_map<
-                std::size_t,
-                std::shared_ptr<IAssetLoader<T>>
+            static inline ConcurrentSkipList<
+                LoaderKey,
+                std::shared_ptr<IAssetLoader<T>>,
+                LoaderOrder
             > sLoaders;
         };
 
@@ -372,9 +386,10 @@ namespace ace
         > sCache;
 
         /**
-         * @brief   The mutex used to lock down the asset registry's loader map.
+         * @brief   Counts loader registrations, to order loaders of equal
+         *          priority.
          */
-        static inline std::mutex sLoadersMutex;
+        static inline std::atomic<std::size_t> sLoaderSequence { 0 };
 
         /**
          * @brief   The mutex used to lock down the asset registry's cache map.
@@ -0,0 +1,188 @@
+/**
+ * @file    Ace/System/ConcurrentFreeList.hpp
+ * @brief   Provides a lock-free stack of free slot indices, for pools shared
+ *          by many threads.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class which tracks the free slots of a fixed-size pool in a
+     *          lock-free stack.
+     *
+     * The stack is intrusive: each slot's index links to the slot below it,
+     * in an array allocated once, so pushing and popping never allocate. The
+     * top of the stack is packed, with a tag which is bumped on every change,
+     * into a single 64-bit atomic. This stops a pop from succeeding against a
+     * top which was popped and pushed back by another thread in the meantime
+     * (the ABA problem), without any need to reclaim memory.
+     *
+     * The most recently freed slot is handed out first, which keeps pools'
+     * hot slots in the cache.
+     */
+    class ACE_API ConcurrentFreeList final
+    {
+    public:
+
+        /**
+         * @brief   The index which marks a slot as absent.
+         */
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+    public:
+
+        /**
+         * @brief   Constructs a free list of the given number of slots, every
+         *          one of them free.
+         *
+         * @param   pCapacity   The number of slots.
+         *
+         * @throw   `std::invalid_argument` if the capacity is zero, or does not
+         *          fit in 32 bits.
+         */
+        explicit ConcurrentFreeList (
+            const std::size_t&  pCapacity
+        ) :
+            mCapacity   { pCapacity }
+        {
+            if (pCapacity == 0 || pCapacity >= NONE)
+            {
+                ACE_THROW(std::invalid_argument, "{}: Capacity must be between 1 and {}!",
+                    "ConcurrentFreeList", NONE - 1);
+            }
+
+            // Link every slot to the next, so that slot zero is handed out
+            // first.
+            mNext = std::make_unique<std::atomic<std::uint32_t>[]>(pCapacity);
+            for (std::size_t i = 0; i < pCapacity; ++i)
+            {
+                mNext[i].store((i + 1 < pCapacity) ? static_cast<std::uint32_t>(i + 1) : NONE,
+                    std::memory_order_relaxed);
+            }
+
+            mHead.store(Pack(0, 0), std::memory_order_relaxed);
+            mFreeCount.store(pCapacity, std::memory_order_relaxed);
+        }
+
+    public:
+
+        /**
+         * @brief   Takes a free slot off the stack.
+         *
+         * @return  The slot's index, or @a `NONE` if every slot is in use.
+         */
+        std::uint32_t Pop () noexcept
+        {
+            std::uint64_t lHead = mHead.load(std::memory_order_acquire);
+            while (true)
+            {
+                const std::uint32_t lIndex = Unpack(lHead);
+                if (lIndex == NONE)
+                {
+                    return NONE;
+                }
+
+                // The slot's link may be stale if another thread has popped it
+                // since; the tag makes the exchange below fail if so.
+                const std::uint32_t lNext = mNext[lIndex].load(std::memory_order_relaxed);
+                if (
+                    mHead.compare_exchange_weak(lHead, Pack(lNext, Tag(lHead) + 1),
+                        std::memory_order_acquire, std::memory_order_acquire) == true
+                )
+                {
+                    mFreeCount.fetch_sub(1, std::memory_order_relaxed);
+                    return lIndex;
+                }
+            }
+        }
+
+        /**
+         * @brief   Puts a slot back on the stack.
+         *
+         * @param   pIndex  The slot's index. Must have been returned by
+         *                  @a `Pop`, and not pushed back since.
+         */
+        void Push (
+            const std::uint32_t pIndex
+        ) noexcept
+        {
+            mFreeCount.fetch_add(1, std::memory_order_relaxed);
+
+            std::uint64_t lHead = mHead.load(std::memory_order_relaxed);
+            do
+            {
+                mNext[pIndex].store(Unpack(lHead), std::memory_order_relaxed);
+            }
+            while (
+                mHead.compare_exchange_weak(lHead, Pack(pIndex, Tag(lHead) + 1),
+                    std::memory_order_release, std::memory_order_relaxed) == false
+            );
+        }
+
+        /**
+         * @brief   Retrieves the number of slots.
+         *
+         * @return  The free list's capacity.
+         */
+        inline std::size_t GetCapacity () const noexcept
+        {
+            return mCapacity;
+        }
+
+        /**
+         * @brief   Retrieves the number of free slots. Only a snapshot, while
+         *          other threads are pushing and popping.
+         *
+         * @return  The number of slots on the stack.
+         */
+        inline std::size_t GetFreeCount () const noexcept
+        {
+            return mFreeCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        ConcurrentFreeList (const ConcurrentFreeList&) = delete;
+        ConcurrentFreeList (ConcurrentFreeList&&) = delete;
+        void operator= (const ConcurrentFreeList&) = delete;
+        void operator= (ConcurrentFreeList&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Packs a slot index and a tag into the top of the stack.
+         */
+        static constexpr std::uint64_t Pack (
+            const std::uint32_t pIndex,
+            const std::uint32_t pTag
+        ) noexcept
+        {
+            return (static_cast<std::uint64_t>(pTag) << 32) | pIndex;
+        }
+
+        static constexpr std::uint32_t Unpack (
+            const std::uint64_t pHead
+        ) noexcept
+        {
+            return static_cast<std::uint32_t>(pHead);
+        }
+
+        static constexpr std::uint32_t Tag (
+            const std::uint64_t pHead
+        ) noexcept
+        {
+            return static_cast<std::uint32_t>(pHead >> 32);
+        }
+
+    private:
+                    std::size_t                                     mCapacity = 0;      ///< @brief The number of slots.
+                    std::unique_ptr<std::atomic<std::uint32_t>[]>   mNext;              ///< @brief Each free slot's link to the slot below it.
+        alignas(64) std::atomic<std::uint64_t>                      mHead { 0 };        ///< @brief The top slot and its tag.
+        alignas(64) std::atomic<std::size_t>                        mFreeCount { 0 };   ///< @brief The number of free slots.
+
+    };
+
+}
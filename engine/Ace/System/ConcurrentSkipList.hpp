@@ -0,0 +1,516 @@
+/**
+ * @file    Ace/System/ConcurrentSkipList.hpp
+ * @brief   Provides an ordered map which many threads can insert into, erase
+ *          from and search at once, without locks.
+ */
+
+#pragma once
+#include <bit>
+#include <utility>
+#include <Ace/System/EpochReclaimer.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A container class used for storing key-value pairs in a
+     *          lock-free skip list, ordered by key.
+     *
+     * Each entry is a node linked into the bottom level of the list, in key
+     * order, and into a random number of the levels above it, each of which
+     * skips over roughly three in four of the nodes on the level below. A
+     * search starts on the top level and drops a level whenever the next node
+     * is past the key, which takes logarithmic time on average.
+     *
+     * Inserting links the new node into each of its levels with a single
+     * compare-and-swap, bottom level first; the node is in the map as soon as
+     * it is linked into the bottom level. Erasing first marks each of the
+     * node's links, top level first, so that nothing more can be linked after
+     * it; the thread which marks the bottom link owns the erase. The node is
+     * then unlinked from every level, by the eraser or by any search which
+     * passes it, and handed to the @a `EpochReclaimer`. An erase of an entry
+     * whose insert is still linking its upper levels waits for the insert to
+     * finish.
+     *
+     * Every method enters an @a `EpochGuard` of its own. A pointer to a value
+     * returned by the map stays valid only while the caller holds a guard of
+     * its own, or for as long as the entry is not erased.
+     *
+     * Whether a value may be modified once inserted is up to its type; the
+     * map only guards its own structure.
+     *
+     * @tparam  K           The type of key. Must be copy-constructible.
+     * @tparam  V           The type of value.
+     * @tparam  Compare     The ordering of keys.
+     */
+    template <typename K, typename V, typename Compare = std::less<K>>
+    class ConcurrentSkipList final
+    {
+    public:
+
+        /**
+         * @brief   The most levels a node may be linked into.
+         */
+        static constexpr std::size_t MAX_LEVEL_COUNT = 20;
+
+    private:
+
+        /**
+         * @brief   A structure containing one entry, and its links on each of
+         *          its levels. The low bit of a link marks the node as erased
+         *          on that level.
+         */
+        struct Node
+        {
+            K                                               mKey;               ///< @brief The entry's key.
+            V                                               mValue;             ///< @brief The entry's value.
+            std::size_t                                     mLevelCount = 0;    ///< @brief The number of levels the node is linked into.
+            std::atomic<bool>                               mLinked { false };  ///< @brief Has the node been linked into all of its levels?
+            std::unique_ptr<std::atomic<std::uintptr_t>[]>  mNext;              ///< @brief The next node on each of the node's levels, and its mark.
+
+            template <typename... Args>
+            Node (
+                const std::size_t&  pLevelCount,
+                const K&            pKey,
+                Args&&...           pArgs
+            ) :
+                mKey        { pKey },
+                mValue      ( std::forward<Args>(pArgs)... ),
+                mLevelCount { pLevelCount },
+                mNext       { std::make_unique<std::atomic<std::uintptr_t>[]>(pLevelCount) }
+            {}
+        };
+
+        /**
+         * @brief   The predecessor's link and the successor on each level, on
+         *          either side of a key.
+         */
+        using Splice = std::pair<
+            std::array<std::atomic<std::uintptr_t>*, MAX_LEVEL_COUNT>,
+            std::array<Node*, MAX_LEVEL_COUNT>
+        >;
+
+    public:
+
+        /**
+         * @brief   Constructs an empty map.
+         *
+         * @param   pCompare    The ordering of keys.
+         */
+        explicit ConcurrentSkipList (
+            Compare pCompare = Compare {}
+        ) :
+            mCompare    { std::move(pCompare) }
+        {
+            for (auto& lNext : mHead)
+            {
+                lNext.store(0, std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * @brief   Destroys every entry still linked in. Must not race with any
+         *          other use of the map. Erased entries are freed by the
+         *          @a `EpochReclaimer`.
+         */
+        ~ConcurrentSkipList ()
+        {
+            Node* lNode = GetNode(mHead[0].load(std::memory_order_acquire));
+            while (lNode != nullptr)
+            {
+                Node* lNext = GetNode(lNode->mNext[0].load(std::memory_order_relaxed));
+                delete lNode;
+                lNode = lNext;
+            }
+        }
+
+    public:
+
+        /**
+         * @brief   Inserts an entry, with its value constructed in place, if
+         *          no entry with an equal key exists yet.
+         *
+         * @param   pKey    The entry's key.
+         * @param   pArgs   The arguments to construct the value with.
+         *
+         * @return  A pair of a pointer to the value of the entry with the key,
+         *          and `true` if it was inserted by this call; `false` if it
+         *          already existed.
+         */
+        template <typename... Args>
+        std::pair<V*, bool> TryEmplace (
+            const K&    pKey,
+            Args&&...   pArgs
+        )
+        {
+            EpochGuard lGuard;
+            Splice lSplice;
+            if (Node* lFound = FindSplice(pKey, lSplice))
+            {
+                return { &lFound->mValue, false };
+            }
+
+            auto lNode = std::make_unique<Node>(RandomLevelCount(), pKey,
+                std::forward<Args>(pArgs)...);
+
+            // Link the node into the bottom level. Until this succeeds, the
+            // node is not in the map; if an equal key beats it in, it is
+            // discarded.
+            while (true)
+            {
+                lNode->mNext[0].store(ToLink(lSplice.second[0]), std::memory_order_relaxed);
+                std::uintptr_t lExpected = ToLink(lSplice.second[0]);
+                if (
+                    lSplice.first[0]->compare_exchange_strong(lExpected, ToLink(lNode.get()),
+                        std::memory_order_release, std::memory_order_relaxed) == true
+                )
+                {
+                    break;
+                }
+
+                if (Node* lFound = FindSplice(pKey, lSplice))
+                {
+                    return { &lFound->mValue, false };
+                }
+            }
+
+            // Link the node into each level above, refreshing the splice
+            // whenever another thread gets in first. Nothing marks the node's
+            // links until it is fully linked, since erases wait for that.
+            Node* lInserted = lNode.release();
+            mCount.fetch_add(1, std::memory_order_relaxed);
+            for (std::size_t lLevel = 1; lLevel < lInserted->mLevelCount; ++lLevel)
+            {
+                while (true)
+                {
+                    lInserted->mNext[lLevel].store(ToLink(lSplice.second[lLevel]),
+                        std::memory_order_relaxed);
+                    std::uintptr_t lExpected = ToLink(lSplice.second[lLevel]);
+                    if (
+                        lSplice.first[lLevel]->compare_exchange_strong(lExpected,
+                            ToLink(lInserted), std::memory_order_release,
+                            std::memory_order_relaxed) == true
+                    )
+                    {
+                        break;
+                    }
+
+                    FindSplice(pKey, lSplice);
+                }
+            }
+
+            lInserted->mLinked.store(true, std::memory_order_release);
+            return { &lInserted->mValue, true };
+        }
+
+        /**
+         * @brief   Inserts an entry, if no entry with an equal key exists yet.
+         *
+         * @param   pKey    The entry's key.
+         * @param   pValue  The entry's value.
+         *
+         * @return  `true` if the entry was inserted; `false` if the key already
+         *          existed, in which case its value is left alone.
+         */
+        inline bool Insert (
+            const K&    pKey,
+            const V&    pValue
+        )
+        {
+            return TryEmplace(pKey, pValue).second;
+        }
+
+        /**
+         * @brief   Erases the entry with the given key, if any. The entry's
+         *          memory is freed once no guard can still be reading it.
+         *
+         * @param   pKey    The key of the entry to erase.
+         *
+         * @return  `true` if this call erased the entry; `false` if there was
+         *          no such entry, or another thread erased it first.
+         */
+        bool Erase (
+            const K&    pKey
+        )
+        {
+            EpochGuard lGuard;
+            Splice lSplice;
+            Node* lNode = FindSplice(pKey, lSplice);
+            if (lNode == nullptr)
+            {
+                return false;
+            }
+
+            while (lNode->mLinked.load(std::memory_order_acquire) == false)
+            {
+                std::this_thread::yield();
+            }
+
+            // Mark the upper links, so that nothing more is linked after the
+            // node on those levels.
+            for (std::size_t lLevel = lNode->mLevelCount; lLevel-- > 1; )
+            {
+                lNode->mNext[lLevel].fetch_or(1, std::memory_order_acq_rel);
+            }
+
+            // Whichever thread marks the bottom link owns the erase.
+            if ((lNode->mNext[0].fetch_or(1, std::memory_order_acq_rel) & 1) != 0)
+            {
+                return false;
+            }
+
+            // Searching for the key unlinks every marked node on its way,
+            // including this one on each of its levels.
+            FindSplice(pKey, lSplice);
+            mCount.fetch_sub(1, std::memory_order_relaxed);
+            EpochReclaimer::Retire(lNode);
+            return true;
+        }
+
+        /**
+         * @brief   Searches for the entry with the given key.
+         *
+         * @param   pKey    The key to search for.
+         *
+         * @return  A pointer to the entry's value, or `nullptr` if there is no
+         *          such entry.
+         */
+        V* Find (
+            const K&    pKey
+        ) const
+        {
+            EpochGuard lGuard;
+            Node* lNode = LowerBound(pKey);
+            if (lNode != nullptr && mCompare(pKey, lNode->mKey) == false)
+            {
+                return &lNode->mValue;
+            }
+
+            return nullptr;
+        }
+
+        /**
+         * @brief   Retrieves whether or not the map has an entry with the
+         *          given key.
+         *
+         * @param   pKey    The key to search for.
+         *
+         * @return  `true` if the key exists; `false` otherwise.
+         */
+        inline bool Contains (
+            const K&    pKey
+        ) const
+        {
+            return Find(pKey) != nullptr;
+        }
+
+        /**
+         * @brief   Calls a function on each entry, in key order. Entries
+         *          inserted or erased during the walk may or may not be
+         *          visited.
+         *
+         * @param   pFunction   The function to call with each key and value.
+         */
+        template <typename Fn>
+        void ForEach (
+            Fn&&    pFunction
+        ) const
+        {
+            EpochGuard lGuard;
+            for (
+                Node* lNode = GetNode(mHead[0].load(std::memory_order_acquire));
+                lNode != nullptr;
+                lNode = GetNode(lNode->mNext[0].load(std::memory_order_acquire))
+            )
+            {
+                if (IsMarked(lNode->mNext[0].load(std::memory_order_acquire)) == false)
+                {
+                    pFunction(std::as_const(lNode->mKey), lNode->mValue);
+                }
+            }
+        }
+
+        /**
+         * @brief   Calls a function on each entry whose key is not less than
+         *          the given key, in key order, until the function returns
+         *          `false`.
+         *
+         * @param   pKey        The key to start from.
+         * @param   pFunction   The function to call with each key and value.
+         */
+        template <typename Fn>
+        void ForEachFrom (
+            const K&    pKey,
+            Fn&&        pFunction
+        ) const
+        {
+            EpochGuard lGuard;
+            for (
+                Node* lNode = LowerBound(pKey);
+                lNode != nullptr;
+                lNode = GetNode(lNode->mNext[0].load(std::memory_order_acquire))
+            )
+            {
+                if (
+                    IsMarked(lNode->mNext[0].load(std::memory_order_acquire)) == false &&
+                    pFunction(std::as_const(lNode->mKey), lNode->mValue) == false
+                )
+                {
+                    break;
+                }
+            }
+        }
+
+        /**
+         * @brief   Retrieves the number of entries. Only a snapshot, while other
+         *          threads are inserting and erasing.
+         *
+         * @return  The number of entries in the map.
+         */
+        inline std::size_t GetCount () const noexcept
+        {
+            return mCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        ConcurrentSkipList (const ConcurrentSkipList&) = delete;
+        ConcurrentSkipList (ConcurrentSkipList&&) = delete;
+        void operator= (const ConcurrentSkipList&) = delete;
+        void operator= (ConcurrentSkipList&&) = delete;
+
+    private:
+
+        static inline Node* GetNode (
+            const std::uintptr_t    pLink
+        ) noexcept
+        {
+            return reinterpret_cast<Node*>(pLink & ~std::uintptr_t { 1 });
+        }
+
+        static inline bool IsMarked (
+            const std::uintptr_t    pLink
+        ) noexcept
+        {
+            return (pLink & 1) != 0;
+        }
+
+        static inline std::uintptr_t ToLink (
+            Node*   pNode
+        ) noexcept
+        {
+            return reinterpret_cast<std::uintptr_t>(pNode);
+        }
+
+        /**
+         * @brief   Finds, on every level, the last link before the given key
+         *          and the first node at or after it, unlinking any erased
+         *          nodes on the way. Must be called under a guard.
+         *
+         * @return  The node with an equal key, if any.
+         */
+        Node* FindSplice (
+            const K&    pKey,
+            Splice&     pSplice
+        )
+        {
+        Retry:
+            std::atomic<std::uintptr_t>* lLinks = mHead.data();
+            for (std::size_t lLevel = MAX_LEVEL_COUNT; lLevel-- > 0; )
+            {
+                Node* lCurrent = GetNode(lLinks[lLevel].load(std::memory_order_acquire));
+                while (lCurrent != nullptr)
+                {
+                    // Unlink the current node if it has been erased. If the
+                    // predecessor changed, or was erased itself, start over.
+                    std::uintptr_t lNext = lCurrent->mNext[lLevel].load(std::memory_order_acquire);
+                    if (IsMarked(lNext) == true)
+                    {
+                        std::uintptr_t lExpected = ToLink(lCurrent);
+                        if (
+                            lLinks[lLevel].compare_exchange_strong(lExpected,
+                                lNext & ~std::uintptr_t { 1 }, std::memory_order_acq_rel,
+                                std::memory_order_acquire) == false
+                        )
+                        {
+                            goto Retry;
+                        }
+
+                        lCurrent = GetNode(lNext);
+                        continue;
+                    }
+
+                    if (mCompare(lCurrent->mKey, pKey) == false)
+                    {
+                        break;
+                    }
+
+                    lLinks = lCurrent->mNext.get();
+                    lCurrent = GetNode(lNext);
+                }
+
+                pSplice.first[lLevel] = &lLinks[lLevel];
+                pSplice.second[lLevel] = lCurrent;
+            }
+
+            Node* lFound = pSplice.second[0];
+            return (lFound != nullptr && mCompare(pKey, lFound->mKey) == false) ? lFound : nullptr;
+        }
+
+        /**
+         * @brief   Finds the first entry whose key is not less than the given
+         *          key, without unlinking anything. Must be called under a
+         *          guard.
+         */
+        Node* LowerBound (
+            const K&    pKey
+        ) const
+        {
+            const std::atomic<std::uintptr_t>* lLinks = mHead.data();
+            Node* lCurrent = nullptr;
+            for (std::size_t lLevel = MAX_LEVEL_COUNT; lLevel-- > 0; )
+            {
+                lCurrent = GetNode(lLinks[lLevel].load(std::memory_order_acquire));
+                while (lCurrent != nullptr && mCompare(lCurrent->mKey, pKey) == true)
+                {
+                    lLinks = lCurrent->mNext.get();
+                    lCurrent = GetNode(lLinks[lLevel].load(std::memory_order_acquire));
+                }
+            }
+
+            // Skip over erased entries still linked into the bottom level.
+            while (
+                lCurrent != nullptr &&
+                IsMarked(lCurrent->mNext[0].load(std::memory_order_acquire)) == true
+            )
+            {
+                lCurrent = GetNode(lCurrent->mNext[0].load(std::memory_order_acquire));
+            }
+
+            return lCurrent;
+        }
+
+        /**
+         * @brief   Picks the number of levels for a new node: one, plus one
+         *          more with a chance of one in four each time.
+         */
+        static std::size_t RandomLevelCount ()
+        {
+            static thread_local std::uint64_t sState =
+                std::hash<std::thread::id> {}(std::this_thread::get_id()) | 1;
+
+            sState ^= sState << 13;
+            sState ^= sState >> 7;
+            sState ^= sState << 17;
+
+            const std::size_t lLevelCount = 1 + std::countr_zero(sState | (1ull << 62)) / 2;
+            return std::min(lLevelCount, MAX_LEVEL_COUNT);
+        }
+
+    private:
+                    Compare                                                 mCompare;           ///< @brief The ordering of keys.
+                    std::array<std::atomic<std::uintptr_t>, MAX_LEVEL_COUNT> mHead;             ///< @brief The first node on each level.
+        alignas(64) std::atomic<std::size_t>                                mCount { 0 };       ///< @brief The number of entries.
+
+    };
+
+}
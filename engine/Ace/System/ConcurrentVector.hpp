@@ -0,0 +1,305 @@
+/**
+ * @file    Ace/System/ConcurrentVector.hpp
+ * @brief   Provides an append-only vector which many threads can grow and
+ *          read at once, without locks, and whose elements never move.
+ */
+
+#pragma once
+#include <bit>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A container class used for storing data in an append-only
+     *          vector, shared by many threads.
+     *
+     * Elements are stored in segments which double in size, each allocated
+     * once, when the first element landing in it is appended. Segments are
+     * never reallocated, so an element's address stays valid for as long as
+     * the vector lives, and readers need not hold any lock.
+     *
+     * Appending reserves a slot with a single atomic increment, constructs
+     * the element in place, and marks its slot as ready. Elements are
+     * published in the order their slots were reserved: @a `GetSize` only
+     * counts an element once it, and every element before it, is ready. No
+     * appender waits on another; whichever finishes last moves the size past
+     * every ready slot, on behalf of the others. Constructing an element must
+     * not throw, since a slot which is never filled would hold back every
+     * element after it; for the same reason, running out of memory while
+     * appending terminates.
+     *
+     * Elements cannot be removed. Whether an element may be modified once
+     * appended is up to its type; the vector only guards its own structure.
+     *
+     * @tparam  T           The type of data stored in this vector.
+     * @tparam  FirstSize   The number of elements in the first segment. Must be
+     *                      a power of two.
+     */
+    template <typename T, std::size_t FirstSize = 16>
+    class ConcurrentVector final
+    {
+    private:
+        static_assert(FirstSize > 0 && (FirstSize & (FirstSize - 1)) == 0,
+            "'ace::ConcurrentVector' first segment size must be a power of two.");
+
+        /**
+         * @brief   The base-two logarithm of @a `FirstSize`.
+         */
+        static constexpr std::size_t FIRST_SHIFT = std::countr_zero(FirstSize);
+
+        /**
+         * @brief   The number of segments, enough to address every index a
+         *          `std::size_t` can hold.
+         */
+        static constexpr std::size_t SEGMENT_COUNT = 64 - FIRST_SHIFT;
+
+        /**
+         * @brief   A helper structure representing a single element's storage,
+         *          and whether or not the element is constructed yet.
+         */
+        struct Slot
+        {
+            alignas(T) std::byte        mStorage[sizeof(T)];    ///< @brief The element's storage.
+            std::atomic<bool>           mReady { false };       ///< @brief Has the element been constructed?
+        };
+
+    public:
+
+        /**
+         * @brief   Constructs an empty vector. No segments are allocated until
+         *          the first element is appended.
+         */
+        ConcurrentVector () = default;
+
+        /**
+         * @brief   Destroys every element, and frees every segment. Must not
+         *          race with any other use of the vector.
+         */
+        ~ConcurrentVector ()
+        {
+            const std::size_t lSize = mSize.load(std::memory_order_acquire);
+            for (std::size_t i = 0; i < lSize; ++i)
+            {
+                std::destroy_at(&(*this)[i]);
+            }
+
+            for (std::size_t lSegment = 0; lSegment < SEGMENT_COUNT; ++lSegment)
+            {
+                delete[] mSegments[lSegment].load(std::memory_order_relaxed);
+            }
+        }
+
+    public:
+
+        /**
+         * @brief   Appends an element to the vector, constructed in place.
+         *
+         * @param   pArgs   The arguments to construct the element with.
+         *
+         * @return  The new element's index.
+         */
+        template <typename... Args>
+            requires std::is_nothrow_constructible_v<T, Args&&...>
+        std::size_t EmplaceBack (
+            Args&&...   pArgs
+        ) noexcept
+        {
+            const std::size_t lIndex = mReserved.fetch_add(1, std::memory_order_relaxed);
+            const auto [lSegment, lOffset] = Locate(lIndex);
+            Slot& lSlot = AcquireSegment(lSegment)[lOffset];
+            std::construct_at(reinterpret_cast<T*>(lSlot.mStorage), std::forward<Args>(pArgs)...);
+            lSlot.mReady.store(true, std::memory_order_seq_cst);
+
+            // Move the size past every ready slot. Both the ready flag and the
+            // size are sequentially consistent, so if another appender's
+            // advance stops short of this slot, this one sees its advance, and
+            // carries on from there.
+            std::size_t lSize = mSize.load(std::memory_order_seq_cst);
+            while (IsReady(lSize) == true)
+            {
+                if (mSize.compare_exchange_weak(lSize, lSize + 1, std::memory_order_seq_cst) == true)
+                {
+                    ++lSize;
+                }
+            }
+
+            return lIndex;
+        }
+
+        /**
+         * @brief   Appends a copy of an element to the vector.
+         *
+         * @param   pItem   The element to append.
+         *
+         * @return  The new element's index.
+         */
+        inline std::size_t PushBack (
+            const T&    pItem
+        ) noexcept
+        {
+            return EmplaceBack(pItem);
+        }
+
+        /**
+         * @brief   Appends an element to the vector, moving it in.
+         *
+         * @param   pItem   The element to append.
+         *
+         * @return  The new element's index.
+         */
+        inline std::size_t PushBack (
+            T&&     pItem
+        ) noexcept
+        {
+            return EmplaceBack(std::move(pItem));
+        }
+
+        /**
+         * @brief   Retrieves the number of elements published so far. Every
+         *          element below this count may be read.
+         *
+         * @return  The number of elements in the vector.
+         */
+        inline std::size_t GetSize () const noexcept
+        {
+            return mSize.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief   Retrieves whether or not the vector has no elements.
+         *
+         * @return  `true` if no elements have been published; `false`
+         *          otherwise.
+         */
+        inline bool IsEmpty () const noexcept
+        {
+            return GetSize() == 0;
+        }
+
+        /**
+         * @brief   Calls a function on each element published so far, in
+         *          order.
+         *
+         * @param   pFunction   The function to call with each element.
+         */
+        template <typename Fn>
+        void ForEach (
+            Fn&&    pFunction
+        )
+        {
+            const std::size_t lSize = GetSize();
+            for (std::size_t i = 0; i < lSize; ++i)
+            {
+                pFunction((*this)[i]);
+            }
+        }
+
+        template <typename Fn>
+        void ForEach (
+            Fn&&    pFunction
+        ) const
+        {
+            const std::size_t lSize = GetSize();
+            for (std::size_t i = 0; i < lSize; ++i)
+            {
+                pFunction((*this)[i]);
+            }
+        }
+
+    public:
+
+        /**
+         * @brief   Retrieves an element by index. The index must be below
+         *          a size returned by @a `GetSize`.
+         */
+        inline T& operator[] (
+            const std::size_t&  pIndex
+        ) noexcept
+        {
+            const auto [lSegment, lOffset] = Locate(pIndex);
+            return *std::launder(reinterpret_cast<T*>(
+                mSegments[lSegment].load(std::memory_order_acquire)[lOffset].mStorage));
+        }
+
+        inline const T& operator[] (
+            const std::size_t&  pIndex
+        ) const noexcept
+        {
+            const auto [lSegment, lOffset] = Locate(pIndex);
+            return *std::launder(reinterpret_cast<const T*>(
+                mSegments[lSegment].load(std::memory_order_acquire)[lOffset].mStorage));
+        }
+
+    private:
+        ConcurrentVector (const ConcurrentVector&) = delete;
+        ConcurrentVector (ConcurrentVector&&) = delete;
+        void operator= (const ConcurrentVector&) = delete;
+        void operator= (ConcurrentVector&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Finds the segment an index falls in, and its offset within
+         *          that segment. Segment `s` holds @a `FirstSize << s`
+         *          elements, starting at index @a `FirstSize * ((1 << s) - 1)`.
+         */
+        static inline std::pair<std::size_t, std::size_t> Locate (
+            const std::size_t   pIndex
+        ) noexcept
+        {
+            const std::size_t lBiased = pIndex + FirstSize;
+            const std::size_t lSegment = std::bit_width(lBiased) - 1 - FIRST_SHIFT;
+            return { lSegment, lBiased - (FirstSize << lSegment) };
+        }
+
+        /**
+         * @brief   Retrieves a segment's storage, allocating it if this is the
+         *          first thread to need it. Threads which lose the race to
+         *          allocate it free their copy and use the winner's.
+         */
+        Slot* AcquireSegment (
+            const std::size_t   pSegment
+        )
+        {
+            Slot* lData = mSegments[pSegment].load(std::memory_order_acquire);
+            if (lData != nullptr)
+            {
+                return lData;
+            }
+
+            Slot* lFresh = new Slot[FirstSize << pSegment];
+            if (
+                mSegments[pSegment].compare_exchange_strong(lData, lFresh,
+                    std::memory_order_acq_rel, std::memory_order_acquire) == false
+            )
+            {
+                delete[] lFresh;
+                return lData;
+            }
+
+            return lFresh;
+        }
+
+        /**
+         * @brief   Retrieves whether or not the element at an index has been
+         *          constructed. The index's segment may not be allocated yet.
+         */
+        bool IsReady (
+            const std::size_t   pIndex
+        ) const noexcept
+        {
+            const auto [lSegment, lOffset] = Locate(pIndex);
+            const Slot* lData = mSegments[lSegment].load(std::memory_order_acquire);
+            return lData != nullptr && lData[lOffset].mReady.load(std::memory_order_seq_cst) == true;
+        }
+
+    private:
+                    std::array<std::atomic<Slot*>, SEGMENT_COUNT>   mSegments {};       ///< @brief Each segment's slots, or `nullptr` if not yet allocated.
+        alignas(64) std::atomic<std::size_t>                        mReserved { 0 };    ///< @brief The number of slots reserved by appenders.
+        alignas(64) std::atomic<std::size_t>                        mSize { 0 };        ///< @brief The number of elements published.
+
+    };
+
+}
@@ -0,0 +1,67 @@
+/**
+ * @file    Ace/System/ContentHash.hpp
+ * @brief   Provides functions for hashing the contents of assets and other
+ *          data, for use as stable cache keys.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Computes the 64-bit FNV-1a hash of a block of bytes.
+     *
+     * Unlike `std::hash`, the result is the same on every platform and in
+     * every run, so it may be stored on disk.
+     *
+     * @param   pData   The bytes to hash.
+     * @param   pSeed   A value mixed into the hash first, such as a format
+     *                  version, so that changing it changes every key.
+     *
+     * @return  The hash.
+     */
+    inline std::uint64_t ContentHash64 (
+        std::span<const std::uint8_t>   pData,
+        const std::uint64_t             pSeed = 0
+    )
+    {
+        constexpr std::uint64_t OFFSET_BASIS = 0xCBF29CE484222325ull;
+        constexpr std::uint64_t PRIME = 0x00000100000001B3ull;
+
+        std::uint64_t lHash = OFFSET_BASIS;
+        for (std::size_t i = 0; i < sizeof(pSeed); ++i)
+        {
+            lHash = (lHash ^ ((pSeed >> (i * 8)) & 0xFF)) * PRIME;
+        }
+
+        for (const std::uint8_t lByte : pData)
+        {
+            lHash = (lHash ^ lByte) * PRIME;
+        }
+
+        return lHash;
+    }
+
+    /**
+     * @brief   Computes the 64-bit FNV-1a hash of a string's characters.
+     *
+     * @param   pText   The string to hash.
+     * @param   pSeed   A value mixed into the hash first.
+     *
+     * @return  The hash.
+     */
+    inline std::uint64_t ContentHash64 (
+        std::string_view    pText,
+        const std::uint64_t pSeed = 0
+    )
+    {
+        return ContentHash64(
+            std::span<const std::uint8_t> {
+                reinterpret_cast<const std::uint8_t*>(pText.data()), pText.size() },
+            pSeed);
+    }
+
+}
@@ -0,0 +1,362 @@
+/**
+ * @file    Ace/System/CpuTopology.cpp
+ */
+
+#if defined(ACE_LINUX)
+    #include <pthread.h>
+    #include <sched.h>
+    #include <sys/mman.h>
+    #include <sys/syscall.h>
+    #include <unistd.h>
+#endif
+
+#include <cctype>
+#include <charconv>
+#include <map>
+#include <Ace/System/CpuTopology.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    static std::optional<std::string> ReadText (
+        const fs::path& pPath
+    )
+    {
+        std::ifstream lStream { pPath };
+        if (lStream.is_open() == false)
+        {
+            return std::nullopt;
+        }
+
+        std::string lText;
+        std::getline(lStream, lText);
+        return lText;
+    }
+
+    static std::optional<std::uint32_t> ReadNumber (
+        const fs::path& pPath
+    )
+    {
+        auto lText = ReadText(pPath);
+        if (lText.has_value() == false)
+        {
+            return std::nullopt;
+        }
+
+        std::uint32_t lValue = 0;
+        const auto lResult = std::from_chars(lText->data(), lText->data() + lText->size(), lValue);
+        if (lResult.ec != std::errc {})
+        {
+            return std::nullopt;
+        }
+
+        return lValue;
+    }
+
+    /* Public Methods *********************************************************/
+
+    const CpuTopology& CpuTopology::Get ()
+    {
+        static const CpuTopology sTopology =
+            [] () -> CpuTopology
+            {
+                CpuTopology lTopology = Detect();
+
+            #if defined(ACE_LINUX)
+                cpu_set_t lSet;
+                CPU_ZERO(&lSet);
+                if (::sched_getaffinity(0, sizeof(lSet), &lSet) == 0)
+                {
+                    std::vector<std::uint32_t> lAllowed;
+                    for (std::uint32_t i = 0; i < CPU_SETSIZE; ++i)
+                    {
+                        if (CPU_ISSET(i, &lSet))
+                        {
+                            lAllowed.push_back(i);
+                        }
+                    }
+
+                    CpuTopology lRestricted = lTopology.Restrict(lAllowed);
+                    if (lRestricted.mCpus.empty() == false)
+                    {
+                        return lRestricted;
+                    }
+                }
+            #endif
+
+                return lTopology;
+            }();
+
+        return sTopology;
+    }
+
+    CpuTopology CpuTopology::Detect (
+        const fs::path& pRoot
+    )
+    {
+        CpuTopology lTopology;
+
+        // Read each online CPU's package and core. A CPU without topology
+        // information is taken to be a core of its own.
+        const auto lOnline = ReadText(pRoot / "cpu" / "online");
+        for (const std::uint32_t lId : ParseCpuList(lOnline.value_or("")))
+        {
+            const fs::path lDirectory = pRoot / "cpu" / std::format("cpu{}", lId) / "topology";
+            lTopology.mCpus.push_back({
+                .mId        = lId,
+                .mCore      = ReadNumber(lDirectory / "core_id").value_or(lId),
+                .mPackage   = ReadNumber(lDirectory / "physical_package_id").value_or(0)
+            });
+        }
+
+        if (lTopology.mCpus.empty() == true)
+        {
+            const std::uint32_t lCount = std::max(std::thread::hardware_concurrency(), 1u);
+            for (std::uint32_t i = 0; i < lCount; ++i)
+            {
+                lTopology.mCpus.push_back({ .mId = i, .mCore = i });
+            }
+
+            lTopology.Finalize();
+            return lTopology;
+        }
+
+        // Assign each CPU to the NUMA node which lists it. Systems without
+        // NUMA support have no `node` directory, leaving every CPU on node 0.
+        std::error_code lError;
+        for (const auto& lEntry : fs::directory_iterator { pRoot / "node", lError })
+        {
+            const std::string lName = lEntry.path().filename().string();
+            std::uint32_t lNode = 0;
+            if (
+                lName.starts_with("node") == false ||
+                std::from_chars(lName.data() + 4, lName.data() + lName.size(), lNode).ec != std::errc {}
+            )
+            {
+                continue;
+            }
+
+            const auto lList = ReadText(lEntry.path() / "cpulist");
+            for (const std::uint32_t lId : ParseCpuList(lList.value_or("")))
+            {
+                for (auto& lCpu : lTopology.mCpus)
+                {
+                    if (lCpu.mId == lId)
+                    {
+                        lCpu.mNode = lNode;
+                    }
+                }
+            }
+        }
+
+        lTopology.Finalize();
+        return lTopology;
+    }
+
+    std::vector<std::uint32_t> CpuTopology::ParseCpuList (
+        std::string_view    pText
+    )
+    {
+        std::vector<std::uint32_t> lCpus;
+        while (pText.empty() == false)
+        {
+            const std::size_t lComma = pText.find(',');
+            std::string_view lRange = pText.substr(0, lComma);
+            pText = (lComma == std::string_view::npos) ? std::string_view {} : pText.substr(lComma + 1);
+
+            while (lRange.empty() == false && std::isspace(static_cast<unsigned char>(lRange.front())))
+            {
+                lRange.remove_prefix(1);
+            }
+            while (lRange.empty() == false && std::isspace(static_cast<unsigned char>(lRange.back())))
+            {
+                lRange.remove_suffix(1);
+            }
+
+            std::uint32_t lFirst = 0;
+            auto lResult = std::from_chars(lRange.data(), lRange.data() + lRange.size(), lFirst);
+            if (lResult.ec != std::errc {})
+            {
+                continue;
+            }
+
+            std::uint32_t lLast = lFirst;
+            if (lResult.ptr != lRange.data() + lRange.size())
+            {
+                if (
+                    *lResult.ptr != '-' ||
+                    std::from_chars(lResult.ptr + 1, lRange.data() + lRange.size(), lLast).ec != std::errc {} ||
+                    lLast < lFirst
+                )
+                {
+                    continue;
+                }
+            }
+
+            for (std::uint32_t i = lFirst; i <= lLast; ++i)
+            {
+                lCpus.push_back(i);
+            }
+        }
+
+        std::sort(lCpus.begin(), lCpus.end());
+        lCpus.erase(std::unique(lCpus.begin(), lCpus.end()), lCpus.end());
+        return lCpus;
+    }
+
+    bool CpuTopology::PinCurrentThread (
+        std::span<const std::uint32_t>  pCpus
+    )
+    {
+        if (pCpus.empty() == true)
+        {
+            return false;
+        }
+
+    #if defined(ACE_LINUX)
+        cpu_set_t lSet;
+        CPU_ZERO(&lSet);
+        for (const std::uint32_t lCpu : pCpus)
+        {
+            if (lCpu < CPU_SETSIZE)
+            {
+                CPU_SET(lCpu, &lSet);
+            }
+        }
+
+        return ::pthread_setaffinity_np(::pthread_self(), sizeof(lSet), &lSet) == 0;
+    #else
+        return false;
+    #endif
+    }
+
+    void* CpuTopology::AllocateOnNode (
+        const std::size_t&  pSize,
+        const std::uint32_t pNode
+    )
+    {
+    #if defined(ACE_LINUX)
+        void* lMemory = ::mmap(nullptr, std::max<std::size_t>(pSize, 1),
+            PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (lMemory == MAP_FAILED)
+        {
+            throw std::bad_alloc {};
+        }
+
+        // Ask for the pages to be placed on the node when they are first
+        // touched. `MPOL_PREFERRED` falls back to other nodes rather than
+        // failing, and a kernel without NUMA support simply refuses.
+        #if defined(SYS_mbind)
+            constexpr int MPOL_PREFERRED = 1;
+            constexpr std::size_t MASK_BITS = sizeof(unsigned long) * 8;
+            std::array<unsigned long, 16> lMask {};
+            if (pNode < lMask.size() * MASK_BITS)
+            {
+                lMask[pNode / MASK_BITS] = 1ul << (pNode % MASK_BITS);
+                ::syscall(SYS_mbind, lMemory, std::max<std::size_t>(pSize, 1), MPOL_PREFERRED,
+                    lMask.data(), lMask.size() * MASK_BITS + 1, 0);
+            }
+        #endif
+
+        return lMemory;
+    #else
+        (void) pNode;
+        void* lMemory = ::operator new(pSize, std::align_val_t { 4096 });
+        return lMemory;
+    #endif
+    }
+
+    void CpuTopology::FreeOnNode (
+        void*               pMemory,
+        const std::size_t&  pSize
+    )
+    {
+        if (pMemory == nullptr)
+        {
+            return;
+        }
+
+    #if defined(ACE_LINUX)
+        ::munmap(pMemory, std::max<std::size_t>(pSize, 1));
+    #else
+        (void) pSize;
+        ::operator delete(pMemory, std::align_val_t { 4096 });
+    #endif
+    }
+
+    CpuTopology CpuTopology::Restrict (
+        std::span<const std::uint32_t>  pAllowed
+    ) const
+    {
+        CpuTopology lTopology;
+        for (const auto& lCpu : mCpus)
+        {
+            if (std::find(pAllowed.begin(), pAllowed.end(), lCpu.mId) != pAllowed.end())
+            {
+                lTopology.mCpus.push_back(lCpu);
+                lTopology.mCpus.back().mNode = mNodeIds[lCpu.mNode];
+            }
+        }
+
+        lTopology.Finalize();
+        return lTopology;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void CpuTopology::Finalize ()
+    {
+        // Number the nodes densely, in the operating system's order.
+        mNodeIds.clear();
+        for (const auto& lCpu : mCpus)
+        {
+            mNodeIds.push_back(lCpu.mNode);
+        }
+        std::sort(mNodeIds.begin(), mNodeIds.end());
+        mNodeIds.erase(std::unique(mNodeIds.begin(), mNodeIds.end()), mNodeIds.end());
+        for (auto& lCpu : mCpus)
+        {
+            lCpu.mNode = static_cast<std::uint32_t>(
+                std::lower_bound(mNodeIds.begin(), mNodeIds.end(), lCpu.mNode) - mNodeIds.begin());
+        }
+
+        // Number the cores densely, node by node. A core is identified by its
+        // package and the core number within that package.
+        std::sort(mCpus.begin(), mCpus.end(),
+            [] (const LogicalCpu& pLeft, const LogicalCpu& pRight)
+            {
+                return std::tie(pLeft.mNode, pLeft.mPackage, pLeft.mCore, pLeft.mId) <
+                    std::tie(pRight.mNode, pRight.mPackage, pRight.mCore, pRight.mId);
+            });
+
+        std::map<std::pair<std::uint32_t, std::uint32_t>, std::uint32_t> lCores;
+        std::vector<std::uint32_t> lSiblings;
+        for (auto& lCpu : mCpus)
+        {
+            auto [lIter, lInserted] = lCores.try_emplace(
+                std::pair { lCpu.mPackage, lCpu.mCore },
+                static_cast<std::uint32_t>(lCores.size()));
+            if (lInserted == true)
+            {
+                lSiblings.push_back(0);
+            }
+
+            lCpu.mCore = lIter->second;
+            lCpu.mSibling = lSiblings[lCpu.mCore]++;
+        }
+
+        // Put every core's first hardware thread ahead of any siblings.
+        std::sort(mCpus.begin(), mCpus.end(),
+            [] (const LogicalCpu& pLeft, const LogicalCpu& pRight)
+            {
+                return std::tie(pLeft.mNode, pLeft.mSibling, pLeft.mCore) <
+                    std::tie(pRight.mNode, pRight.mSibling, pRight.mCore);
+            });
+
+        mCoreCount = lCores.size();
+        mNodeCount = mNodeIds.size();
+    }
+
+}
@@ -0,0 +1,198 @@
+/**
+ * @file    Ace/System/CpuTopology.hpp
+ * @brief   Provides a class describing how the system's logical CPUs are
+ *          grouped into physical cores and NUMA nodes.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A structure describing one logical CPU: a hardware thread the
+     *          operating system can schedule on.
+     */
+    struct LogicalCpu
+    {
+        std::uint32_t   mId = 0;        ///< @brief The operating system's number for the CPU.
+        std::uint32_t   mCore = 0;      ///< @brief The physical core the CPU belongs to, numbered from zero across all packages.
+        std::uint32_t   mPackage = 0;   ///< @brief The physical package (socket) the CPU belongs to.
+        std::uint32_t   mNode = 0;      ///< @brief The NUMA node the CPU belongs to, numbered from zero.
+        std::uint32_t   mSibling = 0;   ///< @brief The CPU's rank among the hardware threads of its core. Zero for the first.
+    };
+
+    /**
+     * @brief   A class describing the topology of the logical CPUs this
+     *          process may run on.
+     *
+     * On Linux, the topology is read from `sysfs`: each CPU's package and
+     * core from `cpu/cpuN/topology`, and each NUMA node's CPUs from
+     * `node/nodeN/cpulist`. Only the CPUs in the process's affinity mask are
+     * kept, so a process confined by `taskset` or a container's CPU set sees
+     * only its share of the machine. Where `sysfs` is unavailable, each of the
+     * hardware's threads is taken to be its own core on a single node.
+     *
+     * The CPUs are ordered node by node, and within each node with every
+     * core's first hardware thread before any of their SMT siblings, so that
+     * taking CPUs from the front fills physical cores first.
+     */
+    class ACE_API CpuTopology final
+    {
+    public:
+
+        /**
+         * @brief   Retrieves the topology of the CPUs this process may run on,
+         *          detecting it on first use.
+         *
+         * @return  A handle to the topology.
+         */
+        static const CpuTopology& Get ();
+
+        /**
+         * @brief   Detects the topology of every online CPU from the given
+         *          `sysfs` directory, regardless of the process's affinity.
+         *
+         * @param   pRoot   The directory containing the `cpu` and `node`
+         *                  directories.
+         *
+         * @return  The detected topology.
+         */
+        static CpuTopology Detect (
+            const fs::path& pRoot = "/sys/devices/system"
+        );
+
+        /**
+         * @brief   Parses a Linux CPU list, such as `0-3,8,10-11`.
+         *
+         * @param   pText   The list to parse.
+         *
+         * @return  The CPUs in the list, in ascending order. Malformed ranges
+         *          are skipped.
+         */
+        static std::vector<std::uint32_t> ParseCpuList (
+            std::string_view    pText
+        );
+
+        /**
+         * @brief   Restricts the calling thread to the given CPUs.
+         *
+         * @param   pCpus   The CPUs the thread may run on.
+         *
+         * @return  `true` if the thread's affinity was set; `false` if the
+         *          list is empty, or the platform refused or is unsupported.
+         */
+        static bool PinCurrentThread (
+            std::span<const std::uint32_t>  pCpus
+        );
+
+        /**
+         * @brief   Allocates page-aligned memory whose pages are preferably
+         *          placed on the given NUMA node.
+         *
+         * The placement is a preference: where the node has no free memory,
+         * or the platform does not support it, pages come from wherever the
+         * kernel would otherwise place them.
+         *
+         * @param   pSize   The number of bytes to allocate.
+         * @param   pNode   The node to place the memory on.
+         *
+         * @return  A pointer to the allocated memory, which must be released
+         *          with @a `FreeOnNode`.
+         *
+         * @throw   `std::bad_alloc` if the memory could not be allocated.
+         */
+        static void* AllocateOnNode (
+            const std::size_t&  pSize,
+            const std::uint32_t pNode
+        );
+
+        /**
+         * @brief   Releases memory allocated by @a `AllocateOnNode`.
+         *
+         * @param   pMemory The memory to release. May be `nullptr`.
+         * @param   pSize   The size the memory was allocated with.
+         */
+        static void FreeOnNode (
+            void*               pMemory,
+            const std::size_t&  pSize
+        );
+
+    public:
+
+        /**
+         * @brief   Retrieves the logical CPUs, ordered as described above.
+         *
+         * @return  The logical CPUs.
+         */
+        inline std::span<const LogicalCpu> GetCpus () const
+        {
+            return mCpus;
+        }
+
+        /**
+         * @brief   Retrieves the number of physical cores.
+         *
+         * @return  The number of cores with at least one CPU in this topology.
+         */
+        inline std::size_t GetCoreCount () const
+        {
+            return mCoreCount;
+        }
+
+        /**
+         * @brief   Retrieves the number of NUMA nodes.
+         *
+         * @return  The number of nodes with at least one CPU in this topology.
+         */
+        inline std::size_t GetNodeCount () const
+        {
+            return mNodeCount;
+        }
+
+        /**
+         * @brief   Retrieves the operating system's number for a NUMA node,
+         *          as used by @a `AllocateOnNode`.
+         *
+         * @param   pNode   The node, numbered from zero.
+         *
+         * @return  The operating system's number for the node.
+         */
+        inline std::uint32_t GetNodeId (
+            const std::uint32_t pNode
+        ) const
+        {
+            return mNodeIds[pNode];
+        }
+
+        /**
+         * @brief   Keeps only the given CPUs, renumbering the cores and nodes
+         *          which remain.
+         *
+         * @param   pAllowed    The CPUs to keep.
+         *
+         * @return  The restricted topology.
+         */
+        CpuTopology Restrict (
+            std::span<const std::uint32_t>  pAllowed
+        ) const;
+
+    private:
+
+        /**
+         * @brief   Sorts the CPUs into their documented order, and numbers the
+         *          cores, nodes and siblings densely from zero.
+         */
+        void Finalize ();
+
+    private:
+        std::vector<LogicalCpu>     mCpus;              ///< @brief The logical CPUs.
+        std::vector<std::uint32_t>  mNodeIds;           ///< @brief The operating system's number for each node.
+        std::size_t                 mCoreCount = 0;     ///< @brief The number of physical cores.
+        std::size_t                 mNodeCount = 0;     ///< @brief The number of NUMA nodes.
+
+    };
+
+}
@@ -0,0 +1,142 @@
+/**
+ * @file    Ace/System/DerivedDataCache.cpp
+ */
+
+#include <Ace/System/DerivedDataCache.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    //
+    // Every entry starts with a little-endian header:
+    //
+    // | Offset | Size | Field                                                |
+    // |--------|------|------------------------------------------------------|
+    // | 0      | 4    | The magic number, `ADDC`.                            |
+    // | 4      | 8    | The size of the data which follows, in bytes.        |
+    // | 12     | 8    | The @a `ContentHash64` of the data.                  |
+    //
+    static constexpr std::uint8_t ENTRY_MAGIC[4] = { 'A', 'D', 'D', 'C' };
+
+    static void WriteU64 (
+        std::uint8_t*       pOut,
+        const std::uint64_t pValue
+    )
+    {
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            pOut[i] = static_cast<std::uint8_t>(pValue >> (i * 8));
+        }
+    }
+
+    static std::uint64_t ReadU64 (
+        const std::uint8_t* pIn
+    )
+    {
+        std::uint64_t lValue = 0;
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            lValue |= static_cast<std::uint64_t>(pIn[i]) << (i * 8);
+        }
+
+        return lValue;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    DerivedDataCache::DerivedDataCache (
+        const fs::path&     pRoot,
+        const std::string&  pMountPoint
+    ) :
+        mRoot       { pRoot },
+        mMountPoint { pMountPoint }
+    {
+        std::error_code lError;
+        fs::create_directories(pRoot, lError);
+        if (fs::is_directory(pRoot) == false)
+        {
+            ACE_THROW(std::runtime_error, "{}: Could not create directory '{}'!",
+                "DerivedDataCache", pRoot.string());
+        }
+
+        VFS::MountPhysicalDirectory(pMountPoint, pRoot, true);
+    }
+
+    DerivedDataCache::~DerivedDataCache ()
+    {
+        VFS::Unmount(mMountPoint, mRoot);
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::optional<astd::byte_buffer> DerivedDataCache::Get (
+        std::string_view    pBucket,
+        const std::uint64_t pKey
+    ) const
+    {
+        auto lFile = VFS::OpenFile(mMountPoint + "/" + MakeEntryPath(pBucket, pKey));
+        if (lFile == nullptr || lFile->GetSize() < HEADER_SIZE)
+        {
+            mMissCount.fetch_add(1, std::memory_order_relaxed);
+            return std::nullopt;
+        }
+
+        std::uint8_t lHeader[HEADER_SIZE] = {};
+        astd::byte_buffer lData;
+        if (lFile->Read(lHeader, HEADER_SIZE) == HEADER_SIZE &&
+            std::memcmp(lHeader, ENTRY_MAGIC, sizeof(ENTRY_MAGIC)) == 0 &&
+            ReadU64(lHeader + 4) == lFile->GetSize() - HEADER_SIZE)
+        {
+            lData.resize(lFile->GetSize() - HEADER_SIZE);
+            if (
+                lData.empty() == true ||
+                lFile->Read(lData.data(), lData.size()) == lData.size()
+            )
+            {
+                if (ContentHash64(lData) == ReadU64(lHeader + 12))
+                {
+                    mHitCount.fetch_add(1, std::memory_order_relaxed);
+                    return lData;
+                }
+            }
+        }
+
+        mMissCount.fetch_add(1, std::memory_order_relaxed);
+        return std::nullopt;
+    }
+
+    bool DerivedDataCache::Put (
+        std::string_view                pBucket,
+        const std::uint64_t             pKey,
+        std::span<const std::uint8_t>   pData
+    )
+    {
+        std::uint8_t lHeader[HEADER_SIZE] = {};
+        std::memcpy(lHeader, ENTRY_MAGIC, sizeof(ENTRY_MAGIC));
+        WriteU64(lHeader + 4, pData.size());
+        WriteU64(lHeader + 12, ContentHash64(pData));
+
+        // The entry is written aside and renamed into place, so a concurrent
+        // reader sees either the old entry or the new one.
+        auto lFile = VFS::OpenFileForWriting(mMountPoint + "/" + MakeEntryPath(pBucket, pKey),
+            { .mAtomic = true, .mBufferSize = HEADER_SIZE });
+        return
+            lFile != nullptr &&
+            lFile->Write(lHeader, HEADER_SIZE) == true &&
+            lFile->Write(pData.data(), pData.size()) == true &&
+            lFile->Commit() == true;
+    }
+
+    /* Private Methods ********************************************************/
+
+    std::string DerivedDataCache::MakeEntryPath (
+        std::string_view    pBucket,
+        const std::uint64_t pKey
+    )
+    {
+        return std::format("{}/{:016x}.bin", pBucket, pKey);
+    }
+
+}
@@ -0,0 +1,154 @@
+/**
+ * @file    Ace/System/DerivedDataCache.hpp
+ * @brief   Provides a class which stores data derived from assets, such as
+ *          compiled scripts, on disk, keyed by a hash of its source.
+ */
+
+#pragma once
+#include <span>
+#include <Ace/System/ContentHash.hpp>
+#include <Ace/System/VirtualFilesystem.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class which stores data derived from assets on disk, so that
+     *          it need only be derived once.
+     *
+     * Entries are grouped into buckets, one per kind of derived data, and are
+     * keyed by a 64-bit hash of whatever they were derived from; typically
+     * @a `ContentHash64` of the source asset, seeded with the version of the
+     * tool which derived it. Each entry is a file named after its key, in a
+     * directory named after its bucket.
+     *
+     * Entries are read through the virtual filesystem, from the mount point
+     * the cache's directory is mounted at, so a prebuilt cache may also be
+     * shipped as an archive mounted at the same point. New entries are written
+     * through the same mount point, which is writable, as atomic files, so
+     * readers never see a partial entry. Each entry carries a
+     * checksum, and entries which fail it are treated as missing.
+     *
+     * All methods may be called from any thread.
+     */
+    class ACE_API DerivedDataCache final
+    {
+    public:
+
+        /**
+         * @brief   The size of the header which precedes each entry's data.
+         */
+        static constexpr std::size_t HEADER_SIZE = 20;
+
+    public:
+
+        /**
+         * @brief   Constructs a cache which stores its entries in the given
+         *          directory, creating it if necessary, and mounts it in the
+         *          virtual filesystem as writable until it is destroyed.
+         *
+         * @param   pRoot           The directory to store entries in.
+         * @param   pMountPoint     The logical mount point to mount it at.
+         *
+         * @throw   `std::runtime_error` if the directory cannot be created.
+         */
+        explicit DerivedDataCache (
+            const fs::path&     pRoot,
+            const std::string&  pMountPoint = "ddc"
+        );
+
+        /**
+         * @brief   Unmounts the cache's directory from the virtual filesystem.
+         */
+        ~DerivedDataCache ();
+
+    public:
+
+        /**
+         * @brief   Retrieves an entry's data.
+         *
+         * @param   pBucket     The entry's bucket.
+         * @param   pKey        The entry's key.
+         *
+         * @return  An `std::optional` which contains the entry's data, if the
+         *          entry exists and is intact.
+         */
+        std::optional<astd::byte_buffer> Get (
+            std::string_view    pBucket,
+            const std::uint64_t pKey
+        ) const;
+
+        /**
+         * @brief   Stores an entry, replacing any existing entry with the same
+         *          key.
+         *
+         * @param   pBucket     The entry's bucket.
+         * @param   pKey        The entry's key.
+         * @param   pData       The entry's data.
+         *
+         * @return  `true` if the entry was stored; `false` otherwise.
+         */
+        bool Put (
+            std::string_view                pBucket,
+            const std::uint64_t             pKey,
+            std::span<const std::uint8_t>   pData
+        );
+
+        /**
+         * @brief   Retrieves the number of entries found by @a `Get` so far.
+         *
+         * @return  The number of cache hits.
+         */
+        inline std::size_t GetHitCount () const
+        {
+            return mHitCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Retrieves the number of entries not found, or found
+         *          damaged, by @a `Get` so far.
+         *
+         * @return  The number of cache misses.
+         */
+        inline std::size_t GetMissCount () const
+        {
+            return mMissCount.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief   Retrieves the directory entries are stored in.
+         *
+         * @return  The cache's root directory.
+         */
+        inline const fs::path& GetRoot () const
+        {
+            return mRoot;
+        }
+
+    private:
+        DerivedDataCache (const DerivedDataCache&) = delete;
+        DerivedDataCache (DerivedDataCache&&) = delete;
+        void operator= (const DerivedDataCache&) = delete;
+        void operator= (DerivedDataCache&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Forms the path of an entry, relative to the cache's root.
+         *
+         * @return  The entry's relative path.
+         */
+        static std::string MakeEntryPath (
+            std::string_view    pBucket,
+            const std::uint64_t pKey
+        );
+
+    private:
+        fs::path                            mRoot;                  ///< @brief The directory entries are stored in.
+        std::string                         mMountPoint;            ///< @brief The logical mount point entries are read from.
+        mutable std::atomic<std::size_t>    mHitCount { 0 };        ///< @brief The number of entries found.
+        mutable std::atomic<std::size_t>    mMissCount { 0 };       ///< @brief The number of entries not found, or damaged.
+
+    };
+
+}
@@ -0,0 +1,307 @@
+/**
+ * @file    Ace/System/EpochReclaimer.cpp
+ */
+
+#include <Ace/System/ConcurrentVector.hpp>
+#include <Ace/System/EpochReclaimer.hpp>
+
+namespace ace
+{
+
+    /* Helper Structures ******************************************************/
+
+    /**
+     * @brief   A structure containing one piece of retired memory.
+     */
+    struct RetiredMemory
+    {
+        void*           mMemory = nullptr;      ///< @brief The memory to free.
+        void            (*mDeleter)(void*);     ///< @brief The function which frees it.
+        std::uint64_t   mEpoch = 0;             ///< @brief The epoch it was retired in.
+    };
+
+    /**
+     * @brief   A structure containing one thread's reclamation state. Records
+     *          are never freed; a thread's record is reused by a later thread
+     *          once it exits.
+     */
+    struct ThreadRecord
+    {
+        alignas(64) std::atomic<std::uint64_t>  mState { 0 };       ///< @brief The epoch the thread last entered a guard in, shifted left once, with the low bit set while it is inside a guard.
+                    std::atomic<bool>           mInUse { false };   ///< @brief Is a thread using this record?
+                    std::uint32_t               mNesting = 0;       ///< @brief The number of guards the thread is inside.
+                    std::vector<RetiredMemory>  mRetired;           ///< @brief The memory the thread has retired, oldest first.
+    };
+
+    /**
+     * @brief   A structure containing the state shared by every thread.
+     */
+    struct SharedState
+    {
+        ConcurrentVector<ThreadRecord>  mRecords;       ///< @brief Every thread's record.
+        std::mutex                      mOrphanMutex;   ///< @brief The mutex used for locking down the orphaned memory.
+        std::vector<RetiredMemory>      mOrphans;       ///< @brief Memory retired by threads which have since exited.
+    };
+
+    /**
+     * @brief   A structure which releases the calling thread's record when the
+     *          thread exits.
+     */
+    struct ThreadHandle
+    {
+        ThreadRecord*   mRecord = nullptr;  ///< @brief The thread's record, once it has claimed one.
+
+        ~ThreadHandle ();
+    };
+
+    /* Static Members *********************************************************/
+
+    static std::atomic<std::uint64_t>   sEpoch { 0 };           ///< @brief The global epoch.
+    static std::atomic<std::size_t>     sPendingCount { 0 };    ///< @brief The amount of retired memory not yet freed.
+    static std::atomic<bool>            sHasOrphans { false };  ///< @brief Is any orphaned memory waiting to be freed?
+    static thread_local ThreadHandle    sThread;                ///< @brief The calling thread's record.
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Retrieves the shared state. It is never destroyed, since
+     *          threads may still exit, and release their records, while
+     *          static objects are being destroyed.
+     */
+    static SharedState& GetShared ()
+    {
+        static SharedState* sShared = new SharedState {};
+        return *sShared;
+    }
+
+    /**
+     * @brief   Retrieves the calling thread's record, claiming a free one, or
+     *          adding a new one, on the thread's first call.
+     */
+    static ThreadRecord& GetRecord ()
+    {
+        if (sThread.mRecord != nullptr)
+        {
+            return *sThread.mRecord;
+        }
+
+        auto& lRecords = GetShared().mRecords;
+        while (sThread.mRecord == nullptr)
+        {
+            const std::size_t lSize = lRecords.GetSize();
+            for (std::size_t i = 0; i < lSize; ++i)
+            {
+                bool lExpected = false;
+                if (lRecords[i].mInUse.compare_exchange_strong(lExpected, true,
+                    std::memory_order_acquire) == true)
+                {
+                    sThread.mRecord = &lRecords[i];
+                    break;
+                }
+            }
+
+            if (sThread.mRecord == nullptr)
+            {
+                lRecords.EmplaceBack();
+            }
+        }
+
+        return *sThread.mRecord;
+    }
+
+    /**
+     * @brief   Tries to move the global epoch forward, which is possible once
+     *          every thread inside a guard has entered it in the current
+     *          epoch.
+     */
+    static void TryAdvance ()
+    {
+        std::uint64_t lEpoch = sEpoch.load(std::memory_order_acquire);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto& lRecords = GetShared().mRecords;
+        const std::size_t lSize = lRecords.GetSize();
+        for (std::size_t i = 0; i < lSize; ++i)
+        {
+            const std::uint64_t lState = lRecords[i].mState.load(std::memory_order_acquire);
+            if ((lState & 1) != 0 && (lState >> 1) != lEpoch)
+            {
+                return;
+            }
+        }
+
+        sEpoch.compare_exchange_strong(lEpoch, lEpoch + 1, std::memory_order_acq_rel);
+    }
+
+    /**
+     * @brief   Frees every piece of memory in a list which no guard can still
+     *          be reading, removing it from the list.
+     *
+     * @return  The amount of memory freed.
+     */
+    static std::size_t Free (
+        std::vector<RetiredMemory>& pList
+    )
+    {
+        // Take the freeable memory out of the list first, since a deleter may
+        // itself retire more memory.
+        const std::uint64_t lEpoch = sEpoch.load(std::memory_order_acquire);
+        const auto lExpired = std::stable_partition(pList.begin(), pList.end(),
+            [lEpoch] (const RetiredMemory& pRetired) -> bool
+            {
+                return pRetired.mEpoch + 2 > lEpoch;
+            });
+        std::vector<RetiredMemory> lFreed { lExpired, pList.end() };
+        pList.erase(lExpired, pList.end());
+
+        for (const RetiredMemory& lRetired : lFreed)
+        {
+            lRetired.mDeleter(lRetired.mMemory);
+        }
+
+        sPendingCount.fetch_sub(lFreed.size(), std::memory_order_relaxed);
+        return lFreed.size();
+    }
+
+    /**
+     * @brief   Moves the epoch forward if possible, then frees what it can
+     *          from a thread's list, and from the orphaned memory if no other
+     *          thread is freeing it already.
+     */
+    static void Collect (
+        ThreadRecord&   pRecord
+    )
+    {
+        TryAdvance();
+        Free(pRecord.mRetired);
+
+        if (sHasOrphans.load(std::memory_order_acquire) == true)
+        {
+            SharedState& lShared = GetShared();
+            std::unique_lock lGuard { lShared.mOrphanMutex, std::try_to_lock };
+            if (lGuard.owns_lock() == true)
+            {
+                Free(lShared.mOrphans);
+                sHasOrphans.store(lShared.mOrphans.empty() == false, std::memory_order_release);
+            }
+        }
+    }
+
+    ThreadHandle::~ThreadHandle ()
+    {
+        if (mRecord == nullptr)
+        {
+            return;
+        }
+
+        // Hand whatever the thread has yet to free over to the others.
+        if (mRecord->mRetired.empty() == false)
+        {
+            SharedState& lShared = GetShared();
+            std::lock_guard lGuard { lShared.mOrphanMutex };
+            lShared.mOrphans.insert(lShared.mOrphans.end(), mRecord->mRetired.begin(),
+                mRecord->mRetired.end());
+            sHasOrphans.store(true, std::memory_order_release);
+        }
+
+        mRecord->mRetired.clear();
+        mRecord->mNesting = 0;
+        mRecord->mState.store(0, std::memory_order_release);
+        mRecord->mInUse.store(false, std::memory_order_release);
+        mRecord = nullptr;
+    }
+
+    /* Public Methods *********************************************************/
+
+    void EpochReclaimer::Retire (
+        void*   pMemory,
+        void    (*pDeleter)(void*)
+    )
+    {
+        if (pMemory == nullptr)
+        {
+            return;
+        }
+
+        // Tag the memory with the global epoch as of now, after it was
+        // unlinked. Any guard which could have seen it was entered in that
+        // epoch or earlier, so has been left once the epoch has moved forward
+        // twice since. The calling thread's own guard, if it is inside one,
+        // may have been entered in an older epoch than a reader's; its epoch
+        // is no bound on when the memory can be freed.
+        ThreadRecord& lRecord = GetRecord();
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        lRecord.mRetired.push_back({
+            pMemory,
+            pDeleter,
+            sEpoch.load(std::memory_order_acquire)
+        });
+
+        sPendingCount.fetch_add(1, std::memory_order_relaxed);
+        if (lRecord.mRetired.size() >= COLLECT_THRESHOLD)
+        {
+            Collect(lRecord);
+        }
+    }
+
+    void EpochReclaimer::Quiesce ()
+    {
+        ThreadRecord& lRecord = GetRecord();
+        if (lRecord.mRetired.empty() == false || sHasOrphans.load(std::memory_order_relaxed) == true)
+        {
+            Collect(lRecord);
+        }
+    }
+
+    void EpochReclaimer::Synchronize ()
+    {
+        ThreadRecord& lRecord = GetRecord();
+        while (true)
+        {
+            Collect(lRecord);
+            if (lRecord.mRetired.empty() == true && sHasOrphans.load(std::memory_order_acquire) == false)
+            {
+                return;
+            }
+
+            std::this_thread::yield();
+        }
+    }
+
+    std::uint64_t EpochReclaimer::GetEpoch ()
+    {
+        return sEpoch.load(std::memory_order_acquire);
+    }
+
+    std::size_t EpochReclaimer::GetPendingCount ()
+    {
+        return sPendingCount.load(std::memory_order_relaxed);
+    }
+
+    /* Private Methods ********************************************************/
+
+    void EpochReclaimer::Enter ()
+    {
+        // Only the outermost guard announces the thread. The fence keeps the
+        // announcement from being reordered past the loads the guard
+        // protects.
+        ThreadRecord& lRecord = GetRecord();
+        if (lRecord.mNesting++ == 0)
+        {
+            lRecord.mState.store((sEpoch.load(std::memory_order_relaxed) << 1) | 1,
+                std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+    }
+
+    void EpochReclaimer::Leave ()
+    {
+        ThreadRecord& lRecord = *sThread.mRecord;
+        if (--lRecord.mNesting == 0)
+        {
+            lRecord.mState.store(lRecord.mState.load(std::memory_order_relaxed) & ~std::uint64_t { 1 },
+                std::memory_order_release);
+        }
+    }
+
+}
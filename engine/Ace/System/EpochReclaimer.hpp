@@ -0,0 +1,180 @@
+/**
+ * @file    Ace/System/EpochReclaimer.hpp
+ * @brief   Provides epoch-based reclamation, which defers freeing memory
+ *          unlinked from lock-free structures until no reader can still hold
+ *          a pointer to it.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A static class which frees memory retired from lock-free
+     *          structures once every thread is done with it.
+     *
+     * A lock-free structure cannot free a node the moment it unlinks it:
+     * another thread may have loaded a pointer to the node just before, and
+     * still be reading it. Instead, the node is handed to @a `Retire`, and
+     * freed once that can no longer be the case.
+     *
+     * Readers mark the stretches of code in which they hold such pointers
+     * with an @a `EpochGuard`. Entering a guard costs one store and one
+     * fence, and no shared counters are touched, so reads stay cheap no
+     * matter how many threads share a structure. A global epoch counter
+     * moves forward once every thread inside a guard has seen its current
+     * value. Memory retired in one epoch is freed once the epoch has moved
+     * forward twice since, by which time every guard which could have seen
+     * it has been left.
+     *
+     * Each thread keeps the memory it retires in a list of its own, which it
+     * frees from at its quiescent points: at the end of each frame of an
+     * @a `IApplication`'s loop, and between tasks on a @a `ThreadPool` or
+     * @a `JobSystem` worker. Threads may also call @a `Quiesce` themselves.
+     * A thread's list is also checked whenever it grows long, so memory does
+     * not pile up on threads which retire a lot. When a thread exits, any
+     * memory it has yet to free is handed to whichever thread quiesces next.
+     *
+     * A thread which stays in a guard holds back reclamation for every
+     * thread, so guards should be short: a lookup, a walk, a single insert.
+     */
+    class ACE_API EpochReclaimer final
+    {
+    public:
+
+        /**
+         * @brief   The number of pieces of retired memory a thread may hold
+         *          before it tries to free some, even between quiescent
+         *          points.
+         */
+        static constexpr std::size_t COLLECT_THRESHOLD = 128;
+
+    public:
+
+        /**
+         * @brief   Retires an object, to be deleted once no guard can still
+         *          be reading it.
+         *
+         * @tparam  T           The type of object.
+         *
+         * @param   pObject     The object, which must already be unreachable
+         *                      by any thread which enters a guard from now
+         *                      on.
+         */
+        template <typename T>
+        static inline void Retire (
+            T*  pObject
+        )
+        {
+            Retire(
+                pObject,
+                [] (void* pMemory) -> void
+                {
+                    delete static_cast<T*>(pMemory);
+                }
+            );
+        }
+
+        /**
+         * @brief   Retires memory, to be freed by the given function once no
+         *          guard can still be reading it.
+         *
+         * @param   pMemory     The memory, which must already be unreachable
+         *                      by any thread which enters a guard from now
+         *                      on.
+         * @param   pDeleter    The function which frees the memory.
+         */
+        static void Retire (
+            void*   pMemory,
+            void    (*pDeleter)(void*)
+        );
+
+        /**
+         * @brief   Marks a quiescent point on the calling thread: tries to move
+         *          the epoch forward, then frees whatever the thread has
+         *          retired which no guard can still be reading. Cheap if the
+         *          thread has nothing retired.
+         */
+        static void Quiesce ();
+
+        /**
+         * @brief   Waits until everything the calling thread has retired, and
+         *          everything handed over by exited threads, has been freed.
+         *
+         * Blocks for as long as any other thread stays in a guard. Must not be
+         * called from within a guard.
+         */
+        static void Synchronize ();
+
+        /**
+         * @brief   Retrieves the global epoch.
+         *
+         * @return  The number of times the epoch has moved forward.
+         */
+        static std::uint64_t GetEpoch ();
+
+        /**
+         * @brief   Retrieves the number of pieces of retired memory, across
+         *          all threads, which have not been freed yet.
+         *
+         * @return  The amount of memory awaiting reclamation.
+         */
+        static std::size_t GetPendingCount ();
+
+    private:
+        friend class EpochGuard;
+
+        /**
+         * @brief   Enters a guard on the calling thread.
+         */
+        static void Enter ();
+
+        /**
+         * @brief   Leaves a guard on the calling thread.
+         */
+        static void Leave ();
+
+    };
+
+    /**
+     * @brief   A class which marks, for its lifetime, a stretch of code in
+     *          which the calling thread may hold pointers into lock-free
+     *          structures whose memory is reclaimed by the
+     *          @a `EpochReclaimer`.
+     *
+     * Guards may be nested; only the outermost one has any effect. A guard
+     * must be left on the thread it was entered on, so a job must not hold
+     * one across a call to @a `JobSystem::Wait`, after which it may resume on
+     * another thread.
+     */
+    class ACE_API EpochGuard final
+    {
+    public:
+
+        /**
+         * @brief   Enters the guard.
+         */
+        inline EpochGuard ()
+        {
+            EpochReclaimer::Enter();
+        }
+
+        /**
+         * @brief   Leaves the guard.
+         */
+        inline ~EpochGuard ()
+        {
+            EpochReclaimer::Leave();
+        }
+
+    private:
+        EpochGuard (const EpochGuard&) = delete;
+        EpochGuard (EpochGuard&&) = delete;
+        void operator= (const EpochGuard&) = delete;
+        void operator= (EpochGuard&&) = delete;
+
+    };
+
+}
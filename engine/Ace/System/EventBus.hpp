@@ -5,6 +5,7 @@
 
 #pragma once
 #include <Ace/System/RingBuffer.hpp>
+#include <Ace/System/Settings.hpp>
 
 namespace ace
 {
@@ -208,7 +209,7 @@ namespace ace
                 };
 
             // Attempt to enqueue the dispatcher function. Drop it if it fails.
-            sEventBuffer.Enqueue(std::move(lDispatcher));
+            GetEventBuffer().Enqueue(std::move(lDispatcher));
         }
 
         /**
@@ -216,7 +217,7 @@ namespace ace
          */
         static void Dispatch ()
         {
-            while (auto lPublishedEvent = sEventBuffer.Dequeue())
+            while (auto lPublishedEvent = GetEventBuffer().Dequeue())
             {
                 (*lPublishedEvent)();
             }
@@ -225,9 +226,10 @@ namespace ace
     private:
 
         /**
-         * @brief   The maximum number of events which can be published.
+         * @brief   The default maximum number of events which can be published,
+         *          used unless the `eventbus.capacity` setting overrides it.
          */
-        static constexpr std::size_t MAX_PUBLISHED_EVENTS = (1 << 10);
+        static constexpr std::size_t DEFAULT_PUBLISHED_EVENTS = (1 << 10);
 
         /**
          * @brief   The base structure for the event bus's templated event
@@ -294,12 +296,28 @@ namespace ace
          *          published events.
          */
         using EventBuffer = RingBuffer<
-            std::function<void()>,
-            MAX_PUBLISHED_EVENTS
+            std::function<void()>
         >;
 
     private:
-        static inline EventBuffer               sEventBuffer {};    ///< @brief The ring buffer of published events to be handled later.
+
+        /**
+         * @brief   Retrieves the ring buffer of published events to be handled
+         *          later, creating it on first use with the capacity given by
+         *          the `eventbus.capacity` setting.
+         *
+         * @return  A handle to the published events' ring buffer.
+         */
+        static EventBuffer& GetEventBuffer ()
+        {
+            static EventBuffer sEventBuffer {
+                Settings::Get<std::size_t>("eventbus.capacity", DEFAULT_PUBLISHED_EVENTS)
+            };
+
+            return sEventBuffer;
+        }
+
+    private:
         static inline EventMap                  sHandlers;          ///< @brief The map of event handlers.
         static inline std::mutex                sHandlersMutex;     ///< @brief The mutex used to lock down the event handlers map.
         static inline std::atomic<std::size_t>  sNextID { 1 };      ///< @brief The subscription ID to be assigned to the next event handler.
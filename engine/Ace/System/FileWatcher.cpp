@@ -3,6 +3,8 @@
  */
 
 #if defined(ACE_LINUX)
+    #include <poll.h>
+    #include <sys/eventfd.h>
     #include <sys/inotify.h>
     #include <unistd.h>
 #endif
@@ -19,6 +21,7 @@ namespace ace
     {
     #if defined(ACE_LINUX)
         std::int32_t mNotifyDescriptor = -1;
+        std::int32_t mWakeDescriptor = -1;
         std::unordered_map<std::int32_t, fs::path> mWatchDescriptors;
     #endif
     };
@@ -55,6 +58,13 @@ namespace ace
             mDirectories.push_back(lDirectory);
         }
 
+        // Create the descriptor `Stop` wakes the worker thread with.
+        #if defined(ACE_LINUX)
+        {
+            mContext->mWakeDescriptor = ::eventfd(0, EFD_NONBLOCK);
+        }
+        #endif
+
         // Start the worker thread.
         mThread = std::thread {
             [this] -> void
@@ -72,12 +82,15 @@ namespace ace
             return;
         }
 
+        // Wake the worker thread from its wait, and wait for it to finish
+        // before closing the descriptors it waits on.
         #if defined(ACE_LINUX)
         {
-            if (mContext->mNotifyDescriptor >= 0)
+            if (mContext->mWakeDescriptor >= 0)
             {
-                ::close(mContext->mNotifyDescriptor);
-                mContext->mWatchDescriptors.clear();
+                const std::uint64_t lSignal = 1;
+                [[maybe_unused]] auto lWritten =
+                    ::write(mContext->mWakeDescriptor, &lSignal, sizeof(lSignal));
             }
         }
         #endif
@@ -87,6 +100,23 @@ namespace ace
             mThread.join();
         }
 
+        #if defined(ACE_LINUX)
+        {
+            if (mContext->mNotifyDescriptor >= 0)
+            {
+                ::close(mContext->mNotifyDescriptor);
+                mContext->mNotifyDescriptor = -1;
+                mContext->mWatchDescriptors.clear();
+            }
+
+            if (mContext->mWakeDescriptor >= 0)
+            {
+                ::close(mContext->mWakeDescriptor);
+                mContext->mWakeDescriptor = -1;
+            }
+        }
+        #endif
+
         mDirectories.clear();
     }
 
@@ -131,12 +161,16 @@ namespace ace
                     WATCH_BUFFER_SIZE
                 );
 
-                // If nothing was read, then wait a little bit before continuing.
+                // If nothing was read, then block until a change is reported
+                // or `Stop` wakes the thread. Without a wake descriptor, check
+                // back every 100 ms instead.
                 if (lBytesRead <= 0)
                 {
-                    std::this_thread::sleep_for(
-                        std::chrono::milliseconds(100)
-                    );
+                    pollfd lDescriptors[2] = {
+                        { mContext->mNotifyDescriptor, POLLIN, 0 },
+                        { mContext->mWakeDescriptor, POLLIN, 0 }
+                    };
+                    ::poll(lDescriptors, 2, (mContext->mWakeDescriptor >= 0) ? -1 : 100);
                     continue;
                 }
 
@@ -2,20 +2,48 @@
  * @file    Ace/System/IApplication.cpp
  */
 
+#include <cmath>
+#include <Ace/System/EpochReclaimer.hpp>
+#include <Ace/System/EventBus.hpp>
 #include <Ace/System/Logger.hpp>
 #include <Ace/System/IApplication.hpp>
 
 namespace ace
 {
 
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   The framerate used in place of one which is not positive and
+     *          finite.
+     */
+    static constexpr float DEFAULT_FRAMERATE = 60.0f;
+
+    /**
+     * @brief   Determines whether a framerate yields a usable fixed timestep.
+     */
+    static bool IsValidFramerate (
+        const float pFramerate
+    )
+    {
+        return std::isfinite(pFramerate) == true && pFramerate > 0.0f &&
+            std::isfinite(1.0f / pFramerate) == true;
+    }
+
     /* Constructors and Destructor ********************************************/
 
     IApplication::IApplication (
         const ApplicationSpec& pSpec
     ) :
-        mFixedTimestep  { 1.0f / pSpec.mFramerate }
+        mFixedTimestep  { 1.0f / ((IsValidFramerate(pSpec.mFramerate) == true) ?
+            pSpec.mFramerate : DEFAULT_FRAMERATE) }
     {
         Logger::Initialize();
+        if (IsValidFramerate(pSpec.mFramerate) == false)
+        {
+            ACE_LOG_WARNING("Framerate {} is not positive and finite; using {} instead.",
+                pSpec.mFramerate, DEFAULT_FRAMERATE);
+        }
     }
 
     IApplication::~IApplication ()
@@ -27,7 +55,75 @@ namespace ace
 
     std::int32_t IApplication::Start ()
     {
-        return 0;
+        using Clock = std::chrono::steady_clock;
+
+        // Frames are capped to the fixed timestep. The time carried into fixed
+        // updates is capped, too, so that a long stall does not trigger a
+        // burst of catch-up updates.
+        const auto lFramePeriod = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<float> { mFixedTimestep });
+        const float lMaxAccumulated = mFixedTimestep * 8.0f;
+
+        mRunning.store(true);
+        auto lPrevious = Clock::now();
+        float lAccumulated = 0.0f;
+        while (mRunning.load() == true)
+        {
+            const auto lFrameStart = Clock::now();
+            const float lDelta =
+                std::chrono::duration<float> { lFrameStart - lPrevious }.count();
+            lPrevious = lFrameStart;
+
+            // Sample input up to the start of the frame, so that every phase
+            // below sees the same input.
+            mInput.Sample(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    lFrameStart.time_since_epoch()).count()
+            );
+
+            EventBus::Dispatch();
+
+            lAccumulated = std::min(lAccumulated + lDelta, lMaxAccumulated);
+            while (lAccumulated >= mFixedTimestep)
+            {
+                OnFixedUpdate(mFixedTimestep);
+                lAccumulated -= mFixedTimestep;
+            }
+
+            OnUpdate(lDelta);
+
+            // The frame boundary is the main thread's quiescent point: free
+            // whatever it retired which no other thread can still be reading.
+            EpochReclaimer::Quiesce();
+
+            std::this_thread::sleep_until(lFrameStart + lFramePeriod);
+        }
+
+        return mExitCode;
+    }
+
+    void IApplication::Quit (
+        const std::int32_t  pExitCode
+    )
+    {
+        mExitCode = pExitCode;
+        mRunning.store(false);
+    }
+
+    /* Protected Methods ******************************************************/
+
+    void IApplication::OnUpdate (
+        const float&    pDelta
+    )
+    {
+        (void) pDelta;
+    }
+
+    void IApplication::OnFixedUpdate (
+        const float&    pTimestep
+    )
+    {
+        (void) pTimestep;
     }
 
 }
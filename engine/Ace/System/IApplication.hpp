@@ -4,7 +4,8 @@
  */
 
 #pragma once
-#include <Ace/Common.hpp>
+#include <Ace/Input/InputPipeline.hpp>
+#include <Ace/System/Settings.hpp>
 
 namespace ace
 {
@@ -15,7 +16,7 @@ namespace ace
      */
     struct ApplicationSpec
     {
-        float mFramerate = 60.0f;       ///< @brief The client application's maximum framerate.
+        float mFramerate = Settings::Get<float>("application.framerate", 60.0f);   ///< @brief The client application's maximum framerate. Defaults to the `application.framerate` setting; 60 is used if it is not positive and finite.
     };
     
     /**
@@ -47,6 +48,21 @@ namespace ace
         /**
          * @brief   Starts the client application's main loop.
          * 
+         * Each frame of the loop runs in a fixed order of phases:
+         * 
+         * 1. Input timestamped up to the start of the frame is sampled from
+         *    @a `mInput`.
+         * 
+         * 2. Events published to the @a `EventBus` are dispatched.
+         * 
+         * 3. @a `OnFixedUpdate` is called once for each fixed timestep which
+         *    has elapsed.
+         * 
+         * 4. @a `OnUpdate` is called once.
+         * 
+         * The loop then sleeps until the next frame is due, and runs until
+         * @a `Quit` is called.
+         * 
          * The return value of this method is intended to be returned by the 
          * client application's `main` function.
          * 
@@ -55,8 +71,53 @@ namespace ace
          */
         virtual std::int32_t Start ();
 
+        /**
+         * @brief   Asks the main loop to exit at the end of the current frame.
+         * 
+         * @param   pExitCode   The value to be returned by @a `Start`.
+         */
+        void Quit (
+            const std::int32_t  pExitCode = 0
+        );
+
+        /**
+         * @brief   Retrieves the pipeline which input is pushed into, and
+         *          sampled from once per frame.
+         * 
+         * @return  A handle to the application's input pipeline.
+         */
+        inline InputPipeline& GetInput ()
+        {
+            return mInput;
+        }
+
+    protected:
+
+        /**
+         * @brief   Called once per frame, after input has been sampled.
+         * 
+         * @param   pDelta  The time elapsed since the previous frame, in
+         *                  seconds.
+         */
+        virtual void OnUpdate (
+            const float&    pDelta
+        );
+
+        /**
+         * @brief   Called once per elapsed fixed timestep, before
+         *          @a `OnUpdate`.
+         * 
+         * @param   pTimestep   The fixed timestep, in seconds.
+         */
+        virtual void OnFixedUpdate (
+            const float&    pTimestep
+        );
+
     protected:
-        float mFixedTimestep = 0.0f;    ///< @brief The application's fixed timestep; controls how frequently @a `fixedUpdate` is called.
+        float               mFixedTimestep = 0.0f;  ///< @brief The application's fixed timestep; controls how frequently @a `OnFixedUpdate` is called.
+        InputPipeline       mInput;                 ///< @brief The pipeline carrying input from the platform thread.
+        std::atomic<bool>   mRunning { false };     ///< @brief Indicates whether or not the main loop is running.
+        std::int32_t        mExitCode = 0;          ///< @brief The value to be returned by @a `Start`.
 
     };
 
@@ -5,6 +5,7 @@
  */
 
 #pragma once
+#include <span>
 #include <Ace/Common.hpp>
 
 namespace ace
@@ -88,6 +89,22 @@ namespace ace
          */
         virtual std::size_t GetSize () const = 0;
 
+        /**
+         * @brief   Maps the whole of the opened file into memory, so that it
+         *          can be used in place without being copied.
+         *
+         * The mapping is read-only, and remains valid until the file is
+         * closed or destroyed. Files which cannot be mapped return an empty
+         * span, and must be read instead; this is the default.
+         *
+         * @return  A span over the file's contents, or an empty span if the
+         *          file cannot be mapped.
+         */
+        virtual std::span<const std::uint8_t> Map ()
+        {
+            return {};
+        }
+
         /**
          * @brief   Closes the virtual file, rendering any subsequent reads and
          *          seeks invalid.
@@ -0,0 +1,112 @@
+/**
+ * @file    Ace/System/IVirtualWritableFile.hpp
+ * @brief   Provides an abstract interface representing a file opened for
+ *          writing through the virtual filesystem (VFS).
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates when a written file's data is forced out to
+     *          storage, so that it survives a power loss.
+     */
+    enum class FileSyncPolicy
+    {
+        None,       ///< @brief Never; the operating system writes the data out in its own time.
+        OnCommit,   ///< @brief Once, when the file is committed, before it replaces anything.
+        OnFlush     ///< @brief On every flush, as well as on commit.
+    };
+
+    /**
+     * @brief   A structure containing the settings a file is opened for
+     *          writing with.
+     */
+    struct FileWriteSpec
+    {
+        bool            mAtomic = true;                 ///< @brief Write to a temporary file, which replaces the file only on commit?
+        bool            mAppend = false;                ///< @brief Keep the file's existing contents, and write after them?
+        FileSyncPolicy  mSync = FileSyncPolicy::None;   ///< @brief When to force the data out to storage.
+        std::size_t     mBufferSize = 64 * 1024;        ///< @brief The number of bytes gathered before they are handed to the operating system.
+    };
+
+    /**
+     * @brief   An abstract interface representing a file opened for writing
+     *          through the virtual filesystem (VFS).
+     *
+     * Writes are gathered in a buffer, and handed on in large pieces. An
+     * atomic file is written aside, and only replaces the file at its path
+     * when committed, so that readers, and the file after a crash, see
+     * either all of the old contents or all of the new. A file destroyed
+     * without being committed is discarded.
+     */
+    class ACE_API IVirtualWritableFile
+    {
+    public:
+
+        /**
+         * @brief   The virtual destructor.
+         */
+        virtual ~IVirtualWritableFile () = default;
+
+        /**
+         * @brief   Writes the given number of bytes from the data buffer
+         *          pointed to by `pBuffer`.
+         *
+         * @param   pBuffer     A raw pointer to the data to be written.
+         * @param   pBytes      The number of bytes to be written.
+         *
+         * @return  `true` if the bytes were written; `false` if there was an
+         *          error, or the file is no longer open.
+         *
+         * @throws  `std::invalid_argument` should be thrown if `pBuffer` is
+         *          `nullptr` and `pBytes` is not zero.
+         */
+        virtual bool Write (
+            const void*         pBuffer,
+            const std::size_t&  pBytes
+        ) = 0;
+
+        /**
+         * @brief   Hands any buffered bytes on, and forces them out to
+         *          storage under @a `FileSyncPolicy::OnFlush`.
+         *
+         * An atomic file's flushed bytes are still not visible at its path
+         * until it is committed.
+         *
+         * @return  `true` if the bytes were handed on; `false` otherwise.
+         */
+        virtual bool Flush () = 0;
+
+        /**
+         * @brief   Retrieves the size the file will have once committed,
+         *          counting any contents it was appended to.
+         *
+         * @return  The size of the written file, in bytes.
+         */
+        virtual std::size_t Tell () const = 0;
+
+        /**
+         * @brief   Flushes the file, forces it out to storage unless the sync
+         *          policy is @a `FileSyncPolicy::None`, and closes it; an
+         *          atomic file then replaces the file at its path.
+         *
+         * @return  `true` if every byte written is now at the file's path;
+         *          `false` otherwise, in which case an atomic file leaves the
+         *          file at its path as it was.
+         */
+        virtual bool Commit () = 0;
+
+        /**
+         * @brief   Closes the file without committing it. An atomic file
+         *          leaves the file at its path as it was; any other keeps
+         *          whatever was flushed.
+         */
+        virtual void Discard () = 0;
+
+    };
+
+}
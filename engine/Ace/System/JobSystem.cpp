@@ -0,0 +1,505 @@
+/**
+ * @file    Ace/System/JobSystem.cpp
+ */
+
+#if defined(ACE_LINUX)
+    #include <sys/mman.h>
+    #include <ucontext.h>
+    #include <unistd.h>
+#else
+    #error "The Ace Engine's job system does not currently support your operating system."
+#endif
+
+#include <Ace/System/EpochReclaimer.hpp>
+#include <Ace/System/JobSystem.hpp>
+#include <Ace/System/Logger.hpp>
+
+namespace ace
+{
+
+    /* `Fiber` Structure ******************************************************/
+
+    /**
+     * @brief   Enumerates the reasons a fiber switches back to its worker.
+     */
+    enum class FiberState : std::uint8_t
+    {
+        Running,    ///< @brief The fiber is running a job.
+        Finished,   ///< @brief The fiber's job has finished, and the fiber is free.
+        Waiting     ///< @brief The fiber's job is waiting on a counter.
+    };
+
+    struct Fiber
+    {
+        JobSystem*              mOwner = nullptr;                   ///< @brief The job system whose pool the fiber belongs to.
+        ucontext_t              mContext {};                        ///< @brief The fiber's saved context.
+        ucontext_t*             mWorkerContext = nullptr;           ///< @brief The context of the worker running the fiber, to switch back to.
+        void*                   mStack = nullptr;                   ///< @brief The fiber's stack, including its guard page.
+        std::size_t             mStackSize = 0;                     ///< @brief The size of @a `mStack`, in bytes.
+        std::function<void()>   mFunction;                          ///< @brief The job the fiber is running.
+        JobCounter*             mCounter = nullptr;                 ///< @brief The counter tracking the job, if any.
+        JobCounter*             mWaitCounter = nullptr;             ///< @brief The counter the job is waiting on.
+        FiberState              mState = FiberState::Finished;      ///< @brief Why the fiber last switched back to its worker.
+
+        ~Fiber ()
+        {
+            if (mStack != nullptr)
+            {
+                ::munmap(mStack, mStackSize);
+            }
+        }
+    };
+
+    /* Static Members *********************************************************/
+
+    static thread_local Fiber* sCurrentFiber = nullptr;     ///< @brief The fiber the calling worker is running, if any.
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   Retrieves the calling thread's current fiber.
+     *
+     * Kept out of line so that the compiler cannot reuse the address of the
+     * thread-local across a fiber switch, after which the fiber may be
+     * running on another thread.
+     */
+    [[gnu::noinline]] static Fiber* GetCurrentFiber ()
+    {
+        return sCurrentFiber;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    JobSystem::JobSystem (
+        const JobSystemSpec&    pSpec
+    ) :
+        mSpec   { pSpec }
+    {
+        if (mSpec.mThreadCount == 0 || mSpec.mFiberCount == 0 || mSpec.mStackSize == 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: The thread count, fiber count and stack size must not be zero!",
+                "JobSystem");
+        }
+
+        mSpec.mMaxFiberCount = std::max(mSpec.mMaxFiberCount, mSpec.mFiberCount);
+        {
+            std::lock_guard lGuard { mMutex };
+            for (std::size_t i = 0; i < mSpec.mFiberCount; ++i)
+            {
+                mFreeFibers.push_back(CreateFiber());
+            }
+        }
+
+        for (std::size_t i = 0; i < mSpec.mThreadCount; ++i)
+        {
+            mWorkerThreads.emplace_back(&JobSystem::RunWorker, this);
+        }
+    }
+
+    JobSystem::~JobSystem ()
+    {
+        {
+            std::lock_guard lGuard { mMutex };
+            mDone = true;
+        }
+
+        mConditional.notify_all();
+        for (auto& lThread : mWorkerThreads)
+        {
+            lThread.join();
+        }
+    }
+
+    /* Public Methods *********************************************************/
+
+    void JobSystem::Run (
+        std::function<void()>   pJob,
+        JobCounter*             pCounter
+    )
+    {
+        if (pCounter != nullptr)
+        {
+            pCounter->mValue.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        // Jobs run from within a job go to the front of the queue, so that
+        // children finish before more parents start.
+        const bool lNested = IsInJob();
+        {
+            std::lock_guard lGuard { mMutex };
+            if (lNested == true)
+            {
+                mJobs.push_front({ std::move(pJob), pCounter });
+            }
+            else
+            {
+                mJobs.push_back({ std::move(pJob), pCounter });
+            }
+        }
+
+        mConditional.notify_one();
+    }
+
+    void JobSystem::Run (
+        std::vector<std::function<void()>>  pJobs,
+        JobCounter&                         pCounter
+    )
+    {
+        if (pJobs.empty() == true)
+        {
+            return;
+        }
+
+        pCounter.mValue.fetch_add(static_cast<std::int64_t>(pJobs.size()),
+            std::memory_order_relaxed);
+
+        const bool lNested = IsInJob();
+        {
+            std::lock_guard lGuard { mMutex };
+            if (lNested == true)
+            {
+                for (auto lIter = pJobs.rbegin(); lIter != pJobs.rend(); ++lIter)
+                {
+                    mJobs.push_front({ std::move(*lIter), &pCounter });
+                }
+            }
+            else
+            {
+                for (auto& lJob : pJobs)
+                {
+                    mJobs.push_back({ std::move(lJob), &pCounter });
+                }
+            }
+        }
+
+        mConditional.notify_all();
+    }
+
+    void JobSystem::Wait (
+        JobCounter& pCounter
+    )
+    {
+        Fiber* lFiber = GetCurrentFiber();
+        if (lFiber != nullptr && lFiber->mOwner == this)
+        {
+            // Suspend the job's fiber, unless the counter has already reached
+            // zero. The worker registers the fiber as a waiter once it has
+            // switched off the fiber's stack, so that no other worker can
+            // resume the fiber while it is still running.
+            bool lDone = false;
+            {
+                std::lock_guard lGuard { pCounter.mMutex };
+                lDone = pCounter.mValue.load(std::memory_order_acquire) == 0;
+            }
+
+            if (lDone == false)
+            {
+                mSuspendCount.fetch_add(1, std::memory_order_relaxed);
+                lFiber->mWaitCounter = &pCounter;
+                lFiber->mState = FiberState::Waiting;
+                ::swapcontext(&lFiber->mContext, lFiber->mWorkerContext);
+            }
+        }
+        else
+        {
+            // Block the calling thread until the counter reaches zero.
+            std::int64_t lValue = pCounter.mValue.load(std::memory_order_acquire);
+            while (lValue != 0)
+            {
+                pCounter.mValue.wait(lValue, std::memory_order_acquire);
+                lValue = pCounter.mValue.load(std::memory_order_acquire);
+            }
+        }
+
+        // Taking the counter's lock once more ensures the job which finished
+        // it is done with the counter, which may be destroyed once this
+        // returns.
+        std::exception_ptr lException = nullptr;
+        {
+            std::lock_guard lGuard { pCounter.mMutex };
+            lException = std::exchange(pCounter.mException, nullptr);
+        }
+
+        if (lException != nullptr)
+        {
+            std::rethrow_exception(lException);
+        }
+    }
+
+    void JobSystem::ParallelFor (
+        const std::size_t&                          pCount,
+        const std::function<void(std::size_t)>&     pFunction,
+        const std::size_t&                          pGrainSize
+    )
+    {
+        const std::size_t lGrainSize = std::max<std::size_t>(pGrainSize, 1);
+        std::vector<std::function<void()>> lJobs;
+        lJobs.reserve((pCount + lGrainSize - 1) / lGrainSize);
+        for (std::size_t lBegin = 0; lBegin < pCount; lBegin += lGrainSize)
+        {
+            const std::size_t lEnd = std::min(lBegin + lGrainSize, pCount);
+            lJobs.push_back(
+                [&pFunction, lBegin, lEnd] () -> void
+                {
+                    for (std::size_t i = lBegin; i < lEnd; ++i)
+                    {
+                        pFunction(i);
+                    }
+                });
+        }
+
+        JobCounter lCounter;
+        Run(std::move(lJobs), lCounter);
+        Wait(lCounter);
+    }
+
+    bool JobSystem::IsInJob () const
+    {
+        Fiber* lFiber = GetCurrentFiber();
+        return lFiber != nullptr && lFiber->mOwner == this;
+    }
+
+    std::size_t JobSystem::GetFiberCount () const
+    {
+        std::lock_guard lGuard { mMutex };
+        return mFibers.size();
+    }
+
+    /* Private Methods ********************************************************/
+
+    Fiber* JobSystem::CreateFiber ()
+    {
+        // Allocate the stack with an inaccessible guard page beneath it.
+        const std::size_t lPageSize = static_cast<std::size_t>(::sysconf(_SC_PAGESIZE));
+        const std::size_t lStackSize = (mSpec.mStackSize + lPageSize - 1) / lPageSize * lPageSize;
+
+        auto lFiber = std::make_unique<Fiber>();
+        lFiber->mOwner = this;
+        lFiber->mStackSize = lStackSize + lPageSize;
+        lFiber->mStack = ::mmap(nullptr, lFiber->mStackSize, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0);
+        if (lFiber->mStack == MAP_FAILED)
+        {
+            lFiber->mStack = nullptr;
+            throw std::bad_alloc {};
+        }
+
+        ::mprotect(lFiber->mStack, lPageSize, PROT_NONE);
+
+        // Point the fiber's context at its entry point. `makecontext` only
+        // passes `int` arguments, so the fiber's address is split in two.
+        const auto lAddress = reinterpret_cast<std::uintptr_t>(lFiber.get());
+        ::getcontext(&lFiber->mContext);
+        lFiber->mContext.uc_stack.ss_sp = static_cast<std::uint8_t*>(lFiber->mStack) + lPageSize;
+        lFiber->mContext.uc_stack.ss_size = lStackSize;
+        lFiber->mContext.uc_link = nullptr;
+        ::makecontext(&lFiber->mContext, reinterpret_cast<void (*)()>(&JobSystem::RunFiber), 2,
+            static_cast<std::uint32_t>(lAddress),
+            static_cast<std::uint32_t>(static_cast<std::uint64_t>(lAddress) >> 32));
+
+        mFibers.push_back(std::move(lFiber));
+        return mFibers.back().get();
+    }
+
+    void JobSystem::RunWorker ()
+    {
+        ucontext_t lContext {};
+        while (true)
+        {
+            // Take a resumed fiber, or else a new job on a free fiber, growing
+            // the pool if every fiber is in use.
+            Fiber* lFiber = nullptr;
+            {
+                std::unique_lock lGuard { mMutex };
+                mConditional.wait(
+                    lGuard,
+                    [this] () -> bool
+                    {
+                        return
+                            mDone == true ||
+                            mReadyFibers.empty() == false ||
+                            (
+                                mJobs.empty() == false &&
+                                (mFreeFibers.empty() == false || mFibers.size() < mSpec.mMaxFiberCount)
+                            );
+                    }
+                );
+
+                if (mReadyFibers.empty() == false)
+                {
+                    lFiber = mReadyFibers.front();
+                    mReadyFibers.pop_front();
+                }
+                else if (mJobs.empty() == false)
+                {
+                    if (mFreeFibers.empty() == false)
+                    {
+                        lFiber = mFreeFibers.back();
+                        mFreeFibers.pop_back();
+                    }
+                    else if (mFibers.size() < mSpec.mMaxFiberCount)
+                    {
+                        lFiber = CreateFiber();
+                    }
+
+                    if (lFiber != nullptr)
+                    {
+                        lFiber->mFunction = std::move(mJobs.front().mFunction);
+                        lFiber->mCounter = mJobs.front().mCounter;
+                        mJobs.pop_front();
+                    }
+                }
+
+                if (lFiber == nullptr)
+                {
+                    if (mDone == true)
+                    {
+                        return;
+                    }
+
+                    continue;
+                }
+            }
+
+            // Switch to the fiber until it finishes its job, or waits.
+            lFiber->mWorkerContext = &lContext;
+            lFiber->mState = FiberState::Running;
+            sCurrentFiber = lFiber;
+            ::swapcontext(&lContext, &lFiber->mContext);
+            sCurrentFiber = nullptr;
+            EpochReclaimer::Quiesce();
+
+            if (lFiber->mState == FiberState::Finished)
+            {
+                bool lJobsWaiting = false;
+                {
+                    std::lock_guard lGuard { mMutex };
+                    mFreeFibers.push_back(lFiber);
+                    lJobsWaiting = mJobs.empty() == false;
+                }
+
+                if (lJobsWaiting == true)
+                {
+                    mConditional.notify_one();
+                }
+            }
+            else if (lFiber->mState == FiberState::Waiting)
+            {
+                // Now that the fiber's stack is no longer in use, register the
+                // fiber as a waiter, or make it ready straight away if the
+                // counter reached zero in the meantime.
+                JobCounter& lCounter = *std::exchange(lFiber->mWaitCounter, nullptr);
+                bool lReady = false;
+                {
+                    std::lock_guard lGuard { lCounter.mMutex };
+                    if (lCounter.mValue.load(std::memory_order_acquire) == 0)
+                    {
+                        lReady = true;
+                    }
+                    else
+                    {
+                        lCounter.mWaiters.push_back(lFiber);
+                    }
+                }
+
+                if (lReady == true)
+                {
+                    {
+                        std::lock_guard lGuard { mMutex };
+                        mReadyFibers.push_back(lFiber);
+                    }
+
+                    mConditional.notify_one();
+                }
+            }
+        }
+    }
+
+    void JobSystem::RunFiber (
+        const std::uint32_t pLow,
+        const std::uint32_t pHigh
+    )
+    {
+        Fiber* lFiber = reinterpret_cast<Fiber*>(
+            (static_cast<std::uintptr_t>(pHigh) << 32) | pLow);
+
+        while (true)
+        {
+            std::exception_ptr lException = nullptr;
+            try
+            {
+                lFiber->mFunction();
+            }
+            catch (...)
+            {
+                lException = std::current_exception();
+            }
+
+            lFiber->mFunction = nullptr;
+            if (JobCounter* lCounter = std::exchange(lFiber->mCounter, nullptr))
+            {
+                lFiber->mOwner->Finish(*lCounter, lException);
+            }
+            else if (lException != nullptr)
+            {
+                try
+                {
+                    std::rethrow_exception(lException);
+                }
+                catch (const std::exception& lEx)
+                {
+                    ACE_LOG_ERROR("JobSystem: Uncaught exception in a job without a counter: {}",
+                        lEx.what());
+                }
+                catch (...)
+                {
+                    ACE_LOG_ERROR("JobSystem: Uncaught exception in a job without a counter.");
+                }
+            }
+
+            // Hand the fiber back to its worker, which returns it to the pool.
+            // It picks up here when it is given its next job.
+            lFiber->mState = FiberState::Finished;
+            ::swapcontext(&lFiber->mContext, lFiber->mWorkerContext);
+        }
+    }
+
+    void JobSystem::Finish (
+        JobCounter&         pCounter,
+        std::exception_ptr  pException
+    )
+    {
+        // Everything touching the counter happens under its lock, so that a
+        // waiter cannot destroy it while this job is still using it.
+        std::vector<Fiber*> lWaiters;
+        {
+            std::lock_guard lGuard { pCounter.mMutex };
+            if (pException != nullptr && pCounter.mException == nullptr)
+            {
+                pCounter.mException = pException;
+            }
+
+            if (pCounter.mValue.fetch_sub(1, std::memory_order_acq_rel) != 1)
+            {
+                return;
+            }
+
+            lWaiters.swap(pCounter.mWaiters);
+            pCounter.mValue.notify_all();
+        }
+
+        if (lWaiters.empty() == false)
+        {
+            {
+                std::lock_guard lGuard { mMutex };
+                for (Fiber* lWaiter : lWaiters)
+                {
+                    mReadyFibers.push_back(lWaiter);
+                }
+            }
+
+            mConditional.notify_all();
+        }
+    }
+
+}
@@ -0,0 +1,291 @@
+/**
+ * @file    Ace/System/JobSystem.hpp
+ * @brief   Provides a fiber-based job system, whose jobs can wait on other
+ *          jobs without blocking the threads they run on.
+ */
+
+#pragma once
+#include <deque>
+#include <Ace/System/Settings.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Forward-declaration of a structure containing one fiber of a
+     *          @a `JobSystem`, and its platform-specific context.
+     */
+    struct Fiber;
+
+    /**
+     * @brief   A structure containing the settings a @a `JobSystem` is created
+     *          with. Each defaults to its `jobs.*` setting.
+     */
+    struct JobSystemSpec
+    {
+        std::size_t     mThreadCount = Settings::Get<std::size_t>("jobs.threads", std::thread::hardware_concurrency());  ///< @brief The number of worker threads.
+        std::size_t     mFiberCount = Settings::Get<std::size_t>("jobs.fibers", 128);                                    ///< @brief The number of fibers created up front.
+        std::size_t     mMaxFiberCount = Settings::Get<std::size_t>("jobs.max_fibers", 4096);                            ///< @brief The most fibers the pool may grow to, if every fiber is waiting.
+        std::size_t     mStackSize = Settings::Get<std::size_t>("jobs.stack_size", 64 * 1024);                           ///< @brief The size of each fiber's stack, in bytes.
+    };
+
+    /**
+     * @brief   A class which counts the unfinished jobs of a batch, for other
+     *          jobs or threads to wait on.
+     *
+     * A counter must outlive every job run against it, and any wait on it.
+     */
+    class ACE_API JobCounter final
+    {
+    public:
+
+        /**
+         * @brief   Constructs a counter with no unfinished jobs.
+         */
+        JobCounter () = default;
+
+    public:
+
+        /**
+         * @brief   Retrieves the number of unfinished jobs.
+         *
+         * @return  The number of jobs run against the counter which have not
+         *          finished yet.
+         */
+        inline std::int64_t GetValue () const
+        {
+            return mValue.load(std::memory_order_acquire);
+        }
+
+        /**
+         * @brief   Retrieves whether or not every job run against the counter
+         *          has finished.
+         *
+         * @return  `true` if no jobs are unfinished; `false` otherwise.
+         */
+        inline bool IsDone () const
+        {
+            return GetValue() == 0;
+        }
+
+    private:
+        JobCounter (const JobCounter&) = delete;
+        JobCounter (JobCounter&&) = delete;
+        void operator= (const JobCounter&) = delete;
+        void operator= (JobCounter&&) = delete;
+
+    private:
+        friend class JobSystem;
+
+        std::atomic<std::int64_t>   mValue { 0 };           ///< @brief The number of unfinished jobs.
+        std::mutex                  mMutex;                 ///< @brief The mutex used for locking down the waiters and exception.
+        std::vector<Fiber*>         mWaiters;               ///< @brief The fibers waiting for the counter to reach zero.
+        std::exception_ptr          mException = nullptr;   ///< @brief The first exception thrown by a job run against the counter.
+
+    };
+
+    /**
+     * @brief   A class which runs jobs on fibers, spread across a pool of
+     *          worker threads.
+     *
+     * Each job runs on a fiber: a lightweight context with a stack of its
+     * own, taken from a pool. A job which calls @a `Wait` on a counter that
+     * has not reached zero does not block its thread. Its fiber is set aside,
+     * and the thread carries on with other jobs. Once the counter reaches
+     * zero, the waiting fiber is resumed on whichever worker is free first.
+     * This lets thousands of jobs be in flight at once on a handful of
+     * threads, each written as plain sequential code.
+     *
+     * Resumed fibers are run before new jobs, and jobs run from within a job
+     * are run before jobs run from outside, so that a job's children finish
+     * before more parents start and wait. If every fiber is waiting while
+     * jobs are still queued, the pool grows, up to the spec's maximum.
+     *
+     * Fibers are switched with `ucontext`, and their stacks are allocated
+     * with a guard page beneath them, so an overflow faults rather than
+     * corrupting memory. A job may resume on a different thread than it
+     * started on after a @a `Wait`, so it must not hold locks or rely on
+     * thread-local state across one.
+     *
+     * Every counter must reach zero before the job system is destroyed.
+     */
+    class ACE_API JobSystem final
+    {
+    public:
+
+        /**
+         * @brief   Creates the fiber pool and starts the worker threads.
+         *
+         * @param   pSpec   The job system's settings.
+         *
+         * @throw   `std::invalid_argument` if the thread count, fiber count or
+         *          stack size is zero.
+         * @throw   `std::bad_alloc` if the fibers' stacks cannot be allocated.
+         */
+        explicit JobSystem (
+            const JobSystemSpec&    pSpec = {}
+        );
+
+        /**
+         * @brief   Stops the worker threads, and releases the fiber pool.
+         */
+        ~JobSystem ();
+
+    public:
+
+        /**
+         * @brief   Queues a job to be run on a fiber.
+         *
+         * @param   pJob        The function to be called by the job.
+         * @param   pCounter    The counter to track the job with, if any.
+         */
+        void Run (
+            std::function<void()>   pJob,
+            JobCounter*             pCounter = nullptr
+        );
+
+        /**
+         * @brief   Queues a batch of jobs, tracked by a single counter.
+         *
+         * @param   pJobs       The functions to be called by the jobs.
+         * @param   pCounter    The counter to track the jobs with.
+         */
+        void Run (
+            std::vector<std::function<void()>>  pJobs,
+            JobCounter&                         pCounter
+        );
+
+        /**
+         * @brief   Waits until every job run against a counter has finished.
+         *
+         * Called from a job, this suspends the job's fiber and frees its
+         * thread to run other jobs in the meantime. Called from any other
+         * thread, this blocks the thread.
+         *
+         * @param   pCounter    The counter to wait on.
+         *
+         * @throw   The first exception thrown by any of the counter's jobs,
+         *          if any. The exception is cleared once rethrown.
+         */
+        void Wait (
+            JobCounter& pCounter
+        );
+
+        /**
+         * @brief   Runs a function once for each index in `[0, pCount)`,
+         *          as jobs of @a `pGrainSize` indices each, and waits for them
+         *          all to finish.
+         *
+         * @param   pCount      The number of indices.
+         * @param   pFunction   The function to be called with each index.
+         * @param   pGrainSize  The number of indices per job.
+         */
+        void ParallelFor (
+            const std::size_t&                          pCount,
+            const std::function<void(std::size_t)>&     pFunction,
+            const std::size_t&                          pGrainSize = 1
+        );
+
+        /**
+         * @brief   Retrieves whether or not the calling code is running in a
+         *          job of this job system.
+         *
+         * @return  `true` if called from one of this system's fibers; `false`
+         *          otherwise.
+         */
+        bool IsInJob () const;
+
+        /**
+         * @brief   Retrieves the number of worker threads.
+         *
+         * @return  The number of worker threads.
+         */
+        inline std::size_t GetThreadCount () const
+        {
+            return mWorkerThreads.size();
+        }
+
+        /**
+         * @brief   Retrieves the number of fibers in the pool.
+         *
+         * @return  The number of fibers created so far.
+         */
+        std::size_t GetFiberCount () const;
+
+        /**
+         * @brief   Retrieves the number of times a job has waited on an
+         *          unfinished counter, suspending its fiber.
+         *
+         * @return  The number of fiber suspensions.
+         */
+        inline std::size_t GetSuspendCount () const
+        {
+            return mSuspendCount.load(std::memory_order_relaxed);
+        }
+
+    private:
+        JobSystem (const JobSystem&) = delete;
+        JobSystem (JobSystem&&) = delete;
+        void operator= (const JobSystem&) = delete;
+        void operator= (JobSystem&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one queued job.
+         */
+        struct Job
+        {
+            std::function<void()>   mFunction;              ///< @brief The function to be called.
+            JobCounter*             mCounter = nullptr;     ///< @brief The counter tracking the job, if any.
+        };
+
+    private:
+
+        /**
+         * @brief   Creates a new fiber and adds it to the pool. Must be called
+         *          under @a `mMutex`.
+         *
+         * @return  A pointer to the new fiber.
+         */
+        Fiber* CreateFiber ();
+
+        /**
+         * @brief   Runs a worker thread, until the job system is destroyed.
+         */
+        void RunWorker ();
+
+        /**
+         * @brief   The entry point of every fiber: runs jobs handed to the
+         *          fiber, one after another, switching back to its worker
+         *          after each.
+         */
+        static void RunFiber (
+            const std::uint32_t pLow,
+            const std::uint32_t pHigh
+        );
+
+        /**
+         * @brief   Marks one of a counter's jobs as finished, resuming any
+         *          fibers waiting on the counter if it reaches zero.
+         */
+        void Finish (
+            JobCounter&         pCounter,
+            std::exception_ptr  pException
+        );
+
+    private:
+        JobSystemSpec                           mSpec;                      ///< @brief The job system's settings.
+        std::vector<std::thread>                mWorkerThreads;             ///< @brief The worker threads.
+        std::vector<std::unique_ptr<Fiber>>     mFibers;                    ///< @brief Every fiber in the pool.
+        std::vector<Fiber*>                     mFreeFibers;                ///< @brief The fibers with no job.
+        std::deque<Fiber*>                      mReadyFibers;               ///< @brief The waiting fibers whose counters have reached zero.
+        std::deque<Job>                         mJobs;                      ///< @brief The jobs waiting for a fiber.
+        mutable std::mutex                      mMutex;                     ///< @brief The mutex used for locking down the pool and queues.
+        std::condition_variable                 mConditional;               ///< @brief A conditional for idle workers to wait on.
+        bool                                    mDone = false;              ///< @brief Is the job system shutting down?
+        std::atomic<std::size_t>                mSuspendCount { 0 };        ///< @brief The number of fiber suspensions.
+
+    };
+
+}
@@ -3,6 +3,7 @@
  */
 
 #include <Ace/System/LoggerConsoleSink.hpp>
+#include <Ace/System/Settings.hpp>
 
 namespace ace
 {
@@ -11,9 +12,7 @@ namespace ace
 
     std::atomic<bool>                           Logger::sRunning { false };     
     std::thread                                 Logger::sWorkerThread;
-    RingBuffer<LogEvent, Logger::MAX_CAPACITY>  Logger::sQueue;    
-    std::mutex                                  Logger::sSinksMutex;  
-    std::vector<std::shared_ptr<ILogSink>>      Logger::sSinks;       
+    ConcurrentVector<std::shared_ptr<ILogSink>> Logger::sSinks;
 
     /* Public Methods *********************************************************/
 
@@ -54,9 +53,9 @@ namespace ace
         std::shared_ptr<ILogSink> pSink
     )
     {
-        // Under a lock, move the new sink into the sinks container.
-        std::lock_guard lGuard { sSinksMutex };
-        sSinks.emplace_back(std::move(pSink));
+        // Append the new sink. The worker thread picks it up from the next
+        // event it dispatches, without either side taking a lock.
+        sSinks.PushBack(std::move(pSink));
     }
 
     void Logger::Publish (
@@ -86,7 +85,7 @@ namespace ace
         };
 
         // Enqueue the event.
-        sQueue.Enqueue(lEvent);
+        GetQueue().Enqueue(lEvent);
     }
 
     /* Private Methods ********************************************************/
@@ -101,7 +100,7 @@ namespace ace
         {
             i = 0;
 
-            while (auto lEvent = sQueue.Dequeue())
+            while (auto lEvent = GetQueue().Dequeue())
             {
                 Dispatch(*lEvent);
                 ++i;
@@ -115,24 +114,34 @@ namespace ace
         // When the logging subsystem shuts down, dispatch any outstanding log
         // events.
         i = 0;
-        while (auto lEvent = sQueue.Dequeue())
+        while (auto lEvent = GetQueue().Dequeue())
         {
             Dispatch(*lEvent);
             ++i;
         }
     }
 
+    RingBuffer<LogEvent>& Logger::GetQueue ()
+    {
+        static RingBuffer<LogEvent> sQueue {
+            Settings::Get<std::size_t>("logger.capacity", DEFAULT_CAPACITY)
+        };
+
+        return sQueue;
+    }
+
     void Logger::Dispatch (
         const LogEvent& pEvent
     )
     {
-        // Under a lock, iterate over all registered sinks and write this log
-        // event's formatted message to each sink.
-        std::lock_guard lGuard { sSinksMutex };
-        for (auto& lSink : sSinks)
-        {
-            lSink->Write(pEvent);
-        }
+        // Iterate over all registered sinks and write this log event's
+        // formatted message to each sink.
+        sSinks.ForEach(
+            [&pEvent] (const std::shared_ptr<ILogSink>& pSink)
+            {
+                pSink->Write(pEvent);
+            }
+        );
     }
 
 }
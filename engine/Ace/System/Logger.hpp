@@ -4,6 +4,7 @@
  */
 
 #pragma once
+#include <Ace/System/ConcurrentVector.hpp>
 #include <Ace/System/RingBuffer.hpp>
 
 namespace ace
@@ -68,9 +69,10 @@ namespace ace
     public:
 
         /**
-         * @brief   The maximum capacity of the logger's ring buffer.
+         * @brief   The default capacity of the logger's ring buffer, used unless
+         *          the `logger.capacity` setting overrides it.
          */
-        static constexpr std::size_t MAX_CAPACITY = 1 << 10;
+        static constexpr std::size_t DEFAULT_CAPACITY = 1 << 10;
 
     public:
 
@@ -200,12 +202,19 @@ namespace ace
             const LogEvent& pEvent
         );
 
+        /**
+         * @brief   Retrieves the circular queue of log events, creating it on
+         *          first use with the capacity given by the `logger.capacity`
+         *          setting.
+         *
+         * @return  A handle to the log event queue.
+         */
+        static RingBuffer<LogEvent>& GetQueue ();
+
     private:
-        static std::atomic<bool>                        sRunning;       ///< @brief Has the logger been initialized?
-        static std::thread                              sWorkerThread;  ///< @brief The background worker thread responsible for processing the log event queue.
-        static RingBuffer<LogEvent, MAX_CAPACITY>       sQueue;         ///< @brief The circular queue of log events.
-        static std::mutex                               sSinksMutex;    ///< @brief The mutex used to lock down the sinks container.
-        static std::vector<std::shared_ptr<ILogSink>>   sSinks;         ///< @brief The container of log sinks.
+        static std::atomic<bool>                                sRunning;       ///< @brief Has the logger been initialized?
+        static std::thread                                      sWorkerThread;  ///< @brief The background worker thread responsible for processing the log event queue.
+        static ConcurrentVector<std::shared_ptr<ILogSink>>      sSinks;         ///< @brief The container of log sinks, appended to and read without a lock.
 
     };
 
@@ -5,6 +5,7 @@
 
 #pragma once
 #include <Ace/System/Logger.hpp>
+#include <Ace/System/Settings.hpp>
 
 namespace ace
 {
@@ -12,13 +13,15 @@ namespace ace
     /**
      * @brief   A structure containing attributes which define a logger sink
      *          for writing to log files.
+     *
+     * Each attribute defaults to its `logger.file.*` setting, if one is set.
      */
     struct LoggerFileSinkSpec
     {
-        fs::path        mLogDirectory   = "logs";           ///< @brief The path to the folder to hold the log files in.
-        std::string     mBaseName       = "ace.log";        ///< @brief The name of the log file currently being written.
-        std::size_t     mMaxSize        = 10 * 1024 * 1024; ///< @brief The maximum size, in bytes, of a single log file.
-        std::size_t     mMaxArchives    = 5;                ///< @brief The maximum number of log files which can be archived.
+        fs::path        mLogDirectory   = Settings::Get<std::string>("logger.file.directory", "logs");         ///< @brief The path to the folder to hold the log files in.
+        std::string     mBaseName       = Settings::Get<std::string>("logger.file.base_name", "ace.log");      ///< @brief The name of the log file currently being written.
+        std::size_t     mMaxSize        = Settings::Get<std::size_t>("logger.file.max_size", 10 * 1024 * 1024);///< @brief The maximum size, in bytes, of a single log file.
+        std::size_t     mMaxArchives    = Settings::Get<std::size_t>("logger.file.max_archives", 5);          ///< @brief The maximum number of log files which can be archived.
     };
 
     /**
@@ -4,19 +4,27 @@
  */
 
 #pragma once
+#include <bit>
 #include <Ace/Common.hpp>
 
 namespace ace
 {
 
+    /**
+     * @brief   A capacity which marks a @a `RingBuffer` as sized at runtime,
+     *          when it is constructed, rather than at compile time.
+     */
+    inline constexpr std::size_t DYNAMIC_CAPACITY = 0;
+
     /**
      * @brief   A container class used for storing data in a multiple-producer,
      *          single-consumer (MPSC) circular queue.
      * 
      * @tparam  T           The type of data stored in this queue.
-     * @tparam  Capacity    The maximum capacity of this queue.
+     * @tparam  Capacity    The maximum capacity of this queue, or
+     *                      @a `DYNAMIC_CAPACITY` to choose it at runtime.
      */
-    template <typename T, std::size_t Capacity>
+    template <typename T, std::size_t Capacity = DYNAMIC_CAPACITY>
     class RingBuffer final
     {
     private:
@@ -36,7 +44,8 @@ namespace ace
         // Knowing that a bitwise AND only evaulates to `true` if both bits
         // checked are set, we can check for a power of two by performing a
         // bitwise AND between a number and that number minus one, and checking
-        // if the result is zero.
+        // if the result is zero. (This also lets @a `DYNAMIC_CAPACITY`, which
+        // is zero, through.)
         //
         static_assert((Capacity & (Capacity - 1)) == 0,
             "'ace::RingBuffer' capacity must be a power of two.");
@@ -54,9 +63,14 @@ namespace ace
         };
 
         /**
-         * @brief   A mask of this ring buffer's capacity.
+         * @brief   The cells' storage: inline for a fixed capacity, or on the
+         *          heap for a dynamic one.
          */
-        static constexpr std::size_t MASK = Capacity - 1;
+        using Storage = std::conditional_t<
+            Capacity == DYNAMIC_CAPACITY,
+            std::unique_ptr<Cell[]>,
+            std::array<Cell, Capacity>
+        >;
 
     public:
 
@@ -65,11 +79,25 @@ namespace ace
          *          cells' atomically-stored sequence numbers.
          */
         explicit RingBuffer () noexcept
+            requires (Capacity != DYNAMIC_CAPACITY)
         {
-            for (std::size_t i = 0; i < Capacity; ++i)
-            {
-                mBuffer[i].mSequenceNumber.store(i, std::memory_order_relaxed);
-            }
+            InitializeCells();
+        }
+
+        /**
+         * @brief   Constructs a queue with a capacity chosen at runtime, and
+         *          initializes its cells' sequence numbers.
+         *
+         * @param   pCapacity   The queue's minimum capacity. Rounded up to a
+         *                      power of two, and to at least two.
+         */
+        explicit RingBuffer (
+            const std::size_t&  pCapacity
+        ) requires (Capacity == DYNAMIC_CAPACITY) :
+            mCapacity   { std::bit_ceil(std::max<std::size_t>(pCapacity, 2)) },
+            mBuffer     { std::make_unique<Cell[]>(mCapacity) }
+        {
+            InitializeCells();
         }
 
         /**
@@ -92,7 +120,7 @@ namespace ace
             //
             // Use that position to index that head element.
             std::size_t lPosition   = mHead.fetch_add(1, std::memory_order_acquire);
-            Cell&       lCell       = mBuffer[lPosition & MASK];
+            Cell&       lCell       = mBuffer[lPosition & (GetCapacity() - 1)];
 
             // Check the sequence number of the cell. If it and the
             // above-retrieved head position are not equal, then either...
@@ -103,7 +131,7 @@ namespace ace
             );
             while (lSequenceNumber != lPosition)
             {
-                if (lPosition - lSequenceNumber >= Capacity)
+                if (lPosition - lSequenceNumber >= GetCapacity())
                 {
                     return false;
                 }
@@ -133,7 +161,7 @@ namespace ace
 
             // Index the appropriate cell.
             std::size_t lPosition   = mTail.load(std::memory_order_relaxed);
-            Cell&       lCell       = mBuffer[lPosition & MASK];
+            Cell&       lCell       = mBuffer[lPosition & (GetCapacity() - 1)];
 
             // Check to see if the cell has data that is ready to be retrieved.
             std::size_t lSequenceNumber = lCell.mSequenceNumber.load(
@@ -147,7 +175,7 @@ namespace ace
             // Move the item out of the queue, then update that cell's sequence
             // number and the tail pointer.
             T lItem = std::move(lCell.mData);
-            lCell.mSequenceNumber.store(lPosition + Capacity,
+            lCell.mSequenceNumber.store(lPosition + GetCapacity(),
                 std::memory_order_release);
             mTail.store(lPosition + 1, std::memory_order_relaxed);
 
@@ -155,6 +183,23 @@ namespace ace
 
         }
 
+        /**
+         * @brief   Retrieves the queue's capacity.
+         *
+         * @return  The maximum number of items the queue can hold.
+         */
+        inline std::size_t GetCapacity () const noexcept
+        {
+            if constexpr (Capacity == DYNAMIC_CAPACITY)
+            {
+                return mCapacity;
+            }
+            else
+            {
+                return Capacity;
+            }
+        }
+
     private:
         RingBuffer (const RingBuffer&) = delete;
         RingBuffer (RingBuffer&&) = delete;
@@ -162,7 +207,21 @@ namespace ace
         void operator= (RingBuffer&&) = delete;
 
     private:
-                    std::array<Cell, Capacity>  mBuffer;        ///< @brief Contains the circular queue's data, and their respective sequence numbers.
+
+        /**
+         * @brief   Gives each cell its initial sequence number: its own index.
+         */
+        void InitializeCells () noexcept
+        {
+            for (std::size_t i = 0; i < GetCapacity(); ++i)
+            {
+                mBuffer[i].mSequenceNumber.store(i, std::memory_order_relaxed);
+            }
+        }
+
+    private:
+                    std::size_t                 mCapacity = Capacity;   ///< @brief The queue's capacity, for a dynamic capacity.
+                    Storage                     mBuffer;        ///< @brief Contains the circular queue's data, and their respective sequence numbers.
         alignas(64) std::atomic<std::size_t>    mHead { 0 };    ///< @brief The circular queue's head element, atomically incremented by producers to reserve a slot index.
         alignas(64) std::atomic<std::size_t>    mTail { 0 };    ///< @brief The circular queue's tail element, modified by the queue's single consumer to track which slot to read next.
 
@@ -0,0 +1,297 @@
+/**
+ * @file    Ace/System/Settings.cpp
+ */
+
+#include <bit>
+#include <cctype>
+#include <charconv>
+#include <Ace/System/ContentHash.hpp>
+#include <Ace/System/Settings.hpp>
+#include <Ace/System/VirtualFilesystem.hpp>
+
+namespace ace
+{
+
+    /* Static Members *********************************************************/
+
+    std::atomic<const Settings::Store*>     Settings::sStore { nullptr };
+    std::mutex                              Settings::sLoadMutex;
+
+    /* Helper Functions *******************************************************/
+
+    static std::string_view Trim (
+        std::string_view    pText
+    )
+    {
+        constexpr std::string_view WHITESPACE = " \t\r\n";
+        const std::size_t lStart = pText.find_first_not_of(WHITESPACE);
+        if (lStart == std::string_view::npos)
+        {
+            return {};
+        }
+
+        return pText.substr(lStart, pText.find_last_not_of(WHITESPACE) - lStart + 1);
+    }
+
+    static bool IsKeyCharacter (
+        const char  pChar
+    )
+    {
+        return std::isalnum(static_cast<unsigned char>(pChar)) ||
+            pChar == '_' || pChar == '-' || pChar == '.';
+    }
+
+    /* Public Methods *********************************************************/
+
+    bool Settings::Load (
+        const std::string&  pLogicalPath
+    )
+    {
+        auto lFile = VFS::OpenFile(pLogicalPath);
+        if (lFile == nullptr)
+        {
+            return false;
+        }
+
+        std::string lText(lFile->GetSize(), '\0');
+        if (lText.empty() == false && lFile->Read(lText.data(), lText.size()) != lText.size())
+        {
+            ACE_THROW(std::runtime_error, "{}: Could not read '{}'!", "Settings", pLogicalPath);
+        }
+
+        LoadFromText(lText, pLogicalPath);
+        return true;
+    }
+
+    void Settings::LoadFromText (
+        std::string_view    pText,
+        const std::string&  pName
+    )
+    {
+        const auto lFail = [&] (const std::size_t& pLine, const std::string& pMessage)
+        {
+            ACE_THROW(std::runtime_error, "{}: {}:{}: {}", "Settings", pName, pLine, pMessage);
+        };
+
+        auto lStore = std::make_unique<Store>();
+        std::vector<Entry> lEntries;
+        std::unordered_set<std::string> lKeys;
+        std::string lSection;
+
+        std::size_t lLineNumber = 0;
+        while (pText.empty() == false)
+        {
+            ++lLineNumber;
+            const std::size_t lEnd = pText.find('\n');
+            std::string_view lLine = Trim(pText.substr(0, lEnd));
+            pText = (lEnd == std::string_view::npos) ? std::string_view {} : pText.substr(lEnd + 1);
+
+            if (lLine.empty() == true || lLine[0] == '#' || lLine[0] == ';')
+            {
+                continue;
+            }
+
+            if (lLine[0] == '[')
+            {
+                if (lLine.back() != ']')
+                {
+                    lFail(lLineNumber, "Expected ']' at the end of the section name.");
+                }
+
+                lSection = std::string { Trim(lLine.substr(1, lLine.size() - 2)) };
+                if (lSection.empty() == false && std::ranges::all_of(lSection, IsKeyCharacter) == false)
+                {
+                    lFail(lLineNumber, std::format("Invalid section name '{}'.", lSection));
+                }
+                continue;
+            }
+
+            const std::size_t lEquals = lLine.find('=');
+            if (lEquals == std::string_view::npos)
+            {
+                lFail(lLineNumber, "Expected 'key = value'.");
+            }
+
+            const std::string_view lName = Trim(lLine.substr(0, lEquals));
+            if (lName.empty() == true || std::ranges::all_of(lName, IsKeyCharacter) == false)
+            {
+                lFail(lLineNumber, std::format("Invalid key '{}'.", lName));
+            }
+
+            std::string lKey = lSection.empty() ? std::string { lName } :
+                std::format("{}.{}", lSection, lName);
+            if (lKeys.insert(lKey).second == false)
+            {
+                lFail(lLineNumber, std::format("Key '{}' is set twice.", lKey));
+            }
+
+            Entry lEntry;
+            lEntry.mHash = ContentHash64(lKey);
+            lEntry.mKeyOffset = static_cast<std::uint32_t>(lStore->mStrings.size());
+            lEntry.mKeyLength = static_cast<std::uint32_t>(lKey.size());
+            lStore->mStrings += lKey;
+
+            std::string_view lValue = Trim(lLine.substr(lEquals + 1));
+            std::string lText;
+            if (lValue.starts_with('"'))
+            {
+                // A quoted string, with `\"` and `\\` escapes. Anything after
+                // the closing quote must be a comment.
+                std::size_t i = 1;
+                for (; i < lValue.size() && lValue[i] != '"'; ++i)
+                {
+                    if (lValue[i] == '\\' && i + 1 < lValue.size())
+                    {
+                        ++i;
+                    }
+
+                    lText += lValue[i];
+                }
+
+                const std::string_view lRest = Trim(lValue.substr(std::min(i + 1, lValue.size())));
+                if (i == lValue.size() || (lRest.empty() == false && lRest[0] != '#' && lRest[0] != ';'))
+                {
+                    lFail(lLineNumber, "Malformed quoted string.");
+                }
+
+                lEntry.mType = SettingType::String;
+            }
+            else
+            {
+                lValue = Trim(lValue.substr(0, lValue.find_first_of("#;")));
+
+                const char* lBegin = lValue.data();
+                const char* lFinish = lValue.data() + lValue.size();
+                const bool lHex = lValue.starts_with("0x") || lValue.starts_with("0X");
+                if (lValue == "true" || lValue == "false")
+                {
+                    lEntry.mType = SettingType::Bool;
+                    lEntry.mBool = (lValue == "true");
+                }
+                else if (
+                    auto [lPtr, lError] = std::from_chars(lBegin + (lHex ? 2 : 0), lFinish,
+                        lEntry.mInteger, lHex ? 16 : 10);
+                    lError == std::errc {} && lPtr == lFinish && lValue.empty() == false
+                )
+                {
+                    lEntry.mType = SettingType::Integer;
+                }
+                else if (
+                    auto [lPtr, lError] = std::from_chars(lBegin, lFinish, lEntry.mFloat);
+                    lError == std::errc {} && lPtr == lFinish && lValue.empty() == false
+                )
+                {
+                    lEntry.mType = SettingType::Float;
+                }
+                else
+                {
+                    lEntry.mType = SettingType::String;
+                    lText = std::string { lValue };
+                }
+            }
+
+            if (lEntry.mType == SettingType::String)
+            {
+                lEntry.mTextOffset = static_cast<std::uint32_t>(lStore->mStrings.size());
+                lEntry.mTextLength = static_cast<std::uint32_t>(lText.size());
+                lStore->mStrings += lText;
+            }
+
+            lEntries.push_back(lEntry);
+        }
+
+        // Keep the table at most half full, so probe sequences stay short.
+        lStore->mTable.resize(std::bit_ceil(std::max<std::size_t>(lEntries.size() * 2, 8)));
+        const std::size_t lMask = lStore->mTable.size() - 1;
+        for (const Entry& lEntry : lEntries)
+        {
+            std::size_t lSlot = lEntry.mHash & lMask;
+            while (lStore->mTable[lSlot].mKeyLength != 0)
+            {
+                lSlot = (lSlot + 1) & lMask;
+            }
+
+            lStore->mTable[lSlot] = lEntry;
+        }
+
+        lStore->mCount = lEntries.size();
+        Publish(std::move(lStore));
+    }
+
+    std::optional<SettingType> Settings::GetType (
+        std::string_view    pKey
+    )
+    {
+        const Entry* lEntry = Find(pKey);
+        if (lEntry == nullptr)
+        {
+            return std::nullopt;
+        }
+
+        return lEntry->mType;
+    }
+
+    std::size_t Settings::GetCount ()
+    {
+        const Store* lStore = sStore.load(std::memory_order_acquire);
+        return (lStore != nullptr) ? lStore->mCount : 0;
+    }
+
+    /* Private Methods ********************************************************/
+
+    const Settings::Entry* Settings::Find (
+        std::string_view    pKey
+    )
+    {
+        const Store* lStore = sStore.load(std::memory_order_acquire);
+        if (lStore == nullptr)
+        {
+            return nullptr;
+        }
+
+        const std::uint64_t lHash = ContentHash64(pKey);
+        const std::size_t lMask = lStore->mTable.size() - 1;
+        for (std::size_t lSlot = lHash & lMask; ; lSlot = (lSlot + 1) & lMask)
+        {
+            const Entry& lEntry = lStore->mTable[lSlot];
+            if (lEntry.mKeyLength == 0)
+            {
+                return nullptr;
+            }
+            else if (
+                lEntry.mHash == lHash &&
+                std::string_view { lStore->mStrings }.substr(lEntry.mKeyOffset,
+                    lEntry.mKeyLength) == pKey
+            )
+            {
+                return &lEntry;
+            }
+        }
+    }
+
+    std::string_view Settings::GetText (
+        const Entry&    pEntry
+    )
+    {
+        const Store* lStore = sStore.load(std::memory_order_acquire);
+        return std::string_view { lStore->mStrings }.substr(pEntry.mTextOffset,
+            pEntry.mTextLength);
+    }
+
+    void Settings::Publish (
+        std::unique_ptr<Store>  pStore
+    )
+    {
+        std::lock_guard lGuard { sLoadMutex };
+        if (sStore.load(std::memory_order_relaxed) != nullptr)
+        {
+            ACE_THROW(std::logic_error, "{}: Settings have already been loaded!",
+                "Settings");
+        }
+
+        // The store is never freed, so that readers never need to guard it,
+        // and string views into it stay valid.
+        sStore.store(pStore.release(), std::memory_order_release);
+    }
+
+}
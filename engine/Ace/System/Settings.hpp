@@ -0,0 +1,249 @@
+/**
+ * @file    Ace/System/Settings.hpp
+ * @brief   Provides a static class holding engine-wide settings, loaded once
+ *          at startup from a configuration file.
+ */
+
+#pragma once
+#include <cmath>
+#include <utility>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   Enumerates the types a setting's value can have.
+     */
+    enum class SettingType : std::uint8_t
+    {
+        Bool,       ///< @brief `true` or `false`.
+        Integer,    ///< @brief A signed 64-bit integer, in decimal or `0x` hexadecimal.
+        Float,      ///< @brief A double-precision floating-point number.
+        String      ///< @brief Text; quoted, or anything which is not one of the above.
+    };
+
+    /**
+     * @brief   A static class holding engine-wide settings, such as queue
+     *          capacities and thread counts, which can be tuned per deployment
+     *          without rebuilding.
+     *
+     * Settings are loaded once, at startup, from an INI-style file read
+     * through the virtual filesystem:
+     *
+     * ```
+     * # Comments start with '#' or ';'.
+     * [logger]
+     * capacity = 4096
+     *
+     * [logger.file]
+     * directory = "logs/server"
+     * ```
+     *
+     * Each key is prefixed with the section it is in, so the above defines
+     * `logger.capacity` and `logger.file.directory`.
+     *
+     * Once loaded, the settings never change. They are held in a single flat
+     * block: an open-addressed table of entries keyed by the hash of their
+     * name, with every string packed into one buffer. The block is published
+     * with one atomic store, so reads take no locks and may happen on any
+     * thread. Reading before any settings are loaded, or reading a missing
+     * key or a value of an incompatible type, yields the caller's default;
+     * engine defaults therefore apply unless a file overrides them.
+     */
+    class ACE_API Settings final
+    {
+    public:
+
+        /**
+         * @brief   Loads the settings from a file in the virtual filesystem.
+         *
+         * @param   pLogicalPath    The logical path to the file.
+         *
+         * @return  `true` if the file was found and loaded; `false` if it was
+         *          not found, in which case every setting keeps its default.
+         *
+         * @throw   `std::logic_error` if settings have already been loaded.
+         * @throw   `std::runtime_error` if the file is malformed.
+         */
+        static bool Load (
+            const std::string&  pLogicalPath
+        );
+
+        /**
+         * @brief   Loads the settings from the given text.
+         *
+         * @param   pText   The settings, in the same format as a file.
+         * @param   pName   A name for the text, used in error messages.
+         *
+         * @throw   `std::logic_error` if settings have already been loaded.
+         * @throw   `std::runtime_error` if the text is malformed.
+         */
+        static void LoadFromText (
+            std::string_view    pText,
+            const std::string&  pName = "settings"
+        );
+
+        /**
+         * @brief   Retrieves a setting's value.
+         *
+         * Integers convert to floating-point settings, and to narrower
+         * integers if they fit; floats convert to integers only if they are
+         * whole and fit. A string is returned as an `std::string_view` into
+         * the settings, which remains valid for the life of the program, or
+         * as an `std::string` or `fs::path` copy.
+         *
+         * @tparam  T           The type to retrieve the value as.
+         *
+         * @param   pKey        The setting's key.
+         * @param   pDefault    The value to return if the setting is missing
+         *                      or has an incompatible type.
+         *
+         * @return  The setting's value, or @a `pDefault`.
+         */
+        template <typename T>
+        static T Get (
+            std::string_view    pKey,
+            const T&            pDefault
+        )
+        {
+            const Entry* lEntry = Find(pKey);
+            if (lEntry == nullptr)
+            {
+                return pDefault;
+            }
+
+            if constexpr (std::is_same_v<T, bool>)
+            {
+                return (lEntry->mType == SettingType::Bool) ? lEntry->mBool : pDefault;
+            }
+            else if constexpr (std::is_integral_v<T>)
+            {
+                if (lEntry->mType == SettingType::Integer)
+                {
+                    return std::in_range<T>(lEntry->mInteger) ?
+                        static_cast<T>(lEntry->mInteger) : pDefault;
+                }
+                else if (
+                    lEntry->mType == SettingType::Float &&
+                    std::isfinite(lEntry->mFloat) == true &&
+                    lEntry->mFloat >= -0x1p63 &&
+                    lEntry->mFloat < 0x1p63
+                )
+                {
+                    // Only now is the value known to fit, so converting it
+                    // is defined.
+                    const std::int64_t lWhole = static_cast<std::int64_t>(lEntry->mFloat);
+                    if (
+                        static_cast<double>(lWhole) == lEntry->mFloat &&
+                        std::in_range<T>(lWhole)
+                    )
+                    {
+                        return static_cast<T>(lWhole);
+                    }
+                }
+
+                return pDefault;
+            }
+            else if constexpr (std::is_floating_point_v<T>)
+            {
+                switch (lEntry->mType)
+                {
+                    case SettingType::Integer:  return static_cast<T>(lEntry->mInteger);
+                    case SettingType::Float:    return static_cast<T>(lEntry->mFloat);
+                    default:                    return pDefault;
+                }
+            }
+            else if constexpr (std::is_constructible_v<T, std::string_view>)
+            {
+                return (lEntry->mType == SettingType::String) ?
+                    T { GetText(*lEntry) } : pDefault;
+            }
+            else
+            {
+                static_assert(std::is_same_v<T, bool>,
+                    "'ace::Settings::Get' does not support this type.");
+            }
+        }
+
+        /**
+         * @brief   Retrieves a setting's type.
+         *
+         * @param   pKey    The setting's key.
+         *
+         * @return  An `std::optional` which contains the setting's type, if
+         *          the setting exists.
+         */
+        static std::optional<SettingType> GetType (
+            std::string_view    pKey
+        );
+
+        /**
+         * @brief   Retrieves the number of settings loaded.
+         *
+         * @return  The number of settings.
+         */
+        static std::size_t GetCount ();
+
+    private:
+
+        /**
+         * @brief   A structure containing one setting in the table.
+         */
+        struct Entry
+        {
+            std::uint64_t   mHash = 0;                      ///< @brief The hash of the key.
+            std::uint32_t   mKeyOffset = 0;                 ///< @brief The key's offset in the string buffer.
+            std::uint32_t   mKeyLength = 0;                 ///< @brief The key's length; zero for an empty slot.
+            std::uint32_t   mTextOffset = 0;                ///< @brief A string value's offset in the string buffer.
+            std::uint32_t   mTextLength = 0;                ///< @brief A string value's length.
+            SettingType     mType = SettingType::String;    ///< @brief The value's type.
+            bool            mBool = false;                  ///< @brief The value, for booleans.
+            std::int64_t    mInteger = 0;                   ///< @brief The value, for integers.
+            double          mFloat = 0.0;                   ///< @brief The value, for floats.
+        };
+
+        /**
+         * @brief   A structure containing the whole, immutable set of
+         *          settings.
+         */
+        struct Store
+        {
+            std::string         mStrings;       ///< @brief Every key and string value, back to back.
+            std::vector<Entry>  mTable;         ///< @brief The open-addressed table; its size is a power of two.
+            std::size_t         mCount = 0;     ///< @brief The number of settings.
+        };
+
+    private:
+
+        /**
+         * @brief   Finds a setting.
+         *
+         * @return  A pointer to the setting's entry, or `nullptr` if it is
+         *          missing or no settings are loaded.
+         */
+        static const Entry* Find (
+            std::string_view    pKey
+        );
+
+        /**
+         * @brief   Retrieves a string setting's value.
+         */
+        static std::string_view GetText (
+            const Entry&    pEntry
+        );
+
+        /**
+         * @brief   Publishes a newly parsed store.
+         */
+        static void Publish (
+            std::unique_ptr<Store>  pStore
+        );
+
+    private:
+        static std::atomic<const Store*>    sStore;         ///< @brief The loaded settings, or `nullptr` if none are.
+        static std::mutex                   sLoadMutex;     ///< @brief Serializes loading; never taken by readers.
+
+    };
+
+}
@@ -0,0 +1,151 @@
+/**
+ * @file    Ace/System/SpscRingBuffer.hpp
+ * @brief   Provides a container class for passing data from one thread to
+ *          another in a circular queue.
+ */
+
+#pragma once
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A container class used for passing data from exactly one
+     *          producer thread to exactly one consumer thread in a lock-free,
+     *          single-producer, single-consumer (SPSC) circular queue.
+     *
+     * Unlike the multiple-producer @a `RingBuffer`, cells need no sequence
+     * numbers: the producer owns the write position and the consumer owns the
+     * read position. Each side caches the other side's position, so it only
+     * touches the other side's cache line when the queue looks full or empty.
+     *
+     * @tparam  T           The type of data stored in this queue.
+     * @tparam  Capacity    The maximum capacity of this queue. Must be a power
+     *                      of two.
+     */
+    template <typename T, std::size_t Capacity>
+    class SpscRingBuffer final
+    {
+    private:
+        static_assert((Capacity & (Capacity - 1)) == 0,
+            "'ace::SpscRingBuffer' capacity must be a power of two.");
+
+        /**
+         * @brief   A mask of this ring buffer's capacity.
+         */
+        static constexpr std::size_t MASK = Capacity - 1;
+
+    public:
+
+        /**
+         * @brief   The default constructor.
+         */
+        explicit SpscRingBuffer () noexcept = default;
+
+        /**
+         * @brief   Attempts to push a new item into the circular queue. May
+         *          only be called from the producer thread.
+         *
+         * @param   pItem   A handle to the item to be enqueued.
+         *
+         * @return  `true` if the item is enqueued; `false` if there was no room
+         *          available in the queue.
+         */
+        bool Enqueue (
+            const T&    pItem
+        ) noexcept
+        {
+            std::size_t lWrite = mWrite.load(std::memory_order_relaxed);
+            if (lWrite - mCachedRead >= Capacity)
+            {
+                // The queue looks full. Refresh the consumer's position, and
+                // check again.
+                mCachedRead = mRead.load(std::memory_order_acquire);
+                if (lWrite - mCachedRead >= Capacity)
+                {
+                    return false;
+                }
+            }
+
+            mBuffer[lWrite & MASK] = pItem;
+            mWrite.store(lWrite + 1, std::memory_order_release);
+            return true;
+        }
+
+        /**
+         * @brief   Attempts to pop an item from the circular queue. May only be
+         *          called from the consumer thread.
+         *
+         * @return  An `std::optional` which contains the dequeued item if one
+         *          was popped.
+         */
+        std::optional<T> Dequeue () noexcept
+        {
+            std::size_t lRead = mRead.load(std::memory_order_relaxed);
+            if (lRead == mCachedWrite)
+            {
+                mCachedWrite = mWrite.load(std::memory_order_acquire);
+                if (lRead == mCachedWrite)
+                {
+                    return std::nullopt;
+                }
+            }
+
+            T lItem = std::move(mBuffer[lRead & MASK]);
+            mRead.store(lRead + 1, std::memory_order_release);
+            return lItem;
+        }
+
+        /**
+         * @brief   Passes queued items, oldest first, to the given function,
+         *          dequeueing each one it accepts, until it rejects one or the
+         *          queue runs dry. May only be called from the consumer
+         *          thread.
+         *
+         * The producer's position is read once, and the consumer's position is
+         * published once, for the whole batch. Items enqueued while the batch
+         * is being consumed are left for the next batch.
+         *
+         * @tparam  F           The type of function called with each item.
+         *
+         * @param   pFunction   A function which takes a handle to an item, and
+         *                      returns `true` to dequeue it and continue, or
+         *                      `false` to leave it queued and stop.
+         *
+         * @return  The number of items dequeued.
+         */
+        template <typename F>
+        std::size_t DequeueWhile (
+            F&& pFunction
+        )
+        {
+            const std::size_t lStart = mRead.load(std::memory_order_relaxed);
+            mCachedWrite = mWrite.load(std::memory_order_acquire);
+
+            std::size_t lRead = lStart;
+            while (lRead != mCachedWrite && pFunction(mBuffer[lRead & MASK]) == true)
+            {
+                ++lRead;
+            }
+
+            mRead.store(lRead, std::memory_order_release);
+            return lRead - lStart;
+        }
+
+    private:
+        SpscRingBuffer (const SpscRingBuffer&) = delete;
+        SpscRingBuffer (SpscRingBuffer&&) = delete;
+        void operator= (const SpscRingBuffer&) = delete;
+        void operator= (SpscRingBuffer&&) = delete;
+
+    private:
+                    std::array<T, Capacity>     mBuffer {};         ///< @brief Contains the circular queue's data.
+        alignas(64) std::atomic<std::size_t>    mWrite { 0 };       ///< @brief The number of items ever enqueued, published by the producer.
+                    std::size_t                 mCachedRead = 0;    ///< @brief The producer's last-seen copy of @a `mRead`.
+        alignas(64) std::atomic<std::size_t>    mRead { 0 };        ///< @brief The number of items ever dequeued, published by the consumer.
+                    std::size_t                 mCachedWrite = 0;   ///< @brief The consumer's last-seen copy of @a `mWrite`.
+
+    };
+
+}
@@ -2,83 +2,179 @@
  * @file    Ace/System/ThreadPool.cpp
  */
 
+#include <Ace/System/EpochReclaimer.hpp>
 #include <Ace/System/ThreadPool.hpp>
 
 namespace ace
 {
 
+    /* Static Members *********************************************************/
+
+    static thread_local const ThreadPool*   sCurrentPool = nullptr;     ///< @brief The pool the calling thread works for, if any.
+    static thread_local std::size_t         sCurrentQueue = 0;          ///< @brief The queue the calling worker serves.
+
     /* Constructors and Destructor ********************************************/
 
     ThreadPool::ThreadPool (
-        std::size_t pThreadCount
+        const ThreadPoolSpec&   pSpec
     ) :
-        mDone   { false }
+        mPlacement  { pSpec.mPlacement },
+        mTimerEpoch { Clock::now() }
     {
-        // If the thread count given is greater than the number of threads
-        // supported by the running system, then correct that number.
-        if (pThreadCount > std::thread::hardware_concurrency())
+        const CpuTopology& lTopology = CpuTopology::Get();
+
+        // Reserve the lowest-numbered physical cores, always leaving at least
+        // one core for the workers.
+        const std::size_t lReservedCores = std::min(pSpec.mReservedCores,
+            lTopology.GetCoreCount() - 1);
+        std::vector<std::vector<LogicalCpu>> lNodes(lTopology.GetNodeCount());
+        for (const auto& lCpu : lTopology.GetCpus())
+        {
+            if (lCpu.mCore < lReservedCores)
+            {
+                mReservedCpus.push_back(lCpu.mId);
+            }
+            else
+            {
+                lNodes[lCpu.mNode].push_back(lCpu);
+            }
+        }
+        std::sort(mReservedCpus.begin(), mReservedCpus.end());
+
+        // Decide each worker's node and CPUs. The pinned placements deal
+        // workers across the nodes in turn, each node handing out its
+        // physical cores before any SMT siblings.
+        struct Worker
+        {
+            std::uint32_t               mNode = 0;
+            std::vector<std::uint32_t>  mCpus;
+        };
+        std::vector<Worker> lWorkers;
+
+        if (mPlacement == ThreadPlacement::None)
         {
-            pThreadCount = std::thread::hardware_concurrency();
+            // If the thread count given is greater than the number of threads
+            // supported by the running system, then correct that number.
+            std::size_t lThreadCount = std::min<std::size_t>(pSpec.mThreadCount,
+                std::thread::hardware_concurrency());
+
+            // Without a placement, workers are only kept off reserved cores.
+            std::vector<std::uint32_t> lCpus;
+            if (mReservedCpus.empty() == false)
+            {
+                for (const auto& lNode : lNodes)
+                {
+                    for (const auto& lCpu : lNode)
+                    {
+                        lCpus.push_back(lCpu.mId);
+                    }
+                }
+
+                lThreadCount = std::min(lThreadCount, lCpus.size());
+            }
+
+            lWorkers.resize(lThreadCount, Worker { 0, lCpus });
         }
-        
-        // Loop through the thread count.
-        for (std::size_t i = 0; i < pThreadCount; ++i)
+        else
         {
-            // For each iteration, emplace a thread which runs the following
-            // function:
-            mWorkerThreads.emplace_back(
-                [this] -> void
+            std::vector<std::size_t> lTaken(lNodes.size(), 0);
+            bool lAny = true;
+            while (lWorkers.size() < pSpec.mThreadCount && lAny == true)
+            {
+                lAny = false;
+                for (std::size_t i = 0; i < lNodes.size() && lWorkers.size() < pSpec.mThreadCount; ++i)
                 {
-                    while (true)
+                    const auto& lNode = lNodes[i];
+                    if (lTaken[i] == lNode.size())
                     {
-                        // Under a lock, get the next task to run.
-                        std::function<void()> lTask;
+                        continue;
+                    }
+
+                    const LogicalCpu& lCpu = lNode[lTaken[i]++];
+                    if (mPlacement == ThreadPlacement::PhysicalCores)
+                    {
+                        if (lCpu.mSibling != 0)
+                        {
+                            lTaken[i] = lNode.size();
+                            continue;
+                        }
+
+                        lWorkers.push_back({ lCpu.mNode, { lCpu.mId } });
+                    }
+                    else
+                    {
+                        Worker lWorker { lCpu.mNode, {} };
+                        for (const auto& lNodeCpu : lNode)
                         {
-                            std::unique_lock lGuard { mMutex };
-
-                            // Wait until the task queue is not empty, or the
-                            // thread pool finishes.
-                            mConditional.wait(
-                                lGuard,
-                                [this] -> bool
-                                {
-                                    return 
-                                        mDone == true || 
-                                        mTasks.empty() == false;
-                                }
-                            );
-
-                            // If the thread pool finishes, and there are no
-                            // more tasks to carry out, then return.
-                            if (mDone == true && mTasks.empty() == true)
-                            {
-                                return;
-                            }
-
-                            // Move the task out of the queue and into the
-                            // out-of-lock snapshot.
-                            lTask = std::move(mTasks.front());
-                            mTasks.pop();
+                            lWorker.mCpus.push_back(lNodeCpu.mId);
                         }
 
-                        // Execute the task.
-                        lTask();
+                        std::sort(lWorker.mCpus.begin(), lWorker.mCpus.end());
+                        lWorkers.push_back(std::move(lWorker));
                     }
+
+                    lAny = true;
                 }
-            );
+            }
+        }
+
+        // Give each node with workers a queue of its own.
+        std::vector<std::size_t> lQueueOfNode(lNodes.size() + 1, lNodes.size());
+        for (const auto& lWorker : lWorkers)
+        {
+            if (lQueueOfNode[lWorker.mNode] == lNodes.size())
+            {
+                lQueueOfNode[lWorker.mNode] = mQueues.size();
+                mQueues.push_back(std::make_unique<TaskQueue>());
+                mQueues.back()->mNode = lWorker.mNode;
+            }
+        }
+
+        if (mQueues.empty() == true)
+        {
+            mQueues.push_back(std::make_unique<TaskQueue>());
         }
+
+        // Start the workers once every queue is in place.
+        for (auto& lWorker : lWorkers)
+        {
+            mWorkerThreads.emplace_back(&ThreadPool::RunWorker, this,
+                lQueueOfNode[lWorker.mNode], std::move(lWorker.mCpus));
+        }
+    }
+
+    ThreadPool::ThreadPool (
+        std::size_t pThreadCount
+    ) :
+        ThreadPool  { ThreadPoolSpec { .mThreadCount = pThreadCount } }
+    {
+
     }
 
     ThreadPool::~ThreadPool ()
     {
-        // Under a lock, indicate that the thread pool is done executing tasks.
+        // Indicate that the thread pool is done executing tasks, then notify
+        // all worker threads to stop running. Each queue's lock is taken so
+        // that no worker misses the notification between checking and
+        // waiting.
+        mDone.store(true);
+        {
+            std::lock_guard lGuard { mTimerMutex };
+            mTimerConditional.notify_all();
+        }
+
+        // Stop the timer thread first, so that it enqueues nothing more.
+        // Scheduled tasks which have not come due are dropped.
+        if (mTimerThread.joinable() == true)
         {
-            std::lock_guard lGuard { mMutex };
-            mDone = true;
+            mTimerThread.join();
         }
 
-        // Use the conditional to notify all worker threads to stop running.
-        mConditional.notify_all();
+        for (auto& lQueue : mQueues)
+        {
+            std::lock_guard lGuard { lQueue->mMutex };
+            lQueue->mConditional.notify_all();
+        }
 
         // Join each thread, waiting for them to finish running.
         for (auto& lThread : mWorkerThreads)
@@ -87,4 +183,260 @@ namespace ace
         }
     }
 
+    /* Public Methods *********************************************************/
+
+    std::optional<std::uint32_t> ThreadPool::GetCurrentNode () const
+    {
+        if (sCurrentPool != this)
+        {
+            return std::nullopt;
+        }
+
+        return mQueues[sCurrentQueue]->mNode;
+    }
+
+    TimerId ThreadPool::EnqueueAt (
+        const Clock::time_point pTime,
+        std::function<void()>   pFunction
+    )
+    {
+        return ScheduleTimer(pTime, std::move(pFunction), Clock::duration::zero());
+    }
+
+    TimerId ThreadPool::EnqueueAfter (
+        const Clock::duration   pDelay,
+        std::function<void()>   pFunction
+    )
+    {
+        return ScheduleTimer(Clock::now() + pDelay, std::move(pFunction),
+            Clock::duration::zero());
+    }
+
+    TimerId ThreadPool::EnqueueEvery (
+        const Clock::duration   pPeriod,
+        std::function<void()>   pFunction
+    )
+    {
+        const Clock::duration lPeriod = std::max<Clock::duration>(pPeriod, TIMER_RESOLUTION);
+        return ScheduleTimer(Clock::now() + lPeriod, std::move(pFunction), lPeriod);
+    }
+
+    bool ThreadPool::CancelTimer (
+        const TimerId   pTimer
+    )
+    {
+        std::lock_guard lGuard { mTimerMutex };
+        return mTimerWheel.Cancel(pTimer);
+    }
+
+    /* Private Methods ********************************************************/
+
+    std::size_t ThreadPool::SelectQueue ()
+    {
+        if (sCurrentPool == this)
+        {
+            return sCurrentQueue;
+        }
+
+        return mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+    }
+
+    std::size_t ThreadPool::FindQueue (
+        const std::uint32_t pNode
+    )
+    {
+        for (std::size_t i = 0; i < mQueues.size(); ++i)
+        {
+            if (mQueues[i]->mNode == pNode)
+            {
+                return i;
+            }
+        }
+
+        return SelectQueue();
+    }
+
+    void ThreadPool::Push (
+        const std::size_t&      pQueue,
+        std::function<void()>   pTask
+    )
+    {
+        // Under the queue's lock, enqueue the task. If one of the queue's own
+        // workers is waiting, it will execute the task.
+        TaskQueue& lQueue = *mQueues[pQueue];
+        {
+            std::lock_guard lGuard { lQueue.mMutex };
+            lQueue.mTasks.push_back(std::move(pTask));
+            if (lQueue.mIdle > 0)
+            {
+                lQueue.mConditional.notify_one();
+                return;
+            }
+        }
+
+        // Otherwise, the node's workers are all busy: wake an idle worker on
+        // another node to take the task from this queue.
+        for (std::size_t i = 1; i < mQueues.size(); ++i)
+        {
+            TaskQueue& lOther = *mQueues[(pQueue + i) % mQueues.size()];
+            std::lock_guard lGuard { lOther.mMutex };
+            if (lOther.mIdle > lOther.mSignals)
+            {
+                ++lOther.mSignals;
+                lOther.mConditional.notify_one();
+                return;
+            }
+        }
+    }
+
+    bool ThreadPool::TryPop (
+        TaskQueue&              pQueue,
+        std::function<void()>&  pTask
+    )
+    {
+        std::lock_guard lGuard { pQueue.mMutex };
+        if (pQueue.mTasks.empty() == true)
+        {
+            return false;
+        }
+
+        pTask = std::move(pQueue.mTasks.front());
+        pQueue.mTasks.pop_front();
+        return true;
+    }
+
+    TimerId ThreadPool::ScheduleTimer (
+        const Clock::time_point pTime,
+        std::function<void()>   pFunction,
+        const Clock::duration   pPeriod
+    )
+    {
+        // Round the deadline up to a whole tick, so the task never runs early,
+        // and the period to the nearest tick.
+        const std::uint64_t lDeadline = static_cast<std::uint64_t>(std::max<std::int64_t>(0,
+            std::chrono::ceil<std::chrono::milliseconds>(pTime - mTimerEpoch).count()));
+        const std::uint64_t lPeriod = static_cast<std::uint64_t>(
+            std::chrono::round<std::chrono::milliseconds>(pPeriod).count());
+
+        std::lock_guard lGuard { mTimerMutex };
+        const TimerId lTimer = mTimerWheel.Schedule(lDeadline, std::move(pFunction), lPeriod);
+
+        // Start the timer thread on first use. Otherwise, only wake it if the
+        // new deadline comes before the one it is sleeping until.
+        if (mTimerThread.joinable() == false)
+        {
+            mTimerThread = std::thread { &ThreadPool::RunTimers, this };
+        }
+        else if (mTimerWakeTick == 0 || lDeadline < mTimerWakeTick)
+        {
+            mTimerConditional.notify_one();
+        }
+
+        return lTimer;
+    }
+
+    void ThreadPool::RunTimers ()
+    {
+        std::vector<std::function<void()>> lExpired;
+        std::unique_lock lGuard { mTimerMutex };
+        while (mDone.load() == false)
+        {
+            // Turn the wheel to the current tick, and hand every task which
+            // came due to the workers, outside the lock.
+            const std::uint64_t lNow = static_cast<std::uint64_t>(
+                std::chrono::floor<std::chrono::milliseconds>(Clock::now() - mTimerEpoch).count());
+            mTimerWheel.Advance(lNow, lExpired);
+            if (lExpired.empty() == false)
+            {
+                mTimerWakeTick = 0;
+                lGuard.unlock();
+                for (auto& lTask : lExpired)
+                {
+                    Push(SelectQueue(), std::move(lTask));
+                }
+
+                lExpired.clear();
+                lGuard.lock();
+                continue;
+            }
+
+            // Sleep until the wheel next has work to do, or a task is
+            // scheduled before then.
+            const auto lNext = mTimerWheel.GetNextTick();
+            if (lNext.has_value() == true)
+            {
+                mTimerWakeTick = *lNext;
+                mTimerConditional.wait_until(lGuard, mTimerEpoch + *lNext * TIMER_RESOLUTION);
+            }
+            else
+            {
+                mTimerWakeTick = 0;
+                mTimerConditional.wait(lGuard);
+            }
+
+            mTimerWakeTick = 0;
+        }
+    }
+
+    void ThreadPool::RunWorker (
+        const std::size_t           pQueue,
+        std::vector<std::uint32_t>  pCpus
+    )
+    {
+        CpuTopology::PinCurrentThread(pCpus);
+        sCurrentPool = this;
+        sCurrentQueue = pQueue;
+
+        TaskQueue& lQueue = *mQueues[pQueue];
+        while (true)
+        {
+            // Take the next task from this worker's own queue, or failing
+            // that, from another node's.
+            std::function<void()> lTask;
+            bool lFound = TryPop(lQueue, lTask);
+            for (std::size_t i = 1; i < mQueues.size() && lFound == false; ++i)
+            {
+                lFound = TryPop(*mQueues[(pQueue + i) % mQueues.size()], lTask);
+            }
+
+            if (lFound == true)
+            {
+                // Execute the task. Between tasks, the worker holds no
+                // pointers into shared structures, so it is quiescent.
+                lTask();
+                EpochReclaimer::Quiesce();
+                continue;
+            }
+
+            // Under a lock, wait until the queue is not empty, another node
+            // asks for help, or the thread pool finishes.
+            std::unique_lock lGuard { lQueue.mMutex };
+            if (lQueue.mTasks.empty() == false)
+            {
+                continue;
+            }
+            else if (mDone.load() == true)
+            {
+                return;
+            }
+
+            ++lQueue.mIdle;
+            lQueue.mConditional.wait(
+                lGuard,
+                [&] -> bool
+                {
+                    return
+                        mDone.load() == true ||
+                        lQueue.mTasks.empty() == false ||
+                        lQueue.mSignals > 0;
+                }
+            );
+            --lQueue.mIdle;
+            if (lQueue.mSignals > 0)
+            {
+                --lQueue.mSignals;
+            }
+        }
+    }
+
 }
@@ -5,27 +5,118 @@
  */
 
 #pragma once
-#include <Ace/Common.hpp>
+#include <deque>
+#include <Ace/System/CpuTopology.hpp>
+#include <Ace/System/Settings.hpp>
+#include <Ace/System/TimerWheel.hpp>
 
 namespace ace
 {
 
+    /**
+     * @brief   Enumerates the ways a @a `ThreadPool` can place its worker
+     *          threads on the system's CPUs.
+     */
+    enum class ThreadPlacement : std::uint8_t
+    {
+        None,           ///< @brief Workers are left to the scheduler, sharing one task queue.
+        PhysicalCores,  ///< @brief Each worker is pinned to its own physical core, leaving SMT siblings idle.
+        NumaNodes       ///< @brief Workers are spread across the NUMA nodes, each free to run on any CPU of its node.
+    };
+
+    /**
+     * @brief   Retrieves the placement named by a setting's value: `cores`,
+     *          `nodes` or `none`.
+     *
+     * @param   pName   The placement's name.
+     *
+     * @return  The named placement, or @a `ThreadPlacement::None` if the name
+     *          is not recognized.
+     */
+    inline ThreadPlacement ParseThreadPlacement (
+        std::string_view    pName
+    )
+    {
+        if (pName == "cores")
+        {
+            return ThreadPlacement::PhysicalCores;
+        }
+        else if (pName == "nodes")
+        {
+            return ThreadPlacement::NumaNodes;
+        }
+
+        return ThreadPlacement::None;
+    }
+
+    /**
+     * @brief   A structure containing the settings a @a `ThreadPool` is
+     *          created with. Each defaults to its `threadpool.*` setting.
+     */
+    struct ThreadPoolSpec
+    {
+        std::size_t         mThreadCount = Settings::Get<std::size_t>("threadpool.threads", std::thread::hardware_concurrency());          ///< @brief The largest number of worker threads to create.
+        ThreadPlacement     mPlacement = ParseThreadPlacement(Settings::Get<std::string_view>("threadpool.placement", "none"));         ///< @brief How the workers are placed on the CPUs.
+        std::size_t         mReservedCores = Settings::Get<std::size_t>("threadpool.reserved_cores", 0);                              ///< @brief The number of physical cores kept free of workers, for the logger or I/O threads.
+    };
+
     /**
      * @brief   A class used for managing a pool of threads, for working on a
      *          large number of tasks concurrently.
+     *
+     * With a placement other than @a `ThreadPlacement::None`, the workers are
+     * pinned according to the @a `CpuTopology`, and each NUMA node with
+     * workers gets a task queue of its own. Tasks enqueued by a worker go to
+     * its own node's queue, so that work spawned near some data stays near
+     * it; tasks enqueued from elsewhere are dealt across the nodes in turn,
+     * or sent to a node with @a `EnqueueOnNode`. A worker whose queue is
+     * empty takes tasks from the other nodes' queues before it sleeps, and a
+     * task enqueued on a node with no idle worker wakes one on another node.
+     *
+     * Reserved cores are the lowest-numbered physical cores of the topology.
+     * Their CPUs are never given to workers, whatever the placement, and can
+     * be retrieved with @a `GetReservedCpus` for pinning other threads to.
+     *
+     * Tasks can also be scheduled for later with @a `EnqueueAt`,
+     * @a `EnqueueAfter` and @a `EnqueueEvery`. Scheduled tasks are kept on a
+     * @a `TimerWheel` with a resolution of @a `TIMER_RESOLUTION`, served by a
+     * timer thread started on first use. The timer thread sleeps until the
+     * wheel's next deadline, and is only woken early by a task scheduled
+     * before it; every task due by the time it wakes is handed to the workers
+     * in one batch.
      */
     class ACE_API ThreadPool final
     {
     public:
 
+        using Clock = std::chrono::steady_clock;
+
         /**
-         * @brief   The default constructor creates the given number of new
-         *          threads to work on tasks.
+         * @brief   The length of one tick of the timer wheel. Scheduled tasks
+         *          run no earlier than their deadline, and typically within
+         *          one tick after it.
+         */
+        static constexpr std::chrono::milliseconds TIMER_RESOLUTION { 1 };
+
+    public:
+
+        /**
+         * @brief   Creates a thread pool with the given settings.
+         *
+         * @param   pSpec   The thread pool's settings.
+         */
+        explicit ThreadPool (
+            const ThreadPoolSpec&   pSpec = {}
+        );
+
+        /**
+         * @brief   Creates the given number of new threads to work on tasks,
+         *          with the other settings taken from their defaults.
          * 
          * @param   pThreadCount    The number of worker threads to be created.
          */
         explicit ThreadPool (
-            std::size_t pThreadCount = std::thread::hardware_concurrency()
+            std::size_t pThreadCount
         );
         
         /**
@@ -56,6 +147,292 @@ namespace ace
             T&&         pFunction,
             As&&...     pArgs
         ) -> std::future<std::invoke_result_t<T, As...>>
+        {
+            return EnqueueOnQueue(
+                SelectQueue(),
+                std::forward<T>(pFunction),
+                std::forward<As>(pArgs)...
+            );
+        }
+
+        /**
+         * @brief   Enqueues a new task for one of the worker threads on the
+         *          given NUMA node to execute in the future.
+         *
+         * Workers on other nodes may still take the task if its node's
+         * workers are all busy.
+         *
+         * @tparam  T       The type of the function to be called by the task.
+         * @tparam  As...   The types of the arguments passed into the function.
+         *
+         * @param   pNode       The node, numbered as in the @a `CpuTopology`.
+         *                      If no workers run on it, the task is enqueued
+         *                      as by @a `Enqueue`.
+         * @param   pFunction   The function to be called by the task.
+         * @param   pArgs       The arguments, if any, passed into the function.
+         *
+         * @return  An `std::future` which will hold the function's return value
+         *          once the task has been executed.
+         */
+        template <typename T, typename... As>
+        auto EnqueueOnNode (
+            const std::uint32_t pNode,
+            T&&                 pFunction,
+            As&&...             pArgs
+        ) -> std::future<std::invoke_result_t<T, As...>>
+        {
+            return EnqueueOnQueue(
+                FindQueue(pNode),
+                std::forward<T>(pFunction),
+                std::forward<As>(pArgs)...
+            );
+        }
+
+        /**
+         * @brief   Schedules a task to be enqueued once the given time comes.
+         *
+         * @param   pTime       The time to enqueue the task at.
+         * @param   pFunction   The function to be called by the task.
+         *
+         * @return  A handle with which the task can be cancelled until it is
+         *          enqueued.
+         */
+        TimerId EnqueueAt (
+            const Clock::time_point pTime,
+            std::function<void()>   pFunction
+        );
+
+        /**
+         * @brief   Schedules a task to be enqueued once the given delay has
+         *          passed.
+         *
+         * @param   pDelay      The delay before the task is enqueued.
+         * @param   pFunction   The function to be called by the task.
+         *
+         * @return  A handle with which the task can be cancelled until it is
+         *          enqueued.
+         */
+        TimerId EnqueueAfter (
+            const Clock::duration   pDelay,
+            std::function<void()>   pFunction
+        );
+
+        /**
+         * @brief   Schedules a task to be enqueued repeatedly, every period,
+         *          starting one period from now.
+         *
+         * Repeats keep to the original schedule rather than drifting with the
+         * time each one takes to run. If the pool falls behind by more than a
+         * period, the missed repeats are run once, not once each.
+         *
+         * @param   pPeriod     The time between repeats. At least one tick.
+         * @param   pFunction   The function to be called by each repeat.
+         *
+         * @return  A handle with which the repeats can be cancelled.
+         */
+        TimerId EnqueueEvery (
+            const Clock::duration   pPeriod,
+            std::function<void()>   pFunction
+        );
+
+        /**
+         * @brief   Cancels a scheduled task, if it has not been enqueued yet,
+         *          or stops a repeating task.
+         *
+         * @param   pTimer  The task's handle.
+         *
+         * @return  `true` if the task was cancelled; `false` if it has already
+         *          been enqueued, or was cancelled before.
+         */
+        bool CancelTimer (
+            const TimerId   pTimer
+        );
+
+        /**
+         * @brief   Calls the given function once for each index in the range
+         *          `[0, pCount)`, spreading the calls across the worker threads
+         *          and the calling thread, then waits for all calls to finish.
+         *
+         * Indices are handed out in batches of @a `pGrainSize` from a shared
+         * atomic counter, so threads which finish their batches early pick up
+         * more work instead of sitting idle.
+         *
+         * @tparam  T           The type of the function to be called.
+         *
+         * @param   pCount      The number of indices to call the function for.
+         * @param   pFunction   The function to be called, taking the index as
+         *                      its only argument.
+         * @param   pGrainSize  The number of indices handed out at once.
+         *
+         * @warning Do not call this method from one of this thread pool's own
+         *          worker threads; the calling thread would block waiting on
+         *          workers which may all be busy waiting the same way.
+         */
+        template <typename T>
+        void ParallelFor (
+            const std::size_t&  pCount,
+            T&&                 pFunction,
+            const std::size_t&  pGrainSize = 1
+        )
+        {
+            if (pCount == 0)
+            {
+                return;
+            }
+
+            // Each participating thread repeatedly claims the next batch of
+            // indices until none are left.
+            const std::size_t lGrainSize = std::max<std::size_t>(pGrainSize, 1);
+            std::atomic<std::size_t> lNext { 0 };
+            auto lWork =
+                [&] () -> void
+                {
+                    while (true)
+                    {
+                        std::size_t lBegin = lNext.fetch_add(lGrainSize,
+                            std::memory_order_relaxed);
+                        if (lBegin >= pCount)
+                        {
+                            return;
+                        }
+
+                        std::size_t lEnd = std::min(lBegin + lGrainSize, pCount);
+                        for (std::size_t i = lBegin; i < lEnd; ++i)
+                        {
+                            pFunction(i);
+                        }
+                    }
+                };
+
+            // Enlist no more helpers than there are batches beyond the one the
+            // calling thread will take itself.
+            std::size_t lBatches = (pCount + lGrainSize - 1) / lGrainSize;
+            std::size_t lHelpers = std::min(mWorkerThreads.size(), lBatches - 1);
+            std::vector<std::future<void>> lFutures;
+            lFutures.reserve(lHelpers);
+            for (std::size_t i = 0; i < lHelpers; ++i)
+            {
+                lFutures.push_back(Enqueue(lWork));
+            }
+
+            // The helpers reference this method's locals, so every one of them
+            // must be waited on before an exception is allowed to leave.
+            std::exception_ptr lException = nullptr;
+            try
+            {
+                lWork();
+            }
+            catch (...)
+            {
+                lException = std::current_exception();
+            }
+
+            for (auto& lFuture : lFutures)
+            {
+                try
+                {
+                    lFuture.get();
+                }
+                catch (...)
+                {
+                    if (lException == nullptr)
+                    {
+                        lException = std::current_exception();
+                    }
+                }
+            }
+
+            if (lException != nullptr)
+            {
+                std::rethrow_exception(lException);
+            }
+        }
+
+        /**
+         * @brief   Retrieves the number of worker threads in this thread pool.
+         *
+         * @return  The number of worker threads.
+         */
+        inline std::size_t GetThreadCount () const
+        {
+            return mWorkerThreads.size();
+        }
+
+        /**
+         * @brief   Retrieves the placement the workers were created with.
+         *
+         * @return  The workers' placement.
+         */
+        inline ThreadPlacement GetPlacement () const
+        {
+            return mPlacement;
+        }
+
+        /**
+         * @brief   Retrieves the number of task queues: one per NUMA node with
+         *          workers, or one in total without a placement.
+         *
+         * @return  The number of task queues.
+         */
+        inline std::size_t GetQueueCount () const
+        {
+            return mQueues.size();
+        }
+
+        /**
+         * @brief   Retrieves the CPUs of the reserved cores, which no worker
+         *          runs on.
+         *
+         * @return  The reserved CPUs, suitable for
+         *          @a `CpuTopology::PinCurrentThread`.
+         */
+        inline std::span<const std::uint32_t> GetReservedCpus () const
+        {
+            return mReservedCpus;
+        }
+
+        /**
+         * @brief   Retrieves the NUMA node the calling thread works on, if it
+         *          is one of this thread pool's workers.
+         *
+         * @return  An `std::optional` which contains the worker's node, if the
+         *          caller is one of this pool's workers.
+         */
+        std::optional<std::uint32_t> GetCurrentNode () const;
+
+    private:
+        ThreadPool (const ThreadPool&) = delete;
+        ThreadPool (ThreadPool&&) = delete;
+        void operator= (const ThreadPool&) = delete;
+        void operator= (ThreadPool&&) = delete;
+
+    private:
+
+        /**
+         * @brief   A structure containing one NUMA node's task queue.
+         */
+        struct TaskQueue
+        {
+            std::uint32_t                       mNode = 0;          ///< @brief The node whose workers serve this queue.
+            std::deque<std::function<void()>>   mTasks;             ///< @brief The tasks waiting to be executed.
+            std::mutex                          mMutex;             ///< @brief The mutex used for locking down this queue.
+            std::condition_variable             mConditional;       ///< @brief A conditional for the node's workers to wait for new tasks on.
+            std::size_t                         mIdle = 0;          ///< @brief The number of the node's workers waiting on @a `mConditional`.
+            std::size_t                         mSignals = 0;       ///< @brief The number of idle workers woken to take tasks from other queues.
+        };
+
+    private:
+
+        /**
+         * @brief   Wraps a function and its arguments in a packaged task, and
+         *          pushes it onto the given queue.
+         */
+        template <typename T, typename... As>
+        auto EnqueueOnQueue (
+            const std::size_t&  pQueue,
+            T&&                 pFunction,
+            As&&...             pArgs
+        ) -> std::future<std::invoke_result_t<T, As...>>
         {
 
             // Define the return type of the function which the task to be
@@ -76,21 +453,15 @@ namespace ace
                 );
             std::future<ReturnValue> lFuture = lTaskPointer->get_future();
 
-            // Under a lock, enqueue a void function which will call the
-            // bound, packaged task function.
-            {
-                std::lock_guard lGuard { mMutex };
-                mTasks.emplace(
-                    [lTaskPointer] -> void
-                    {
-                        (*lTaskPointer)();
-                    }
-                );
-            }
-
-            // Notify one of the waiting worker threads that a new task is
-            // available to be executed.
-            mConditional.notify_one();
+            // Push a void function which will call the bound, packaged task
+            // function, waking a worker to execute it.
+            Push(
+                pQueue,
+                [lTaskPointer] -> void
+                {
+                    (*lTaskPointer)();
+                }
+            );
 
             // The `std::future` returned here will contain the return value,
             // if any, of the packaged task function that is executed.
@@ -98,12 +469,80 @@ namespace ace
 
         }
 
+        /**
+         * @brief   Picks the queue for a task enqueued without a node: the
+         *          calling worker's own, or the next in turn.
+         */
+        std::size_t SelectQueue ();
+
+        /**
+         * @brief   Finds the queue serving the given node, falling back to
+         *          @a `SelectQueue` if there is none.
+         */
+        std::size_t FindQueue (
+            const std::uint32_t pNode
+        );
+
+        /**
+         * @brief   Pushes a task onto a queue, and wakes an idle worker to
+         *          execute it: one of the queue's own if any, or else one on
+         *          another node.
+         */
+        void Push (
+            const std::size_t&      pQueue,
+            std::function<void()>   pTask
+        );
+
+        /**
+         * @brief   Takes a task from the front of a queue, if it has any.
+         */
+        bool TryPop (
+            TaskQueue&              pQueue,
+            std::function<void()>&  pTask
+        );
+
+        /**
+         * @brief   Runs a worker serving the given queue, until the pool is
+         *          destroyed.
+         *
+         * @param   pQueue  The index of the worker's queue.
+         * @param   pCpus   The CPUs to pin the worker to, if any.
+         */
+        void RunWorker (
+            const std::size_t           pQueue,
+            std::vector<std::uint32_t>  pCpus
+        );
+
+        /**
+         * @brief   Schedules a function on the timer wheel, starting the timer
+         *          thread if it is not running yet.
+         */
+        TimerId ScheduleTimer (
+            const Clock::time_point pTime,
+            std::function<void()>   pFunction,
+            const Clock::duration   pPeriod
+        );
+
+        /**
+         * @brief   Runs the timer thread, which enqueues scheduled tasks as
+         *          they come due, until the pool is destroyed.
+         */
+        void RunTimers ();
+
     private:
-        std::vector<std::thread>            mWorkerThreads;     ///< @brief The list of worker threads in this thread pool.
-        std::queue<std::function<void()>>   mTasks;             ///< @brief The queue of tasks being worked on by this thread pool's worker threads.
-        std::mutex                          mMutex;             ///< @brief The mutex used for locking down this class's members.
-        std::condition_variable             mConditional;       ///< @brief A conditional for the worker threads to wait for new tasks on.
-        bool                                mDone = false;      ///< @brief Is the thread pool finished executing tasks?
+        std::vector<std::thread>                    mWorkerThreads;         ///< @brief The list of worker threads in this thread pool.
+        std::vector<std::unique_ptr<TaskQueue>>     mQueues;                ///< @brief The task queues, one per NUMA node with workers.
+        std::vector<std::uint32_t>                  mReservedCpus;          ///< @brief The CPUs of the reserved cores.
+        ThreadPlacement                             mPlacement = ThreadPlacement::None; ///< @brief How the workers are placed on the CPUs.
+        std::atomic<std::size_t>                    mNextQueue { 0 };       ///< @brief The queue the next task enqueued from outside the pool goes to.
+        std::atomic<bool>                           mDone { false };        ///< @brief Is the thread pool finished executing tasks?
+
+        Clock::time_point                           mTimerEpoch;            ///< @brief The time of the timer wheel's tick zero.
+        TimerWheel                                  mTimerWheel;            ///< @brief The wheel of scheduled tasks.
+        std::uint64_t                               mTimerWakeTick = 0;     ///< @brief The tick the timer thread is sleeping until, or zero if it is awake or sleeping indefinitely.
+        std::mutex                                  mTimerMutex;            ///< @brief The mutex used for locking down the timer wheel.
+        std::condition_variable                     mTimerConditional;      ///< @brief A conditional for the timer thread to sleep on.
+        std::thread                                 mTimerThread;           ///< @brief The timer thread, once started.
 
     };
 
@@ -0,0 +1,301 @@
+/**
+ * @file    Ace/System/TimerWheel.cpp
+ */
+
+#include <Ace/System/TimerWheel.hpp>
+
+namespace ace
+{
+
+    /* Constructors and Destructor ********************************************/
+
+    TimerWheel::TimerWheel (
+        const std::uint64_t pNow
+    ) :
+        mNow    { pNow }
+    {
+        mSlots.fill(NONE);
+    }
+
+    /* Public Methods *********************************************************/
+
+    TimerId TimerWheel::Schedule (
+        const std::uint64_t     pDeadline,
+        std::function<void()>   pCallback,
+        const std::uint64_t     pPeriod
+    )
+    {
+        // Take a timer from the free list, growing the pool if it is empty.
+        std::uint32_t lIndex = mFree;
+        if (lIndex != NONE)
+        {
+            mFree = mTimers[lIndex].mNext;
+        }
+        else
+        {
+            lIndex = static_cast<std::uint32_t>(mTimers.size());
+            mTimers.emplace_back();
+        }
+
+        Timer& lTimer = mTimers[lIndex];
+        lTimer.mDeadline = std::max(pDeadline, mNow + 1);
+        lTimer.mPeriod = pPeriod;
+        lTimer.mCallback = std::move(pCallback);
+        Link(lIndex);
+        ++mCount;
+
+        return (static_cast<TimerId>(lTimer.mGeneration) << 32) | (lIndex + 1);
+    }
+
+    bool TimerWheel::Cancel (
+        const TimerId   pTimer
+    )
+    {
+        const std::uint64_t lIndex = (pTimer & 0xFFFFFFFF) - 1;
+        if (
+            pTimer == INVALID_TIMER ||
+            lIndex >= mTimers.size() ||
+            mTimers[lIndex].mGeneration != static_cast<std::uint32_t>(pTimer >> 32) ||
+            mTimers[lIndex].mSlot == NONE
+        )
+        {
+            return false;
+        }
+
+        // Unlink the timer and return it to the free list. Bumping its
+        // generation invalidates every handle to it.
+        Timer& lTimer = mTimers[lIndex];
+        Unlink(static_cast<std::uint32_t>(lIndex));
+        lTimer.mCallback = nullptr;
+        ++lTimer.mGeneration;
+        lTimer.mNext = mFree;
+        mFree = static_cast<std::uint32_t>(lIndex);
+        --mCount;
+
+        return true;
+    }
+
+    std::size_t TimerWheel::Advance (
+        const std::uint64_t                     pNow,
+        std::vector<std::function<void()>>&     pExpired
+    )
+    {
+        std::size_t lExpiredCount = 0;
+        while (mNow < pNow)
+        {
+            // Skip straight past ticks on which nothing would happen.
+            const auto lNext = GetNextTick();
+            if (lNext.has_value() == false || *lNext > pNow)
+            {
+                mNow = pNow;
+                break;
+            }
+
+            mNow = *lNext;
+
+            // Each time a level turns over, cascade the next slot of the level
+            // above down into the levels below.
+            for (std::size_t lLevel = 1; lLevel < LEVEL_COUNT; ++lLevel)
+            {
+                const std::uint32_t lShift = static_cast<std::uint32_t>(lLevel) * LEVEL_BITS;
+                if ((mNow & ((std::uint64_t { 1 } << lShift) - 1)) != 0)
+                {
+                    break;
+                }
+
+                std::uint32_t lIndex = DetachSlot(static_cast<std::uint32_t>(
+                    lLevel * SLOT_COUNT + ((mNow >> lShift) & (SLOT_COUNT - 1))));
+                while (lIndex != NONE)
+                {
+                    const std::uint32_t lNextIndex = mTimers[lIndex].mNext;
+                    Link(lIndex);
+                    lIndex = lNextIndex;
+                }
+            }
+
+            // Expire every timer in this tick's slot.
+            std::uint32_t lIndex = DetachSlot(static_cast<std::uint32_t>(mNow & (SLOT_COUNT - 1)));
+            while (lIndex != NONE)
+            {
+                Timer& lTimer = mTimers[lIndex];
+                const std::uint32_t lNextIndex = lTimer.mNext;
+                ++lExpiredCount;
+
+                if (lTimer.mPeriod > 0)
+                {
+                    // Reschedule a repeating timer on its next deadline which
+                    // is still to come.
+                    pExpired.push_back(lTimer.mCallback);
+                    lTimer.mDeadline += lTimer.mPeriod;
+                    if (lTimer.mDeadline <= mNow)
+                    {
+                        lTimer.mDeadline += ((mNow - lTimer.mDeadline) / lTimer.mPeriod + 1) *
+                            lTimer.mPeriod;
+                    }
+
+                    Link(lIndex);
+                }
+                else
+                {
+                    pExpired.push_back(std::move(lTimer.mCallback));
+                    lTimer.mCallback = nullptr;
+                    ++lTimer.mGeneration;
+                    lTimer.mNext = mFree;
+                    mFree = lIndex;
+                    --mCount;
+                }
+
+                lIndex = lNextIndex;
+            }
+        }
+
+        return lExpiredCount;
+    }
+
+    std::optional<std::uint64_t> TimerWheel::GetNextTick () const
+    {
+        if (mCount == 0)
+        {
+            return std::nullopt;
+        }
+
+        // A level's slots come up in order, starting just after its current
+        // slot. For level zero, that is when the slot's timers expire; for
+        // the levels above, when the slot cascades down.
+        std::uint64_t lBest = std::numeric_limits<std::uint64_t>::max();
+        for (std::size_t lLevel = 0; lLevel < LEVEL_COUNT; ++lLevel)
+        {
+            const std::uint32_t lShift = static_cast<std::uint32_t>(lLevel) * LEVEL_BITS;
+            const std::uint32_t lSpan = lShift + LEVEL_BITS;
+            const std::uint64_t lBase = (mNow >> lSpan) << lSpan;
+            const std::size_t lCurrent = (mNow >> lShift) & (SLOT_COUNT - 1);
+
+            std::size_t lSlot = FindOccupied(lLevel, lCurrent + 1);
+            std::uint64_t lTick = lBase + (static_cast<std::uint64_t>(lSlot) << lShift);
+            if (lSlot == SLOT_COUNT)
+            {
+                lSlot = FindOccupied(lLevel, 0);
+                if (lSlot == SLOT_COUNT)
+                {
+                    continue;
+                }
+
+                lTick = lBase + (std::uint64_t { 1 } << lSpan) +
+                    (static_cast<std::uint64_t>(lSlot) << lShift);
+            }
+
+            lBest = std::min(lBest, lTick);
+        }
+
+        return lBest;
+    }
+
+    /* Private Methods ********************************************************/
+
+    void TimerWheel::Link (
+        const std::uint32_t pIndex
+    )
+    {
+        // Pick the lowest level whose range covers the deadline. Deadlines
+        // beyond the top level's range wait in its slots, and cascade back
+        // into it until they come within range.
+        Timer& lTimer = mTimers[pIndex];
+        const std::uint64_t lDelta = (lTimer.mDeadline > mNow) ? lTimer.mDeadline - mNow : 0;
+        std::size_t lLevel = 0;
+        while (lLevel + 1 < LEVEL_COUNT && lDelta >= (std::uint64_t { 1 } << ((lLevel + 1) * LEVEL_BITS)))
+        {
+            ++lLevel;
+        }
+
+        const std::uint64_t lDeadline = std::max(lTimer.mDeadline, mNow);
+        const std::uint32_t lSlot = static_cast<std::uint32_t>(lLevel * SLOT_COUNT +
+            ((lDeadline >> (lLevel * LEVEL_BITS)) & (SLOT_COUNT - 1)));
+
+        // Push the timer onto the front of the slot's list.
+        lTimer.mSlot = lSlot;
+        lTimer.mPrevious = NONE;
+        lTimer.mNext = mSlots[lSlot];
+        if (lTimer.mNext != NONE)
+        {
+            mTimers[lTimer.mNext].mPrevious = pIndex;
+        }
+
+        mSlots[lSlot] = pIndex;
+        mOccupied[lSlot / 64] |= std::uint64_t { 1 } << (lSlot % 64);
+    }
+
+    void TimerWheel::Unlink (
+        const std::uint32_t pIndex
+    )
+    {
+        Timer& lTimer = mTimers[pIndex];
+        if (lTimer.mPrevious != NONE)
+        {
+            mTimers[lTimer.mPrevious].mNext = lTimer.mNext;
+        }
+        else
+        {
+            mSlots[lTimer.mSlot] = lTimer.mNext;
+            if (lTimer.mNext == NONE)
+            {
+                mOccupied[lTimer.mSlot / 64] &= ~(std::uint64_t { 1 } << (lTimer.mSlot % 64));
+            }
+        }
+
+        if (lTimer.mNext != NONE)
+        {
+            mTimers[lTimer.mNext].mPrevious = lTimer.mPrevious;
+        }
+
+        lTimer.mSlot = NONE;
+        lTimer.mPrevious = NONE;
+        lTimer.mNext = NONE;
+    }
+
+    std::uint32_t TimerWheel::DetachSlot (
+        const std::uint32_t pSlot
+    )
+    {
+        // Timers are pushed onto the front of their slot, so reverse the list
+        // to hand them out in the order they were linked.
+        std::uint32_t lIndex = mSlots[pSlot];
+        std::uint32_t lReversed = NONE;
+        while (lIndex != NONE)
+        {
+            Timer& lTimer = mTimers[lIndex];
+            const std::uint32_t lNext = lTimer.mNext;
+            lTimer.mSlot = NONE;
+            lTimer.mPrevious = NONE;
+            lTimer.mNext = lReversed;
+            lReversed = lIndex;
+            lIndex = lNext;
+        }
+
+        mSlots[pSlot] = NONE;
+        mOccupied[pSlot / 64] &= ~(std::uint64_t { 1 } << (pSlot % 64));
+        return lReversed;
+    }
+
+    std::size_t TimerWheel::FindOccupied (
+        const std::size_t   pLevel,
+        const std::size_t   pFrom
+    ) const
+    {
+        for (std::size_t lWord = pFrom / 64; lWord < BITMAP_WORDS; ++lWord)
+        {
+            std::uint64_t lBits = mOccupied[pLevel * BITMAP_WORDS + lWord];
+            if (lWord == pFrom / 64)
+            {
+                lBits &= ~std::uint64_t { 0 } << (pFrom % 64);
+            }
+
+            if (lBits != 0)
+            {
+                return lWord * 64 + std::countr_zero(lBits);
+            }
+        }
+
+        return SLOT_COUNT;
+    }
+
+}
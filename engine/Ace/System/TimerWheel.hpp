@@ -0,0 +1,230 @@
+/**
+ * @file    Ace/System/TimerWheel.hpp
+ * @brief   Provides a hierarchical timer wheel, which tracks large numbers of
+ *          timers with constant-time scheduling and cancellation.
+ */
+
+#pragma once
+#include <bit>
+#include <Ace/Common.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A handle to a timer scheduled on a @a `TimerWheel`. Handles are
+     *          never reused, so a stale handle is safe to cancel.
+     */
+    using TimerId = std::uint64_t;
+
+    /**
+     * @brief   A handle which refers to no timer.
+     */
+    inline constexpr TimerId INVALID_TIMER = 0;
+
+    /**
+     * @brief   A class which tracks timers on a hierarchical timer wheel.
+     *
+     * Time is measured in whole ticks, whose length is up to the caller. The
+     * wheel has @a `LEVEL_COUNT` levels of @a `SLOT_COUNT` slots each: level
+     * zero has a slot per tick for the next 256 ticks, level one a slot per
+     * 256 ticks for the next 65536, and so on. A timer is linked into the
+     * slot of the lowest level whose range covers its deadline, which takes
+     * constant time, as does unlinking it to cancel it. Each time the wheel
+     * turns past a slot of a higher level, that slot's timers cascade down
+     * into the levels below, so every timer is moved at most once per level.
+     * Timers further out than the top level's range are kept in its slots and
+     * simply cascade back into the top level until their deadline is in
+     * range.
+     *
+     * Timers live in a single pooled array and are linked by index, so the
+     * wheel makes no allocations per timer once the pool has grown to its
+     * peak size. A bitmap of occupied slots lets the wheel find its next
+     * deadline, and skip over empty stretches, without visiting every slot.
+     *
+     * A timer wheel is not thread-safe.
+     */
+    class ACE_API TimerWheel final
+    {
+    public:
+
+        /**
+         * @brief   The number of bits of a tick count each level covers.
+         */
+        static constexpr std::uint32_t LEVEL_BITS = 8;
+
+        /**
+         * @brief   The number of slots on each level.
+         */
+        static constexpr std::size_t SLOT_COUNT = std::size_t { 1 } << LEVEL_BITS;
+
+        /**
+         * @brief   The number of levels.
+         */
+        static constexpr std::size_t LEVEL_COUNT = 4;
+
+    public:
+
+        /**
+         * @brief   Constructs an empty timer wheel.
+         *
+         * @param   pNow    The wheel's current tick.
+         */
+        explicit TimerWheel (
+            const std::uint64_t pNow = 0
+        );
+
+    public:
+
+        /**
+         * @brief   Schedules a timer.
+         *
+         * @param   pDeadline   The tick on which the timer expires. A deadline
+         *                      which has already passed expires on the next
+         *                      tick.
+         * @param   pCallback   The function the timer carries.
+         * @param   pPeriod     The number of ticks between repeats, or zero
+         *                      for a timer which expires only once.
+         *
+         * @return  A handle to the new timer.
+         */
+        TimerId Schedule (
+            const std::uint64_t     pDeadline,
+            std::function<void()>   pCallback,
+            const std::uint64_t     pPeriod = 0
+        );
+
+        /**
+         * @brief   Cancels a timer, if it is still scheduled.
+         *
+         * @param   pTimer  The timer's handle.
+         *
+         * @return  `true` if the timer was cancelled; `false` if it has
+         *          already expired, been cancelled, or never existed.
+         */
+        bool Cancel (
+            const TimerId   pTimer
+        );
+
+        /**
+         * @brief   Turns the wheel forward to the given tick, collecting the
+         *          callback of every timer which expires on the way.
+         *
+         * A repeating timer's callback is copied, and the timer rescheduled a
+         * whole number of periods after its last deadline: a timer which fell
+         * behind by several periods expires once, not once per period missed.
+         *
+         * @param   pNow        The tick to turn to. Ticks before the wheel's
+         *                      current tick are ignored.
+         * @param   pExpired    Receives the expired timers' callbacks, in
+         *                      order of deadline.
+         *
+         * @return  The number of timers which expired.
+         */
+        std::size_t Advance (
+            const std::uint64_t                     pNow,
+            std::vector<std::function<void()>>&     pExpired
+        );
+
+        /**
+         * @brief   Retrieves the earliest tick on which the wheel may have
+         *          work to do: a timer expiring, or a higher level's slot
+         *          cascading down.
+         *
+         * @return  An `std::optional` which contains the tick, if any timers
+         *          are scheduled.
+         */
+        std::optional<std::uint64_t> GetNextTick () const;
+
+        /**
+         * @brief   Retrieves the wheel's current tick.
+         *
+         * @return  The latest tick the wheel has turned to.
+         */
+        inline std::uint64_t GetNow () const
+        {
+            return mNow;
+        }
+
+        /**
+         * @brief   Retrieves the number of timers scheduled.
+         *
+         * @return  The number of scheduled timers.
+         */
+        inline std::size_t GetCount () const
+        {
+            return mCount;
+        }
+
+    private:
+
+        /**
+         * @brief   The index which marks the end of a list of timers.
+         */
+        static constexpr std::uint32_t NONE = std::numeric_limits<std::uint32_t>::max();
+
+        /**
+         * @brief   A structure containing one pooled timer.
+         */
+        struct Timer
+        {
+            std::uint64_t           mDeadline = 0;      ///< @brief The tick on which the timer expires.
+            std::uint64_t           mPeriod = 0;        ///< @brief The ticks between repeats, or zero.
+            std::function<void()>   mCallback;          ///< @brief The function the timer carries.
+            std::uint32_t           mPrevious = NONE;   ///< @brief The previous timer in the timer's slot.
+            std::uint32_t           mNext = NONE;       ///< @brief The next timer in the timer's slot, or in the free list.
+            std::uint32_t           mSlot = NONE;       ///< @brief The slot the timer is linked into, across all levels, or @a `NONE` if it is free.
+            std::uint32_t           mGeneration = 0;    ///< @brief Counts the times this pool entry has been reused.
+        };
+
+        /**
+         * @brief   The number of 64-bit words in each level's bitmap.
+         */
+        static constexpr std::size_t BITMAP_WORDS = SLOT_COUNT / 64;
+
+    private:
+
+        /**
+         * @brief   Links a timer into the slot its deadline belongs in.
+         */
+        void Link (
+            const std::uint32_t pIndex
+        );
+
+        /**
+         * @brief   Unlinks a timer from its slot.
+         */
+        void Unlink (
+            const std::uint32_t pIndex
+        );
+
+        /**
+         * @brief   Detaches every timer from a slot, returning the first.
+         */
+        std::uint32_t DetachSlot (
+            const std::uint32_t pSlot
+        );
+
+        /**
+         * @brief   Finds the first occupied slot of a level at or after the
+         *          given slot, without wrapping around.
+         *
+         * @return  The slot's index within the level, or @a `SLOT_COUNT` if
+         *          there is none.
+         */
+        std::size_t FindOccupied (
+            const std::size_t   pLevel,
+            const std::size_t   pFrom
+        ) const;
+
+    private:
+        std::uint64_t                                           mNow = 0;           ///< @brief The wheel's current tick.
+        std::size_t                                             mCount = 0;         ///< @brief The number of scheduled timers.
+        std::vector<Timer>                                      mTimers;            ///< @brief The pool of timers.
+        std::uint32_t                                           mFree = NONE;       ///< @brief The first free timer in the pool.
+        std::array<std::uint32_t, LEVEL_COUNT * SLOT_COUNT>     mSlots;             ///< @brief The first timer in each slot, across all levels.
+        std::array<std::uint64_t, LEVEL_COUNT * BITMAP_WORDS>   mOccupied {};       ///< @brief A bit for each slot, set if it holds any timers.
+
+    };
+
+}
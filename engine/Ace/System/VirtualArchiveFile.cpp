@@ -157,6 +157,12 @@ namespace ace
         return mSize;
     }
     
+    std::span<const std::uint8_t> VirtualArchiveFile::Map ()
+    {
+        // The entry was extracted into memory when it was opened.
+        return { mBuffer.data(), mSize };
+    }
+
     void VirtualArchiveFile::Close ()
     {
         mBuffer.clear();
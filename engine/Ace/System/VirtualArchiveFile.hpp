@@ -57,6 +57,8 @@ namespace ace
         std::size_t Tell () const override;
         
         std::size_t GetSize () const override;
+
+        std::span<const std::uint8_t> Map () override;
         
         void Close () override;
 
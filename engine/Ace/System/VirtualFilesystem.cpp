@@ -7,15 +7,12 @@
 namespace ace
 {
 
-    /* Static Members *********************************************************/
-
-    std::vector<VirtualFilesystem::Mount>   VirtualFilesystem::sMounts;
-
     /* Public Methods *********************************************************/
 
     void VirtualFilesystem::MountPhysicalDirectory (
         const std::string&  pMountPoint,
-        const fs::path&     pRealPath
+        const fs::path&     pRealPath,
+        const bool          pWritable
     )
     {
         std::string lMountPoint = NormalizePath(pMountPoint);
@@ -28,7 +25,7 @@ namespace ace
             );
         }
 
-        sMounts.emplace_back(PhysicalMount { lMountPoint, pRealPath });
+        AddMount(PhysicalMount { lMountPoint, pRealPath, pWritable });
     }
 
     void VirtualFilesystem::MountArchive (
@@ -46,7 +43,55 @@ namespace ace
             );
         }
 
-        sMounts.emplace_back(ArchiveMount { lMountPoint, pArchivePath });
+        AddMount(ArchiveMount { lMountPoint, pArchivePath });
+    }
+
+    std::shared_ptr<VirtualMemoryStore> VirtualFilesystem::MountMemory (
+        const std::string&  pMountPoint
+    )
+    {
+        auto lStore = std::make_shared<VirtualMemoryStore>();
+        AddMount(MemoryMount { NormalizePath(pMountPoint), lStore });
+        return lStore;
+    }
+
+    bool VirtualFilesystem::Unmount (
+        const std::string&  pMountPoint,
+        const fs::path&     pRealPath
+    )
+    {
+        const std::string lMountPoint = NormalizePath(pMountPoint);
+        return RemoveMount(
+            [&] (const Mount& pMount)
+            {
+                if (const auto* lMount = std::get_if<PhysicalMount>(&pMount); lMount != nullptr)
+                {
+                    return lMount->mMountPoint == lMountPoint && lMount->mRealPath == pRealPath;
+                }
+                else if (const auto* lMount = std::get_if<ArchiveMount>(&pMount); lMount != nullptr)
+                {
+                    return lMount->mMountPoint == lMountPoint && lMount->mArchivePath == pRealPath;
+                }
+
+                return false;
+            }
+        );
+    }
+
+    bool VirtualFilesystem::Unmount (
+        const std::string&                          pMountPoint,
+        const std::shared_ptr<VirtualMemoryStore>&  pStore
+    )
+    {
+        const std::string lMountPoint = NormalizePath(pMountPoint);
+        return RemoveMount(
+            [&] (const Mount& pMount)
+            {
+                const auto* lMount = std::get_if<MemoryMount>(&pMount);
+                return lMount != nullptr && lMount->mMountPoint == lMountPoint &&
+                    lMount->mStore == pStore;
+            }
+        );
     }
 
     std::unique_ptr<IVirtualFile> VirtualFilesystem::OpenFile (
@@ -54,7 +99,13 @@ namespace ace
     )
     {
         std::string lLogicalPath = NormalizePath(pLogicalPath);
-        for (auto lIter = sMounts.rbegin(); lIter != sMounts.rend(); ++lIter)
+        const auto lMounts = GetMountState().mMounts.load(std::memory_order_acquire);
+        if (lMounts == nullptr)
+        {
+            return nullptr;
+        }
+
+        for (auto lIter = lMounts->rbegin(); lIter != lMounts->rend(); ++lIter)
         {
             if (auto lFile = AttemptOpen(*lIter, lLogicalPath))
             {
@@ -65,8 +116,131 @@ namespace ace
         return nullptr;
     }
 
+    std::unique_ptr<IVirtualWritableFile> VirtualFilesystem::OpenFileForWriting (
+        const std::string&      pLogicalPath,
+        const FileWriteSpec&    pSpec
+    )
+    {
+        const std::string lLogicalPath = NormalizePath(pLogicalPath);
+        const auto lMounts = GetMountState().mMounts.load(std::memory_order_acquire);
+        if (lMounts == nullptr)
+        {
+            return nullptr;
+        }
+
+        for (auto lIter = lMounts->rbegin(); lIter != lMounts->rend(); ++lIter)
+        {
+            if (const auto* lMount = std::get_if<PhysicalMount>(&*lIter); lMount != nullptr && lMount->mWritable == true)
+            {
+                if (auto lSubpath = MatchMountPoint(lMount->mMountPoint, lLogicalPath))
+                {
+                    try
+                    {
+                        return std::make_unique<VirtualLocalWritableFile>(lMount->mRealPath / *lSubpath, pSpec);
+                    }
+                    catch (...)
+                    {
+                        return nullptr;
+                    }
+                }
+            }
+            else if (const auto* lMount = std::get_if<MemoryMount>(&*lIter); lMount != nullptr)
+            {
+                if (auto lSubpath = MatchMountPoint(lMount->mMountPoint, lLogicalPath))
+                {
+                    return std::make_unique<VirtualMemoryWritableFile>(lMount->mStore, *lSubpath, pSpec);
+                }
+            }
+        }
+
+        return nullptr;
+    }
+
+    bool VirtualFilesystem::RemoveFile (
+        const std::string&  pLogicalPath
+    )
+    {
+        const std::string lLogicalPath = NormalizePath(pLogicalPath);
+        const auto lMounts = GetMountState().mMounts.load(std::memory_order_acquire);
+        if (lMounts == nullptr)
+        {
+            return false;
+        }
+
+        for (auto lIter = lMounts->rbegin(); lIter != lMounts->rend(); ++lIter)
+        {
+            if (const auto* lMount = std::get_if<PhysicalMount>(&*lIter); lMount != nullptr && lMount->mWritable == true)
+            {
+                if (auto lSubpath = MatchMountPoint(lMount->mMountPoint, lLogicalPath))
+                {
+                    std::error_code lError;
+                    return fs::remove(lMount->mRealPath / *lSubpath, lError);
+                }
+            }
+            else if (const auto* lMount = std::get_if<MemoryMount>(&*lIter); lMount != nullptr)
+            {
+                if (auto lSubpath = MatchMountPoint(lMount->mMountPoint, lLogicalPath))
+                {
+                    return lMount->mStore->Remove(*lSubpath);
+                }
+            }
+        }
+
+        return false;
+    }
+
     /* Private Methods ********************************************************/
 
+    VirtualFilesystem::MountState& VirtualFilesystem::GetMountState ()
+    {
+        static MountState* sState = new MountState {};
+        return *sState;
+    }
+
+    void VirtualFilesystem::AddMount (
+        Mount   pMount
+    )
+    {
+        auto& lState = GetMountState();
+        std::lock_guard lGuard { lState.mMutex };
+
+        // Copy the published list, rather than changing it, since lookups may
+        // still be walking it.
+        const auto lCurrent = lState.mMounts.load(std::memory_order_relaxed);
+        auto lMounts = (lCurrent != nullptr) ?
+            std::make_shared<MountList>(*lCurrent) :
+            std::make_shared<MountList>();
+        lMounts->push_back(std::move(pMount));
+        lState.mMounts.store(std::move(lMounts), std::memory_order_release);
+    }
+
+    bool VirtualFilesystem::RemoveMount (
+        const std::function<bool (const Mount&)>&   pMatch
+    )
+    {
+        auto& lState = GetMountState();
+        std::lock_guard lGuard { lState.mMutex };
+
+        const auto lCurrent = lState.mMounts.load(std::memory_order_relaxed);
+        if (lCurrent == nullptr)
+        {
+            return false;
+        }
+
+        const auto lFound = std::find_if(lCurrent->rbegin(), lCurrent->rend(), pMatch);
+        if (lFound == lCurrent->rend())
+        {
+            return false;
+        }
+
+        // As in `AddMount`, lookups walking the old list keep it alive until
+        // they finish.
+        auto lMounts = std::make_shared<MountList>(*lCurrent);
+        lMounts->erase(lMounts->begin() + (std::distance(lFound, lCurrent->rend()) - 1));
+        lState.mMounts.store(std::move(lMounts), std::memory_order_release);
+        return true;
+    }
+
     std::string VirtualFilesystem::NormalizePath (
         const std::string&  pPath
     )
@@ -90,6 +264,41 @@ namespace ace
         return lPath;
     }
 
+    std::optional<std::string> VirtualFilesystem::MatchMountPoint (
+        const std::string&  pMountPoint,
+        const std::string&  pLogicalPath
+    )
+    {
+        if (pLogicalPath.starts_with(pMountPoint) == false)
+        {
+            return std::nullopt;
+        }
+
+        // The mount point must end at a slash, so that `data` does not
+        // cover `database/...`.
+        std::string lSubpath = pLogicalPath.substr(pMountPoint.size());
+        if (pMountPoint.empty() == false && lSubpath.empty() == false)
+        {
+            if (lSubpath[0] != '/')
+            {
+                return std::nullopt;
+            }
+
+            lSubpath.erase(lSubpath.begin());
+        }
+
+        // Nothing may reach outside the mount.
+        for (const fs::path& lPart : fs::path { lSubpath })
+        {
+            if (lPart == "..")
+            {
+                return std::nullopt;
+            }
+        }
+
+        return lSubpath;
+    }
+
     std::unique_ptr<IVirtualFile> VirtualFilesystem::AttemptOpen (
         const Mount&        pMount,
         const std::string&  pLogicalPath
@@ -100,26 +309,15 @@ namespace ace
         return std::visit(
             [&] (const auto& pVisitedMount) -> std::unique_ptr<IVirtualFile>
             {
-                // Get the mount point. Make sure the provided logical path
-                // begins with that substring.
-                const auto& lMountPoint = pVisitedMount.mMountPoint;
-                if (pLogicalPath.starts_with(lMountPoint) == false)
+                // Get the remaining subpath after the mount point, if the mount
+                // point covers the logical path at all.
+                const auto lMatch = MatchMountPoint(pVisitedMount.mMountPoint, pLogicalPath);
+                if (lMatch.has_value() == false)
                 {
                     return nullptr;
                 }
 
-                // Get the remaining subpath after the mount point.
-                std::string lSubpath = pLogicalPath.substr(lMountPoint.size());
-                if (
-                    lSubpath.empty() == false &&
-                    (
-                        lSubpath[0] == '/' ||
-                        lSubpath[0] == '\\'
-                    )
-                )
-                {
-                    lSubpath.erase(lSubpath.begin());
-                }
+                const std::string& lSubpath = *lMatch;
 
                 // Depending on the mount structure's type, open the file.
                 if constexpr
@@ -153,6 +351,14 @@ namespace ace
                         return nullptr;
                     }
                 }
+                else if constexpr
+                    (std::is_same_v<decltype(pVisitedMount), const MemoryMount&>)
+                {
+                    auto lContents = pVisitedMount.mStore->Find(lSubpath);
+                    return (lContents != nullptr) ?
+                        std::make_unique<VirtualMemoryFile>(std::move(lContents)) :
+                        nullptr;
+                }
 
                 return nullptr;
             }, pMount
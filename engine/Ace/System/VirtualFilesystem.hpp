@@ -6,7 +6,9 @@
 
 #pragma once
 #include <Ace/System/VirtualLocalFile.hpp>
+#include <Ace/System/VirtualLocalWritableFile.hpp>
 #include <Ace/System/VirtualArchiveFile.hpp>
+#include <Ace/System/VirtualMemoryFile.hpp>
 
 namespace ace
 {
@@ -14,6 +16,17 @@ namespace ace
     /**
      * @brief   A static class used for mounting directories and opening files
      *          in a virtual filesystem (VFS).
+     *
+     * Files are opened from the most recently mounted mount point which
+     * holds them. Files are opened for writing in the most recently mounted
+     * writable mount point which covers their path, whether or not it holds
+     * them yet; archives are never writable. A mount point covers a path
+     * which is the mount point itself, or continues it after a slash.
+     *
+     * Mounting and unmounting are thread-safe, and never block threads opening
+     * files. The mount list is immutable once published: mounting copies it,
+     * changes the copy, and publishes the copy with one atomic store, while
+     * each lookup walks whichever list was published when it began.
      */
     class ACE_API VirtualFilesystem final
     {
@@ -26,10 +39,12 @@ namespace ace
          * @param   pMountPoint The name of the logical mount point under which 
          *                      given path will be mounted.
          * @param   pRealPath   The actual path to be mounted.
+         * @param   pWritable   Can files be written through this mount?
          */
         static void MountPhysicalDirectory (
             const std::string&  pMountPoint,
-            const fs::path&     pRealPath
+            const fs::path&     pRealPath,
+            const bool          pWritable = false
         );
 
         /**
@@ -45,6 +60,48 @@ namespace ace
             const fs::path&     pArchivePath
         );
 
+        /**
+         * @brief   Mounts an empty, writable, in-memory directory with the
+         *          given logical mount point, for tests and scratch data.
+         *
+         * @param   pMountPoint The name of the logical mount point.
+         *
+         * @return  The store holding the mount's files.
+         */
+        static std::shared_ptr<VirtualMemoryStore> MountMemory (
+            const std::string&  pMountPoint
+        );
+
+        /**
+         * @brief   Unmounts the most recent mount of the given physical
+         *          directory or archive file at the given mount point.
+         *
+         * Files already opened through the mount stay open.
+         *
+         * @param   pMountPoint The logical mount point it was mounted at.
+         * @param   pRealPath   The directory or archive file it mounted.
+         *
+         * @return  `true` if a mount was removed; `false` otherwise.
+         */
+        static bool Unmount (
+            const std::string&  pMountPoint,
+            const fs::path&     pRealPath
+        );
+
+        /**
+         * @brief   Unmounts the most recent mount of the given in-memory store
+         *          at the given mount point.
+         *
+         * @param   pMountPoint The logical mount point it was mounted at.
+         * @param   pStore      The store returned by @a `MountMemory`.
+         *
+         * @return  `true` if a mount was removed; `false` otherwise.
+         */
+        static bool Unmount (
+            const std::string&                          pMountPoint,
+            const std::shared_ptr<VirtualMemoryStore>&  pStore
+        );
+
         /**
          * @brief   Opens a logical file, searching for the file in one of the
          *          mounted directories.
@@ -58,6 +115,34 @@ namespace ace
             const std::string&  pLogicalPath
         );
 
+        /**
+         * @brief   Opens a logical file for writing, in the writable mount
+         *          which covers its path.
+         *
+         * @param   pLogicalPath    The logical path to the file to write.
+         * @param   pSpec           The settings to write it with.
+         *
+         * @return  An `std::unique_ptr` to the opened writable file if a
+         *          writable mount covers the path and the file could be
+         *          opened; `nullptr` otherwise.
+         */
+        static std::unique_ptr<IVirtualWritableFile> OpenFileForWriting (
+            const std::string&      pLogicalPath,
+            const FileWriteSpec&    pSpec = {}
+        );
+
+        /**
+         * @brief   Removes a logical file from the writable mount which
+         *          covers its path.
+         *
+         * @param   pLogicalPath    The logical path to the file to remove.
+         *
+         * @return  `true` if the file was removed; `false` otherwise.
+         */
+        static bool RemoveFile (
+            const std::string&  pLogicalPath
+        );
+
     private:
     
         /**
@@ -68,6 +153,7 @@ namespace ace
         {
             std::string mMountPoint;
             fs::path    mRealPath;
+            bool        mWritable = false;
         };
 
         /**
@@ -81,16 +167,49 @@ namespace ace
             fs::path    mArchivePath;
         };
 
+        /**
+         * @brief   A structure representing an in-memory mount, mapping a
+         *          mount point to the store holding its files.
+         */
+        struct MemoryMount
+        {
+            std::string                         mMountPoint;
+            std::shared_ptr<VirtualMemoryStore> mStore;
+        };
+
         /**
          * @brief   Defines a union representing a mount point.
          */
         using Mount = std::variant<
             PhysicalMount,
-            ArchiveMount
+            ArchiveMount,
+            MemoryMount
         >;
 
+        /**
+         * @brief   Defines an immutable, published list of mounts, in mounting
+         *          order.
+         */
+        using MountList = std::vector<Mount>;
+
+        /**
+         * @brief   A structure holding the published mount list.
+         */
+        struct MountState
+        {
+            std::atomic<std::shared_ptr<const MountList>>   mMounts;    ///< @brief The published list of mounts, or `nullptr` if nothing has been mounted.
+            std::mutex                                      mMutex;     ///< @brief Serializes changes to the mount list; never taken by readers.
+        };
+
     private:
 
+        /**
+         * @brief   Retrieves the mount state. It is never destroyed, since
+         *          objects which unmount when destroyed, such as a
+         *          @a `DerivedDataCache`, may outlive the VFS's statics.
+         */
+        static MountState& GetMountState ();
+
         /**
          * @brief   Normalizes the given path string, removing any trailing
          *          slashes, and converting any remaining backslashes `\\` to
@@ -104,6 +223,21 @@ namespace ace
             const std::string&  pPath
         );
 
+        /**
+         * @brief   Finds the path within a mount of a logical path which the
+         *          mount point covers.
+         *
+         * @param   pMountPoint     The mount point.
+         * @param   pLogicalPath    The normalized logical path.
+         *
+         * @return  The path within the mount, if the mount point covers the
+         *          logical path; `std::nullopt` otherwise.
+         */
+        static std::optional<std::string> MatchMountPoint (
+            const std::string&  pMountPoint,
+            const std::string&  pLogicalPath
+        );
+
         /**
          * @brief   Attempts to open a file in the given mount at the given
          *          logical path.
@@ -119,8 +253,26 @@ namespace ace
             const std::string&  pLogicalPath
         );
 
-    private:
-        static std::vector<Mount> sMounts;      ///< @brief The list of mounts.
+        /**
+         * @brief   Publishes a new mount list with the given mount appended.
+         *
+         * @param   pMount  The mount to add.
+         */
+        static void AddMount (
+            Mount   pMount
+        );
+
+        /**
+         * @brief   Publishes a new mount list without the most recent mount
+         *          matching the given predicate.
+         *
+         * @param   pMatch  Determines whether a mount is the one to remove.
+         *
+         * @return  `true` if a mount was removed; `false` otherwise.
+         */
+        static bool RemoveMount (
+            const std::function<bool (const Mount&)>&   pMatch
+        );
 
     };
 
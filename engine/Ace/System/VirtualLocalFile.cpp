@@ -2,6 +2,13 @@
  * @file    Ace/System/VirtualLocalFile.cpp
  */
 
+#if defined(ACE_LINUX)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 #include <Ace/System/VirtualLocalFile.hpp>
 
 namespace ace
@@ -13,19 +20,54 @@ namespace ace
         const fs::path& pPath
     ) :
         IVirtualFile    {},
+    #if defined(ACE_LINUX)
+        mDescriptor     { ::open(pPath.c_str(), O_RDONLY | O_CLOEXEC) },
+    #endif
         mFileStream     { pPath, std::ios::binary }
     {
-        if (mFileStream.is_open() == false)
+        std::error_code lError;
+        mSize = fs::file_size(pPath, lError);
+        if (mFileStream.is_open() == false || lError != std::error_code {})
         {
+        #if defined(ACE_LINUX)
+            if (mDescriptor >= 0)
+            {
+                ::close(mDescriptor);
+            }
+        #endif
+
             throw std::runtime_error {
                 std::format("VirtualLocalFile: '{}' could not be opened!",
                     pPath.string())
             };
         }
 
-        mSize = fs::file_size(pPath);
         mFileStream.exceptions(std::ios::badbit | std::ios::failbit);
         mFileStream.seekg(0, std::ios::beg);
+
+    #if defined(ACE_LINUX)
+        // The file is mapped through a descriptor opened along with the
+        // stream, since opening it by path again at mapping time could reach
+        // a different file, if this one has since been replaced. Only keep the
+        // descriptor if the path still names the same file, of the same size,
+        // after the stream has been opened, so both refer to one file.
+        if (mDescriptor >= 0)
+        {
+            struct stat lOpened {};
+            struct stat lCurrent {};
+            if (
+                ::fstat(mDescriptor, &lOpened) != 0 ||
+                ::stat(pPath.c_str(), &lCurrent) != 0 ||
+                lOpened.st_dev != lCurrent.st_dev ||
+                lOpened.st_ino != lCurrent.st_ino ||
+                static_cast<std::size_t>(lOpened.st_size) != mSize
+            )
+            {
+                ::close(mDescriptor);
+                mDescriptor = -1;
+            }
+        }
+    #endif
     }
 
     VirtualLocalFile::~VirtualLocalFile ()
@@ -85,12 +127,59 @@ namespace ace
         return mSize;
     }
     
+    std::span<const std::uint8_t> VirtualLocalFile::Map ()
+    {
+    #if defined(ACE_LINUX)
+        if (mMapping == nullptr && mSize > 0 && mDescriptor >= 0)
+        {
+            // A file truncated in place since it was opened would fault when
+            // the missing pages are touched; refuse to map it.
+            struct stat lStat {};
+            if (
+                ::fstat(mDescriptor, &lStat) != 0 ||
+                static_cast<std::size_t>(lStat.st_size) != mSize
+            )
+            {
+                return {};
+            }
+
+            void* lMapping = ::mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, mDescriptor, 0);
+            if (lMapping == MAP_FAILED)
+            {
+                return {};
+            }
+
+            mMapping = lMapping;
+        }
+
+        return (mMapping != nullptr) ?
+            std::span<const std::uint8_t> { static_cast<const std::uint8_t*>(mMapping), mSize } :
+            std::span<const std::uint8_t> {};
+    #else
+        return {};
+    #endif
+    }
+
     void VirtualLocalFile::Close ()
     {
         if (mFileStream.is_open())
         {
             mFileStream.close();
         }
+
+    #if defined(ACE_LINUX)
+        if (mMapping != nullptr)
+        {
+            ::munmap(mMapping, mSize);
+            mMapping = nullptr;
+        }
+
+        if (mDescriptor >= 0)
+        {
+            ::close(mDescriptor);
+            mDescriptor = -1;
+        }
+    #endif
     }
 
 }
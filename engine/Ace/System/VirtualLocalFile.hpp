@@ -51,12 +51,16 @@ namespace ace
         std::size_t Tell () const override;
         
         std::size_t GetSize () const override;
+
+        std::span<const std::uint8_t> Map () override;
         
         void Close () override;
 
     private:
-        mutable std::ifstream   mFileStream;    ///< @brief The file stream at which the file is opened.
-                std::size_t     mSize = 0;      ///< @brief The size of the opened file, in bytes.        
+                int             mDescriptor = -1;   ///< @brief A descriptor for the file the stream has open, for mapping; `-1` if the file cannot be mapped.
+        mutable std::ifstream   mFileStream;        ///< @brief The file stream at which the file is opened.
+                std::size_t     mSize = 0;          ///< @brief The size of the opened file, in bytes.        
+                void*           mMapping = nullptr; ///< @brief The file's contents, once mapped.
 
     };
 
@@ -0,0 +1,316 @@
+/**
+ * @file    Ace/System/VirtualLocalWritableFile.cpp
+ */
+
+#if defined(ACE_LINUX)
+    #include <fcntl.h>
+    #include <unistd.h>
+#elif defined(ACE_WINDOWS)
+    #include <io.h>
+    #include <process.h>
+#endif
+
+#include <cerrno>
+
+#include <Ace/System/VirtualLocalWritableFile.hpp>
+
+namespace ace
+{
+
+    /* Helper Functions *******************************************************/
+
+    /**
+     * @brief   The number of temporary names tried before giving up.
+     */
+    static constexpr std::size_t TEMPORARY_ATTEMPTS = 16;
+
+    /**
+     * @brief   Forms a temporary path beside the given one, unique to this
+     *          process, thread and write.
+     */
+    static fs::path MakeTemporaryPath (
+        const fs::path& pPath
+    )
+    {
+    #if defined(ACE_WINDOWS)
+        const auto lProcess = ::_getpid();
+    #else
+        const auto lProcess = ::getpid();
+    #endif
+
+        static std::atomic<std::uint64_t> sWriteCount { 0 };
+        return fs::path { pPath }.concat(std::format(".{}.{}.{}.tmp", lProcess,
+            std::hash<std::thread::id> {}(std::this_thread::get_id()),
+            sWriteCount.fetch_add(1, std::memory_order_relaxed)));
+    }
+
+    static std::FILE* OpenStream (
+        const fs::path& pPath,
+        const bool      pAppend
+    )
+    {
+    #if defined(ACE_WINDOWS)
+        return ::_wfopen(pPath.c_str(), (pAppend == true) ? L"ab" : L"wb");
+    #else
+        return std::fopen(pPath.c_str(), (pAppend == true) ? "ab" : "wb");
+    #endif
+    }
+
+    /**
+     * @brief   Creates an empty temporary file beside the given one, failing
+     *          rather than reusing a file which already exists, and retrying
+     *          with a fresh name if another writer got there first.
+     *
+     * @return  The temporary file's path, or an empty path if none could be
+     *          created.
+     */
+    static fs::path CreateTemporaryFile (
+        const fs::path& pPath
+    )
+    {
+        for (std::size_t i = 0; i < TEMPORARY_ATTEMPTS; ++i)
+        {
+            const fs::path lPath = MakeTemporaryPath(pPath);
+        #if defined(ACE_WINDOWS)
+            std::FILE* lFile = ::_wfopen(lPath.c_str(), L"wbx");
+        #else
+            std::FILE* lFile = std::fopen(lPath.c_str(), "wbx");
+        #endif
+            if (lFile != nullptr)
+            {
+                std::fclose(lFile);
+                return lPath;
+            }
+            else if (errno != EEXIST)
+            {
+                break;
+            }
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief   Forces a directory's entries out to storage, so that a rename
+     *          within it survives a power loss.
+     */
+    static bool SyncDirectory (
+        const fs::path& pDirectory
+    )
+    {
+    #if defined(ACE_LINUX)
+        const int lDescriptor = ::open(pDirectory.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+        if (lDescriptor < 0)
+        {
+            return false;
+        }
+
+        const bool lSynced = ::fsync(lDescriptor) == 0;
+        ::close(lDescriptor);
+        return lSynced;
+    #else
+        (void) pDirectory;
+        return true;
+    #endif
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    VirtualLocalWritableFile::VirtualLocalWritableFile (
+        const fs::path&         pPath,
+        const FileWriteSpec&    pSpec
+    ) :
+        mPath       { pPath },
+        mWritePath  { pPath },
+        mSpec       { pSpec }
+    {
+        std::error_code lError;
+        if (mPath.has_parent_path() == true)
+        {
+            fs::create_directories(mPath.parent_path(), lError);
+        }
+
+        // The temporary file is created exclusively, so no other writer, in
+        // this process or another, can be handed the same one.
+        if (mSpec.mAtomic == true)
+        {
+            mWritePath = CreateTemporaryFile(mPath);
+            if (mWritePath.empty() == true)
+            {
+                ACE_THROW(std::runtime_error, "{}: No temporary file could be created beside '{}'!",
+                    "VirtualLocalWritableFile", mPath.string());
+            }
+        }
+
+        // An atomic append starts from a copy of the file.
+        if (mSpec.mAtomic == true && mSpec.mAppend == true && fs::is_regular_file(mPath, lError) == true)
+        {
+            fs::copy_file(mPath, mWritePath, fs::copy_options::overwrite_existing, lError);
+            if (lError)
+            {
+                fs::remove(mWritePath, lError);
+                ACE_THROW(std::runtime_error, "{}: '{}' could not be copied to append to!",
+                    "VirtualLocalWritableFile", mPath.string());
+            }
+        }
+
+        mFile = OpenStream(mWritePath, mSpec.mAppend);
+        if (mFile == nullptr)
+        {
+            if (mSpec.mAtomic == true)
+            {
+                fs::remove(mWritePath, lError);
+            }
+
+            ACE_THROW(std::runtime_error, "{}: '{}' could not be opened for writing!",
+                "VirtualLocalWritableFile", mPath.string());
+        }
+
+        // The file is written in whole buffers already, so the stream's own
+        // buffer would only copy everything twice.
+        std::setvbuf(mFile, nullptr, _IONBF, 0);
+        std::fseek(mFile, 0, SEEK_END);
+        mSize = static_cast<std::size_t>(std::ftell(mFile));
+        mBuffer.reserve(mSpec.mBufferSize);
+    }
+
+    VirtualLocalWritableFile::~VirtualLocalWritableFile ()
+    {
+        Discard();
+    }
+
+    /* Public Methods *********************************************************/
+
+    bool VirtualLocalWritableFile::Write (
+        const void*         pBuffer,
+        const std::size_t&  pBytes
+    )
+    {
+        if (pBuffer == nullptr && pBytes != 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Write buffer is null!",
+                "VirtualLocalWritableFile");
+        }
+        else if (mFile == nullptr || mFailed == true)
+        {
+            return false;
+        }
+
+        if (mBuffer.size() + pBytes <= mSpec.mBufferSize)
+        {
+            const auto* lBytes = static_cast<const std::uint8_t*>(pBuffer);
+            mBuffer.insert(mBuffer.end(), lBytes, lBytes + pBytes);
+            mSize += pBytes;
+            return true;
+        }
+
+        // Anything which would not fit in the buffer is written straight
+        // through, after whatever is already buffered. The size grows only
+        // once the bytes are buffered or written.
+        mFailed = FlushBuffer() == false ||
+            std::fwrite(pBuffer, 1, pBytes, mFile) != pBytes;
+        if (mFailed == false)
+        {
+            mSize += pBytes;
+        }
+
+        return mFailed == false;
+    }
+
+    bool VirtualLocalWritableFile::Flush ()
+    {
+        if (mFile == nullptr || FlushBuffer() == false)
+        {
+            return false;
+        }
+
+        return mSpec.mSync != FileSyncPolicy::OnFlush || Sync() == true;
+    }
+
+    std::size_t VirtualLocalWritableFile::Tell () const
+    {
+        return mSize;
+    }
+
+    bool VirtualLocalWritableFile::Commit ()
+    {
+        if (mFile == nullptr)
+        {
+            return false;
+        }
+
+        bool lCommitted = FlushBuffer() == true &&
+            (mSpec.mSync == FileSyncPolicy::None || Sync() == true);
+        lCommitted = (std::fclose(mFile) == 0) && lCommitted;
+        mFile = nullptr;
+        if (mSpec.mAtomic == false)
+        {
+            return lCommitted;
+        }
+
+        // Renaming over the file is atomic, so a concurrent reader sees
+        // either the old file or the new one.
+        std::error_code lError;
+        if (lCommitted == true)
+        {
+            fs::rename(mWritePath, mPath, lError);
+            lCommitted = !lError;
+        }
+
+        if (lCommitted == false)
+        {
+            fs::remove(mWritePath, lError);
+            return false;
+        }
+
+        return mSpec.mSync == FileSyncPolicy::None || mPath.has_parent_path() == false ||
+            SyncDirectory(mPath.parent_path()) == true;
+    }
+
+    void VirtualLocalWritableFile::Discard ()
+    {
+        if (mFile == nullptr)
+        {
+            return;
+        }
+
+        std::fclose(mFile);
+        mFile = nullptr;
+        mBuffer.clear();
+        if (mSpec.mAtomic == true)
+        {
+            std::error_code lError;
+            fs::remove(mWritePath, lError);
+        }
+    }
+
+    /* Private Methods ********************************************************/
+
+    bool VirtualLocalWritableFile::FlushBuffer ()
+    {
+        if (mFailed == false && mBuffer.empty() == false)
+        {
+            mFailed = std::fwrite(mBuffer.data(), 1, mBuffer.size(), mFile) != mBuffer.size();
+            mBuffer.clear();
+        }
+
+        return mFailed == false;
+    }
+
+    bool VirtualLocalWritableFile::Sync ()
+    {
+        if (std::fflush(mFile) != 0)
+        {
+            mFailed = true;
+        }
+
+    #if defined(ACE_LINUX)
+        mFailed = mFailed || ::fsync(::fileno(mFile)) != 0;
+    #elif defined(ACE_WINDOWS)
+        mFailed = mFailed || ::_commit(::_fileno(mFile)) != 0;
+    #endif
+
+        return mFailed == false;
+    }
+
+}
@@ -0,0 +1,90 @@
+/**
+ * @file    Ace/System/VirtualLocalWritableFile.hpp
+ * @brief   Contains a class representing a local file opened for writing to
+ *          disk by the virtual filesystem (VFS).
+ */
+
+#pragma once
+#include <cstdio>
+#include <Ace/System/IVirtualWritableFile.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class representing a local file opened for writing to disk
+     *          by the virtual filesystem (VFS).
+     *
+     * An atomic file is written to a temporary file beside its path, created
+     * exclusively under a name unique to the process, then renamed over it, which the filesystem does in one step. When
+     * syncing, the file is synced before the rename, and its directory after,
+     * so that the rename itself survives a power loss.
+     */
+    class ACE_API VirtualLocalWritableFile final : public IVirtualWritableFile
+    {
+    public:
+
+        /**
+         * @brief   This constructor opens a file on disk for writing at the
+         *          given physical path, creating its directory if necessary.
+         *
+         * @param   pPath   The path to the local file to write.
+         * @param   pSpec   The settings to write it with.
+         *
+         * @throw   `std::runtime_error` if the file could not be opened.
+         */
+        explicit VirtualLocalWritableFile (
+            const fs::path&         pPath,
+            const FileWriteSpec&    pSpec = {}
+        );
+
+        /**
+         * @brief   The destructor discards the file, unless it was committed.
+         */
+        ~VirtualLocalWritableFile () override;
+
+    public:
+
+        bool Write (
+            const void*         pBuffer,
+            const std::size_t&  pBytes
+        ) override;
+
+        bool Flush () override;
+
+        std::size_t Tell () const override;
+
+        bool Commit () override;
+
+        void Discard () override;
+
+    private:
+        VirtualLocalWritableFile (const VirtualLocalWritableFile&) = delete;
+        VirtualLocalWritableFile (VirtualLocalWritableFile&&) = delete;
+        void operator= (const VirtualLocalWritableFile&) = delete;
+        void operator= (VirtualLocalWritableFile&&) = delete;
+
+    private:
+
+        /**
+         * @brief   Hands the buffered bytes to the operating system.
+         */
+        bool FlushBuffer ();
+
+        /**
+         * @brief   Forces the file's data out to storage.
+         */
+        bool Sync ();
+
+    private:
+        fs::path            mPath;                  ///< @brief The path the file is committed to.
+        fs::path            mWritePath;             ///< @brief The path being written; a temporary one, if atomic.
+        FileWriteSpec       mSpec;                  ///< @brief The settings the file is written with.
+        std::FILE*          mFile = nullptr;        ///< @brief The open file, until it is committed or discarded.
+        astd::byte_buffer   mBuffer;                ///< @brief The bytes written, but not yet handed on.
+        std::size_t         mSize = 0;              ///< @brief The size of the written file, in bytes.
+        bool                mFailed = false;        ///< @brief Has a write failed, dooming the commit?
+
+    };
+
+}
@@ -0,0 +1,222 @@
+/**
+ * @file    Ace/System/VirtualMemoryFile.cpp
+ */
+
+#include <Ace/System/VirtualMemoryFile.hpp>
+
+namespace ace
+{
+
+    /* Public Methods *********************************************************/
+
+    VirtualMemoryStore::Contents VirtualMemoryStore::Find (
+        const std::string&  pPath
+    ) const
+    {
+        std::lock_guard lGuard { mMutex };
+        auto lIter = mFiles.find(pPath);
+        return (lIter != mFiles.end()) ? lIter->second : nullptr;
+    }
+
+    void VirtualMemoryStore::Store (
+        const std::string&  pPath,
+        Contents            pContents
+    )
+    {
+        std::lock_guard lGuard { mMutex };
+        mFiles.insert_or_assign(pPath, std::move(pContents));
+    }
+
+    bool VirtualMemoryStore::Remove (
+        const std::string&  pPath
+    )
+    {
+        std::lock_guard lGuard { mMutex };
+        return mFiles.erase(pPath) != 0;
+    }
+
+    std::size_t VirtualMemoryStore::GetFileCount () const
+    {
+        std::lock_guard lGuard { mMutex };
+        return mFiles.size();
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    VirtualMemoryFile::VirtualMemoryFile (
+        VirtualMemoryStore::Contents    pContents
+    ) :
+        IVirtualFile    {},
+        mContents       { std::move(pContents) }
+    {
+        if (mContents == nullptr)
+        {
+            throw std::invalid_argument { "VirtualMemoryFile: Contents are null!" };
+        }
+    }
+
+    /* Public Methods *********************************************************/
+
+    std::size_t VirtualMemoryFile::Read (
+        void*               pBuffer,
+        const std::size_t&  pBytes
+    )
+    {
+        if (pBuffer == nullptr)
+        {
+            throw std::invalid_argument { "Read buffer is null!" };
+        }
+        else if (mContents == nullptr)
+        {
+            return 0;
+        }
+
+        const std::size_t lBytes = std::min(pBytes, mContents->size() - mPosition);
+        std::memcpy(pBuffer, mContents->data() + mPosition, lBytes);
+        mPosition += lBytes;
+        return lBytes;
+    }
+
+    bool VirtualMemoryFile::Seek (
+        const std::size_t&  pOffset,
+        FileSeekPoint       pPoint
+    )
+    {
+        const std::size_t lSize = GetSize();
+        std::size_t lPosition = 0;
+        switch (pPoint)
+        {
+            case FileSeekPoint::Start:      lPosition = pOffset; break;
+            case FileSeekPoint::End:        lPosition = lSize + pOffset; break;
+            case FileSeekPoint::Current:    lPosition = mPosition + pOffset; break;
+        }
+
+        if (lPosition > lSize)
+        {
+            return false;
+        }
+
+        mPosition = lPosition;
+        return true;
+    }
+
+    std::size_t VirtualMemoryFile::Tell () const
+    {
+        return mPosition;
+    }
+
+    std::size_t VirtualMemoryFile::GetSize () const
+    {
+        return (mContents != nullptr) ? mContents->size() : 0;
+    }
+
+    std::span<const std::uint8_t> VirtualMemoryFile::Map ()
+    {
+        return (mContents != nullptr) ?
+            std::span<const std::uint8_t> { *mContents } :
+            std::span<const std::uint8_t> {};
+    }
+
+    void VirtualMemoryFile::Close ()
+    {
+        mContents = nullptr;
+        mPosition = 0;
+    }
+
+    /* Constructors and Destructor ********************************************/
+
+    VirtualMemoryWritableFile::VirtualMemoryWritableFile (
+        std::shared_ptr<VirtualMemoryStore>     pStore,
+        const std::string&                      pPath,
+        const FileWriteSpec&                    pSpec
+    ) :
+        mStore  { std::move(pStore) },
+        mPath   { pPath },
+        mSpec   { pSpec }
+    {
+        if (mStore == nullptr)
+        {
+            throw std::invalid_argument { "VirtualMemoryWritableFile: Store is null!" };
+        }
+
+        if (mSpec.mAppend == true)
+        {
+            if (const auto lContents = mStore->Find(mPath))
+            {
+                mData = *lContents;
+            }
+        }
+
+        // Like a file on disk, one written in place is truncated on opening.
+        if (mSpec.mAtomic == false)
+        {
+            Flush();
+        }
+    }
+
+    VirtualMemoryWritableFile::~VirtualMemoryWritableFile ()
+    {
+        Discard();
+    }
+
+    /* Public Methods *********************************************************/
+
+    bool VirtualMemoryWritableFile::Write (
+        const void*         pBuffer,
+        const std::size_t&  pBytes
+    )
+    {
+        if (pBuffer == nullptr && pBytes != 0)
+        {
+            ACE_THROW(std::invalid_argument, "{}: Write buffer is null!",
+                "VirtualMemoryWritableFile");
+        }
+        else if (mStore == nullptr)
+        {
+            return false;
+        }
+
+        const auto* lBytes = static_cast<const std::uint8_t*>(pBuffer);
+        mData.insert(mData.end(), lBytes, lBytes + pBytes);
+        return true;
+    }
+
+    bool VirtualMemoryWritableFile::Flush ()
+    {
+        if (mStore == nullptr)
+        {
+            return false;
+        }
+        else if (mSpec.mAtomic == false)
+        {
+            mStore->Store(mPath, std::make_shared<const astd::byte_buffer>(mData));
+        }
+
+        return true;
+    }
+
+    std::size_t VirtualMemoryWritableFile::Tell () const
+    {
+        return mData.size();
+    }
+
+    bool VirtualMemoryWritableFile::Commit ()
+    {
+        if (mStore == nullptr)
+        {
+            return false;
+        }
+
+        mStore->Store(mPath, std::make_shared<const astd::byte_buffer>(std::move(mData)));
+        mStore = nullptr;
+        mData = {};
+        return true;
+    }
+
+    void VirtualMemoryWritableFile::Discard ()
+    {
+        mStore = nullptr;
+        mData = {};
+    }
+
+}
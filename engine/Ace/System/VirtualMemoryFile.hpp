@@ -0,0 +1,179 @@
+/**
+ * @file    Ace/System/VirtualMemoryFile.hpp
+ * @brief   Contains classes representing files kept in memory by the virtual
+ *          filesystem (VFS), for tests and scratch data.
+ */
+
+#pragma once
+#include <Ace/System/IVirtualFile.hpp>
+#include <Ace/System/IVirtualWritableFile.hpp>
+
+namespace ace
+{
+
+    /**
+     * @brief   A class holding the files of an in-memory mount, by their path
+     *          within it.
+     *
+     * Each file's contents are immutable once stored; writing a file stores
+     * new contents in its place, so files already open for reading keep the
+     * contents they were opened with.
+     *
+     * All methods may be called from any thread.
+     */
+    class ACE_API VirtualMemoryStore final
+    {
+    public:
+
+        using Contents = std::shared_ptr<const astd::byte_buffer>;
+
+    public:
+
+        /**
+         * @brief   Retrieves a file's contents.
+         *
+         * @param   pPath   The file's path within the mount.
+         *
+         * @return  The file's contents, or `nullptr` if there is no such file.
+         */
+        Contents Find (
+            const std::string&  pPath
+        ) const;
+
+        /**
+         * @brief   Stores a file's contents, replacing any it had.
+         *
+         * @param   pPath       The file's path within the mount.
+         * @param   pContents   The file's new contents.
+         */
+        void Store (
+            const std::string&  pPath,
+            Contents            pContents
+        );
+
+        /**
+         * @brief   Removes a file.
+         *
+         * @param   pPath   The file's path within the mount.
+         *
+         * @return  `true` if the file existed; `false` otherwise.
+         */
+        bool Remove (
+            const std::string&  pPath
+        );
+
+        /**
+         * @brief   Retrieves the number of files held.
+         *
+         * @return  The number of files.
+         */
+        std::size_t GetFileCount () const;
+
+    private:
+        mutable std::mutex                              mMutex;     ///< @brief Guards the files.
+        std::unordered_map<std::string, Contents>       mFiles;     ///< @brief Every file's contents, by path.
+
+    };
+
+    /**
+     * @brief   A class representing a file read from an in-memory mount by the
+     *          virtual filesystem (VFS).
+     */
+    class ACE_API VirtualMemoryFile final : public IVirtualFile
+    {
+    public:
+
+        /**
+         * @brief   This constructor opens the given contents for reading.
+         *
+         * @param   pContents   The file's contents.
+         *
+         * @throw   `std::invalid_argument` if `pContents` is `nullptr`.
+         */
+        explicit VirtualMemoryFile (
+            VirtualMemoryStore::Contents    pContents
+        );
+
+    public:
+
+        std::size_t Read (
+            void*               pBuffer,
+            const std::size_t&  pBytes = (std::size_t) -1
+        ) override;
+
+        bool Seek (
+            const std::size_t&  pOffset,
+            FileSeekPoint       pPoint = FileSeekPoint::Start
+        ) override;
+
+        std::size_t Tell () const override;
+
+        std::size_t GetSize () const override;
+
+        std::span<const std::uint8_t> Map () override;
+
+        void Close () override;
+
+    private:
+        VirtualMemoryStore::Contents    mContents;          ///< @brief The file's contents, until it is closed.
+        std::size_t                     mPosition = 0;      ///< @brief The current position of the read cursor, in bytes.
+
+    };
+
+    /**
+     * @brief   A class representing a file written to an in-memory mount by
+     *          the virtual filesystem (VFS).
+     *
+     * Writes gather in the file itself, so the buffer size and sync policy
+     * have no effect. An atomic file stores its contents on commit; any other
+     * stores them on every flush, too.
+     */
+    class ACE_API VirtualMemoryWritableFile final : public IVirtualWritableFile
+    {
+    public:
+
+        /**
+         * @brief   This constructor opens a file in the given store for
+         *          writing.
+         *
+         * @param   pStore  The store to write the file to.
+         * @param   pPath   The file's path within the store.
+         * @param   pSpec   The settings to write it with.
+         *
+         * @throw   `std::invalid_argument` if `pStore` is `nullptr`.
+         */
+        VirtualMemoryWritableFile (
+            std::shared_ptr<VirtualMemoryStore>     pStore,
+            const std::string&                      pPath,
+            const FileWriteSpec&                    pSpec = {}
+        );
+
+        /**
+         * @brief   The destructor discards the file, unless it was committed.
+         */
+        ~VirtualMemoryWritableFile () override;
+
+    public:
+
+        bool Write (
+            const void*         pBuffer,
+            const std::size_t&  pBytes
+        ) override;
+
+        bool Flush () override;
+
+        std::size_t Tell () const override;
+
+        bool Commit () override;
+
+        void Discard () override;
+
+    private:
+        std::shared_ptr<VirtualMemoryStore>     mStore;             ///< @brief The store the file is written to, until it is committed or discarded.
+        std::string                             mPath;              ///< @brief The file's path within the store.
+        FileWriteSpec                           mSpec;              ///< @brief The settings the file is written with.
+        astd::byte_buffer                       mData;              ///< @brief The file's contents so far.
+
+    };
+
+}
@@ -0,0 +1,195 @@
+/**
+ * @file    Benchmarks/BenchAnimation.cpp
+ */
+
+#include <iostream>
+#include <numbers>
+#include <Benchmarks/BenchAnimation.hpp>
+
+namespace AceAnimation
+{
+    static constexpr std::size_t JOINT_COUNT = 64;
+    static constexpr std::size_t FRAME_COUNT = 90;
+    static constexpr std::size_t CLIP_COUNT = 4;
+    static constexpr std::size_t CHARACTER_COUNT = 2'000;
+    static constexpr std::size_t EVALUATION_COUNT = 10;
+
+    /**
+     * @brief   Builds a skeleton shaped like a tree, each joint hanging off
+     *          one of the joints before it.
+     */
+    static ace::Skeleton BuildSkeleton ()
+    {
+        ace::Skeleton lSkeleton;
+        lSkeleton.mParents.resize(JOINT_COUNT);
+        lSkeleton.mBindPose.Resize(JOINT_COUNT);
+        for (std::size_t j = 0; j < JOINT_COUNT; ++j)
+        {
+            lSkeleton.mParents[j] = (j == 0) ? -1 : static_cast<std::int32_t>((j - 1) / 3);
+            lSkeleton.mBindPose.SetJoint(j, { 0.0f, (j == 0) ? 0.0f : 0.25f, 0.0f }, {});
+        }
+
+        return lSkeleton;
+    }
+
+    /**
+     * @brief   Builds a looping clip in which most joints swing back and forth
+     *          and the root walks forward; every fourth joint, like the tips
+     *          of fingers, holds still.
+     */
+    static ace::RawAnimationClip BuildRawClip (
+        const std::size_t   pVariant
+    )
+    {
+        ace::RawAnimationClip lRaw {
+            .mFrameRate = 30.0f,
+            .mJointCount = JOINT_COUNT,
+            .mFrameCount = FRAME_COUNT
+        };
+
+        const float lPhase = float(pVariant) * 0.7f;
+        for (std::size_t f = 0; f < FRAME_COUNT; ++f)
+        {
+            const float lCycle = 2.0f * std::numbers::pi_v<float> * float(f) / float(FRAME_COUNT - 1);
+            for (std::size_t j = 0; j < JOINT_COUNT; ++j)
+            {
+                const bool lStill = (j % 4 == 3);
+                const float lSwing = lStill ? 0.3f : 0.6f * std::sin(lCycle + lPhase + float(j) * 0.4f);
+                const ace::Vector3f lAxis = ace::Vector3f { 1.0f, float(j % 3), float(pVariant) }.Normalized();
+
+                lRaw.mRotations.push_back({ lAxis, lSwing });
+                lRaw.mScales.push_back({ 1.0f, 1.0f, 1.0f });
+                lRaw.mTranslations.push_back((j == 0) ?
+                    ace::Vector3f { 0.0f, 0.05f * std::sin(2.0f * lCycle), float(f) * 0.04f } :
+                    ace::Vector3f { 0.0f, 0.25f, 0.0f });
+            }
+        }
+
+        return lRaw;
+    }
+
+    bool BenchClipCompression ()
+    {
+        // Compress a clip, then check every frame decodes close to the keys
+        // it was made from.
+        const ace::RawAnimationClip lRaw = BuildRawClip(1);
+        const auto lStart = std::chrono::steady_clock::now();
+        const ace::AnimationClip lClip { lRaw };
+        const std::chrono::duration<double, std::milli> lCompressTime = std::chrono::steady_clock::now() - lStart;
+
+        float lMaxRotationError = 0.0f;
+        float lMaxTranslationError = 0.0f;
+        ace::LocalPose lPose;
+        for (std::size_t f = 0; f + 1 < FRAME_COUNT; ++f)
+        {
+            lClip.Sample(float(f) / lRaw.mFrameRate, lPose);
+            for (std::size_t j = 0; j < JOINT_COUNT; ++j)
+            {
+                const std::size_t lKey = f * JOINT_COUNT + j;
+                const float lDot = std::abs(ace::Dot(lPose.GetRotation(j), lRaw.mRotations[lKey]));
+                lMaxRotationError = std::max(lMaxRotationError, 2.0f * std::acos(std::min(lDot, 1.0f)));
+                lMaxTranslationError = std::max(lMaxTranslationError,
+                    (lPose.GetTranslation(j) - lRaw.mTranslations[lKey]).Length());
+            }
+        }
+
+        const double lRatio = double(ace::AnimationClip::GetRawMemorySize(lRaw)) / double(lClip.GetMemorySize());
+        if (lRatio < 4.0 || lMaxRotationError > 0.01f || lMaxTranslationError > 1e-3f)
+        {
+            std::cerr << std::format("Clip compression: ratio {:.1f}, rotation error {} rad, "
+                "translation error {}.\n", lRatio, lMaxRotationError, lMaxTranslationError);
+            return false;
+        }
+
+        std::cout << std::format(
+            "Clip compression: {} joints x {} frames, {} animated tracks, {} -> {} bytes ({:.1f}x) in "
+            "{:.2f} ms. Max error {:.4f} rad, {:.6f} units.\n",
+            JOINT_COUNT, FRAME_COUNT, lClip.GetAnimatedTrackCount(),
+            ace::AnimationClip::GetRawMemorySize(lRaw), lClip.GetMemorySize(), lRatio,
+            lCompressTime.count(), lMaxRotationError, lMaxTranslationError
+        );
+
+        return true;
+    }
+
+    bool BenchCrowdEvaluation ()
+    {
+        // A crowd of characters, each blending two of a handful of clips at
+        // its own time and weights, is evaluated on the calling thread and
+        // on a pool; both must agree to the bit.
+        const ace::Skeleton lSkeleton = BuildSkeleton();
+        std::vector<ace::AnimationClip> lClips;
+        for (std::size_t i = 0; i < CLIP_COUNT; ++i)
+        {
+            lClips.emplace_back(BuildRawClip(i));
+        }
+
+        std::vector<ace::AnimatedCharacter> lSerial(CHARACTER_COUNT);
+        for (std::size_t i = 0; i < CHARACTER_COUNT; ++i)
+        {
+            ace::AnimatedCharacter& lCharacter = lSerial[i];
+            lCharacter.mSkeleton = &lSkeleton;
+            lCharacter.mLayerCount = (i % 50 == 0) ? 0 : 2;
+            lCharacter.mLayers[0] = { &lClips[i % CLIP_COUNT], float(i) * 0.013f, 0.75f };
+            lCharacter.mLayers[1] = { &lClips[(i + 1) % CLIP_COUNT], float(i) * 0.029f, 0.25f };
+        }
+
+        std::vector<ace::AnimatedCharacter> lPooled = lSerial;
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+        const ace::Animator lSerialAnimator;
+        const ace::Animator lPooledAnimator { { .mThreadPool = &lPool } };
+
+        std::chrono::duration<double, std::milli> lSerialTime {};
+        std::chrono::duration<double, std::milli> lPooledTime {};
+        for (std::size_t e = 0; e < EVALUATION_COUNT; ++e)
+        {
+            for (std::size_t i = 0; i < CHARACTER_COUNT; ++i)
+            {
+                for (std::size_t l = 0; l < 2; ++l)
+                {
+                    lSerial[i].mLayers[l].mTime += 1.0f / 60.0f;
+                    lPooled[i].mLayers[l].mTime = lSerial[i].mLayers[l].mTime;
+                }
+            }
+
+            auto lStart = std::chrono::steady_clock::now();
+            lSerialAnimator.Evaluate(lSerial);
+            lSerialTime += std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            lPooledAnimator.Evaluate(lPooled);
+            lPooledTime += std::chrono::steady_clock::now() - lStart;
+        }
+
+        for (std::size_t i = 0; i < CHARACTER_COUNT; ++i)
+        {
+            if (
+                lSerial[i].mModelMatrices.size() != JOINT_COUNT ||
+                std::memcmp(lSerial[i].mModelMatrices.data(), lPooled[i].mModelMatrices.data(),
+                    JOINT_COUNT * sizeof(ace::Matrix4f)) != 0
+            )
+            {
+                std::cerr << "Crowd evaluation: Character " << i << " differs between serial and pooled runs.\n";
+                return false;
+            }
+        }
+
+        // A character in its bind pose has its joints stacked straight up.
+        const ace::Matrix4f& lTip = lSerial[0].mModelMatrices[JOINT_COUNT - 1];
+        if (ace::EpsilonEqual(lTip.mI[13], 0.25f * 4.0f, 1e-5f) == false)
+        {
+            std::cerr << "Crowd evaluation: The bind pose was not evaluated correctly.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "Crowd evaluation: {} characters x {} joints, 2 layers each. Serial: {:.2f} ms; "
+            "{} workers: {:.2f} ms ({:.2f}x).\n",
+            CHARACTER_COUNT, JOINT_COUNT, lSerialTime.count() / EVALUATION_COUNT,
+            lPool.GetThreadCount(), lPooledTime.count() / EVALUATION_COUNT,
+            lSerialTime.count() / lPooledTime.count()
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * @file    Benchmarks/BenchAnimation.hpp
+ */
+
+#pragma once
+#include <Ace/Animation/AnimationClip.hpp>
+#include <Ace/Animation/AnimationPose.hpp>
+#include <Ace/Animation/Animator.hpp>
+
+namespace AceAnimation
+{
+    bool BenchClipCompression ();
+    bool BenchCrowdEvaluation ();
+}
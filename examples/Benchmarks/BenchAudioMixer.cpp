@@ -0,0 +1,76 @@
+/**
+ * @file    Benchmarks/BenchAudioMixer.cpp
+ */
+
+#include <iostream>
+#include <numbers>
+#include <Benchmarks/BenchAudioMixer.hpp>
+
+namespace AceAudioMixer
+{
+    static constexpr std::size_t VOICE_COUNT = 256;
+    static constexpr std::size_t BLOCK_COUNT = 1000;
+
+    bool BenchMixVoices ()
+    {
+        // One second of a 440 Hz tone, at a different rate than the mixer's
+        // so that every voice is resampled.
+        auto lClip = std::make_shared<ace::AudioClip>();
+        lClip->mSampleRate = 44100;
+        lClip->mChannelCount = 1;
+        lClip->mSamples.resize(44100);
+        for (std::size_t i = 0; i < lClip->mSamples.size(); ++i)
+        {
+            lClip->mSamples[i] = 0.5f * std::sin(
+                2.0f * std::numbers::pi_v<float> * 440.0f * i / 44100.0f);
+        }
+
+        ace::AudioMixer lMixer {};
+        ace::AssetHandle<ace::AudioClip> lHandle { lClip };
+        for (std::size_t i = 0; i < VOICE_COUNT; ++i)
+        {
+            ace::VoiceParams lParams;
+            lParams.mGain = 1.0f / VOICE_COUNT;
+            lParams.mPan = -1.0f + 2.0f * i / (VOICE_COUNT - 1);
+            lParams.mPitch = 0.5f + 1.5f * i / VOICE_COUNT;
+            lParams.mLooping = true;
+            if (lMixer.Play(lHandle, lParams) == 0)
+            {
+                std::cerr << "Could not play voice " << i << ".\n";
+                return false;
+            }
+        }
+
+        // Render offline to a `.wav` file, timing each block's mix.
+        fs::path lPath = fs::temp_directory_path() / "AceBenchAudioMixer.wav";
+        ace::WaveFileSink lSink { lPath, lMixer.GetSpec().mSampleRate };
+
+        std::chrono::nanoseconds lTotal { 0 };
+        std::chrono::nanoseconds lWorst { 0 };
+        for (std::size_t i = 0; i < BLOCK_COUNT; ++i)
+        {
+            lMixer.Render(lSink, 1);
+            lTotal += lMixer.GetLastMixDuration();
+            lWorst = std::max(lWorst, lMixer.GetLastMixDuration());
+        }
+
+        lSink.Close();
+
+        if (lMixer.GetActiveVoiceCount() != VOICE_COUNT)
+        {
+            std::cerr << "Expected " << VOICE_COUNT << " active voices; got "
+                << lMixer.GetActiveVoiceCount() << ".\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "AudioMixer: {} voices, {}-frame blocks: {:.3f} ms average, "
+            "{:.3f} ms worst per block. Output written to '{}'.\n",
+            VOICE_COUNT, lMixer.GetSpec().mBlockFrames,
+            lTotal.count() / 1.0e6 / BLOCK_COUNT, lWorst.count() / 1.0e6,
+            lPath.string()
+        );
+
+        return lSink.GetFrameCount() == BLOCK_COUNT * lMixer.GetSpec().mBlockFrames;
+    }
+}
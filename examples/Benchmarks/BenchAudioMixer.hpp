@@ -0,0 +1,12 @@
+/**
+ * @file    Benchmarks/BenchAudioMixer.hpp
+ */
+
+#pragma once
+#include <Ace/Audio/AudioMixer.hpp>
+#include <Ace/Audio/WaveFileSink.hpp>
+
+namespace AceAudioMixer
+{
+    bool BenchMixVoices ();
+}
@@ -0,0 +1,336 @@
+/**
+ * @file    Benchmarks/BenchContainers.cpp
+ */
+
+#include <iostream>
+#include <map>
+#include <Benchmarks/BenchContainers.hpp>
+
+namespace AceContainers
+{
+    static constexpr std::size_t THREAD_COUNT = 4;
+    static constexpr std::size_t APPEND_COUNT = 250'000;
+    static constexpr std::size_t SLOT_COUNT = 64;
+    static constexpr std::size_t CYCLE_COUNT = 250'000;
+    static constexpr std::size_t KEY_COUNT = 100'000;
+    static constexpr std::size_t CHURN_KEY_COUNT = 1024;
+    static constexpr std::size_t CHURN_COUNT = 200'000;
+    static constexpr std::size_t GUARD_COUNT = 10'000'000;
+
+    /**
+     * @brief   Runs a function on several threads at once, returning the time
+     *          taken in milliseconds.
+     */
+    template <typename Fn>
+    static double RunThreads (
+        Fn&&    pFunction
+    )
+    {
+        std::vector<std::thread> lThreads;
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < THREAD_COUNT; ++i)
+        {
+            lThreads.emplace_back(pFunction, i);
+        }
+
+        for (auto& lThread : lThreads)
+        {
+            lThread.join();
+        }
+
+        return std::chrono::duration<double, std::milli> {
+            std::chrono::steady_clock::now() - lStart }.count();
+    }
+
+    bool BenchConcurrentVector ()
+    {
+        // Several threads append at once, while their elements stay where
+        // they were put.
+        ace::ConcurrentVector<std::uint64_t> lVector;
+        std::vector<std::vector<const std::uint64_t*>> lAddresses(THREAD_COUNT);
+        const double lLockFree = RunThreads(
+            [&] (std::size_t pThread)
+            {
+                lAddresses[pThread].reserve(APPEND_COUNT);
+                for (std::size_t i = 0; i < APPEND_COUNT; ++i)
+                {
+                    const std::size_t lIndex = lVector.PushBack(pThread * APPEND_COUNT + i);
+                    lAddresses[pThread].push_back(&lVector[lIndex]);
+                }
+            }
+        );
+
+        std::mutex lMutex;
+        std::vector<std::uint64_t> lLocked;
+        const double lMutexed = RunThreads(
+            [&] (std::size_t pThread)
+            {
+                for (std::size_t i = 0; i < APPEND_COUNT; ++i)
+                {
+                    std::lock_guard lGuard { lMutex };
+                    lLocked.push_back(pThread * APPEND_COUNT + i);
+                }
+            }
+        );
+
+        if (lVector.GetSize() != THREAD_COUNT * APPEND_COUNT)
+        {
+            std::cerr << "ConcurrentVector: Size is " << lVector.GetSize() << ".\n";
+            return false;
+        }
+
+        for (std::size_t lThread = 0; lThread < THREAD_COUNT; ++lThread)
+        {
+            for (std::size_t i = 0; i < APPEND_COUNT; ++i)
+            {
+                if (*lAddresses[lThread][i] != lThread * APPEND_COUNT + i)
+                {
+                    std::cerr << "ConcurrentVector: An element moved or was overwritten.\n";
+                    return false;
+                }
+            }
+        }
+
+        std::cout << std::format(
+            "ConcurrentVector: {} appends on {} threads in {:.2f} ms; {:.2f} ms with a mutex.\n",
+            THREAD_COUNT * APPEND_COUNT, THREAD_COUNT, lLockFree, lMutexed
+        );
+
+        return true;
+    }
+
+    bool BenchConcurrentFreeList ()
+    {
+        // Threads borrow and return slots over and over, each marking its
+        // slot while it holds it, so that a slot handed out twice is caught.
+        ace::ConcurrentFreeList lFreeList { SLOT_COUNT };
+        std::vector<std::atomic<std::size_t>> lOwners(SLOT_COUNT);
+        std::atomic<bool> lDoubleLent { false };
+        const double lLockFree = RunThreads(
+            [&] (std::size_t pThread)
+            {
+                for (std::size_t i = 0; i < CYCLE_COUNT; ++i)
+                {
+                    const std::uint32_t lSlot = lFreeList.Pop();
+                    if (lSlot == ace::ConcurrentFreeList::NONE)
+                    {
+                        continue;
+                    }
+
+                    if (lOwners[lSlot].exchange(pThread + 1) != 0)
+                    {
+                        lDoubleLent = true;
+                    }
+
+                    lOwners[lSlot].store(0);
+                    lFreeList.Push(lSlot);
+                }
+            }
+        );
+
+        std::mutex lMutex;
+        std::vector<std::uint32_t> lFree(SLOT_COUNT);
+        std::iota(lFree.begin(), lFree.end(), 0);
+        const double lMutexed = RunThreads(
+            [&] (std::size_t)
+            {
+                for (std::size_t i = 0; i < CYCLE_COUNT; ++i)
+                {
+                    std::uint32_t lSlot = 0;
+                    {
+                        std::lock_guard lGuard { lMutex };
+                        lSlot = lFree.back();
+                        lFree.pop_back();
+                    }
+
+                    std::lock_guard lGuard { lMutex };
+                    lFree.push_back(lSlot);
+                }
+            }
+        );
+
+        if (lDoubleLent == true || lFreeList.GetFreeCount() != SLOT_COUNT)
+        {
+            std::cerr << "ConcurrentFreeList: A slot was lent twice, or lost.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "ConcurrentFreeList: {} pop/push pairs on {} threads in {:.2f} ms; "
+            "{:.2f} ms with a mutex.\n",
+            THREAD_COUNT * CYCLE_COUNT, THREAD_COUNT, lLockFree, lMutexed
+        );
+
+        return true;
+    }
+
+    bool BenchConcurrentSkipList ()
+    {
+        // Threads insert interleaved keys, then look up every key, including
+        // each other's.
+        ace::ConcurrentSkipList<std::uint64_t, std::uint64_t> lMap;
+        std::atomic<bool> lMissing { false };
+        const double lLockFree = RunThreads(
+            [&] (std::size_t pThread)
+            {
+                for (std::size_t i = pThread; i < KEY_COUNT; i += THREAD_COUNT)
+                {
+                    lMap.Insert(i * 7919 % KEY_COUNT, i);
+                }
+
+                for (std::size_t i = 0; i < KEY_COUNT; i += THREAD_COUNT)
+                {
+                    const std::uint64_t* lValue = lMap.Find(i * 7919 % KEY_COUNT);
+                    if (lValue != nullptr && *lValue != i)
+                    {
+                        lMissing = true;
+                    }
+                }
+            }
+        );
+
+        std::mutex lMutex;
+        std::map<std::uint64_t, std::uint64_t> lLocked;
+        const double lMutexed = RunThreads(
+            [&] (std::size_t pThread)
+            {
+                for (std::size_t i = pThread; i < KEY_COUNT; i += THREAD_COUNT)
+                {
+                    std::lock_guard lGuard { lMutex };
+                    lLocked.emplace(i * 7919 % KEY_COUNT, i);
+                }
+
+                for (std::size_t i = 0; i < KEY_COUNT; i += THREAD_COUNT)
+                {
+                    std::lock_guard lGuard { lMutex };
+                    lLocked.find(i * 7919 % KEY_COUNT);
+                }
+            }
+        );
+
+        // Every key is present, once, in order.
+        std::uint64_t lExpected = 0;
+        lMap.ForEach(
+            [&] (const std::uint64_t& pKey, std::uint64_t&)
+            {
+                if (pKey != lExpected++)
+                {
+                    lMissing = true;
+                }
+            }
+        );
+
+        if (lMissing == true || lExpected != KEY_COUNT || lMap.GetCount() != KEY_COUNT ||
+            lMap.Insert(0, 1) == true)
+        {
+            std::cerr << "ConcurrentSkipList: Keys are missing, duplicated or out of order.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "ConcurrentSkipList: {} inserts and {} finds on {} threads in {:.2f} ms; "
+            "{:.2f} ms with a mutex and std::map.\n",
+            KEY_COUNT, KEY_COUNT, THREAD_COUNT, lLockFree, lMutexed
+        );
+
+        return true;
+    }
+
+    /**
+     * @brief   A value which counts its live instances, so that leaks and
+     *          double frees show up.
+     */
+    struct Tracked
+    {
+        static inline std::atomic<std::int64_t> sLive { 0 };
+
+        std::uint64_t mValue = 0;
+
+        explicit Tracked (std::uint64_t pValue) : mValue { pValue } { sLive.fetch_add(1); }
+        Tracked (const Tracked& pOther) : mValue { pOther.mValue } { sLive.fetch_add(1); }
+        ~Tracked () { mValue = 0xDEADDEADDEADDEADull; sLive.fetch_sub(1); }
+    };
+
+    bool BenchEpochReclamation ()
+    {
+        // Threads insert, erase and look up a small set of keys at once, so
+        // that nodes are erased while other threads are reading them.
+        std::atomic<bool> lCorrupt { false };
+        std::atomic<std::size_t> lErased { 0 };
+        double lChurn = 0.0;
+        {
+            ace::ConcurrentSkipList<std::uint64_t, Tracked> lMap;
+            lChurn = RunThreads(
+                [&] (std::size_t pThread)
+                {
+                    std::mt19937_64 lRandom { 90 + pThread };
+                    for (std::size_t i = 0; i < CHURN_COUNT; ++i)
+                    {
+                        const std::uint64_t lKey = lRandom() % CHURN_KEY_COUNT;
+                        switch (lRandom() % 3)
+                        {
+                            case 0:
+                                lMap.TryEmplace(lKey, lKey * 3);
+                                break;
+                            case 1:
+                                lErased += (lMap.Erase(lKey) == true) ? 1 : 0;
+                                break;
+                            default:
+                            {
+                                ace::EpochGuard lGuard;
+                                const Tracked* lValue = lMap.Find(lKey);
+                                if (lValue != nullptr && lValue->mValue != lKey * 3)
+                                {
+                                    lCorrupt = true;
+                                }
+                                break;
+                            }
+                        }
+
+                        if (i % 64 == 0)
+                        {
+                            ace::EpochReclaimer::Quiesce();
+                        }
+                    }
+                }
+            );
+
+            std::size_t lWalked = 0;
+            lMap.ForEach([&] (const std::uint64_t&, const Tracked&) { ++lWalked; });
+            if (lWalked != lMap.GetCount())
+            {
+                std::cerr << "EpochReclaimer: The map holds " << lWalked << " entries; it counts "
+                    << lMap.GetCount() << ".\n";
+                return false;
+            }
+        }
+
+        // Once every thread has moved on, everything retired is freed.
+        const std::size_t lPending = ace::EpochReclaimer::GetPendingCount();
+        ace::EpochReclaimer::Synchronize();
+        if (lCorrupt == true || ace::EpochReclaimer::GetPendingCount() != 0 || Tracked::sLive.load() != 0)
+        {
+            std::cerr << "EpochReclaimer: A value was read after being freed, or "
+                << Tracked::sLive.load() << " values leaked.\n";
+            return false;
+        }
+
+        // The cost of a guard, to a reader.
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < GUARD_COUNT; ++i)
+        {
+            ace::EpochGuard lGuard;
+        }
+        const double lGuardNs = std::chrono::duration<double, std::nano> {
+            std::chrono::steady_clock::now() - lStart }.count() / GUARD_COUNT;
+
+        std::cout << std::format(
+            "EpochReclaimer: {} mixed operations on {} threads in {:.2f} ms, {} erases, {} still "
+            "pending at the end, all freed by epoch {}; {:.1f} ns per guard.\n",
+            THREAD_COUNT * CHURN_COUNT, THREAD_COUNT, lChurn, lErased.load(), lPending,
+            ace::EpochReclaimer::GetEpoch(), lGuardNs
+        );
+
+        return true;
+    }
+}
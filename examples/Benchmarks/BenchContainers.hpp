@@ -0,0 +1,17 @@
+/**
+ * @file    Benchmarks/BenchContainers.hpp
+ */
+
+#pragma once
+#include <Ace/System/ConcurrentFreeList.hpp>
+#include <Ace/System/ConcurrentSkipList.hpp>
+#include <Ace/System/ConcurrentVector.hpp>
+#include <Ace/System/EpochReclaimer.hpp>
+
+namespace AceContainers
+{
+    bool BenchConcurrentVector ();
+    bool BenchConcurrentFreeList ();
+    bool BenchConcurrentSkipList ();
+    bool BenchEpochReclamation ();
+}
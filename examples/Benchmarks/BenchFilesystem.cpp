@@ -0,0 +1,305 @@
+/**
+ * @file    Benchmarks/BenchFilesystem.cpp
+ */
+
+#include <iostream>
+#include <Benchmarks/BenchFilesystem.hpp>
+
+namespace AceFilesystem
+{
+    static constexpr std::size_t RECORD_COUNT = 200000;
+    static constexpr std::size_t RECORD_SIZE = 32;
+    static constexpr std::size_t SYNC_FILE_COUNT = 32;
+    static constexpr std::size_t SYNC_FILE_SIZE = 16 * 1024;
+    static constexpr std::size_t WRITER_COUNT = 4;
+    static constexpr std::size_t COMMITS_PER_WRITER = 200;
+    static constexpr std::size_t REPLACED_SIZE = 64 * 1024;
+
+    /**
+     * @brief   Reads the whole of a logical file, or nothing if it does not
+     *          exist.
+     */
+    static astd::byte_buffer ReadAll (
+        const std::string&  pLogicalPath
+    )
+    {
+        auto lFile = ace::VFS::OpenFile(pLogicalPath);
+        astd::byte_buffer lData((lFile != nullptr) ? lFile->GetSize() : 0);
+        if (lData.empty() == false && lFile->Read(lData.data(), lData.size()) != lData.size())
+        {
+            lData.clear();
+        }
+
+        return lData;
+    }
+
+    /**
+     * @brief   Writes many small records to a logical file, and returns how
+     *          long it took.
+     */
+    static std::chrono::duration<double, std::milli> WriteRecords (
+        const std::string&  pLogicalPath,
+        const std::size_t   pBufferSize
+    )
+    {
+        std::uint8_t lRecord[RECORD_SIZE] = {};
+        const auto lStart = std::chrono::steady_clock::now();
+        auto lFile = ace::VFS::OpenFileForWriting(pLogicalPath, { .mBufferSize = pBufferSize });
+        for (std::size_t i = 0; i < RECORD_COUNT && lFile != nullptr; ++i)
+        {
+            std::memcpy(lRecord, &i, sizeof(i));
+            lFile->Write(lRecord, RECORD_SIZE);
+        }
+
+        if (lFile == nullptr || lFile->Commit() == false)
+        {
+            return std::chrono::duration<double, std::milli>::max();
+        }
+
+        return std::chrono::steady_clock::now() - lStart;
+    }
+
+    /**
+     * @brief   Writes a number of files under a sync policy, flushing each a
+     *          few times along the way, and returns how long each took.
+     */
+    static std::chrono::duration<double, std::milli> WriteSynced (
+        const std::string&          pPrefix,
+        const ace::FileSyncPolicy   pPolicy
+    )
+    {
+        const astd::byte_buffer lChunk(SYNC_FILE_SIZE / 4, 0x5A);
+        const auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < SYNC_FILE_COUNT; ++i)
+        {
+            auto lFile = ace::VFS::OpenFileForWriting(std::format("{}{}.bin", pPrefix, i), { .mSync = pPolicy });
+            for (std::size_t c = 0; c < 4 && lFile != nullptr; ++c)
+            {
+                lFile->Write(lChunk.data(), lChunk.size());
+                lFile->Flush();
+            }
+
+            if (lFile == nullptr || lFile->Commit() == false)
+            {
+                return std::chrono::duration<double, std::milli>::max();
+            }
+        }
+
+        return (std::chrono::steady_clock::now() - lStart) / double(SYNC_FILE_COUNT);
+    }
+
+    static fs::path MakeRoot (
+        const std::string&  pName
+    )
+    {
+        const fs::path lRoot = fs::temp_directory_path() / pName;
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot);
+        return lRoot;
+    }
+
+    bool BenchWritableFiles ()
+    {
+        // Many small writes are timed with and without a buffer, then files
+        // are written under each sync policy. Read-only mounts, and paths
+        // which escape their mount, must refuse to be written.
+        const fs::path lRoot = MakeRoot("AceBenchFilesystem");
+        fs::create_directories(lRoot / "readonly");
+        ace::VFS::MountPhysicalDirectory("bench-fs", lRoot, true);
+        ace::VFS::MountPhysicalDirectory("bench-fs-readonly", lRoot / "readonly");
+
+        const auto lBufferedTime = WriteRecords("bench-fs/buffered.bin", 64 * 1024);
+        const auto lUnbufferedTime = WriteRecords("bench-fs/unbuffered.bin", 0);
+        const astd::byte_buffer lBuffered = ReadAll("bench-fs/buffered.bin");
+        if (
+            lBuffered.size() != RECORD_COUNT * RECORD_SIZE ||
+            lBuffered != ReadAll("bench-fs/unbuffered.bin")
+        )
+        {
+            std::cerr << std::format("Writable files: Expected {} bytes of records; got {}.\n",
+                RECORD_COUNT * RECORD_SIZE, lBuffered.size());
+            return false;
+        }
+
+        for (std::size_t i = 0; i < RECORD_COUNT; i += 997)
+        {
+            std::size_t lValue = 0;
+            std::memcpy(&lValue, lBuffered.data() + i * RECORD_SIZE, sizeof(lValue));
+            if (lValue != i)
+            {
+                std::cerr << std::format("Writable files: Record {} reads back as {}.\n", i, lValue);
+                return false;
+            }
+        }
+
+        const auto lNoSyncTime = WriteSynced("bench-fs/nosync/", ace::FileSyncPolicy::None);
+        const auto lCommitSyncTime = WriteSynced("bench-fs/commitsync/", ace::FileSyncPolicy::OnCommit);
+        const auto lFlushSyncTime = WriteSynced("bench-fs/flushsync/", ace::FileSyncPolicy::OnFlush);
+        if (ReadAll(std::format("bench-fs/flushsync/{}.bin", SYNC_FILE_COUNT - 1)).size() != SYNC_FILE_SIZE)
+        {
+            std::cerr << "Writable files: A synced file did not read back whole.\n";
+            return false;
+        }
+
+        if (
+            ace::VFS::OpenFileForWriting("bench-fs-readonly/refused.bin") != nullptr ||
+            ace::VFS::OpenFileForWriting("bench-fs/../escaped.bin") != nullptr ||
+            ace::VFS::OpenFileForWriting("bench-fsx/unmounted.bin") != nullptr
+        )
+        {
+            std::cerr << "Writable files: A read-only, escaping or unmounted path was opened for writing.\n";
+            return false;
+        }
+
+        // Appending in place, and atomically, must both keep what was there.
+        const std::string lHello = "hello, ", lWorld = "world";
+        for (const bool lAtomic : { false, true })
+        {
+            const std::string lPath = std::format("bench-fs/append{}.txt", int(lAtomic));
+            auto lFirst = ace::VFS::OpenFileForWriting(lPath, { .mAtomic = lAtomic });
+            lFirst->Write(lHello.data(), lHello.size());
+            lFirst->Commit();
+
+            auto lSecond = ace::VFS::OpenFileForWriting(lPath, { .mAtomic = lAtomic, .mAppend = true });
+            lSecond->Write(lWorld.data(), lWorld.size());
+            const std::size_t lSize = lSecond->Tell();
+            lSecond->Commit();
+
+            const astd::byte_buffer lText = ReadAll(lPath);
+            if (lSize != lHello.size() + lWorld.size() || std::string { lText.begin(), lText.end() } != lHello + lWorld)
+            {
+                std::cerr << std::format("Writable files: Appending {} did not keep the file's contents.\n",
+                    (lAtomic == true) ? "atomically" : "in place");
+                return false;
+            }
+        }
+
+        std::cout << std::format(
+            "Writable files: {} writes of {} bytes in {:.1f} ms buffered, {:.1f} ms unbuffered ({:.1f}x).\n",
+            RECORD_COUNT, RECORD_SIZE, lBufferedTime.count(), lUnbufferedTime.count(),
+            lUnbufferedTime.count() / lBufferedTime.count()
+        );
+        std::cout << std::format(
+            "Writable files: {} KB files with 4 flushes took {:.3f} ms unsynced, {:.3f} ms synced on commit, "
+            "{:.3f} ms synced on every flush.\n",
+            SYNC_FILE_SIZE / 1024, lNoSyncTime.count(), lCommitSyncTime.count(), lFlushSyncTime.count()
+        );
+
+        return true;
+    }
+
+    bool BenchAtomicReplace ()
+    {
+        // Writers replace one file over and over, each time filling it with a
+        // single byte value, while a reader checks that it only ever sees one
+        // whole version. Then the in-memory mount must behave the same.
+        const fs::path lRoot = MakeRoot("AceBenchAtomicReplace");
+        ace::VFS::MountPhysicalDirectory("bench-replace", lRoot, true);
+        auto lStore = ace::VFS::MountMemory("bench-replace-mem");
+
+        for (const std::string_view lMount : { "bench-replace", "bench-replace-mem" })
+        {
+            const std::string lPath = std::format("{}/save.bin", lMount);
+            const astd::byte_buffer lInitial(REPLACED_SIZE, 0xFF);
+            auto lFile = ace::VFS::OpenFileForWriting(lPath);
+            lFile->Write(lInitial.data(), lInitial.size());
+            lFile->Commit();
+
+            // A file flushed but then discarded must change nothing.
+            auto lDiscarded = ace::VFS::OpenFileForWriting(lPath);
+            lDiscarded->Write(lInitial.data(), REPLACED_SIZE / 2);
+            lDiscarded->Flush();
+            const bool lUntouched = ReadAll(lPath) == lInitial;
+            lDiscarded.reset();
+            if (lUntouched == false || ReadAll(lPath) != lInitial)
+            {
+                std::cerr << std::format("Atomic replace: An uncommitted write to '{}' was visible.\n", lPath);
+                return false;
+            }
+
+            std::atomic<bool> lWriting { true };
+            std::atomic<std::size_t> lCommits { 0 };
+            std::vector<std::thread> lWriters;
+            const auto lStart = std::chrono::steady_clock::now();
+            for (std::size_t w = 0; w < WRITER_COUNT; ++w)
+            {
+                lWriters.emplace_back([&, w] ()
+                {
+                    astd::byte_buffer lData(REPLACED_SIZE);
+                    for (std::size_t i = 0; i < COMMITS_PER_WRITER; ++i)
+                    {
+                        std::ranges::fill(lData, static_cast<std::uint8_t>(w * COMMITS_PER_WRITER + i));
+                        auto lWriter = ace::VFS::OpenFileForWriting(lPath);
+                        if (
+                            lWriter != nullptr &&
+                            lWriter->Write(lData.data(), lData.size()) == true &&
+                            lWriter->Commit() == true
+                        )
+                        {
+                            lCommits.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                });
+            }
+
+            std::size_t lReads = 0, lTorn = 0;
+            std::thread lReader { [&] ()
+            {
+                while (lWriting.load(std::memory_order_relaxed) == true)
+                {
+                    const astd::byte_buffer lData = ReadAll(lPath);
+                    const bool lWhole = lData.size() == REPLACED_SIZE &&
+                        std::ranges::all_of(lData, [&] (const std::uint8_t lByte) { return lByte == lData[0]; });
+                    lTorn += (lWhole == true) ? 0 : 1;
+                    ++lReads;
+                }
+            } };
+
+            for (std::thread& lWriter : lWriters)
+            {
+                lWriter.join();
+            }
+
+            const std::chrono::duration<double, std::milli> lTime = std::chrono::steady_clock::now() - lStart;
+            lWriting = false;
+            lReader.join();
+
+            std::size_t lLeftovers = 0;
+            for (const auto& lEntry : fs::directory_iterator { lRoot })
+            {
+                lLeftovers += (lEntry.path().filename() != "save.bin") ? 1 : 0;
+            }
+
+            if (lTorn != 0 || lCommits != WRITER_COUNT * COMMITS_PER_WRITER || lLeftovers != 0)
+            {
+                std::cerr << std::format("Atomic replace: On '{}', {} of {} reads were torn, {} of {} commits "
+                    "succeeded, and {} temporary files were left.\n", lMount, lTorn, lReads, lCommits.load(),
+                    WRITER_COUNT * COMMITS_PER_WRITER, lLeftovers);
+                return false;
+            }
+
+            std::cout << std::format(
+                "Atomic replace: '{}': {} replacements of {} KB in {:.1f} ms ({:.1f} us each); {} reads, none torn.\n",
+                lMount, lCommits.load(), REPLACED_SIZE / 1024, lTime.count(),
+                lTime.count() * 1000.0 / double(lCommits.load()), lReads
+            );
+        }
+
+        // In-memory files map in place, and can be removed.
+        auto lMapped = ace::VFS::OpenFile("bench-replace-mem/save.bin");
+        if (
+            lMapped == nullptr || lMapped->Map().size() != REPLACED_SIZE ||
+            lStore->GetFileCount() != 1 ||
+            ace::VFS::RemoveFile("bench-replace-mem/save.bin") == false ||
+            ace::VFS::OpenFile("bench-replace-mem/save.bin") != nullptr ||
+            lMapped->Map().size() != REPLACED_SIZE
+        )
+        {
+            std::cerr << "Atomic replace: The in-memory file did not map, or was not removed cleanly.\n";
+            return false;
+        }
+
+        return true;
+    }
+}
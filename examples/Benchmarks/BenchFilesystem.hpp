@@ -0,0 +1,12 @@
+/**
+ * @file    Benchmarks/BenchFilesystem.hpp
+ */
+
+#pragma once
+#include <Ace/System/VirtualFilesystem.hpp>
+
+namespace AceFilesystem
+{
+    bool BenchWritableFiles ();
+    bool BenchAtomicReplace ();
+}
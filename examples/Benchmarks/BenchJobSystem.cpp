@@ -0,0 +1,161 @@
+/**
+ * @file    Benchmarks/BenchJobSystem.cpp
+ */
+
+#include <iostream>
+#include <Benchmarks/BenchJobSystem.hpp>
+
+namespace AceJobSystem
+{
+    static constexpr std::size_t LOADER_COUNT = 4000;
+    static constexpr std::size_t CHUNK_COUNT = 16;
+    static constexpr std::size_t CHUNK_SIZE = 4096;
+    static constexpr std::size_t ELEMENT_COUNT = 4'000'000;
+
+    /**
+     * @brief   Stands in for decoding a chunk of an asset.
+     */
+    static std::uint64_t DecodeChunk (
+        const std::size_t   pLoader,
+        const std::size_t   pChunk
+    )
+    {
+        std::uint64_t lHash = 0xCBF29CE484222325ull ^ (pLoader * CHUNK_COUNT + pChunk);
+        for (std::size_t i = 0; i < CHUNK_SIZE; ++i)
+        {
+            lHash = (lHash ^ i) * 0x100000001B3ull;
+        }
+
+        return lHash;
+    }
+
+    bool BenchLoaderJobs ()
+    {
+        // Thousands of loader jobs, each of which splits its asset into
+        // chunks, decodes them as child jobs, and waits on them. Each wait
+        // suspends the loader's fiber rather than blocking a worker.
+        ace::JobSystem lJobs { ace::JobSystemSpec {
+            .mThreadCount   = std::max<std::size_t>(std::thread::hardware_concurrency(), 4),
+            .mFiberCount    = 128,
+            .mMaxFiberCount = 4096,
+            .mStackSize     = 64 * 1024
+        } };
+
+        std::vector<std::uint64_t> lResults(LOADER_COUNT, 0);
+        ace::JobCounter lLoaders;
+
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t lLoader = 0; lLoader < LOADER_COUNT; ++lLoader)
+        {
+            lJobs.Run(
+                [&, lLoader] () -> void
+                {
+                    std::array<std::uint64_t, CHUNK_COUNT> lChunks {};
+                    ace::JobCounter lCounter;
+                    std::vector<std::function<void()>> lChildren;
+                    for (std::size_t lChunk = 0; lChunk < CHUNK_COUNT; ++lChunk)
+                    {
+                        lChildren.push_back([&lChunks, lLoader, lChunk] {
+                            lChunks[lChunk] = DecodeChunk(lLoader, lChunk);
+                        });
+                    }
+
+                    lJobs.Run(std::move(lChildren), lCounter);
+                    lJobs.Wait(lCounter);
+
+                    std::uint64_t lSum = 0;
+                    for (const std::uint64_t lChunk : lChunks)
+                    {
+                        lSum += lChunk;
+                    }
+
+                    lResults[lLoader] = lSum;
+                },
+                &lLoaders
+            );
+        }
+
+        lJobs.Wait(lLoaders);
+        std::chrono::duration<double> lElapsed = std::chrono::steady_clock::now() - lStart;
+
+        for (std::size_t lLoader = 0; lLoader < LOADER_COUNT; ++lLoader)
+        {
+            std::uint64_t lExpected = 0;
+            for (std::size_t lChunk = 0; lChunk < CHUNK_COUNT; ++lChunk)
+            {
+                lExpected += DecodeChunk(lLoader, lChunk);
+            }
+
+            if (lResults[lLoader] != lExpected)
+            {
+                std::cerr << "JobSystem: Loader " << lLoader << " produced the wrong result.\n";
+                return false;
+            }
+        }
+
+        // An exception thrown by a child job reaches the job waiting on it.
+        ace::JobCounter lFailing;
+        bool lCaught = false;
+        lJobs.Run(
+            [&] () -> void
+            {
+                ace::JobCounter lCounter;
+                lJobs.Run([] { throw std::runtime_error { "Chunk failed to decode." }; }, &lCounter);
+                try
+                {
+                    lJobs.Wait(lCounter);
+                }
+                catch (const std::runtime_error&)
+                {
+                    lCaught = true;
+                }
+            },
+            &lFailing
+        );
+
+        lJobs.Wait(lFailing);
+        if (lCaught == false)
+        {
+            std::cerr << "JobSystem: A child job's exception did not reach its parent.\n";
+            return false;
+        }
+
+        const std::size_t lJobCount = LOADER_COUNT * (CHUNK_COUNT + 1);
+        std::cout << std::format(
+            "JobSystem: {} loader jobs with {} children each on {} workers: {:.0f} jobs/s, "
+            "{} fiber suspensions, {} fibers.\n",
+            LOADER_COUNT, CHUNK_COUNT, lJobs.GetThreadCount(),
+            lJobCount / lElapsed.count(), lJobs.GetSuspendCount(), lJobs.GetFiberCount()
+        );
+
+        return true;
+    }
+
+    bool BenchParallelFor ()
+    {
+        ace::JobSystem lJobs {};
+        std::vector<std::uint32_t> lValues(ELEMENT_COUNT, 0);
+
+        auto lStart = std::chrono::steady_clock::now();
+        lJobs.ParallelFor(ELEMENT_COUNT,
+            [&lValues] (std::size_t i) { lValues[i] = static_cast<std::uint32_t>(i * 2654435761u); },
+            16384);
+        std::chrono::duration<double> lElapsed = std::chrono::steady_clock::now() - lStart;
+
+        for (std::size_t i = 0; i < ELEMENT_COUNT; ++i)
+        {
+            if (lValues[i] != static_cast<std::uint32_t>(i * 2654435761u))
+            {
+                std::cerr << "JobSystem: ParallelFor missed index " << i << ".\n";
+                return false;
+            }
+        }
+
+        std::cout << std::format(
+            "JobSystem: ParallelFor over {} elements on {} workers: {:.2f} ms.\n",
+            ELEMENT_COUNT, lJobs.GetThreadCount(), lElapsed.count() * 1000.0
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,12 @@
+/**
+ * @file    Benchmarks/BenchJobSystem.hpp
+ */
+
+#pragma once
+#include <Ace/System/JobSystem.hpp>
+
+namespace AceJobSystem
+{
+    bool BenchLoaderJobs ();
+    bool BenchParallelFor ();
+}
@@ -0,0 +1,369 @@
+/**
+ * @file    Benchmarks/BenchMeshes.cpp
+ */
+
+#include <iostream>
+#include <numbers>
+#include <numeric>
+#include <Benchmarks/BenchMeshes.hpp>
+
+namespace AceMeshes
+{
+    static constexpr std::size_t SEGMENTS = 256;
+    static constexpr std::size_t RINGS = 128;
+    static constexpr float RADIUS = 2.0f;
+    static constexpr std::size_t CACHE_SIZE = 16;
+    static constexpr std::size_t LOD_COUNT = 5;
+    static constexpr std::size_t CROWD_SIZE = 20000;
+    static constexpr float VIEWPORT_HEIGHT = 1080.0f;
+    static constexpr float MAX_PIXEL_ERROR = 1.0f;
+
+    /**
+     * @brief   Writes a UV sphere as `.obj` source, with its quads in a
+     *          shuffled order, as an exporter with no care for locality
+     *          might.
+     */
+    static std::string MakeSphereSource ()
+    {
+        std::string lSource;
+        for (std::size_t r = 0; r <= RINGS; ++r)
+        {
+            const float lPolar = std::numbers::pi_v<float> * float(r) / float(RINGS);
+            for (std::size_t s = 0; s <= SEGMENTS; ++s)
+            {
+                const float lAzimuth = 2.0f * std::numbers::pi_v<float> * float(s) / float(SEGMENTS);
+                const float lX = std::sin(lPolar) * std::cos(lAzimuth);
+                const float lY = std::cos(lPolar);
+                const float lZ = std::sin(lPolar) * std::sin(lAzimuth);
+                lSource += std::format("v {} {} {}\nvt {} {}\nvn {} {} {}\n", lX * RADIUS, lY * RADIUS, lZ * RADIUS,
+                    float(s) / float(SEGMENTS), float(r) / float(RINGS), lX, lY, lZ);
+            }
+        }
+
+        std::vector<std::size_t> lQuads(RINGS * SEGMENTS);
+        std::iota(lQuads.begin(), lQuads.end(), 0);
+        std::mt19937 lRandom { 97 };
+        std::shuffle(lQuads.begin(), lQuads.end(), lRandom);
+        for (const std::size_t lQuad : lQuads)
+        {
+            const std::size_t r = lQuad / SEGMENTS;
+            const std::size_t s = lQuad % SEGMENTS;
+            const std::size_t lA = r * (SEGMENTS + 1) + s + 1;
+            const std::size_t lB = lA + 1;
+            const std::size_t lC = lB + SEGMENTS + 1;
+            const std::size_t lD = lA + SEGMENTS + 1;
+            lSource += std::format("f {0}/{0}/{0} {1}/{1}/{1} {2}/{2}/{2} {3}/{3}/{3}\n", lA, lB, lC, lD);
+        }
+
+        return lSource;
+    }
+
+    bool BenchMeshCooking ()
+    {
+        // A shuffled sphere is cooked, checked against its source, then
+        // written out and viewed in place through the asset registry.
+        const std::string lSource = MakeSphereSource();
+        std::vector<ace::MeshVertex> lVertices;
+        std::vector<std::uint32_t> lIndices;
+        ace::ObjMeshLoader::Parse(lSource, lVertices, lIndices);
+
+        std::vector<std::uint32_t> lUnoptimized = lIndices;
+        const std::size_t lUniqueCount = ace::MeshCooker::Deduplicate(lVertices, lUnoptimized).size();
+        const float lBefore = ace::MeshCooker::ComputeCacheMissRatio(lUnoptimized, lUniqueCount, CACHE_SIZE);
+
+        auto lStart = std::chrono::steady_clock::now();
+        const astd::byte_buffer lBlob = ace::MeshCooker::Cook(lVertices, lIndices, { .mCacheSize = CACHE_SIZE });
+        const std::chrono::duration<double, std::milli> lCookTime = std::chrono::steady_clock::now() - lStart;
+
+        const auto lMesh = ace::Mesh::FromBlob(lBlob);
+        std::vector<std::uint32_t> lCooked(lMesh->GetIndexCount());
+        for (std::size_t i = 0; i < lCooked.size(); ++i)
+        {
+            lCooked[i] = lMesh->GetIndex(i);
+        }
+
+        const float lAfter = ace::MeshCooker::ComputeCacheMissRatio(lCooked, lMesh->GetVertices().size(), CACHE_SIZE);
+        if (lCooked.size() != lIndices.size() || lMesh->GetVertices().size() != lUniqueCount || lAfter >= lBefore * 0.5f)
+        {
+            std::cerr << std::format("Mesh cooking: Expected {} indices and {} vertices, and the cache miss ratio "
+                "to halve; got {}, {}, and {} to {}.\n", lIndices.size(), lUniqueCount, lCooked.size(),
+                lMesh->GetVertices().size(), lBefore, lAfter);
+            return false;
+        }
+
+        // Every quantized vertex must still lie on the sphere, facing out.
+        const float lTolerance = RADIUS * 2.0f / 65535.0f * 2.0f;
+        for (const ace::PackedVertex& lPacked : lMesh->GetVertices())
+        {
+            const ace::MeshVertex lVertex = lMesh->Unpack(lPacked);
+            const float lDistance = lVertex.mPosition.Length();
+            if (
+                std::abs(lDistance - RADIUS) > lTolerance ||
+                lVertex.mNormal.Dot(lVertex.mPosition / lDistance) < 0.99f
+            )
+            {
+                std::cerr << "Mesh cooking: A vertex was quantized too coarsely.\n";
+                return false;
+            }
+        }
+
+        // The meshlets, in order, must hold exactly the index list.
+        std::size_t lCorner = 0;
+        for (const ace::Meshlet& lMeshlet : lMesh->GetMeshlets())
+        {
+            if (lMeshlet.mVertexCount > 64 || lMeshlet.mTriangleCount > 124)
+            {
+                std::cerr << "Mesh cooking: A meshlet is over its limits.\n";
+                return false;
+            }
+
+            for (std::size_t i = 0; i < lMeshlet.mTriangleCount * 3u; ++i, ++lCorner)
+            {
+                const std::uint8_t lLocal = lMesh->GetMeshletTriangles()[lMeshlet.mTriangleOffset + i];
+                if (lMesh->GetMeshletVertices()[lMeshlet.mVertexOffset + lLocal] != lCooked[lCorner])
+                {
+                    std::cerr << "Mesh cooking: The meshlets do not match the index list.\n";
+                    return false;
+                }
+            }
+        }
+
+        if (lCorner != lCooked.size())
+        {
+            std::cerr << "Mesh cooking: The meshlets do not cover the index list.\n";
+            return false;
+        }
+
+        // Load the source and the cooked blob through the registry.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchMeshes";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot);
+        std::ofstream { lRoot / "sphere.obj", std::ios::binary } << lSource;
+        std::ofstream { lRoot / "sphere.amesh", std::ios::binary }.write(
+            reinterpret_cast<const char*>(lBlob.data()), static_cast<std::streamsize>(lBlob.size()));
+
+        ace::VFS::MountPhysicalDirectory("bench-meshes", lRoot);
+        auto lCache = std::make_shared<ace::DerivedDataCache>(lRoot / "ddc", "bench-meshes-ddc");
+        auto lObjLoader = std::make_shared<ace::ObjMeshLoader>(ace::MeshLoaderSpec { .mCook = { .mCacheSize = CACHE_SIZE }, .mCache = lCache });
+        ace::AssetRegistry::RegisterAssetLoader<ace::Mesh>(lObjLoader);
+        ace::AssetRegistry::RegisterAssetLoader<ace::Mesh>(std::make_shared<ace::MeshBlobLoader>());
+
+        lStart = std::chrono::steady_clock::now();
+        const auto lFromSource = ace::AssetRegistry::Load<ace::Mesh>("bench-meshes/sphere.obj");
+        const std::chrono::duration<double, std::milli> lSourceTime = std::chrono::steady_clock::now() - lStart;
+
+        lStart = std::chrono::steady_clock::now();
+        const auto lFromCache = lObjLoader->Load("bench-meshes/sphere.obj", ace::VFS::OpenFile("bench-meshes/sphere.obj"));
+        const std::chrono::duration<double, std::milli> lCacheTime = std::chrono::steady_clock::now() - lStart;
+
+        lStart = std::chrono::steady_clock::now();
+        const auto lFromBlob = ace::AssetRegistry::Load<ace::Mesh>("bench-meshes/sphere.amesh");
+        const std::chrono::duration<double, std::milli> lBlobTime = std::chrono::steady_clock::now() - lStart;
+
+        if (
+            lFromSource.IsValid() == false || lFromCache == nullptr || lFromBlob.IsValid() == false ||
+            lObjLoader->GetCookCount() != 1 || lFromBlob->IsMapped() == false ||
+            std::ranges::equal(lFromSource->GetBlob(), lBlob) == false ||
+            std::ranges::equal(lFromCache->GetBlob(), lBlob) == false ||
+            std::ranges::equal(lFromBlob->GetBlob(), lBlob) == false
+        )
+        {
+            std::cerr << "Mesh cooking: The mesh did not load identically from source, cache and blob.\n";
+            return false;
+        }
+
+        const std::size_t lSourceBytes = lVertices.size() * sizeof(ace::MeshVertex) + lIndices.size() * 4;
+        std::cout << std::format(
+            "Mesh cooking: {} triangles, {} corners deduplicated to {} vertices, {} meshlets, in {:.1f} ms. "
+            "Cache misses per triangle: {:.3f} to {:.3f}. Blob: {} bytes ({:.1f}x smaller).\n",
+            lIndices.size() / 3, lVertices.size(), lUniqueCount, lMesh->GetMeshlets().size(), lCookTime.count(),
+            lBefore, lAfter, lBlob.size(), double(lSourceBytes) / double(lBlob.size())
+        );
+        std::cout << std::format(
+            "Mesh cooking: Loaded from .obj in {:.1f} ms; from the cache in {:.2f} ms; mapped from .amesh in {:.3f} ms.\n",
+            lSourceTime.count(), lCacheTime.count(), lBlobTime.count()
+        );
+
+        return true;
+    }
+
+    bool BenchMeshLods ()
+    {
+        // The sphere is cooked into levels of detail, which are checked,
+        // picked for a crowd of instances, then streamed in as the view
+        // closes on one.
+        const std::string lSource = MakeSphereSource();
+        std::vector<ace::MeshVertex> lVertices;
+        std::vector<std::uint32_t> lIndices;
+        ace::ObjMeshLoader::Parse(lSource, lVertices, lIndices);
+
+        auto lStart = std::chrono::steady_clock::now();
+        const astd::byte_buffer lBlob = ace::MeshCooker::Cook(lVertices, lIndices,
+            { .mCacheSize = CACHE_SIZE, .mLodCount = LOD_COUNT, .mLodReduction = 0.5f, .mLodMaxError = 0.02f });
+        const std::chrono::duration<double, std::milli> lCookTime = std::chrono::steady_clock::now() - lStart;
+
+        const auto lMesh = ace::Mesh::FromBlob(lBlob);
+        const std::span<const ace::MeshLod> lLods = lMesh->GetLods();
+        if (lLods.size() != LOD_COUNT)
+        {
+            std::cerr << std::format("Mesh LODs: Expected {} levels of detail; got {}.\n", LOD_COUNT, lLods.size());
+            return false;
+        }
+
+        // Every vertex lies on the sphere, so a level's flattening shows in
+        // how far its triangles' centroids sink below it.
+        std::string lSummary;
+        for (std::size_t l = 0; l < lLods.size(); ++l)
+        {
+            const ace::MeshLod& lLod = lLods[l];
+            float lSag = 0.0f;
+            for (std::size_t i = 0; i < lLod.mIndexCount; i += 3)
+            {
+                ace::Vector3f lCentroid = ace::Vector3f::Zero();
+                for (std::size_t c = 0; c < 3; ++c)
+                {
+                    const std::uint32_t lIndex = lMesh->GetIndex(lLod.mIndexOffset + i + c);
+                    if (lIndex >= lLod.mVertexCount)
+                    {
+                        std::cerr << std::format("Mesh LODs: Level {} uses a vertex outside its prefix.\n", l);
+                        return false;
+                    }
+
+                    lCentroid += lMesh->Unpack(lMesh->GetVertices()[lIndex]).mPosition;
+                }
+
+                lSag = std::max(lSag, RADIUS - (lCentroid / 3.0f).Length());
+            }
+
+            if (
+                (l > 0 && (lLod.mIndexCount >= lLods[l - 1].mIndexCount || lLod.mError < lLods[l - 1].mError)) ||
+                lLod.mError > 0.02f * RADIUS * 2.0f * std::sqrt(3.0f) || lSag > 0.1f * RADIUS
+            )
+            {
+                std::cerr << std::format("Mesh LODs: Level {} has {} triangles, an error of {} and sags by {}.\n",
+                    l, lLod.mIndexCount / 3, lLod.mError, lSag);
+                return false;
+            }
+
+            lSummary += std::format("{}{} tris / {} verts / error {:.4f} / sag {:.4f}", (l > 0) ? "; " : "",
+                lLod.mIndexCount / 3, lLod.mVertexCount, lLod.mError, lSag);
+        }
+
+        // Pick levels for a crowd scattered in depth, and compare the
+        // triangles drawn with drawing every instance at full detail.
+        const ace::Matrix4f lProjection = ace::Perspective<float>(std::numbers::pi_v<float> / 3.0f, 16.0f / 9.0f, 0.1f, 1000.0f);
+        std::vector<ace::Matrix4f> lModelViews(CROWD_SIZE);
+        std::mt19937 lRandom { 98 };
+        std::uniform_real_distribution<float> lDepth { 4.0f, 400.0f };
+        std::uniform_real_distribution<float> lSpread { -1.0f, 1.0f };
+        for (ace::Matrix4f& lModelView : lModelViews)
+        {
+            const float lZ = lDepth(lRandom);
+            lModelView = ace::Translate<float>({ lSpread(lRandom) * lZ, lSpread(lRandom) * lZ * 0.5f, -lZ });
+        }
+
+        std::vector<std::size_t> lPicked(CROWD_SIZE);
+        lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < CROWD_SIZE; ++i)
+        {
+            lPicked[i] = lMesh->SelectLod(lModelViews[i], lProjection, VIEWPORT_HEIGHT, MAX_PIXEL_ERROR);
+        }
+        const std::chrono::duration<double, std::micro> lSelectTime = std::chrono::steady_clock::now() - lStart;
+
+        std::size_t lDrawn = 0;
+        std::array<std::size_t, ace::Mesh::MAX_LODS> lHistogram {};
+        for (const std::size_t lLevel : lPicked)
+        {
+            lDrawn += lLods[lLevel].mIndexCount / 3;
+            ++lHistogram[lLevel];
+        }
+
+        const std::size_t lFull = CROWD_SIZE * (lLods[0].mIndexCount / 3);
+        std::size_t lPrevious = 0;
+        for (float lZ = 2.5f; lZ < 1000.0f; lZ *= 1.25f)
+        {
+            const std::size_t lLevel = lMesh->SelectLod(ace::Translate<float>({ 0.0f, 0.0f, -lZ }), lProjection, VIEWPORT_HEIGHT, MAX_PIXEL_ERROR);
+            if (lLevel < lPrevious)
+            {
+                std::cerr << "Mesh LODs: A further view picked a finer level.\n";
+                return false;
+            }
+
+            lPrevious = lLevel;
+        }
+
+        if (lPrevious != LOD_COUNT - 1 || lHistogram[0] == CROWD_SIZE || lDrawn * 4 > lFull)
+        {
+            std::cerr << std::format("Mesh LODs: The crowd drew {} of {} triangles.\n", lDrawn, lFull);
+            return false;
+        }
+
+        // Write one blob per level, and stream them in as a view closes on
+        // the mesh and backs away again.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchMeshLods";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot);
+
+        std::vector<std::string> lPaths;
+        std::vector<std::size_t> lSizes;
+        for (std::size_t l = 0; l < lLods.size(); ++l)
+        {
+            const astd::byte_buffer lLevelBlob = ace::MeshCooker::ExtractLod(*lMesh, l);
+            const std::string lName = std::format("sphere.lod{}.amesh", l);
+            std::ofstream { lRoot / lName, std::ios::binary }.write(
+                reinterpret_cast<const char*>(lLevelBlob.data()), static_cast<std::streamsize>(lLevelBlob.size()));
+            lPaths.push_back("bench-lods/" + lName);
+            lSizes.push_back(lLevelBlob.size());
+        }
+
+        ace::VFS::MountPhysicalDirectory("bench-lods", lRoot);
+        ace::AssetRegistry::RegisterAssetLoader<ace::Mesh>(std::make_shared<ace::MeshBlobLoader>());
+
+        ace::StreamedMesh lStreamed { lPaths };
+        const std::size_t lFirstLevel = lStreamed.Select(ace::Translate<float>({ 0.0f, 0.0f, -3.0f }), lProjection, VIEWPORT_HEIGHT, MAX_PIXEL_ERROR);
+        const bool lStartedStreaming = lStreamed.IsStreaming();
+
+        lStart = std::chrono::steady_clock::now();
+        std::size_t lLevel = lFirstLevel;
+        while (lLevel != 0 && std::chrono::steady_clock::now() - lStart < std::chrono::seconds { 5 })
+        {
+            std::this_thread::sleep_for(std::chrono::microseconds { 100 });
+            lLevel = lStreamed.Select(ace::Translate<float>({ 0.0f, 0.0f, -3.0f }), lProjection, VIEWPORT_HEIGHT, MAX_PIXEL_ERROR);
+        }
+        const std::chrono::duration<double, std::milli> lStreamTime = std::chrono::steady_clock::now() - lStart;
+
+        const bool lDetailed = lLevel == 0 && lStreamed.GetMesh().HasLod(0) == true;
+        lLevel = lStreamed.Select(ace::Translate<float>({ 0.0f, 0.0f, -900.0f }), lProjection, VIEWPORT_HEIGHT, MAX_PIXEL_ERROR);
+        if (
+            lFirstLevel != LOD_COUNT - 1 || lStartedStreaming == false || lDetailed == false ||
+            lLevel != LOD_COUNT - 1 || lStreamed.GetResidentLevel() != LOD_COUNT - 1 ||
+            std::ranges::equal(ace::Mesh::FromBlob(ace::MeshCooker::ExtractLod(*lMesh, 0))->GetBlob(), lMesh->GetBlob()) == false
+        )
+        {
+            std::cerr << "Mesh LODs: Levels did not stream in and out as the view moved.\n";
+            return false;
+        }
+
+        std::string lCounts;
+        for (std::size_t l = 0; l < lLods.size(); ++l)
+        {
+            lCounts += std::format("{}{}", (l > 0) ? " / " : "", lHistogram[l]);
+        }
+
+        std::cout << std::format("Mesh LODs: Cooked {} levels in {:.1f} ms: {}.\n", lLods.size(), lCookTime.count(), lSummary);
+        std::cout << std::format(
+            "Mesh LODs: Picked levels for {} instances in {:.1f} us ({:.1f} ns each), drawing {} of {} triangles ({:.1f}x fewer); "
+            "instances per level: {}.\n",
+            CROWD_SIZE, lSelectTime.count(), lSelectTime.count() * 1000.0 / double(CROWD_SIZE), lDrawn, lFull,
+            double(lFull) / double(lDrawn), lCounts
+        );
+        std::cout << std::format(
+            "Mesh LODs: Coarsest blob {} bytes resident up front, of {} for full detail; the full level streamed in {:.2f} ms.\n",
+            lSizes.back(), lSizes.front(), lStreamTime.count()
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,16 @@
+/**
+ * @file    Benchmarks/BenchMeshes.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/MeshCooker.hpp>
+#include <Ace/Graphics/MeshLoaders.hpp>
+#include <Ace/Graphics/StreamedMesh.hpp>
+#include <Ace/Maths/Projection.hpp>
+#include <Ace/Maths/Transform.hpp>
+
+namespace AceMeshes
+{
+    bool BenchMeshCooking ();
+    bool BenchMeshLods ();
+}
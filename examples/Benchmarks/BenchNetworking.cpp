@@ -0,0 +1,341 @@
+/**
+ * @file    Benchmarks/BenchNetworking.cpp
+ */
+
+#include <iostream>
+#include <numbers>
+#include <Benchmarks/BenchNetworking.hpp>
+
+namespace AceNetworking
+{
+    static constexpr std::size_t MESSAGE_COUNT = 20000;
+
+    /**
+     * @brief   Sends numbered reliable messages from one host to another, and
+     *          checks that every one arrives exactly once, in order.
+     */
+    static bool SendNumbered (
+        const std::string&  pName,
+        ace::NetworkHost&   pSender,
+        ace::NetworkHost&   pReceiver,
+        const std::size_t&  pCount
+    )
+    {
+        const auto lStart = std::chrono::steady_clock::now();
+        const auto lGiveUp = lStart + std::chrono::seconds { 30 };
+        const ace::NetworkAddress lTo = pReceiver.GetLocalAddress();
+
+        std::uint32_t lSent = 0;
+        std::uint32_t lExpected = 0;
+        while (lExpected < pCount)
+        {
+            if (std::chrono::steady_clock::now() > lGiveUp)
+            {
+                std::cerr << std::format("{}: Timed out after {} of {} messages.\n",
+                    pName, lExpected, pCount);
+                return false;
+            }
+
+            // Keep a few hundred messages in flight, so that the test
+            // measures the channel rather than the queues' capacities.
+            while (lSent < pCount && lSent < lExpected + 512)
+            {
+                std::array<std::uint8_t, 64> lPayload {};
+                std::memcpy(lPayload.data(), &lSent, sizeof(lSent));
+                if (pSender.Send(lTo, lPayload, ace::NetworkDelivery::ReliableOrdered) == false)
+                {
+                    break;
+                }
+
+                ++lSent;
+            }
+
+            pSender.Flush();
+
+            while (auto lEvent = pReceiver.Receive())
+            {
+                if (lEvent->mType != ace::NetworkEventType::Message)
+                {
+                    continue;
+                }
+
+                std::uint32_t lNumber = 0;
+                std::memcpy(&lNumber, lEvent->GetPayload().data(), sizeof(lNumber));
+                if (
+                    lEvent->mDelivery != ace::NetworkDelivery::ReliableOrdered ||
+                    lNumber != lExpected
+                )
+                {
+                    std::cerr << std::format("{}: Expected message {}; got {}.\n",
+                        pName, lExpected, lNumber);
+                    return false;
+                }
+
+                ++lExpected;
+            }
+
+            // Drain the sender's events, too, so its queue never fills up.
+            while (pSender.Receive().has_value() == true) {}
+            std::this_thread::sleep_for(std::chrono::microseconds { 200 });
+        }
+
+        const auto lElapsed = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - lStart };
+        std::cout << std::format(
+            "{}: {} reliable messages delivered in order in {:.3f} s "
+            "({:.0f} per second), {} resends.\n",
+            pName, pCount, lElapsed.count(), pCount / lElapsed.count(),
+            pSender.GetResendCount()
+        );
+
+        return true;
+    }
+
+    bool BenchLoopbackReliable ()
+    {
+        ace::LoopbackNetwork lNetwork {
+            ace::LoopbackConditions {
+                std::chrono::milliseconds { 20 },
+                std::chrono::milliseconds { 10 },
+                0.1f
+            }
+        };
+
+        ace::NetworkHost lServer {
+            std::make_unique<ace::LoopbackTransport>(lNetwork,
+                ace::NetworkAddress::Loopback(1000))
+        };
+        ace::NetworkHost lClient {
+            std::make_unique<ace::LoopbackTransport>(lNetwork,
+                ace::NetworkAddress::Loopback(1001))
+        };
+
+        lServer.Start();
+        lClient.Start();
+        const bool lPassed = SendNumbered(
+            "NetworkHost (loopback, 20 ms latency, 10 ms jitter, 10% loss)",
+            lClient, lServer, MESSAGE_COUNT / 4);
+        lClient.Stop();
+        lServer.Stop();
+
+        return lPassed && lClient.GetResendCount() > 0;
+    }
+
+    bool BenchUdpReliable ()
+    {
+        std::unique_ptr<ace::UdpTransport> lServerTransport, lClientTransport;
+        try
+        {
+            lServerTransport = std::make_unique<ace::UdpTransport>(
+                ace::NetworkAddress::Loopback(0));
+            lClientTransport = std::make_unique<ace::UdpTransport>(
+                ace::NetworkAddress::Loopback(0));
+        }
+        catch (const std::exception& lEx)
+        {
+            std::cout << std::format("NetworkHost (UDP): Skipped; {}\n", lEx.what());
+            return true;
+        }
+
+        ace::NetworkHost lServer { std::move(lServerTransport) };
+        ace::NetworkHost lClient { std::move(lClientTransport) };
+
+        lServer.Start();
+        lClient.Start();
+        const bool lPassed = SendNumbered("NetworkHost (UDP, 127.0.0.1)",
+            lClient, lServer, MESSAGE_COUNT * 5);
+        lClient.Stop();
+        lServer.Stop();
+
+        return lPassed;
+    }
+
+    static constexpr std::size_t ENTITY_COUNT = 1000;
+    static constexpr std::size_t TICK_RATE = 60;
+    static constexpr std::size_t TICK_COUNT = TICK_RATE * 5;
+
+    /**
+     * @brief   Moves a quarter of the entities along circles and spins them,
+     *          leaving the rest at rest, as of the given tick.
+     */
+    static void PlaceEntity (
+        const std::size_t&  pIndex,
+        const std::size_t&  pTick,
+        ace::Vector3f&      pPosition,
+        ace::Quaternion4f&  pRotation
+    )
+    {
+        const float lTime = (pIndex % 4 == 0) ?
+            static_cast<float>(pTick) / TICK_RATE : 0.0f;
+        const float lPhase = static_cast<float>(pIndex) * 0.37f;
+        const ace::Vector3f lHome {
+            static_cast<float>(pIndex % 32) * 16.0f - 256.0f,
+            0.0f,
+            static_cast<float>(pIndex / 32) * 16.0f - 256.0f
+        };
+
+        pPosition = lHome + ace::Vector3f {
+            std::cos(lTime + lPhase) * 4.0f,
+            std::sin(lTime * 2.0f) * 0.5f,
+            std::sin(lTime + lPhase) * 4.0f
+        };
+        pRotation = ace::Quaternion4f {
+            ace::Vector3f { 0.0f, 1.0f, 0.0f }, lTime * std::numbers::pi_v<float> + lPhase
+        };
+    }
+
+    bool BenchSnapshotReplication ()
+    {
+        const std::string lName = std::format(
+            "SnapshotReplicator (loopback, {} entities at {} Hz, 30 ms latency, 5% loss)",
+            ENTITY_COUNT, TICK_RATE);
+
+        ace::LoopbackNetwork lNetwork {
+            ace::LoopbackConditions {
+                std::chrono::milliseconds { 30 },
+                std::chrono::milliseconds { 5 },
+                0.05f
+            }
+        };
+
+        ace::NetworkHost lServer {
+            std::make_unique<ace::LoopbackTransport>(lNetwork,
+                ace::NetworkAddress::Loopback(1002))
+        };
+        ace::NetworkHost lClient {
+            std::make_unique<ace::LoopbackTransport>(lNetwork,
+                ace::NetworkAddress::Loopback(1003))
+        };
+
+        ace::SnapshotSpec lSpec;
+        lSpec.mEntityCount = ENTITY_COUNT;
+        ace::SnapshotReplicator lReplicator { lSpec };
+        ace::SnapshotReceiver lReceiver { lSpec };
+        const auto lClientId = lReplicator.AddClient();
+        const ace::NetworkAddress lClientAddress = lClient.GetLocalAddress();
+        const ace::NetworkAddress lServerAddress = lServer.GetLocalAddress();
+
+        lServer.Start();
+        lClient.Start();
+
+        using Clock = std::chrono::steady_clock;
+        const auto lInterval = std::chrono::duration_cast<Clock::duration>(
+            std::chrono::duration<double> { 1.0 / TICK_RATE });
+
+        std::size_t lBytesSent = 0, lChunksSent = 0, lFullSize = 0, lCompleted = 0;
+        Clock::duration lEncodeTime {}, lDecodeTime {};
+        std::optional<std::uint16_t> lLastAcked;
+
+        auto lNextTick = Clock::now();
+        for (std::size_t lTick = 0; lTick < TICK_COUNT; ++lTick)
+        {
+            std::this_thread::sleep_until(lNextTick);
+            lNextTick += lInterval;
+
+            // Server: apply the client's acknowledgements, then capture and
+            // send this tick's snapshot.
+            while (auto lEvent = lServer.Receive())
+            {
+                const auto lPayload = lEvent->GetPayload();
+                if (lEvent->mType == ace::NetworkEventType::Message && lPayload.size() == 2)
+                {
+                    lReplicator.Acknowledge(lClientId,
+                        static_cast<std::uint16_t>(lPayload[0] | (lPayload[1] << 8)));
+                }
+            }
+
+            for (std::size_t i = 0; i < ENTITY_COUNT; ++i)
+            {
+                ace::Vector3f lPosition;
+                ace::Quaternion4f lRotation;
+                PlaceEntity(i, lTick, lPosition, lRotation);
+                lReplicator.SetEntity(i, lPosition, lRotation);
+            }
+
+            const auto lEncodeStart = Clock::now();
+            lReplicator.Capture();
+            const std::size_t lSize = lReplicator.Encode(lClientId,
+                [&] (std::span<const std::uint8_t> pChunk)
+                {
+                    lServer.Send(lClientAddress, pChunk, ace::NetworkDelivery::Unreliable);
+                    ++lChunksSent;
+                });
+            lEncodeTime += Clock::now() - lEncodeStart;
+            lServer.Flush();
+
+            lFullSize = (lTick == 0) ? lSize : lFullSize;
+            lBytesSent += lSize;
+
+            // Client: decode whatever has arrived, and acknowledge the latest
+            // whole snapshot.
+            while (auto lEvent = lClient.Receive())
+            {
+                if (lEvent->mType != ace::NetworkEventType::Message)
+                {
+                    continue;
+                }
+
+                const auto lDecodeStart = Clock::now();
+                lCompleted += (lReceiver.Receive(lEvent->GetPayload()) == true) ? 1 : 0;
+                lDecodeTime += Clock::now() - lDecodeStart;
+            }
+
+            if (auto lAck = lReceiver.TakeAcknowledgement())
+            {
+                const std::uint8_t lPayload[2] = {
+                    static_cast<std::uint8_t>(*lAck),
+                    static_cast<std::uint8_t>(*lAck >> 8)
+                };
+                lClient.Send(lServerAddress, lPayload, ace::NetworkDelivery::Unreliable);
+                lClient.Flush();
+                lLastAcked = lAck;
+            }
+        }
+
+        lClient.Stop();
+        lServer.Stop();
+
+        // Sequence numbers start at zero and advance once per tick, so the
+        // client's latest snapshot can be checked against the ground truth.
+        if (lLastAcked.has_value() == false || lCompleted < TICK_COUNT / 2)
+        {
+            std::cerr << std::format("{}: Only {} of {} snapshots arrived whole.\n",
+                lName, lCompleted, TICK_COUNT);
+            return false;
+        }
+
+        const float lTolerance = lSpec.mPositionResolution;
+        for (std::size_t i = 0; i < ENTITY_COUNT; ++i)
+        {
+            ace::Vector3f lExpectedPosition, lPosition;
+            ace::Quaternion4f lExpectedRotation, lRotation;
+            PlaceEntity(i, *lLastAcked, lExpectedPosition, lExpectedRotation);
+            if (
+                lReceiver.GetEntity(i, lPosition, lRotation) == false ||
+                std::abs(lPosition.mX - lExpectedPosition.mX) > lTolerance ||
+                std::abs(lPosition.mY - lExpectedPosition.mY) > lTolerance ||
+                std::abs(lPosition.mZ - lExpectedPosition.mZ) > lTolerance ||
+                std::abs(lRotation.Dot(lExpectedRotation.Normalized())) < 0.999f
+            )
+            {
+                std::cerr << std::format("{}: Entity {} was not restored.\n", lName, i);
+                return false;
+            }
+        }
+
+        const double lSeconds = static_cast<double>(TICK_COUNT) / TICK_RATE;
+        std::cout << std::format(
+            "{}: {} of {} snapshots arrived whole; full snapshot {} bytes, "
+            "average {:.0f} bytes ({} chunks) per snapshot, {:.1f} kB/s; "
+            "encode {:.1f} us, decode {:.1f} us per snapshot.\n",
+            lName, lCompleted, TICK_COUNT, lFullSize,
+            static_cast<double>(lBytesSent) / TICK_COUNT,
+            lChunksSent / TICK_COUNT,
+            lBytesSent / lSeconds / 1000.0,
+            std::chrono::duration<double, std::micro> { lEncodeTime }.count() / TICK_COUNT,
+            std::chrono::duration<double, std::micro> { lDecodeTime }.count() / TICK_COUNT
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,16 @@
+/**
+ * @file    Benchmarks/BenchNetworking.hpp
+ */
+
+#pragma once
+#include <Ace/Networking/LoopbackTransport.hpp>
+#include <Ace/Networking/NetworkHost.hpp>
+#include <Ace/Networking/SnapshotReplication.hpp>
+#include <Ace/Networking/UdpTransport.hpp>
+
+namespace AceNetworking
+{
+    bool BenchLoopbackReliable ();
+    bool BenchUdpReliable ();
+    bool BenchSnapshotReplication ();
+}
@@ -0,0 +1,118 @@
+/**
+ * @file    Benchmarks/BenchParticles.cpp
+ */
+
+#include <iostream>
+#include <Benchmarks/BenchParticles.hpp>
+
+namespace AceParticles
+{
+    static constexpr std::size_t EMITTER_COUNT = 64;
+    static constexpr std::size_t EMITTER_CAPACITY = 16'384;
+    static constexpr std::size_t FRAME_COUNT = 180;
+    static constexpr float FRAME_TIME = 1.0f / 60.0f;
+
+    /**
+     * @brief   Fills a system with fountains, each filled to capacity up
+     *          front and then kept roughly full by its spawn rate.
+     */
+    static std::vector<ace::EmitterId> BuildFountains (
+        ace::ParticleSystem&    pSystem
+    )
+    {
+        std::vector<ace::EmitterId> lEmitters;
+        for (std::size_t i = 0; i < EMITTER_COUNT; ++i)
+        {
+            const ace::EmitterId lEmitter = pSystem.CreateEmitter({
+                .mCapacity = EMITTER_CAPACITY,
+                .mPosition { float(i % 8) * 10.0f, 0.0f, float(i / 8) * 10.0f },
+                .mVelocity { 0.0f, 8.0f, 0.0f },
+                .mVelocitySpread { 2.0f, 1.0f, 2.0f },
+                .mRate = float(EMITTER_CAPACITY) / 2.0f,
+                .mLifetime = 2.0f,
+                .mLifetimeSpread = 0.5f,
+                .mSeed = static_cast<std::uint32_t>(i + 1)
+            });
+
+            pSystem.Emit(lEmitter, EMITTER_CAPACITY);
+            lEmitters.push_back(lEmitter);
+        }
+
+        return lEmitters;
+    }
+
+    bool BenchParticleUpdate ()
+    {
+        // A million particles are simulated on the calling thread and on a
+        // pool; both must agree to the bit, as each emitter's work and random
+        // numbers are its own.
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+        ace::ParticleSystem lSerial { { .mDrag = 0.1f } };
+        ace::ParticleSystem lPooled { { .mThreadPool = &lPool, .mDrag = 0.1f } };
+        const std::vector<ace::EmitterId> lSerialEmitters = BuildFountains(lSerial);
+        const std::vector<ace::EmitterId> lPooledEmitters = BuildFountains(lPooled);
+
+        std::chrono::duration<double, std::milli> lSerialTime {};
+        std::chrono::duration<double, std::milli> lPooledTime {};
+        std::size_t lMinCount = lSerial.GetParticleCount();
+        std::size_t lMaxCount = 0;
+        for (std::size_t f = 0; f < FRAME_COUNT; ++f)
+        {
+            auto lStart = std::chrono::steady_clock::now();
+            lSerial.Update(FRAME_TIME);
+            lSerialTime += std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            lPooled.Update(FRAME_TIME);
+            lPooledTime += std::chrono::steady_clock::now() - lStart;
+
+            lMinCount = std::min(lMinCount, lSerial.GetParticleCount());
+            lMaxCount = std::max(lMaxCount, lSerial.GetParticleCount());
+        }
+
+        for (std::size_t i = 0; i < EMITTER_COUNT; ++i)
+        {
+            const ace::ParticleView lFirst = lSerial.GetParticles(lSerialEmitters[i]);
+            const ace::ParticleView lSecond = lPooled.GetParticles(lPooledEmitters[i]);
+            if (
+                lFirst.mLifetime.size() != lSecond.mLifetime.size() ||
+                std::equal(lFirst.mPosition[1].begin(), lFirst.mPosition[1].end(),
+                    lSecond.mPosition[1].begin()) == false ||
+                std::equal(lFirst.mLifetime.begin(), lFirst.mLifetime.end(),
+                    lSecond.mLifetime.begin()) == false
+            )
+            {
+                std::cerr << "Particle update: Emitter " << i << " differs between serial and pooled runs.\n";
+                return false;
+            }
+
+            for (const float lLifetime : lFirst.mLifetime)
+            {
+                if (lLifetime <= 0.0f)
+                {
+                    std::cerr << "Particle update: A dead particle was not removed.\n";
+                    return false;
+                }
+            }
+        }
+
+        // The first burst dies out between 1.5 and 2.5 seconds in, faster
+        // than the spawn rate replaces it, but the fountains never run dry.
+        if (lMinCount < EMITTER_COUNT * EMITTER_CAPACITY / 4 || lMaxCount > EMITTER_COUNT * EMITTER_CAPACITY)
+        {
+            std::cerr << "Particle update: Between " << lMinCount << " and " << lMaxCount
+                << " particles were kept alive.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "Particle update: {} emitters, {} to {} particles. Serial: {:.2f} ms/frame; "
+            "{} workers: {:.2f} ms/frame ({:.2f}x).\n",
+            EMITTER_COUNT, lMinCount, lMaxCount, lSerialTime.count() / FRAME_COUNT,
+            lPool.GetThreadCount(), lPooledTime.count() / FRAME_COUNT,
+            lSerialTime.count() / lPooledTime.count()
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,11 @@
+/**
+ * @file    Benchmarks/BenchParticles.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/ParticleSystem.hpp>
+
+namespace AceParticles
+{
+    bool BenchParticleUpdate ();
+}
@@ -0,0 +1,340 @@
+/**
+ * @file    Benchmarks/BenchPhysics.cpp
+ */
+
+#include <iostream>
+#include <random>
+#include <Benchmarks/BenchPhysics.hpp>
+
+namespace AcePhysics
+{
+    static constexpr std::size_t BODY_COUNT = 100'000;
+    static constexpr std::size_t FRAME_COUNT = 10;
+    static constexpr std::size_t CHURN_COUNT = 500;
+    static constexpr float WORLD_SIZE = 200.0f;
+    static constexpr float MAX_SPEED = 0.5f;
+
+    /**
+     * @brief   A box moving around the world, bouncing off its walls.
+     */
+    struct Body
+    {
+        ace::Vector3f   mCentre;
+        ace::Vector3f   mHalfExtents;
+        ace::Vector3f   mVelocity;
+        ace::ProxyId    mSweepProxy = ace::INVALID_PROXY;
+        ace::ProxyId    mTreeProxy = ace::INVALID_PROXY;
+
+        ace::AABB3f GetBounds () const
+        {
+            return { mCentre - mHalfExtents, mCentre + mHalfExtents };
+        }
+    };
+
+    /**
+     * @brief   Turns a body around along one axis once it leaves the world.
+     */
+    static void Bounce (
+        const float pPosition,
+        float&      pVelocity
+    )
+    {
+        if ((pPosition < 0.0f && pVelocity < 0.0f) || (pPosition > WORLD_SIZE && pVelocity > 0.0f))
+        {
+            pVelocity = -pVelocity;
+        }
+    }
+
+    /**
+     * @brief   Translates pairs of handles into sorted pairs of body indices,
+     *          optionally keeping only those whose bodies' boxes overlap.
+     */
+    static std::vector<ace::ProxyPair> ToBodyPairs (
+        const ace::IBroadphase&             pBroadphase,
+        const std::vector<ace::ProxyPair>&  pPairs,
+        const std::vector<Body>&            pBodies,
+        const bool                          pExactOnly
+    )
+    {
+        std::vector<ace::ProxyPair> lResult;
+        lResult.reserve(pPairs.size());
+        for (const ace::ProxyPair& lPair : pPairs)
+        {
+            const auto lFirst = static_cast<ace::ProxyId>(pBroadphase.GetUserData(lPair.mFirst));
+            const auto lSecond = static_cast<ace::ProxyId>(pBroadphase.GetUserData(lPair.mSecond));
+            if (
+                pExactOnly == false ||
+                pBodies[lFirst].GetBounds().Intersects(pBodies[lSecond].GetBounds()) == true
+            )
+            {
+                lResult.push_back({ std::min(lFirst, lSecond), std::max(lFirst, lSecond) });
+            }
+        }
+
+        std::sort(lResult.begin(), lResult.end());
+        return lResult;
+    }
+
+    bool BenchBroadphase ()
+    {
+        // A hundred thousand boxes of assorted sizes drift around a cube,
+        // with a few replaced by fresh ones each frame. Both broadphases
+        // find the pairs on a thread pool, and a second sweep-and-prune on
+        // the calling thread checks that the results do not depend on it.
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+        ace::SweepAndPrune lSweep { ace::BroadphaseSpec { .mThreadPool = &lPool } };
+        ace::SweepAndPrune lSerialSweep {};
+        ace::DynamicAABBTree lTree { ace::BroadphaseSpec { .mThreadPool = &lPool, .mGrainSize = 1024 } };
+
+        std::mt19937 lRandom { 42 };
+        std::uniform_real_distribution<float> lPosition { 0.0f, WORLD_SIZE };
+        std::uniform_real_distribution<float> lExtent { 0.25f, 1.5f };
+        std::uniform_real_distribution<float> lSpeed { -MAX_SPEED, MAX_SPEED };
+        auto lSpawn =
+            [&] (Body& pBody, std::size_t pIndex) -> void
+            {
+                pBody.mCentre = { lPosition(lRandom), lPosition(lRandom), lPosition(lRandom) };
+                pBody.mHalfExtents = { lExtent(lRandom), lExtent(lRandom), lExtent(lRandom) };
+                pBody.mVelocity = { lSpeed(lRandom), lSpeed(lRandom), lSpeed(lRandom) };
+                pBody.mSweepProxy = lSweep.CreateProxy(pBody.GetBounds(), pIndex);
+                pBody.mTreeProxy = lTree.CreateProxy(pBody.GetBounds(), pIndex);
+                lSerialSweep.CreateProxy(pBody.GetBounds(), pIndex);
+            };
+
+        std::vector<Body> lBodies(BODY_COUNT);
+        for (std::size_t i = 0; i < BODY_COUNT; ++i)
+        {
+            lSpawn(lBodies[i], i);
+        }
+
+        std::vector<ace::ProxyPair> lSweepPairs;
+        std::vector<ace::ProxyPair> lSerialPairs;
+        std::vector<ace::ProxyPair> lTreePairs;
+        std::chrono::duration<double, std::milli> lSweepTime {};
+        std::chrono::duration<double, std::milli> lTreeTime {};
+        std::size_t lPairCount = 0;
+        for (std::size_t lFrame = 0; lFrame < FRAME_COUNT; ++lFrame)
+        {
+            // Replace a few bodies. The serial sweep-and-prune hands out the
+            // same handles as the pooled one, so it shares its handles.
+            for (std::size_t i = 0; i < CHURN_COUNT; ++i)
+            {
+                const std::size_t lIndex = lRandom() % BODY_COUNT;
+                lSweep.DestroyProxy(lBodies[lIndex].mSweepProxy);
+                lSerialSweep.DestroyProxy(lBodies[lIndex].mSweepProxy);
+                lTree.DestroyProxy(lBodies[lIndex].mTreeProxy);
+                lSpawn(lBodies[lIndex], lIndex);
+            }
+
+            for (Body& lBody : lBodies)
+            {
+                lBody.mCentre += lBody.mVelocity;
+                Bounce(lBody.mCentre.mX, lBody.mVelocity.mX);
+                Bounce(lBody.mCentre.mY, lBody.mVelocity.mY);
+                Bounce(lBody.mCentre.mZ, lBody.mVelocity.mZ);
+            }
+
+            auto lStart = std::chrono::steady_clock::now();
+            for (const Body& lBody : lBodies)
+            {
+                lSweep.MoveProxy(lBody.mSweepProxy, lBody.GetBounds(), lBody.mVelocity);
+            }
+            lSweep.FindPairs(lSweepPairs);
+            lSweepTime += std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            for (const Body& lBody : lBodies)
+            {
+                lTree.MoveProxy(lBody.mTreeProxy, lBody.GetBounds(), lBody.mVelocity);
+            }
+            lTree.FindPairs(lTreePairs);
+            lTreeTime += std::chrono::steady_clock::now() - lStart;
+
+            for (const Body& lBody : lBodies)
+            {
+                lSerialSweep.MoveProxy(lBody.mSweepProxy, lBody.GetBounds(), lBody.mVelocity);
+            }
+            lSerialSweep.FindPairs(lSerialPairs);
+
+            if (lSweepPairs != lSerialPairs)
+            {
+                std::cerr << "Broadphase: Sweep-and-prune's pairs depend on the thread pool.\n";
+                return false;
+            }
+
+            // Sweep-and-prune tests boxes exactly, so its pairs must match the
+            // tree's once those are narrowed down to exact overlaps.
+            if (
+                ToBodyPairs(lSweep, lSweepPairs, lBodies, false) !=
+                ToBodyPairs(lTree, lTreePairs, lBodies, true)
+            )
+            {
+                std::cerr << "Broadphase: The broadphases disagree on frame " << lFrame << ".\n";
+                return false;
+            }
+
+            lPairCount += lSweepPairs.size();
+        }
+
+        std::vector<ace::ProxyId> lFound;
+        lTree.Query(lBodies[0].GetBounds(), lFound);
+        if (std::find(lFound.begin(), lFound.end(), lBodies[0].mTreeProxy) == lFound.end())
+        {
+            std::cerr << "Broadphase: A query missed the box it was made with.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "Broadphase: {} moving boxes on {} workers, {:.0f} pairs per frame. "
+            "Sweep-and-prune: {:.2f} ms/frame; AABB tree: {:.2f} ms/frame, height {}, "
+            "{:.1f}% reinserted per frame.\n",
+            BODY_COUNT, lPool.GetThreadCount(), double(lPairCount) / FRAME_COUNT,
+            lSweepTime.count() / FRAME_COUNT, lTreeTime.count() / FRAME_COUNT, lTree.GetHeight(),
+            100.0 * double(lTree.GetReinsertCount()) / double(BODY_COUNT * FRAME_COUNT)
+        );
+
+        return true;
+    }
+
+    static constexpr std::size_t STACK_GRID = 10;
+    static constexpr std::size_t STACK_HEIGHT = 5;
+    static constexpr std::size_t SPHERE_COUNT = 200;
+    static constexpr std::size_t STEP_COUNT = 300;
+    static constexpr float STEP_TIME = 1.0f / 60.0f;
+
+    /**
+     * @brief   Fills a world with stacks of boxes on a static floor, and a
+     *          shower of spheres falling onto them.
+     *
+     * @return  The handles of the dynamic bodies.
+     */
+    static std::vector<ace::BodyId> BuildScene (
+        ace::PhysicsWorld&  pWorld
+    )
+    {
+        pWorld.CreateBody({ .mHalfExtents { 40.0f, 1.0f, 40.0f }, .mMass = 0.0f,
+            .mPosition { 0.0f, -1.0f, 0.0f } });
+
+        std::vector<ace::BodyId> lBodies;
+        for (std::size_t x = 0; x < STACK_GRID; ++x)
+        {
+            for (std::size_t z = 0; z < STACK_GRID; ++z)
+            {
+                for (std::size_t y = 0; y < STACK_HEIGHT; ++y)
+                {
+                    lBodies.push_back(pWorld.CreateBody({
+                        .mPosition { float(x) * 3.0f - 15.0f, 0.5f + float(y) * 1.0f, float(z) * 3.0f - 15.0f }
+                    }));
+                }
+            }
+        }
+
+        std::mt19937 lRandom { 7 };
+        std::uniform_real_distribution<float> lPosition { -16.0f, 16.0f };
+        std::uniform_real_distribution<float> lHeight { 8.0f, 20.0f };
+        for (std::size_t i = 0; i < SPHERE_COUNT; ++i)
+        {
+            lBodies.push_back(pWorld.CreateBody({
+                .mShape = ace::BodyShape::Sphere,
+                .mHalfExtents { 0.4f, 0.4f, 0.4f },
+                .mMass = 0.5f,
+                .mPosition { lPosition(lRandom), lHeight(lRandom), lPosition(lRandom) },
+                .mRestitution = 0.3f
+            }));
+        }
+
+        return lBodies;
+    }
+
+    bool BenchRigidBodies ()
+    {
+        // A hundred stacks of boxes take a shower of spheres, once on a
+        // thread pool and once on the calling thread. Both runs must end with
+        // the same bodies, bit for bit.
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+        ace::PhysicsWorld lWorld { ace::PhysicsWorldSpec { .mThreadPool = &lPool } };
+        ace::PhysicsWorld lSerialWorld {};
+        const std::vector<ace::BodyId> lBodies = BuildScene(lWorld);
+        BuildScene(lSerialWorld);
+
+        std::chrono::duration<double, std::milli> lPooledTime {};
+        std::chrono::duration<double, std::milli> lSerialTime {};
+        std::size_t lContactCount = 0;
+        std::size_t lBatchCount = 0;
+        std::size_t lColorCount = 0;
+        std::size_t lIslandCount = 0;
+        for (std::size_t lStep = 0; lStep < STEP_COUNT; ++lStep)
+        {
+            auto lStart = std::chrono::steady_clock::now();
+            lWorld.Step(STEP_TIME);
+            lPooledTime += std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            lSerialWorld.Step(STEP_TIME);
+            lSerialTime += std::chrono::steady_clock::now() - lStart;
+
+            const ace::PhysicsStepStats& lStats = lWorld.GetLastStepStats();
+            lContactCount += lStats.mContactCount;
+            lBatchCount += lStats.mBatchCount;
+            lIslandCount += lStats.mIslandCount;
+            lColorCount = std::max(lColorCount, lStats.mColorCount);
+        }
+
+        std::size_t lAwakeCount = 0;
+        for (const ace::BodyId lBody : lBodies)
+        {
+            const ace::Vector3f& lPosition = lWorld.GetPosition(lBody);
+            const ace::Quaternion4f& lOrientation = lWorld.GetOrientation(lBody);
+            const ace::Vector3f& lSerialPosition = lSerialWorld.GetPosition(lBody);
+            const ace::Quaternion4f& lSerialOrientation = lSerialWorld.GetOrientation(lBody);
+            if (
+                std::memcmp(&lPosition, &lSerialPosition, sizeof(lPosition)) != 0 ||
+                std::memcmp(&lOrientation, &lSerialOrientation, sizeof(lOrientation)) != 0
+            )
+            {
+                std::cerr << "Rigid Bodies: Body " << lBody << " depends on the thread pool.\n";
+                return false;
+            }
+
+            if (lPosition.mY < 0.3f || std::isfinite(lPosition.mY) == false)
+            {
+                std::cerr << "Rigid Bodies: Body " << lBody << " fell through the floor.\n";
+                return false;
+            }
+
+            lAwakeCount += (lWorld.IsAwake(lBody) == true) ? 1 : 0;
+        }
+
+        // A few stacks may be knocked over by the spheres, but most should
+        // still stand, their top boxes about where they started.
+        std::size_t lStandingCount = 0;
+        for (std::size_t i = STACK_HEIGHT - 1; i < STACK_GRID * STACK_GRID * STACK_HEIGHT; i += STACK_HEIGHT)
+        {
+            lStandingCount += (lWorld.GetPosition(lBodies[i]).mY > float(STACK_HEIGHT) - 1.0f) ? 1 : 0;
+        }
+
+        if (lStandingCount < STACK_GRID * STACK_GRID * 3 / 4)
+        {
+            std::cerr << "Rigid Bodies: Only " << lStandingCount << " stacks still stand.\n";
+            return false;
+        }
+
+        if (lAwakeCount == lBodies.size())
+        {
+            std::cerr << "Rigid Bodies: No body fell asleep.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "Rigid Bodies: {} bodies over {} steps on {} workers, {:.0f} contacts and {:.1f} islands per step, "
+            "{:.0f} four-wide batches per iteration, up to {} colours. Pooled: {:.2f} ms/step; serial: "
+            "{:.2f} ms/step; {} of {} stacks standing and {} bodies asleep at the end.\n",
+            lBodies.size(), STEP_COUNT, lPool.GetThreadCount(), double(lContactCount) / STEP_COUNT,
+            double(lIslandCount) / STEP_COUNT, double(lBatchCount) / STEP_COUNT, lColorCount,
+            lPooledTime.count() / STEP_COUNT, lSerialTime.count() / STEP_COUNT, lStandingCount,
+            STACK_GRID * STACK_GRID, lBodies.size() - lAwakeCount
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * @file    Benchmarks/BenchPhysics.hpp
+ */
+
+#pragma once
+#include <Ace/Physics/DynamicAABBTree.hpp>
+#include <Ace/Physics/PhysicsWorld.hpp>
+#include <Ace/Physics/SweepAndPrune.hpp>
+
+namespace AcePhysics
+{
+    bool BenchBroadphase ();
+    bool BenchRigidBodies ();
+}
@@ -0,0 +1,222 @@
+/**
+ * @file    Benchmarks/BenchScripting.cpp
+ */
+
+#include <cmath>
+#include <iostream>
+#include <Benchmarks/BenchScripting.hpp>
+
+namespace AceScripting
+{
+    static constexpr std::size_t SCRIPT_COUNT = 300;
+    static constexpr std::size_t CALL_COUNT = 1000000;
+
+    static const char* CALLS_SOURCE = R"(
+        // Damage after armor, never below one.
+        fn damage (base, armor, critical) {
+            let dealt = base * (1 + critical) - armor * 0.5;
+            if (dealt < 1) { return 1; }
+            return dealt;
+        }
+
+        fn fib (n) {
+            if (n < 2) { return n; }
+            return fib(n - 1) + fib(n - 2);
+        }
+
+        fn falloff (distance, radius) {
+            return clamp(1 - distance / radius, 0, 1) * sqrt(radius);
+        }
+    )";
+
+    /**
+     * @brief   Generates a script of a few functions, unique to the given
+     *          index.
+     */
+    static std::string MakeScript (
+        const std::size_t&  pIndex
+    )
+    {
+        return std::format(R"(
+            // Generated script {0}.
+            fn update (health, regen, dt) {{
+                let next = health + regen * dt * {0};
+                if (next > 100) {{ next = 100; }}
+                return next;
+            }}
+
+            fn score (kills, deaths) {{
+                let ratio = kills / (deaths + 1);
+                let bonus = 0;
+                let i = 0;
+                while (i < kills && i < {1}) {{
+                    bonus = bonus + i * {2};
+                    i = i + 1;
+                }}
+                return ratio * 1000 + bonus;
+            }}
+
+            fn pick (a, b, c) {{
+                if (a > b && a > c) {{ return 0; }}
+                else if (b > c || b == a) {{ return 1; }}
+                return 2;
+            }}
+        )", pIndex, pIndex % 17 + 3, pIndex * 0.25);
+    }
+
+    bool BenchScriptColdStart ()
+    {
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchScripting";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot / "src");
+
+        for (std::size_t i = 0; i < SCRIPT_COUNT; ++i)
+        {
+            std::ofstream { lRoot / "src" / std::format("script{}.acs", i) } << MakeScript(i);
+        }
+
+        ace::VFS::MountPhysicalDirectory("bench-scripts", lRoot / "src");
+        auto lCache = std::make_shared<ace::DerivedDataCache>(lRoot / "ddc", "bench-ddc");
+        auto lLoader = std::make_shared<ace::ScriptLoader>(lCache);
+        ace::AssetRegistry::RegisterAssetLoader<ace::ScriptModule>(lLoader);
+
+        // Loads every script, returning the time taken; handles are dropped
+        // straight away so that the registry's own cache cannot serve the
+        // next pass.
+        const auto lLoadAll = [&] () -> std::optional<double>
+        {
+            const auto lStart = std::chrono::steady_clock::now();
+            for (std::size_t i = 0; i < SCRIPT_COUNT; ++i)
+            {
+                auto lModule = ace::AssetRegistry::Load<ace::ScriptModule>(
+                    std::format("bench-scripts/script{}.acs", i));
+                if (lModule.IsValid() == false || lModule->FindFunction("score").has_value() == false)
+                {
+                    std::cerr << std::format("ScriptLoader: Script {} did not load.\n", i);
+                    return std::nullopt;
+                }
+            }
+
+            return std::chrono::duration<double, std::milli> {
+                std::chrono::steady_clock::now() - lStart }.count();
+        };
+
+        const auto lCold = lLoadAll();
+        const std::size_t lCompiled = lLoader->GetCompileCount();
+        const auto lWarm = lLoadAll();
+        if (
+            lCold.has_value() == false ||
+            lWarm.has_value() == false ||
+            lCompiled != SCRIPT_COUNT ||
+            lLoader->GetCompileCount() != SCRIPT_COUNT ||
+            lCache->GetHitCount() != SCRIPT_COUNT
+        )
+        {
+            std::cerr << std::format("ScriptLoader: Expected {} compiles and {} cache hits; "
+                "got {} and {}.\n", SCRIPT_COUNT, SCRIPT_COUNT,
+                lLoader->GetCompileCount(), lCache->GetHitCount());
+            return false;
+        }
+
+        std::cout << std::format(
+            "ScriptLoader: {} scripts compiled and cached in {:.2f} ms; "
+            "loaded from the cache in {:.2f} ms, with no recompiles.\n",
+            SCRIPT_COUNT, *lCold, *lWarm);
+
+        fs::remove_all(lRoot, lError);
+        return true;
+    }
+
+    bool BenchScriptCalls ()
+    {
+        ace::ScriptVM lVM;
+        lVM.RegisterNative("clamp", [] (std::span<const double> pArgs)
+        {
+            return std::clamp(pArgs[0], pArgs[1], pArgs[2]);
+        });
+        lVM.RegisterNative("sqrt", [] (std::span<const double> pArgs)
+        {
+            return std::sqrt(pArgs[0]);
+        });
+
+        const std::uint32_t lModule = lVM.Link(
+            ace::ScriptCompiler::Compile(CALLS_SOURCE, "calls"));
+        const auto lDamage = lVM.FindFunction(lModule, "damage");
+        const auto lFib = lVM.FindFunction(lModule, "fib");
+        const auto lFalloff = lVM.FindFunction(lModule, "falloff");
+        if (lDamage.has_value() == false || lFib.has_value() == false || lFalloff.has_value() == false)
+        {
+            std::cerr << "ScriptVM: Functions not found.\n";
+            return false;
+        }
+
+        std::vector<double> lArguments(CALL_COUNT * 3);
+        for (std::size_t i = 0; i < CALL_COUNT; ++i)
+        {
+            lArguments[i * 3 + 0] = static_cast<double>(i % 200);
+            lArguments[i * 3 + 1] = static_cast<double>(i % 37);
+            lArguments[i * 3 + 2] = static_cast<double>(i % 2);
+        }
+
+        const auto lExpected = [&] (const std::size_t& pIndex)
+        {
+            const double* lArgs = &lArguments[pIndex * 3];
+            const double lDealt = lArgs[0] * (1 + lArgs[2]) - lArgs[1] * 0.5;
+            return (lDealt < 1) ? 1.0 : lDealt;
+        };
+
+        // One call at a time.
+        double lSum = 0.0;
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < CALL_COUNT; ++i)
+        {
+            lSum += lVM.Call(*lDamage, std::span<const double> { &lArguments[i * 3], 3 });
+        }
+        const double lSingle = std::chrono::duration<double, std::nano> {
+            std::chrono::steady_clock::now() - lStart }.count() / CALL_COUNT;
+
+        // The same calls, batched.
+        std::vector<double> lResults(CALL_COUNT);
+        lStart = std::chrono::steady_clock::now();
+        lVM.CallBatch(*lDamage, lArguments, lResults);
+        const double lBatched = std::chrono::duration<double, std::nano> {
+            std::chrono::steady_clock::now() - lStart }.count() / CALL_COUNT;
+
+        double lBatchSum = 0.0;
+        for (std::size_t i = 0; i < CALL_COUNT; ++i)
+        {
+            if (lResults[i] != lExpected(i))
+            {
+                std::cerr << std::format("ScriptVM: damage call {} returned {}; expected {}.\n",
+                    i, lResults[i], lExpected(i));
+                return false;
+            }
+
+            lBatchSum += lResults[i];
+        }
+
+        // Deep script-to-script recursion, and native calls.
+        const std::uint64_t lBefore = lVM.GetInstructionCount();
+        lStart = std::chrono::steady_clock::now();
+        const double lFib25 = lVM.Call(*lFib, std::array { 25.0 });
+        const double lFibSeconds = std::chrono::duration<double> {
+            std::chrono::steady_clock::now() - lStart }.count();
+        const double lFalloffValue = lVM.Call(*lFalloff, std::array { 2.0, 4.0 });
+
+        if (lSum != lBatchSum || lFib25 != 75025.0 || lFalloffValue != 1.0)
+        {
+            std::cerr << std::format("ScriptVM: Wrong results (fib(25) = {}, falloff = {}).\n",
+                lFib25, lFalloffValue);
+            return false;
+        }
+
+        std::cout << std::format(
+            "ScriptVM: {} calls at {:.1f} ns each, {:.1f} ns each batched; "
+            "fib(25) in {:.2f} ms ({:.0f} M instructions per second).\n",
+            CALL_COUNT, lSingle, lBatched, lFibSeconds * 1000.0,
+            (lVM.GetInstructionCount() - lBefore) / lFibSeconds / 1e6);
+
+        return true;
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * @file    Benchmarks/BenchScripting.hpp
+ */
+
+#pragma once
+#include <Ace/Scripting/ScriptCompiler.hpp>
+#include <Ace/Scripting/ScriptLoader.hpp>
+#include <Ace/Scripting/ScriptVM.hpp>
+
+namespace AceScripting
+{
+    bool BenchScriptColdStart ();
+    bool BenchScriptCalls ();
+}
@@ -0,0 +1,263 @@
+/**
+ * @file    Benchmarks/BenchShaders.cpp
+ */
+
+#include <iostream>
+#include <Benchmarks/BenchShaders.hpp>
+
+namespace AceShaders
+{
+    static constexpr std::size_t MATERIAL_COUNT = 24;
+    static constexpr std::size_t VARIANT_COUNT = 4;
+    static constexpr std::chrono::milliseconds COMPILE_COST { 2 };
+    static constexpr std::size_t CODE_SIZE = 4096;
+
+    /**
+     * @brief   A stand-in for a driver's compiler, which takes a fixed time
+     *          per shader or pipeline and emits bytes derived from its input.
+     */
+    class StubCompiler final : public ace::IShaderCompiler
+    {
+    public:
+
+        explicit StubCompiler (
+            const std::uint64_t pVersion
+        ) :
+            mVersion    { pVersion }
+        {
+
+        }
+
+        std::uint64_t GetVersion () const override
+        {
+            return mVersion;
+        }
+
+        astd::byte_buffer CompileShader (
+            const ace::ShaderSource&    pShader
+        ) override
+        {
+            if (pShader.mSource.contains("#error") == true)
+            {
+                ACE_THROW(std::runtime_error, "{}: '{}' does not compile!",
+                    "StubCompiler", pShader.mPath);
+            }
+
+            std::this_thread::sleep_for(COMPILE_COST);
+            return Emit(ace::ShaderCache::MakeShaderKey(pShader, mVersion));
+        }
+
+        astd::byte_buffer BuildPipeline (
+            std::span<const astd::byte_buffer>  pShaders,
+            std::span<const std::uint8_t>       pState
+        ) override
+        {
+            std::this_thread::sleep_for(COMPILE_COST);
+            std::uint64_t lSeed = ace::ContentHash64(pState, mVersion);
+            for (const astd::byte_buffer& lShader : pShaders)
+            {
+                lSeed = ace::ContentHash64(lShader, lSeed);
+            }
+
+            return Emit(lSeed);
+        }
+
+    private:
+
+        static astd::byte_buffer Emit (
+            std::uint64_t   pSeed
+        )
+        {
+            astd::byte_buffer lCode(CODE_SIZE);
+            for (std::uint8_t& lByte : lCode)
+            {
+                pSeed = pSeed * 6364136223846793005ull + 1442695040888963407ull;
+                lByte = static_cast<std::uint8_t>(pSeed >> 56);
+            }
+
+            return lCode;
+        }
+
+    private:
+        std::uint64_t   mVersion = 0;
+
+    };
+
+    /**
+     * @brief   Describes every material's pipelines: a vertex and a fragment
+     *          shader per variant, each with its own definitions and state.
+     */
+    static std::vector<ace::PipelineSource> MakePipelines ()
+    {
+        std::vector<ace::PipelineSource> lPipelines;
+        for (std::size_t m = 0; m < MATERIAL_COUNT; ++m)
+        {
+            const std::string lName = std::format("material{}", m);
+            for (std::size_t v = 0; v < VARIANT_COUNT; ++v)
+            {
+                ace::PipelineSource lPipeline;
+                lPipeline.mShaders.push_back({
+                    .mPath = std::format("bench-shaders/{}.vert", lName),
+                    .mStage = ace::ShaderStage::Vertex,
+                    .mDefines = { std::format("SKINNED={}", v & 1) },
+                    .mSource = std::format("// {} vertex\nvoid main () {{ gl_Position = vec4({}); }}\n", lName, m)
+                });
+                lPipeline.mShaders.push_back({
+                    .mPath = std::format("bench-shaders/{}.frag", lName),
+                    .mStage = ace::ShaderStage::Fragment,
+                    .mDefines = { std::format("SHADOWS={}", v >> 1), "QUALITY=HIGH" },
+                    .mSource = std::format("// {} fragment\nvoid main () {{ colour = vec4({}); }}\n", lName, m)
+                });
+                lPipeline.mState = { static_cast<std::uint8_t>(v), static_cast<std::uint8_t>(m) };
+                lPipelines.push_back(std::move(lPipeline));
+            }
+        }
+
+        return lPipelines;
+    }
+
+    bool BenchShaderCache ()
+    {
+        // A first run compiles every pipeline and records a manifest; a
+        // second run, as after a restart, prewarms from that manifest and
+        // the persistent store, and should compile nothing at all.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchShaders";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot / "src");
+
+        std::vector<ace::PipelineSource> lPipelines = MakePipelines();
+        for (const ace::PipelineSource& lPipeline : lPipelines)
+        {
+            for (const ace::ShaderSource& lShader : lPipeline.mShaders)
+            {
+                std::ofstream { lRoot / "src" / fs::path { lShader.mPath }.filename(), std::ios::binary } << lShader.mSource;
+            }
+        }
+
+        ace::VFS::MountPhysicalDirectory("bench-shaders", lRoot / "src");
+        ace::VFS::MountPhysicalDirectory("bench-shaders-state", lRoot);
+        auto lStore = std::make_shared<ace::DerivedDataCache>(lRoot / "ddc", "bench-shaders-ddc");
+        auto lCompiler = std::make_shared<StubCompiler>(1);
+        std::unordered_set<std::uint64_t> lShaderKeys;
+        for (const ace::PipelineSource& lPipeline : lPipelines)
+        {
+            for (const ace::ShaderSource& lShader : lPipeline.mShaders)
+            {
+                lShaderKeys.insert(ace::ShaderCache::MakeShaderKey(lShader, 1));
+            }
+        }
+
+        const std::size_t lShaderCount = lShaderKeys.size();
+        const std::size_t lPipelineCount = lPipelines.size();
+
+        std::vector<astd::byte_buffer> lCodes;
+        std::chrono::duration<double, std::milli> lColdTime, lWarmTime;
+        {
+            ace::ShaderCache lCache { { .mCompiler = lCompiler, .mCache = lStore } };
+
+            auto lStart = std::chrono::steady_clock::now();
+            for (const ace::PipelineSource& lPipeline : lPipelines)
+            {
+                lCodes.push_back(lCache.GetPipeline(lPipeline)->mCode);
+            }
+            lColdTime = std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            for (const ace::PipelineSource& lPipeline : lPipelines)
+            {
+                lCache.GetPipeline(lPipeline);
+            }
+            lWarmTime = std::chrono::steady_clock::now() - lStart;
+
+            if (lCache.GetCompileCount() != lShaderCount + lPipelineCount || lCache.GetDiskHitCount() != 0)
+            {
+                std::cerr << std::format("Shader cache: Expected {} compiles on the first run; got {}, and {} disk hits.\n",
+                    lShaderCount + lPipelineCount, lCache.GetCompileCount(), lCache.GetDiskHitCount());
+                return false;
+            }
+
+            std::ofstream { lRoot / "shaders.manifest", std::ios::binary } << lCache.BuildManifest();
+        }
+
+        // Definitions in another order must give the same key.
+        ace::ShaderSource lReordered = lPipelines[0].mShaders[1];
+        std::ranges::reverse(lReordered.mDefines);
+        if (ace::ShaderCache::MakeShaderKey(lReordered, 1) != ace::ShaderCache::MakeShaderKey(lPipelines[0].mShaders[1], 1))
+        {
+            std::cerr << "Shader cache: The order of definitions changed a shader's key.\n";
+            return false;
+        }
+
+        // Restart: prewarm in the background, then ask for every pipeline.
+        std::size_t lStarted = 0;
+        std::chrono::duration<double, std::milli> lPrewarmTime, lFirstFrameTime;
+        {
+            ace::ShaderCache lCache { { .mCompiler = lCompiler, .mCache = lStore } };
+
+            auto lStart = std::chrono::steady_clock::now();
+            lStarted = lCache.Prewarm("bench-shaders-state/shaders.manifest");
+            lCache.WaitIdle();
+            lPrewarmTime = std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            bool lIdentical = true;
+            for (std::size_t i = 0; i < lPipelines.size(); ++i)
+            {
+                lIdentical = lIdentical && std::ranges::equal(lCache.GetPipeline(lPipelines[i])->mCode, lCodes[i]);
+            }
+            lFirstFrameTime = std::chrono::steady_clock::now() - lStart;
+
+            if (
+                lIdentical == false || lStarted != lShaderCount + lPipelineCount ||
+                lCache.GetCompileCount() != 0 || lCache.GetDiskHitCount() != lStarted
+            )
+            {
+                std::cerr << std::format("Shader cache: Prewarming started {} of {} entries, compiled {} and found {} "
+                    "on disk; the pipelines {} match.\n", lStarted, lShaderCount + lPipelineCount,
+                    lCache.GetCompileCount(), lCache.GetDiskHitCount(), (lIdentical == true) ? "did" : "did not");
+                return false;
+            }
+        }
+
+        // A new compiler version must miss everything; a shader which fails
+        // must not be cached as failed.
+        {
+            ace::ShaderCache lCache { { .mCompiler = std::make_shared<StubCompiler>(2), .mCache = lStore } };
+            lCache.GetPipeline(lPipelines[0]);
+
+            ace::ShaderSource lBroken { .mStage = ace::ShaderStage::Compute, .mSource = "#error" };
+            std::size_t lFailures = 0;
+            for (int i = 0; i < 2; ++i)
+            {
+                try
+                {
+                    lCache.GetShaderAsync(lBroken).get();
+                }
+                catch (const std::runtime_error&)
+                {
+                    ++lFailures;
+                }
+            }
+
+            if (lCache.GetCompileCount() != 3 || lCache.GetDiskHitCount() != 0 || lFailures != 2)
+            {
+                std::cerr << std::format("Shader cache: A new compiler version gave {} compiles and {} disk hits, "
+                    "and a broken shader failed {} times.\n", lCache.GetCompileCount(), lCache.GetDiskHitCount(), lFailures);
+                return false;
+            }
+        }
+
+        std::cout << std::format(
+            "Shader cache: {} shaders and {} pipelines compiled in {:.1f} ms; looked up again in {:.3f} ms.\n",
+            lShaderCount, lPipelineCount, lColdTime.count(), lWarmTime.count()
+        );
+        std::cout << std::format(
+            "Shader cache: After a restart, prewarmed {} entries from disk in {:.1f} ms ({:.1f}x faster), with no "
+            "compiles; first frame's lookups took {:.3f} ms.\n",
+            lStarted, lPrewarmTime.count(), lColdTime.count() / lPrewarmTime.count(), lFirstFrameTime.count()
+        );
+
+        return true;
+    }
+}
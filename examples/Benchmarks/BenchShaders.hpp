@@ -0,0 +1,11 @@
+/**
+ * @file    Benchmarks/BenchShaders.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/ShaderCache.hpp>
+
+namespace AceShaders
+{
+    bool BenchShaderCache ();
+}
@@ -0,0 +1,567 @@
+/**
+ * @file    Benchmarks/BenchTextures.cpp
+ */
+
+#include <iostream>
+#include <miniz.h>
+#include <Benchmarks/BenchTextures.hpp>
+
+namespace AceTextures
+{
+    static constexpr std::size_t LARGE_SIZE = 1024;
+    static constexpr std::size_t LARGE_COUNT = 8;
+    static constexpr std::size_t COMPRESSED_SIZE = 1024;
+    static constexpr double MINIMUM_PSNR = 32.0;
+
+    /**
+     * @brief   Appends a value to a buffer, most significant byte first.
+     */
+    static void PutBigEndian (
+        astd::byte_buffer&  pBuffer,
+        const std::uint32_t pValue
+    )
+    {
+        for (int i = 3; i >= 0; --i)
+        {
+            pBuffer.push_back(static_cast<std::uint8_t>(pValue >> (i * 8)));
+        }
+    }
+
+    /**
+     * @brief   Appends a value to a buffer, least significant byte first.
+     */
+    static void PutLittleEndian (
+        astd::byte_buffer&  pBuffer,
+        const std::uint32_t pValue,
+        const std::size_t   pBytes = 4
+    )
+    {
+        for (std::size_t i = 0; i < pBytes; ++i)
+        {
+            pBuffer.push_back(static_cast<std::uint8_t>(pValue >> (i * 8)));
+        }
+    }
+
+    /**
+     * @brief   Generates an image of gradients and noise, which compresses
+     *          about as well as a photograph.
+     */
+    static astd::byte_buffer MakePixels (
+        const std::size_t   pWidth,
+        const std::size_t   pHeight,
+        const std::size_t   pChannels,
+        const std::uint32_t pSeed
+    )
+    {
+        astd::byte_buffer lPixels(pWidth * pHeight * pChannels);
+        std::uint32_t lState = pSeed;
+        for (std::size_t y = 0; y < pHeight; ++y)
+        {
+            for (std::size_t x = 0; x < pWidth; ++x)
+            {
+                lState = lState * 1664525u + 1013904223u;
+                for (std::size_t c = 0; c < pChannels; ++c)
+                {
+                    const std::size_t lBase = (x * (c + 1) + y * (3 - c % 3)) / 4;
+                    lPixels[(y * pWidth + x) * pChannels + c] =
+                        static_cast<std::uint8_t>(lBase + ((lState >> (8 + c * 4)) & 0x7));
+                }
+            }
+        }
+
+        return lPixels;
+    }
+
+    static std::uint8_t Paeth (
+        const int   pLeft,
+        const int   pUp,
+        const int   pUpLeft
+    )
+    {
+        const int lEstimate = pLeft + pUp - pUpLeft;
+        const int lLeft = std::abs(lEstimate - pLeft);
+        const int lUp = std::abs(lEstimate - pUp);
+        const int lUpLeft = std::abs(lEstimate - pUpLeft);
+        if (lLeft <= lUp && lLeft <= lUpLeft) { return static_cast<std::uint8_t>(pLeft); }
+        return static_cast<std::uint8_t>((lUp <= lUpLeft) ? pUp : pUpLeft);
+    }
+
+    /**
+     * @brief   Encodes packed samples as a `.png` file, cycling through the
+     *          five row filters.
+     */
+    static astd::byte_buffer EncodePng (
+        const astd::byte_buffer&    pSamples,
+        const std::uint32_t         pWidth,
+        const std::uint32_t         pHeight,
+        const std::uint8_t          pDepth,
+        const std::uint8_t          pColorType,
+        const std::size_t           pChannels,
+        const astd::byte_buffer&    pPalette = {},
+        const astd::byte_buffer&    pTransparency = {}
+    )
+    {
+        const std::size_t lRowBytes = (pWidth * pChannels * pDepth + 7) / 8;
+        const std::size_t lStride = std::max<std::size_t>(pChannels * pDepth / 8, 1);
+        astd::byte_buffer lFiltered;
+        for (std::size_t y = 0; y < pHeight; ++y)
+        {
+            const std::uint8_t lFilter = static_cast<std::uint8_t>(y % 5);
+            const std::uint8_t* lRow = pSamples.data() + y * lRowBytes;
+            const std::uint8_t* lAbove = (y > 0) ? lRow - lRowBytes : nullptr;
+            lFiltered.push_back(lFilter);
+            for (std::size_t i = 0; i < lRowBytes; ++i)
+            {
+                const int lLeft = (i >= lStride) ? lRow[i - lStride] : 0;
+                const int lUp = (lAbove != nullptr) ? lAbove[i] : 0;
+                const int lUpLeft = (lAbove != nullptr && i >= lStride) ? lAbove[i - lStride] : 0;
+                const int lPrediction =
+                    (lFilter == 1) ? lLeft :
+                    (lFilter == 2) ? lUp :
+                    (lFilter == 3) ? (lLeft + lUp) / 2 :
+                    (lFilter == 4) ? Paeth(lLeft, lUp, lUpLeft) : 0;
+                lFiltered.push_back(static_cast<std::uint8_t>(lRow[i] - lPrediction));
+            }
+        }
+
+        mz_ulong lCompressedSize = mz_compressBound(static_cast<mz_ulong>(lFiltered.size()));
+        astd::byte_buffer lCompressed(lCompressedSize);
+        mz_compress2(lCompressed.data(), &lCompressedSize, lFiltered.data(),
+            static_cast<mz_ulong>(lFiltered.size()), MZ_DEFAULT_LEVEL);
+        lCompressed.resize(lCompressedSize);
+
+        astd::byte_buffer lFile = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        auto lChunk =
+            [&lFile] (const char* pType, const astd::byte_buffer& pData)
+            {
+                PutBigEndian(lFile, static_cast<std::uint32_t>(pData.size()));
+                const std::size_t lStart = lFile.size();
+                lFile.insert(lFile.end(), pType, pType + 4);
+                lFile.insert(lFile.end(), pData.begin(), pData.end());
+                PutBigEndian(lFile, static_cast<std::uint32_t>(
+                    mz_crc32(MZ_CRC32_INIT, lFile.data() + lStart, lFile.size() - lStart)));
+            };
+
+        astd::byte_buffer lHeader;
+        PutBigEndian(lHeader, pWidth);
+        PutBigEndian(lHeader, pHeight);
+        lHeader.insert(lHeader.end(), { pDepth, pColorType, 0, 0, 0 });
+        lChunk("IHDR", lHeader);
+        if (pPalette.empty() == false) { lChunk("PLTE", pPalette); }
+        if (pTransparency.empty() == false) { lChunk("tRNS", pTransparency); }
+        lChunk("IDAT", lCompressed);
+        lChunk("IEND", {});
+        return lFile;
+    }
+
+    static void WriteFile (
+        const fs::path&             pPath,
+        const astd::byte_buffer&    pData
+    )
+    {
+        std::ofstream { pPath, std::ios::binary }.write(reinterpret_cast<const char*>(pData.data()),
+            static_cast<std::streamsize>(pData.size()));
+    }
+
+    /**
+     * @brief   Checks a loaded texture's first mip against the RGBA pixels it
+     *          should hold.
+     */
+    static bool CheckPixels (
+        const char*                             pName,
+        const ace::AssetHandle<ace::Texture>&   pTexture,
+        const astd::byte_buffer&                pExpected,
+        const std::size_t                       pMipCount
+    )
+    {
+        if (pTexture.IsValid() == false)
+        {
+            std::cerr << "Texture formats: " << pName << " did not load.\n";
+            return false;
+        }
+
+        if (pTexture->mMips.size() != pMipCount || pTexture->mMips[0].mData != pExpected)
+        {
+            std::cerr << "Texture formats: " << pName << " decoded wrongly (" << pTexture->mMips.size()
+                << " mips).\n";
+            return false;
+        }
+
+        return true;
+    }
+
+    bool BenchTextureFormats ()
+    {
+        // One small file of each supported kind is written out, loaded back
+        // through the asset registry, and checked pixel for pixel.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchTextures";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot);
+        ace::VFS::MountPhysicalDirectory("bench-textures", lRoot);
+
+        ace::ThreadPool lPool { 4 };
+        ace::TextureLoaders::RegisterAll({ .mThreadPool = &lPool, .mRowsPerJob = 8 });
+
+        // RGB and RGBA at 8 bits, with every filter.
+        const astd::byte_buffer lRgb = MakePixels(61, 37, 3, 1);
+        astd::byte_buffer lRgbExpected(61 * 37 * 4);
+        ace::TextureConversion::ExpandRGBToRGBA(lRgb.data(), lRgbExpected.data(), 61 * 37);
+        WriteFile(lRoot / "rgb.png", EncodePng(lRgb, 61, 37, 8, 2, 3));
+
+        const astd::byte_buffer lRgba = MakePixels(64, 64, 4, 2);
+        WriteFile(lRoot / "rgba.png", EncodePng(lRgba, 64, 64, 8, 6, 4));
+
+        // A 4-bit palette, with some entries transparent.
+        astd::byte_buffer lPalette;
+        astd::byte_buffer lTransparency;
+        for (std::uint32_t i = 0; i < 16; ++i)
+        {
+            lPalette.insert(lPalette.end(), { std::uint8_t(i * 16), std::uint8_t(255 - i * 8), std::uint8_t(i * 3) });
+            lTransparency.push_back(std::uint8_t(i * 17));
+        }
+
+        astd::byte_buffer lIndices((19 * 4 + 7) / 8 * 11);
+        astd::byte_buffer lPaletteExpected;
+        for (std::size_t y = 0; y < 11; ++y)
+        {
+            for (std::size_t x = 0; x < 19; ++x)
+            {
+                const std::uint8_t lIndex = std::uint8_t((x * 7 + y * 3) % 16);
+                lIndices[y * 10 + x / 2] |= (x % 2 == 0) ? std::uint8_t(lIndex << 4) : lIndex;
+                lPaletteExpected.insert(lPaletteExpected.end(), { lPalette[lIndex * 3], lPalette[lIndex * 3 + 1],
+                    lPalette[lIndex * 3 + 2], lTransparency[lIndex] });
+            }
+        }
+
+        WriteFile(lRoot / "palette.png", EncodePng(lIndices, 19, 11, 4, 3, 1, lPalette, lTransparency));
+
+        // 16-bit greyscale, narrowed to its high bytes.
+        const astd::byte_buffer lGrey16 = MakePixels(9, 6, 2, 3);
+        astd::byte_buffer lGreyExpected;
+        for (std::size_t i = 0; i < 9 * 6; ++i)
+        {
+            const std::uint8_t lValue = lGrey16[i * 2];
+            lGreyExpected.insert(lGreyExpected.end(), { lValue, lValue, lValue, 0xFF });
+        }
+
+        WriteFile(lRoot / "grey16.png", EncodePng(lGrey16, 9, 6, 16, 0, 1));
+
+        // A bottom-up, run-length-encoded 24-bit `.tga`, in runs of four.
+        astd::byte_buffer lTga = { 0, 0, 10, 0, 0, 0, 0, 0, 0, 0, 0, 0, 16, 0, 8, 0, 24, 0 };
+        astd::byte_buffer lTgaExpected(16 * 8 * 4);
+        for (std::size_t lRow = 0; lRow < 8; ++lRow)
+        {
+            const std::size_t y = 7 - lRow;
+            for (std::size_t x = 0; x < 16; x += 4)
+            {
+                const std::uint8_t lBlue = std::uint8_t(x * 10);
+                const std::uint8_t lGreen = std::uint8_t(y * 20);
+                const std::uint8_t lRed = std::uint8_t(200 - x);
+                lTga.insert(lTga.end(), { 0x83, lBlue, lGreen, lRed });
+                for (std::size_t i = 0; i < 4; ++i)
+                {
+                    std::memcpy(lTgaExpected.data() + (y * 16 + x + i) * 4,
+                        std::array<std::uint8_t, 4> { lRed, lGreen, lBlue, 0xFF }.data(), 4);
+                }
+            }
+        }
+
+        WriteFile(lRoot / "rle.tga", lTga);
+
+        // A legacy BGRA `.dds` without mips, and a `DX10` BC1 one with them.
+        astd::byte_buffer lDds;
+        auto lDdsHeader =
+            [&lDds] (const std::uint32_t pWidth, const std::uint32_t pHeight, const std::uint32_t pMips,
+                const std::uint32_t pFlags, const std::uint32_t pFourCC, const std::uint32_t pRedMask)
+            {
+                lDds.clear();
+                PutLittleEndian(lDds, 0x20534444);
+                PutLittleEndian(lDds, 124);
+                PutLittleEndian(lDds, 0x1007 | 0x20000);
+                PutLittleEndian(lDds, pHeight);
+                PutLittleEndian(lDds, pWidth);
+                PutLittleEndian(lDds, 0);
+                PutLittleEndian(lDds, 0);
+                PutLittleEndian(lDds, pMips);
+                lDds.resize(76, 0);
+                PutLittleEndian(lDds, 32);
+                PutLittleEndian(lDds, pFlags);
+                PutLittleEndian(lDds, pFourCC);
+                PutLittleEndian(lDds, (pFourCC == 0) ? 32 : 0);
+                PutLittleEndian(lDds, pRedMask);
+                PutLittleEndian(lDds, 0x0000FF00);
+                PutLittleEndian(lDds, (pRedMask == 0x00FF0000) ? 0x000000FF : 0x00FF0000);
+                PutLittleEndian(lDds, 0xFF000000);
+                lDds.resize(128, 0);
+            };
+
+        const astd::byte_buffer lBgra = MakePixels(32, 32, 4, 4);
+        astd::byte_buffer lBgraExpected = lBgra;
+        ace::TextureConversion::SwizzleBGRAToRGBA(lBgraExpected.data(), 32 * 32);
+        lDdsHeader(32, 32, 1, 0x41, 0, 0x00FF0000);
+        lDds.insert(lDds.end(), lBgra.begin(), lBgra.end());
+        WriteFile(lRoot / "bgra.dds", lDds);
+
+        lDdsHeader(16, 8, 5, 0x4, 0x30315844, 0);
+        PutLittleEndian(lDds, 71);
+        PutLittleEndian(lDds, 3);
+        PutLittleEndian(lDds, 0);
+        PutLittleEndian(lDds, 1);
+        PutLittleEndian(lDds, 0);
+        const astd::byte_buffer lBlocks = MakePixels(8 * (8 + 2 + 1 + 1 + 1), 1, 1, 5);
+        lDds.insert(lDds.end(), lBlocks.begin(), lBlocks.end());
+        WriteFile(lRoot / "bc1.dds", lDds);
+
+        // An sRGB `.ktx` with a single mip.
+        astd::byte_buffer lKtx = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+        for (const std::uint32_t lField : { 0x04030201u, 0x1401u, 1u, 0x1908u, 0x8C43u, 0x1908u, 8u, 4u, 0u, 0u, 1u, 1u, 0u })
+        {
+            PutLittleEndian(lKtx, lField);
+        }
+
+        const astd::byte_buffer lKtxPixels = MakePixels(8, 4, 4, 6);
+        PutLittleEndian(lKtx, static_cast<std::uint32_t>(lKtxPixels.size()));
+        lKtx.insert(lKtx.end(), lKtxPixels.begin(), lKtxPixels.end());
+        WriteFile(lRoot / "srgb.ktx", lKtx);
+
+        using ace::AssetRegistry;
+        using ace::Texture;
+        if (
+            CheckPixels("rgb.png", AssetRegistry::Load<Texture>("bench-textures/rgb.png"), lRgbExpected, 6) == false ||
+            CheckPixels("rgba.png", AssetRegistry::Load<Texture>("bench-textures/rgba.png"), lRgba, 7) == false ||
+            CheckPixels("palette.png", AssetRegistry::Load<Texture>("bench-textures/palette.png"), lPaletteExpected, 5) == false ||
+            CheckPixels("grey16.png", AssetRegistry::Load<Texture>("bench-textures/grey16.png"), lGreyExpected, 4) == false ||
+            CheckPixels("rle.tga", AssetRegistry::Load<Texture>("bench-textures/rle.tga"), lTgaExpected, 5) == false ||
+            CheckPixels("bgra.dds", AssetRegistry::Load<Texture>("bench-textures/bgra.dds"), lBgraExpected, 6) == false ||
+            CheckPixels("srgb.ktx", AssetRegistry::Load<Texture>("bench-textures/srgb.ktx"), lKtxPixels, 4) == false
+        )
+        {
+            return false;
+        }
+
+        const auto lBc1 = AssetRegistry::Load<Texture>("bench-textures/bc1.dds");
+        if (
+            lBc1.IsValid() == false || lBc1->mFormat != ace::TextureFormat::BC1 || lBc1->mSrgb == true ||
+            lBc1->mMips.size() != 5 || lBc1->mMips[4].mData.size() != 8 ||
+            std::equal(lBc1->mMips[0].mData.begin(), lBc1->mMips[0].mData.end(), lBlocks.begin()) == false
+        )
+        {
+            std::cerr << "Texture formats: bc1.dds was not read correctly.\n";
+            return false;
+        }
+
+        // A mip of black and white is the mid-grey of linear space, which
+        // sRGB encodes brighter than half.
+        ace::Texture lChecker;
+        lChecker.mSrgb = true;
+        lChecker.mMips.push_back({ 2, 2, { 0, 0, 0, 255, 255, 255, 255, 255, 255, 255, 255, 255, 0, 0, 0, 255 } });
+        ace::TextureConversion::GenerateMips(lChecker);
+        const std::uint8_t lGrey = lChecker.mMips[1].mData[0];
+        ace::TextureConversion::ConvertToLinear(lChecker);
+        const float lLinear = reinterpret_cast<const float*>(lChecker.mMips[0].mData.data())[4];
+        if (lGrey < 186 || lGrey > 189 || lLinear != 1.0f)
+        {
+            std::cerr << "Texture formats: sRGB mips or conversion are wrong (grey " << int(lGrey) << ").\n";
+            return false;
+        }
+
+        std::cout << "Texture formats: PNG (RGB, RGBA, 4-bit palette, 16-bit grey), RLE TGA, BGRA and BC1 DDS, "
+            "and sRGB KTX all decoded correctly.\n";
+        return true;
+    }
+
+    bool BenchTextureDecode ()
+    {
+        // Large photographic PNGs are decoded, with mips, on the loading
+        // thread alone and with rows spread across a pool; both must agree.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchTextureDecode";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot);
+        ace::VFS::MountPhysicalDirectory("bench-decode", lRoot);
+
+        std::size_t lFileBytes = 0;
+        for (std::size_t i = 0; i < LARGE_COUNT; ++i)
+        {
+            const astd::byte_buffer lPng = EncodePng(MakePixels(LARGE_SIZE, LARGE_SIZE, 3, std::uint32_t(i + 10)),
+                LARGE_SIZE, LARGE_SIZE, 8, 2, 3);
+            lFileBytes += lPng.size();
+            WriteFile(lRoot / std::format("large{}.png", i), lPng);
+        }
+
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+        ace::PngTextureLoader lSerial { {} };
+        ace::PngTextureLoader lPooled { { .mThreadPool = &lPool } };
+
+        std::chrono::duration<double, std::milli> lSerialTime {};
+        std::chrono::duration<double, std::milli> lPooledTime {};
+        for (std::size_t i = 0; i < LARGE_COUNT; ++i)
+        {
+            const std::string lPath = std::format("bench-decode/large{}.png", i);
+            auto lStart = std::chrono::steady_clock::now();
+            const auto lFirst = lSerial.Load(lPath, ace::VFS::OpenFile(lPath));
+            lSerialTime += std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            const auto lSecond = lPooled.Load(lPath, ace::VFS::OpenFile(lPath));
+            lPooledTime += std::chrono::steady_clock::now() - lStart;
+
+            if (
+                lFirst == nullptr || lSecond == nullptr || lFirst->mMips.size() != 11 ||
+                lSecond->mMips.size() != lFirst->mMips.size()
+            )
+            {
+                std::cerr << "Texture decode: " << lPath << " did not load.\n";
+                return false;
+            }
+
+            for (std::size_t m = 0; m < lFirst->mMips.size(); ++m)
+            {
+                if (lFirst->mMips[m].mData != lSecond->mMips[m].mData)
+                {
+                    std::cerr << "Texture decode: Mip " << m << " of " << lPath << " differs between runs.\n";
+                    return false;
+                }
+            }
+        }
+
+        const double lMegapixels = double(LARGE_SIZE * LARGE_SIZE * LARGE_COUNT) / 1e6;
+        std::cout << std::format(
+            "Texture decode: {} {}x{} PNGs ({:.1f} MB) with mips. Serial: {:.1f} ms ({:.1f} MP/s); "
+            "{} workers: {:.1f} ms ({:.1f} MP/s).\n",
+            LARGE_COUNT, LARGE_SIZE, LARGE_SIZE, double(lFileBytes) / 1e6,
+            lSerialTime.count(), lMegapixels / (lSerialTime.count() / 1000.0),
+            lPool.GetThreadCount(), lPooledTime.count(), lMegapixels / (lPooledTime.count() / 1000.0)
+        );
+
+        return true;
+    }
+
+    /**
+     * @brief   Measures the peak signal-to-noise ratio of a decompressed
+     *          texture's first mip, over the channels its format keeps.
+     */
+    static double MeasurePsnr (
+        const ace::TextureMip&  pOriginal,
+        const ace::TextureMip&  pDecompressed,
+        const std::size_t       pChannelCount
+    )
+    {
+        double lSquaredError = 0.0;
+        for (std::size_t i = 0; i < pOriginal.mData.size(); i += 4)
+        {
+            for (std::size_t c = 0; c < pChannelCount; ++c)
+            {
+                const double lDelta = double(pOriginal.mData[i + c]) - double(pDecompressed.mData[i + c]);
+                lSquaredError += lDelta * lDelta;
+            }
+        }
+
+        const double lMean = lSquaredError / double(pOriginal.mData.size() / 4 * pChannelCount);
+        return (lMean > 0.0) ? 10.0 * std::log10(255.0 * 255.0 / lMean) : 99.0;
+    }
+
+    bool BenchTextureCompression ()
+    {
+        // A photographic texture, with an alpha gradient, is compressed into
+        // each block format on one thread and across a pool; the results
+        // must agree, and must decompress close to the original.
+        ace::Texture lSource;
+        lSource.mSrgb = true;
+        lSource.mMips.push_back({ COMPRESSED_SIZE, COMPRESSED_SIZE, MakePixels(COMPRESSED_SIZE, COMPRESSED_SIZE, 4, 7) });
+        ace::TextureConversion::GenerateMips(lSource);
+
+        std::size_t lSourceBytes = 0;
+        for (const auto& lMip : lSource.mMips)
+        {
+            lSourceBytes += lMip.mData.size();
+        }
+
+        ace::ThreadPool lPool { std::max<std::size_t>(std::thread::hardware_concurrency(), 4) };
+
+        struct Case { ace::TextureFormat mFormat; const char* mName; std::size_t mChannels; };
+        for (const Case& lCase : {
+            Case { ace::TextureFormat::BC1, "BC1", 3 },
+            Case { ace::TextureFormat::BC3, "BC3", 4 },
+            Case { ace::TextureFormat::BC5, "BC5", 2 },
+            Case { ace::TextureFormat::BC7, "BC7", 4 }
+        })
+        {
+            auto lStart = std::chrono::steady_clock::now();
+            const auto lSerial = ace::TextureCompressor::Compress(lSource, lCase.mFormat);
+            const std::chrono::duration<double, std::milli> lSerialTime = std::chrono::steady_clock::now() - lStart;
+
+            lStart = std::chrono::steady_clock::now();
+            const auto lPooled = ace::TextureCompressor::Compress(lSource, lCase.mFormat, &lPool);
+            const std::chrono::duration<double, std::milli> lPooledTime = std::chrono::steady_clock::now() - lStart;
+
+            std::size_t lCompressedBytes = 0;
+            for (std::size_t m = 0; m < lSerial->mMips.size(); ++m)
+            {
+                lCompressedBytes += lSerial->mMips[m].mData.size();
+                if (lSerial->mMips[m].mData != lPooled->mMips[m].mData)
+                {
+                    std::cerr << "Texture compression: " << lCase.mName << " mip " << m << " differs between runs.\n";
+                    return false;
+                }
+            }
+
+            const auto lDecompressed = ace::TextureCompressor::Decompress(*lPooled, &lPool);
+            const double lPsnr = MeasurePsnr(lSource.mMips[0], lDecompressed->mMips[0], lCase.mChannels);
+            if (lPsnr < MINIMUM_PSNR || lDecompressed->mMips.size() != lSource.mMips.size())
+            {
+                std::cerr << "Texture compression: " << lCase.mName << " PSNR is only " << lPsnr << " dB.\n";
+                return false;
+            }
+
+            std::cout << std::format(
+                "Texture compression: {} at {}x{} with mips, {:.1f}x smaller, {:.2f} dB PSNR. "
+                "Serial: {:.1f} ms; {} workers: {:.1f} ms.\n",
+                lCase.mName, COMPRESSED_SIZE, COMPRESSED_SIZE, double(lSourceBytes) / double(lCompressedBytes),
+                lPsnr, lSerialTime.count(), lPool.GetThreadCount(), lPooledTime.count()
+            );
+        }
+
+        // Cooking through the loaders stores the compressed texture in the
+        // derived-data cache, so the second load reads it back as it is.
+        const fs::path lRoot = fs::temp_directory_path() / "AceBenchTextureCooking";
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        fs::create_directories(lRoot / "source");
+        ace::VFS::MountPhysicalDirectory("bench-cook", lRoot / "source");
+        WriteFile(lRoot / "source" / "albedo.png", EncodePng(MakePixels(LARGE_SIZE, LARGE_SIZE, 3, 8),
+            LARGE_SIZE, LARGE_SIZE, 8, 2, 3));
+
+        auto lCache = std::make_shared<ace::DerivedDataCache>(lRoot / "ddc", "bench-cook-ddc");
+        ace::PngTextureLoader lLoader { {
+            .mThreadPool = &lPool,
+            .mCompression = ace::TextureFormat::BC7,
+            .mCache = lCache
+        } };
+
+        auto lStart = std::chrono::steady_clock::now();
+        const auto lCooked = lLoader.Load("bench-cook/albedo.png", ace::VFS::OpenFile("bench-cook/albedo.png"));
+        const std::chrono::duration<double, std::milli> lCookTime = std::chrono::steady_clock::now() - lStart;
+
+        lStart = std::chrono::steady_clock::now();
+        const auto lCached = lLoader.Load("bench-cook/albedo.png", ace::VFS::OpenFile("bench-cook/albedo.png"));
+        const std::chrono::duration<double, std::milli> lCachedTime = std::chrono::steady_clock::now() - lStart;
+
+        if (
+            lCooked == nullptr || lCached == nullptr || lCooked->mFormat != ace::TextureFormat::BC7 ||
+            lCache->GetHitCount() != 1 || lCached->Serialize() != lCooked->Serialize()
+        )
+        {
+            std::cerr << "Texture compression: The cooked texture was not cached and read back intact.\n";
+            return false;
+        }
+
+        std::cout << std::format(
+            "Texture compression: {}x{} PNG cooked to BC7 in {:.1f} ms; loaded from the cache in {:.1f} ms.\n",
+            LARGE_SIZE, LARGE_SIZE, lCookTime.count(), lCachedTime.count()
+        );
+
+        return true;
+    }
+}
@@ -0,0 +1,15 @@
+/**
+ * @file    Benchmarks/BenchTextures.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/Texture.hpp>
+#include <Ace/Graphics/TextureCompressor.hpp>
+#include <Ace/Graphics/TextureLoaders.hpp>
+
+namespace AceTextures
+{
+    bool BenchTextureFormats ();
+    bool BenchTextureDecode ();
+    bool BenchTextureCompression ();
+}
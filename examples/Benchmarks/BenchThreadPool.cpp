@@ -0,0 +1,260 @@
+/**
+ * @file    Benchmarks/BenchThreadPool.cpp
+ */
+
+#include <iostream>
+#include <Benchmarks/BenchThreadPool.hpp>
+
+namespace AceThreadPool
+{
+    static constexpr std::size_t BLOCK_SIZE = 8 * 1024 * 1024;
+    static constexpr std::size_t PASS_COUNT = 8;
+    static constexpr std::size_t TIMER_COUNT = 1'000'000;
+    static constexpr std::uint64_t TIMER_SPAN = 600'000;
+    static constexpr std::size_t TASK_COUNT = 1000;
+
+    /**
+     * @brief   Sums blocks of memory allocated on each worker's own node, so
+     *          that a placement which keeps workers near their memory reads
+     *          it at local bandwidth.
+     */
+    static bool RunPlacement (
+        const ace::ThreadPlacement  pPlacement,
+        const char*                 pName
+    )
+    {
+        ace::ThreadPool lPool { ace::ThreadPoolSpec {
+            .mThreadCount   = std::thread::hardware_concurrency(),
+            .mPlacement     = pPlacement,
+            .mReservedCores = 0
+        } };
+
+        // Allocate and fill one block per worker, from a task on that
+        // worker's node, so the pages are first touched there.
+        const std::size_t lBlockCount = std::max<std::size_t>(lPool.GetThreadCount(), 1);
+        const std::size_t lValueCount = BLOCK_SIZE / sizeof(std::uint64_t);
+        std::vector<std::uint64_t*> lBlocks(lBlockCount, nullptr);
+        std::vector<std::uint32_t> lNodes(lBlockCount, 0);
+        std::vector<std::future<void>> lFutures;
+        for (std::size_t i = 0; i < lBlockCount; ++i)
+        {
+            lFutures.push_back(lPool.Enqueue(
+                [&, i] () -> void
+                {
+                    lNodes[i] = lPool.GetCurrentNode().value_or(0);
+                    lBlocks[i] = static_cast<std::uint64_t*>(ace::CpuTopology::AllocateOnNode(
+                        BLOCK_SIZE, ace::CpuTopology::Get().GetNodeId(lNodes[i])));
+                    for (std::size_t j = 0; j < lValueCount; ++j)
+                    {
+                        lBlocks[i][j] = j;
+                    }
+                }));
+        }
+
+        for (auto& lFuture : lFutures)
+        {
+            lFuture.get();
+        }
+
+        // Sum every block on its own node, several times over.
+        std::atomic<std::uint64_t> lTotal { 0 };
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t lPass = 0; lPass < PASS_COUNT; ++lPass)
+        {
+            lFutures.clear();
+            for (std::size_t i = 0; i < lBlockCount; ++i)
+            {
+                lFutures.push_back(lPool.EnqueueOnNode(lNodes[i],
+                    [&, i] () -> void
+                    {
+                        std::uint64_t lSum = 0;
+                        for (std::size_t j = 0; j < lValueCount; ++j)
+                        {
+                            lSum += lBlocks[i][j];
+                        }
+
+                        lTotal.fetch_add(lSum, std::memory_order_relaxed);
+                    }));
+            }
+
+            for (auto& lFuture : lFutures)
+            {
+                lFuture.get();
+            }
+        }
+        std::chrono::duration<double> lElapsed = std::chrono::steady_clock::now() - lStart;
+
+        for (auto* lBlock : lBlocks)
+        {
+            ace::CpuTopology::FreeOnNode(lBlock, BLOCK_SIZE);
+        }
+
+        const std::uint64_t lExpected = PASS_COUNT * lBlockCount *
+            (lValueCount * (lValueCount - 1) / 2);
+        if (lTotal.load() != lExpected)
+        {
+            std::cerr << "ThreadPool: '" << pName << "' summed " << lTotal.load()
+                << "; expected " << lExpected << ".\n";
+            return false;
+        }
+
+        const double lBytes = static_cast<double>(PASS_COUNT * lBlockCount * BLOCK_SIZE);
+        std::cout << std::format(
+            "ThreadPool: '{}' placement, {} workers over {} queues: {:.2f} GB/s.\n",
+            pName, lPool.GetThreadCount(), lPool.GetQueueCount(),
+            lBytes / lElapsed.count() / 1.0e9
+        );
+
+        return true;
+    }
+
+    bool BenchPlacements ()
+    {
+        const auto& lTopology = ace::CpuTopology::Get();
+        std::cout << std::format(
+            "ThreadPool: {} CPUs on {} physical cores across {} NUMA nodes.\n",
+            lTopology.GetCpus().size(), lTopology.GetCoreCount(), lTopology.GetNodeCount()
+        );
+
+        return
+            RunPlacement(ace::ThreadPlacement::None, "none") == true &&
+            RunPlacement(ace::ThreadPlacement::PhysicalCores, "cores") == true &&
+            RunPlacement(ace::ThreadPlacement::NumaNodes, "nodes") == true;
+    }
+
+    bool BenchTimerWheel ()
+    {
+        // Schedule a million timers up to ten minutes of 1 ms ticks out, then
+        // cancel every other one.
+        ace::TimerWheel lWheel {};
+        std::mt19937_64 lRandom { 87 };
+        std::uniform_int_distribution<std::uint64_t> lDeadlines { 1, TIMER_SPAN };
+        std::size_t lFired = 0;
+        std::vector<ace::TimerId> lTimers;
+        lTimers.reserve(TIMER_COUNT);
+
+        auto lStart = std::chrono::steady_clock::now();
+        for (std::size_t i = 0; i < TIMER_COUNT; ++i)
+        {
+            lTimers.push_back(lWheel.Schedule(lDeadlines(lRandom), [&lFired] { ++lFired; }));
+        }
+        auto lScheduled = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < TIMER_COUNT; i += 2)
+        {
+            if (lWheel.Cancel(lTimers[i]) == false)
+            {
+                std::cerr << "TimerWheel: Could not cancel timer " << i << ".\n";
+                return false;
+            }
+        }
+        auto lCancelled = std::chrono::steady_clock::now();
+
+        // Turn the wheel a second at a time, running what expires.
+        std::vector<std::function<void()>> lExpired;
+        std::uint64_t lLastDeadline = 0;
+        for (std::uint64_t lTick = 0; lTick <= TIMER_SPAN; lTick += 1000)
+        {
+            lWheel.Advance(lTick, lExpired);
+            for (auto& lCallback : lExpired)
+            {
+                lCallback();
+            }
+
+            lExpired.clear();
+            lLastDeadline = lTick;
+        }
+        auto lAdvanced = std::chrono::steady_clock::now();
+
+        if (lFired != TIMER_COUNT / 2 || lWheel.GetCount() != 0 || lWheel.Cancel(lTimers[1]) == true)
+        {
+            std::cerr << "TimerWheel: " << lFired << " timers fired by tick " << lLastDeadline
+                << "; expected " << TIMER_COUNT / 2 << ".\n";
+            return false;
+        }
+
+        using Nanoseconds = std::chrono::duration<double, std::nano>;
+        std::cout << std::format(
+            "TimerWheel: {} timers: {:.1f} ns per schedule, {:.1f} ns per cancel, "
+            "{:.1f} ns per expiry.\n",
+            TIMER_COUNT,
+            Nanoseconds { lScheduled - lStart }.count() / TIMER_COUNT,
+            Nanoseconds { lCancelled - lScheduled }.count() / (TIMER_COUNT / 2),
+            Nanoseconds { lAdvanced - lCancelled }.count() / (TIMER_COUNT / 2)
+        );
+
+        return true;
+    }
+
+    bool BenchScheduledTasks ()
+    {
+        using Clock = ace::ThreadPool::Clock;
+        ace::ThreadPool lPool {};
+
+        // Schedule tasks up to 50 ms out, and measure how late each runs.
+        std::mutex lMutex;
+        std::vector<double> lLateness;
+        std::vector<std::future<void>> lDone;
+        std::mt19937 lRandom { 87 };
+        std::uniform_int_distribution<int> lDelays { 1, 50 };
+        for (std::size_t i = 0; i < TASK_COUNT; ++i)
+        {
+            auto lPromise = std::make_shared<std::promise<void>>();
+            lDone.push_back(lPromise->get_future());
+            const Clock::time_point lDue = Clock::now() + std::chrono::milliseconds { lDelays(lRandom) };
+            lPool.EnqueueAt(lDue,
+                [&, lDue, lPromise] () -> void
+                {
+                    std::lock_guard lGuard { lMutex };
+                    lLateness.push_back(std::chrono::duration<double, std::milli> {
+                        Clock::now() - lDue }.count());
+                    lPromise->set_value();
+                });
+        }
+
+        // A repeating task alongside, and one which is cancelled before it
+        // comes due.
+        std::atomic<std::size_t> lRepeats { 0 };
+        auto lRepeating = lPool.EnqueueEvery(std::chrono::milliseconds { 5 },
+            [&] { lRepeats.fetch_add(1); });
+        std::atomic<bool> lCancelledRan { false };
+        auto lCancelled = lPool.EnqueueAfter(std::chrono::milliseconds { 20 },
+            [&] { lCancelledRan = true; });
+        if (lPool.CancelTimer(lCancelled) == false)
+        {
+            std::cerr << "ThreadPool: Could not cancel a scheduled task.\n";
+            return false;
+        }
+
+        for (auto& lFuture : lDone)
+        {
+            lFuture.get();
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds { 20 });
+        lPool.CancelTimer(lRepeating);
+
+        const double lWorst = *std::max_element(lLateness.begin(), lLateness.end());
+        const double lEarliest = *std::min_element(lLateness.begin(), lLateness.end());
+        double lAverage = 0.0;
+        for (const double lValue : lLateness)
+        {
+            lAverage += lValue / lLateness.size();
+        }
+
+        std::cout << std::format(
+            "ThreadPool: {} scheduled tasks ran {:.3f} ms late on average, {:.3f} ms at worst; "
+            "a 5 ms repeating task ran {} times.\n",
+            TASK_COUNT, lAverage, lWorst, lRepeats.load()
+        );
+
+        if (lEarliest < 0.0 || lCancelledRan == true || lRepeats.load() < 5)
+        {
+            std::cerr << "ThreadPool: A scheduled task ran early, was not cancelled, or "
+                "a repeating task did not repeat.\n";
+            return false;
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,15 @@
+/**
+ * @file    Benchmarks/BenchThreadPool.hpp
+ */
+
+#pragma once
+#include <Ace/System/CpuTopology.hpp>
+#include <Ace/System/ThreadPool.hpp>
+#include <Ace/System/TimerWheel.hpp>
+
+namespace AceThreadPool
+{
+    bool BenchPlacements ();
+    bool BenchTimerWheel ();
+    bool BenchScheduledTasks ();
+}
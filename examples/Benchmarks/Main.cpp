@@ -0,0 +1,66 @@
+#define ACE_USE_OWN_MAIN
+#include <iostream>
+#include <string>
+#include <functional>
+#include <Benchmarks/BenchAnimation.hpp>
+#include <Benchmarks/BenchAudioMixer.hpp>
+#include <Benchmarks/BenchContainers.hpp>
+#include <Benchmarks/BenchFilesystem.hpp>
+#include <Benchmarks/BenchJobSystem.hpp>
+#include <Benchmarks/BenchMeshes.hpp>
+#include <Benchmarks/BenchNetworking.hpp>
+#include <Benchmarks/BenchParticles.hpp>
+#include <Benchmarks/BenchPhysics.hpp>
+#include <Benchmarks/BenchScripting.hpp>
+#include <Benchmarks/BenchShaders.hpp>
+#include <Benchmarks/BenchTextures.hpp>
+#include <Benchmarks/BenchThreadPool.hpp>
+
+#define FN(F) { #F, F }
+
+static const std::vector<std::pair<std::string, std::function<bool()>>>
+    BenchmarkFunctions = {
+        FN(AceAnimation::BenchClipCompression),
+        FN(AceAnimation::BenchCrowdEvaluation),
+        FN(AceAudioMixer::BenchMixVoices),
+        FN(AceContainers::BenchConcurrentVector),
+        FN(AceContainers::BenchConcurrentFreeList),
+        FN(AceContainers::BenchConcurrentSkipList),
+        FN(AceContainers::BenchEpochReclamation),
+        FN(AceFilesystem::BenchWritableFiles),
+        FN(AceFilesystem::BenchAtomicReplace),
+        FN(AceJobSystem::BenchLoaderJobs),
+        FN(AceJobSystem::BenchParallelFor),
+        FN(AceMeshes::BenchMeshCooking),
+        FN(AceMeshes::BenchMeshLods),
+        FN(AceNetworking::BenchLoopbackReliable),
+        FN(AceNetworking::BenchUdpReliable),
+        FN(AceNetworking::BenchSnapshotReplication),
+        FN(AceParticles::BenchParticleUpdate),
+        FN(AcePhysics::BenchBroadphase),
+        FN(AcePhysics::BenchRigidBodies),
+        FN(AceScripting::BenchScriptColdStart),
+        FN(AceScripting::BenchScriptCalls),
+        FN(AceShaders::BenchShaderCache),
+        FN(AceTextures::BenchTextureFormats),
+        FN(AceTextures::BenchTextureDecode),
+        FN(AceTextures::BenchTextureCompression),
+        FN(AceThreadPool::BenchPlacements),
+        FN(AceThreadPool::BenchTimerWheel),
+        FN(AceThreadPool::BenchScheduledTasks)
+    };
+
+int main ()
+{
+    for (const auto& p : BenchmarkFunctions)
+    {
+        if (p.second() == false)
+        {
+            std::cerr << "Benchmark '" << p.first << "' failed." << std::endl;
+            return 1;
+        }
+    }
+
+    std::cout << "All benchmarks completed.\n";
+    return 0;
+}
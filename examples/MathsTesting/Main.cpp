@@ -11,6 +11,17 @@
 #include <MathsTesting/TestQuat4.hpp>
 #include <MathsTesting/TestTransform.hpp>
 #include <MathsTesting/TestProjection.hpp>
+#include <MathsTesting/TestAABB3.hpp>
+#include <MathsTesting/TestSoftwareRasterizer.hpp>
+#include <MathsTesting/TestRenderQueue.hpp>
+#include <MathsTesting/TestStagingRing.hpp>
+#include <MathsTesting/TestInputPipeline.hpp>
+#include <MathsTesting/TestSettings.hpp>
+#include <MathsTesting/TestEpochReclaimer.hpp>
+#include <MathsTesting/TestVirtualLocalFile.hpp>
+#include <MathsTesting/TestTextureLoaders.hpp>
+#include <MathsTesting/TestVirtualFilesystem.hpp>
+#include <MathsTesting/TestWorldStreamer.hpp>
 
 #define FN(F) { #F, F }
 
@@ -72,6 +83,8 @@ static const std::unordered_map<std::string, std::function<bool()>>
         FN(AceQuat4::TestSphericalLerp),
         FN(AceQuat4::TestSphericalLerp180),
         FN(AceQuat4::TestRotate),
+        FN(AceQuat4::TestMultiply),
+        FN(AceQuat4::TestToMatrix3),
         FN(AceTransform::TestScale),
         FN(AceTransform::TestTranslate),
         FN(AceTransform::TestRotateX),
@@ -81,7 +94,48 @@ static const std::unordered_map<std::string, std::function<bool()>>
         FN(AceTransform::TestLookAt),
         FN(AceProjection::TestOrtho),
         FN(AceProjection::TestOrthoExtent),
-        FN(AceProjection::TestPerspective)
+        FN(AceProjection::TestPerspective),
+        FN(AceAABB3::TestBasic),
+        FN(AceAABB3::TestContains),
+        FN(AceAABB3::TestIntersects),
+        FN(AceAABB3::TestMerge),
+        FN(AceAABB3::TestDistance),
+        FN(AceSoftwareRasterizer::TestExactPixels),
+        FN(AceSoftwareRasterizer::TestSharedEdges),
+        FN(AceSoftwareRasterizer::TestTopLeftRule),
+        FN(AceSoftwareRasterizer::TestThreadCountDeterminism),
+        FN(AceRenderQueue::TestEmptyAndSingle),
+        FN(AceRenderQueue::TestSortedAcrossRuns),
+        FN(AceRenderQueue::TestStableEqualKeys),
+        FN(AceStagingRing::TestFullRing),
+        FN(AceStagingRing::TestWraparound),
+        FN(AceStagingRing::TestFenceReclamation),
+        FN(AceInputPipeline::TestPressRelease),
+        FN(AceInputPipeline::TestSubFrameTap),
+        FN(AceInputPipeline::TestMouseAccumulation),
+        FN(AceInputPipeline::TestOverflowDrops),
+        FN(AceInputPipeline::TestSpscOrdering),
+        FN(AceSettings::TestParsing),
+        FN(AceSettings::TestMalformed),
+        FN(AceSettings::TestConversion),
+        FN(AceSettings::TestMissingKeys),
+        FN(AceSettings::TestFramerate),
+        FN(AceEpochReclaimer::TestGuardDefersFree),
+        FN(AceEpochReclaimer::TestRetireInsideOuterGuard),
+        FN(AceVirtualLocalFile::TestMapAfterReplace),
+        FN(AceVirtualLocalFile::TestMapAfterTruncate),
+        FN(AceVirtualLocalFile::TestConcurrentAtomicWrites),
+        FN(AceVirtualLocalFile::TestFailedWriteSize),
+        FN(AceTextureLoaders::TestDdsDimensions),
+        FN(AceTextureLoaders::TestPngDimensions),
+        FN(AceTextureLoaders::TestMipSizeBounds),
+        FN(AceVirtualFilesystem::TestConcurrentMounting),
+        FN(AceVirtualFilesystem::TestUnmount),
+        FN(AceVirtualFilesystem::TestCacheUnmounts),
+        FN(AceWorldStreamer::TestLoadOrder),
+        FN(AceWorldStreamer::TestHysteresis),
+        FN(AceWorldStreamer::TestBudgetEviction),
+        FN(AceWorldStreamer::TestFailureRetry)
     };
 
 int main ()
@@ -0,0 +1,65 @@
+/**
+ * @file    MathsTesting/TestAABB3.cpp
+ */
+
+#include <MathsTesting/TestAABB3.hpp>
+
+namespace AceAABB3
+{
+    static constexpr ace::AABB3f a { { 0.0f, 0.0f, 0.0f }, { 2.0f, 4.0f, 6.0f } };
+    static constexpr ace::AABB3f b { { 1.0f, 1.0f, 1.0f }, { 3.0f, 3.0f, 3.0f } };
+
+    bool TestBasic ()
+    {
+        return
+            a.Center() == ace::Vector3f { 1.0f, 2.0f, 3.0f } &&
+            a.Size() == ace::Vector3f { 2.0f, 4.0f, 6.0f } &&
+            a.Extents() == ace::Vector3f { 1.0f, 2.0f, 3.0f } &&
+            ace::EpsilonEqual(a.Volume(), 48.0f) &&
+            ace::EpsilonEqual(a.SurfaceArea(), 88.0f) &&
+            a.IsEmpty() == false &&
+            ace::AABB3f::Empty().IsEmpty() == true &&
+            ace::AABB3f::FromCenterExtents(a.Center(), a.Extents()) == a;
+    }
+
+    bool TestContains ()
+    {
+        return
+            a.Contains(ace::Vector3f { 1.0f, 1.0f, 1.0f }) == true &&
+            a.Contains(ace::Vector3f { 2.0f, 4.0f, 6.0f }) == true &&
+            a.Contains(ace::Vector3f { 2.5f, 1.0f, 1.0f }) == false &&
+            a.Contains(ace::AABB3f { { 0.5f, 0.5f, 0.5f }, { 1.5f, 1.5f, 1.5f } }) == true &&
+            a.Contains(b) == false;
+    }
+
+    bool TestIntersects ()
+    {
+        ace::AABB3f lApart    { { 5.0f, 5.0f, 5.0f }, { 6.0f, 6.0f, 6.0f } };
+        ace::AABB3f lTouching { { 2.0f, 0.0f, 0.0f }, { 3.0f, 1.0f, 1.0f } };
+
+        return
+            ace::Intersects(a, b) == true &&
+            ace::Intersects(a, lApart) == false &&
+            ace::Intersects(a, lTouching) == true;
+    }
+
+    bool TestMerge ()
+    {
+        ace::AABB3f lBox = ace::AABB3f::Empty();
+        lBox.Merge(ace::Vector3f { 1.0f, -1.0f, 2.0f });
+        lBox.Merge(ace::Vector3f { -1.0f, 3.0f, 0.0f });
+
+        return
+            lBox == ace::AABB3f { { -1.0f, -1.0f, 0.0f }, { 1.0f, 3.0f, 2.0f } } &&
+            ace::Union(a, b) == ace::AABB3f { { 0.0f, 0.0f, 0.0f }, { 3.0f, 4.0f, 6.0f } } &&
+            a.Expanded(1.0f) == ace::AABB3f { { -1.0f, -1.0f, -1.0f }, { 3.0f, 5.0f, 7.0f } };
+    }
+
+    bool TestDistance ()
+    {
+        return
+            ace::EpsilonEqual(a.DistanceSquared(ace::Vector3f { 1.0f, 1.0f, 1.0f }), 0.0f) &&
+            ace::EpsilonEqual(a.DistanceSquared(ace::Vector3f { 5.0f, 2.0f, 3.0f }), 9.0f) &&
+            ace::EpsilonEqual(a.DistanceSquared(ace::Vector3f { -1.0f, -1.0f, 3.0f }), 2.0f);
+    }
+}
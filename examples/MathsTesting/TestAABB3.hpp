@@ -0,0 +1,15 @@
+/**
+ * @file    MathsTesting/TestAABB3.hpp
+ */
+
+#pragma once
+#include <Ace/Maths/AABB3.hpp>
+
+namespace AceAABB3
+{
+    bool TestBasic ();
+    bool TestContains ();
+    bool TestIntersects ();
+    bool TestMerge ();
+    bool TestDistance ();
+}
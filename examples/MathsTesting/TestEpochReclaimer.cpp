@@ -0,0 +1,132 @@
+/**
+ * @file    MathsTesting/TestEpochReclaimer.cpp
+ */
+
+#include <thread>
+#include <MathsTesting/TestEpochReclaimer.hpp>
+
+namespace AceEpochReclaimer
+{
+    static std::atomic<bool> sFreed { false };
+
+    /**
+     * @brief   A deleter which frees nothing, but records that it was called.
+     */
+    static void MarkFreed (
+        void*   pMemory
+    )
+    {
+        (void) pMemory;
+        sFreed.store(true, std::memory_order_release);
+    }
+
+    /**
+     * @brief   A reader thread which enters a guard, then holds it until told
+     *          to leave.
+     */
+    class Reader final
+    {
+    public:
+
+        Reader () :
+            mThread { [this] () { Run(); } }
+        {
+            while (mEntered.load(std::memory_order_acquire) == false)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+        ~Reader ()
+        {
+            Leave();
+        }
+
+        void Leave ()
+        {
+            mLeave.store(true, std::memory_order_release);
+            if (mThread.joinable() == true)
+            {
+                mThread.join();
+            }
+        }
+
+    private:
+
+        void Run ()
+        {
+            ace::EpochGuard lGuard;
+            mEntered.store(true, std::memory_order_release);
+            while (mLeave.load(std::memory_order_acquire) == false)
+            {
+                std::this_thread::yield();
+            }
+        }
+
+    private:
+        std::atomic<bool>   mEntered { false };
+        std::atomic<bool>   mLeave { false };
+        std::thread         mThread;
+
+    };
+
+    bool TestGuardDefersFree ()
+    {
+        ace::EpochReclaimer::Synchronize();
+        sFreed.store(false);
+
+        // Memory retired while another thread is inside a guard outlives the
+        // guard, however often the retiring thread quiesces.
+        Reader lReader;
+        ace::EpochReclaimer::Retire(&sFreed, MarkFreed);
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            ace::EpochReclaimer::Quiesce();
+        }
+
+        const bool lDeferred = sFreed.load() == false;
+        lReader.Leave();
+
+        ace::EpochReclaimer::Synchronize();
+        return lDeferred == true && sFreed.load() == true;
+    }
+
+    bool TestRetireInsideOuterGuard ()
+    {
+        ace::EpochReclaimer::Synchronize();
+        sFreed.store(false);
+
+        // Enter a guard, then let the epoch move forward once, which it may
+        // since this thread entered in the current epoch.
+        std::optional<ace::EpochGuard> lOuter;
+        lOuter.emplace();
+        const std::uint64_t lEpoch = ace::EpochReclaimer::GetEpoch();
+        ace::EpochReclaimer::Synchronize();
+        if (ace::EpochReclaimer::GetEpoch() != lEpoch + 1)
+        {
+            return false;
+        }
+
+        // A reader enters in the later epoch and may load the memory; it is
+        // then unlinked and retired from inside the older, outer guard, as a
+        // structure's erase does.
+        Reader lReader;
+        ace::EpochReclaimer::Retire(&sFreed, MarkFreed);
+        lOuter.reset();
+
+        // Once the outer guard is left, the epoch can move forward again, but
+        // the memory must stay until the reader has left too.
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            ace::EpochReclaimer::Quiesce();
+        }
+
+        const bool lDeferred =
+            ace::EpochReclaimer::GetEpoch() == lEpoch + 2 &&
+            sFreed.load() == false;
+        lReader.Leave();
+
+        ace::EpochReclaimer::Synchronize();
+        return lDeferred == true && sFreed.load() == true;
+    }
+}
@@ -0,0 +1,12 @@
+/**
+ * @file    MathsTesting/TestEpochReclaimer.hpp
+ */
+
+#pragma once
+#include <Ace/System/EpochReclaimer.hpp>
+
+namespace AceEpochReclaimer
+{
+    bool TestGuardDefersFree ();
+    bool TestRetireInsideOuterGuard ();
+}
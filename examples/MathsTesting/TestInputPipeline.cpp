@@ -0,0 +1,208 @@
+/**
+ * @file    MathsTesting/TestInputPipeline.cpp
+ */
+
+#include <thread>
+#include <MathsTesting/TestInputPipeline.hpp>
+
+namespace AceInputPipeline
+{
+    static constexpr std::size_t JUMP = 0;
+    static constexpr std::size_t FIRE = 1;
+    static constexpr std::uint32_t KEY_SPACE = 32;
+    static constexpr std::uint32_t KEY_W = 87;
+    static constexpr std::uint32_t BUTTON_LEFT = 1;
+
+    static bool Matches (
+        const ace::ActionState& pState,
+        const bool              pDown,
+        const bool              pPressed,
+        const bool              pReleased,
+        const std::uint32_t     pPressCount
+    )
+    {
+        return
+            pState.mDown == pDown &&
+            pState.mPressed == pPressed &&
+            pState.mReleased == pReleased &&
+            pState.mPressCount == pPressCount;
+    }
+
+    bool TestPressRelease ()
+    {
+        ace::InputPipeline lPipeline;
+        lPipeline.BindAction(JUMP, ace::InputSource::Key, KEY_SPACE);
+        lPipeline.BindAction(FIRE, ace::InputSource::MouseButton, BUTTON_LEFT);
+        const auto& lSnapshot = lPipeline.GetSnapshot();
+
+        // A record timestamped after the sample time waits for a later frame.
+        lPipeline.Push({ .mTimestamp = 100, .mType = ace::InputEventType::KeyDown, .mCode = KEY_SPACE });
+        lPipeline.Sample(50);
+        const bool lEarly =
+            Matches(lSnapshot.GetAction(JUMP), false, false, false, 0) &&
+            lPipeline.GetFrameRecords().empty() == true;
+
+        lPipeline.Sample(150);
+        const bool lPressed =
+            Matches(lSnapshot.GetAction(JUMP), true, true, false, 1) &&
+            Matches(lSnapshot.GetAction(FIRE), false, false, false, 0) &&
+            lPipeline.GetFrameRecords().size() == 1 &&
+            lSnapshot.mFrame == 2 &&
+            lSnapshot.mSampleTime == 150;
+
+        // Held states carry over; edges do not. Auto-repeats are not presses.
+        lPipeline.Push({ .mTimestamp = 210, .mType = ace::InputEventType::KeyDown, .mCode = KEY_SPACE });
+        lPipeline.Sample(250);
+        const bool lHeld = Matches(lSnapshot.GetAction(JUMP), true, false, false, 0);
+
+        lPipeline.Push({ .mTimestamp = 260, .mType = ace::InputEventType::KeyUp, .mCode = KEY_SPACE });
+        lPipeline.Push({ .mTimestamp = 270, .mType = ace::InputEventType::MouseButtonDown, .mCode = BUTTON_LEFT });
+        lPipeline.Sample(300);
+        const bool lReleased =
+            Matches(lSnapshot.GetAction(JUMP), false, false, true, 0) &&
+            Matches(lSnapshot.GetAction(FIRE), true, true, false, 1);
+
+        // Unbound inputs and unbound actions change nothing.
+        lPipeline.Push({ .mTimestamp = 310, .mType = ace::InputEventType::KeyDown, .mCode = KEY_W });
+        lPipeline.Sample(350);
+        const bool lUnbound =
+            Matches(lSnapshot.GetAction(JUMP), false, false, false, 0) &&
+            Matches(lSnapshot.GetAction(7), false, false, false, 0);
+
+        return lEarly == true && lPressed == true && lHeld == true &&
+            lReleased == true && lUnbound == true;
+    }
+
+    bool TestSubFrameTap ()
+    {
+        ace::InputPipeline lPipeline;
+        lPipeline.BindAction(JUMP, ace::InputSource::Key, KEY_SPACE);
+        lPipeline.BindAction(JUMP, ace::InputSource::Key, KEY_W);
+        const auto& lSnapshot = lPipeline.GetSnapshot();
+
+        // Two taps which both begin and end between samples still register
+        // as presses, even though the action is up at both sample times.
+        lPipeline.Push({ .mTimestamp = 10, .mType = ace::InputEventType::KeyDown, .mCode = KEY_SPACE });
+        lPipeline.Push({ .mTimestamp = 20, .mType = ace::InputEventType::KeyUp, .mCode = KEY_SPACE });
+        lPipeline.Push({ .mTimestamp = 30, .mType = ace::InputEventType::KeyDown, .mCode = KEY_SPACE });
+        lPipeline.Push({ .mTimestamp = 40, .mType = ace::InputEventType::KeyUp, .mCode = KEY_SPACE });
+        lPipeline.Sample(100);
+        const bool lTapped = Matches(lSnapshot.GetAction(JUMP), false, true, true, 2);
+
+        // With two inputs bound, the action stays down until both are up.
+        lPipeline.Push({ .mTimestamp = 110, .mType = ace::InputEventType::KeyDown, .mCode = KEY_SPACE });
+        lPipeline.Push({ .mTimestamp = 120, .mType = ace::InputEventType::KeyDown, .mCode = KEY_W });
+        lPipeline.Push({ .mTimestamp = 130, .mType = ace::InputEventType::KeyUp, .mCode = KEY_SPACE });
+        lPipeline.Sample(200);
+        const bool lOverlapped = Matches(lSnapshot.GetAction(JUMP), true, true, false, 1);
+
+        lPipeline.Push({ .mTimestamp = 210, .mType = ace::InputEventType::KeyUp, .mCode = KEY_W });
+        lPipeline.Sample(300);
+        const bool lReleased = Matches(lSnapshot.GetAction(JUMP), false, false, true, 0);
+
+        return lTapped == true && lOverlapped == true && lReleased == true;
+    }
+
+    bool TestMouseAccumulation ()
+    {
+        ace::InputPipeline lPipeline;
+        const auto& lSnapshot = lPipeline.GetSnapshot();
+
+        // Motion and scrolling accumulate over a frame; the pointer position
+        // is the latest one.
+        lPipeline.Push({ .mTimestamp = 10, .mType = ace::InputEventType::MouseDelta, .mX = 1.0f, .mY = 2.0f });
+        lPipeline.Push({ .mTimestamp = 20, .mType = ace::InputEventType::MouseDelta, .mX = 3.0f, .mY = -1.0f });
+        lPipeline.Push({ .mTimestamp = 30, .mType = ace::InputEventType::MouseScrolled, .mY = 1.0f });
+        lPipeline.Push({ .mTimestamp = 40, .mType = ace::InputEventType::MouseMoved, .mX = 5.0f, .mY = 6.0f });
+        lPipeline.Push({ .mTimestamp = 50, .mType = ace::InputEventType::MouseMoved, .mX = 7.0f, .mY = 8.0f });
+        lPipeline.Sample(100);
+        const bool lAccumulated =
+            lSnapshot.mMouseDelta == ace::Vector2f { 4.0f, 1.0f } &&
+            lSnapshot.mScrollDelta == ace::Vector2f { 0.0f, 1.0f } &&
+            lSnapshot.mMousePosition == ace::Vector2f { 7.0f, 8.0f };
+
+        // The next frame starts the deltas over, but keeps the position.
+        lPipeline.Sample(200);
+        const bool lCleared =
+            lSnapshot.mMouseDelta == ace::Vector2f {} &&
+            lSnapshot.mScrollDelta == ace::Vector2f {} &&
+            lSnapshot.mMousePosition == ace::Vector2f { 7.0f, 8.0f };
+
+        return lAccumulated == true && lCleared == true;
+    }
+
+    bool TestOverflowDrops ()
+    {
+        ace::InputPipeline lPipeline;
+        bool lFilled = true;
+        for (std::size_t i = 0; i < ace::InputPipeline::CAPACITY; ++i)
+        {
+            lFilled = lPipeline.Push({ .mTimestamp = i, .mType = ace::InputEventType::MouseDelta, .mX = 1.0f }) && lFilled;
+        }
+
+        // Records pushed into a full pipeline are dropped and counted.
+        const bool lDropped =
+            lPipeline.Push({ .mTimestamp = 0, .mType = ace::InputEventType::MouseDelta }) == false &&
+            lPipeline.Push({ .mTimestamp = 0, .mType = ace::InputEventType::MouseDelta }) == false &&
+            lPipeline.GetDroppedCount() == 2;
+
+        // Sampling drains the records which did fit, and makes room again.
+        lPipeline.Sample(ace::InputPipeline::CAPACITY);
+        const bool lDrained =
+            lPipeline.GetFrameRecords().size() == ace::InputPipeline::CAPACITY &&
+            lPipeline.GetSnapshot().mMouseDelta.mX == static_cast<float>(ace::InputPipeline::CAPACITY) &&
+            lPipeline.Push({ .mTimestamp = 0, .mType = ace::InputEventType::MouseDelta }) == true &&
+            lPipeline.GetDroppedCount() == 2;
+
+        return lFilled == true && lDropped == true && lDrained == true;
+    }
+
+    bool TestSpscOrdering ()
+    {
+        // One thread produces a long, increasing sequence through a small
+        // ring while the other consumes it in batches; every item arrives
+        // exactly once, in order.
+        constexpr std::uint64_t COUNT = 200000;
+        auto lRing = std::make_unique<ace::SpscRingBuffer<std::uint64_t, 64>>();
+        std::thread lProducer {
+            [&lRing] ()
+            {
+                for (std::uint64_t i = 0; i < COUNT; )
+                {
+                    if (lRing->Enqueue(i) == true)
+                    {
+                        ++i;
+                    }
+                    else
+                    {
+                        std::this_thread::yield();
+                    }
+                }
+            }
+        };
+
+        bool lOrdered = true;
+        std::uint64_t lExpected = 0;
+        while (lExpected < COUNT)
+        {
+            // Alternate between batched and single dequeues.
+            if (lExpected % 2 == 0)
+            {
+                lRing->DequeueWhile(
+                    [&lOrdered, &lExpected] (const std::uint64_t& pItem)
+                    {
+                        lOrdered = lOrdered && pItem == lExpected++;
+                        return true;
+                    }
+                );
+            }
+            else if (auto lItem = lRing->Dequeue(); lItem.has_value() == true)
+            {
+                lOrdered = lOrdered && *lItem == lExpected++;
+            }
+        }
+
+        lProducer.join();
+        return lOrdered == true && lRing->Dequeue().has_value() == false;
+    }
+}
@@ -0,0 +1,15 @@
+/**
+ * @file    MathsTesting/TestInputPipeline.hpp
+ */
+
+#pragma once
+#include <Ace/Input/InputPipeline.hpp>
+
+namespace AceInputPipeline
+{
+    bool TestPressRelease ();
+    bool TestSubFrameTap ();
+    bool TestMouseAccumulation ();
+    bool TestOverflowDrops ();
+    bool TestSpscOrdering ();
+}
@@ -239,4 +239,62 @@ namespace AceQuat4
         return true;
     }
 
+    bool TestMultiply ()
+    {
+        // Two quarter turns about the same axis make a half turn.
+        ace::Quaternion4f   lQuarter { ace::Vector3f::Front(), HALF_PI };
+        ace::Quaternion4f   lHalf { ace::Vector3f::Front(), ace::PI<float> };
+        ACE_EXPECT(
+            ace::EpsilonEqual(lQuarter * lQuarter, lHalf),
+            "Quaternion composition about one axis test failed."
+        );
+
+        // The right quaternion's rotation is applied first.
+        ace::Quaternion4f   lAboutZ { ace::Vector3f::Front(), HALF_PI };
+        ace::Quaternion4f   lAboutX { ace::Vector3f::Right(), HALF_PI };
+        ace::Vector3f       lVector = ace::Vector3f::Right();
+        ace::Vector3f       lOut = ace::Rotate(lAboutX * lAboutZ, lVector);
+        ace::Vector3f       lExpected = ace::Rotate(lAboutX, ace::Rotate(lAboutZ, lVector));
+        ACE_EXPECT(
+            ace::EpsilonEqual(lOut, lExpected),
+            "Quaternion composition order test failed."
+        );
+
+        ace::Quaternion4f   lCombined = lAboutX;
+        lCombined *= lAboutZ;
+        ACE_EXPECT(
+            ace::EpsilonEqual(lCombined, lAboutX * lAboutZ),
+            "Quaternion compound multiplication test failed."
+        );
+
+        // A quaternion times its inverse is the identity.
+        ACE_EXPECT(
+            ace::EpsilonEqual(lAboutX * lAboutX.Inverse(), ace::Quaternion4f {}),
+            "Quaternion times inverse test failed."
+        );
+
+        return true;
+    }
+
+    bool TestToMatrix3 ()
+    {
+        ACE_EXPECT(
+            ace::Quaternion4f {}.ToMatrix3() == ace::Matrix3f::Identity(),
+            "Quaternion to identity 3x3 matrix test failed."
+        );
+
+        ace::Quaternion4f   lQuat { 0.3f, -1.1f, 0.7f };
+        ace::Vector3f       lVector { 1.0f, 2.0f, 3.0f };
+        ace::Vector3f       lOut = lQuat.ToMatrix3() * lVector;
+        ace::Vector3f       lExpected = ace::Rotate(lQuat, lVector);
+        ACE_EXPECT(
+            ace::EpsilonEqual(lOut.mX, lExpected.mX, 1e-5f) &&
+            ace::EpsilonEqual(lOut.mY, lExpected.mY, 1e-5f) &&
+            ace::EpsilonEqual(lOut.mZ, lExpected.mZ, 1e-5f),
+            "Quaternion to 3x3 matrix rotation test failed."
+        );
+
+        return true;
+    }
+
 }
@@ -17,4 +17,6 @@ namespace AceQuat4
     bool TestSphericalLerp ();
     bool TestSphericalLerp180 ();
     bool TestRotate ();
+    bool TestMultiply ();
+    bool TestToMatrix3 ();
 }
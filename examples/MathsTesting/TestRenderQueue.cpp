@@ -0,0 +1,184 @@
+/**
+ * @file    MathsTesting/TestRenderQueue.cpp
+ */
+
+#include <random>
+#include <MathsTesting/TestRenderQueue.hpp>
+
+namespace AceRenderQueue
+{
+    static constexpr std::size_t BUFFER_COUNT = 4;
+
+    /**
+     * @brief   A backend recording the geometry handle of each command it
+     *          receives, which the tests below use as a recording index.
+     */
+    class IndexBackend final : public ace::IRenderBackend
+    {
+    public:
+
+        void BeginFrame () override
+        {
+            mIndices.clear();
+        }
+
+        void Draw (
+            const std::uint64_t&        pSortKey,
+            const ace::DrawCommand&     pCommand
+        ) override
+        {
+            (void) pSortKey;
+            mIndices.push_back(pCommand.mGeometry);
+        }
+
+        void EndFrame () override
+        {
+
+        }
+
+    public:
+        std::vector<std::uint32_t> mIndices;
+
+    };
+
+    /**
+     * @brief   Records the given keys into several buffers of a queue, each
+     *          buffer from its own thread, splitting the keys into contiguous
+     *          slices in buffer creation order. Each command's geometry handle
+     *          holds the index of its key.
+     */
+    static void Record (
+        ace::RenderQueue&                   pQueue,
+        const std::vector<std::uint64_t>&   pKeys
+    )
+    {
+        std::vector<ace::RenderCommandBuffer*> lBuffers;
+        for (std::size_t i = 0; i < BUFFER_COUNT; ++i)
+        {
+            lBuffers.push_back(&pQueue.CreateCommandBuffer());
+        }
+
+        std::vector<std::thread> lThreads;
+        const std::size_t lSlice = (pKeys.size() + BUFFER_COUNT - 1) / BUFFER_COUNT;
+        for (std::size_t i = 0; i < BUFFER_COUNT; ++i)
+        {
+            lThreads.emplace_back(
+                [&pKeys, lBuffer = lBuffers[i], lBegin = i * lSlice, lSlice] ()
+                {
+                    const std::size_t lEnd = std::min(pKeys.size(), lBegin + lSlice);
+                    for (std::size_t j = lBegin; j < lEnd; ++j)
+                    {
+                        lBuffer->Draw(pKeys[j], { .mGeometry = static_cast<std::uint32_t>(j) });
+                    }
+                }
+            );
+        }
+
+        for (auto& lThread : lThreads)
+        {
+            lThread.join();
+        }
+    }
+
+    /**
+     * @brief   Generates random keys, drawing each from the given number of
+     *          distinct values spread over every byte of the key.
+     */
+    static std::vector<std::uint64_t> MakeKeys (
+        const std::size_t   pCount,
+        const std::size_t   pDistinct
+    )
+    {
+        std::mt19937_64 lEngine { 1234 };
+        std::vector<std::uint64_t> lValues;
+        for (std::size_t i = 0; i < pDistinct; ++i)
+        {
+            lValues.push_back(lEngine());
+        }
+
+        std::vector<std::uint64_t> lKeys;
+        for (std::size_t i = 0; i < pCount; ++i)
+        {
+            lKeys.push_back(lValues[lEngine() % pDistinct]);
+        }
+
+        return lKeys;
+    }
+
+    bool TestEmptyAndSingle ()
+    {
+        ace::RenderQueue lQueue { 2 };
+        ace::NullRenderBackend lBackend;
+
+        // An empty submission still begins and ends a frame.
+        Record(lQueue, {});
+        lQueue.Submit(lBackend);
+        const bool lEmpty =
+            lBackend.GetSortKeys().empty() == true &&
+            lBackend.GetFrameCount() == 1;
+
+        auto& lBuffer = lQueue.CreateCommandBuffer();
+        lBuffer.Draw(42, {});
+        lQueue.Submit(lBackend);
+        const bool lSingle =
+            lBackend.GetSortKeys() == std::vector<std::uint64_t> { 42 } &&
+            lBackend.GetFrameCount() == 2;
+
+        // Submission resets the buffers.
+        lQueue.Submit(lBackend);
+        const bool lReset =
+            lBackend.GetSortKeys().empty() == true &&
+            lBuffer.GetCommandCount() == 0;
+
+        return lEmpty == true && lSingle == true && lReset == true;
+    }
+
+    bool TestSortedAcrossRuns ()
+    {
+        // Just under one run, exactly one run, and several runs with a partial
+        // run at the end.
+        for (const std::size_t lCount : {
+            ace::RenderQueue::RUN_SIZE - 1,
+            ace::RenderQueue::RUN_SIZE,
+            ace::RenderQueue::RUN_SIZE * 3 + 17 })
+        {
+            auto lKeys = MakeKeys(lCount, lCount);
+            ace::RenderQueue lQueue { 4 };
+            ace::NullRenderBackend lBackend;
+            Record(lQueue, lKeys);
+            lQueue.Submit(lBackend);
+
+            std::sort(lKeys.begin(), lKeys.end());
+            if (lBackend.GetSortKeys() != lKeys)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool TestStableEqualKeys ()
+    {
+        // With only a few distinct keys, most commands tie; commands with
+        // equal keys must arrive in buffer creation order, then recording
+        // order, even when they fall in different runs.
+        const std::size_t lCount = ace::RenderQueue::RUN_SIZE * 2 + 5;
+        const auto lKeys = MakeKeys(lCount, 7);
+        ace::RenderQueue lQueue { 4 };
+        IndexBackend lBackend;
+        Record(lQueue, lKeys);
+        lQueue.Submit(lBackend);
+
+        std::vector<std::uint32_t> lExpected (lCount);
+        std::iota(lExpected.begin(), lExpected.end(), 0);
+        std::stable_sort(lExpected.begin(), lExpected.end(),
+            [&lKeys] (const std::uint32_t& pFirst, const std::uint32_t& pSecond)
+            {
+                return lKeys[pFirst] < lKeys[pSecond];
+            }
+        );
+
+        return lBackend.mIndices == lExpected;
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * @file    MathsTesting/TestRenderQueue.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/RenderQueue.hpp>
+#include <Ace/Graphics/NullRenderBackend.hpp>
+
+namespace AceRenderQueue
+{
+    bool TestEmptyAndSingle ();
+    bool TestSortedAcrossRuns ();
+    bool TestStableEqualKeys ();
+}
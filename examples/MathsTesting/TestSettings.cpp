@@ -0,0 +1,219 @@
+/**
+ * @file    MathsTesting/TestSettings.cpp
+ */
+
+#include <MathsTesting/TestSettings.hpp>
+
+namespace AceSettings
+{
+    /**
+     * @brief   The settings every test reads. Settings load once per process,
+     *          so the tests share them; every key lives under `test`, away
+     *          from the engine's own settings.
+     */
+    static constexpr std::string_view TEXT = R"(
+# A comment.
+; Another comment.
+[test]
+flag = true
+off = false
+count = 42   # A trailing comment.
+hex = 0xFF
+negative = -7
+big = 5000000000
+ratio = 0.25
+whole = 3.0
+huge = 1e300
+over = 9.3e18
+under = -9.3e18
+edge = -9223372036854775808.0
+nan = nan
+inf = inf
+name = "quoted # not a comment"
+escaped = "say \"hi\" \\ bye"
+bare = some text
+
+[test.nested]
+depth = 2
+)";
+
+    /**
+     * @brief   Loads @a `TEXT`, the first time it is called.
+     */
+    static void EnsureLoaded ()
+    {
+        static const bool LOADED = (ace::Settings::LoadFromText(TEXT, "test"), true);
+        (void) LOADED;
+    }
+
+    /**
+     * @brief   Does loading the given text throw an exception of the given
+     *          type?
+     */
+    template <typename E>
+    static bool Throws (
+        std::string_view    pText
+    )
+    {
+        try
+        {
+            ace::Settings::LoadFromText(pText, "malformed");
+        }
+        catch (const E&)
+        {
+            return true;
+        }
+        catch (...)
+        {
+
+        }
+
+        return false;
+    }
+
+    bool TestParsing ()
+    {
+        EnsureLoaded();
+        using ace::Settings;
+        using ace::SettingType;
+
+        const bool lTypes =
+            Settings::GetCount() == 18 &&
+            Settings::GetType("test.flag") == SettingType::Bool &&
+            Settings::GetType("test.count") == SettingType::Integer &&
+            Settings::GetType("test.hex") == SettingType::Integer &&
+            Settings::GetType("test.ratio") == SettingType::Float &&
+            Settings::GetType("test.name") == SettingType::String &&
+            Settings::GetType("test.bare") == SettingType::String &&
+            Settings::GetType("test.nested.depth") == SettingType::Integer;
+
+        const bool lValues =
+            Settings::Get<bool>("test.flag", false) == true &&
+            Settings::Get<bool>("test.off", true) == false &&
+            Settings::Get<int>("test.count", 0) == 42 &&
+            Settings::Get<int>("test.hex", 0) == 255 &&
+            Settings::Get<int>("test.negative", 0) == -7 &&
+            Settings::Get<std::int64_t>("test.big", 0) == 5000000000 &&
+            Settings::Get<double>("test.ratio", 0.0) == 0.25 &&
+            Settings::Get<int>("test.nested.depth", 0) == 2;
+
+        // Quoted strings keep comment characters and unescape quotes and
+        // backslashes; bare strings are trimmed.
+        const bool lStrings =
+            Settings::Get<std::string_view>("test.name", "") == "quoted # not a comment" &&
+            Settings::Get<std::string>("test.escaped", "") == R"(say "hi" \ bye)" &&
+            Settings::Get<std::string>("test.bare", "") == "some text" &&
+            Settings::Get<fs::path>("test.bare", "") == fs::path { "some text" };
+
+        // Settings load only once.
+        const bool lOnce = Throws<std::logic_error>("test.again = 1");
+
+        return lTypes == true && lValues == true && lStrings == true && lOnce == true;
+    }
+
+    bool TestMalformed ()
+    {
+        // Malformed text is rejected before anything is published, so these
+        // throw whether or not settings are loaded.
+        return
+            Throws<std::runtime_error>("[section") &&
+            Throws<std::runtime_error>("[bad name]") &&
+            Throws<std::runtime_error>("no equals sign") &&
+            Throws<std::runtime_error>(" = 1") &&
+            Throws<std::runtime_error>("bad key = 1") &&
+            Throws<std::runtime_error>("key = 1\nkey = 2") &&
+            Throws<std::runtime_error>("key = \"unterminated") &&
+            Throws<std::runtime_error>("key = \"text\" trailing");
+    }
+
+    bool TestConversion ()
+    {
+        EnsureLoaded();
+        using ace::Settings;
+
+        // Integers narrow only if they fit, and widen to floats.
+        const bool lIntegers =
+            Settings::Get<std::uint8_t>("test.hex", 0) == 255 &&
+            Settings::Get<std::int8_t>("test.hex", 9) == 9 &&
+            Settings::Get<unsigned>("test.negative", 9) == 9 &&
+            Settings::Get<std::int32_t>("test.big", 9) == 9 &&
+            Settings::Get<float>("test.count", 0.0f) == 42.0f;
+
+        // Floats convert to integers only if they are whole, finite and in
+        // range; anything else yields the default rather than overflowing.
+        const bool lFloats =
+            Settings::Get<int>("test.whole", 0) == 3 &&
+            Settings::Get<int>("test.ratio", 9) == 9 &&
+            Settings::Get<std::int64_t>("test.huge", 9) == 9 &&
+            Settings::Get<std::int64_t>("test.over", 9) == 9 &&
+            Settings::Get<std::int64_t>("test.under", 9) == 9 &&
+            Settings::Get<std::uint64_t>("test.over", 9) == 9 &&
+            Settings::Get<std::int64_t>("test.edge", 9) == std::numeric_limits<std::int64_t>::min() &&
+            Settings::Get<std::int64_t>("test.nan", 9) == 9 &&
+            Settings::Get<std::int64_t>("test.inf", 9) == 9 &&
+            std::isinf(Settings::Get<double>("test.inf", 0.0)) == true;
+
+        // Other mismatched types yield the default.
+        const bool lMismatched =
+            Settings::Get<bool>("test.count", true) == true &&
+            Settings::Get<int>("test.flag", 9) == 9 &&
+            Settings::Get<int>("test.name", 9) == 9 &&
+            Settings::Get<double>("test.name", 1.5) == 1.5 &&
+            Settings::Get<std::string>("test.count", "default") == "default";
+
+        return lIntegers == true && lFloats == true && lMismatched == true;
+    }
+
+    bool TestMissingKeys ()
+    {
+        EnsureLoaded();
+        using ace::Settings;
+
+        // Keys are matched whole, including their section prefix.
+        return
+            Settings::Get<int>("test.missing", 9) == 9 &&
+            Settings::Get<int>("count", 9) == 9 &&
+            Settings::Get<int>("nested.depth", 9) == 9 &&
+            Settings::Get<int>("test.coun", 9) == 9 &&
+            Settings::Get<std::string>("", "default") == "default" &&
+            Settings::GetType("test.missing").has_value() == false &&
+            Settings::GetType("test").has_value() == false;
+    }
+
+    /**
+     * @brief   An application which exposes its fixed timestep.
+     */
+    class TimestepApplication final : public ace::IApplication
+    {
+    public:
+        explicit TimestepApplication (
+            const float pFramerate
+        ) :
+            IApplication { { .mFramerate = pFramerate } }
+        {
+        }
+
+        float GetFixedTimestep () const
+        {
+            return mFixedTimestep;
+        }
+    };
+
+    bool TestFramerate ()
+    {
+        // Framerates which would yield no usable timestep fall back to 60.
+        for (const float lFramerate : {
+            0.0f, -30.0f, 1.0e-40f,
+            std::numeric_limits<float>::infinity(),
+            std::numeric_limits<float>::quiet_NaN()
+        })
+        {
+            if (TimestepApplication { lFramerate }.GetFixedTimestep() != 1.0f / 60.0f)
+            {
+                return false;
+            }
+        }
+
+        return TimestepApplication { 30.0f }.GetFixedTimestep() == 1.0f / 30.0f;
+    }
+}
@@ -0,0 +1,15 @@
+/**
+ * @file    MathsTesting/TestSettings.hpp
+ */
+
+#pragma once
+#include <Ace/System/IApplication.hpp>
+
+namespace AceSettings
+{
+    bool TestParsing ();
+    bool TestMalformed ();
+    bool TestConversion ();
+    bool TestMissingKeys ();
+    bool TestFramerate ();
+}
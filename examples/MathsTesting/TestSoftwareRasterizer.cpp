@@ -0,0 +1,195 @@
+/**
+ * @file    MathsTesting/TestSoftwareRasterizer.cpp
+ */
+
+#include <MathsTesting/TestSoftwareRasterizer.hpp>
+
+namespace AceSoftwareRasterizer
+{
+    static const ace::Vector4f RED { 1.0f, 0.0f, 0.0f, 1.0f };
+    static const ace::Vector4f GREEN { 0.0f, 1.0f, 0.0f, 1.0f };
+    static const ace::Vector4f BLACK { 0.0f, 0.0f, 0.0f, 1.0f };
+    static constexpr ace::RasterState FLAT { .mCullMode = ace::CullMode::None, .mDepthTest = false, .mDepthWrite = false };
+
+    /**
+     * @brief   Submits a rectangle, given in normalized device coordinates, as
+     *          two triangles split along the diagonal from its bottom-left to
+     *          its top-right corner.
+     */
+    static void SubmitRect (
+        ace::SoftwareRasterizer&    pRasterizer,
+        const float                 pLeft,
+        const float                 pBottom,
+        const float                 pRight,
+        const float                 pTop,
+        const ace::Vector4f&        pColor
+    )
+    {
+        const std::vector<ace::RasterVertex> lVertices {
+            { { pLeft, pBottom, 0.0f }, pColor },
+            { { pRight, pBottom, 0.0f }, pColor },
+            { { pRight, pTop, 0.0f }, pColor },
+            { { pLeft, pTop, 0.0f }, pColor }
+        };
+
+        pRasterizer.Submit(lVertices, { 0, 1, 2, 0, 2, 3 }, ace::Matrix4f::Identity(), FLAT);
+    }
+
+    /**
+     * @brief   Counts the pixels of a framebuffer holding the given colour.
+     */
+    static std::size_t CountPixels (
+        const ace::Framebuffer& pTarget,
+        const ace::Vector4f&    pColor
+    )
+    {
+        std::size_t lCount = 0;
+        for (std::size_t y = 0; y < pTarget.GetHeight(); ++y)
+        {
+            for (std::size_t x = 0; x < pTarget.GetWidth(); ++x)
+            {
+                lCount += (pTarget.GetPixel(x, y) == ace::Framebuffer::PackColor(pColor)) ? 1 : 0;
+            }
+        }
+
+        return lCount;
+    }
+
+    bool TestExactPixels ()
+    {
+        // A red rectangle over the middle half of an 8x8 target, whose edges
+        // fall between pixel centers, covers exactly columns and rows 2-5.
+        ace::Framebuffer lTarget { 8, 8 };
+        lTarget.Clear(BLACK);
+        ace::SoftwareRasterizer lRasterizer { lTarget, 2 };
+        SubmitRect(lRasterizer, -0.5f, -0.5f, 0.5f, 0.5f, RED);
+        lRasterizer.Flush();
+
+        for (std::size_t y = 0; y < 8; ++y)
+        {
+            for (std::size_t x = 0; x < 8; ++x)
+            {
+                const bool lInside = x >= 2 && x <= 5 && y >= 2 && y <= 5;
+                if (lTarget.GetPixel(x, y) != ace::Framebuffer::PackColor(lInside ? RED : BLACK))
+                {
+                    return false;
+                }
+            }
+        }
+
+        return lRasterizer.GetPendingTriangleCount() == 0;
+    }
+
+    bool TestSharedEdges ()
+    {
+        // The diagonal of a full-screen quad passes through eight pixel
+        // centers. Drawn alone, its two triangles must cover every pixel
+        // exactly once between them.
+        const std::vector<ace::RasterVertex> lVertices {
+            { { -1.0f, -1.0f, 0.0f }, RED },
+            { { 1.0f, -1.0f, 0.0f }, RED },
+            { { 1.0f, 1.0f, 0.0f }, RED },
+            { { -1.0f, 1.0f, 0.0f }, RED }
+        };
+
+        std::size_t lCovered = 0;
+        std::vector<std::uint32_t> lOwners(64, 0);
+        for (const std::vector<std::uint32_t>& lIndices : { std::vector<std::uint32_t> { 0, 1, 2 }, std::vector<std::uint32_t> { 0, 2, 3 } })
+        {
+            ace::Framebuffer lTarget { 8, 8 };
+            lTarget.Clear(BLACK);
+            ace::SoftwareRasterizer lRasterizer { lTarget, 2 };
+            lRasterizer.Submit(lVertices, lIndices, ace::Matrix4f::Identity(), FLAT);
+            lRasterizer.Flush();
+
+            lCovered += CountPixels(lTarget, RED);
+            for (std::size_t i = 0; i < 64; ++i)
+            {
+                lOwners[i] += (lTarget.GetPixel(i % 8, i / 8) == ace::Framebuffer::PackColor(RED)) ? 1 : 0;
+            }
+        }
+
+        return lCovered == 64 && std::ranges::all_of(lOwners, [] (const std::uint32_t pCount) { return pCount == 1; });
+    }
+
+    bool TestTopLeftRule ()
+    {
+        // Two rectangles meet on a vertical edge through the centers of
+        // column 4, then on a horizontal edge through the centers of row 4.
+        // Each shared line of pixels goes to the rectangle whose left, or
+        // top, edge it lies on.
+        ace::Framebuffer lTarget { 8, 8 };
+        ace::SoftwareRasterizer lRasterizer { lTarget, 2 };
+
+        lTarget.Clear(BLACK);
+        SubmitRect(lRasterizer, -1.0f, -1.0f, 0.125f, 1.0f, RED);
+        SubmitRect(lRasterizer, 0.125f, -1.0f, 1.0f, 1.0f, GREEN);
+        lRasterizer.Flush();
+
+        bool lVertical = CountPixels(lTarget, RED) == 32 && CountPixels(lTarget, GREEN) == 32;
+        for (std::size_t y = 0; y < 8; ++y)
+        {
+            lVertical = lVertical && lTarget.GetPixel(4, y) == ace::Framebuffer::PackColor(GREEN);
+        }
+
+        // Row 4's centers lie at y = -0.125 in normalized device coordinates,
+        // which is the top edge of the lower rectangle.
+        lTarget.Clear(BLACK);
+        SubmitRect(lRasterizer, -1.0f, -0.125f, 1.0f, 1.0f, RED);
+        SubmitRect(lRasterizer, -1.0f, -1.0f, 1.0f, -0.125f, GREEN);
+        lRasterizer.Flush();
+
+        bool lHorizontal = CountPixels(lTarget, RED) == 32 && CountPixels(lTarget, GREEN) == 32;
+        for (std::size_t x = 0; x < 8; ++x)
+        {
+            lHorizontal = lHorizontal && lTarget.GetPixel(x, 4) == ace::Framebuffer::PackColor(GREEN);
+        }
+
+        return lVertical == true && lHorizontal == true;
+    }
+
+    bool TestThreadCountDeterminism ()
+    {
+        // Many overlapping, depth-tested, shaded triangles spanning several
+        // tiles must give bit-identical colour and depth at any thread count.
+        std::vector<ace::RasterVertex> lVertices;
+        std::vector<std::uint32_t> lIndices;
+        std::mt19937 lRandom { 77 };
+        std::uniform_real_distribution<float> lUnit { -1.2f, 1.2f };
+        std::uniform_real_distribution<float> lChannel { 0.0f, 1.0f };
+        for (std::uint32_t i = 0; i < 3000; ++i)
+        {
+            lVertices.push_back({
+                { lUnit(lRandom), lUnit(lRandom), lUnit(lRandom) * 0.8f },
+                { lChannel(lRandom), lChannel(lRandom), lChannel(lRandom), 1.0f }
+            });
+            lIndices.push_back(i);
+        }
+
+        const auto Render = [&] (const std::size_t pThreadCount)
+        {
+            auto lTarget = std::make_unique<ace::Framebuffer>(300, 200);
+            lTarget->Clear(BLACK);
+            ace::SoftwareRasterizer lRasterizer { *lTarget, pThreadCount };
+            lRasterizer.Submit(lVertices, lIndices, ace::Matrix4f::Identity(), { .mCullMode = ace::CullMode::None });
+            lRasterizer.Flush();
+            return lTarget;
+        };
+
+        const auto lSingle = Render(1);
+        const auto lMany = Render(8);
+        for (std::size_t y = 0; y < lSingle->GetHeight(); ++y)
+        {
+            if (
+                std::memcmp(lSingle->GetColorRow(y), lMany->GetColorRow(y), lSingle->GetWidth() * 4) != 0 ||
+                std::memcmp(lSingle->GetDepthRow(y), lMany->GetDepthRow(y), lSingle->GetWidth() * 4) != 0
+            )
+            {
+                return false;
+            }
+        }
+
+        // The scene must actually have drawn something.
+        return CountPixels(*lSingle, BLACK) < lSingle->GetWidth() * lSingle->GetHeight() / 2;
+    }
+}
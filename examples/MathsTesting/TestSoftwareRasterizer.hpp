@@ -0,0 +1,14 @@
+/**
+ * @file    MathsTesting/TestSoftwareRasterizer.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/SoftwareRasterizer.hpp>
+
+namespace AceSoftwareRasterizer
+{
+    bool TestExactPixels ();
+    bool TestSharedEdges ();
+    bool TestTopLeftRule ();
+    bool TestThreadCountDeterminism ();
+}
@@ -0,0 +1,119 @@
+/**
+ * @file    MathsTesting/TestStagingRing.cpp
+ */
+
+#include <MathsTesting/TestStagingRing.hpp>
+
+namespace AceStagingRing
+{
+    static constexpr std::size_t CAPACITY = 256;
+
+    bool TestFullRing ()
+    {
+        ace::StagingRing lRing { CAPACITY };
+        const auto lFirst = lRing.ReserveBytes(128);
+        const auto lSecond = lRing.ReserveBytes(128);
+
+        // With every byte reserved and nothing fenced, even a one-byte
+        // reservation fails, and a reservation larger than the arena throws.
+        const bool lFull =
+            lFirst.size() == 128 &&
+            lSecond.data() == lFirst.data() + 128 &&
+            lRing.GetUsedBytes() == CAPACITY &&
+            lRing.ReserveBytes(1).empty() == true &&
+            lRing.Reserve<std::uint32_t>(1).empty() == true;
+
+        bool lThrew = false;
+        try
+        {
+            lRing.ReserveBytes(CAPACITY + 1);
+        }
+        catch (const std::invalid_argument&)
+        {
+            lThrew = true;
+        }
+
+        // Once the data is fenced and the fence is signalled, the space is
+        // reusable.
+        lRing.SignalFence(lRing.InsertFence());
+        const bool lReclaimed =
+            lRing.GetUsedBytes() == 0 &&
+            lRing.ReserveBytes(CAPACITY).data() == lFirst.data();
+
+        return lFull == true && lThrew == true && lReclaimed == true;
+    }
+
+    bool TestWraparound ()
+    {
+        ace::StagingRing lRing { CAPACITY };
+        const auto lFirst = lRing.ReserveBytes(192);
+        lRing.SignalFence(lRing.InsertFence());
+
+        // A reservation which would run past the end of the arena skips the
+        // remaining 64 bytes and starts back at the beginning; the skipped
+        // bytes count as used until they are reclaimed.
+        const auto lWrapped = lRing.ReserveBytes(128);
+        const bool lWraps =
+            lWrapped.size() == 128 &&
+            lWrapped.data() == lFirst.data() &&
+            lRing.GetUsedBytes() == 192;
+
+        // Only 64 bytes remain, as the wrapped reservation's end is 64 bytes
+        // short of where the reclaimed data began.
+        const bool lBounded =
+            lRing.ReserveBytes(65).empty() == true &&
+            lRing.ReserveBytes(64).data() == lFirst.data() + 128 &&
+            lRing.ReserveBytes(1).empty() == true;
+
+        // Padding a reservation for alignment can carry it across the end of
+        // the arena, back to the beginning.
+        lRing.SignalFence(lRing.InsertFence());
+        lRing.ReserveBytes(1, 1);
+        const auto lAligned = lRing.ReserveBytes(64, ace::StagingRing::MAX_ALIGNMENT);
+        const bool lAlignedWraps =
+            lAligned.data() == lFirst.data() &&
+            reinterpret_cast<std::uintptr_t>(lAligned.data()) % ace::StagingRing::MAX_ALIGNMENT == 0;
+
+        return lWraps == true && lBounded == true && lAlignedWraps == true;
+    }
+
+    bool TestFenceReclamation ()
+    {
+        ace::StagingRing lRing { CAPACITY };
+        std::vector<std::uint64_t> lFences;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            lRing.ReserveBytes(64);
+            lFences.push_back(lRing.InsertFence());
+        }
+
+        const bool lInserted =
+            lFences == std::vector<std::uint64_t> { 1, 2, 3, 4 } &&
+            lRing.GetCompletedFence() == 0 &&
+            lRing.ReserveBytes(1).empty() == true;
+
+        // Signalling a fence retires it and every earlier fence, reclaiming
+        // exactly the data reserved before it.
+        lRing.SignalFence(lFences[1]);
+        const bool lPartial =
+            lRing.GetCompletedFence() == 2 &&
+            lRing.GetUsedBytes() == 128 &&
+            lRing.ReserveBytes(128).size() == 128 &&
+            lRing.ReserveBytes(1).empty() == true;
+
+        // Signalling an already retired fence changes nothing.
+        lRing.SignalFence(lFences[0]);
+        const bool lStale =
+            lRing.GetCompletedFence() == 2 &&
+            lRing.GetUsedBytes() == CAPACITY;
+
+        // A fence inserted after the reuse covers it too.
+        const auto lLast = lRing.InsertFence();
+        lRing.SignalFence(lLast);
+        const bool lDrained =
+            lRing.GetCompletedFence() == lLast &&
+            lRing.GetUsedBytes() == 0;
+
+        return lInserted == true && lPartial == true && lStale == true && lDrained == true;
+    }
+}
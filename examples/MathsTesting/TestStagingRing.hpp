@@ -0,0 +1,13 @@
+/**
+ * @file    MathsTesting/TestStagingRing.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/StagingRing.hpp>
+
+namespace AceStagingRing
+{
+    bool TestFullRing ();
+    bool TestWraparound ();
+    bool TestFenceReclamation ();
+}
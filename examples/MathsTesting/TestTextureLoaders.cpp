@@ -0,0 +1,132 @@
+/**
+ * @file    MathsTesting/TestTextureLoaders.cpp
+ */
+
+#include <Ace/System/VirtualMemoryFile.hpp>
+#include <MathsTesting/TestTextureLoaders.hpp>
+
+namespace AceTextureLoaders
+{
+    static void WriteU32 (
+        astd::byte_buffer&  pBuffer,
+        const std::size_t   pOffset,
+        const std::uint32_t pValue,
+        const bool          pBigEndian = false
+    )
+    {
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            const std::size_t lShift = pBigEndian ? (3 - i) * 8 : i * 8;
+            pBuffer[pOffset + i] = static_cast<std::uint8_t>(pValue >> lShift);
+        }
+    }
+
+    /**
+     * @brief   Builds a `.dds` file of 32-bit BGRA pixels with one mip,
+     *          followed by the given pixel data.
+     */
+    static astd::byte_buffer MakeDds (
+        const std::uint32_t         pWidth,
+        const std::uint32_t         pHeight,
+        const astd::byte_buffer&    pPixels
+    )
+    {
+        astd::byte_buffer lFile(128);
+        lFile[0] = 'D'; lFile[1] = 'D'; lFile[2] = 'S'; lFile[3] = ' ';
+        WriteU32(lFile, 4, 124);
+        WriteU32(lFile, 12, pHeight);
+        WriteU32(lFile, 16, pWidth);
+        WriteU32(lFile, 28, 1);
+        WriteU32(lFile, 80, 0x40);
+        WriteU32(lFile, 88, 32);
+        WriteU32(lFile, 92, 0x00FF0000);
+        WriteU32(lFile, 104, 0xFF000000);
+        lFile.insert(lFile.end(), pPixels.begin(), pPixels.end());
+        return lFile;
+    }
+
+    template <typename L>
+    static std::shared_ptr<ace::Texture> Load (
+        const astd::byte_buffer&    pFile,
+        const std::string&          pPath
+    )
+    {
+        L lLoader { { .mGenerateMips = false } };
+        auto lContents = std::make_shared<const astd::byte_buffer>(pFile);
+        return lLoader.Load(pPath, std::make_unique<ace::VirtualMemoryFile>(lContents));
+    }
+
+    bool TestDdsDimensions ()
+    {
+        // A 2^31 square image of 4-byte pixels is 2^64 bytes, which wraps to
+        // zero; the header must be rejected before any size is computed.
+        const bool lRejected =
+            Load<ace::DdsTextureLoader>(MakeDds(0x80000000, 0x80000000, { 1, 2, 3, 4 }), "huge.dds") == nullptr &&
+            Load<ace::DdsTextureLoader>(MakeDds(ace::Texture::MAX_DIMENSION + 1, 1, { 1, 2, 3, 4 }), "wide.dds") == nullptr;
+
+        // A small image still loads, swizzled into RGBA order.
+        const auto lTexture = Load<ace::DdsTextureLoader>(
+            MakeDds(2, 1, { 1, 2, 3, 4, 5, 6, 7, 8 }), "small.dds");
+        const bool lLoaded =
+            lTexture != nullptr &&
+            lTexture->GetWidth() == 2 &&
+            lTexture->GetHeight() == 1 &&
+            lTexture->mMips[0].mData == astd::byte_buffer { 3, 2, 1, 4, 7, 6, 5, 8 };
+
+        return lRejected == true && lLoaded == true;
+    }
+
+    bool TestPngDimensions ()
+    {
+        // A 64-bit-per-pixel image with a header claiming 2^31 - 1 square
+        // pixels is rejected as soon as the header is read.
+        astd::byte_buffer lFile { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+        const std::size_t lChunk = lFile.size();
+        lFile.resize(lChunk + 25);
+        WriteU32(lFile, lChunk, 13, true);
+        lFile[lChunk + 4] = 'I'; lFile[lChunk + 5] = 'H'; lFile[lChunk + 6] = 'D'; lFile[lChunk + 7] = 'R';
+        WriteU32(lFile, lChunk + 8, 0x7FFFFFFF, true);
+        WriteU32(lFile, lChunk + 12, 0x7FFFFFFF, true);
+        lFile[lChunk + 16] = 16;
+        lFile[lChunk + 17] = 6;
+
+        return Load<ace::PngTextureLoader>(lFile, "huge.png") == nullptr;
+    }
+
+    bool TestMipSizeBounds ()
+    {
+        const bool lInRange =
+            ace::Texture::GetMipSize(ace::TextureFormat::RGBA8, ace::Texture::MAX_DIMENSION,
+                ace::Texture::MAX_DIMENSION) == std::size_t { ace::Texture::MAX_DIMENSION } * ace::Texture::MAX_DIMENSION * 4 &&
+            ace::Texture::GetMipSize(ace::TextureFormat::BC1, 5, 5) == 32;
+
+        bool lThrew = false;
+        try
+        {
+            ace::Texture::GetMipSize(ace::TextureFormat::RGBA8, 0x80000000, 0x80000000);
+        }
+        catch (const std::length_error&)
+        {
+            lThrew = true;
+        }
+
+        // A cooked texture claiming an oversized mip is rejected too.
+        ace::Texture lTexture;
+        lTexture.mMips.push_back({ .mWidth = 1, .mHeight = 1, .mData = { 1, 2, 3, 4 } });
+        astd::byte_buffer lCooked = lTexture.Serialize();
+
+        // The first mip's width follows the 12-byte header; make it 2^31.
+        lCooked[15] = 0x80;
+        bool lCookedRejected = false;
+        try
+        {
+            ace::Texture::Deserialize(lCooked);
+        }
+        catch (const std::runtime_error&)
+        {
+            lCookedRejected = true;
+        }
+
+        return lInRange == true && lThrew == true && lCookedRejected == true;
+    }
+}
@@ -0,0 +1,13 @@
+/**
+ * @file    MathsTesting/TestTextureLoaders.hpp
+ */
+
+#pragma once
+#include <Ace/Graphics/TextureLoaders.hpp>
+
+namespace AceTextureLoaders
+{
+    bool TestDdsDimensions ();
+    bool TestPngDimensions ();
+    bool TestMipSizeBounds ();
+}
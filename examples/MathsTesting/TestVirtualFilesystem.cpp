@@ -0,0 +1,97 @@
+/**
+ * @file    MathsTesting/TestVirtualFilesystem.cpp
+ */
+
+#include <thread>
+#include <MathsTesting/TestVirtualFilesystem.hpp>
+
+namespace AceVirtualFilesystem
+{
+    bool TestConcurrentMounting ()
+    {
+        constexpr std::size_t MOUNT_COUNT = 200;
+        constexpr std::size_t READER_COUNT = 3;
+
+        auto lBase = ace::VFS::MountMemory("test-vfs-concurrent");
+        lBase->Store("file.txt", std::make_shared<const astd::byte_buffer>(astd::byte_buffer { 'a' }));
+
+        // Readers keep opening a file while another thread keeps mounting;
+        // every open sees a whole mount list.
+        std::atomic<bool> lDone { false };
+        std::atomic<std::size_t> lMisses { 0 };
+        std::vector<std::thread> lReaders;
+        for (std::size_t i = 0; i < READER_COUNT; ++i)
+        {
+            lReaders.emplace_back(
+                [&lDone, &lMisses] ()
+                {
+                    while (lDone.load(std::memory_order_acquire) == false)
+                    {
+                        if (ace::VFS::OpenFile("test-vfs-concurrent/file.txt") == nullptr)
+                        {
+                            lMisses.fetch_add(1, std::memory_order_relaxed);
+                        }
+                    }
+                }
+            );
+        }
+
+        for (std::size_t i = 0; i < MOUNT_COUNT; ++i)
+        {
+            ace::VFS::MountMemory(std::format("test-vfs-concurrent-{}", i));
+        }
+
+        lDone.store(true, std::memory_order_release);
+        for (auto& lReader : lReaders)
+        {
+            lReader.join();
+        }
+
+        return lMisses.load() == 0 &&
+            ace::VFS::OpenFile("test-vfs-concurrent/file.txt") != nullptr;
+    }
+
+    bool TestUnmount ()
+    {
+        auto lFirst = ace::VFS::MountMemory("test-vfs-unmount");
+        auto lSecond = ace::VFS::MountMemory("test-vfs-unmount");
+        lFirst->Store("file.txt", std::make_shared<const astd::byte_buffer>(astd::byte_buffer { 'a' }));
+        lSecond->Store("file.txt", std::make_shared<const astd::byte_buffer>(astd::byte_buffer { 'b' }));
+
+        // Unmounting the later mount uncovers the earlier one, and only
+        // the given store is removed.
+        if (ace::VFS::Unmount("test-vfs-unmount", lSecond) == false ||
+            ace::VFS::Unmount("test-vfs-unmount", lSecond) == true)
+        {
+            return false;
+        }
+
+        auto lFile = ace::VFS::OpenFile("test-vfs-unmount/file.txt");
+        std::uint8_t lByte = 0;
+        if (lFile == nullptr || lFile->Read(&lByte, 1) != 1 || lByte != 'a')
+        {
+            return false;
+        }
+
+        return ace::VFS::Unmount("test-vfs-unmount", lFirst) == true &&
+            ace::VFS::OpenFile("test-vfs-unmount/file.txt") == nullptr;
+    }
+
+    bool TestCacheUnmounts ()
+    {
+        const fs::path lRoot = fs::temp_directory_path() / "ace-test-vfs-ddc";
+        {
+            ace::DerivedDataCache lCache { lRoot, "test-vfs-ddc" };
+            if (ace::VFS::OpenFileForWriting("test-vfs-ddc/entry") == nullptr)
+            {
+                return false;
+            }
+        }
+
+        const bool lUnmounted = ace::VFS::OpenFileForWriting("test-vfs-ddc/entry") == nullptr;
+
+        std::error_code lError;
+        fs::remove_all(lRoot, lError);
+        return lUnmounted;
+    }
+}
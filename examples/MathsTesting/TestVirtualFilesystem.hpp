@@ -0,0 +1,13 @@
+/**
+ * @file    MathsTesting/TestVirtualFilesystem.hpp
+ */
+
+#pragma once
+#include <Ace/System/DerivedDataCache.hpp>
+
+namespace AceVirtualFilesystem
+{
+    bool TestConcurrentMounting ();
+    bool TestUnmount ();
+    bool TestCacheUnmounts ();
+}
@@ -0,0 +1,140 @@
+/**
+ * @file    MathsTesting/TestVirtualLocalFile.cpp
+ */
+
+#include <thread>
+#include <MathsTesting/TestVirtualLocalFile.hpp>
+
+namespace AceVirtualLocalFile
+{
+    /**
+     * @brief   Writes the given text to a file, replacing its contents.
+     */
+    static void WriteText (
+        const fs::path&     pPath,
+        std::string_view    pText
+    )
+    {
+        std::ofstream lStream { pPath, std::ios::binary | std::ios::trunc };
+        lStream.write(pText.data(), pText.size());
+    }
+
+    /**
+     * @brief   Retrieves a mapping's contents as text.
+     */
+    static std::string_view AsText (
+        std::span<const std::uint8_t>   pMapping
+    )
+    {
+        return { reinterpret_cast<const char*>(pMapping.data()), pMapping.size() };
+    }
+
+    bool TestMapAfterReplace ()
+    {
+        const fs::path lDirectory = fs::temp_directory_path() / "ace-test-local-file";
+        fs::create_directories(lDirectory);
+        const fs::path lPath = lDirectory / "replaced.txt";
+        WriteText(lPath, "original contents");
+
+        // Atomically replace the file after opening it, as a writable mount
+        // does. Mapping still shows the file which was opened, not the one
+        // now at its path.
+        ace::VirtualLocalFile lFile { lPath };
+        WriteText(lDirectory / "replacement.tmp", "new");
+        fs::rename(lDirectory / "replacement.tmp", lPath);
+
+        const auto lMapping = lFile.Map();
+        const bool lOriginal =
+            AsText(lMapping) == "original contents" &&
+            lFile.Map().data() == lMapping.data();
+
+        lFile.Close();
+        fs::remove_all(lDirectory);
+        return lOriginal == true;
+    }
+
+    bool TestMapAfterTruncate ()
+    {
+        const fs::path lDirectory = fs::temp_directory_path() / "ace-test-local-file";
+        fs::create_directories(lDirectory);
+        const fs::path lPath = lDirectory / "truncated.txt";
+        WriteText(lPath, std::string(8192, 'x'));
+
+        // A file truncated in place since it was opened is not mapped, since
+        // touching its missing pages would fault.
+        ace::VirtualLocalFile lFile { lPath };
+        fs::resize_file(lPath, 16);
+
+        const bool lRefused =
+            lFile.Map().empty() == true &&
+            lFile.GetSize() == 8192;
+
+        lFile.Close();
+        fs::remove_all(lDirectory);
+        return lRefused == true;
+    }
+
+    bool TestConcurrentAtomicWrites ()
+    {
+        constexpr std::size_t WRITER_COUNT = 8;
+
+        const fs::path lDirectory = fs::temp_directory_path() / "ace-test-local-file";
+        fs::create_directories(lDirectory);
+        const fs::path lPath = lDirectory / "contested.txt";
+
+        // Writers racing to replace the same file each get a temporary file
+        // of their own, so the survivor is one writer's whole contents, and
+        // no temporary file is left behind.
+        std::atomic<std::size_t> lCommitted { 0 };
+        std::vector<std::thread> lWriters;
+        for (std::size_t i = 0; i < WRITER_COUNT; ++i)
+        {
+            lWriters.emplace_back(
+                [&lPath, &lCommitted, i] ()
+                {
+                    const std::string lText(4096, static_cast<char>('a' + i));
+                    ace::VirtualLocalWritableFile lFile { lPath, { .mBufferSize = 64 } };
+                    if (lFile.Write(lText.data(), lText.size()) == true && lFile.Commit() == true)
+                    {
+                        lCommitted.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            );
+        }
+
+        for (auto& lWriter : lWriters)
+        {
+            lWriter.join();
+        }
+
+        std::ifstream lStream { lPath, std::ios::binary };
+        const std::string lText { std::istreambuf_iterator<char> { lStream }, {} };
+        lStream.close();
+
+        const bool lWhole =
+            lCommitted.load() == WRITER_COUNT &&
+            lText.size() == 4096 &&
+            lText.find_first_not_of(lText[0]) == std::string::npos &&
+            std::distance(fs::directory_iterator { lDirectory }, fs::directory_iterator {}) == 1;
+
+        fs::remove_all(lDirectory);
+        return lWhole == true;
+    }
+
+    bool TestFailedWriteSize ()
+    {
+    #if defined(ACE_LINUX)
+        // Every write to `/dev/full` fails, so nothing should be counted
+        // towards the file's size, whether it was buffered or written
+        // straight through.
+        ace::VirtualLocalWritableFile lFile { "/dev/full", { .mAtomic = false, .mBufferSize = 4 } };
+        const std::uint8_t lBytes[16] = {};
+        return
+            lFile.Write(lBytes, 2) == true && lFile.Tell() == 2 &&
+            lFile.Write(lBytes, sizeof(lBytes)) == false && lFile.Tell() == 2 &&
+            lFile.Write(lBytes, 1) == false && lFile.Tell() == 2;
+    #else
+        return true;
+    #endif
+    }
+}
@@ -0,0 +1,15 @@
+/**
+ * @file    MathsTesting/TestVirtualLocalFile.hpp
+ */
+
+#pragma once
+#include <Ace/System/VirtualLocalFile.hpp>
+#include <Ace/System/VirtualLocalWritableFile.hpp>
+
+namespace AceVirtualLocalFile
+{
+    bool TestMapAfterReplace ();
+    bool TestMapAfterTruncate ();
+    bool TestConcurrentAtomicWrites ();
+    bool TestFailedWriteSize ();
+}
@@ -0,0 +1,231 @@
+/**
+ * @file    MathsTesting/TestWorldStreamer.cpp
+ */
+
+#include <MathsTesting/TestWorldStreamer.hpp>
+
+namespace AceWorldStreamer
+{
+    static constexpr float CELL_SIZE = 10.0f;
+
+    /**
+     * @brief   A cell asset; its file holds `ok`, or `fail` to make its load
+     *          fail.
+     */
+    struct TestCell
+    {
+        std::string mText;
+    };
+
+    class TestCellLoader final : public ace::IAssetLoader<TestCell>
+    {
+    public:
+
+        bool CanLoad (
+            const std::string&      pLogicalPath,
+            const ace::IVirtualFile& pVirtualFile
+        ) const override
+        {
+            (void) pVirtualFile;
+            return pLogicalPath.ends_with(".cell");
+        }
+
+        std::shared_ptr<TestCell> Load (
+            const std::string&                 pLogicalPath,
+            std::unique_ptr<ace::IVirtualFile> pVirtualFile
+        ) override
+        {
+            (void) pLogicalPath;
+            std::string lText(pVirtualFile->GetSize(), '\0');
+            pVirtualFile->Read(lText.data(), lText.size());
+            return (lText == "fail") ? nullptr : std::make_shared<TestCell>(lText);
+        }
+
+    };
+
+    /**
+     * @brief   Mounts the in-memory directory the cells live in, and registers
+     *          their loader, once.
+     */
+    static ace::VirtualMemoryStore& GetStore ()
+    {
+        static const std::shared_ptr<ace::VirtualMemoryStore> sStore = [] ()
+        {
+            ace::AssetRegistry::RegisterAssetLoader<TestCell>(std::make_shared<TestCellLoader>());
+            return ace::VFS::MountMemory("test-world");
+        }();
+
+        return *sStore;
+    }
+
+    /**
+     * @brief   Writes a cell's file, and registers the cell with a streamer.
+     */
+    static void AddCell (
+        ace::WorldStreamer<TestCell>&   pStreamer,
+        const std::string&              pLevel,
+        const ace::Vector3i&            pCoord,
+        const std::string&              pText = "ok"
+    )
+    {
+        const std::string lPath = std::format("{}/{}_{}_{}.cell", pLevel, pCoord.mX, pCoord.mY, pCoord.mZ);
+        GetStore().Store(lPath, std::make_shared<const astd::byte_buffer>(pText.begin(), pText.end()));
+        pStreamer.AddCell(pCoord, "test-world/" + lPath, 1);
+    }
+
+    /**
+     * @brief   Updates a streamer around one focus point until no loads are
+     *          left in flight.
+     */
+    static bool Settle (
+        ace::WorldStreamer<TestCell>&   pStreamer,
+        const ace::Vector3f&            pFocus
+    )
+    {
+        for (std::size_t i = 0; i < 5000; ++i)
+        {
+            pStreamer.Update({ pFocus });
+            if (pStreamer.GetInFlightCount() == 0)
+            {
+                return true;
+            }
+
+            std::this_thread::sleep_for(std::chrono::milliseconds { 1 });
+        }
+
+        return false;
+    }
+
+    static bool IsResident (
+        const ace::WorldStreamer<TestCell>& pStreamer,
+        const ace::Vector3i&                pCoord
+    )
+    {
+        return pStreamer.GetCell(pCoord).IsValid();
+    }
+
+    bool TestLoadOrder ()
+    {
+        // One load at a time, so that cells come in strictly nearest first,
+        // whatever order they were registered in.
+        ace::WorldStreamer<TestCell> lStreamer { {
+            .mCellSize = CELL_SIZE, .mLoadRadius = 35.0f, .mUnloadRadius = 50.0f, .mMaxInFlight = 1
+        } };
+        for (const std::int32_t x : { 3, 0, 5, 2, 1 })
+        {
+            AddCell(lStreamer, "order", { x, 0, 0 });
+        }
+
+        std::vector<std::int32_t> lOrder;
+        const std::size_t lSubscription = ace::EventBus::Subscribe<ace::CellStreamedEvent>(
+            [&] (const ace::CellStreamedEvent& pEvent)
+            {
+                if (pEvent.mMethod == ace::CellStreamMethod::StreamedIn && pEvent.mLogicalPath.contains("/order/"))
+                {
+                    lOrder.push_back(pEvent.mCoord.mX);
+                }
+
+                return false;
+            });
+
+        const bool lSettled = Settle(lStreamer, { 5.0f, 5.0f, 5.0f });
+        ace::EventBus::Unsubscribe(lSubscription);
+
+        return
+            lSettled == true &&
+            lOrder == std::vector<std::int32_t> { 0, 1, 2, 3 } &&
+            IsResident(lStreamer, { 5, 0, 0 }) == false &&
+            lStreamer.GetBudgetedBytes() == 4;
+    }
+
+    bool TestHysteresis ()
+    {
+        // A cell stays resident between the load and unload radii, and only
+        // comes back once it is inside the load radius again.
+        ace::WorldStreamer<TestCell> lStreamer { {
+            .mCellSize = CELL_SIZE, .mLoadRadius = 10.0f, .mUnloadRadius = 20.0f
+        } };
+        AddCell(lStreamer, "hysteresis", { 0, 0, 0 });
+
+        const bool lLoaded = Settle(lStreamer, { 5.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 });
+        const bool lKept = Settle(lStreamer, { 25.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 });
+        const bool lEdge = Settle(lStreamer, { 30.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 });
+        const bool lReleased = Settle(lStreamer, { 35.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 }) == false;
+        const bool lNotReloaded = Settle(lStreamer, { 25.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 }) == false;
+        const bool lReloaded = Settle(lStreamer, { 15.0f, 5.0f, 5.0f }) && IsResident(lStreamer, { 0, 0, 0 });
+
+        return
+            lLoaded == true && lKept == true && lEdge == true && lReleased == true &&
+            lNotReloaded == true && lReloaded == true;
+    }
+
+    bool TestBudgetEviction ()
+    {
+        // Room for two cells: the third waits, and is only let in by
+        // evicting the farthest resident cell once it becomes the nearest.
+        ace::WorldStreamer<TestCell> lStreamer { {
+            .mCellSize = CELL_SIZE, .mLoadRadius = 100.0f, .mUnloadRadius = 1000.0f, .mMemoryBudget = 2
+        } };
+        for (const std::int32_t x : { 0, 1, 2 })
+        {
+            AddCell(lStreamer, "budget", { x, 0, 0 });
+        }
+
+        const bool lFirst =
+            Settle(lStreamer, { 5.0f, 5.0f, 5.0f }) &&
+            IsResident(lStreamer, { 0, 0, 0 }) == true &&
+            IsResident(lStreamer, { 1, 0, 0 }) == true &&
+            IsResident(lStreamer, { 2, 0, 0 }) == false &&
+            lStreamer.GetBudgetedBytes() == 2;
+
+        const bool lSecond =
+            Settle(lStreamer, { 25.0f, 5.0f, 5.0f }) &&
+            IsResident(lStreamer, { 0, 0, 0 }) == false &&
+            IsResident(lStreamer, { 1, 0, 0 }) == true &&
+            IsResident(lStreamer, { 2, 0, 0 }) == true &&
+            lStreamer.GetBudgetedBytes() == 2;
+
+        return lFirst == true && lSecond == true;
+    }
+
+    bool TestFailureRetry ()
+    {
+        // A failed cell is left alone for the retry delay, then loads once
+        // whatever broke it is fixed.
+        ace::WorldStreamer<TestCell> lStreamer { {
+            .mCellSize = CELL_SIZE, .mLoadRadius = 10.0f, .mUnloadRadius = 20.0f, .mRetryDelay = 8
+        } };
+        AddCell(lStreamer, "retry", { 0, 0, 0 }, "fail");
+
+        const ace::Vector3f lFocus { 5.0f, 5.0f, 5.0f };
+        const bool lFailed =
+            Settle(lStreamer, lFocus) &&
+            IsResident(lStreamer, { 0, 0, 0 }) == false &&
+            lStreamer.GetFailureCount({ 0, 0, 0 }) == 1 &&
+            lStreamer.GetBudgetedBytes() == 0;
+
+        AddCell(lStreamer, "retry", { 0, 0, 0 }, "ok");
+        bool lWaited = true;
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            lStreamer.Update({ lFocus });
+            lWaited = lWaited && lStreamer.GetInFlightCount() == 0;
+        }
+
+        for (std::size_t i = 0; i < 8; ++i)
+        {
+            lStreamer.Update({ lFocus });
+        }
+
+        const bool lRecovered =
+            Settle(lStreamer, lFocus) &&
+            IsResident(lStreamer, { 0, 0, 0 }) == true &&
+            lStreamer.GetFailureCount({ 0, 0, 0 }) == 0;
+
+        // The failed load's warning starts the logger; stop it again so its
+        // worker thread is joined before the test runner exits.
+        ace::Logger::Shutdown();
+
+        return lFailed == true && lWaited == true && lRecovered == true;
+    }
+}
@@ -0,0 +1,14 @@
+/**
+ * @file    MathsTesting/TestWorldStreamer.hpp
+ */
+
+#pragma once
+#include <Ace/Scene/WorldStreamer.hpp>
+
+namespace AceWorldStreamer
+{
+    bool TestLoadOrder ();
+    bool TestHysteresis ();
+    bool TestBudgetEviction ();
+    bool TestFailureRetry ();
+}
@@ -7,6 +7,13 @@
 
 std::unique_ptr<ace::IApplication> ace::MakeApplication ()
 {
+    // Load the engine's settings, if any, before anything reads them.
+    if (fs::is_directory("config") == true)
+    {
+        ace::VFS::MountPhysicalDirectory("config", "config");
+        ace::Settings::Load("config/engine.cfg");
+    }
+
     ace::ApplicationSpec pSpec;
     return std::make_unique<sandbox::Application>(pSpec);
 }
@@ -29,4 +36,18 @@ namespace sandbox
         
     }
 
+    /* Protected Methods ******************************************************/
+
+    void Application::OnUpdate (
+        const float& pDelta
+    )
+    {
+        // Nothing produces input yet, so exit after a few seconds.
+        mElapsed += pDelta;
+        if (mElapsed >= 3.0f)
+        {
+            Quit();
+        }
+    }
+
 }
@@ -13,6 +13,12 @@ namespace sandbox
     public:
         explicit Application (const ace::ApplicationSpec& pSpec);
         virtual ~Application () override;
+
+    protected:
+        void OnUpdate (const float& pDelta) override;
+
+    private:
+        float mElapsed = 0.0f;
         
     };
 
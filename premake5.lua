@@ -102,6 +102,23 @@ workspace "Ace"
         filter {}
         
 
+    -- Project: `Benchmarks` - Ace Engine Performance Benchmarks
+    project "Benchmarks"
+        kind        "ConsoleApp"
+        location    "./build/%{outputdir}/Benchmarks"
+        targetdir   "./build/%{outputdir}/bin"
+        objdir      "./build/%{outputdir}/obj/Benchmarks"
+        files       { "./examples/Benchmarks/**.hpp", "./examples/Benchmarks/**.cpp" }
+        includedirs { "./engine", "./examples", "./external/miniz", table.unpack(external_includes) }
+        links       { "AceEngine", table.unpack(external_links) }
+        
+        filter { "system:windows" }
+            systemversion   "latest"
+        filter { "system:linux" }
+            pic             "On"
+        filter {}
+        
+
     -- Project: `Sandbox` - Ace Engine Sandbox Application
     project "Sandbox"
         kind        "ConsoleApp"